@@ -0,0 +1,80 @@
+using BenchmarkDotNet.Attributes;
+using Hex1b.Layout;
+using Hex1b.Surfaces;
+using Hex1b.Theming;
+
+namespace Hex1b.Benchmarks;
+
+/// <summary>
+/// Benchmarks for computed cell effects over a full screen, as behind a modal dialog.
+/// </summary>
+/// <remarks>
+/// <para>
+/// <c>Flatten_PerCell</c> wraps the effect in a lambda, which hides its row kernels and makes
+/// the composite resolve every cell through a <see cref="ComputeContext"/>, as custom effects
+/// do. <c>Flatten_Bulk</c> flattens the same composite with the built-in effect.
+/// </para>
+/// <para>
+/// <c>ApplyEffect</c> applies the effect in place to a fresh copy of the rendered screen, as
+/// an EffectPanel callback would; the copy is included in its time.
+/// </para>
+/// </remarks>
+[MemoryDiagnoser]
+public class CellEffectBenchmarks
+{
+    private const int Width = 200;
+    private const int Height = 60;
+
+    private Surface _screen = null!;
+    private Surface _result = null!;
+    private CompositeSurface _perCell = null!;
+    private CompositeSurface _bulk = null!;
+    private CellCompute _effect = null!;
+
+    [Params("Dim", "Tint", "BlurBackground")]
+    public string Effect { get; set; } = "Dim";
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _effect = Effect switch
+        {
+            "Tint" => CellEffects.Tint(Hex1bColor.FromRgb(20, 40, 120), 0.4f),
+            "BlurBackground" => CellEffects.BlurBackground(),
+            _ => CellEffects.Dim(0.5f),
+        };
+
+        _screen = new Surface(Width, Height);
+        _screen.Fill(new Rect(0, 0, Width, Height), new SurfaceCell(" ", null, Hex1bColor.FromRgb(30, 30, 46)));
+        for (int y = 0; y < Height; y++)
+        {
+            var foreground = Hex1bColor.FromRgb((byte)(100 + y * 2), 200, (byte)(255 - y * 3));
+            _screen.WriteText(2, y, $"{y,3}: The quick brown fox jumps over the lazy dog, line after line of content.", foreground);
+        }
+        _result = new Surface(Width, Height);
+
+        var effect = _effect;
+        _perCell = CreateBackdrop(context => effect(context));
+        _bulk = CreateBackdrop(_effect);
+    }
+
+    [Benchmark(Baseline = true)]
+    public void Flatten_PerCell() => _perCell.FlattenInto(_result);
+
+    [Benchmark]
+    public void Flatten_Bulk() => _bulk.FlattenInto(_result);
+
+    [Benchmark]
+    public void ApplyEffect()
+    {
+        _screen.Clone().ApplyEffect(_effect);
+    }
+
+    private CompositeSurface CreateBackdrop(CellCompute effect)
+    {
+        var composite = new CompositeSurface(Width, Height);
+        composite.AddLayer(_screen);
+        composite.AddComputedLayer(Width, Height, effect);
+        return composite;
+    }
+}
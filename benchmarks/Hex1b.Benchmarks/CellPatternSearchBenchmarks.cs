@@ -0,0 +1,100 @@
+using System.Text;
+using BenchmarkDotNet.Attributes;
+using Hex1b.Automation;
+using Hex1b.Theming;
+using Hex1b.Tokens;
+
+namespace Hex1b.Benchmarks;
+
+/// <summary>
+/// Benchmarks for cell pattern and regex searches over a large scrollback capture.
+/// </summary>
+/// <remarks>
+/// The <c>Shared</c> benchmarks reuse one snapshot, so they measure searches against an
+/// already-built text index; the <c>Cold</c> ones take a fresh snapshot each time and include
+/// building the index.
+/// </remarks>
+[MemoryDiagnoser]
+public class CellPatternSearchBenchmarks
+{
+    private Hex1bAppWorkloadAdapter _workload = null!;
+    private Hex1bTerminal _terminal = null!;
+    private Hex1bTerminalSnapshot _snapshot = null!;
+    private CompiledCellPattern _textPattern = null!;
+    private CompiledCellPattern _charPattern = null!;
+    private CompiledCellPattern _regexPattern = null!;
+
+    [Params(10_000)]
+    public int Lines { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _workload = new Hex1bAppWorkloadAdapter();
+        _terminal = Hex1bTerminal.CreateBuilder()
+            .WithWorkload(_workload)
+            .WithHeadless()
+            .WithDimensions(120, 40)
+            .WithScrollback(Lines)
+            .Build();
+
+        var sb = new StringBuilder();
+        for (int i = 0; i < Lines; i++)
+        {
+            var status = i % 97 == 0 ? "\x1b[31mFAILED\x1b[0m" : "\x1b[32mpassed\x1b[0m";
+            sb.Append($"[{i:D5}] test_case_{i % 250} ........ {status} in {i % 1000} ms\r\n");
+        }
+        _terminal.ApplyTokens(AnsiTokenizer.Tokenize(sb.ToString()));
+        _snapshot = _terminal.CreateSnapshot(scrollbackLines: Lines);
+
+        _textPattern = new CellPatternSearcher()
+            .Find("FAILED")
+            .RightText(" in")
+            .Compile();
+        _charPattern = new CellPatternSearcher()
+            .Find('[')
+            .RightWhile(ctx => char.IsDigit(ctx.Cell.Character[0]))
+            .Right(']')
+            .Compile();
+        _regexPattern = new CellPatternSearcher()
+            .FindPattern(@"test_case_24\d")
+            .Compile();
+
+        // Build the shared index once so the Shared benchmarks measure searching only
+        _textPattern.Search(_snapshot);
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        _terminal.Dispose();
+        _workload.Dispose();
+    }
+
+    [Benchmark(Baseline = true)]
+    public int FindText_Shared() => _textPattern.Search(_snapshot).Count;
+
+    [Benchmark]
+    public int FindChar_Shared() => _charPattern.Search(_snapshot).Count;
+
+    [Benchmark]
+    public int FindPattern_Shared() => _regexPattern.Search(_snapshot).Count;
+
+    [Benchmark]
+    public int FindMultiLinePattern_Shared() => _snapshot.FindMultiLinePattern(@"FAILED.*\n.*passed").Count;
+
+    [Benchmark]
+    public bool ContainsText_Shared() => _snapshot.ContainsText("test_case_249 ........ FAILED");
+
+    [Benchmark]
+    public bool HasForegroundColor_Shared() => _snapshot.HasForegroundColor(Hex1bColor.FromRgb(1, 2, 3));
+
+    [Benchmark]
+    public int ThreeSearches_Cold()
+    {
+        using var snapshot = _terminal.CreateSnapshot(scrollbackLines: Lines);
+        return _textPattern.Search(snapshot).Count
+            + _charPattern.Search(snapshot).Count
+            + _regexPattern.Search(snapshot).Count;
+    }
+}
@@ -14,8 +14,23 @@ switch (benchmarkType)
     case "rendering":
         BenchmarkSwitcher.FromTypes([typeof(RenderingModeBenchmarks)]).Run(bdnArgs);
         break;
+    case "patterns":
+        BenchmarkSwitcher.FromTypes([typeof(CellPatternSearchBenchmarks)]).Run(bdnArgs);
+        break;
+    case "pty":
+        BenchmarkSwitcher.FromTypes([typeof(PtySpawnBenchmarks)]).Run(bdnArgs);
+        break;
+    case "emulator":
+        BenchmarkSwitcher.FromTypes([typeof(TerminalEmulatorBenchmarks)]).Run(bdnArgs);
+        break;
+    case "theme":
+        BenchmarkSwitcher.FromTypes([typeof(ThemeBenchmarks)]).Run(bdnArgs);
+        break;
+    case "effects":
+        BenchmarkSwitcher.FromTypes([typeof(CellEffectBenchmarks)]).Run(bdnArgs);
+        break;
     case "all":
     default:
-        BenchmarkSwitcher.FromTypes([typeof(SurfaceBenchmarks), typeof(RenderingModeBenchmarks)]).Run(bdnArgs);
+        BenchmarkSwitcher.FromTypes([typeof(SurfaceBenchmarks), typeof(RenderingModeBenchmarks), typeof(CellPatternSearchBenchmarks), typeof(TerminalEmulatorBenchmarks), typeof(ThemeBenchmarks), typeof(CellEffectBenchmarks)]).Run(bdnArgs);
         break;
 }
@@ -0,0 +1,58 @@
+using BenchmarkDotNet.Attributes;
+
+namespace Hex1b.Benchmarks;
+
+/// <summary>
+/// Benchmarks for starting a short-lived child on a PTY with <c>forkpty</c> versus <c>posix_spawn</c>.
+/// </summary>
+/// <remarks>
+/// Each iteration starts <c>/bin/true</c> and reaps it. <see cref="HeapMegabytes"/> keeps a
+/// managed ballast alive, since fork cost grows with the parent's mapped memory while
+/// posix_spawn shouldn't. Linux only.
+/// </remarks>
+[MemoryDiagnoser]
+public class PtySpawnBenchmarks
+{
+    private const string Executable = "/bin/true";
+
+    private readonly Dictionary<string, string> _environment = new()
+    {
+        ["PATH"] = "/usr/bin:/bin",
+        ["TERM"] = "xterm-256color",
+    };
+
+    private byte[][] _ballast = [];
+
+    [Params(0, 1024)]
+    public int HeapMegabytes { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        if (!OperatingSystem.IsLinux())
+            throw new PlatformNotSupportedException("PTY spawn benchmarks require Linux.");
+
+        // Touch every page so the ballast is actually mapped
+        _ballast = new byte[HeapMegabytes][];
+        for (int i = 0; i < _ballast.Length; i++)
+        {
+            _ballast[i] = new byte[1024 * 1024];
+            for (int offset = 0; offset < _ballast[i].Length; offset += 4096)
+                _ballast[i][offset] = 1;
+        }
+    }
+
+    [Benchmark(Baseline = true)]
+    public async Task ForkPty() => await SpawnAndReapAsync(UnixPtySpawnMode.ForkPty);
+
+    [Benchmark]
+    public async Task PosixSpawn() => await SpawnAndReapAsync(UnixPtySpawnMode.PosixSpawn);
+
+    private async Task SpawnAndReapAsync(UnixPtySpawnMode mode)
+    {
+        var handle = new UnixPtyHandle(mode);
+        handle.Spawn(Executable, [], workingDirectory: null, _environment, 80, 24);
+        await handle.WaitForExitAsync(CancellationToken.None);
+        await handle.DisposeAsync();
+    }
+}
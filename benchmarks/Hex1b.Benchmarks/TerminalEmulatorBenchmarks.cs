@@ -0,0 +1,188 @@
+using System.Text;
+using System.Threading.Channels;
+using BenchmarkDotNet.Attributes;
+using Hex1b.Reflow;
+using Hex1b.Tokens;
+
+namespace Hex1b.Benchmarks;
+
+/// <summary>
+/// Benchmarks for the terminal emulator core: tokenizing workload output, applying it to the
+/// screen and scrollback, the whole output pump, and snapshots and reflow afterwards.
+/// </summary>
+/// <remarks>
+/// <para>
+/// <c>Tokenize</c>, <c>ApplyTokens</c> and <c>Pump</c> each process one whole stream (about
+/// 1 MiB, see <see cref="TerminalStreams"/>) per operation, so their mean is the time per MiB
+/// (MB/s is its reciprocal) and the Allocated column is bytes allocated per MiB.
+/// </para>
+/// <para>
+/// <c>Snapshot</c> and <c>ResizeReflow</c> measure latency against a terminal that already
+/// holds the stream, with a full scrollback.
+/// </para>
+/// </remarks>
+[MemoryDiagnoser]
+public class TerminalEmulatorBenchmarks
+{
+    private const int ScrollbackLines = 10_000;
+
+    private IReadOnlyList<byte[]> _chunks = [];
+    private IReadOnlyList<AnsiToken>[] _tokenizedChunks = [];
+
+    private Hex1bAppWorkloadAdapter _applyWorkload = null!;
+    private Hex1bTerminal _applyTerminal = null!;
+
+    private ReplayWorkloadAdapter _pumpWorkload = null!;
+    private Hex1bTerminal _pumpTerminal = null!;
+
+    [Params(TerminalStreams.Vim, TerminalStreams.Htop, TerminalStreams.GitLog, TerminalStreams.CatLog, TerminalStreams.Tmux)]
+    public string Stream { get; set; } = TerminalStreams.Vim;
+
+    [GlobalSetup]
+    public async Task Setup()
+    {
+        _chunks = TerminalStreams.Load(Stream);
+        _tokenizedChunks = TokenizeChunks(_chunks);
+
+        _applyWorkload = new Hex1bAppWorkloadAdapter();
+        _applyTerminal = Hex1bTerminal.CreateBuilder()
+            .WithWorkload(_applyWorkload)
+            .WithPresentation(new HeadlessPresentationAdapter(TerminalStreams.Width, TerminalStreams.Height)
+                .WithReflow(AlacrittyReflowStrategy.Instance))
+            .WithScrollback(ScrollbackLines)
+            .Build();
+        ApplyTokens();
+
+        _pumpWorkload = new ReplayWorkloadAdapter();
+        _pumpTerminal = Hex1bTerminal.CreateBuilder()
+            .WithWorkload(_pumpWorkload)
+            .WithHeadless()
+            .WithDimensions(TerminalStreams.Width, TerminalStreams.Height)
+            .WithScrollback(ScrollbackLines)
+            .Build();
+        await Pump();
+    }
+
+    [GlobalCleanup]
+    public async Task Cleanup()
+    {
+        await _pumpTerminal.DisposeAsync();
+        await _pumpWorkload.DisposeAsync();
+        _applyTerminal.Dispose();
+        _applyWorkload.Dispose();
+    }
+
+    /// <summary>
+    /// Decodes and tokenizes the stream the way the output pump does, carrying split UTF-8
+    /// characters and escape sequences over to the next chunk.
+    /// </summary>
+    [Benchmark(Baseline = true)]
+    public int Tokenize() => TokenizeChunks(_chunks).Sum(tokens => tokens.Count);
+
+    /// <summary>
+    /// Applies the pre-tokenized stream to the screen buffer and scrollback.
+    /// </summary>
+    [Benchmark]
+    public void ApplyTokens()
+    {
+        foreach (var tokens in _tokenizedChunks)
+            _applyTerminal.ApplyTokens(tokens);
+    }
+
+    /// <summary>
+    /// Feeds the stream through the output pump, from workload read to presentation write.
+    /// </summary>
+    [Benchmark]
+    public Task Pump() => _pumpWorkload.ReplayAsync(_chunks);
+
+    [Benchmark]
+    public int Snapshot()
+    {
+        using var snapshot = _applyTerminal.CreateSnapshot(scrollbackLines: ScrollbackLines);
+        return snapshot.Height;
+    }
+
+    /// <summary>
+    /// Narrows the terminal and widens it back, then takes a snapshot with the whole
+    /// scrollback so any deferred re-wrapping is included.
+    /// </summary>
+    [Benchmark]
+    public int ResizeReflow()
+    {
+        _applyTerminal.Resize(TerminalStreams.Width * 2 / 3, TerminalStreams.Height);
+        _applyTerminal.Resize(TerminalStreams.Width, TerminalStreams.Height);
+        using var snapshot = _applyTerminal.CreateSnapshot(scrollbackLines: ScrollbackLines);
+        return snapshot.Height;
+    }
+
+    private static IReadOnlyList<AnsiToken>[] TokenizeChunks(IReadOnlyList<byte[]> chunks)
+    {
+        var decoder = Encoding.UTF8.GetDecoder();
+        var incomplete = "";
+        var result = new IReadOnlyList<AnsiToken>[chunks.Count];
+        for (int i = 0; i < chunks.Count; i++)
+        {
+            var chars = new char[decoder.GetCharCount(chunks[i], flush: false)];
+            decoder.GetChars(chunks[i], chars, flush: false);
+            var (complete, rest) = Hex1bTerminal.ExtractIncompleteEscapeSequence(incomplete + new string(chars));
+            incomplete = rest;
+            result[i] = complete.Length > 0 ? AnsiTokenizer.Tokenize(complete) : [];
+        }
+        return result;
+    }
+
+    /// <summary>
+    /// Hands out queued chunks as fast as the pump asks for them.
+    /// </summary>
+    private sealed class ReplayWorkloadAdapter : IHex1bTerminalWorkloadAdapter
+    {
+        private readonly Channel<byte[]> _output = Channel.CreateUnbounded<byte[]>(
+            new UnboundedChannelOptions { SingleReader = true, SingleWriter = true });
+        private readonly byte[] _endMarker = [];
+        private TaskCompletionSource _replayed = new();
+
+        public event Action? Disconnected
+        {
+            add { }
+            remove { }
+        }
+
+        /// <summary>
+        /// Queues the chunks; completes once the pump has processed all of them.
+        /// </summary>
+        public Task ReplayAsync(IReadOnlyList<byte[]> chunks)
+        {
+            _replayed = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+            foreach (var chunk in chunks)
+                _output.Writer.TryWrite(chunk);
+            _output.Writer.TryWrite(_endMarker);
+            return _replayed.Task;
+        }
+
+        public async ValueTask<ReadOnlyMemory<byte>> ReadOutputAsync(CancellationToken ct = default)
+        {
+            while (true)
+            {
+                if (!_output.Reader.TryRead(out var chunk))
+                    chunk = await _output.Reader.ReadAsync(ct);
+
+                // The pump only reads again after processing the previous chunk
+                if (ReferenceEquals(chunk, _endMarker))
+                {
+                    _replayed.TrySetResult();
+                    continue;
+                }
+                return chunk;
+            }
+        }
+
+        public ValueTask WriteInputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default) => ValueTask.CompletedTask;
+        public ValueTask ResizeAsync(int width, int height, CancellationToken ct = default) => ValueTask.CompletedTask;
+
+        public ValueTask DisposeAsync()
+        {
+            _output.Writer.TryComplete();
+            return ValueTask.CompletedTask;
+        }
+    }
+}
@@ -0,0 +1,280 @@
+using System.Buffers;
+using System.Text;
+
+namespace Hex1b.Benchmarks;
+
+/// <summary>
+/// Workload output streams for the terminal emulator benchmarks, split into chunks the way
+/// a PTY read would deliver them.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Every stream is repeated to about <see cref="TargetBytes"/>, so a benchmark that processes
+/// one whole stream per operation reports time and allocations per MiB.
+/// </para>
+/// <para>
+/// Set <c>HEX1B_BENCHMARK_RECORDINGS</c> to a directory holding asciicast v2 recordings named
+/// after the streams (<c>vim.cast</c>, <c>htop.cast</c>, ...), e.g. made with
+/// <c>asciinema rec</c>, to drive the benchmarks with real sessions. Streams without a
+/// recording are generated: deterministic approximations of each program's output, so
+/// results stay comparable between runs and machines.
+/// </para>
+/// </remarks>
+internal static class TerminalStreams
+{
+    public const int TargetBytes = 1024 * 1024;
+    public const int Width = 120;
+    public const int Height = 40;
+
+    public const string Vim = "vim";
+    public const string Htop = "htop";
+    public const string GitLog = "git-log";
+    public const string CatLog = "cat-log";
+    public const string Tmux = "tmux";
+
+    public static IReadOnlyList<byte[]> Load(string name)
+    {
+        var chunks = LoadRecording(name) ?? name switch
+        {
+            Vim => Generate(VimSession),
+            Htop => Generate(HtopRefreshes),
+            GitLog => Split(Generate(GitLogOutput), 4096),
+            CatLog => Split(Generate(LogFile), 64 * 1024),
+            Tmux => Generate(TmuxRedraws),
+            _ => throw new ArgumentOutOfRangeException(nameof(name), name, "Unknown stream."),
+        };
+        return RepeatToTarget(chunks);
+    }
+
+    private static List<byte[]>? LoadRecording(string name)
+    {
+        var directory = Environment.GetEnvironmentVariable("HEX1B_BENCHMARK_RECORDINGS");
+        var path = string.IsNullOrEmpty(directory) ? null : Path.Combine(directory, name + ".cast");
+        if (path is null || !File.Exists(path))
+            return null;
+
+        using var stream = File.OpenRead(path);
+        using var reader = new AsciinemaEventReader(stream);
+        var chunks = new List<byte[]>();
+        var data = new ArrayBufferWriter<byte>();
+
+        // Header first, then one output chunk per "o" event
+        if (!reader.ReadLineAsync().AsTask().GetAwaiter().GetResult())
+            return null;
+        while (reader.ReadLineAsync().AsTask().GetAwaiter().GetResult())
+        {
+            data.Clear();
+            if (AsciinemaEventReader.TryParseEvent(reader.Line.Span, out _, out var eventType, data)
+                && eventType == (byte)'o' && data.WrittenCount > 0)
+            {
+                chunks.Add(data.WrittenSpan.ToArray());
+            }
+        }
+        return chunks.Count > 0 ? chunks : null;
+    }
+
+    private static List<byte[]> RepeatToTarget(List<byte[]> chunks)
+    {
+        var result = new List<byte[]>();
+        long total = 0;
+        while (total < TargetBytes)
+        {
+            foreach (var chunk in chunks)
+            {
+                result.Add(chunk);
+                total += chunk.Length;
+                if (total >= TargetBytes)
+                    break;
+            }
+        }
+        return result;
+    }
+
+    private static List<byte[]> Generate(Action<Random, Action<string>> writer)
+    {
+        var chunks = new List<byte[]>();
+        writer(new Random(42), text => chunks.Add(Encoding.UTF8.GetBytes(text)));
+        return chunks;
+    }
+
+    // Cuts at fixed byte offsets, so escape sequences and UTF-8 characters get split across
+    // chunks like they do with real pipe reads
+    private static List<byte[]> Split(List<byte[]> chunks, int size)
+    {
+        var all = chunks.SelectMany(c => c).ToArray();
+        return all.Chunk(size).ToList();
+    }
+
+    private static readonly string[] Keywords = ["public", "private", "static", "var", "return", "if", "foreach", "new"];
+
+    /// <summary>
+    /// Opens a file (full redraw with syntax colors and a status line), then edits: single
+    /// characters typed, cursor jumps, and scrolls through a scroll region.
+    /// </summary>
+    private static void VimSession(Random random, Action<string> write)
+    {
+        var sb = new StringBuilder();
+        for (int session = 0; session < 8; session++)
+        {
+            sb.Clear();
+            sb.Append("\x1b[?1049h\x1b[22;0;0t\x1b[?1h\x1b=\x1b[H\x1b[2J\x1b[1;38r");
+            for (int y = 1; y < Height - 1; y++)
+                AppendCodeLine(sb, random, y);
+            sb.Append($"\x1b[{Height - 1};1H\x1b[7m src/Hex1b/Hex1bTerminal.cs [+]{new string(' ', Width - 50)}1,1  Top \x1b[27m");
+            sb.Append("\x1b[1;5H");
+            write(sb.ToString());
+
+            for (int edit = 0; edit < 300; edit++)
+            {
+                switch (random.Next(4))
+                {
+                    case 0:
+                        write($"\x1b[?25l{(char)('a' + random.Next(26))}\x1b[?25h");
+                        break;
+                    case 1:
+                        write($"\x1b[{random.Next(1, Height - 1)};{random.Next(1, 60)}H");
+                        break;
+                    case 2:
+                        sb.Clear();
+                        sb.Append($"\x1b[?25l\x1b[{Height - 2};1H\n\x1b[{Height - 2};1H");
+                        AppendCodeLine(sb, random, Height - 2);
+                        sb.Append($"\x1b[{Height - 1};{Width - 18}H\x1b[7m{edit},1 {edit % 100}%\x1b[27m\x1b[?25h");
+                        write(sb.ToString());
+                        break;
+                    default:
+                        write($"\x1b[{Height};1H\x1b[1m-- INSERT --\x1b[m\x1b[K\x1b[{random.Next(1, Height - 1)};10H");
+                        break;
+                }
+            }
+            write("\x1b[?1049l\x1b[23;0;0t\x1b[?1l\x1b>");
+        }
+    }
+
+    private static void AppendCodeLine(StringBuilder sb, Random random, int row)
+    {
+        sb.Append($"\x1b[{row};1H\x1b[38;5;130m{row,4} \x1b[m");
+        sb.Append(new string(' ', 4 * random.Next(4)));
+        for (int word = 0; word < random.Next(2, 9); word++)
+        {
+            if (random.Next(3) == 0)
+                sb.Append($"\x1b[38;5;{(random.Next(2) == 0 ? 33 : 169)}m{Keywords[random.Next(Keywords.Length)]}\x1b[m ");
+            else if (random.Next(5) == 0)
+                sb.Append($"\x1b[38;5;71m\"text_{random.Next(1000)}\"\x1b[m ");
+            else
+                sb.Append($"identifier{random.Next(100)} ");
+        }
+        sb.Append("\x1b[K");
+    }
+
+    /// <summary>
+    /// One full refresh per chunk: meter bars, then a table of processes in 256 colors with
+    /// the selected row highlighted.
+    /// </summary>
+    private static void HtopRefreshes(Random random, Action<string> write)
+    {
+        var sb = new StringBuilder();
+        write("\x1b[?1049h\x1b[?1h\x1b=\x1b[?25l\x1b[H\x1b[2J");
+        for (int refresh = 0; refresh < 60; refresh++)
+        {
+            sb.Clear();
+            for (int cpu = 0; cpu < 4; cpu++)
+            {
+                var used = random.Next(40);
+                sb.Append($"\x1b[{cpu + 1};3H\x1b[36m{cpu}\x1b[39m\x1b[1m[\x1b[32m{new string('|', used)}\x1b[31m{new string('|', random.Next(5))}\x1b[90m{new string(' ', 45 - used)}\x1b[39m{random.Next(100),3}.{random.Next(10)}%\x1b[1m]\x1b[m");
+            }
+            sb.Append($"\x1b[6;1H\x1b[30;42m    PID USER      PRI  NI  VIRT   RES   SHR S CPU% MEM%   TIME+  Command{new string(' ', Width - 73)}\x1b[m");
+            var selected = random.Next(7, Height - 1);
+            for (int row = 7; row < Height; row++)
+            {
+                var highlight = row == selected ? "\x1b[30;46m" : "";
+                sb.Append($"\x1b[{row};1H{highlight}{random.Next(1, 99999),7} \x1b[38;5;{(random.Next(4) == 0 ? 245 : 252)}mroot     \x1b[39m {random.Next(40),3} {random.Next(-20, 20),3} ");
+                sb.Append($"\x1b[36m{random.Next(9999)}M\x1b[39m {random.Next(999),4}M {random.Next(99),4}M S {random.Next(100),4}.{random.Next(10)} {random.Next(10),3}.{random.Next(10)} {random.Next(60)}:{random.Next(60):D2}.{random.Next(100):D2} ");
+                sb.Append($"\x1b[1m/usr/bin/process{random.Next(50)}\x1b[m --flag-{random.Next(10)}\x1b[K");
+            }
+            sb.Append($"\x1b[{Height};1H\x1b[30;46mF1\x1b[39;49mHelp  \x1b[30;46mF2\x1b[39;49mSetup \x1b[30;46mF3\x1b[39;49mSearch\x1b[K");
+            write(sb.ToString());
+        }
+    }
+
+    /// <summary>
+    /// <c>git log --color --stat</c> piped through: colored commit headers, authors with
+    /// non-ASCII names, and diffstat bars.
+    /// </summary>
+    private static void GitLogOutput(Random random, Action<string> write)
+    {
+        string[] authors = ["Zoë Müller", "José García", "李明", "Åsa Lindqvist", "Dev Bot"];
+        var sb = new StringBuilder();
+        for (int commit = 0; commit < 400; commit++)
+        {
+            sb.Clear();
+            var sha = string.Concat(Enumerable.Range(0, 40).Select(_ => "0123456789abcdef"[random.Next(16)]));
+            sb.Append($"\x1b[33mcommit {sha}\x1b[m");
+            if (commit % 10 == 0)
+                sb.Append(" \x1b[33m(\x1b[m\x1b[1;36mHEAD -> \x1b[m\x1b[1;32mmain\x1b[m\x1b[33m, \x1b[m\x1b[1;31morigin/main\x1b[m\x1b[33m)\x1b[m");
+            sb.Append($"\r\nAuthor: {authors[random.Next(authors.Length)]} <dev{random.Next(50)}@example.com>\r\n");
+            sb.Append($"Date:   Mon Oct {random.Next(1, 29)} {random.Next(24):D2}:{random.Next(60):D2}:00 2026 +0200\r\n\r\n");
+            sb.Append($"    Fix handling of case {random.Next(1000)} in the output pump\r\n\r\n");
+            for (int file = 0; file < random.Next(1, 6); file++)
+            {
+                var added = random.Next(40);
+                var removed = random.Next(20);
+                sb.Append($" src/Hex1b/File{random.Next(200)}.cs | {added + removed,3} \x1b[32m{new string('+', added)}\x1b[m\x1b[31m{new string('-', removed)}\x1b[m\r\n");
+            }
+            sb.Append("\r\n");
+            write(sb.ToString());
+        }
+    }
+
+    /// <summary>
+    /// A large application log, mostly plain text with colored levels, as <c>cat</c> would
+    /// stream it.
+    /// </summary>
+    private static void LogFile(Random random, Action<string> write)
+    {
+        string[] levels = ["\x1b[32mINFO\x1b[0m ", "\x1b[32mINFO\x1b[0m ", "\x1b[36mDEBUG\x1b[0m", "\x1b[33mWARN\x1b[0m ", "\x1b[31mERROR\x1b[0m"];
+        var sb = new StringBuilder();
+        for (int block = 0; block < 40; block++)
+        {
+            sb.Clear();
+            for (int line = 0; line < 200; line++)
+            {
+                sb.Append($"2026-10-18T{random.Next(24):D2}:{random.Next(60):D2}:{random.Next(60):D2}.{random.Next(1000):D3}Z {levels[random.Next(levels.Length)]} ");
+                sb.Append($"[worker-{random.Next(16)}] Request {random.Next(1_000_000)} handled in {random.Next(500)} ms status={(random.Next(10) == 0 ? 500 : 200)}");
+                if (random.Next(8) == 0)
+                    sb.Append($" payload={{\"id\":{random.Next(1000)},\"items\":[{random.Next(10)},{random.Next(10)},{random.Next(10)}],\"note\":\"cache miss on shard {random.Next(32)}\"}}");
+                sb.Append("\r\n");
+            }
+            write(sb.ToString());
+        }
+    }
+
+    /// <summary>
+    /// Two panes side by side: each pane's output is drawn by tmux with absolute cursor
+    /// moves clipped to the pane, a box-drawing border, and a status line refresh.
+    /// </summary>
+    private static void TmuxRedraws(Random random, Action<string> write)
+    {
+        const int paneWidth = Width / 2 - 1;
+        var sb = new StringBuilder();
+        write("\x1b[?1049h\x1b[H\x1b[2J\x1b[?1000h\x1b[?1006h");
+        for (int redraw = 0; redraw < 150; redraw++)
+        {
+            sb.Clear();
+            var pane = redraw % 2;
+            var left = pane == 0 ? 1 : paneWidth + 2;
+            var full = redraw % 25 == 0;
+            var firstRow = full ? 1 : Height - 1 - random.Next(1, 4);
+            for (int row = firstRow; row < Height; row++)
+            {
+                sb.Append($"\x1b[{row};{left}H");
+                var text = $"\x1b[38;5;{random.Next(256)}m{random.Next(1_000_000):D7}\x1b[39m line of pane {pane} output {random.Next(1000)}";
+                sb.Append(text).Append("\x1b[").Append(paneWidth - 40).Append('X');
+                if (pane == 0)
+                    sb.Append($"\x1b[{row};{paneWidth + 1}H\x1b[32m│\x1b[39m");
+            }
+            sb.Append($"\x1b[{Height};1H\x1b[30;42m[0] 0:bash* 1:vim- {new string(' ', Width - 45)}\"host\" {random.Next(24):D2}:{random.Next(60):D2} 18-Oct-26\x1b[39;49m");
+            sb.Append($"\x1b[{Height - 1};{left + random.Next(20)}H");
+            write(sb.ToString());
+        }
+    }
+}
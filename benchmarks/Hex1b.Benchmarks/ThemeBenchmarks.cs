@@ -0,0 +1,179 @@
+using BenchmarkDotNet.Attributes;
+using Hex1b.Layout;
+using Hex1b.Nodes;
+using Hex1b.Surfaces;
+using Hex1b.Theming;
+using Hex1b.Widgets;
+
+namespace Hex1b.Benchmarks;
+
+/// <summary>
+/// Benchmarks for theme lookups and the frames that depend on them.
+/// </summary>
+/// <remarks>
+/// <para>
+/// <c>Get_*</c> resolve the same mix of colors and characters, several of them through
+/// fallback chains. <c>Get_Dictionary</c> replays the string-keyed lookup themes used
+/// before element slots, as the baseline.
+/// </para>
+/// <para>
+/// <c>RenderFrame_*</c> render a whole 80x24 frame of bordered, scrolled and list content
+/// with caching off. <c>Unlocked</c> uses a clone of the theme, as inside a ThemePanel.
+/// </para>
+/// </remarks>
+[MemoryDiagnoser]
+public class ThemeBenchmarks
+{
+    private const int TerminalWidth = 80;
+    private const int TerminalHeight = 24;
+
+    private static readonly Hex1bThemeElement<Hex1bColor>[] Colors =
+    [
+        ButtonTheme.BackgroundColor,
+        ButtonTheme.FocusedForegroundColor,
+        BorderTheme.TopBorderColor,
+        BorderTheme.LeftBorderColor,
+        ScrollTheme.TrackColor,
+        ScrollTheme.ThumbColor,
+        ListTheme.SelectedBackgroundColor,
+        GlobalTheme.ForegroundColor,
+        GlobalTheme.BackgroundColor,
+    ];
+
+    private static readonly Hex1bThemeElement<string>[] Strings =
+    [
+        BorderTheme.TopLine,
+        BorderTheme.LeftLine,
+        BorderTheme.TopLeftCorner,
+        ScrollTheme.VerticalThumbCharacter,
+    ];
+
+    private Hex1bTheme _locked = null!;
+    private Hex1bTheme _unlocked = null!;
+    private DictionaryTheme _dictionary = null!;
+
+    private Hex1bNode _frame = null!;
+    private Surface _surface = null!;
+    private SurfaceRenderContext _lockedContext = null!;
+    private SurfaceRenderContext _unlockedContext = null!;
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _locked = Hex1bThemes.Ocean;
+        _unlocked = Hex1bThemes.Ocean.Clone();
+        _dictionary = new DictionaryTheme()
+            .Set(ButtonTheme.BackgroundColor, Hex1bColor.FromRgb(25, 40, 60))
+            .Set(ButtonTheme.FocusedForegroundColor, Hex1bColor.White)
+            .Set(BorderTheme.BorderColor, Hex1bColor.FromRgb(60, 90, 130))
+            .Set(ListTheme.SelectedBackgroundColor, Hex1bColor.FromRgb(0, 100, 180));
+
+        _frame = new BorderNode
+        {
+            Title = "Theme Benchmark",
+            Child = new VStackNode
+            {
+                Children =
+                [
+                    new TextBlockNode { Text = "Header Content" },
+                    new HStackNode
+                    {
+                        Children =
+                        [
+                            new ButtonNode { Label = "OK", IsFocused = true },
+                            new ButtonNode { Label = "Cancel" }
+                        ]
+                    },
+                    new ListNode { Items = [.. Enumerable.Range(1, 5).Select(i => $"Item {i}")], FocusedIndex = 2 },
+                    new ProgressNode { Value = 50, Maximum = 100 },
+                    new ScrollPanelNode
+                    {
+                        Orientation = ScrollOrientation.Vertical,
+                        Child = new VStackNode
+                        {
+                            Children = Enumerable.Range(0, 40)
+                                .Select(i => new TextBlockNode { Text = $"Row {i}: scrolled content" } as Hex1bNode)
+                                .ToList()
+                        }
+                    }
+                ]
+            }
+        };
+        _frame.Measure(new Constraints(0, TerminalWidth, 0, TerminalHeight));
+        _frame.Arrange(new Rect(0, 0, TerminalWidth, TerminalHeight));
+
+        _surface = new Surface(TerminalWidth, TerminalHeight);
+        _lockedContext = new SurfaceRenderContext(_surface, _locked) { CachingEnabled = false };
+        _unlockedContext = new SurfaceRenderContext(_surface, _unlocked) { CachingEnabled = false };
+    }
+
+    [Benchmark(Baseline = true)]
+    public int Get_Dictionary()
+    {
+        var sum = 0;
+        foreach (var element in Colors)
+            sum += _dictionary.Get(element).R;
+        foreach (var element in Strings)
+            sum += _dictionary.Get(element).Length;
+        return sum;
+    }
+
+    [Benchmark]
+    public int Get_Locked()
+    {
+        var sum = 0;
+        foreach (var element in Colors)
+            sum += _locked.Get(element).R;
+        foreach (var element in Strings)
+            sum += _locked.Get(element).Length;
+        return sum;
+    }
+
+    [Benchmark]
+    public int Get_Unlocked()
+    {
+        var sum = 0;
+        foreach (var element in Colors)
+            sum += _unlocked.Get(element).R;
+        foreach (var element in Strings)
+            sum += _unlocked.Get(element).Length;
+        return sum;
+    }
+
+    [Benchmark]
+    public void RenderFrame_Locked()
+    {
+        _surface.Clear();
+        _lockedContext.RenderChild(_frame);
+    }
+
+    [Benchmark]
+    public void RenderFrame_Unlocked()
+    {
+        _surface.Clear();
+        _unlockedContext.RenderChild(_frame);
+    }
+
+    /// <summary>
+    /// Theme lookup as it was before element slots: by name, boxed, with recursive fallback.
+    /// </summary>
+    private sealed class DictionaryTheme
+    {
+        private readonly Dictionary<string, object> _values = new();
+
+        public T Get<T>(Hex1bThemeElement<T> element)
+        {
+            if (_values.TryGetValue(element.Name, out var value) && value is T typedValue)
+                return typedValue;
+            if (element.Fallback != null)
+                return Get(element.Fallback);
+            return element.DefaultValue();
+        }
+
+        public DictionaryTheme Set<T>(Hex1bThemeElement<T> element, T value)
+        {
+            _values[element.Name] = value!;
+            return this;
+        }
+    }
+}
@@ -8,6 +8,7 @@ namespace Hex1b.McpServer;
 internal sealed class CapturingPresentationAdapter : IHex1bTerminalPresentationAdapter
 {
     private readonly TaskCompletionSource _disconnected = new();
+    private long _bytesWritten;
     private int _width;
     private int _height;
 
@@ -20,6 +21,11 @@ internal sealed class CapturingPresentationAdapter : IHex1bTerminalPresentationA
     public int Width => _width;
     public int Height => _height;
 
+    /// <summary>
+    /// Gets the number of output bytes the terminal has written.
+    /// </summary>
+    public long BytesWritten => Interlocked.Read(ref _bytesWritten);
+
     public TerminalCapabilities Capabilities => new()
     {
         SupportsMouse = false,
@@ -35,6 +41,7 @@ internal sealed class CapturingPresentationAdapter : IHex1bTerminalPresentationA
     public ValueTask WriteOutputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default)
     {
         // Discard output - the terminal's screen buffer captures everything
+        Interlocked.Add(ref _bytesWritten, data.Length);
         return ValueTask.CompletedTask;
     }
 
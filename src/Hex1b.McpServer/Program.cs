@@ -13,7 +13,9 @@ builder.Logging.AddConsole(consoleLogOptions =>
     consoleLogOptions.LogToStandardErrorThreshold = LogLevel.Trace;
 });
 
-// Register the terminal session manager as a singleton
+// Register the terminal session manager as a singleton. The warm shell pool and the session
+// limit are configured with HEX1B_MCP_WARM_SESSIONS, HEX1B_MCP_POOL_SHELL and HEX1B_MCP_MAX_SESSIONS.
+builder.Services.AddSingleton(TerminalSessionPoolOptions.FromEnvironment());
 builder.Services.AddSingleton<TerminalSessionManager>();
 
 builder.Services
@@ -4,6 +4,7 @@ using System.Text;
 using System.Text.Json;
 using System.Text.Json.Serialization;
 using Hex1b.Automation;
+using Hex1b.Diagnostics;
 
 namespace Hex1b.McpServer;
 
@@ -20,6 +21,8 @@ public sealed class RemoteTerminalTarget : ITerminalTarget
 
     private readonly string _socketPath;
     private readonly string _id;
+    private readonly object _mirrorLock = new();
+    private TerminalScreenMirrorReader? _mirror;
     private bool _disposed;
 
     /// <summary>
@@ -150,6 +153,10 @@ public sealed class RemoteTerminalTarget : ITerminalTarget
     /// <inheritdoc />
     public async Task<string> CaptureTextAsync(CancellationToken ct = default)
     {
+        // Read the shared-memory screen mirror when the application publishes one
+        if (TryReadMirror() is { } frame)
+            return frame.GetText();
+
         // Use "text" format for plain text - returns cells in row/column order without ANSI codes
         var response = await SendRequestAsync<CaptureResponse>(new { method = "capture", format = "text" }, ct);
         return response.Data ?? "";
@@ -194,6 +201,18 @@ public sealed class RemoteTerminalTarget : ITerminalTarget
         return false;
     }
 
+    private TerminalScreenMirrorFrame? TryReadMirror()
+    {
+        lock (_mirrorLock)
+        {
+            if (_disposed)
+                return null;
+
+            _mirror ??= TerminalScreenMirrorReader.TryOpenForSocket(_socketPath);
+            return _mirror?.TryRead();
+        }
+    }
+
     private async Task<T> SendRequestAsync<T>(object request, CancellationToken ct) where T : BasicResponse, new()
     {
         using var socket = new Socket(AddressFamily.Unix, SocketType.Stream, ProtocolType.Unspecified);
@@ -322,7 +341,12 @@ public sealed class RemoteTerminalTarget : ITerminalTarget
     /// <inheritdoc />
     public ValueTask DisposeAsync()
     {
-        _disposed = true;
+        lock (_mirrorLock)
+        {
+            _disposed = true;
+            _mirror?.Dispose();
+            _mirror = null;
+        }
         return ValueTask.CompletedTask;
     }
 
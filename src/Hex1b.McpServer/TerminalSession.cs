@@ -1,3 +1,5 @@
+using System.Buffers;
+using System.Diagnostics;
 using System.Text;
 using Hex1b.Automation;
 using Hex1b.Theming;
@@ -10,11 +12,19 @@ namespace Hex1b.McpServer;
 /// </summary>
 public sealed class TerminalSession : IAsyncDisposable
 {
+    private static readonly TimeSpan PromptGracePeriod = TimeSpan.FromMilliseconds(500);
+
     private readonly Hex1bTerminalChildProcess _process;
     private readonly Hex1bTerminal _terminal;
     private readonly CapturingPresentationAdapter _presentation;
     private readonly AsciinemaRecorder _asciinemaRecorder;
     private readonly CancellationTokenSource _cts = new();
+    private readonly object _svgLock = new();
+    private readonly ArrayBufferWriter<char> _svgBuffer = new();
+    private TerminalSvgRenderer? _svgRenderer;
+    private readonly object _exitLock = new();
+    private Task<int>? _exitTask;
+    private long _inputBytes;
     private bool _disposed;
     private int _width;
     private int _height;
@@ -22,7 +32,7 @@ public sealed class TerminalSession : IAsyncDisposable
     /// <summary>
     /// Gets the unique identifier for this session.
     /// </summary>
-    public string Id { get; }
+    public string Id { get; internal set; }
 
     /// <summary>
     /// Gets the terminal width in columns.
@@ -37,7 +47,7 @@ public sealed class TerminalSession : IAsyncDisposable
     /// <summary>
     /// Gets when this session was started.
     /// </summary>
-    public DateTimeOffset StartedAt { get; }
+    public DateTimeOffset StartedAt { get; internal set; }
 
     /// <summary>
     /// Gets the command that was executed.
@@ -52,7 +62,7 @@ public sealed class TerminalSession : IAsyncDisposable
     /// <summary>
     /// Gets the working directory for the process.
     /// </summary>
-    public string? WorkingDirectory { get; }
+    public string? WorkingDirectory { get; internal set; }
 
     /// <summary>
     /// Gets the process ID of the child process. Returns -1 if not started.
@@ -85,6 +95,16 @@ public sealed class TerminalSession : IAsyncDisposable
     /// </summary>
     public string? ActiveRecordingPath => _asciinemaRecorder.FilePath;
 
+    /// <summary>
+    /// Gets whether this session runs a shell from the manager's warm pool.
+    /// </summary>
+    public bool IsPooled { get; internal set; }
+
+    /// <summary>
+    /// Gets how many times this session's shell was reset and handed out again by the pool.
+    /// </summary>
+    public int ReuseCount { get; internal set; }
+
     private TerminalSession(
         string id,
         Hex1bTerminalChildProcess process,
@@ -197,6 +217,7 @@ public sealed class TerminalSession : IAsyncDisposable
             return;
 
         var bytes = Encoding.UTF8.GetBytes(text);
+        Interlocked.Add(ref _inputBytes, bytes.Length);
         await _process.WriteInputAsync(bytes, ct);
     }
 
@@ -214,6 +235,7 @@ public sealed class TerminalSession : IAsyncDisposable
         var bytes = TranslateKey(key, modifiers);
         if (bytes.Length > 0)
         {
+            Interlocked.Add(ref _inputBytes, bytes.Length);
             await _process.WriteInputAsync(bytes, ct);
         }
     }
@@ -252,7 +274,51 @@ public sealed class TerminalSession : IAsyncDisposable
     public string CaptureSvg(TerminalSvgOptions? options = null)
     {
         using var snapshot = _terminal.CreateSnapshot();
-        return snapshot.ToSvg(options);
+        if (options is not null)
+            return snapshot.ToSvg(options);
+
+        lock (_svgLock)
+        {
+            RenderSvg(snapshot);
+            return new string(_svgBuffer.WrittenSpan);
+        }
+    }
+
+    /// <summary>
+    /// Captures the current terminal screen as SVG and writes it to a file.
+    /// </summary>
+    /// <param name="path">The file to write.</param>
+    /// <remarks>
+    /// Repeated captures share one <see cref="TerminalSvgRenderer"/>, so rows that haven't changed
+    /// since the previous capture are not rendered again.
+    /// </remarks>
+    public void SaveSvg(string path)
+    {
+        using var snapshot = _terminal.CreateSnapshot();
+        lock (_svgLock)
+        {
+            RenderSvg(snapshot);
+            using var writer = new StreamWriter(path, append: false, new UTF8Encoding(encoderShouldEmitUTF8Identifier: false));
+            writer.Write(_svgBuffer.WrittenSpan);
+        }
+    }
+
+    private void RenderSvg(Hex1bTerminalSnapshot snapshot)
+    {
+        // Default options follow the snapshot's cell size, as ToSvg does
+        if (_svgRenderer is null
+            || _svgRenderer.Options.CellWidth != snapshot.CellPixelWidth
+            || _svgRenderer.Options.CellHeight != snapshot.CellPixelHeight)
+        {
+            _svgRenderer = new TerminalSvgRenderer(new TerminalSvgOptions
+            {
+                CellWidth = snapshot.CellPixelWidth,
+                CellHeight = snapshot.CellPixelHeight
+            });
+        }
+
+        _svgBuffer.Clear();
+        _svgRenderer.Render(snapshot, _svgBuffer);
     }
 
     /// <summary>
@@ -269,13 +335,20 @@ public sealed class TerminalSession : IAsyncDisposable
 
         try
         {
+            // One full check, then only re-check the rows that changed each time the
+            // screen generation advances — no snapshots and no polling while idle.
+            var generation = _terminal.ScreenGeneration;
+            if (ScreenContainsText(text))
+                return true;
+
             while (!cts.Token.IsCancellationRequested)
             {
-                using var snapshot = _terminal.CreateSnapshot();
-                if (snapshot.ContainsText(text))
-                    return true;
+                var current = await _terminal.WaitForScreenChangeAsync(generation, cts.Token);
+                var found = ChangedRowsContainText(text, generation);
+                generation = current;
 
-                await Task.Delay(100, cts.Token);
+                if (found)
+                    return true;
             }
         }
         catch (OperationCanceledException) when (!ct.IsCancellationRequested)
@@ -286,6 +359,163 @@ public sealed class TerminalSession : IAsyncDisposable
         return false;
     }
 
+    /// <summary>
+    /// Gets the terminal's screen generation, which advances with every change to the screen.
+    /// </summary>
+    internal long ScreenGeneration => _terminal.ScreenGeneration;
+
+    /// <summary>
+    /// Waits until the screen generation advances past <paramref name="sinceGeneration"/>.
+    /// </summary>
+    internal Task<long> WaitForScreenChangeAsync(long sinceGeneration, CancellationToken ct)
+        => _terminal.WaitForScreenChangeAsync(sinceGeneration, ct);
+
+    /// <summary>
+    /// Gets a task that completes with the exit code when the process exits, shared by all
+    /// callers and only cancelled when the session is disposed.
+    /// </summary>
+    /// <remarks>
+    /// Waiting for the child blocks a thread between polls, so the wait runs on the thread pool
+    /// and is started once, on first use, rather than by every waiter.
+    /// </remarks>
+    internal Task<int> ExitTask
+    {
+        get
+        {
+            lock (_exitLock)
+            {
+                return _exitTask ??= Task.Run(() => _process.WaitForExitAsync(_cts.Token));
+            }
+        }
+    }
+
+    /// <summary>
+    /// Checks whether the whole screen contains <paramref name="text"/>.
+    /// </summary>
+    internal bool ScreenContainsText(string text)
+    {
+        using var snapshot = _terminal.CreateSnapshot();
+        return snapshot.ContainsText(text);
+    }
+
+    /// <summary>
+    /// Checks whether any row changed after <paramref name="sinceGeneration"/> contains
+    /// <paramref name="text"/>, without copying the screen.
+    /// </summary>
+    internal bool ChangedRowsContainText(string text, long sinceGeneration)
+        => _terminal.RowsContainText(text, _terminal.GetChangedRows(sinceGeneration));
+
+    /// <summary>
+    /// Gets the bytes exchanged with the session and the current CPU time and working set of
+    /// its process.
+    /// </summary>
+    /// <remarks>
+    /// CPU time and working set cover the session's own process (usually the shell), not the
+    /// commands it runs, and are null once the process has exited.
+    /// </remarks>
+    public TerminalSessionResourceUsage GetResourceUsage()
+    {
+        TimeSpan? cpuTime = null;
+        long? workingSet = null;
+        if (!HasExited)
+        {
+            try
+            {
+                using var process = Process.GetProcessById(ProcessId);
+                cpuTime = process.TotalProcessorTime;
+                workingSet = process.WorkingSet64;
+            }
+            catch
+            {
+                // The process exited or can't be inspected
+            }
+        }
+
+        return new TerminalSessionResourceUsage(
+            Interlocked.Read(ref _inputBytes),
+            _presentation.BytesWritten,
+            cpuTime,
+            workingSet);
+    }
+
+    /// <summary>
+    /// Types a command line into the shell and waits until it has set the window title to
+    /// <paramref name="titleMarker"/>.
+    /// </summary>
+    /// <remarks>
+    /// The title is used as the completion signal because the command's echo on screen can't
+    /// be told apart from its output, while an OSC title change only comes from running it.
+    /// </remarks>
+    /// <param name="commandLine">The command line, including the final carriage return. Its last
+    /// command sets the title to <paramref name="titleMarker"/>.</param>
+    /// <param name="titleMarker">The title that signals the command line has run.</param>
+    /// <param name="interruptFirst">Send Ctrl+C and let the shell return to its prompt before
+    /// typing, so a running foreground job doesn't swallow the command.</param>
+    /// <param name="timeout">How long to wait for the title.</param>
+    /// <param name="ct">Cancellation token.</param>
+    /// <returns>True once the title was set and the shell has had a moment to draw its prompt;
+    /// false on timeout or if the process exited.</returns>
+    internal async Task<bool> RunUntilTitleAsync(string commandLine, string titleMarker, bool interruptFirst, TimeSpan timeout, CancellationToken ct)
+    {
+        if (_disposed || _process.HasExited)
+            return false;
+
+        var marked = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        void OnTitleChanged(string title)
+        {
+            if (title == titleMarker)
+                marked.TrySetResult();
+        }
+
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(ct);
+        cts.CancelAfter(timeout);
+        _terminal.WindowTitleChanged += OnTitleChanged;
+        try
+        {
+            if (interruptFirst)
+            {
+                // The line discipline flushes pending input on SIGINT, so the command is only
+                // typed once the shell has redrawn its prompt.
+                var generation = _terminal.ScreenGeneration;
+                await _process.WriteInputAsync(new byte[] { 0x03 }, cts.Token);
+                await _terminal.WaitForScreenChangeAsync(generation, cts.Token);
+                await Task.Delay(50, cts.Token);
+            }
+
+            await _process.WriteInputAsync(Encoding.UTF8.GetBytes(commandLine), cts.Token);
+            await marked.Task.WaitAsync(cts.Token);
+
+            // The prompt follows. Give it a moment, so input typed next isn't echoed by the
+            // line discipline before the shell has started reading.
+            var promptGeneration = _terminal.ScreenGeneration;
+            using (var snapshot = _terminal.CreateSnapshot())
+            {
+                if (snapshot.CursorX > 0 || snapshot.CursorY > 0)
+                    return !_process.HasExited;
+            }
+
+            using var promptCts = CancellationTokenSource.CreateLinkedTokenSource(cts.Token);
+            promptCts.CancelAfter(PromptGracePeriod);
+            try
+            {
+                await _terminal.WaitForScreenChangeAsync(promptGeneration, promptCts.Token);
+            }
+            catch (OperationCanceledException) when (!cts.IsCancellationRequested)
+            {
+                // A shell with an empty prompt
+            }
+            return !_process.HasExited;
+        }
+        catch (OperationCanceledException) when (!ct.IsCancellationRequested)
+        {
+            return false;
+        }
+        finally
+        {
+            _terminal.WindowTitleChanged -= OnTitleChanged;
+        }
+    }
+
     /// <summary>
     /// Waits for the process to exit.
     /// </summary>
@@ -325,12 +555,12 @@ public sealed class TerminalSession : IAsyncDisposable
             throw new ObjectDisposedException(nameof(TerminalSession));
 
         // Start recording - dimensions are automatically inferred from the session
-        _asciinemaRecorder.StartRecording(filePath, options ?? new AsciinemaRecorderOptions
+        await _asciinemaRecorder.StartRecordingAsync(filePath, options ?? new AsciinemaRecorderOptions
         {
             AutoFlush = true,
             Title = $"{Command} session",
             Command = Command
-        });
+        }, ct);
 
         // Synthesize current terminal state and write as initial event
         var initialState = SynthesizeTerminalState();
@@ -483,6 +713,20 @@ public sealed class TerminalSession : IAsyncDisposable
         await _process.DisposeAsync();
         _terminal.Dispose();
         await _presentation.DisposeAsync();
+        _cts.Cancel();
         _cts.Dispose();
     }
 }
+
+/// <summary>
+/// Resource usage of a terminal session.
+/// </summary>
+/// <param name="InputBytes">Bytes of input sent to the session.</param>
+/// <param name="OutputBytes">Bytes of output the session's terminal produced.</param>
+/// <param name="CpuTime">CPU time used by the session's process, or null if it has exited.</param>
+/// <param name="WorkingSetBytes">Working set of the session's process, or null if it has exited.</param>
+public sealed record TerminalSessionResourceUsage(
+    long InputBytes,
+    long OutputBytes,
+    TimeSpan? CpuTime,
+    long? WorkingSetBytes);
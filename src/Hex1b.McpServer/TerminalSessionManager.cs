@@ -6,17 +6,55 @@ namespace Hex1b.McpServer;
 /// Manages multiple terminal sessions with thread-safe operations.
 /// Supports both local sessions (launched by MCP server) and remote targets (connected via UDS).
 /// </summary>
+/// <remarks>
+/// With <see cref="TerminalSessionPoolOptions.WarmSessionCount"/> set, shell sessions are served
+/// from a pool of pre-spawned shells, and removing a pooled session resets its shell for the
+/// next request instead of killing it. With <see cref="TerminalSessionPoolOptions.MaxConcurrentSessions"/>
+/// set, start requests queue until a running session exits or is removed.
+/// </remarks>
 public sealed class TerminalSessionManager : IAsyncDisposable
 {
     private readonly ConcurrentDictionary<string, TerminalSession> _sessions = new();
     private readonly ConcurrentDictionary<string, ITerminalTarget> _targets = new();
+    private readonly TerminalSessionPoolOptions _options;
+    private readonly TerminalSessionPool? _pool;
+    private readonly SemaphoreSlim? _slots;
+
+    // Sessions holding a concurrency slot, mapped to the lease taken when they started. A pooled
+    // shell can be handed out again, so a release only counts if its lease is still current.
+    private readonly ConcurrentDictionary<TerminalSession, object> _slotLeases = new();
     private bool _disposed;
 
+    /// <summary>
+    /// Creates a session manager without a warm pool or a session limit.
+    /// </summary>
+    public TerminalSessionManager()
+        : this(new TerminalSessionPoolOptions())
+    {
+    }
+
+    /// <summary>
+    /// Creates a session manager with the given pool and session limit options.
+    /// </summary>
+    public TerminalSessionManager(TerminalSessionPoolOptions options)
+    {
+        _options = options;
+        if (options.WarmSessionCount > 0 && !OperatingSystem.IsWindows())
+            _pool = new TerminalSessionPool(options);
+        if (options.MaxConcurrentSessions is int max && max > 0)
+            _slots = new SemaphoreSlim(max, max);
+    }
+
     /// <summary>
     /// Gets the number of active sessions.
     /// </summary>
     public int SessionCount => _sessions.Count;
 
+    /// <summary>
+    /// Gets the number of pre-spawned shells waiting in the warm pool.
+    /// </summary>
+    public int WarmSessionCount => _pool?.IdleCount ?? 0;
+
     /// <summary>
     /// Gets the number of all targets (local + remote).
     /// </summary>
@@ -41,6 +79,32 @@ public sealed class TerminalSessionManager : IAsyncDisposable
         return [.. _targets.Values];
     }
 
+    /// <summary>
+    /// Waits for text on several targets at once, local and remote.
+    /// </summary>
+    /// <param name="conditions">The texts to wait for, one per target. A target may appear more than once.</param>
+    /// <param name="waitForAll">True to wait until every condition is met, false to return as soon as one is.</param>
+    /// <param name="timeout">Maximum time to wait.</param>
+    /// <param name="ct">Cancellation token.</param>
+    /// <returns>One result per condition, in the order given.</returns>
+    /// <exception cref="ArgumentException">A condition names a target that doesn't exist.</exception>
+    public Task<IReadOnlyList<TerminalTextWaitResult>> WaitForTextAsync(
+        IReadOnlyList<TerminalTextCondition> conditions,
+        bool waitForAll,
+        TimeSpan timeout,
+        CancellationToken ct = default)
+    {
+        var resolved = new List<(TerminalTextCondition, ITerminalTarget)>(conditions.Count);
+        foreach (var condition in conditions)
+        {
+            var target = GetTarget(condition.SessionId)
+                ?? throw new ArgumentException($"Session '{condition.SessionId}' not found.", nameof(conditions));
+            resolved.Add((condition, target));
+        }
+
+        return new TerminalTextWaiter(resolved, waitForAll).WaitAsync(timeout, ct);
+    }
+
     /// <summary>
     /// Connects to a remote Hex1b application by process ID.
     /// </summary>
@@ -208,19 +272,37 @@ public sealed class TerminalSessionManager : IAsyncDisposable
         if (_disposed)
             throw new ObjectDisposedException(nameof(TerminalSessionManager));
 
-        var session = await TerminalSession.StartAsync(
-            id,
-            command,
-            arguments,
-            workingDirectory,
-            environment,
-            width,
-            height,
-            asciinemaFilePath,
-            ct);
+        await AcquireSlotAsync(ct);
+
+        TerminalSession session;
+        try
+        {
+            TerminalSession? pooled = null;
+            if (_pool != null && _pool.Matches(command, arguments, environment, asciinemaFilePath))
+                pooled = await _pool.TryTakeAsync(id, workingDirectory, width, height, ct);
+
+            session = pooled ?? await TerminalSession.StartAsync(
+                id,
+                command,
+                arguments,
+                workingDirectory,
+                environment,
+                width,
+                height,
+                asciinemaFilePath,
+                ct);
+        }
+        catch
+        {
+            _slots?.Release();
+            throw;
+        }
+
+        TrackSlot(session);
 
         if (!_sessions.TryAdd(id, session))
         {
+            ReleaseSlot(session);
             await session.DisposeAsync();
             throw new InvalidOperationException($"A session with ID '{id}' already exists.");
         }
@@ -232,6 +314,72 @@ public sealed class TerminalSessionManager : IAsyncDisposable
         return session;
     }
 
+    private async Task AcquireSlotAsync(CancellationToken ct)
+    {
+        if (_slots == null)
+            return;
+
+        if (!await _slots.WaitAsync(_options.SessionQueueTimeout, ct))
+        {
+            throw new InvalidOperationException(
+                $"The limit of {_options.MaxConcurrentSessions} concurrent sessions was reached. Remove a session and try again.");
+        }
+    }
+
+    private void TrackSlot(TerminalSession session)
+    {
+        if (_slots == null)
+            return;
+
+        var lease = new object();
+        _slotLeases[session] = lease;
+        _ = ReleaseSlotOnExitAsync(session, lease);
+    }
+
+    private async Task ReleaseSlotOnExitAsync(TerminalSession session, object lease)
+    {
+        try
+        {
+            await session.WaitForExitAsync();
+        }
+        catch
+        {
+            // Disposed before it exited; removal released the slot
+        }
+
+        ReleaseSlot(session, lease);
+    }
+
+    private void ReleaseSlot(TerminalSession session, object? lease = null)
+    {
+        if (_slots == null)
+            return;
+
+        var released = lease == null
+            ? _slotLeases.TryRemove(session, out _)
+            : _slotLeases.TryRemove(KeyValuePair.Create(session, lease));
+        if (released)
+            _slots.Release();
+    }
+
+    /// <summary>
+    /// Releases a removed session: pooled shells that are still running go back to the pool,
+    /// everything else is disposed.
+    /// </summary>
+    private async Task ReleaseSessionAsync(TerminalSession session)
+    {
+        ReleaseSlot(session);
+
+        if (_pool != null && session.IsPooled && !session.HasExited)
+        {
+            // Resetting takes a round trip through the shell; don't hold up the caller
+            _ = _pool.ReturnAsync(session);
+            return;
+        }
+
+        await session.DisposeAsync();
+    }
+
     /// <summary>
     /// Gets a session by ID.
     /// </summary>
@@ -272,7 +420,10 @@ public sealed class TerminalSessionManager : IAsyncDisposable
             ProcessId = s.ProcessId,
             AsciinemaFilePath = s.AsciinemaFilePath,
             IsRecording = s.IsRecording,
-            ActiveRecordingPath = s.ActiveRecordingPath
+            ActiveRecordingPath = s.ActiveRecordingPath,
+            IsPooled = s.IsPooled,
+            ReuseCount = s.ReuseCount,
+            ResourceUsage = s.GetResourceUsage()
         }).ToList();
     }
 
@@ -307,7 +458,7 @@ public sealed class TerminalSessionManager : IAsyncDisposable
         if (!_sessions.TryRemove(id, out var session))
             return false;
 
-        await session.DisposeAsync();
+        await ReleaseSessionAsync(session);
         return true;
     }
 
@@ -326,6 +477,7 @@ public sealed class TerminalSessionManager : IAsyncDisposable
             return false;
 
         session.Kill(signal);
+        ReleaseSlot(session);
         await session.DisposeAsync();
         return true;
     }
@@ -342,6 +494,7 @@ public sealed class TerminalSessionManager : IAsyncDisposable
         foreach (var session in sessions)
         {
             session.Kill();
+            ReleaseSlot(session);
             await session.DisposeAsync();
         }
     }
@@ -362,6 +515,8 @@ public sealed class TerminalSessionManager : IAsyncDisposable
         {
             if (_sessions.TryRemove(id, out var session))
             {
+                _targets.TryRemove(id, out _);
+                ReleaseSlot(session);
                 await session.DisposeAsync();
                 cleanedUp.Add(id);
             }
@@ -384,6 +539,8 @@ public sealed class TerminalSessionManager : IAsyncDisposable
 
         _disposed = true;
         await StopAllSessionsAsync();
+        if (_pool != null)
+            await _pool.DisposeAsync();
     }
 }
 
@@ -456,4 +613,19 @@ public class SessionInfo
     /// The path to the currently active asciinema recording, or null if not recording.
     /// </summary>
     public string? ActiveRecordingPath { get; init; }
+
+    /// <summary>
+    /// Whether the session runs a shell from the warm pool.
+    /// </summary>
+    public bool IsPooled { get; init; }
+
+    /// <summary>
+    /// How many times the session's shell was reset and reused by the pool.
+    /// </summary>
+    public int ReuseCount { get; init; }
+
+    /// <summary>
+    /// Bytes exchanged with the session and the resource usage of its process.
+    /// </summary>
+    public TerminalSessionResourceUsage? ResourceUsage { get; init; }
 }
@@ -0,0 +1,282 @@
+using System.Text;
+
+namespace Hex1b.McpServer;
+
+/// <summary>
+/// Keeps pre-spawned shell sessions ready so starting a session doesn't pay for forking the
+/// PTY, starting the shell and building the terminal.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Idle sessions are handed out by <see cref="TryTakeAsync"/> and the pool tops itself up in
+/// the background. A new shell only joins the pool once its startup files have run and its
+/// screen has been cleared, so callers get a prompt on a blank screen. Released sessions are
+/// reset and returned when <see cref="TerminalSessionPoolOptions.ReuseReleasedSessions"/> is
+/// set: the reset interrupts the foreground job, changes back to the pool's directory and
+/// re-executes the shell through a script that restores the environment the pool started with,
+/// then clears the screen with RIS once the new shell reads input.
+/// </para>
+/// <para>
+/// Commands typed by the pool start with a space so shells that honor
+/// <c>HISTCONTROL=ignorespace</c> keep them out of the history.
+/// </para>
+/// </remarks>
+internal sealed class TerminalSessionPool : IAsyncDisposable
+{
+    private readonly TerminalSessionPoolOptions _options;
+    private readonly Queue<TerminalSession> _idle = new();
+    private readonly object _lock = new();
+    private readonly string _homeDirectory;
+    private readonly string _resetScriptPath;
+    private int _spawning;
+    private bool _disposed;
+
+    public TerminalSessionPool(TerminalSessionPoolOptions options)
+    {
+        _options = options;
+        _homeDirectory = Environment.CurrentDirectory;
+        _resetScriptPath = WriteResetScript(options);
+        Replenish();
+    }
+
+    /// <summary>
+    /// Gets the number of idle sessions ready to be handed out.
+    /// </summary>
+    public int IdleCount
+    {
+        get
+        {
+            lock (_lock)
+            {
+                return _idle.Count;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets the path of the script that re-executes a released shell.
+    /// </summary>
+    internal string ResetScriptPath => _resetScriptPath;
+
+    /// <summary>
+    /// Whether a start request can be served by a pooled shell.
+    /// </summary>
+    public bool Matches(string command, string[] arguments, Dictionary<string, string>? environment, string? asciinemaFilePath)
+    {
+        return command == _options.Shell
+            && arguments.AsSpan().SequenceEqual(_options.ShellArguments)
+            && (environment is null || environment.Count == 0)
+            && string.IsNullOrWhiteSpace(asciinemaFilePath);
+    }
+
+    /// <summary>
+    /// Takes an idle session and prepares it for <paramref name="id"/>, or returns null if none
+    /// is ready or the working directory couldn't be entered.
+    /// </summary>
+    public async Task<TerminalSession?> TryTakeAsync(string id, string? workingDirectory, int width, int height, CancellationToken ct)
+    {
+        while (true)
+        {
+            TerminalSession? session;
+            lock (_lock)
+            {
+                if (_disposed || !_idle.TryDequeue(out session))
+                    return null;
+            }
+            Replenish();
+
+            if (session.HasExited)
+            {
+                await session.DisposeAsync();
+                continue;
+            }
+
+            if (session.Width != width || session.Height != height)
+                await session.ResizeAsync(width, height, ct);
+
+            if (workingDirectory is not null
+                && (!Directory.Exists(workingDirectory)
+                    || !await RunAsync(session, $"cd -- {Quote(workingDirectory)} &&", interruptFirst: false, ct)))
+            {
+                // Let the caller start a fresh session, which reports a bad directory properly
+                await session.DisposeAsync();
+                return null;
+            }
+
+            session.Id = id;
+            session.WorkingDirectory = workingDirectory;
+            session.StartedAt = DateTimeOffset.UtcNow;
+            return session;
+        }
+    }
+
+    /// <summary>
+    /// Resets a released session and returns it to the pool, or disposes it if it can't be
+    /// reused or the pool is full.
+    /// </summary>
+    public async Task ReturnAsync(TerminalSession session)
+    {
+        if (!CanReuse(session)
+            // The clear is typed ahead and runs in the re-executed shell, after its startup
+            // files, so their output is cleared too
+            || !await RunAsync(session, $"cd -- {Quote(_homeDirectory)} && . {Quote(_resetScriptPath)}\r", interruptFirst: true, CancellationToken.None))
+        {
+            await session.DisposeAsync();
+            return;
+        }
+
+        lock (_lock)
+        {
+            // A reset shell beats one still spawning; a spawn that finishes into a full pool
+            // is discarded
+            if (!_disposed && _idle.Count < _options.WarmSessionCount)
+            {
+                session.Id = NewWarmId();
+                session.WorkingDirectory = null;
+                session.ReuseCount++;
+                _idle.Enqueue(session);
+                return;
+            }
+        }
+
+        await session.DisposeAsync();
+    }
+
+    private bool CanReuse(TerminalSession session)
+    {
+        if (!_options.ReuseReleasedSessions || !session.IsPooled || session.HasExited || session.IsRecording)
+            return false;
+
+        lock (_lock)
+        {
+            return !_disposed && _idle.Count < _options.WarmSessionCount;
+        }
+    }
+
+    private void Replenish()
+    {
+        lock (_lock)
+        {
+            while (!_disposed && _idle.Count + _spawning < _options.WarmSessionCount)
+            {
+                _spawning++;
+                _ = Task.Run(SpawnAsync);
+            }
+        }
+    }
+
+    private async Task SpawnAsync()
+    {
+        TerminalSession? session = null;
+        try
+        {
+            session = await TerminalSession.StartAsync(
+                NewWarmId(),
+                _options.Shell,
+                _options.ShellArguments,
+                workingDirectory: null,
+                environment: null,
+                _options.Width,
+                _options.Height);
+            session.IsPooled = true;
+
+            if (!await RunAsync(session, "", interruptFirst: false, CancellationToken.None))
+            {
+                await session.DisposeAsync();
+                session = null;
+            }
+        }
+        catch
+        {
+            // Leave the slot empty; the next take tries again
+            if (session is not null)
+                await session.DisposeAsync();
+            session = null;
+        }
+
+        lock (_lock)
+        {
+            _spawning--;
+            if (session is not null && !_disposed && _idle.Count < _options.WarmSessionCount)
+            {
+                _idle.Enqueue(session);
+                return;
+            }
+        }
+
+        if (session is not null)
+            await session.DisposeAsync();
+    }
+
+    /// <summary>
+    /// Types <paramref name="prefix"/> followed by a command that clears the screen with RIS and
+    /// flashes a one-off window title, and waits for that title.
+    /// </summary>
+    private Task<bool> RunAsync(TerminalSession session, string prefix, bool interruptFirst, CancellationToken ct)
+    {
+        var marker = $"hex1b-pool-{Guid.NewGuid():N}";
+        var commandLine = $" {prefix} printf '\\033c\\033]2;%s\\007\\033]2;\\007' {marker}\r";
+        return session.RunUntilTitleAsync(commandLine, marker, interruptFirst, _options.ResetTimeout, ct);
+    }
+
+    private static string NewWarmId() => $"warm-{Guid.NewGuid():N}"[..12];
+
+    private static string Quote(string value) => "'" + value.Replace("'", "'\\''") + "'";
+
+    /// <summary>
+    /// Writes a script that re-executes the shell with the environment a fresh pooled session
+    /// starts with, so a reused shell doesn't keep variables exported by its previous user.
+    /// </summary>
+    private static string WriteResetScript(TerminalSessionPoolOptions options)
+    {
+        // Mirror what Hex1bTerminalChildProcess gives a new child: the inherited environment,
+        // a default TERM and the nesting level bumped by one.
+        var environment = new SortedDictionary<string, string>(StringComparer.Ordinal);
+        foreach (System.Collections.DictionaryEntry entry in Environment.GetEnvironmentVariables())
+        {
+            if (entry.Key is string key && entry.Value is string value)
+                environment[key] = value;
+        }
+        environment.TryAdd("TERM", "xterm-256color");
+        environment["HEX1B_NESTING_LEVEL"] =
+            (int.TryParse(environment.GetValueOrDefault("HEX1B_NESTING_LEVEL"), out var level) ? level + 1 : 1).ToString();
+
+        var script = new StringBuilder("exec env -i");
+        foreach (var (key, value) in environment)
+            script.Append(' ').Append(Quote($"{key}={value}"));
+        script.Append(' ').Append(Quote(options.Shell));
+        foreach (var argument in options.ShellArguments)
+            script.Append(' ').Append(Quote(argument));
+        script.Append('\n');
+
+        // The script holds the server's environment, so only the current user may read it
+        var path = Path.Combine(Path.GetTempPath(), $"hex1b-pool-{Environment.ProcessId}-{Guid.NewGuid():N}.sh");
+        var fileOptions = new FileStreamOptions { Mode = FileMode.CreateNew, Access = FileAccess.Write };
+        if (!OperatingSystem.IsWindows())
+            fileOptions.UnixCreateMode = UnixFileMode.UserRead | UnixFileMode.UserWrite;
+        using (var writer = new StreamWriter(path, new UTF8Encoding(encoderShouldEmitUTF8Identifier: false), fileOptions))
+            writer.Write(script.ToString());
+
+        return path;
+    }
+
+    /// <inheritdoc />
+    public async ValueTask DisposeAsync()
+    {
+        List<TerminalSession> idle;
+        lock (_lock)
+        {
+            if (_disposed)
+                return;
+            _disposed = true;
+            idle = [.. _idle];
+            _idle.Clear();
+        }
+
+        foreach (var session in idle)
+            await session.DisposeAsync();
+
+        try { File.Delete(_resetScriptPath); }
+        catch { /* ignore */ }
+    }
+}
@@ -0,0 +1,88 @@
+namespace Hex1b.McpServer;
+
+/// <summary>
+/// Options for the warm shell pool and the concurrent session limit of a
+/// <see cref="TerminalSessionManager"/>.
+/// </summary>
+public sealed class TerminalSessionPoolOptions
+{
+    /// <summary>
+    /// Number of pre-spawned shells kept ready. Zero (the default) disables the pool.
+    /// </summary>
+    /// <remarks>
+    /// Warm shells are only used on Linux and macOS, and only for sessions that start
+    /// <see cref="Shell"/> with <see cref="ShellArguments"/>, no extra environment variables
+    /// and no recording file.
+    /// </remarks>
+    public int WarmSessionCount { get; set; }
+
+    /// <summary>
+    /// Shell command the pool pre-spawns. Must be POSIX-compatible, since sessions are reset
+    /// with <c>cd</c>, <c>printf</c> and <c>exec</c>. Defaults to <c>bash</c>.
+    /// </summary>
+    public string Shell { get; set; } = "bash";
+
+    /// <summary>
+    /// Arguments for <see cref="Shell"/>.
+    /// </summary>
+    public string[] ShellArguments { get; set; } = [];
+
+    /// <summary>
+    /// Terminal width of pre-spawned shells. Acquired sessions are resized to the requested size.
+    /// </summary>
+    public int Width { get; set; } = 80;
+
+    /// <summary>
+    /// Terminal height of pre-spawned shells. Acquired sessions are resized to the requested size.
+    /// </summary>
+    public int Height { get; set; } = 24;
+
+    /// <summary>
+    /// Whether removing a still-running pooled session resets its shell and returns it to the
+    /// pool instead of killing it. Defaults to true.
+    /// </summary>
+    /// <remarks>
+    /// The reset interrupts the foreground job, returns to the home directory, re-executes the
+    /// shell with the environment the pool started with and clears the screen with RIS. A session
+    /// whose screen doesn't come back clean within <see cref="ResetTimeout"/> is killed instead.
+    /// </remarks>
+    public bool ReuseReleasedSessions { get; set; } = true;
+
+    /// <summary>
+    /// How long to wait for a shell to reach a cleared prompt after starting, after a reset or
+    /// after a working-directory change. Covers the shell's startup files.
+    /// </summary>
+    public TimeSpan ResetTimeout { get; set; } = TimeSpan.FromSeconds(10);
+
+    /// <summary>
+    /// Maximum number of sessions that may run at once, or null for no limit. Sessions count
+    /// until their process exits.
+    /// </summary>
+    public int? MaxConcurrentSessions { get; set; }
+
+    /// <summary>
+    /// How long a start request waits for a free slot when <see cref="MaxConcurrentSessions"/>
+    /// is reached before failing.
+    /// </summary>
+    public TimeSpan SessionQueueTimeout { get; set; } = TimeSpan.FromSeconds(30);
+
+    /// <summary>
+    /// Reads options from the <c>HEX1B_MCP_WARM_SESSIONS</c>, <c>HEX1B_MCP_POOL_SHELL</c> and
+    /// <c>HEX1B_MCP_MAX_SESSIONS</c> environment variables.
+    /// </summary>
+    public static TerminalSessionPoolOptions FromEnvironment()
+    {
+        var options = new TerminalSessionPoolOptions();
+
+        if (int.TryParse(Environment.GetEnvironmentVariable("HEX1B_MCP_WARM_SESSIONS"), out var warm) && warm > 0)
+            options.WarmSessionCount = warm;
+
+        if (Environment.GetEnvironmentVariable("HEX1B_MCP_POOL_SHELL") is { Length: > 0 } shell)
+            options.Shell = shell;
+
+        if (int.TryParse(Environment.GetEnvironmentVariable("HEX1B_MCP_MAX_SESSIONS"), out var max) && max > 0)
+            options.MaxConcurrentSessions = max;
+
+        return options;
+    }
+}
@@ -0,0 +1,203 @@
+using System.Diagnostics;
+
+namespace Hex1b.McpServer;
+
+/// <summary>
+/// A text to wait for on one terminal target.
+/// </summary>
+/// <param name="SessionId">The session ID of the target.</param>
+/// <param name="Text">The text to wait for.</param>
+public sealed record TerminalTextCondition(string SessionId, string Text);
+
+/// <summary>
+/// The outcome of one <see cref="TerminalTextCondition"/>.
+/// </summary>
+/// <param name="SessionId">The session ID of the target.</param>
+/// <param name="Text">The text that was waited for.</param>
+/// <param name="Found">Whether the text appeared before the wait ended.</param>
+/// <param name="HasExited">Whether the target exited or disconnected before the text appeared.</param>
+/// <param name="FoundAfter">How long into the wait the text was seen, or null if it wasn't.</param>
+public sealed record TerminalTextWaitResult(string SessionId, string Text, bool Found, bool HasExited, TimeSpan? FoundAfter);
+
+/// <summary>
+/// Waits for text on many terminal targets from a single loop.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Local sessions are driven by their terminals' screen-change notifications: the loop sleeps
+/// until any watched screen changes and then only re-checks the rows that changed on that
+/// screen. Remote targets have no change notification, so they share one poll tick.
+/// </para>
+/// <para>
+/// In <em>any</em> mode the wait ends when one condition is met; in <em>all</em> mode when
+/// every condition is met. It also ends early once the result is decided because the targets
+/// that could still satisfy it have exited.
+/// </para>
+/// </remarks>
+internal sealed class TerminalTextWaiter
+{
+    private static readonly TimeSpan RemotePollInterval = TimeSpan.FromMilliseconds(100);
+
+    private readonly Entry[] _entries;
+    private readonly bool _waitForAll;
+    private readonly Stopwatch _stopwatch = new();
+
+    public TerminalTextWaiter(IReadOnlyList<(TerminalTextCondition Condition, ITerminalTarget Target)> conditions, bool waitForAll)
+    {
+        _entries = new Entry[conditions.Count];
+        for (int i = 0; i < conditions.Count; i++)
+            _entries[i] = new Entry(conditions[i].Condition, conditions[i].Target);
+        _waitForAll = waitForAll;
+    }
+
+    public async Task<IReadOnlyList<TerminalTextWaitResult>> WaitAsync(TimeSpan timeout, CancellationToken ct)
+    {
+        _stopwatch.Restart();
+
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(ct);
+        cts.CancelAfter(timeout);
+
+        foreach (var entry in _entries)
+        {
+            if (entry.Session is { } session)
+            {
+                // Read the generation first so a change during the check isn't missed
+                entry.Generation = session.ScreenGeneration;
+                CheckFound(entry, session.ScreenContainsText(entry.Condition.Text));
+                CheckExited(entry);
+            }
+        }
+        await PollRemotesAsync(cts.Token);
+
+        var waits = new List<Task>();
+        Task? remoteTick = null;
+        while (!IsDecided())
+        {
+            waits.Clear();
+            foreach (var entry in _entries)
+            {
+                if (entry.IsSettled || entry.Session is not { } session)
+                    continue;
+
+                entry.Change ??= session.WaitForScreenChangeAsync(entry.Generation, cts.Token);
+                entry.Exit ??= session.ExitTask.WaitAsync(cts.Token);
+                waits.Add(entry.Change);
+                waits.Add(entry.Exit);
+            }
+
+            if (_entries.Any(e => !e.IsSettled && e.Session is null))
+            {
+                remoteTick ??= Task.Delay(RemotePollInterval, cts.Token);
+                waits.Add(remoteTick);
+            }
+
+            if (waits.Count == 0)
+                break;
+
+            // Every wait is tied to cts, so this also wakes up on timeout
+            await Task.WhenAny(waits);
+            ct.ThrowIfCancellationRequested();
+            if (cts.IsCancellationRequested)
+                break;
+
+            foreach (var entry in _entries)
+            {
+                if (entry.IsSettled)
+                    continue;
+
+                if (entry.Change is { IsCompletedSuccessfully: true } change)
+                {
+                    var found = entry.Session!.ChangedRowsContainText(entry.Condition.Text, entry.Generation);
+                    entry.Generation = change.Result;
+                    entry.Change = null;
+                    CheckFound(entry, found);
+                }
+
+                if (!entry.IsSettled && entry.Exit is { IsCompleted: true })
+                {
+                    // Output that arrived just before the exit may not have been checked yet
+                    CheckFound(entry, entry.Session!.ScreenContainsText(entry.Condition.Text));
+                    CheckExited(entry);
+                }
+            }
+
+            if (remoteTick is { IsCompleted: true })
+            {
+                remoteTick = null;
+                await PollRemotesAsync(cts.Token);
+            }
+        }
+
+        return _entries
+            .Select(e => new TerminalTextWaitResult(e.Condition.SessionId, e.Condition.Text, e.FoundAfter.HasValue, e.Exited, e.FoundAfter))
+            .ToList();
+    }
+
+    private async Task PollRemotesAsync(CancellationToken ct)
+    {
+        var pending = _entries.Where(e => !e.IsSettled && e.Session is null).ToList();
+        if (pending.Count == 0)
+            return;
+
+        await Task.WhenAll(pending.Select(async entry =>
+        {
+            try
+            {
+                var text = await entry.Target.CaptureTextAsync(ct);
+                CheckFound(entry, text.Contains(entry.Condition.Text, StringComparison.Ordinal));
+                CheckExited(entry);
+            }
+            catch (OperationCanceledException) when (ct.IsCancellationRequested)
+            {
+                // Timed out; the loop ends
+            }
+            catch (Exception)
+            {
+                // A remote that can't be captured has gone away
+                entry.Exited = true;
+            }
+        }));
+    }
+
+    private void CheckFound(Entry entry, bool found)
+    {
+        if (found && entry.FoundAfter is null)
+            entry.FoundAfter = _stopwatch.Elapsed;
+    }
+
+    private static void CheckExited(Entry entry)
+    {
+        if (entry.FoundAfter is null && !entry.Target.IsAlive)
+            entry.Exited = true;
+    }
+
+    private bool IsDecided()
+    {
+        if (_waitForAll)
+            return _entries.All(e => e.FoundAfter.HasValue) || _entries.Any(e => e.Exited);
+
+        return _entries.Any(e => e.FoundAfter.HasValue) || _entries.All(e => e.Exited);
+    }
+
+    private sealed class Entry(TerminalTextCondition condition, ITerminalTarget target)
+    {
+        public TerminalTextCondition Condition { get; } = condition;
+
+        public ITerminalTarget Target { get; } = target;
+
+        // Local sessions are watched through their screen-change notifications
+        public TerminalSession? Session { get; } = (target as LocalTerminalTarget)?.Session;
+
+        public long Generation { get; set; }
+
+        public Task<long>? Change { get; set; }
+
+        public Task<int>? Exit { get; set; }
+
+        public TimeSpan? FoundAfter { get; set; }
+
+        public bool Exited { get; set; }
+
+        public bool IsSettled => FoundAfter.HasValue || Exited;
+    }
+}
@@ -85,8 +85,6 @@ public class CaptureTools(TerminalSessionManager sessionManager)
 
         try
         {
-            var svg = session.CaptureSvg();
-
             // Ensure directory exists
             var directory = Path.GetDirectoryName(savePath);
             if (!string.IsNullOrEmpty(directory))
@@ -101,7 +99,7 @@ public class CaptureTools(TerminalSessionManager sessionManager)
             }
 
             // Save SVG
-            File.WriteAllText(savePath, svg);
+            session.SaveSvg(savePath);
 
             return new CaptureScreenshotResult
             {
@@ -165,7 +165,13 @@ public class SessionManagementTools(TerminalSessionManager sessionManager)
                 RunningFor = s.HasExited ? null : DateTimeOffset.UtcNow - s.StartedAt,
                 AsciinemaFilePath = s.AsciinemaFilePath,
                 IsRecording = s.IsRecording,
-                ActiveRecordingPath = s.ActiveRecordingPath
+                ActiveRecordingPath = s.ActiveRecordingPath,
+                IsPooled = s.IsPooled,
+                ReuseCount = s.ReuseCount,
+                InputBytes = s.ResourceUsage?.InputBytes,
+                OutputBytes = s.ResourceUsage?.OutputBytes,
+                CpuTime = s.ResourceUsage?.CpuTime,
+                WorkingSetBytes = s.ResourceUsage?.WorkingSetBytes
             }).ToArray()
         };
     }
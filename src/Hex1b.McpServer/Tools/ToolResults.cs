@@ -242,6 +242,28 @@ public class TerminalSessionInfo
     [JsonPropertyName("activeRecordingPath")]
     [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
     public string? ActiveRecordingPath { get; init; }
+
+    [JsonPropertyName("isPooled")]
+    public bool IsPooled { get; init; }
+
+    [JsonPropertyName("reuseCount")]
+    public int ReuseCount { get; init; }
+
+    [JsonPropertyName("inputBytes")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public long? InputBytes { get; init; }
+
+    [JsonPropertyName("outputBytes")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public long? OutputBytes { get; init; }
+
+    [JsonPropertyName("cpuTime")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public TimeSpan? CpuTime { get; init; }
+
+    [JsonPropertyName("workingSetBytes")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public long? WorkingSetBytes { get; init; }
 }
 
 public class StartRecordingResult
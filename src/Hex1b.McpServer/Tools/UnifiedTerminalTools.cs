@@ -341,6 +341,95 @@ public class UnifiedTerminalTools(TerminalSessionManager sessionManager)
             };
         }
     }
+
+    /// <summary>
+    /// Captures several terminal screens at once.
+    /// </summary>
+    [McpServerTool, Description("Captures the screens of several terminal targets concurrently in one call. Works with both local and remote terminals.")]
+    public async Task<CaptureTerminalsResult> CaptureTerminalScreens(
+        [Description("Session IDs of the terminal targets")] string[] sessionIds,
+        [Description("Capture format: 'text', 'ansi', or 'svg' (default: 'text')")] string format = "text",
+        CancellationToken ct = default)
+    {
+        var captures = await Task.WhenAll(sessionIds.Select(id => CaptureTerminalScreen(id, format, null, ct)));
+        var captured = captures.Count(c => c.Success);
+
+        return new CaptureTerminalsResult
+        {
+            Success = captured == captures.Length,
+            Message = $"Captured {captured} of {captures.Length} terminal(s)",
+            Captures = captures
+        };
+    }
+
+    /// <summary>
+    /// Waits for text on several terminal targets at once.
+    /// </summary>
+    [McpServerTool, Description("Waits for text on several terminal targets in one call. Returns as soon as any condition is met (mode 'any') or once all are met (mode 'all'). Works with both local and remote terminals.")]
+    public async Task<WaitForTerminalsTextResult> WaitForTerminalsText(
+        [Description("Session IDs of the terminal targets. A session may be listed more than once.")] string[] sessionIds,
+        [Description("The text to wait for: one entry for all sessions, or one entry per session ID")] string[] texts,
+        [Description("'any' to return when one condition is met, 'all' to wait for every condition (default: 'any')")] string mode = "any",
+        [Description("Maximum seconds to wait (default: 10)")] int timeoutSeconds = 10,
+        CancellationToken ct = default)
+    {
+        var waitForAll = string.Equals(mode, "all", StringComparison.OrdinalIgnoreCase);
+        if (!waitForAll && !string.Equals(mode, "any", StringComparison.OrdinalIgnoreCase))
+            return WaitForTerminalsFailed(mode, $"Unknown mode '{mode}'. Use 'any' or 'all'.");
+
+        if (sessionIds.Length == 0)
+            return WaitForTerminalsFailed(mode, "At least one session ID is required.");
+
+        if (texts.Length != 1 && texts.Length != sessionIds.Length)
+            return WaitForTerminalsFailed(mode, $"Expected 1 or {sessionIds.Length} texts, got {texts.Length}.");
+
+        if (sessionIds.FirstOrDefault(id => sessionManager.GetTarget(id) == null) is { } missing)
+            return WaitForTerminalsFailed(mode, $"Session '{missing}' not found.");
+
+        var conditions = sessionIds
+            .Select((id, i) => new TerminalTextCondition(id, texts.Length == 1 ? texts[0] : texts[i]))
+            .ToList();
+
+        try
+        {
+            var results = await sessionManager.WaitForTextAsync(conditions, waitForAll, TimeSpan.FromSeconds(timeoutSeconds), ct);
+            var found = results.Count(r => r.Found);
+            var satisfied = waitForAll ? found == results.Count : found > 0;
+
+            return new WaitForTerminalsTextResult
+            {
+                Success = true,
+                Message = satisfied
+                    ? $"Condition met: found {found} of {results.Count}"
+                    : results.Any(r => r.HasExited)
+                        ? $"Condition can't be met: a terminal exited. Found {found} of {results.Count}"
+                        : $"Condition not met within {timeoutSeconds}s: found {found} of {results.Count}",
+                Mode = waitForAll ? "all" : "any",
+                Satisfied = satisfied,
+                Results = results.Select(r => new TerminalTextWaitInfo
+                {
+                    SessionId = r.SessionId,
+                    Text = r.Text,
+                    Found = r.Found,
+                    HasExited = r.HasExited,
+                    FoundAfterMs = r.FoundAfter is { } after ? (long)after.TotalMilliseconds : null
+                }).ToArray()
+            };
+        }
+        catch (Exception ex)
+        {
+            return WaitForTerminalsFailed(mode, $"Wait failed: {ex.Message}");
+        }
+    }
+
+    private static WaitForTerminalsTextResult WaitForTerminalsFailed(string mode, string message) => new()
+    {
+        Success = false,
+        Message = message,
+        Mode = mode,
+        Satisfied = false,
+        Results = []
+    };
 }
 
 // === Result Types ===
@@ -514,4 +603,53 @@ public class CaptureTerminalResult
     public int Height { get; init; }
 }
 
+public class CaptureTerminalsResult
+{
+    [JsonPropertyName("success")]
+    public required bool Success { get; init; }
+
+    [JsonPropertyName("message")]
+    public required string Message { get; init; }
+
+    [JsonPropertyName("captures")]
+    public required CaptureTerminalResult[] Captures { get; init; }
+}
+
+public class WaitForTerminalsTextResult
+{
+    [JsonPropertyName("success")]
+    public required bool Success { get; init; }
+
+    [JsonPropertyName("message")]
+    public required string Message { get; init; }
+
+    [JsonPropertyName("mode")]
+    public required string Mode { get; init; }
+
+    [JsonPropertyName("satisfied")]
+    public required bool Satisfied { get; init; }
+
+    [JsonPropertyName("results")]
+    public required TerminalTextWaitInfo[] Results { get; init; }
+}
+
+public class TerminalTextWaitInfo
+{
+    [JsonPropertyName("sessionId")]
+    public required string SessionId { get; init; }
+
+    [JsonPropertyName("text")]
+    public required string Text { get; init; }
+
+    [JsonPropertyName("found")]
+    public required bool Found { get; init; }
+
+    [JsonPropertyName("hasExited")]
+    public bool HasExited { get; init; }
+
+    [JsonPropertyName("foundAfterMs")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public long? FoundAfterMs { get; init; }
+}
+
 // WaitForTextResult is defined in ToolResults.cs
@@ -61,8 +61,7 @@ internal sealed class AssertCommand : BaseCommand
         {
             while (!timeoutCts.Token.IsCancellationRequested)
             {
-                var response = await _client.SendAsync(resolved.SocketPath!,
-                    new DiagnosticsRequest { Method = "capture", Format = "text" }, timeoutCts.Token);
+                var response = await _client.CaptureTextAsync(resolved.SocketPath!, timeoutCts.Token);
 
                 if (!response.Success)
                 {
@@ -70,8 +70,7 @@ internal sealed class CaptureScreenshotCommand : BaseCommand
 
             while (!timeoutCts.Token.IsCancellationRequested)
             {
-                var textResponse = await _client.SendAsync(resolved.SocketPath!,
-                    new DiagnosticsRequest { Method = "capture", Format = "text" }, timeoutCts.Token);
+                var textResponse = await _client.CaptureTextAsync(resolved.SocketPath!, timeoutCts.Token);
 
                 if (textResponse is { Success: true, Data: not null } && textResponse.Data.Contains(waitText, StringComparison.Ordinal))
                 {
@@ -89,8 +88,10 @@ internal sealed class CaptureScreenshotCommand : BaseCommand
         // and pass it through the protocol so the SVG is generated correctly.
         string? fontFamily = isPng ? ResolveMonospaceFont() : null;
 
-        var response = await _client.SendAsync(resolved.SocketPath!,
-            new DiagnosticsRequest { Method = "capture", Format = captureFormat, ScrollbackLines = scrollback > 0 ? scrollback : null, FontFamily = fontFamily }, cancellationToken);
+        var response = string.Equals(captureFormat, "text", StringComparison.OrdinalIgnoreCase) && scrollback == 0
+            ? await _client.CaptureTextAsync(resolved.SocketPath!, cancellationToken)
+            : await _client.SendAsync(resolved.SocketPath!,
+                new DiagnosticsRequest { Method = "capture", Format = captureFormat, ScrollbackLines = scrollback > 0 ? scrollback : null, FontFamily = fontFamily }, cancellationToken);
 
         if (!response.Success)
         {
@@ -28,7 +28,7 @@ internal sealed class TerminalHost
         if (diagnosticsFilter != null)
             builder.AddPresentationFilter(diagnosticsFilter);
         else
-            builder.WithDiagnostics(appName: config.Command, forceEnable: true);
+            builder.WithDiagnostics(appName: config.Command, forceEnable: true, enableScreenMirror: true);
 
         ConfigurePtyProcess(builder, config);
 
@@ -72,7 +72,7 @@ internal sealed class TerminalHost
         if (diagnosticsFilter != null)
             builder.AddPresentationFilter(diagnosticsFilter);
         else
-            builder.WithDiagnostics(appName: config.Command, forceEnable: true);
+            builder.WithDiagnostics(appName: config.Command, forceEnable: true, enableScreenMirror: true);
 
         ConfigurePtyProcess(builder, config);
 
@@ -126,7 +126,7 @@ internal sealed class TerminalHost
         if (!config.Port.HasValue)
             return null;
 
-        return new Hex1b.Diagnostics.McpDiagnosticsPresentationFilter(config.Command);
+        return new Hex1b.Diagnostics.McpDiagnosticsPresentationFilter(config.Command, enableScreenMirror: true);
     }
 
     /// <summary>
@@ -1,6 +1,7 @@
 using System.Net.Sockets;
 using System.Text;
 using System.Text.Json;
+using Hex1b.Automation;
 using Hex1b.Diagnostics;
 
 namespace Hex1b.Tool.Infrastructure;
@@ -9,8 +10,10 @@ namespace Hex1b.Tool.Infrastructure;
 /// Client for communicating with Hex1b terminals via Unix domain sockets.
 /// Sends DiagnosticsRequest and receives DiagnosticsResponse over the existing protocol.
 /// </summary>
-internal sealed class TerminalClient
+internal sealed class TerminalClient : IDisposable
 {
+    private readonly Dictionary<string, TerminalScreenMirrorReader?> _mirrors = new(StringComparer.Ordinal);
+
     /// <summary>
     /// Sends a request to a terminal at the specified socket path and returns the response.
     /// </summary>
@@ -36,6 +39,40 @@ internal sealed class TerminalClient
             ?? new DiagnosticsResponse { Success = false, Error = "Failed to deserialize response" };
     }
 
+    /// <summary>
+    /// Captures the screen as plain text. Reads the terminal's shared-memory screen mirror when
+    /// it publishes one, and falls back to a capture request over the socket otherwise.
+    /// </summary>
+    public Task<DiagnosticsResponse> CaptureTextAsync(string socketPath, CancellationToken cancellationToken = default)
+    {
+        if (GetMirror(socketPath)?.TryRead() is { } frame)
+        {
+            return Task.FromResult(new DiagnosticsResponse
+            {
+                Success = true,
+                Width = frame.Width,
+                Height = frame.Height,
+                Data = frame.GetText()
+            });
+        }
+
+        return SendAsync(socketPath, new DiagnosticsRequest { Method = "capture", Format = "text" }, cancellationToken);
+    }
+
+    private TerminalScreenMirrorReader? GetMirror(string socketPath)
+    {
+        lock (_mirrors)
+        {
+            // Polling loops reuse the mapping; a missing mirror is looked up again next time
+            if (!_mirrors.TryGetValue(socketPath, out var mirror) || mirror == null)
+            {
+                mirror = TerminalScreenMirrorReader.TryOpenForSocket(socketPath);
+                _mirrors[socketPath] = mirror;
+            }
+            return mirror;
+        }
+    }
+
     /// <summary>
     /// Probes a terminal socket to check if it's alive. Times out after 3 seconds.
     /// </summary>
@@ -52,4 +89,14 @@ internal sealed class TerminalClient
             return null;
         }
     }
+
+    public void Dispose()
+    {
+        lock (_mirrors)
+        {
+            foreach (var mirror in _mirrors.Values)
+                mirror?.Dispose();
+            _mirrors.Clear();
+        }
+    }
 }
@@ -76,6 +76,7 @@ internal sealed class TerminalDiscovery
                 try
                 {
                     File.Delete(terminal.SocketPath);
+                    File.Delete(TerminalScreenMirrorReader.GetMirrorPath(terminal.SocketPath));
                     removed++;
                 }
                 catch
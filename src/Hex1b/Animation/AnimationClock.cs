@@ -0,0 +1,115 @@
+using Hex1b.Diagnostics;
+using Hex1b.Nodes;
+
+namespace Hex1b.Animation;
+
+/// <summary>
+/// Drives every running animation in an app from a single per-frame tick.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The app stamps each frame with <see cref="BeginFrame"/> before reconciliation, and every
+/// <see cref="StatePanelNode"/> advances its animations to that same timestamp, so animations
+/// that started together stay in step however long reconciliation takes.
+/// </para>
+/// <para>
+/// A panel whose animations are still running calls <see cref="RequestFrame"/>. The first
+/// request in a frame schedules one <see cref="AnimationTimer"/> callback; when it fires, all
+/// requesting panels are marked dirty and the app is invalidated once. When no panel asks for
+/// another frame, nothing is scheduled and the clock stops ticking.
+/// </para>
+/// <para>
+/// The clock is used from the render loop only and is not thread-safe.
+/// </para>
+/// </remarks>
+internal sealed class AnimationClock
+{
+    private readonly TimeSpan _interval;
+    private readonly Action<TimeSpan, Action> _scheduleTimer;
+    private readonly Action? _invalidate;
+    private readonly Hex1bMetrics? _metrics;
+    private readonly Action _tick;
+
+    // Latest active animation count per requesting panel; frames rendered between two ticks
+    // (e.g. on input) re-request for the same panels
+    private readonly Dictionary<StatePanelNode, int> _pending = new(ReferenceEqualityComparer.Instance);
+    private bool _tickScheduled;
+
+    /// <summary>
+    /// Creates a clock that ticks through the given timer callback.
+    /// </summary>
+    /// <param name="interval">The delay between a request and the tick it schedules.</param>
+    /// <param name="scheduleTimer">Schedules a one-shot callback, e.g. <see cref="AnimationTimer.Schedule"/>.</param>
+    /// <param name="invalidate">Invalidates the app so the ticked panels are rendered.</param>
+    /// <param name="metrics">Receives the active animation counts, or null to record nothing.</param>
+    public AnimationClock(TimeSpan interval, Action<TimeSpan, Action> scheduleTimer, Action? invalidate, Hex1bMetrics? metrics = null)
+    {
+        ArgumentNullException.ThrowIfNull(scheduleTimer);
+
+        _interval = interval;
+        _scheduleTimer = scheduleTimer;
+        _invalidate = invalidate;
+        _metrics = metrics;
+        _tick = Tick;
+    }
+
+    /// <summary>
+    /// The <see cref="System.Diagnostics.Stopwatch"/> timestamp of the current frame,
+    /// or 0 before the first frame.
+    /// </summary>
+    public long FrameTimestamp { get; private set; }
+
+    /// <summary>
+    /// Whether a tick is scheduled, i.e. some animation asked for another frame.
+    /// </summary>
+    public bool IsTicking => _tickScheduled;
+
+    /// <summary>
+    /// The number of animations that were running when the last tick fired.
+    /// </summary>
+    public int ActiveAnimations { get; private set; }
+
+    /// <summary>
+    /// Starts a frame at the given <see cref="System.Diagnostics.Stopwatch"/> timestamp.
+    /// </summary>
+    public void BeginFrame(long timestamp)
+    {
+        FrameTimestamp = timestamp;
+    }
+
+    /// <summary>
+    /// Asks for the panel to be re-rendered on the next tick.
+    /// </summary>
+    /// <param name="node">The panel whose animations are still running.</param>
+    /// <param name="activeAnimations">How many of its animations are running.</param>
+    public void RequestFrame(StatePanelNode node, int activeAnimations)
+    {
+        _pending[node] = activeAnimations;
+
+        if (!_tickScheduled)
+        {
+            _tickScheduled = true;
+            _scheduleTimer(_interval, _tick);
+        }
+    }
+
+    private void Tick()
+    {
+        _tickScheduled = false;
+
+        var activeAnimations = 0;
+        foreach (var (node, count) in _pending)
+        {
+            node.MarkDirty();
+            node.Parent?.MarkDirty();
+            activeAnimations += count;
+        }
+        _pending.Clear();
+        ActiveAnimations = activeAnimations;
+
+        _metrics?.AnimationTickCount.Add(1);
+        _metrics?.AnimationActiveCount.Record(ActiveAnimations);
+
+        _invalidate?.Invoke();
+    }
+}
@@ -15,6 +15,9 @@ public sealed class AnimationCollection : IActiveState, IDisposable
 {
     private readonly Dictionary<string, Hex1bAnimator> _animators = new();
 
+    // Creation-ordered copy of the dictionary values, walked by the per-frame passes
+    private readonly List<Hex1bAnimator> _ordered = new();
+
     /// <summary>
     /// Gets or creates an animator by name. On first call, the configure action is invoked
     /// to set initial properties and the animator is optionally auto-started.
@@ -32,7 +35,10 @@ public sealed class AnimationCollection : IActiveState, IDisposable
         configure?.Invoke(animator);
         if (autoStart)
             animator.Start();
+        if (existing is not null)
+            _ordered.Remove(existing);
         _animators[name] = animator;
+        _ordered.Add(animator);
         return animator;
     }
 
@@ -41,7 +47,7 @@ public sealed class AnimationCollection : IActiveState, IDisposable
     /// </summary>
     internal void AdvanceAll(TimeSpan elapsed)
     {
-        foreach (var animator in _animators.Values)
+        foreach (var animator in _ordered)
         {
             if (animator.IsRunning)
                 animator.Advance(elapsed);
@@ -55,7 +61,7 @@ public sealed class AnimationCollection : IActiveState, IDisposable
     {
         get
         {
-            foreach (var animator in _animators.Values)
+            foreach (var animator in _ordered)
             {
                 if (animator.IsRunning)
                     return true;
@@ -64,17 +70,38 @@ public sealed class AnimationCollection : IActiveState, IDisposable
         }
     }
 
+    /// <summary>
+    /// Returns the number of animators in the collection that are currently running.
+    /// </summary>
+    internal int ActiveCount
+    {
+        get
+        {
+            var count = 0;
+            foreach (var animator in _ordered)
+            {
+                if (animator.IsRunning)
+                    count++;
+            }
+            return count;
+        }
+    }
+
     /// <inheritdoc />
     bool IActiveState.IsActive => HasActiveAnimations;
 
     /// <inheritdoc />
     void IActiveState.OnFrameAdvance(TimeSpan elapsed) => AdvanceAll(elapsed);
 
+    /// <inheritdoc />
+    int IActiveState.ActiveCount => ActiveCount;
+
     /// <summary>
     /// Disposes all animators and clears the collection.
     /// </summary>
     public void Dispose()
     {
         _animators.Clear();
+        _ordered.Clear();
     }
 }
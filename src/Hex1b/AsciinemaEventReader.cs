@@ -0,0 +1,235 @@
+using System.Buffers;
+using System.Buffers.Text;
+using System.Text.Json;
+
+namespace Hex1b;
+
+/// <summary>
+/// Streaming reader for asciicast v2 files.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Lines are returned as UTF-8 slices of a pooled buffer together with their byte offset
+/// in the file, so callers can index events by position and read them back later with
+/// <see cref="RandomAccess"/>. Event parsing uses <see cref="Utf8JsonReader"/> directly on
+/// those slices and unescapes payloads into a caller-supplied buffer, so walking a
+/// recording allocates nothing per event.
+/// </para>
+/// <para>
+/// A line returned by <see cref="ReadLineAsync"/> is only valid until the next call.
+/// </para>
+/// </remarks>
+internal sealed class AsciinemaEventReader : IDisposable
+{
+    private const int InitialBufferSize = 64 * 1024;
+    private static ReadOnlySpan<byte> Utf8Bom => [0xEF, 0xBB, 0xBF];
+
+    private readonly Stream _stream;
+    private byte[] _buffer;
+    private int _start;        // start of the unread data in _buffer
+    private int _scanned;      // end of the unread data already searched for '\n'
+    private int _end;          // end of the data in _buffer
+    private long _bufferOffset; // stream offset of _buffer[0]
+    private bool _endOfStream;
+
+    public AsciinemaEventReader(Stream stream)
+    {
+        _stream = stream;
+        _buffer = ArrayPool<byte>.Shared.Rent(InitialBufferSize);
+    }
+
+    /// <summary>
+    /// The current line, without its line terminator.
+    /// </summary>
+    public ReadOnlyMemory<byte> Line { get; private set; }
+
+    /// <summary>
+    /// The byte offset of <see cref="Line"/> in the stream.
+    /// </summary>
+    public long LineOffset { get; private set; }
+
+    /// <summary>
+    /// Advances to the next line.
+    /// </summary>
+    /// <returns>False at the end of the stream.</returns>
+    public async ValueTask<bool> ReadLineAsync(CancellationToken ct = default)
+    {
+        while (true)
+        {
+            var newline = _buffer.AsSpan(_scanned, _end - _scanned).IndexOf((byte)'\n');
+            if (newline >= 0)
+            {
+                SetLine(_scanned + newline);
+                _start = _scanned = _scanned + newline + 1;
+                return true;
+            }
+            _scanned = _end;
+
+            if (_endOfStream)
+            {
+                if (_start == _end)
+                    return false;
+
+                SetLine(_end);
+                _start = _scanned = _end;
+                return true;
+            }
+
+            if (_start > 0)
+            {
+                // Slide the partial line to the front of the buffer
+                _buffer.AsSpan(_start, _end - _start).CopyTo(_buffer);
+                _bufferOffset += _start;
+                _end -= _start;
+                _scanned -= _start;
+                _start = 0;
+            }
+            else if (_end == _buffer.Length)
+            {
+                var larger = ArrayPool<byte>.Shared.Rent(_buffer.Length * 2);
+                _buffer.AsSpan(0, _end).CopyTo(larger);
+                ArrayPool<byte>.Shared.Return(_buffer);
+                _buffer = larger;
+            }
+
+            var read = await _stream.ReadAsync(_buffer.AsMemory(_end), ct).ConfigureAwait(false);
+            if (read == 0)
+                _endOfStream = true;
+            else
+                _end += read;
+        }
+    }
+
+    private void SetLine(int end)
+    {
+        var length = end - _start;
+        if (length > 0 && _buffer[_start + length - 1] == (byte)'\r')
+            length--;
+
+        Line = _buffer.AsMemory(_start, length);
+        LineOffset = _bufferOffset + _start;
+    }
+
+    public void Dispose()
+    {
+        var buffer = _buffer;
+        _buffer = [];
+        if (buffer.Length > 0)
+            ArrayPool<byte>.Shared.Return(buffer);
+    }
+
+    /// <summary>
+    /// Returns true if the line is empty or whitespace only.
+    /// </summary>
+    public static bool IsBlank(ReadOnlySpan<byte> line) => line.Trim(" \t\r"u8).IsEmpty;
+
+    /// <summary>
+    /// Parses the dimensions from an asciicast v2 header line.
+    /// </summary>
+    /// <exception cref="InvalidDataException">The header is not a JSON object with a width and height.</exception>
+    public static (int Width, int Height) ParseHeader(ReadOnlySpan<byte> line)
+    {
+        int? width = null;
+        int? height = null;
+
+        if (line.StartsWith(Utf8Bom))
+            line = line[Utf8Bom.Length..];
+
+        try
+        {
+            var reader = new Utf8JsonReader(line);
+            if (!reader.Read() || reader.TokenType != JsonTokenType.StartObject)
+                throw new InvalidDataException("Invalid asciinema file: header is not a JSON object");
+
+            while (reader.Read() && reader.TokenType == JsonTokenType.PropertyName)
+            {
+                var isWidth = reader.ValueTextEquals("width"u8);
+                var isHeight = !isWidth && reader.ValueTextEquals("height"u8);
+                reader.Read();
+
+                if ((isWidth || isHeight) && reader.TokenType == JsonTokenType.Number && reader.TryGetInt32(out var value))
+                {
+                    if (isWidth)
+                        width = value;
+                    else
+                        height = value;
+                }
+                else
+                {
+                    reader.Skip();
+                }
+            }
+        }
+        catch (JsonException ex)
+        {
+            throw new InvalidDataException("Invalid asciinema file: malformed header", ex);
+        }
+
+        if (width is null || height is null)
+            throw new InvalidDataException("Invalid asciinema file: header is missing width or height");
+
+        return (width.Value, height.Value);
+    }
+
+    /// <summary>
+    /// Parses an event line of the form <c>[time, "type", "data"]</c>.
+    /// </summary>
+    /// <param name="line">The UTF-8 event line.</param>
+    /// <param name="timestamp">The event time in seconds.</param>
+    /// <param name="eventType">The event type code (<c>'o'</c>, <c>'i'</c>, <c>'r'</c>, <c>'m'</c>), or 0 if it isn't a single character.</param>
+    /// <param name="data">If non-null, receives the unescaped UTF-8 event data.</param>
+    /// <returns>False if the line isn't a well-formed event; nothing is written to <paramref name="data"/> then.</returns>
+    public static bool TryParseEvent(ReadOnlySpan<byte> line, out double timestamp, out byte eventType, IBufferWriter<byte>? data)
+    {
+        timestamp = 0;
+        eventType = 0;
+
+        try
+        {
+            var reader = new Utf8JsonReader(line);
+            if (!reader.Read() || reader.TokenType != JsonTokenType.StartArray)
+                return false;
+            if (!reader.Read() || reader.TokenType != JsonTokenType.Number || !reader.TryGetDouble(out timestamp))
+                return false;
+            if (!reader.Read() || reader.TokenType != JsonTokenType.String)
+                return false;
+            if (!reader.ValueIsEscaped && reader.ValueSpan.Length == 1)
+                eventType = reader.ValueSpan[0];
+            if (!reader.Read() || reader.TokenType != JsonTokenType.String)
+                return false;
+
+            if (data is not null)
+            {
+                if (!reader.ValueIsEscaped)
+                {
+                    data.Write(reader.ValueSpan);
+                }
+                else
+                {
+                    // Unescaping never makes the value longer
+                    var written = reader.CopyString(data.GetSpan(reader.ValueSpan.Length));
+                    data.Advance(written);
+                }
+            }
+            return true;
+        }
+        catch (Exception ex) when (ex is JsonException or InvalidOperationException)
+        {
+            // Malformed JSON, or escapes that don't form valid UTF-16 (e.g. lone surrogates)
+            return false;
+        }
+    }
+
+    /// <summary>
+    /// Parses resize event data of the form <c>WIDTHxHEIGHT</c>.
+    /// </summary>
+    public static bool TryParseSize(ReadOnlySpan<byte> data, out int width, out int height)
+    {
+        height = 0;
+        return Utf8Parser.TryParse(data, out width, out var consumed)
+            && consumed < data.Length
+            && data[consumed] == (byte)'x'
+            && Utf8Parser.TryParse(data[(consumed + 1)..], out height, out var heightConsumed)
+            && consumed + 1 + heightConsumed == data.Length;
+    }
+}
@@ -1,5 +1,4 @@
-using System.Text;
-using System.Text.Json;
+using System.Buffers;
 using System.Threading.Channels;
 
 namespace Hex1b;
@@ -108,43 +107,37 @@ public sealed class AsciinemaFileWorkloadAdapter : IHex1bTerminalWorkloadAdapter
     {
         try
         {
-            using var stream = File.OpenRead(_filePath);
-            using var reader = new StreamReader(stream, Encoding.UTF8);
+            await using var stream = new FileStream(_filePath, FileMode.Open, FileAccess.Read, FileShare.Read,
+                bufferSize: 1, FileOptions.Asynchronous | FileOptions.SequentialScan);
+            using var reader = new AsciinemaEventReader(stream);
 
             // Read header
-            var headerLine = await reader.ReadLineAsync(ct);
-            if (string.IsNullOrWhiteSpace(headerLine))
+            if (!await reader.ReadLineAsync(ct) || AsciinemaEventReader.IsBlank(reader.Line.Span))
             {
                 throw new InvalidDataException("Invalid asciinema file: missing header");
             }
 
-            var header = JsonDocument.Parse(headerLine);
-            Width = header.RootElement.GetProperty("width").GetInt32();
-            Height = header.RootElement.GetProperty("height").GetInt32();
+            var (headerWidth, headerHeight) = AsciinemaEventReader.ParseHeader(reader.Line.Span);
+            Width = headerWidth;
+            Height = headerHeight;
 
             double previousTimestamp = 0;
+            var eventData = new ArrayBufferWriter<byte>();
 
             // Read and replay events
-            while (!ct.IsCancellationRequested)
+            while (!ct.IsCancellationRequested && await reader.ReadLineAsync(ct))
             {
-                var line = await reader.ReadLineAsync(ct);
-                if (string.IsNullOrWhiteSpace(line))
+                if (AsciinemaEventReader.IsBlank(reader.Line.Span))
                 {
-                    break; // End of file
+                    break; // End of events
                 }
 
-                var eventDoc = JsonDocument.Parse(line);
-                var eventArray = eventDoc.RootElement;
-
-                if (eventArray.GetArrayLength() < 3)
+                eventData.Clear();
+                if (!AsciinemaEventReader.TryParseEvent(reader.Line.Span, out var timestamp, out var eventType, eventData))
                 {
                     continue; // Invalid event, skip
                 }
 
-                var timestamp = eventArray[0].GetDouble();
-                var eventType = eventArray[1].GetString();
-                var eventData = eventArray[2].GetString() ?? "";
-
                 // Calculate delay based on timestamp difference
                 var delay = timestamp - previousTimestamp;
                 if (delay > 0)
@@ -158,17 +151,13 @@ public sealed class AsciinemaFileWorkloadAdapter : IHex1bTerminalWorkloadAdapter
                 // Handle event based on type
                 switch (eventType)
                 {
-                    case "o": // Output event
-                        var bytes = Encoding.UTF8.GetBytes(eventData);
-                        await _outputChannel.Writer.WriteAsync(bytes, ct);
+                    case (byte)'o': // Output event
+                        await _outputChannel.Writer.WriteAsync(eventData.WrittenSpan.ToArray(), ct);
                         break;
 
-                    case "r": // Resize event
+                    case (byte)'r': // Resize event
                         // Parse "WxH" format
-                        var parts = eventData.Split('x');
-                        if (parts.Length == 2 && 
-                            int.TryParse(parts[0], out var width) && 
-                            int.TryParse(parts[1], out var height))
+                        if (AsciinemaEventReader.TryParseSize(eventData.WrittenSpan, out var width, out var height))
                         {
                             Width = width;
                             Height = height;
@@ -177,8 +166,8 @@ public sealed class AsciinemaFileWorkloadAdapter : IHex1bTerminalWorkloadAdapter
                         }
                         break;
 
-                    case "i": // Input event (we ignore these during playback)
-                    case "m": // Marker event (we ignore these during playback)
+                    case (byte)'i': // Input event (we ignore these during playback)
+                    case (byte)'m': // Marker event (we ignore these during playback)
                         break;
                 }
             }
@@ -1,6 +1,10 @@
+using System.Buffers;
+using System.Diagnostics;
+using System.Runtime.ExceptionServices;
 using System.Text;
 using System.Text.Json;
 using System.Text.Json.Serialization;
+using System.Threading.Channels;
 using Hex1b.Tokens;
 
 namespace Hex1b;
@@ -20,6 +24,13 @@ namespace Hex1b;
 ///   <item>Subsequent lines: Events as [time, type, data] tuples</item>
 /// </list>
 /// </para>
+/// <para>
+/// Events are handed from the filter callbacks to a bounded queue. With
+/// <see cref="AsciinemaRecorderOptions.AutoFlush"/> enabled, a background writer drains the
+/// queue and writes each batch of events with a single file write, so the terminal's
+/// output pump never waits on disk I/O. What happens when the queue is full is controlled
+/// by <see cref="AsciinemaRecorderOptions.BackpressurePolicy"/>.
+/// </para>
 /// <example>
 /// <code>
 /// var options = new Hex1bTerminalOptions { ... };
@@ -35,11 +46,17 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
 {
     private AsciinemaRecorderOptions _options;
     private string? _filePath;
-    private readonly List<AsciinemaEvent> _pendingEvents = new();
     private readonly object _lock = new();
+    private readonly object _backpressureLock = new();
     private readonly SemaphoreSlim _writeLock = new(1, 1);
+    private readonly ArrayBufferWriter<byte> _batch = new();
+    private Channel<AsciinemaEvent> _queue;
+    private Task? _writerTask;
+    private Task _stopTask = Task.CompletedTask;
+    private ExceptionDispatchInfo? _writeError;
+    private Utf8JsonWriter? _json;
     private FileStream? _fileStream;
-    private StreamWriter? _writer;
+    private string? _initialState;
     private int _width;
     private int _height;
     private DateTimeOffset _timestamp;
@@ -48,6 +65,14 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
     private bool _disposed;
     private bool _isRecording;
 
+    // Backpressure state, guarded by _backpressureLock
+    private StringBuilder? _coalescedOutput;
+    private double _coalescedTime;
+    private long _droppedSinceMarker;
+    private double _lastDroppedTime;
+    private long _droppedEventCount;
+    private long _coalescedEventCount;
+
     /// <summary>
     /// Creates a new Asciinema recorder in idle mode (not recording).
     /// </summary>
@@ -60,6 +85,7 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
     {
         _filePath = null;
         _options = new AsciinemaRecorderOptions();
+        _queue = CreateQueue(_options);
         _isRecording = false;
     }
 
@@ -74,7 +100,9 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
         ArgumentException.ThrowIfNullOrWhiteSpace(filePath);
         _filePath = filePath;
         _options = options ?? new AsciinemaRecorderOptions();
+        _queue = CreateQueue(_options);
         _isRecording = true; // Start recording immediately for backward compatibility
+        StartWriter(_queue);
     }
 
     /// <summary>
@@ -99,19 +127,41 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
     {
         get
         {
+            var count = _queue.Reader.Count;
             lock (_lock)
             {
-                return _pendingEvents.Count;
+                if (_initialState != null) count++;
             }
+            lock (_backpressureLock)
+            {
+                if (_coalescedOutput != null) count++;
+            }
+            return count;
         }
     }
 
+    /// <summary>
+    /// Gets the number of events discarded because the queue was full
+    /// (<see cref="AsciinemaBackpressurePolicy.DropWithMarker"/>).
+    /// </summary>
+    public long DroppedEventCount => Interlocked.Read(ref _droppedEventCount);
+
+    /// <summary>
+    /// Gets the number of output events merged into a preceding event because the queue was full
+    /// (<see cref="AsciinemaBackpressurePolicy.Coalesce"/>).
+    /// </summary>
+    public long CoalescedEventCount => Interlocked.Read(ref _coalescedEventCount);
+
+    private Diagnostics.Hex1bMetrics Metrics => _options.Metrics ?? Diagnostics.Hex1bMetrics.Default;
+
     /// <summary>
     /// Starts recording to the specified file.
     /// </summary>
     /// <param name="filePath">Path to the output file (typically with .cast extension).</param>
     /// <param name="options">Recording options. If null, defaults are used.</param>
-    /// <exception cref="InvalidOperationException">Thrown if already recording.</exception>
+    /// <exception cref="InvalidOperationException">
+    /// Thrown if already recording, or if the previous recording is still being finalized.
+    /// </exception>
     /// <remarks>
     /// <para>
     /// This method is used for dynamic recording scenarios where recording starts
@@ -119,6 +169,10 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
     /// automatically taken from the session. Use <see cref="WriteInitialStateAsync"/>
     /// to capture the current terminal state before continuing.
     /// </para>
+    /// <para>
+    /// A stop that has not finished yet still owns the file and the background writer.
+    /// Use <see cref="StartRecordingAsync"/> to wait for it instead of failing.
+    /// </para>
     /// </remarks>
     public void StartRecording(string filePath, AsciinemaRecorderOptions? options = null)
     {
@@ -131,15 +185,57 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
                 throw new InvalidOperationException("Already recording. Call StopRecordingAsync() first.");
             }
 
+            if (!_stopTask.IsCompleted || _writerTask is { IsCompleted: false })
+            {
+                throw new InvalidOperationException(
+                    "The previous recording is still being finalized. Await StopRecordingAsync() or use StartRecordingAsync().");
+            }
+
             _filePath = filePath;
             _options = options ?? new AsciinemaRecorderOptions();
             // _width and _height are already set from OnSessionStartAsync
             _recordingStartTime = DateTimeOffset.UtcNow;
             _timestamp = _recordingStartTime;
             _headerWritten = false;
-            _pendingEvents.Clear();
+            _initialState = null;
+            ResetBackpressure();
+            _writeError = null;
+            _queue.Writer.TryComplete();
+            _queue = CreateQueue(_options);
             _isRecording = true;
+            StartWriter(_queue);
+        }
+    }
+
+    /// <summary>
+    /// Starts recording to the specified file once the previous recording has been finalized.
+    /// </summary>
+    /// <param name="filePath">Path to the output file (typically with .cast extension).</param>
+    /// <param name="options">Recording options. If null, defaults are used.</param>
+    /// <param name="ct">Cancellation token.</param>
+    /// <exception cref="InvalidOperationException">Thrown if already recording.</exception>
+    /// <remarks>
+    /// Unlike <see cref="StartRecording"/>, this waits for a stop that is still in progress
+    /// and for the previous background writer to exit, so two writers never share the file.
+    /// </remarks>
+    public async Task StartRecordingAsync(string filePath, AsciinemaRecorderOptions? options = null, CancellationToken ct = default)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(filePath);
+
+        Task previous;
+        lock (_lock)
+        {
+            if (_isRecording)
+            {
+                throw new InvalidOperationException("Already recording. Call StopRecordingAsync() first.");
+            }
+
+            _queue.Writer.TryComplete();
+            previous = _writerTask is null ? _stopTask : Task.WhenAll(_stopTask, _writerTask);
         }
+
+        await previous.WaitAsync(ct);
+        StartRecording(filePath, options);
     }
 
     /// <summary>
@@ -147,13 +243,21 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
     /// </summary>
     /// <returns>The path to the finalized recording file, or null if not recording.</returns>
     /// <remarks>
+    /// <para>
     /// After calling this method, <see cref="StartRecording"/> can be called again
     /// to start a new recording to a different file.
+    /// </para>
+    /// <para>
+    /// The file is closed even if it could not be written; the write error is thrown afterwards.
+    /// </para>
     /// </remarks>
     public async Task<string?> StopRecordingAsync(CancellationToken ct = default)
     {
         string? completedFilePath;
-        
+        Channel<AsciinemaEvent> queue;
+        Task? writerTask;
+        var stopped = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+
         lock (_lock)
         {
             if (!_isRecording)
@@ -161,21 +265,51 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
                 return null;
             }
 
+            // Take this recording's queue and writer now, so a recording started while
+            // this one is finalized is never completed or awaited here
             _isRecording = false;
             completedFilePath = _filePath;
+            queue = _queue;
+            writerTask = _writerTask;
+            _writerTask = null;
+            _stopTask = stopped.Task;
         }
 
-        // Flush any remaining events and close the file
-        await FlushAsync(ct);
-        
-        await _writeLock.WaitAsync(ct);
         try
         {
-            await CloseStreamAsync();
+            try
+            {
+                // Flush any remaining events
+                await DrainAsync(queue, force: true, ct);
+            }
+            finally
+            {
+                // Stop the writer and close the file even if the last write failed
+                queue.Writer.TryComplete();
+                if (writerTask != null)
+                {
+                    await writerTask;
+                }
+
+                await _writeLock.WaitAsync(ct);
+                try
+                {
+                    await CloseStreamAsync();
+                }
+                finally
+                {
+                    _writeLock.Release();
+                }
+            }
+
+            lock (_lock)
+            {
+                _writeError?.Throw();
+            }
         }
         finally
         {
-            _writeLock.Release();
+            stopped.SetResult();
         }
 
         return completedFilePath;
@@ -204,8 +338,8 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
         {
             if (!_isRecording) return;
             
-            // Insert at the beginning with time 0
-            _pendingEvents.Insert(0, new AsciinemaEvent(0, "o", ansiContent));
+            // Written ahead of anything still queued
+            _initialState = ansiContent;
         }
 
         if (_options.AutoFlush)
@@ -219,14 +353,49 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
     /// </summary>
     /// <param name="label">Optional label for the marker.</param>
     /// <param name="elapsed">Time elapsed since session start.</param>
+    /// <remarks>
+    /// Never blocks the caller: if the queue is full, the marker is dropped and counted as with
+    /// <see cref="AsciinemaBackpressurePolicy.DropWithMarker"/>, whatever the configured policy.
+    /// Use <see cref="AddMarkerAsync"/> to wait for room instead.
+    /// </remarks>
     public void AddMarker(string label = "", TimeSpan? elapsed = null)
+    {
+        if (TryCreateMarker(label, elapsed, out var queue, out var evt))
+        {
+            // Completes synchronously when it can't wait
+            _ = EnqueueAsync(queue, evt, canWait: false, CancellationToken.None);
+        }
+    }
+
+    /// <summary>
+    /// Adds a marker event at the current time, applying the
+    /// <see cref="AsciinemaRecorderOptions.BackpressurePolicy"/> if the queue is full.
+    /// </summary>
+    /// <param name="label">Optional label for the marker.</param>
+    /// <param name="elapsed">Time elapsed since session start.</param>
+    /// <param name="ct">Cancellation token.</param>
+    public async Task AddMarkerAsync(string label = "", TimeSpan? elapsed = null, CancellationToken ct = default)
+    {
+        if (TryCreateMarker(label, elapsed, out var queue, out var evt))
+        {
+            await EnqueueAsync(queue, evt, canWait: true, ct);
+        }
+    }
+
+    private bool TryCreateMarker(string label, TimeSpan? elapsed, out Channel<AsciinemaEvent> queue, out AsciinemaEvent evt)
     {
         lock (_lock)
         {
-            if (!_isRecording) return;
-            
+            queue = _queue;
+            if (!_isRecording)
+            {
+                evt = default;
+                return false;
+            }
+
             var time = elapsed ?? (_headerWritten ? DateTimeOffset.UtcNow - _timestamp : TimeSpan.Zero);
-            _pendingEvents.Add(new AsciinemaEvent(time.TotalSeconds, "m", label));
+            evt = new AsciinemaEvent(time.TotalSeconds, "m", label);
+            return true;
         }
     }
 
@@ -244,25 +413,13 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
     }
 
     /// <inheritdoc />
-    async ValueTask IHex1bTerminalWorkloadFilter.OnOutputAsync(IReadOnlyList<AnsiToken> tokens, TimeSpan elapsed, CancellationToken ct)
+    ValueTask IHex1bTerminalWorkloadFilter.OnOutputAsync(IReadOnlyList<AnsiToken> tokens, TimeSpan elapsed, CancellationToken ct)
     {
-        if (tokens.Count == 0) return;
+        if (tokens.Count == 0) return ValueTask.CompletedTask;
 
         // Serialize tokens back to ANSI text for recording
         var text = AnsiTokenSerializer.Serialize(tokens);
-        lock (_lock)
-        {
-            if (!_isRecording) return;
-            
-            // Calculate elapsed time relative to when recording started
-            var recordingElapsed = GetRecordingElapsed(elapsed);
-            _pendingEvents.Add(new AsciinemaEvent(recordingElapsed.TotalSeconds, "o", text));
-        }
-
-        if (_options.AutoFlush)
-        {
-            await FlushAsync(ct);
-        }
+        return RecordAsync("o", text, elapsed, ct);
     }
 
     /// <inheritdoc />
@@ -274,45 +431,26 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
     }
 
     /// <inheritdoc />
-    async ValueTask IHex1bTerminalWorkloadFilter.OnInputAsync(IReadOnlyList<Tokens.AnsiToken> tokens, TimeSpan elapsed, CancellationToken ct)
+    ValueTask IHex1bTerminalWorkloadFilter.OnInputAsync(IReadOnlyList<Tokens.AnsiToken> tokens, TimeSpan elapsed, CancellationToken ct)
     {
         // Only record input if explicitly enabled (per Asciinema spec recommendation)
-        if (!_options.CaptureInput) return;
-        if (tokens.Count == 0) return;
+        if (!_options.CaptureInput) return ValueTask.CompletedTask;
+        if (tokens.Count == 0) return ValueTask.CompletedTask;
 
         var text = Tokens.AnsiTokenSerializer.Serialize(tokens);
-        lock (_lock)
-        {
-            if (!_isRecording) return;
-            
-            var recordingElapsed = GetRecordingElapsed(elapsed);
-            _pendingEvents.Add(new AsciinemaEvent(recordingElapsed.TotalSeconds, "i", text));
-        }
-
-        if (_options.AutoFlush)
-        {
-            await FlushAsync(ct);
-        }
+        return RecordAsync("i", text, elapsed, ct);
     }
 
     /// <inheritdoc />
-    async ValueTask IHex1bTerminalWorkloadFilter.OnResizeAsync(int width, int height, TimeSpan elapsed, CancellationToken ct)
+    ValueTask IHex1bTerminalWorkloadFilter.OnResizeAsync(int width, int height, TimeSpan elapsed, CancellationToken ct)
     {
         lock (_lock)
         {
             _width = width;
             _height = height;
-            
-            if (!_isRecording) return;
-            
-            var recordingElapsed = GetRecordingElapsed(elapsed);
-            _pendingEvents.Add(new AsciinemaEvent(recordingElapsed.TotalSeconds, "r", $"{width}x{height}"));
         }
 
-        if (_options.AutoFlush)
-        {
-            await FlushAsync(ct);
-        }
+        return RecordAsync("r", $"{width}x{height}", elapsed, ct);
     }
 
     /// <inheritdoc />
@@ -322,6 +460,23 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
         return ValueTask.CompletedTask;
     }
 
+    private ValueTask RecordAsync(string code, string data, TimeSpan elapsed, CancellationToken ct)
+    {
+        Channel<AsciinemaEvent> queue;
+        AsciinemaEvent evt;
+        lock (_lock)
+        {
+            if (!_isRecording) return ValueTask.CompletedTask;
+            
+            // Calculate elapsed time relative to when recording started
+            var recordingElapsed = GetRecordingElapsed(elapsed);
+            evt = new AsciinemaEvent(recordingElapsed.TotalSeconds, code, data);
+            queue = _queue;
+        }
+
+        return EnqueueAsync(queue, evt, canWait: true, ct);
+    }
+
     /// <summary>
     /// Calculates elapsed time relative to when recording started.
     /// </summary>
@@ -345,96 +500,476 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
         return recordingElapsed < TimeSpan.Zero ? TimeSpan.Zero : recordingElapsed;
     }
 
+    private static Channel<AsciinemaEvent> CreateQueue(AsciinemaRecorderOptions options)
+    {
+        return Channel.CreateBounded<AsciinemaEvent>(new BoundedChannelOptions(Math.Max(1, options.QueueCapacity))
+        {
+            FullMode = BoundedChannelFullMode.Wait,
+            SingleReader = false,
+            SingleWriter = false
+        });
+    }
+
     /// <summary>
-    /// Flushes any pending events to the file.
+    /// Queues an event, applying the backpressure policy if the queue is full.
+    /// Completes synchronously unless the policy has to wait for the writer; when
+    /// <paramref name="canWait"/> is false, an event that would wait is dropped instead.
     /// </summary>
-    /// <param name="ct">Cancellation token.</param>
-    public async Task FlushAsync(CancellationToken ct = default)
+    private ValueTask EnqueueAsync(Channel<AsciinemaEvent> queue, AsciinemaEvent evt, bool canWait, CancellationToken ct)
     {
-        List<AsciinemaEvent> eventsToWrite;
-        AsciinemaHeader? header = null;
-        bool nothingToWrite;
+        if (Volatile.Read(ref _writeError) != null)
+        {
+            // The background writer failed, so nothing will make room again
+            lock (_backpressureLock)
+            {
+                RecordDropLocked(evt);
+            }
+            return ValueTask.CompletedTask;
+        }
 
-        lock (_lock)
+        AsciinemaEvent? pending = null;
+        lock (_backpressureLock)
         {
-            // Can't flush if no file path is set
-            if (_filePath == null)
-                return;
-                
-            nothingToWrite = _pendingEvents.Count == 0 && _headerWritten;
+            if (_coalescedOutput != null)
+            {
+                // Later output joins the coalesced event so ordering is preserved
+                if (evt.Code == "o")
+                {
+                    _coalescedOutput.Append(evt.Data);
+                    Interlocked.Increment(ref _coalescedEventCount);
+                    Metrics.RecorderCoalescedEvents.Add(1);
+                    TryReleaseBackpressureLocked(queue);
+                    return ValueTask.CompletedTask;
+                }
 
-            if (!nothingToWrite)
+                if (canWait)
+                {
+                    pending = TakeCoalescedLocked();
+                }
+                else
+                {
+                    // The coalesced output has to be queued first; without room for it the event is dropped
+                    TryReleaseBackpressureLocked(queue);
+                    if (_coalescedOutput != null)
+                    {
+                        RecordDropLocked(evt);
+                        return ValueTask.CompletedTask;
+                    }
+                }
+            }
+            else if (_droppedSinceMarker > 0)
             {
-                if (!_headerWritten)
+                // The first event accepted after drops is preceded by a marker recording them
+                if (!queue.Writer.TryWrite(new AsciinemaEvent(_lastDroppedTime, "m", DropMarkerLabel())))
+                {
+                    RecordDropLocked(evt);
+                    return ValueTask.CompletedTask;
+                }
+                _droppedSinceMarker = 0;
+            }
+        }
+
+        if (pending is null && queue.Writer.TryWrite(evt))
+            return ValueTask.CompletedTask;
+
+        if (pending is not null)
+            return WriteBlockingAsync(queue, pending.Value, evt, ct);
+
+        var policy = canWait ? _options.BackpressurePolicy : AsciinemaBackpressurePolicy.DropWithMarker;
+        switch (policy)
+        {
+            case AsciinemaBackpressurePolicy.DropWithMarker:
+                lock (_backpressureLock)
                 {
-                    header = new AsciinemaHeader
+                    RecordDropLocked(evt);
+                    TryReleaseBackpressureLocked(queue);
+                }
+                return ValueTask.CompletedTask;
+
+            case AsciinemaBackpressurePolicy.Coalesce when evt.Code == "o":
+                lock (_backpressureLock)
+                {
+                    if (_coalescedOutput == null)
                     {
-                        Version = 2,
-                        Width = _width,
-                        Height = _height,
-                        Timestamp = _recordingStartTime.ToUnixTimeSeconds(),
-                        Title = _options.Title,
-                        Command = _options.Command,
-                        IdleTimeLimit = _options.IdleTimeLimit,
-                        Env = _options.CaptureEnvironment ? new Dictionary<string, string>
-                        {
-                            ["TERM"] = Environment.GetEnvironmentVariable("TERM") ?? "xterm-256color",
-                            ["SHELL"] = Environment.GetEnvironmentVariable("SHELL") ?? ""
-                        } : null,
-                        Theme = _options.Theme
-                    };
-                    _headerWritten = true;
+                        _coalescedOutput = new StringBuilder(evt.Data);
+                        _coalescedTime = evt.Time;
+                    }
+                    else
+                    {
+                        _coalescedOutput.Append(evt.Data);
+                        Interlocked.Increment(ref _coalescedEventCount);
+                        Metrics.RecorderCoalescedEvents.Add(1);
+                    }
+                    TryReleaseBackpressureLocked(queue);
+                }
+                return ValueTask.CompletedTask;
+
+            default:
+                return WriteBlockingAsync(queue, null, evt, ct);
+        }
+    }
+
+    private async ValueTask WriteBlockingAsync(Channel<AsciinemaEvent> queue, AsciinemaEvent? first, AsciinemaEvent evt, CancellationToken ct)
+    {
+        try
+        {
+            if (first is not null)
+                await WriteBlockingAsync(queue, first.Value, ct);
+            await WriteBlockingAsync(queue, evt, ct);
+        }
+        catch (ChannelClosedException)
+        {
+            // Recording stopped, or the background writer failed, while waiting for space
+            if (Volatile.Read(ref _writeError) != null)
+            {
+                lock (_backpressureLock)
+                {
+                    RecordDropLocked(evt);
                 }
+            }
+        }
+    }
+
+    private async ValueTask WriteBlockingAsync(Channel<AsciinemaEvent> queue, AsciinemaEvent evt, CancellationToken ct)
+    {
+        if (_options.AutoFlush)
+        {
+            await queue.Writer.WriteAsync(evt, ct);
+            return;
+        }
+
+        // Without a background writer, a full queue is written out here rather than
+        // waiting for an explicit flush that may never come
+        while (!queue.Writer.TryWrite(evt))
+        {
+            await DrainAsync(queue, force: false, ct);
+        }
+    }
+
+    /// <summary>
+    /// Moves coalesced output or a pending drop marker into the queue if the writer has made
+    /// room since, so it isn't held back until the next event arrives.
+    /// </summary>
+    private void TryReleaseBackpressureLocked(Channel<AsciinemaEvent> queue)
+    {
+        if (queue.Reader.Count >= _options.QueueCapacity)
+            return;
+
+        if (_coalescedOutput != null)
+        {
+            if (queue.Writer.TryWrite(new AsciinemaEvent(_coalescedTime, "o", _coalescedOutput.ToString())))
+                _coalescedOutput = null;
+        }
+        else if (_droppedSinceMarker > 0)
+        {
+            if (queue.Writer.TryWrite(new AsciinemaEvent(_lastDroppedTime, "m", DropMarkerLabel())))
+                _droppedSinceMarker = 0;
+        }
+    }
+
+    private string DropMarkerLabel() => $"hex1b: dropped {_droppedSinceMarker} events";
+
+    private void RecordDropLocked(AsciinemaEvent evt)
+    {
+        _droppedSinceMarker++;
+        _lastDroppedTime = evt.Time;
+        Interlocked.Increment(ref _droppedEventCount);
+        Metrics.RecorderDroppedEvents.Add(1);
+    }
+
+    private AsciinemaEvent TakeDropMarkerLocked()
+    {
+        var marker = new AsciinemaEvent(_lastDroppedTime, "m", DropMarkerLabel());
+        _droppedSinceMarker = 0;
+        return marker;
+    }
+
+    private AsciinemaEvent TakeCoalescedLocked()
+    {
+        var evt = new AsciinemaEvent(_coalescedTime, "o", _coalescedOutput!.ToString());
+        _coalescedOutput = null;
+        return evt;
+    }
+
+    private void ResetBackpressure()
+    {
+        lock (_backpressureLock)
+        {
+            _coalescedOutput = null;
+            _droppedSinceMarker = 0;
+        }
+    }
+
+    private void StartWriter(Channel<AsciinemaEvent> queue)
+    {
+        if (_options.AutoFlush)
+        {
+            _writerTask = Task.Run(() => RunWriterAsync(queue));
+        }
+    }
+
+    private async Task StopWriterAsync()
+    {
+        Task? writerTask;
+        lock (_lock)
+        {
+            _queue.Writer.TryComplete();
+            writerTask = _writerTask;
+            _writerTask = null;
+        }
 
-                eventsToWrite = new List<AsciinemaEvent>(_pendingEvents);
-                _pendingEvents.Clear();
+        if (writerTask != null)
+        {
+            await writerTask;
+        }
+    }
+
+    /// <summary>
+    /// Background writer: writes whatever has been queued each time the queue becomes non-empty.
+    /// </summary>
+    private async Task RunWriterAsync(Channel<AsciinemaEvent> queue)
+    {
+        try
+        {
+            while (await queue.Reader.WaitToReadAsync())
+            {
+                await DrainAsync(queue, force: false, CancellationToken.None);
             }
-            else
+        }
+        catch (Exception ex)
+        {
+            // Keep the terminal running: with no writer left, later events are dropped and
+            // counted instead of waiting for room, and the error surfaces from the next flush
+            lock (_lock)
             {
-                eventsToWrite = [];
+                _writeError ??= ExceptionDispatchInfo.Capture(ex);
             }
+            queue.Writer.TryComplete();
+        }
+    }
+
+    /// <summary>
+    /// Flushes any pending events to the file.
+    /// </summary>
+    /// <param name="ct">Cancellation token.</param>
+    /// <remarks>
+    /// If the file could not be written, by this flush or earlier by the background writer,
+    /// the write error is thrown. Events that could not be written are counted in
+    /// <see cref="DroppedEventCount"/>.
+    /// </remarks>
+    public async Task FlushAsync(CancellationToken ct = default)
+    {
+        Channel<AsciinemaEvent> queue;
+        lock (_lock)
+        {
+            _writeError?.Throw();
+
+            // Can't flush if no file path is set
+            if (_filePath == null)
+                return;
+            queue = _queue;
         }
 
-        // Always acquire _writeLock so we wait for any in-progress write
-        // (e.g. a concurrent auto-flush) to finish before returning.  Without
-        // this, a caller could read the file before a concurrent flush has
-        // finished creating it on disk.
+        // Draining takes _writeLock, so this also waits for any batch the background
+        // writer is part-way through; everything queued before this call is on disk
+        // when it returns.
+        await DrainAsync(queue, force: true, ct);
+    }
+
+    /// <summary>
+    /// Writes everything currently queued as one batch.
+    /// </summary>
+    /// <param name="queue">The queue to drain.</param>
+    /// <param name="force">Write the header even if there are no events, and any coalesced or dropped-event state.</param>
+    /// <param name="ct">Cancellation token.</param>
+    private async Task DrainAsync(Channel<AsciinemaEvent> queue, bool force, CancellationToken ct)
+    {
         await _writeLock.WaitAsync(ct);
         try
         {
-            if (nothingToWrite)
-                return;
+            var depth = queue.Reader.Count;
+            var start = Stopwatch.GetTimestamp();
+            bool writeHeader;
+            var events = 0;
+            long earlierDrops = 0;
+            double lastTime = 0;
+            lock (_lock)
+            {
+                if (_filePath == null)
+                    return;
+                if (depth == 0 && _initialState == null && !(force && !_headerWritten) && !HasBackpressureState())
+                    return;
+
+                writeHeader = !_headerWritten;
+                if (writeHeader)
+                {
+                    WriteHeaderLocked();
+                }
+
+                if (_initialState != null)
+                {
+                    WriteEvent(new AsciinemaEvent(0, "o", _initialState));
+                    _initialState = null;
+                    events++;
+                }
+            }
+
+            while (queue.Reader.TryRead(out var evt))
+            {
+                WriteEvent(evt);
+                events++;
+                lastTime = evt.Time;
+            }
 
-            await EnsureStreamOpenAsync(overwrite: header != null);
+            // Once the queue is empty, nothing newer can be ahead of coalesced output or a drop marker
+            lock (_backpressureLock)
+            {
+                if (queue.Reader.Count == 0)
+                {
+                    if (_coalescedOutput != null)
+                    {
+                        lastTime = Math.Max(lastTime, _coalescedTime);
+                        WriteEvent(TakeCoalescedLocked());
+                        events++;
+                    }
+                    if (_droppedSinceMarker > 0)
+                    {
+                        lastTime = Math.Max(lastTime, _lastDroppedTime);
+                        earlierDrops = _droppedSinceMarker;
+                        WriteEvent(TakeDropMarkerLocked());
+                    }
+                }
+            }
 
-            if (header != null)
+            if (_batch.WrittenCount > 0)
             {
-                var headerJson = JsonSerializer.Serialize(header, AsciinemaJsonContext.Default.AsciinemaHeader);
-                await _writer!.WriteLineAsync(headerJson);
+                try
+                {
+                    EnsureStreamOpen(overwrite: writeHeader);
+                    await _fileStream!.WriteAsync(_batch.WrittenMemory, ct);
+                    await _fileStream.FlushAsync(ct);
+                }
+                catch
+                {
+                    // The batch is gone from the queue: count it as dropped so the next batch
+                    // written starts with a marker, and rewrite the header if it never made it
+                    RecordLostBatch(events, earlierDrops, lastTime);
+                    await AbandonStreamAsync();
+                    throw;
+                }
+                _batch.Clear();
+
+                Metrics.RecorderQueueDepth.Record(depth);
+                Metrics.RecorderWriteDuration.Record(Stopwatch.GetElapsedTime(start).TotalMilliseconds);
             }
 
-            foreach (var evt in eventsToWrite)
+            if (writeHeader)
             {
-                ct.ThrowIfCancellationRequested();
-                var eventJson = JsonSerializer.Serialize(evt, AsciinemaJsonContext.Default.AsciinemaEvent);
-                await _writer!.WriteLineAsync(eventJson);
+                lock (_lock)
+                {
+                    _headerWritten = true;
+                }
             }
 
-            await _writer!.FlushAsync(ct);
+            // Close between bursts so the file can be opened by other readers
+            if (queue.Reader.Count == 0)
+            {
+                await CloseStreamAsync();
+            }
         }
         finally
         {
-            if (!nothingToWrite)
-                await CloseStreamAsync();
+            _batch.Clear();
             _writeLock.Release();
         }
     }
 
-    private async Task EnsureStreamOpenAsync(bool overwrite)
+    /// <summary>
+    /// Counts the events of a batch that could not be written as dropped, and puts back the
+    /// count of a drop marker that was part of it.
+    /// </summary>
+    private void RecordLostBatch(int events, long earlierDrops, double lastTime)
+    {
+        lock (_backpressureLock)
+        {
+            _droppedSinceMarker += events + earlierDrops;
+            _lastDroppedTime = lastTime;
+        }
+        Interlocked.Add(ref _droppedEventCount, events);
+        Metrics.RecorderDroppedEvents.Add(events);
+    }
+
+    private async Task AbandonStreamAsync()
+    {
+        var stream = _fileStream;
+        _fileStream = null;
+        try
+        {
+            if (stream != null)
+                await stream.DisposeAsync();
+        }
+        catch
+        {
+            // Disposing flushes again; the write error has already been reported
+        }
+    }
+
+    private bool HasBackpressureState()
+    {
+        lock (_backpressureLock)
+        {
+            return _coalescedOutput != null || _droppedSinceMarker > 0;
+        }
+    }
+
+    private void WriteHeaderLocked()
+    {
+        var header = new AsciinemaHeader
+        {
+            Version = 2,
+            Width = _width,
+            Height = _height,
+            Timestamp = _recordingStartTime.ToUnixTimeSeconds(),
+            Title = _options.Title,
+            Command = _options.Command,
+            IdleTimeLimit = _options.IdleTimeLimit,
+            Env = _options.CaptureEnvironment ? new Dictionary<string, string>
+            {
+                ["TERM"] = Environment.GetEnvironmentVariable("TERM") ?? "xterm-256color",
+                ["SHELL"] = Environment.GetEnvironmentVariable("SHELL") ?? ""
+            } : null,
+            Theme = _options.Theme
+        };
+
+        var json = GetJsonWriter();
+        JsonSerializer.Serialize(json, header, AsciinemaJsonContext.Default.AsciinemaHeader);
+        json.Flush();
+        _batch.Write("\n"u8);
+    }
+
+    private void WriteEvent(AsciinemaEvent evt)
+    {
+        var json = GetJsonWriter();
+        JsonSerializer.Serialize(json, evt, AsciinemaJsonContext.Default.AsciinemaEvent);
+        json.Flush();
+        _batch.Write("\n"u8);
+    }
+
+    private Utf8JsonWriter GetJsonWriter()
+    {
+        if (_json == null)
+            _json = new Utf8JsonWriter(_batch);
+        else
+            _json.Reset(_batch);
+        return _json;
+    }
+
+    private void EnsureStreamOpen(bool overwrite)
     {
         if (_fileStream == null && _filePath != null)
         {
             var mode = overwrite ? FileMode.Create : FileMode.Append;
+            // Events are written as raw UTF-8 without a BOM - asciinema player doesn't handle BOM
             _fileStream = new FileStream(
                 _filePath,
                 mode,
@@ -442,21 +977,16 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
                 FileShare.ReadWrite | FileShare.Delete,
                 4096,
                 useAsync: true);
-            // Use UTF-8 without BOM - asciinema player doesn't handle BOM
-            _writer = new StreamWriter(_fileStream, new UTF8Encoding(encoderShouldEmitUTF8Identifier: false), leaveOpen: false);
         }
-        await Task.CompletedTask;
     }
 
     private async Task CloseStreamAsync()
     {
-        if (_writer != null)
+        if (_fileStream != null)
         {
-            await _writer.DisposeAsync();
-            _writer = null;
+            await _fileStream.DisposeAsync();
+            _fileStream = null;
         }
-
-        _fileStream = null;
     }
 
     /// <summary>
@@ -466,8 +996,12 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
     {
         lock (_lock)
         {
-            _pendingEvents.Clear();
+            _initialState = null;
+            while (_queue.Reader.TryRead(out _))
+            {
+            }
         }
+        ResetBackpressure();
     }
 
     /// <inheritdoc />
@@ -479,6 +1013,8 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
         // Flush any remaining events
         try
         {
+            await _stopTask;
+            await StopWriterAsync();
             await FlushAsync();
         }
         catch
@@ -496,6 +1032,7 @@ public sealed class AsciinemaRecorder : IHex1bTerminalWorkloadFilter, IAsyncDisp
             _writeLock.Release();
         }
         
+        _json?.Dispose();
         _writeLock.Dispose();
     }
 
@@ -548,6 +1085,49 @@ public sealed class AsciinemaRecorderOptions
     /// Terminal color theme for playback.
     /// </summary>
     public AsciinemaTheme? Theme { get; set; }
+
+    /// <summary>
+    /// Maximum number of events held in memory before <see cref="BackpressurePolicy"/> applies.
+    /// Default is 4096.
+    /// </summary>
+    public int QueueCapacity { get; set; } = 4096;
+
+    /// <summary>
+    /// What to do with new events when the queue is full.
+    /// Default is <see cref="AsciinemaBackpressurePolicy.Block"/>, which never loses events.
+    /// </summary>
+    public AsciinemaBackpressurePolicy BackpressurePolicy { get; set; } = AsciinemaBackpressurePolicy.Block;
+
+    /// <summary>
+    /// Metrics instance for queue depth, write latency and backpressure counters.
+    /// If null, <see cref="Diagnostics.Hex1bMetrics.Default"/> is used.
+    /// </summary>
+    public Diagnostics.Hex1bMetrics? Metrics { get; set; }
+}
+
+/// <summary>
+/// How <see cref="AsciinemaRecorder"/> handles events when its queue is full.
+/// </summary>
+public enum AsciinemaBackpressurePolicy
+{
+    /// <summary>
+    /// Wait for the writer to make room. The terminal's output pump is slowed to disk speed
+    /// but no events are lost.
+    /// </summary>
+    Block,
+
+    /// <summary>
+    /// Discard new events and write a marker event recording how many were dropped once
+    /// there is room again.
+    /// </summary>
+    DropWithMarker,
+
+    /// <summary>
+    /// Merge new output events into one event that is queued once there is room again.
+    /// Output is kept but loses its intermediate timing. Other events wait as with
+    /// <see cref="Block"/>.
+    /// </summary>
+    Coalesce
 }
 
 /// <summary>
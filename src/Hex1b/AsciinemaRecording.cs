@@ -1,5 +1,6 @@
+using System.Buffers;
 using System.Text;
-using System.Text.Json;
+using Microsoft.Win32.SafeHandles;
 
 namespace Hex1b;
 
@@ -46,8 +47,12 @@ public enum AsciinemaPlaybackState
 /// using <see cref="Hex1bTerminalBuilder.WithAsciinemaPlayback(string, out AsciinemaRecording, double)"/>.
 /// </para>
 /// <para>
-/// When seeking backwards, the terminal state is automatically reset and events
-/// are replayed from the beginning up to the target position.
+/// Loading indexes the byte offset of every event instead of keeping event data in
+/// memory; payloads are read back from the file as they are played. After loading,
+/// terminal-state keyframes are built in the background by replaying the recording into
+/// an offscreen terminal. A seek restores the nearest keyframe at or before the target
+/// and replays only the events after it, so seeking in long recordings doesn't replay
+/// from the start. Until the keyframes are ready, seeks fall back to a full replay.
 /// </para>
 /// </remarks>
 /// <example>
@@ -69,8 +74,18 @@ public sealed class AsciinemaRecording
     private readonly string _filePath;
     private readonly List<AsciinemaEvent> _events = [];
     private readonly List<AsciinemaMarker> _markers = [];
+    private readonly List<AsciinemaKeyframe> _keyframes = [];
     private readonly object _lock = new();
-    
+
+    // Largest file range read in one call when replaying a run of events
+    private const int MaxReadChunkSize = 1024 * 1024;
+
+    private SafeFileHandle? _fileHandle;
+    private CancellationTokenSource? _keyframeCts;
+    private Task _keyframeTask = Task.CompletedTask;
+
+    private int _headerWidth;
+    private int _headerHeight;
     private int _width;
     private int _height;
     private double _duration;
@@ -142,6 +157,30 @@ public sealed class AsciinemaRecording
     /// Gets the current playback state.
     /// </summary>
     public AsciinemaPlaybackState State => _state;
+
+    /// <summary>
+    /// Bytes of output after which the keyframe builder takes a keyframe.
+    /// </summary>
+    internal int KeyframeOutputBytes { get; set; } = 64 * 1024;
+
+    /// <summary>
+    /// Seconds of recording time after which the keyframe builder takes a keyframe,
+    /// provided there was output since the previous one.
+    /// </summary>
+    internal double KeyframeInterval { get; set; } = 30;
+
+    /// <summary>
+    /// Completes when background keyframe building has finished.
+    /// </summary>
+    internal Task KeyframesBuilt => _keyframeTask;
+
+    /// <summary>
+    /// Gets the number of keyframes built so far.
+    /// </summary>
+    internal int KeyframeCount
+    {
+        get { lock (_keyframes) return _keyframes.Count; }
+    }
     
     /// <summary>
     /// Event raised when the playback state changes.
@@ -200,12 +239,15 @@ public sealed class AsciinemaRecording
     /// <param name="position">The target position to seek to.</param>
     /// <remarks>
     /// <para>
-    /// When seeking backwards, the terminal screen is cleared and events are
-    /// replayed from the beginning up to the target position without timing delays.
+    /// When seeking backwards, the terminal screen is cleared, the nearest keyframe at
+    /// or before the target is restored, and the events after it are replayed up to the
+    /// target position without timing delays. Without a keyframe, events are replayed
+    /// from the beginning.
     /// </para>
     /// <para>
     /// When seeking forwards, events are replayed without timing delays until
-    /// the target position is reached.
+    /// the target position is reached, starting from a keyframe if one lies between
+    /// the current and target positions.
     /// </para>
     /// </remarks>
     public void Seek(TimeSpan position)
@@ -236,44 +278,26 @@ public sealed class AsciinemaRecording
     {
         if (_eventsLoaded) return;
         
-        using var stream = File.OpenRead(_filePath);
-        using var reader = new StreamReader(stream, Encoding.UTF8);
+        await using var stream = new FileStream(_filePath, FileMode.Open, FileAccess.Read, FileShare.Read,
+            bufferSize: 1, FileOptions.Asynchronous | FileOptions.SequentialScan);
+        using var reader = new AsciinemaEventReader(stream);
         
         // Read header
-        var headerLine = await reader.ReadLineAsync(ct);
-        if (string.IsNullOrWhiteSpace(headerLine))
+        if (!await reader.ReadLineAsync(ct) || AsciinemaEventReader.IsBlank(reader.Line.Span))
         {
             throw new InvalidDataException("Invalid asciinema file: missing header");
         }
         
-        var header = JsonDocument.Parse(headerLine);
-        _width = header.RootElement.GetProperty("width").GetInt32();
-        _height = header.RootElement.GetProperty("height").GetInt32();
+        (_headerWidth, _headerHeight) = AsciinemaEventReader.ParseHeader(reader.Line.Span);
+        _width = _headerWidth;
+        _height = _headerHeight;
         
-        // Read all events
-        while (!ct.IsCancellationRequested)
+        // Index all events; only marker labels are decoded
+        var markerLabel = new ArrayBufferWriter<byte>();
+        while (!ct.IsCancellationRequested && await reader.ReadLineAsync(ct))
         {
-            var line = await reader.ReadLineAsync(ct);
-            if (string.IsNullOrWhiteSpace(line))
+            if (!IndexEvent(reader.Line.Span, reader.LineOffset, markerLabel))
                 break;
-            
-            var eventDoc = JsonDocument.Parse(line);
-            var eventArray = eventDoc.RootElement;
-            
-            if (eventArray.GetArrayLength() < 3)
-                continue;
-            
-            var timestamp = eventArray[0].GetDouble();
-            var eventType = eventArray[1].GetString() ?? "";
-            var eventData = eventArray[2].GetString() ?? "";
-            
-            _events.Add(new AsciinemaEvent(timestamp, eventType, eventData));
-            
-            // Collect markers for chapter navigation
-            if (eventType == "m" && !string.IsNullOrWhiteSpace(eventData))
-            {
-                _markers.Add(new AsciinemaMarker(timestamp, eventData));
-            }
         }
         
         // Calculate duration from last event
@@ -283,6 +307,51 @@ public sealed class AsciinemaRecording
         }
         
         _eventsLoaded = true;
+        
+        _keyframeCts = new CancellationTokenSource();
+        var keyframeToken = _keyframeCts.Token;
+        _keyframeTask = Task.Run(() => BuildKeyframes(keyframeToken), keyframeToken);
+    }
+    
+    /// <summary>
+    /// Adds one event line to the index. Returns false at a blank line, which ends the events.
+    /// </summary>
+    private bool IndexEvent(ReadOnlySpan<byte> line, long offset, ArrayBufferWriter<byte> markerLabel)
+    {
+        if (AsciinemaEventReader.IsBlank(line))
+            return false;
+        
+        if (!AsciinemaEventReader.TryParseEvent(line, out var timestamp, out var eventType, data: null))
+            return true;
+        
+        _events.Add(new AsciinemaEvent(timestamp, eventType, offset, line.Length));
+        
+        // Collect markers for chapter navigation
+        if (eventType == (byte)'m')
+        {
+            markerLabel.Clear();
+            AsciinemaEventReader.TryParseEvent(line, out _, out _, markerLabel);
+            var label = Encoding.UTF8.GetString(markerLabel.WrittenSpan);
+            if (!string.IsNullOrWhiteSpace(label))
+            {
+                _markers.Add(new AsciinemaMarker(timestamp, label));
+            }
+        }
+        
+        return true;
+    }
+    
+    /// <summary>
+    /// Stops keyframe building and closes the recording file.
+    /// </summary>
+    internal void Close()
+    {
+        _keyframeCts?.Cancel();
+        lock (_lock)
+        {
+            _fileHandle?.Dispose();
+            _fileHandle = null;
+        }
     }
     
     internal async Task PlaybackLoopAsync(CancellationToken ct)
@@ -406,7 +475,7 @@ public sealed class AsciinemaRecording
                 }
                 
                 // Process the event
-                ProcessEvent(evt);
+                ProcessEvents(_currentEventIndex, _currentEventIndex);
                 
                 lock (_lock)
                 {
@@ -422,37 +491,43 @@ public sealed class AsciinemaRecording
         }
     }
     
-    private void ProcessSeek(double targetPosition)
+    internal void ProcessSeek(double targetPosition)
     {
         int targetIndex = FindEventIndexForPosition(targetPosition);
+        var keyframe = FindKeyframe(targetIndex);
         
         lock (_lock)
         {
-            // If seeking backwards or to a position before current event, reset and replay
-            if (targetPosition < _currentPosition || targetIndex < _currentEventIndex)
+            var backward = targetPosition < _currentPosition || targetIndex < _currentEventIndex;
+            int replayFrom;
+            
+            if (keyframe is not null && (backward || keyframe.EventIndex >= _currentEventIndex))
             {
+                // Restore the nearest keyframe and replay only the events after it
                 _clearScreenCallback?.Invoke();
-                
-                // Replay all events from start to target
-                for (int i = 0; i <= targetIndex && i < _events.Count; i++)
-                {
-                    ProcessEvent(_events[i]);
-                }
-                
-                _currentEventIndex = Math.Max(0, targetIndex + 1);
-                _currentPosition = targetPosition;
+                _outputCallback?.Invoke(keyframe.State);
+                _width = keyframe.Width;
+                _height = keyframe.Height;
+                replayFrom = keyframe.EventIndex + 1;
+            }
+            else if (backward)
+            {
+                // No keyframe yet: reset and replay all events from start to target
+                _clearScreenCallback?.Invoke();
+                _width = _headerWidth;
+                _height = _headerHeight;
+                replayFrom = 0;
             }
             else
             {
                 // Fast-forward: replay events without delays
-                for (int i = _currentEventIndex; i <= targetIndex && i < _events.Count; i++)
-                {
-                    ProcessEvent(_events[i]);
-                }
-                
-                _currentEventIndex = Math.Max(0, targetIndex + 1);
-                _currentPosition = targetPosition;
+                replayFrom = _currentEventIndex;
             }
+            
+            ProcessEvents(replayFrom, targetIndex);
+            
+            _currentEventIndex = Math.Max(0, targetIndex + 1);
+            _currentPosition = targetPosition;
         }
         
         PositionChanged?.Invoke(targetPosition);
@@ -482,29 +557,193 @@ public sealed class AsciinemaRecording
         return result;
     }
     
-    private void ProcessEvent(AsciinemaEvent evt)
+    private AsciinemaKeyframe? FindKeyframe(int eventIndex)
     {
-        switch (evt.EventType)
+        lock (_keyframes)
         {
-            case "o": // Output event
-                var bytes = Encoding.UTF8.GetBytes(evt.Data);
-                _outputCallback?.Invoke(bytes);
-                break;
+            // Binary search for the last keyframe at or before the event
+            int left = 0;
+            int right = _keyframes.Count - 1;
+            AsciinemaKeyframe? result = null;
             
-            case "r": // Resize event
-                var parts = evt.Data.Split('x');
-                if (parts.Length == 2 &&
-                    int.TryParse(parts[0], out var width) &&
-                    int.TryParse(parts[1], out var height))
+            while (left <= right)
+            {
+                int mid = left + (right - left) / 2;
+                if (_keyframes[mid].EventIndex <= eventIndex)
                 {
-                    _width = width;
-                    _height = height;
+                    result = _keyframes[mid];
+                    left = mid + 1;
                 }
-                break;
+                else
+                {
+                    right = mid - 1;
+                }
+            }
+            
+            return result;
+        }
+    }
+    
+    /// <summary>
+    /// Replays events <paramref name="from"/> through <paramref name="to"/>, sending their
+    /// combined output to the terminal in a single write.
+    /// </summary>
+    private void ProcessEvents(int from, int to)
+    {
+        lock (_lock)
+        {
+            if (from > to || from >= _events.Count)
+                return;
+            
+            var output = new ArrayBufferWriter<byte>();
+            ReadEvents(from, Math.Min(to, _events.Count - 1), (line, index) =>
+            {
+                switch (_events[index].EventType)
+                {
+                    case (byte)'o': // Output event
+                        AsciinemaEventReader.TryParseEvent(line, out _, out _, output);
+                        break;
+                    
+                    case (byte)'r': // Resize event
+                        if (TryParseResize(line, out var width, out var height))
+                        {
+                            _width = width;
+                            _height = height;
+                        }
+                        break;
+                    
+                    // "i" (input) and "m" (marker) events are ignored
+                }
+            });
             
-            // "i" (input) and "m" (marker) events are ignored
+            if (output.WrittenCount > 0)
+                _outputCallback?.Invoke(output.WrittenMemory);
+        }
+    }
+    
+    /// <summary>
+    /// Reads the lines of events <paramref name="from"/> through <paramref name="to"/> from
+    /// the file, batching adjacent events into large reads.
+    /// </summary>
+    private void ReadEvents(int from, int to, ReadOnlySpanAction<byte, int> visit, CancellationToken ct = default)
+    {
+        SafeFileHandle handle;
+        lock (_lock)
+        {
+            handle = _fileHandle ??= File.OpenHandle(_filePath, FileMode.Open, FileAccess.Read, FileShare.Read);
+        }
+        
+        var buffer = ArrayPool<byte>.Shared.Rent(Math.Min(MaxReadChunkSize, 64 * 1024));
+        try
+        {
+            int i = from;
+            while (i <= to)
+            {
+                ct.ThrowIfCancellationRequested();
+                
+                // Extend the chunk while the next event still fits
+                long start = _events[i].Offset;
+                int last = i;
+                while (last < to && _events[last + 1].Offset + _events[last + 1].Length - start <= MaxReadChunkSize)
+                    last++;
+                
+                var length = (int)(_events[last].Offset + _events[last].Length - start);
+                if (buffer.Length < length)
+                {
+                    ArrayPool<byte>.Shared.Return(buffer);
+                    buffer = ArrayPool<byte>.Shared.Rent(length);
+                }
+                
+                var read = 0;
+                while (read < length)
+                {
+                    var n = RandomAccess.Read(handle, buffer.AsSpan(read, length - read), start + read);
+                    if (n == 0)
+                        throw new InvalidDataException("Asciinema file was truncated during playback");
+                    read += n;
+                }
+                
+                for (; i <= last; i++)
+                {
+                    var evt = _events[i];
+                    visit(buffer.AsSpan((int)(evt.Offset - start), evt.Length), i);
+                }
+            }
         }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+    }
+    
+    private static bool TryParseResize(ReadOnlySpan<byte> line, out int width, out int height)
+    {
+        width = height = 0;
+        var data = new ArrayBufferWriter<byte>(16);
+        return AsciinemaEventReader.TryParseEvent(line, out _, out _, data)
+            && AsciinemaEventReader.TryParseSize(data.WrittenSpan, out width, out height);
     }
     
-    private readonly record struct AsciinemaEvent(double Timestamp, string EventType, string Data);
+    /// <summary>
+    /// Replays the recording into an offscreen terminal and records keyframes along the way.
+    /// </summary>
+    private void BuildKeyframes(CancellationToken ct)
+    {
+        if (_events.Count == 0 || _headerWidth <= 0 || _headerHeight <= 0)
+            return;
+        
+        using var terminal = new OffscreenTerminal(_headerWidth, _headerHeight);
+        var width = _headerWidth;
+        var height = _headerHeight;
+        long bytesSinceKeyframe = 0;
+        double lastKeyframeTime = 0;
+        
+        try
+        {
+            ReadEvents(0, _events.Count - 1, (line, index) =>
+            {
+                var evt = _events[index];
+                if (evt.EventType == (byte)'o')
+                {
+                    var before = terminal.Output.WrittenCount;
+                    AsciinemaEventReader.TryParseEvent(line, out _, out _, terminal.Output);
+                    bytesSinceKeyframe += terminal.Output.WrittenCount - before;
+                    terminal.Commit();
+                }
+                else if (evt.EventType == (byte)'r' && TryParseResize(line, out var w, out var h))
+                {
+                    width = w;
+                    height = h;
+                }
+                
+                if (bytesSinceKeyframe == 0
+                    || (bytesSinceKeyframe < KeyframeOutputBytes && evt.Timestamp - lastKeyframeTime < KeyframeInterval))
+                    return;
+                
+                // A keyframe must not split an escape sequence; the next event completes it
+                if (!terminal.TryCaptureState(out var state))
+                    return;
+                
+                lock (_keyframes)
+                {
+                    _keyframes.Add(new AsciinemaKeyframe(index, evt.Timestamp, width, height, state));
+                }
+                bytesSinceKeyframe = 0;
+                lastKeyframeTime = evt.Timestamp;
+            }, ct);
+        }
+        catch (OperationCanceledException)
+        {
+            // Recording closed
+        }
+        catch (Exception ex) when (ex is IOException or ObjectDisposedException or InvalidDataException)
+        {
+            // Keyframes are only an optimization; seeking falls back to a full replay
+            System.Diagnostics.Debug.WriteLine($"Keyframe build error: {ex.Message}");
+        }
+    }
+    
+    private readonly record struct AsciinemaEvent(double Timestamp, byte EventType, long Offset, int Length);
+    
+    private sealed record AsciinemaKeyframe(int EventIndex, double Timestamp, int Width, int Height, byte[] State);
 }
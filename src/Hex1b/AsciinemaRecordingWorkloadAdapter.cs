@@ -149,6 +149,7 @@ internal sealed class AsciinemaRecordingWorkloadAdapter : IHex1bTerminalWorkload
             }
         }
         
+        _recording.Close();
         _outputChannel.Writer.TryComplete();
         _cts.Dispose();
     }
@@ -14,6 +14,7 @@ public sealed class CellPatternSearcher
 {
     private readonly ImmutableList<IPatternStep> _steps;
     private readonly ImmutableStack<string> _activeCaptures;
+    private CompiledCellPattern? _compiled;
 
     /// <summary>
     /// Creates a new empty pattern searcher.
@@ -46,7 +47,7 @@ public sealed class CellPatternSearcher
     /// Starts the pattern by finding all cells containing the specified character.
     /// </summary>
     public CellPatternSearcher Find(char c) =>
-        Find(ctx => ctx.Cell.Character == c.ToString());
+        AddStep(new FindPredicateStep(c.ToString()));
 
     /// <summary>
     /// Starts the pattern by finding all occurrences of the specified text.
@@ -167,26 +168,38 @@ public sealed class CellPatternSearcher
     /// <summary>
     /// Moves one cell to the right and matches if it contains the specified character.
     /// </summary>
-    public CellPatternSearcher Right(char c) =>
-        Right(ctx => ctx.Cell.Character == c.ToString());
+    public CellPatternSearcher Right(char c)
+    {
+        var s = c.ToString();
+        return Right(ctx => ctx.Cell.Character == s);
+    }
 
     /// <summary>
     /// Moves one cell to the left and matches if it contains the specified character.
     /// </summary>
-    public CellPatternSearcher Left(char c) =>
-        Left(ctx => ctx.Cell.Character == c.ToString());
+    public CellPatternSearcher Left(char c)
+    {
+        var s = c.ToString();
+        return Left(ctx => ctx.Cell.Character == s);
+    }
 
     /// <summary>
     /// Moves one cell up and matches if it contains the specified character.
     /// </summary>
-    public CellPatternSearcher Up(char c) =>
-        Up(ctx => ctx.Cell.Character == c.ToString());
+    public CellPatternSearcher Up(char c)
+    {
+        var s = c.ToString();
+        return Up(ctx => ctx.Cell.Character == s);
+    }
 
     /// <summary>
     /// Moves one cell down and matches if it contains the specified character.
     /// </summary>
-    public CellPatternSearcher Down(char c) =>
-        Down(ctx => ctx.Cell.Character == c.ToString());
+    public CellPatternSearcher Down(char c)
+    {
+        var s = c.ToString();
+        return Down(ctx => ctx.Cell.Character == s);
+    }
 
     #endregion
 
@@ -323,14 +336,20 @@ public sealed class CellPatternSearcher
     /// <summary>
     /// Moves right until the specified character is found (inclusive).
     /// </summary>
-    public CellPatternSearcher RightUntil(char c) =>
-        RightUntil(ctx => ctx.Cell.Character == c.ToString());
+    public CellPatternSearcher RightUntil(char c)
+    {
+        var s = c.ToString();
+        return RightUntil(ctx => ctx.Cell.Character == s);
+    }
 
     /// <summary>
     /// Moves left until the specified character is found (inclusive).
     /// </summary>
-    public CellPatternSearcher LeftUntil(char c) =>
-        LeftUntil(ctx => ctx.Cell.Character == c.ToString());
+    public CellPatternSearcher LeftUntil(char c)
+    {
+        var s = c.ToString();
+        return LeftUntil(ctx => ctx.Cell.Character == s);
+    }
 
     /// <summary>
     /// Moves right until the specified text is found (inclusive).
@@ -503,23 +522,27 @@ public sealed class CellPatternSearcher
 
     #region Execution
 
+    /// <summary>
+    /// Compiles the pattern for repeated searching.
+    /// </summary>
+    /// <remarks>
+    /// <see cref="Search"/> and <see cref="SearchFirst"/> compile on first use and reuse the
+    /// result, so calling this is only needed to hold on to the compiled form directly.
+    /// </remarks>
+    public CompiledCellPattern Compile() =>
+        LazyInitializer.EnsureInitialized(ref _compiled, () => new CompiledCellPattern(_steps));
+
     /// <summary>
     /// Searches for all occurrences of the pattern in the region.
     /// </summary>
-    public CellPatternSearchResult Search(IHex1bTerminalRegion region)
-    {
-        var executor = new PatternExecutor(region, _steps);
-        return executor.Execute();
-    }
+    public CellPatternSearchResult Search(IHex1bTerminalRegion region) =>
+        Compile().Search(region);
 
     /// <summary>
     /// Searches for the first occurrence of the pattern in the region.
     /// </summary>
-    public CellPatternMatch? SearchFirst(IHex1bTerminalRegion region)
-    {
-        var executor = new PatternExecutor(region, _steps);
-        return executor.ExecuteFirst();
-    }
+    public CellPatternMatch? SearchFirst(IHex1bTerminalRegion region) =>
+        Compile().SearchFirst(region);
 
     #endregion
 
@@ -0,0 +1,111 @@
+using System.Collections.Immutable;
+
+namespace Hex1b.Automation;
+
+/// <summary>
+/// A <see cref="CellPatternSearcher"/> compiled into a flat step program that can be run
+/// against many regions without re-analysing the pattern.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Compilation resolves the step that seeds candidate positions, the captures that are
+/// open when it matches, and inlines <c>Then(...)</c> sub-patterns that follow it, so
+/// each candidate position runs a straight list of steps.
+/// </para>
+/// <para>
+/// Seeding uses the region's text index: literal and regex <c>Find</c> steps search the
+/// row text instead of visiting every cell, and <see cref="CellPatternSearcher.Find(char)"/>
+/// only evaluates cells the text says can match. On snapshots the index is built once and
+/// shared by every search, so running several patterns against one large capture pays for
+/// text extraction only once.
+/// </para>
+/// <para>
+/// Compiled patterns are immutable and safe to use from multiple threads.
+/// </para>
+/// </remarks>
+public sealed class CompiledCellPattern
+{
+    internal CompiledCellPattern(ImmutableList<IPatternStep> steps)
+    {
+        FindStepIndex = -1;
+        for (int i = 0; i < steps.Count; i++)
+        {
+            if (steps[i] is FindPredicateStep or FindRegexStep or FindTextStep or FindMultilineRegexStep)
+            {
+                FindStepIndex = i;
+                break;
+            }
+        }
+
+        // Captures opened (and not yet closed) before the seeding step
+        var captureStack = new Stack<string>();
+        for (int i = 0; i < FindStepIndex; i++)
+        {
+            if (steps[i] is BeginCaptureStep beginCapture)
+                captureStack.Push(beginCapture.Name);
+            else if (steps[i] is EndCaptureStep && captureStack.Count > 0)
+                captureStack.Pop();
+        }
+        LeadingCaptures = captureStack.Reverse().ToArray();
+
+        // Steps after the seeding step. Composite steps are plain sequences, so they are
+        // inlined; a Find inside one still runs as a continuation step, never as a seed.
+        var body = new List<IPatternStep>();
+        for (int i = FindStepIndex + 1; i < steps.Count; i++)
+            Inline(steps[i], body);
+
+        FindStep = FindStepIndex >= 0 ? steps[FindStepIndex] : null;
+        Body = body.ToArray();
+    }
+
+    /// <summary>
+    /// The step that seeds candidate positions, or null to start from every cell.
+    /// </summary>
+    internal IPatternStep? FindStep { get; }
+
+    /// <summary>
+    /// Index of <see cref="FindStep"/> in the original step list, or -1.
+    /// </summary>
+    internal int FindStepIndex { get; }
+
+    /// <summary>
+    /// Capture names active when <see cref="FindStep"/> matches, outermost first.
+    /// </summary>
+    internal string[] LeadingCaptures { get; }
+
+    /// <summary>
+    /// Steps run from each candidate position, in order.
+    /// </summary>
+    internal IPatternStep[] Body { get; }
+
+    /// <summary>
+    /// Searches for all occurrences of the pattern in the region.
+    /// </summary>
+    public CellPatternSearchResult Search(IHex1bTerminalRegion region)
+    {
+        var executor = new PatternExecutor(region, this);
+        return executor.Execute();
+    }
+
+    /// <summary>
+    /// Searches for the first occurrence of the pattern in the region.
+    /// </summary>
+    public CellPatternMatch? SearchFirst(IHex1bTerminalRegion region)
+    {
+        var executor = new PatternExecutor(region, this);
+        return executor.ExecuteFirst();
+    }
+
+    private static void Inline(IPatternStep step, List<IPatternStep> body)
+    {
+        if (step is CompositeStep composite)
+        {
+            foreach (var inner in composite.Steps)
+                Inline(inner, body);
+        }
+        else
+        {
+            body.Add(step);
+        }
+    }
+}
@@ -52,31 +52,9 @@ public static class Hex1bTerminalRegionExtensions
         if (y < 0 || y >= region.Height)
             return "";
 
-        var sb = new StringBuilder();
-        for (int x = 0; x < region.Width; x++)
-        {
-            var cell = region.GetCell(x, y);
-            var ch = cell.Character;
-
-            // Preserve the width of ordinary empty/unwritten cells as spaces so
-            // text snapshots keep their terminal geometry stable across platforms.
-            // But continuation cells for wide characters are zero-width in the
-            // textual view and should not show up as visible spaces.
-            if (string.IsNullOrEmpty(ch))
-            {
-                if (!IsWideCharContinuation(region, x, y))
-                    sb.Append(' ');
-            }
-            else if (ch == "\uE000" || ch == "\0")
-            {
-                sb.Append(' ');
-            }
-            else
-            {
-                sb.Append(ch);
-            }
-        }
-        return sb.ToString();
+        // Snapshots cache their line text so repeated searches don't rebuild it
+        return TerminalRegionTextIndex.TryGetShared(region)?.GetLine(y)
+            ?? TerminalRegionTextIndex.BuildLine(region, y, columns: null);
     }
 
     /// <summary>
@@ -221,7 +199,7 @@ public static class Hex1bTerminalRegionExtensions
         return true;
     }
 
-    private static bool ColorsEqual(Theming.Hex1bColor? a, Theming.Hex1bColor? b)
+    internal static bool ColorsEqual(Theming.Hex1bColor? a, Theming.Hex1bColor? b)
     {
         if (a is null && b is null)
             return true;
@@ -230,95 +208,44 @@ public static class Hex1bTerminalRegionExtensions
         return a.Value.R == b.Value.R && a.Value.G == b.Value.G && a.Value.B == b.Value.B;
     }
 
-    private static bool IsWideCharContinuation(IHex1bTerminalRegion region, int x, int y)
-    {
-        if (x <= 0)
-            return false;
-
-        var previous = region.GetCell(x - 1, y).Character;
-        return !string.IsNullOrEmpty(previous)
-            && previous != "\uE000"
-            && previous != "\0"
-            && DisplayWidth.GetGraphemeWidth(previous) > 1;
-    }
-
     /// <summary>
     /// Checks if any cell in the region has the specified attribute.
     /// </summary>
     public static bool HasAttribute(this IHex1bTerminalRegion region, CellAttributes attribute)
-    {
-        for (int y = 0; y < region.Height; y++)
-        {
-            for (int x = 0; x < region.Width; x++)
-            {
-                var cell = region.GetCell(x, y);
-                if ((cell.Attributes & attribute) != 0)
-                    return true;
-            }
-        }
-        return false;
-    }
+        => AnyRun(region, run => (run.Attributes & attribute) != 0);
 
     /// <summary>
     /// Checks if any cell in the region has a non-null foreground color.
     /// </summary>
     public static bool HasForegroundColor(this IHex1bTerminalRegion region)
-    {
-        for (int y = 0; y < region.Height; y++)
-        {
-            for (int x = 0; x < region.Width; x++)
-            {
-                if (region.GetCell(x, y).Foreground is not null)
-                    return true;
-            }
-        }
-        return false;
-    }
+        => AnyRun(region, run => run.Foreground is not null);
 
     /// <summary>
     /// Checks if any cell in the region has a non-null background color.
     /// </summary>
     public static bool HasBackgroundColor(this IHex1bTerminalRegion region)
-    {
-        for (int y = 0; y < region.Height; y++)
-        {
-            for (int x = 0; x < region.Width; x++)
-            {
-                if (region.GetCell(x, y).Background is not null)
-                    return true;
-            }
-        }
-        return false;
-    }
+        => AnyRun(region, run => run.Background is not null);
 
     /// <summary>
     /// Checks if any cell in the region has the specified foreground color.
     /// </summary>
     public static bool HasForegroundColor(this IHex1bTerminalRegion region, Theming.Hex1bColor color)
-    {
-        for (int y = 0; y < region.Height; y++)
-        {
-            for (int x = 0; x < region.Width; x++)
-            {
-                var fg = region.GetCell(x, y).Foreground;
-                if (fg is not null && ColorsEqual(fg, color))
-                    return true;
-            }
-        }
-        return false;
-    }
+        => AnyRun(region, run => run.Foreground is not null && ColorsEqual(run.Foreground, color));
 
     /// <summary>
     /// Checks if any cell in the region has the specified background color.
     /// </summary>
     public static bool HasBackgroundColor(this IHex1bTerminalRegion region, Theming.Hex1bColor color)
+        => AnyRun(region, run => run.Background is not null && ColorsEqual(run.Background, color));
+
+    private static bool AnyRun(IHex1bTerminalRegion region, Func<CellAttributeRun, bool> predicate)
     {
-        for (int y = 0; y < region.Height; y++)
+        var index = TerminalRegionTextIndex.For(region);
+        for (int y = 0; y < index.Height; y++)
         {
-            for (int x = 0; x < region.Width; x++)
+            foreach (var run in index.GetAttributeRuns(y))
             {
-                var bg = region.GetCell(x, y).Background;
-                if (bg is not null && ColorsEqual(bg, color))
+                if (predicate(run))
                     return true;
             }
         }
@@ -658,13 +585,13 @@ public static class Hex1bTerminalRegionExtensions
     private static List<MultiLineTextMatch> FindMultiLinePatternCore(IHex1bTerminalRegion region, Regex regex, bool trimLines, string? lineSeparator)
     {
         var results = new List<MultiLineTextMatch>();
-        var (fullText, lineOffsets) = BuildFullTextWithOffsets(region, trimLines, lineSeparator);
+        var (fullText, lineOffsets) = TerminalRegionTextIndex.For(region).GetJoinedText(trimLines, lineSeparator);
 
         var matches = regex.Matches(fullText);
         foreach (Match match in matches)
         {
-            var (startLine, startColumn) = OffsetToLineColumn(match.Index, lineOffsets);
-            var (endLine, endColumn) = OffsetToLineColumn(match.Index + match.Length, lineOffsets);
+            var (startLine, startColumn) = TerminalRegionTextIndex.OffsetToLineColumn(match.Index, lineOffsets);
+            var (endLine, endColumn) = TerminalRegionTextIndex.OffsetToLineColumn(match.Index + match.Length, lineOffsets);
             results.Add(new MultiLineTextMatch(startLine, startColumn, endLine, endColumn, match.Value));
         }
         return results;
@@ -672,62 +599,15 @@ public static class Hex1bTerminalRegionExtensions
 
     private static MultiLineTextMatch? FindFirstMultiLinePatternCore(IHex1bTerminalRegion region, Regex regex, bool trimLines, string? lineSeparator)
     {
-        var (fullText, lineOffsets) = BuildFullTextWithOffsets(region, trimLines, lineSeparator);
+        var (fullText, lineOffsets) = TerminalRegionTextIndex.For(region).GetJoinedText(trimLines, lineSeparator);
 
         var match = regex.Match(fullText);
         if (match.Success)
         {
-            var (startLine, startColumn) = OffsetToLineColumn(match.Index, lineOffsets);
-            var (endLine, endColumn) = OffsetToLineColumn(match.Index + match.Length, lineOffsets);
+            var (startLine, startColumn) = TerminalRegionTextIndex.OffsetToLineColumn(match.Index, lineOffsets);
+            var (endLine, endColumn) = TerminalRegionTextIndex.OffsetToLineColumn(match.Index + match.Length, lineOffsets);
             return new MultiLineTextMatch(startLine, startColumn, endLine, endColumn, match.Value);
         }
         return null;
     }
-
-    private static (string fullText, int[] lineOffsets) BuildFullTextWithOffsets(IHex1bTerminalRegion region, bool trimLines, string? lineSeparator)
-    {
-        var sb = new StringBuilder();
-        // Store the start offset of each line's content (after any preceding separator)
-        var lineOffsets = new int[region.Height + 1]; // +1 for end sentinel
-        var separator = lineSeparator ?? "";
-
-        for (int y = 0; y < region.Height; y++)
-        {
-            if (y > 0 && separator.Length > 0)
-                sb.Append(separator);
-            // Record the start offset of this line's content
-            lineOffsets[y] = sb.Length;
-            // Use trimmed or untrimmed lines based on parameter
-            sb.Append(trimLines ? region.GetLineTrimmed(y) : region.GetLine(y));
-        }
-        lineOffsets[region.Height] = sb.Length;
-
-        return (sb.ToString(), lineOffsets);
-    }
-
-    private static (int line, int column) OffsetToLineColumn(int offset, int[] lineOffsets)
-    {
-        // Find the line that contains this offset using linear search
-        // For typical terminal heights (< 100 lines), this is efficient enough
-        int line = 0;
-        for (int i = 0; i < lineOffsets.Length - 1; i++)
-        {
-            int lineStart = lineOffsets[i];
-            int nextLineStart = lineOffsets[i + 1];
-            
-            // The newline character between lines is at nextLineStart - 1
-            // Characters from lineStart to (nextLineStart - 1) inclusive belong to line i
-            // Note: For the last line, this is just until the end
-            if (offset >= lineStart && (i == lineOffsets.Length - 2 || offset < nextLineStart))
-            {
-                line = i;
-                break;
-            }
-        }
-
-        // Calculate column within the line
-        int column = offset - lineOffsets[line];
-
-        return (line, column);
-    }
 }
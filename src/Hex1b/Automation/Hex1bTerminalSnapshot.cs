@@ -8,8 +8,9 @@ namespace Hex1b.Automation;
 /// </summary>
 public sealed class Hex1bTerminalSnapshot : IHex1bTerminalRegion, IDisposable
 {
-    private readonly TerminalCell[,] _cells;
-    private bool _disposed;
+    private readonly TerminalCell[][] _rows;
+    private readonly TerminalCell _fillCell;
+    private TerminalRegionTextIndex? _textIndex;
 
     /// <summary>
     /// Number of scrollback lines included in this snapshot (prepended above visible content).
@@ -24,10 +25,15 @@ public sealed class Hex1bTerminalSnapshot : IHex1bTerminalRegion, IDisposable
     internal Hex1bTerminalSnapshot(Hex1bTerminal terminal, int scrollbackLines, ScrollbackWidth scrollbackWidth, TerminalCell voidCell)
     {
         Terminal = terminal;
-        var terminalWidth = terminal.Width;
-        var terminalHeight = terminal.Height;
-        CursorX = terminal.CursorX;
-        CursorY = terminal.CursorY;
+
+        // Pin the screen rows first: this is the only part that needs the buffer lock and it
+        // doesn't copy any cells. The rows are shared copy-on-write with the terminal, which
+        // clones a row only when it next writes to it.
+        var pinned = terminal.PinScreen(scrollbackLines);
+        Generation = pinned.Generation;
+        CursorX = pinned.CursorX;
+        CursorY = pinned.CursorY;
+
         InAlternateScreen = terminal.InAlternateScreen;
         CursorVisible = terminal.CursorVisible;
         BracketedPasteEnabled = terminal.BracketedPasteEnabled;
@@ -62,71 +68,32 @@ public sealed class Hex1bTerminalSnapshot : IHex1bTerminalRegion, IDisposable
         }
         KgpImages = images;
 
-        // Get scrollback rows if requested
-        ScrollbackRow[] scrollbackRows = [];
-        if (scrollbackLines > 0 && terminal.Scrollback is { } scrollback)
-        {
-            scrollbackRows = scrollback.GetLines(scrollbackLines);
-        }
+        var scrollbackRows = pinned.ScrollbackRows;
         ScrollbackLineCount = scrollbackRows.Length;
 
         // Determine snapshot dimensions
-        int snapshotWidth;
-        if (scrollbackWidth == ScrollbackWidth.Original && scrollbackRows.Length > 0)
+        var terminalWidth = pinned.Width;
+        int snapshotWidth = terminalWidth;
+        if (scrollbackWidth == ScrollbackWidth.Original)
         {
-            snapshotWidth = terminalWidth;
             foreach (var row in scrollbackRows)
             {
                 if (row.OriginalWidth > snapshotWidth)
                     snapshotWidth = row.OriginalWidth;
             }
         }
-        else
-        {
-            snapshotWidth = terminalWidth;
-        }
 
-        int totalHeight = scrollbackRows.Length + terminalHeight;
         Width = snapshotWidth;
-        Height = totalHeight;
+        Height = scrollbackRows.Length + pinned.Height;
 
-        _cells = new TerminalCell[totalHeight, snapshotWidth];
-
-        // Pre-fill with void cell if snapshot is wider than any source row
-        if (snapshotWidth > terminalWidth)
-        {
-            for (int y = 0; y < totalHeight; y++)
-            {
-                for (int x = 0; x < snapshotWidth; x++)
-                {
-                    _cells[y, x] = voidCell;
-                }
-            }
-        }
-
-        // Fill scrollback rows (top of snapshot)
-        for (int rowIdx = 0; rowIdx < scrollbackRows.Length; rowIdx++)
-        {
-            var row = scrollbackRows[rowIdx];
-            int copyWidth = Math.Min(row.Cells.Length, snapshotWidth);
-            for (int x = 0; x < copyWidth; x++)
-            {
-                _cells[rowIdx, x] = row.Cells[x];
-                row.Cells[x].TrackedSixel?.AddRef();
-                row.Cells[x].TrackedHyperlink?.AddRef();
-            }
-        }
-
-        // Fill visible area (below scrollback)
-        var screenBuffer = terminal.GetScreenBuffer(addTrackedObjectRefs: true);
-        for (int y = 0; y < terminalHeight; y++)
-        {
-            int copyWidth = Math.Min(terminalWidth, snapshotWidth);
-            for (int x = 0; x < copyWidth; x++)
-            {
-                _cells[scrollbackRows.Length + y, x] = screenBuffer[y, x];
-            }
-        }
+        // Scrollback rows are immutable once pushed, so they are referenced rather than
+        // copied, just like the pinned screen rows. Cells past the end of a row read as
+        // the void cell when the snapshot is wider than the terminal.
+        _rows = new TerminalCell[Height][];
+        for (int i = 0; i < scrollbackRows.Length; i++)
+            _rows[i] = scrollbackRows[i].Cells;
+        Array.Copy(pinned.ScreenRows, 0, _rows, scrollbackRows.Length, pinned.Height);
+        _fillCell = snapshotWidth > terminalWidth ? voidCell : default;
 
         // Adjust cursor position to account for prepended scrollback rows
         CursorY += scrollbackRows.Length;
@@ -137,6 +104,11 @@ public sealed class Hex1bTerminalSnapshot : IHex1bTerminalRegion, IDisposable
     /// </summary>
     public Hex1bTerminal Terminal { get; }
 
+    /// <summary>
+    /// The terminal's <see cref="Hex1bTerminal.ScreenGeneration"/> when the snapshot was taken.
+    /// </summary>
+    public long Generation { get; }
+
     /// <summary>
     /// Terminal width at snapshot time.
     /// </summary>
@@ -263,19 +235,38 @@ public sealed class Hex1bTerminalSnapshot : IHex1bTerminalRegion, IDisposable
     {
         if (x < 0 || x >= Width || y < 0 || y >= Height)
             return TerminalCell.Empty;
-        return _cells[y, x];
+        var row = _rows[y];
+        return x < row.Length ? row[x] : _fillCell;
+    }
+
+    /// <summary>
+    /// Returns the cell array backing row <paramref name="y"/>, or null if the row reads any
+    /// fill cells. Rows are shared copy-on-write, so two snapshots return the same array for
+    /// a row exactly when the terminal didn't write to it in between.
+    /// </summary>
+    internal TerminalCell[]? GetSharedRow(int y)
+    {
+        var row = _rows[y];
+        return row.Length >= Width ? row : null;
     }
 
+    /// <summary>
+    /// Text and attribute index shared by every search on this snapshot, built on first use.
+    /// </summary>
+    internal TerminalRegionTextIndex TextIndex =>
+        LazyInitializer.EnsureInitialized(ref _textIndex, () => new TerminalRegionTextIndex(this));
+
     /// <summary>
     /// Checks if any cell in the snapshot contains Sixel data.
     /// </summary>
     public bool ContainsSixelData()
     {
-        for (int y = 0; y < Height; y++)
+        foreach (var row in _rows)
         {
-            for (int x = 0; x < Width; x++)
+            var width = Math.Min(row.Length, Width);
+            for (int x = 0; x < width; x++)
             {
-                if (_cells[y, x].TrackedSixel is not null)
+                if (row[x].TrackedSixel is not null)
                     return true;
             }
         }
@@ -295,22 +286,14 @@ public sealed class Hex1bTerminalSnapshot : IHex1bTerminalRegion, IDisposable
     public string GetScreenText() => this.GetText();
 
     /// <summary>
-    /// Releases tracked object references held by this snapshot.
+    /// Releases the snapshot.
     /// </summary>
+    /// <remarks>
+    /// Snapshots share rows copy-on-write with the terminal and don't hold tracked object
+    /// references, so there is nothing to release; the method is kept so existing
+    /// <c>using</c> patterns continue to compile.
+    /// </remarks>
     public void Dispose()
     {
-        if (_disposed)
-            return;
-        _disposed = true;
-
-        // Release all tracked object references
-        for (int y = 0; y < Height; y++)
-        {
-            for (int x = 0; x < Width; x++)
-            {
-                _cells[y, x].TrackedSixel?.Release();
-                _cells[y, x].TrackedHyperlink?.Release();
-            }
-        }
     }
 }
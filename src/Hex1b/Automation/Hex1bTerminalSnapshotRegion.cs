@@ -14,6 +14,7 @@ public sealed class Hex1bTerminalSnapshotRegion : IHex1bTerminalRegion
 {
     private readonly IHex1bTerminalRegion _parent;
     private readonly Rect _bounds;
+    private TerminalRegionTextIndex? _textIndex;
 
     internal Hex1bTerminalSnapshotRegion(IHex1bTerminalRegion parent, Rect bounds)
     {
@@ -41,6 +42,12 @@ public sealed class Hex1bTerminalSnapshotRegion : IHex1bTerminalRegion
         return _parent.GetCell(_bounds.X + x, _bounds.Y + y);
     }
 
+    /// <summary>
+    /// Text and attribute index shared by every search on this region, built on first use.
+    /// </summary>
+    internal TerminalRegionTextIndex TextIndex =>
+        LazyInitializer.EnsureInitialized(ref _textIndex, () => new TerminalRegionTextIndex(this));
+
     /// <inheritdoc />
     public Hex1bTerminalSnapshotRegion GetRegion(Rect bounds)
     {
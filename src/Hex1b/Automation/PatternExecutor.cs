@@ -1,5 +1,3 @@
-using System.Collections.Immutable;
-
 namespace Hex1b.Automation;
 
 /// <summary>
@@ -18,20 +16,22 @@ internal readonly record struct StartPosition(
 internal sealed class PatternExecutor
 {
     private readonly IHex1bTerminalRegion _region;
-    private readonly ImmutableList<IPatternStep> _steps;
+    private readonly CompiledCellPattern _pattern;
 
-    public PatternExecutor(IHex1bTerminalRegion region, ImmutableList<IPatternStep> steps)
+    public PatternExecutor(IHex1bTerminalRegion region, CompiledCellPattern pattern)
     {
         _region = region;
-        _steps = steps;
+        _pattern = pattern;
     }
 
+    private bool IsEmpty => _pattern.FindStep is null && _pattern.Body.Length == 0;
+
     /// <summary>
     /// Executes the pattern and returns all matches.
     /// </summary>
     public CellPatternSearchResult Execute()
     {
-        if (_steps.Count == 0)
+        if (IsEmpty)
             return CellPatternSearchResult.Empty;
 
         var matches = new List<CellPatternMatch>();
@@ -61,7 +61,7 @@ internal sealed class PatternExecutor
     /// </summary>
     public CellPatternMatch? ExecuteFirst()
     {
-        if (_steps.Count == 0)
+        if (IsEmpty)
             return null;
 
         var startingPositions = FindStartingPositions();
@@ -88,75 +88,63 @@ internal sealed class PatternExecutor
     private List<StartPosition> FindStartingPositions()
     {
         var positions = new List<StartPosition>();
+        var findStep = _pattern.FindStep;
+        var findStepIndex = _pattern.FindStepIndex;
 
-        if (_steps.Count == 0)
-            return positions;
-
-        // Find the first Find step (there may be BeginCapture steps before it)
-        int findStepIndex = -1;
-        for (int i = 0; i < _steps.Count; i++)
+        if (findStep is null)
         {
-            if (_steps[i] is FindPredicateStep or FindRegexStep or FindTextStep or FindMultilineRegexStep)
+            // No Find step - start from every cell
+            for (int y = 0; y < _region.Height; y++)
             {
-                findStepIndex = i;
-                break;
+                for (int x = 0; x < _region.Width; x++)
+                {
+                    positions.Add(new StartPosition(x, y, x, y, 0, -1, FindOptions.Default));
+                }
             }
+            return positions;
         }
 
-        if (findStepIndex >= 0)
+        // Seed positions come from the region's shared text index so repeated searches
+        // over the same snapshot don't re-extract its text.
+        var index = TerminalRegionTextIndex.For(_region);
+
+        if (findStep is FindPredicateStep predicateStep)
         {
-            var findStep = _steps[findStepIndex];
-            
-            if (findStep is FindPredicateStep predicateStep)
+            var found = predicateStep.FindStartingPositions(_region, index);
+            foreach (var (x, y) in found)
             {
-                var found = predicateStep.FindStartingPositions(_region);
-                foreach (var (x, y) in found)
-                {
-                    positions.Add(new StartPosition(x, y, x, y, 1, findStepIndex, FindOptions.Default));
-                }
+                positions.Add(new StartPosition(x, y, x, y, 1, findStepIndex, FindOptions.Default));
             }
-            else if (findStep is FindTextStep textStep)
+        }
+        else if (findStep is FindTextStep textStep)
+        {
+            var found = textStep.FindStartingPositions(index);
+            foreach (var (x, y, length) in found)
             {
-                var found = textStep.FindStartingPositions(_region);
-                foreach (var (x, y, length) in found)
-                {
-                    var endX = x + length - 1;
-                    positions.Add(new StartPosition(x, y, endX, y, length, findStepIndex, textStep.Options));
-                }
+                var endX = x + length - 1;
+                positions.Add(new StartPosition(x, y, endX, y, length, findStepIndex, textStep.Options));
             }
-            else if (findStep is FindRegexStep regexStep)
-            {
-                var found = regexStep.FindStartingPositions(_region);
-                foreach (var (x, y, length) in found)
-                {
-                    var endX = x + length - 1;
-                    positions.Add(new StartPosition(x, y, endX, y, length, findStepIndex, regexStep.Options));
-                }
-            }
-            else if (findStep is FindMultilineRegexStep multilineStep)
+        }
+        else if (findStep is FindRegexStep regexStep)
+        {
+            var found = regexStep.FindStartingPositions(index);
+            foreach (var (x, y, length) in found)
             {
-                var found = multilineStep.FindStartingPositions(_region);
-                foreach (var match in found)
-                {
-                    // Calculate total length across lines (approximate for cell count)
-                    var lineCount = match.EndY - match.StartY + 1;
-                    var totalLength = match.Text.Length; // Use text length as approximation
-                    positions.Add(new StartPosition(
-                        match.StartX, match.StartY,
-                        match.EndX, match.EndY,
-                        totalLength, findStepIndex, multilineStep.Options));
-                }
+                var endX = x + length - 1;
+                positions.Add(new StartPosition(x, y, endX, y, length, findStepIndex, regexStep.Options));
             }
         }
-        else
+        else if (findStep is FindMultilineRegexStep multilineStep)
         {
-            // No Find step - start from every cell
-            for (int y = 0; y < _region.Height; y++)
+            var found = multilineStep.FindStartingPositions(index);
+            foreach (var match in found)
             {
-                for (int x = 0; x < _region.Width; x++)
-                {
-                    positions.Add(new StartPosition(x, y, x, y, 0, -1, FindOptions.Default));
-                }
+                // Calculate total length across lines (approximate for cell count)
+                var totalLength = match.Text.Length; // Use text length as approximation
+                positions.Add(new StartPosition(
+                    match.StartX, match.StartY,
+                    match.EndX, match.EndY,
+                    totalLength, findStepIndex, multilineStep.Options));
             }
         }
 
@@ -191,21 +179,11 @@ internal sealed class PatternExecutor
         // Track capture stack for proper EndCapture handling
         var captureStack = new Stack<string>();
 
-        // Process steps before Find (typically BeginCapture steps)
-        for (int i = 0; i < startPos.FindStepIndex && startPos.FindStepIndex >= 0; i++)
+        // Captures opened before Find stay open for the cells it matched
+        foreach (var name in _pattern.LeadingCaptures)
         {
-            var step = _steps[i];
-            if (step is BeginCaptureStep beginCapture)
-            {
-                var name = beginCapture.Name;
-                captureStack.Push(name);
-                state.ActiveCaptures.Add(name);
-            }
-            else if (step is EndCaptureStep && captureStack.Count > 0)
-            {
-                var name = captureStack.Pop();
-                state.ActiveCaptures.Remove(name);
-            }
+            captureStack.Push(name);
+            state.ActiveCaptures.Add(name);
         }
 
         // Add initial cells (for Find steps) if IncludeMatchInCells is true
@@ -214,13 +192,9 @@ internal sealed class PatternExecutor
             AddMatchedCells(state, startPos);
         }
 
-        // Execute remaining steps (skip steps up to and including Find)
-        int startStepIndex = startPos.FindStepIndex >= 0 ? startPos.FindStepIndex + 1 : 0;
-        
-        for (int i = startStepIndex; i < _steps.Count; i++)
+        // Execute remaining steps (everything after Find)
+        foreach (var step in _pattern.Body)
         {
-            var step = _steps[i];
-            
             // Handle capture stack
             if (step is BeginCaptureStep beginCapture)
             {
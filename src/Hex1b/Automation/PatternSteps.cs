@@ -276,12 +276,23 @@ internal sealed class MatchTextStep : IPatternStep
 internal sealed class FindPredicateStep : IPatternStep
 {
     private readonly Func<CellMatchContext, bool> _predicate;
+    private readonly string? _character;
 
     public FindPredicateStep(Func<CellMatchContext, bool> predicate)
     {
         _predicate = predicate;
     }
 
+    /// <summary>
+    /// Creates a step that finds cells whose character is exactly <paramref name="character"/>.
+    /// Unlike an arbitrary predicate, this lets the search skip cells via the text index.
+    /// </summary>
+    public FindPredicateStep(string character)
+    {
+        _character = character;
+        _predicate = ctx => ctx.Cell.Character == character;
+    }
+
     public StepResult Execute(PatternExecutionState state)
     {
         // This is used during initial position finding
@@ -289,8 +300,14 @@ internal sealed class FindPredicateStep : IPatternStep
         return _predicate(context) ? StepResult.Succeeded : StepResult.Failed;
     }
 
-    public List<(int X, int Y)> FindStartingPositions(IHex1bTerminalRegion region)
+    public List<(int X, int Y)> FindStartingPositions(IHex1bTerminalRegion region, TerminalRegionTextIndex index)
     {
+        // A cell holding the character shows up verbatim in its row text, so the text
+        // index narrows the candidates; each one is still checked against the cell.
+        // NUL and the unwritten marker are rendered as spaces, so they can't use it.
+        if (_character is { Length: > 0 } character && character != "\0" && character != "\uE000")
+            return FindCharacterPositions(region, index, character);
+
         var positions = new List<(int X, int Y)>();
         var tempState = new PatternExecutionState(region);
         
@@ -315,6 +332,33 @@ internal sealed class FindPredicateStep : IPatternStep
         
         return positions;
     }
+
+    private static List<(int X, int Y)> FindCharacterPositions(
+        IHex1bTerminalRegion region, TerminalRegionTextIndex index, string character)
+    {
+        var positions = new List<(int X, int Y)>();
+        var (text, lineOffsets) = index.GetJoinedText(trimLines: false, lineSeparator: "\n");
+        int lastX = -1, lastY = -1;
+
+        int offset = 0;
+        while ((offset = text.IndexOf(character, offset, StringComparison.Ordinal)) >= 0)
+        {
+            var (y, column) = TerminalRegionTextIndex.OffsetToLineColumn(offset, lineOffsets);
+            offset++;
+
+            var x = index.GetColumn(y, column);
+            if (x >= region.Width || (x == lastX && y == lastY))
+                continue;
+            if (region.GetCell(x, y).Character != character)
+                continue;
+
+            positions.Add((x, y));
+            lastX = x;
+            lastY = y;
+        }
+
+        return positions;
+    }
 }
 
 /// <summary>
@@ -394,29 +438,46 @@ internal sealed class FindTextStep : IPatternStep
         return StepResult.Succeeded;
     }
 
-    public List<(int X, int Y, int Length)> FindStartingPositions(IHex1bTerminalRegion region)
+    public List<(int X, int Y, int Length)> FindStartingPositions(TerminalRegionTextIndex index)
     {
         var positions = new List<(int X, int Y, int Length)>();
+
+        // Rows never contain a newline, so searching the newline-joined text finds exactly
+        // the per-row occurrences in a single pass.
+        if (_text.Contains('\n'))
+            return positions;
+
+        var (text, lineOffsets) = index.GetJoinedText(trimLines: false, lineSeparator: "\n");
+        int offset = 0;
         
-        for (int y = 0; y < region.Height; y++)
+        while ((offset = text.IndexOf(_text, offset, StringComparison.Ordinal)) >= 0)
         {
-            var line = region.GetLine(y);
-            int index = 0;
-            
-            while ((index = line.IndexOf(_text, index, StringComparison.Ordinal)) >= 0)
-            {
-                positions.Add((index, y, _text.Length));
-                index++;
-            }
+            var (y, column) = TerminalRegionTextIndex.OffsetToLineColumn(offset, lineOffsets);
+            var (x, length) = ToCells(index, y, column, _text.Length);
+            positions.Add((x, y, length));
+            offset++;
         }
         
         return positions;
     }
+
+    /// <summary>
+    /// Converts a match at a text offset within a row to its first cell and cell count.
+    /// </summary>
+    internal static (int X, int Length) ToCells(TerminalRegionTextIndex index, int y, int offset, int textLength)
+    {
+        var x = index.GetColumn(y, offset);
+        if (textLength == 0)
+            return (x, 0);
+
+        var lastX = index.GetColumn(y, offset + textLength - 1);
+        return (x, lastX - x + 1);
+    }
 }
 
 /// <summary>
-/// Finds starting positions using a regex pattern (single-line).
-/// Uses the existing FindPattern infrastructure.
+/// Finds starting positions using a regex pattern (single-line), matched against each
+/// row's indexed text.
 /// </summary>
 internal sealed class FindRegexStep : IPatternStep
 {
@@ -436,16 +497,17 @@ internal sealed class FindRegexStep : IPatternStep
         return StepResult.Succeeded;
     }
 
-    public List<(int X, int Y, int Length)> FindStartingPositions(IHex1bTerminalRegion region)
+    public List<(int X, int Y, int Length)> FindStartingPositions(TerminalRegionTextIndex index)
     {
         var positions = new List<(int X, int Y, int Length)>();
         
-        // Use existing FindPattern infrastructure
-        var matches = region.FindPattern(_regex);
-        
-        foreach (var match in matches)
+        for (int y = 0; y < index.Height; y++)
         {
-            positions.Add((match.StartColumn, match.Line, match.Length));
+            foreach (Match match in _regex.Matches(index.GetLine(y)))
+            {
+                var (x, length) = FindTextStep.ToCells(index, y, match.Index, match.Length);
+                positions.Add((x, y, length));
+            }
         }
         
         return positions;
@@ -453,8 +515,8 @@ internal sealed class FindRegexStep : IPatternStep
 }
 
 /// <summary>
-/// Finds starting positions using a regex pattern that can span multiple lines.
-/// Uses the existing FindMultiLinePattern infrastructure.
+/// Finds starting positions using a regex pattern that can span multiple lines, matched
+/// against the index's joined text.
 /// </summary>
 internal sealed class FindMultilineRegexStep : IPatternStep
 {
@@ -478,19 +540,19 @@ internal sealed class FindMultilineRegexStep : IPatternStep
         return StepResult.Succeeded;
     }
 
-    public List<MultilineMatchPosition> FindStartingPositions(IHex1bTerminalRegion region)
+    public List<MultilineMatchPosition> FindStartingPositions(TerminalRegionTextIndex index)
     {
         var positions = new List<MultilineMatchPosition>();
+        var (text, lineOffsets) = index.GetJoinedText(_trimLines, _lineSeparator);
         
-        // Use existing FindMultiLinePattern infrastructure
-        var matches = region.FindMultiLinePattern(_regex, _trimLines, _lineSeparator);
-        
-        foreach (var match in matches)
+        foreach (Match match in _regex.Matches(text))
         {
+            var (startLine, startOffset) = TerminalRegionTextIndex.OffsetToLineColumn(match.Index, lineOffsets);
+            var (endLine, endOffset) = TerminalRegionTextIndex.OffsetToLineColumn(match.Index + match.Length, lineOffsets);
             positions.Add(new MultilineMatchPosition(
-                match.StartColumn, match.StartLine,
-                match.EndColumn, match.EndLine,
-                match.Text));
+                index.GetColumn(startLine, startOffset), startLine,
+                index.GetColumn(endLine, endOffset), endLine,
+                match.Value));
         }
         
         return positions;
@@ -818,6 +880,8 @@ internal sealed class CompositeStep : IPatternStep
         _steps = steps;
     }
 
+    public ImmutableList<IPatternStep> Steps => _steps;
+
     public StepResult Execute(PatternExecutionState state)
     {
         foreach (var step in _steps)
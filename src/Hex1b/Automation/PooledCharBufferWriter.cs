@@ -0,0 +1,71 @@
+using System.Buffers;
+
+namespace Hex1b.Automation;
+
+/// <summary>
+/// An <see cref="IBufferWriter{T}"/> of chars backed by <see cref="ArrayPool{T}.Shared"/>.
+/// </summary>
+/// <remarks>
+/// Used by the SVG and HTML renderers so a document is built in one pooled buffer and
+/// turned into a string once, instead of growing a <see cref="System.Text.StringBuilder"/>
+/// line by line.
+/// </remarks>
+internal sealed class PooledCharBufferWriter : IBufferWriter<char>, IDisposable
+{
+    private char[] _buffer;
+    private int _written;
+
+    public PooledCharBufferWriter(int initialCapacity = 16 * 1024)
+    {
+        _buffer = ArrayPool<char>.Shared.Rent(initialCapacity);
+    }
+
+    public int WrittenCount => _written;
+
+    public ReadOnlySpan<char> WrittenSpan => _buffer.AsSpan(0, _written);
+
+    public void Advance(int count)
+    {
+        if (count < 0 || _written + count > _buffer.Length)
+            throw new ArgumentOutOfRangeException(nameof(count));
+        _written += count;
+    }
+
+    public Memory<char> GetMemory(int sizeHint = 0)
+    {
+        EnsureCapacity(sizeHint);
+        return _buffer.AsMemory(_written);
+    }
+
+    public Span<char> GetSpan(int sizeHint = 0)
+    {
+        EnsureCapacity(sizeHint);
+        return _buffer.AsSpan(_written);
+    }
+
+    public void Clear() => _written = 0;
+
+    public override string ToString() => new(_buffer, 0, _written);
+
+    public void Dispose()
+    {
+        var buffer = _buffer;
+        _buffer = [];
+        _written = 0;
+        if (buffer.Length > 0)
+            ArrayPool<char>.Shared.Return(buffer);
+    }
+
+    private void EnsureCapacity(int sizeHint)
+    {
+        sizeHint = Math.Max(sizeHint, 1);
+        if (_buffer.Length - _written >= sizeHint)
+            return;
+
+        var grown = ArrayPool<char>.Shared.Rent(Math.Max(_buffer.Length * 2, _written + sizeHint));
+        _buffer.AsSpan(0, _written).CopyTo(grown);
+        if (_buffer.Length > 0)
+            ArrayPool<char>.Shared.Return(_buffer);
+        _buffer = grown;
+    }
+}
@@ -0,0 +1,104 @@
+using System.Buffers;
+using System.Globalization;
+using System.Runtime.CompilerServices;
+
+namespace Hex1b.Automation;
+
+/// <summary>
+/// Writes SVG and HTML markup straight into an <see cref="IBufferWriter{T}"/>.
+/// </summary>
+/// <remarks>
+/// Interpolated strings passed to <see cref="Append(ref TerminalMarkupInterpolatedStringHandler)"/>
+/// and <see cref="AppendLine(ref TerminalMarkupInterpolatedStringHandler)"/> are formatted in place,
+/// so per-cell elements don't allocate intermediate strings. Numbers are always formatted with the
+/// invariant culture.
+/// </remarks>
+internal sealed class TerminalMarkupWriter(IBufferWriter<char> output)
+{
+    public IBufferWriter<char> Output => output;
+
+    public void Append(string? value) => output.Write(value.AsSpan());
+
+    public void Append(ReadOnlySpan<char> value) => output.Write(value);
+
+    public void Append(char value)
+    {
+        output.GetSpan(1)[0] = value;
+        output.Advance(1);
+    }
+
+    public void Append([InterpolatedStringHandlerArgument("")] ref TerminalMarkupInterpolatedStringHandler value)
+    {
+    }
+
+    public void AppendLine() => Append(Environment.NewLine);
+
+    public void AppendLine(string? value)
+    {
+        Append(value);
+        AppendLine();
+    }
+
+    public void AppendLine([InterpolatedStringHandlerArgument("")] ref TerminalMarkupInterpolatedStringHandler value)
+        => AppendLine();
+
+    public void AppendFormatted<T>(T value, ReadOnlySpan<char> format) where T : ISpanFormattable
+    {
+        var span = output.GetSpan(32);
+        int written;
+        while (!value.TryFormat(span, out written, format, CultureInfo.InvariantCulture))
+            span = output.GetSpan(span.Length * 2);
+        output.Advance(written);
+    }
+
+    /// <summary>
+    /// Appends text with the XML special characters escaped.
+    /// </summary>
+    public void AppendEscaped(ReadOnlySpan<char> value)
+    {
+        while (!value.IsEmpty)
+        {
+            var index = value.IndexOfAny("&<>\"'");
+            if (index < 0)
+            {
+                Append(value);
+                return;
+            }
+
+            Append(value[..index]);
+            Append(value[index] switch
+            {
+                '&' => "&amp;",
+                '<' => "&lt;",
+                '>' => "&gt;",
+                '"' => "&quot;",
+                _ => "&#39;"
+            });
+            value = value[(index + 1)..];
+        }
+    }
+}
+
+/// <summary>
+/// Formats interpolated strings directly into a <see cref="TerminalMarkupWriter"/>.
+/// </summary>
+[InterpolatedStringHandler]
+internal readonly ref struct TerminalMarkupInterpolatedStringHandler
+{
+    private readonly TerminalMarkupWriter _writer;
+
+    public TerminalMarkupInterpolatedStringHandler(int literalLength, int formattedCount, TerminalMarkupWriter writer)
+    {
+        _writer = writer;
+    }
+
+    public void AppendLiteral(string value) => _writer.Append(value);
+
+    public void AppendFormatted(string? value) => _writer.Append(value);
+
+    public void AppendFormatted(ReadOnlySpan<char> value) => _writer.Append(value);
+
+    public void AppendFormatted<T>(T value) where T : ISpanFormattable => _writer.AppendFormatted(value, default);
+
+    public void AppendFormatted<T>(T value, string? format) where T : ISpanFormattable => _writer.AppendFormatted(value, format);
+}
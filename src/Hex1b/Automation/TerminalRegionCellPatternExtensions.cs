@@ -33,6 +33,32 @@ public static class TerminalRegionCellPatternExtensions
         return pattern.SearchFirst(region);
     }
 
+    /// <summary>
+    /// Searches for all occurrences of a compiled pattern in this region.
+    /// </summary>
+    /// <param name="region">The terminal region to search.</param>
+    /// <param name="pattern">The compiled pattern to search for.</param>
+    /// <returns>A result containing all matches found.</returns>
+    public static CellPatternSearchResult SearchPattern(
+        this IHex1bTerminalRegion region,
+        CompiledCellPattern pattern)
+    {
+        return pattern.Search(region);
+    }
+
+    /// <summary>
+    /// Searches for the first occurrence of a compiled pattern in this region.
+    /// </summary>
+    /// <param name="region">The terminal region to search.</param>
+    /// <param name="pattern">The compiled pattern to search for.</param>
+    /// <returns>The first match found, or null if no match.</returns>
+    public static CellPatternMatch? SearchFirstPattern(
+        this IHex1bTerminalRegion region,
+        CompiledCellPattern pattern)
+    {
+        return pattern.SearchFirst(region);
+    }
+
     /// <summary>
     /// Creates a snapshot region from a pattern match.
     /// Uses the match's bounding rectangle.
@@ -1,6 +1,5 @@
-using System.Text;
-using System.Text.Json;
-using System.Web;
+using System.Buffers;
+using Hex1b.Theming;
 
 namespace Hex1b.Automation;
 
@@ -17,8 +16,9 @@ public static class TerminalRegionHtmlExtensions
     /// <returns>An HTML string with embedded SVG and JavaScript for cell inspection.</returns>
     public static string ToHtml(this IHex1bTerminalRegion region, TerminalSvgOptions? options = null)
     {
-        options ??= TerminalRegionSvgExtensions.DefaultOptions;
-        return RenderToHtml(region, options, cursorX: null, cursorY: null);
+        using var buffer = new PooledCharBufferWriter();
+        region.WriteHtml(buffer, options);
+        return buffer.ToString();
     }
 
     /// <summary>
@@ -28,39 +28,43 @@ public static class TerminalRegionHtmlExtensions
     /// <param name="options">Optional rendering options.</param>
     /// <returns>An HTML string with embedded SVG and JavaScript for cell inspection.</returns>
     public static string ToHtml(this Hex1bTerminalSnapshot snapshot, TerminalSvgOptions? options = null)
+    {
+        using var buffer = new PooledCharBufferWriter();
+        snapshot.WriteHtml(buffer, options);
+        return buffer.ToString();
+    }
+
+    /// <summary>
+    /// Writes the terminal region as interactive HTML to <paramref name="writer"/>.
+    /// </summary>
+    /// <param name="region">The terminal region to render.</param>
+    /// <param name="writer">The destination for the HTML markup.</param>
+    /// <param name="options">Optional rendering options.</param>
+    public static void WriteHtml(this IHex1bTerminalRegion region, IBufferWriter<char> writer, TerminalSvgOptions? options = null)
     {
         options ??= TerminalRegionSvgExtensions.DefaultOptions;
-        return RenderToHtml(snapshot, options, snapshot.CursorX, snapshot.CursorY, snapshot.ScrollbackLineCount);
+        RenderToHtml(region, writer, options, cursorX: null, cursorY: null);
     }
 
-    private static string RenderToHtml(IHex1bTerminalRegion region, TerminalSvgOptions options, int? cursorX, int? cursorY, int scrollbackLineCount = 0)
+    /// <summary>
+    /// Writes the terminal snapshot as interactive HTML to <paramref name="writer"/>.
+    /// </summary>
+    /// <param name="snapshot">The terminal snapshot to render.</param>
+    /// <param name="writer">The destination for the HTML markup.</param>
+    /// <param name="options">Optional rendering options.</param>
+    public static void WriteHtml(this Hex1bTerminalSnapshot snapshot, IBufferWriter<char> writer, TerminalSvgOptions? options = null)
+    {
+        options ??= TerminalRegionSvgExtensions.DefaultOptions;
+        RenderToHtml(snapshot, writer, options, snapshot.CursorX, snapshot.CursorY, snapshot.ScrollbackLineCount);
+    }
+
+    private static void RenderToHtml(IHex1bTerminalRegion region, IBufferWriter<char> writer, TerminalSvgOptions options, int? cursorX, int? cursorY, int scrollbackLineCount = 0)
     {
         var cellWidth = options.CellWidth;
         var cellHeight = options.CellHeight;
         var svgWidth = region.Width * cellWidth;
         var svgHeight = region.Height * cellHeight;
 
-        // Pre-scan cells to identify unique cell groups (e.g., hyperlinks with same ID/URI)
-        // This allows related cells to be highlighted together in the HTML viewer
-        var hyperlinkGroups = new Dictionary<object, string>();
-        var groupId = 0;
-        
-        for (int y = 0; y < region.Height; y++)
-        {
-            for (int x = 0; x < region.Width; x++)
-            {
-                var cell = region.GetCell(x, y);
-                if (cell.TrackedHyperlink is { } trackedLink && !hyperlinkGroups.ContainsKey(trackedLink))
-                {
-                    var groupKey = $"link-{groupId++}";
-                    hyperlinkGroups[trackedLink] = groupKey;
-                }
-            }
-        }
-
-        // Build cell data as JSON for JavaScript (includes group IDs for related cells)
-        var cellData = BuildCellDataJson(region, hyperlinkGroups);
-
         // For HTML, create options with grids enabled (we'll hide them via CSS initially)
         var htmlSvgOptions = new TerminalSvgOptions
         {
@@ -77,82 +81,81 @@ public static class TerminalRegionHtmlExtensions
             PixelGridColor = options.PixelGridColor
         };
 
-        // Get the SVG content with grids included (hidden via CSS initially)
-        var svgContent = region is Hex1bTerminalSnapshot snapshot
-            ? snapshot.ToSvg(htmlSvgOptions)
-            : region.ToSvg(htmlSvgOptions);
+        // The SVG is written in place, with grids included (hidden via CSS initially). The cell
+        // data JSON takes its hyperlink group names from the same renderer so they match.
+        var svgRenderer = new TerminalSvgRenderer(htmlSvgOptions, cacheRows: false);
 
-        var sb = new StringBuilder();
+        var w = new TerminalMarkupWriter(writer);
 
-        sb.AppendLine("<!DOCTYPE html>");
-        sb.AppendLine("<html lang=\"en\">");
-        sb.AppendLine("<head>");
-        sb.AppendLine("  <meta charset=\"UTF-8\">");
-        sb.AppendLine("  <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">");
-        sb.AppendLine("  <title>Terminal Snapshot Inspector</title>");
-        sb.AppendLine("  <style>");
-        sb.AppendLine("    * { box-sizing: border-box; margin: 0; padding: 0; }");
-        sb.AppendLine("    body {");
-        sb.AppendLine("      font-family: -apple-system, BlinkMacSystemFont, 'Segoe UI', Roboto, Oxygen, Ubuntu, sans-serif;");
-        sb.AppendLine("      background: #1a1a2e;");
-        sb.AppendLine("      color: #eee;");
-        sb.AppendLine("      min-height: 100vh;");
-        sb.AppendLine("      padding: 20px;");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      flex-direction: column;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    /* Minimal mode - applied via ?minimal=true query param */");
-        sb.AppendLine("    body.minimal {");
-        sb.AppendLine("      padding: 0;");
-        sb.AppendLine("      background: transparent;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    body.minimal h1,");
-        sb.AppendLine("    body.minimal .info-bar,");
-        sb.AppendLine("    body.minimal .theme-controls {");
-        sb.AppendLine("      display: none !important;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    body.minimal .container {");
-        sb.AppendLine("      height: 100vh;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    body.minimal .svg-container {");
-        sb.AppendLine("      border: none;");
-        sb.AppendLine("      border-radius: 0;");
-        sb.AppendLine("      background: transparent;");
-        sb.AppendLine("      padding: 0;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    body.minimal .svg-container svg {");
-        sb.AppendLine("      box-shadow: 0 0 20px rgba(0, 180, 255, 0.35), 0 0 40px rgba(0, 120, 200, 0.2);");
-        sb.AppendLine("    }");
-        sb.AppendLine("    h1 {");
-        sb.AppendLine("      font-size: 1.5rem;");
-        sb.AppendLine("      margin-bottom: 10px;");
-        sb.AppendLine("      color: #00d4ff;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .info-bar {");
-        sb.AppendLine("      font-size: 0.85rem;");
-        sb.AppendLine("      color: #888;");
-        sb.AppendLine("      margin-bottom: 20px;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .container {");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      gap: 20px;");
-        sb.AppendLine("      flex-wrap: wrap;");
-        sb.AppendLine("      flex: 1;");
-        sb.AppendLine("      min-height: 0;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .svg-container {");
-        sb.AppendLine("      position: relative;");
-        sb.AppendLine("      border: 2px solid #333;");
-        sb.AppendLine("      border-radius: 8px;");
-        sb.AppendLine("      overflow: auto;");
-        sb.AppendLine("      background: #0d0d0d;");
-        sb.AppendLine("      flex: 1;");
-        sb.AppendLine("      min-height: 0;");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      align-items: center;");
-        sb.AppendLine("      justify-content: center;");
-        sb.AppendLine("      padding: 20px;");
-        sb.AppendLine("    }");
+        w.AppendLine("<!DOCTYPE html>");
+        w.AppendLine("<html lang=\"en\">");
+        w.AppendLine("<head>");
+        w.AppendLine("  <meta charset=\"UTF-8\">");
+        w.AppendLine("  <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">");
+        w.AppendLine("  <title>Terminal Snapshot Inspector</title>");
+        w.AppendLine("  <style>");
+        w.AppendLine("    * { box-sizing: border-box; margin: 0; padding: 0; }");
+        w.AppendLine("    body {");
+        w.AppendLine("      font-family: -apple-system, BlinkMacSystemFont, 'Segoe UI', Roboto, Oxygen, Ubuntu, sans-serif;");
+        w.AppendLine("      background: #1a1a2e;");
+        w.AppendLine("      color: #eee;");
+        w.AppendLine("      min-height: 100vh;");
+        w.AppendLine("      padding: 20px;");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      flex-direction: column;");
+        w.AppendLine("    }");
+        w.AppendLine("    /* Minimal mode - applied via ?minimal=true query param */");
+        w.AppendLine("    body.minimal {");
+        w.AppendLine("      padding: 0;");
+        w.AppendLine("      background: transparent;");
+        w.AppendLine("    }");
+        w.AppendLine("    body.minimal h1,");
+        w.AppendLine("    body.minimal .info-bar,");
+        w.AppendLine("    body.minimal .theme-controls {");
+        w.AppendLine("      display: none !important;");
+        w.AppendLine("    }");
+        w.AppendLine("    body.minimal .container {");
+        w.AppendLine("      height: 100vh;");
+        w.AppendLine("    }");
+        w.AppendLine("    body.minimal .svg-container {");
+        w.AppendLine("      border: none;");
+        w.AppendLine("      border-radius: 0;");
+        w.AppendLine("      background: transparent;");
+        w.AppendLine("      padding: 0;");
+        w.AppendLine("    }");
+        w.AppendLine("    body.minimal .svg-container svg {");
+        w.AppendLine("      box-shadow: 0 0 20px rgba(0, 180, 255, 0.35), 0 0 40px rgba(0, 120, 200, 0.2);");
+        w.AppendLine("    }");
+        w.AppendLine("    h1 {");
+        w.AppendLine("      font-size: 1.5rem;");
+        w.AppendLine("      margin-bottom: 10px;");
+        w.AppendLine("      color: #00d4ff;");
+        w.AppendLine("    }");
+        w.AppendLine("    .info-bar {");
+        w.AppendLine("      font-size: 0.85rem;");
+        w.AppendLine("      color: #888;");
+        w.AppendLine("      margin-bottom: 20px;");
+        w.AppendLine("    }");
+        w.AppendLine("    .container {");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      gap: 20px;");
+        w.AppendLine("      flex-wrap: wrap;");
+        w.AppendLine("      flex: 1;");
+        w.AppendLine("      min-height: 0;");
+        w.AppendLine("    }");
+        w.AppendLine("    .svg-container {");
+        w.AppendLine("      position: relative;");
+        w.AppendLine("      border: 2px solid #333;");
+        w.AppendLine("      border-radius: 8px;");
+        w.AppendLine("      overflow: auto;");
+        w.AppendLine("      background: #0d0d0d;");
+        w.AppendLine("      flex: 1;");
+        w.AppendLine("      min-height: 0;");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      align-items: center;");
+        w.AppendLine("      justify-content: center;");
+        w.AppendLine("      padding: 20px;");
+        w.AppendLine("    }");
         // When scrollback is present, constrain the container to visible-area height
         // and allow the user to scroll up into the scrollback region
         if (scrollbackLineCount > 0)
@@ -160,794 +163,788 @@ public static class TerminalRegionHtmlExtensions
             var visibleRows = region.Height - scrollbackLineCount;
             // Use a max-height based on the visible area + padding, so the container
             // is sized to show only the live terminal, with scrollback above
-            sb.AppendLine("    .svg-container.has-scrollback {");
-            sb.AppendLine("      align-items: flex-start;");
-            sb.AppendLine("      justify-content: flex-start;");
-            sb.AppendLine("    }");
-            sb.AppendLine("    .svg-container.has-scrollback svg {");
-            sb.AppendLine("      max-width: none;");
-            sb.AppendLine("      max-height: none;");
-            sb.AppendLine("    }");
+            w.AppendLine("    .svg-container.has-scrollback {");
+            w.AppendLine("      align-items: flex-start;");
+            w.AppendLine("      justify-content: flex-start;");
+            w.AppendLine("    }");
+            w.AppendLine("    .svg-container.has-scrollback svg {");
+            w.AppendLine("      max-width: none;");
+            w.AppendLine("      max-height: none;");
+            w.AppendLine("    }");
         }
-        sb.AppendLine("    .svg-container svg {");
-        sb.AppendLine("      display: block;");
-        sb.AppendLine("      max-width: 100%;");
-        sb.AppendLine("      max-height: 100%;");
-        sb.AppendLine("      width: auto;");
-        sb.AppendLine("      height: auto;");
-        sb.AppendLine("      image-rendering: pixelated;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .cell-highlight {");
-        sb.AppendLine("      position: absolute;");
-        sb.AppendLine("      pointer-events: none;");
-        sb.AppendLine("      border: 1px solid #00d4ff;");
-        sb.AppendLine("      border-radius: 2px;");
-        sb.AppendLine("      opacity: 0;");
-        sb.AppendLine("      transition: opacity 0.1s, box-shadow 0.2s;");
-        sb.AppendLine("      box-shadow: 0 0 0 rgba(0, 212, 255, 0);");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .cell-highlight.visible {");
-        sb.AppendLine("      opacity: 1;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .cell-highlight.shimmer {");
-        sb.AppendLine("      box-shadow: 0 0 12px rgba(0, 212, 255, 0.8), inset 0 0 8px rgba(0, 212, 255, 0.4);");
-        sb.AppendLine("      border-color: #00ffff;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip {");
-        sb.AppendLine("      position: fixed;");
-        sb.AppendLine("      background: #2d2d44;");
-        sb.AppendLine("      border: 1px solid #444;");
-        sb.AppendLine("      border-radius: 8px;");
-        sb.AppendLine("      padding: 12px 16px;");
-        sb.AppendLine("      font-size: 13px;");
-        sb.AppendLine("      box-shadow: 0 4px 20px rgba(0,0,0,0.5);");
-        sb.AppendLine("      pointer-events: none;");
-        sb.AppendLine("      opacity: 0;");
-        sb.AppendLine("      transition: opacity 0.15s;");
-        sb.AppendLine("      z-index: 1000;");
-        sb.AppendLine("      min-width: 280px;");
-        sb.AppendLine("      max-width: 400px;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip.visible {");
-        sb.AppendLine("      opacity: 1;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip.pinned {");
-        sb.AppendLine("      pointer-events: auto;");
-        sb.AppendLine("      border-color: #00d4ff;");
-        sb.AppendLine("      box-shadow: 0 4px 20px rgba(0,0,0,0.5), 0 0 0 2px rgba(0, 212, 255, 0.3);");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip-pin-indicator {");
-        sb.AppendLine("      position: absolute;");
-        sb.AppendLine("      top: 8px;");
-        sb.AppendLine("      right: 8px;");
-        sb.AppendLine("      font-size: 12px;");
-        sb.AppendLine("      color: #00d4ff;");
-        sb.AppendLine("      cursor: pointer;");
-        sb.AppendLine("      padding: 4px;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip-pin-indicator:hover {");
-        sb.AppendLine("      color: #ff6b6b;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .highlight-toggle {");
-        sb.AppendLine("      display: inline-flex;");
-        sb.AppendLine("      align-items: center;");
-        sb.AppendLine("      gap: 4px;");
-        sb.AppendLine("      padding: 4px 8px;");
-        sb.AppendLine("      margin-left: 8px;");
-        sb.AppendLine("      background: #3d3d5c;");
-        sb.AppendLine("      border: 1px solid #555;");
-        sb.AppendLine("      border-radius: 4px;");
-        sb.AppendLine("      cursor: pointer;");
-        sb.AppendLine("      font-size: 11px;");
-        sb.AppendLine("      color: #888;");
-        sb.AppendLine("      transition: all 0.2s;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .highlight-toggle:hover {");
-        sb.AppendLine("      background: #4d4d6c;");
-        sb.AppendLine("      color: #fff;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .highlight-toggle.active {");
-        sb.AppendLine("      background: #ff6b6b;");
-        sb.AppendLine("      border-color: #ff6b6b;");
-        sb.AppendLine("      color: #fff;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip-header {");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      align-items: center;");
-        sb.AppendLine("      gap: 12px;");
-        sb.AppendLine("      margin-bottom: 10px;");
-        sb.AppendLine("      padding-bottom: 10px;");
-        sb.AppendLine("      border-bottom: 1px solid #444;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip-char {");
-        sb.AppendLine("      font-family: 'Cascadia Code', 'Fira Code', Consolas, monospace;");
-        sb.AppendLine("      font-size: 28px;");
-        sb.AppendLine("      width: 44px;");
-        sb.AppendLine("      height: 44px;");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      align-items: center;");
-        sb.AppendLine("      justify-content: center;");
-        sb.AppendLine("      border-radius: 6px;");
-        sb.AppendLine("      border: 1px solid #555;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip-position {");
-        sb.AppendLine("      color: #888;");
-        sb.AppendLine("      font-size: 12px;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip-section {");
-        sb.AppendLine("      margin-bottom: 8px;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip-section:last-child {");
-        sb.AppendLine("      margin-bottom: 0;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip-label {");
-        sb.AppendLine("      color: #888;");
-        sb.AppendLine("      font-size: 11px;");
-        sb.AppendLine("      text-transform: uppercase;");
-        sb.AppendLine("      letter-spacing: 0.5px;");
-        sb.AppendLine("      margin-bottom: 3px;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip-value {");
-        sb.AppendLine("      font-family: 'Cascadia Code', 'Fira Code', Consolas, monospace;");
-        sb.AppendLine("      font-size: 12px;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip-row {");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      gap: 16px;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .tooltip-row > div {");
-        sb.AppendLine("      flex: 1;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .color-swatch {");
-        sb.AppendLine("      display: inline-block;");
-        sb.AppendLine("      width: 14px;");
-        sb.AppendLine("      height: 14px;");
-        sb.AppendLine("      border-radius: 3px;");
-        sb.AppendLine("      border: 1px solid #666;");
-        sb.AppendLine("      vertical-align: middle;");
-        sb.AppendLine("      margin-right: 6px;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .attr-badge {");
-        sb.AppendLine("      display: inline-block;");
-        sb.AppendLine("      padding: 2px 6px;");
-        sb.AppendLine("      margin: 2px;");
-        sb.AppendLine("      border-radius: 4px;");
-        sb.AppendLine("      font-size: 11px;");
-        sb.AppendLine("      background: #3d3d5c;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .attr-badge.bold { font-weight: bold; }");
-        sb.AppendLine("    .attr-badge.italic { font-style: italic; }");
-        sb.AppendLine("    .attr-badge.underline { text-decoration: underline; }");
-        sb.AppendLine("    .attr-badge.strikethrough { text-decoration: line-through; }");
-        sb.AppendLine("    .attr-badge.dim { opacity: 0.5; }");
-        sb.AppendLine("    .attr-badge.blink { background: #5c5c3d; }");
-        sb.AppendLine("    .attr-badge.reverse { background: #5c3d5c; }");
-        sb.AppendLine("    .attr-badge.hidden { background: #3d3d3d; }");
-        sb.AppendLine("    .attr-badge.overline { text-decoration: overline; }");
-        sb.AppendLine("    .theme-controls {");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      gap: 20px;");
-        sb.AppendLine("      align-items: center;");
-        sb.AppendLine("      margin-bottom: 20px;");
-        sb.AppendLine("      flex-wrap: wrap;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .theme-presets {");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      gap: 8px;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .theme-btn {");
-        sb.AppendLine("      padding: 8px 16px;");
-        sb.AppendLine("      border: 1px solid #444;");
-        sb.AppendLine("      border-radius: 6px;");
-        sb.AppendLine("      background: #2d2d44;");
-        sb.AppendLine("      color: #eee;");
-        sb.AppendLine("      cursor: pointer;");
-        sb.AppendLine("      font-size: 13px;");
-        sb.AppendLine("      transition: all 0.2s;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .theme-btn:hover {");
-        sb.AppendLine("      background: #3d3d5c;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .theme-btn.active {");
-        sb.AppendLine("      background: #00d4ff;");
-        sb.AppendLine("      color: #000;");
-        sb.AppendLine("      border-color: #00d4ff;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .color-pickers {");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      gap: 16px;");
-        sb.AppendLine("      align-items: center;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .color-pickers label {");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      align-items: center;");
-        sb.AppendLine("      gap: 8px;");
-        sb.AppendLine("      font-size: 13px;");
-        sb.AppendLine("      color: #888;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .color-pickers input[type=\"color\"] {");
-        sb.AppendLine("      width: 40px;");
-        sb.AppendLine("      height: 28px;");
-        sb.AppendLine("      border: 1px solid #444;");
-        sb.AppendLine("      border-radius: 4px;");
-        sb.AppendLine("      cursor: pointer;");
-        sb.AppendLine("      background: transparent;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .grid-controls {");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      gap: 16px;");
-        sb.AppendLine("      align-items: center;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .grid-controls label {");
-        sb.AppendLine("      display: flex;");
-        sb.AppendLine("      align-items: center;");
-        sb.AppendLine("      gap: 6px;");
-        sb.AppendLine("      font-size: 13px;");
-        sb.AppendLine("      color: #888;");
-        sb.AppendLine("      cursor: pointer;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .grid-controls input[type=\"checkbox\"] {");
-        sb.AppendLine("      width: 16px;");
-        sb.AppendLine("      height: 16px;");
-        sb.AppendLine("      cursor: pointer;");
-        sb.AppendLine("    }");
-        sb.AppendLine("    .svg-container .cell-grid { display: none; }");
-        sb.AppendLine("    .svg-container.show-cell-grid .cell-grid { display: block; }");
-        sb.AppendLine("    .svg-container .pixel-grid { display: none; }");
-        sb.AppendLine("    .svg-container.show-pixel-grid .pixel-grid { display: block; }");
-        sb.AppendLine("  </style>");
-        sb.AppendLine("</head>");
-        sb.AppendLine("<body>");
-        sb.AppendLine("  <h1>Terminal Snapshot Inspector</h1>");
-        sb.AppendLine($"  <div class=\"info-bar\">Size: {region.Width} × {region.Height} cells | Hover over cells to inspect</div>");
-        sb.AppendLine("  <div class=\"theme-controls\">");
-        sb.AppendLine("    <div class=\"theme-presets\">");
-        sb.AppendLine("      <button id=\"btn-dark\" class=\"theme-btn active\">Dark Mode</button>");
-        sb.AppendLine("      <button id=\"btn-light\" class=\"theme-btn\">Light Mode</button>");
-        sb.AppendLine("    </div>");
-        sb.AppendLine("    <div class=\"color-pickers\">");
-        sb.AppendLine("      <label>Background: <input type=\"color\" id=\"bg-picker\" value=\"#1e1e1e\"></label>");
-        sb.AppendLine("      <label>Foreground: <input type=\"color\" id=\"fg-picker\" value=\"#d4d4d4\"></label>");
-        sb.AppendLine("    </div>");
-        sb.AppendLine("    <div class=\"grid-controls\">");
-        sb.AppendLine("      <label><input type=\"checkbox\" id=\"cell-grid-toggle\"> Cell Grid</label>");
-        sb.AppendLine("      <label><input type=\"color\" id=\"cell-grid-color\" value=\"#808080\"></label>");
-        sb.AppendLine("      <label><input type=\"checkbox\" id=\"pixel-grid-toggle\"> Pixel Grid</label>");
-        sb.AppendLine("      <label><input type=\"color\" id=\"pixel-grid-color\" value=\"#404040\"></label>");
-        sb.AppendLine("    </div>");
-        sb.AppendLine("  </div>");
-        sb.AppendLine("  <div class=\"container\">");
+        w.AppendLine("    .svg-container svg {");
+        w.AppendLine("      display: block;");
+        w.AppendLine("      max-width: 100%;");
+        w.AppendLine("      max-height: 100%;");
+        w.AppendLine("      width: auto;");
+        w.AppendLine("      height: auto;");
+        w.AppendLine("      image-rendering: pixelated;");
+        w.AppendLine("    }");
+        w.AppendLine("    .cell-highlight {");
+        w.AppendLine("      position: absolute;");
+        w.AppendLine("      pointer-events: none;");
+        w.AppendLine("      border: 1px solid #00d4ff;");
+        w.AppendLine("      border-radius: 2px;");
+        w.AppendLine("      opacity: 0;");
+        w.AppendLine("      transition: opacity 0.1s, box-shadow 0.2s;");
+        w.AppendLine("      box-shadow: 0 0 0 rgba(0, 212, 255, 0);");
+        w.AppendLine("    }");
+        w.AppendLine("    .cell-highlight.visible {");
+        w.AppendLine("      opacity: 1;");
+        w.AppendLine("    }");
+        w.AppendLine("    .cell-highlight.shimmer {");
+        w.AppendLine("      box-shadow: 0 0 12px rgba(0, 212, 255, 0.8), inset 0 0 8px rgba(0, 212, 255, 0.4);");
+        w.AppendLine("      border-color: #00ffff;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip {");
+        w.AppendLine("      position: fixed;");
+        w.AppendLine("      background: #2d2d44;");
+        w.AppendLine("      border: 1px solid #444;");
+        w.AppendLine("      border-radius: 8px;");
+        w.AppendLine("      padding: 12px 16px;");
+        w.AppendLine("      font-size: 13px;");
+        w.AppendLine("      box-shadow: 0 4px 20px rgba(0,0,0,0.5);");
+        w.AppendLine("      pointer-events: none;");
+        w.AppendLine("      opacity: 0;");
+        w.AppendLine("      transition: opacity 0.15s;");
+        w.AppendLine("      z-index: 1000;");
+        w.AppendLine("      min-width: 280px;");
+        w.AppendLine("      max-width: 400px;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip.visible {");
+        w.AppendLine("      opacity: 1;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip.pinned {");
+        w.AppendLine("      pointer-events: auto;");
+        w.AppendLine("      border-color: #00d4ff;");
+        w.AppendLine("      box-shadow: 0 4px 20px rgba(0,0,0,0.5), 0 0 0 2px rgba(0, 212, 255, 0.3);");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip-pin-indicator {");
+        w.AppendLine("      position: absolute;");
+        w.AppendLine("      top: 8px;");
+        w.AppendLine("      right: 8px;");
+        w.AppendLine("      font-size: 12px;");
+        w.AppendLine("      color: #00d4ff;");
+        w.AppendLine("      cursor: pointer;");
+        w.AppendLine("      padding: 4px;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip-pin-indicator:hover {");
+        w.AppendLine("      color: #ff6b6b;");
+        w.AppendLine("    }");
+        w.AppendLine("    .highlight-toggle {");
+        w.AppendLine("      display: inline-flex;");
+        w.AppendLine("      align-items: center;");
+        w.AppendLine("      gap: 4px;");
+        w.AppendLine("      padding: 4px 8px;");
+        w.AppendLine("      margin-left: 8px;");
+        w.AppendLine("      background: #3d3d5c;");
+        w.AppendLine("      border: 1px solid #555;");
+        w.AppendLine("      border-radius: 4px;");
+        w.AppendLine("      cursor: pointer;");
+        w.AppendLine("      font-size: 11px;");
+        w.AppendLine("      color: #888;");
+        w.AppendLine("      transition: all 0.2s;");
+        w.AppendLine("    }");
+        w.AppendLine("    .highlight-toggle:hover {");
+        w.AppendLine("      background: #4d4d6c;");
+        w.AppendLine("      color: #fff;");
+        w.AppendLine("    }");
+        w.AppendLine("    .highlight-toggle.active {");
+        w.AppendLine("      background: #ff6b6b;");
+        w.AppendLine("      border-color: #ff6b6b;");
+        w.AppendLine("      color: #fff;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip-header {");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      align-items: center;");
+        w.AppendLine("      gap: 12px;");
+        w.AppendLine("      margin-bottom: 10px;");
+        w.AppendLine("      padding-bottom: 10px;");
+        w.AppendLine("      border-bottom: 1px solid #444;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip-char {");
+        w.AppendLine("      font-family: 'Cascadia Code', 'Fira Code', Consolas, monospace;");
+        w.AppendLine("      font-size: 28px;");
+        w.AppendLine("      width: 44px;");
+        w.AppendLine("      height: 44px;");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      align-items: center;");
+        w.AppendLine("      justify-content: center;");
+        w.AppendLine("      border-radius: 6px;");
+        w.AppendLine("      border: 1px solid #555;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip-position {");
+        w.AppendLine("      color: #888;");
+        w.AppendLine("      font-size: 12px;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip-section {");
+        w.AppendLine("      margin-bottom: 8px;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip-section:last-child {");
+        w.AppendLine("      margin-bottom: 0;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip-label {");
+        w.AppendLine("      color: #888;");
+        w.AppendLine("      font-size: 11px;");
+        w.AppendLine("      text-transform: uppercase;");
+        w.AppendLine("      letter-spacing: 0.5px;");
+        w.AppendLine("      margin-bottom: 3px;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip-value {");
+        w.AppendLine("      font-family: 'Cascadia Code', 'Fira Code', Consolas, monospace;");
+        w.AppendLine("      font-size: 12px;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip-row {");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      gap: 16px;");
+        w.AppendLine("    }");
+        w.AppendLine("    .tooltip-row > div {");
+        w.AppendLine("      flex: 1;");
+        w.AppendLine("    }");
+        w.AppendLine("    .color-swatch {");
+        w.AppendLine("      display: inline-block;");
+        w.AppendLine("      width: 14px;");
+        w.AppendLine("      height: 14px;");
+        w.AppendLine("      border-radius: 3px;");
+        w.AppendLine("      border: 1px solid #666;");
+        w.AppendLine("      vertical-align: middle;");
+        w.AppendLine("      margin-right: 6px;");
+        w.AppendLine("    }");
+        w.AppendLine("    .attr-badge {");
+        w.AppendLine("      display: inline-block;");
+        w.AppendLine("      padding: 2px 6px;");
+        w.AppendLine("      margin: 2px;");
+        w.AppendLine("      border-radius: 4px;");
+        w.AppendLine("      font-size: 11px;");
+        w.AppendLine("      background: #3d3d5c;");
+        w.AppendLine("    }");
+        w.AppendLine("    .attr-badge.bold { font-weight: bold; }");
+        w.AppendLine("    .attr-badge.italic { font-style: italic; }");
+        w.AppendLine("    .attr-badge.underline { text-decoration: underline; }");
+        w.AppendLine("    .attr-badge.strikethrough { text-decoration: line-through; }");
+        w.AppendLine("    .attr-badge.dim { opacity: 0.5; }");
+        w.AppendLine("    .attr-badge.blink { background: #5c5c3d; }");
+        w.AppendLine("    .attr-badge.reverse { background: #5c3d5c; }");
+        w.AppendLine("    .attr-badge.hidden { background: #3d3d3d; }");
+        w.AppendLine("    .attr-badge.overline { text-decoration: overline; }");
+        w.AppendLine("    .theme-controls {");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      gap: 20px;");
+        w.AppendLine("      align-items: center;");
+        w.AppendLine("      margin-bottom: 20px;");
+        w.AppendLine("      flex-wrap: wrap;");
+        w.AppendLine("    }");
+        w.AppendLine("    .theme-presets {");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      gap: 8px;");
+        w.AppendLine("    }");
+        w.AppendLine("    .theme-btn {");
+        w.AppendLine("      padding: 8px 16px;");
+        w.AppendLine("      border: 1px solid #444;");
+        w.AppendLine("      border-radius: 6px;");
+        w.AppendLine("      background: #2d2d44;");
+        w.AppendLine("      color: #eee;");
+        w.AppendLine("      cursor: pointer;");
+        w.AppendLine("      font-size: 13px;");
+        w.AppendLine("      transition: all 0.2s;");
+        w.AppendLine("    }");
+        w.AppendLine("    .theme-btn:hover {");
+        w.AppendLine("      background: #3d3d5c;");
+        w.AppendLine("    }");
+        w.AppendLine("    .theme-btn.active {");
+        w.AppendLine("      background: #00d4ff;");
+        w.AppendLine("      color: #000;");
+        w.AppendLine("      border-color: #00d4ff;");
+        w.AppendLine("    }");
+        w.AppendLine("    .color-pickers {");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      gap: 16px;");
+        w.AppendLine("      align-items: center;");
+        w.AppendLine("    }");
+        w.AppendLine("    .color-pickers label {");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      align-items: center;");
+        w.AppendLine("      gap: 8px;");
+        w.AppendLine("      font-size: 13px;");
+        w.AppendLine("      color: #888;");
+        w.AppendLine("    }");
+        w.AppendLine("    .color-pickers input[type=\"color\"] {");
+        w.AppendLine("      width: 40px;");
+        w.AppendLine("      height: 28px;");
+        w.AppendLine("      border: 1px solid #444;");
+        w.AppendLine("      border-radius: 4px;");
+        w.AppendLine("      cursor: pointer;");
+        w.AppendLine("      background: transparent;");
+        w.AppendLine("    }");
+        w.AppendLine("    .grid-controls {");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      gap: 16px;");
+        w.AppendLine("      align-items: center;");
+        w.AppendLine("    }");
+        w.AppendLine("    .grid-controls label {");
+        w.AppendLine("      display: flex;");
+        w.AppendLine("      align-items: center;");
+        w.AppendLine("      gap: 6px;");
+        w.AppendLine("      font-size: 13px;");
+        w.AppendLine("      color: #888;");
+        w.AppendLine("      cursor: pointer;");
+        w.AppendLine("    }");
+        w.AppendLine("    .grid-controls input[type=\"checkbox\"] {");
+        w.AppendLine("      width: 16px;");
+        w.AppendLine("      height: 16px;");
+        w.AppendLine("      cursor: pointer;");
+        w.AppendLine("    }");
+        w.AppendLine("    .svg-container .cell-grid { display: none; }");
+        w.AppendLine("    .svg-container.show-cell-grid .cell-grid { display: block; }");
+        w.AppendLine("    .svg-container .pixel-grid { display: none; }");
+        w.AppendLine("    .svg-container.show-pixel-grid .pixel-grid { display: block; }");
+        w.AppendLine("  </style>");
+        w.AppendLine("</head>");
+        w.AppendLine("<body>");
+        w.AppendLine("  <h1>Terminal Snapshot Inspector</h1>");
+        w.AppendLine($"  <div class=\"info-bar\">Size: {region.Width} × {region.Height} cells | Hover over cells to inspect</div>");
+        w.AppendLine("  <div class=\"theme-controls\">");
+        w.AppendLine("    <div class=\"theme-presets\">");
+        w.AppendLine("      <button id=\"btn-dark\" class=\"theme-btn active\">Dark Mode</button>");
+        w.AppendLine("      <button id=\"btn-light\" class=\"theme-btn\">Light Mode</button>");
+        w.AppendLine("    </div>");
+        w.AppendLine("    <div class=\"color-pickers\">");
+        w.AppendLine("      <label>Background: <input type=\"color\" id=\"bg-picker\" value=\"#1e1e1e\"></label>");
+        w.AppendLine("      <label>Foreground: <input type=\"color\" id=\"fg-picker\" value=\"#d4d4d4\"></label>");
+        w.AppendLine("    </div>");
+        w.AppendLine("    <div class=\"grid-controls\">");
+        w.AppendLine("      <label><input type=\"checkbox\" id=\"cell-grid-toggle\"> Cell Grid</label>");
+        w.AppendLine("      <label><input type=\"color\" id=\"cell-grid-color\" value=\"#808080\"></label>");
+        w.AppendLine("      <label><input type=\"checkbox\" id=\"pixel-grid-toggle\"> Pixel Grid</label>");
+        w.AppendLine("      <label><input type=\"color\" id=\"pixel-grid-color\" value=\"#404040\"></label>");
+        w.AppendLine("    </div>");
+        w.AppendLine("  </div>");
+        w.AppendLine("  <div class=\"container\">");
         var scrollbackClass = scrollbackLineCount > 0 ? " has-scrollback" : "";
-        sb.AppendLine($"    <div class=\"svg-container{scrollbackClass}\" id=\"svg-container\">");
-        sb.AppendLine(svgContent);
-        sb.AppendLine($"      <div class=\"cell-highlight\" id=\"cell-highlight\"></div>");
-        sb.AppendLine("    </div>");
-        sb.AppendLine("  </div>");
-        sb.AppendLine("  <div class=\"tooltip\" id=\"tooltip\"></div>");
-        sb.AppendLine();
-        sb.AppendLine("  <script>");
-        sb.AppendLine("    // Check for minimal mode via query string");
-        sb.AppendLine("    const urlParams = new URLSearchParams(window.location.search);");
-        sb.AppendLine("    const isMinimalMode = urlParams.get('minimal') === 'true';");
-        sb.AppendLine("    if (isMinimalMode) {");
-        sb.AppendLine("      document.body.classList.add('minimal');");
-        sb.AppendLine("      // Apply theme from query params if provided");
-        sb.AppendLine("      const themeBg = urlParams.get('bg');");
-        sb.AppendLine("      const themeFg = urlParams.get('fg');");
-        sb.AppendLine("      if (themeBg) {");
-        sb.AppendLine("        document.body.style.background = themeBg;");
-        sb.AppendLine("      }");
-        sb.AppendLine("    }");
-        sb.AppendLine();
-        sb.AppendLine($"    const BASE_CELL_WIDTH = {cellWidth};");
-        sb.AppendLine($"    const BASE_CELL_HEIGHT = {cellHeight};");
-        sb.AppendLine($"    const SVG_WIDTH = {svgWidth};");
-        sb.AppendLine($"    const SVG_HEIGHT = {svgHeight};");
-        sb.AppendLine($"    const COLS = {region.Width};");
-        sb.AppendLine($"    const ROWS = {region.Height};");
-        sb.AppendLine($"    const SCROLLBACK_LINES = {scrollbackLineCount};");
-        sb.AppendLine($"    const cellData = {cellData};");
-        sb.AppendLine();
-        sb.AppendLine("    const container = document.getElementById('svg-container');");
-        sb.AppendLine("    const highlight = document.getElementById('cell-highlight');");
-        sb.AppendLine("    const tooltip = document.getElementById('tooltip');");
-        sb.AppendLine("    const svg = container.querySelector('svg');");
-        sb.AppendLine();
+        w.AppendLine($"    <div class=\"svg-container{scrollbackClass}\" id=\"svg-container\">");
+        svgRenderer.Render(region, writer, cursorX, cursorY, scrollbackLineCount);
+        w.AppendLine($"      <div class=\"cell-highlight\" id=\"cell-highlight\"></div>");
+        w.AppendLine("    </div>");
+        w.AppendLine("  </div>");
+        w.AppendLine("  <div class=\"tooltip\" id=\"tooltip\"></div>");
+        w.AppendLine();
+        w.AppendLine("  <script>");
+        w.AppendLine("    // Check for minimal mode via query string");
+        w.AppendLine("    const urlParams = new URLSearchParams(window.location.search);");
+        w.AppendLine("    const isMinimalMode = urlParams.get('minimal') === 'true';");
+        w.AppendLine("    if (isMinimalMode) {");
+        w.AppendLine("      document.body.classList.add('minimal');");
+        w.AppendLine("      // Apply theme from query params if provided");
+        w.AppendLine("      const themeBg = urlParams.get('bg');");
+        w.AppendLine("      const themeFg = urlParams.get('fg');");
+        w.AppendLine("      if (themeBg) {");
+        w.AppendLine("        document.body.style.background = themeBg;");
+        w.AppendLine("      }");
+        w.AppendLine("    }");
+        w.AppendLine();
+        w.AppendLine($"    const BASE_CELL_WIDTH = {cellWidth};");
+        w.AppendLine($"    const BASE_CELL_HEIGHT = {cellHeight};");
+        w.AppendLine($"    const SVG_WIDTH = {svgWidth};");
+        w.AppendLine($"    const SVG_HEIGHT = {svgHeight};");
+        w.AppendLine($"    const COLS = {region.Width};");
+        w.AppendLine($"    const ROWS = {region.Height};");
+        w.AppendLine($"    const SCROLLBACK_LINES = {scrollbackLineCount};");
+        w.Append("    const cellData = ");
+        WriteCellDataJson(w, region, svgRenderer);
+        w.AppendLine(";");
+        w.AppendLine();
+        w.AppendLine("    const container = document.getElementById('svg-container');");
+        w.AppendLine("    const highlight = document.getElementById('cell-highlight');");
+        w.AppendLine("    const tooltip = document.getElementById('tooltip');");
+        w.AppendLine("    const svg = container.querySelector('svg');");
+        w.AppendLine();
         // Scroll to the visible area on load when scrollback is present
-        sb.AppendLine("    // Scroll to visible area when scrollback lines are present");
-        sb.AppendLine("    if (SCROLLBACK_LINES > 0) {");
-        sb.AppendLine("      requestAnimationFrame(() => {");
-        sb.AppendLine("        const svgRect = svg.getBoundingClientRect();");
-        sb.AppendLine("        const scale = svgRect.height / SVG_HEIGHT;");
-        sb.AppendLine("        const scrollbackPixelHeight = SCROLLBACK_LINES * BASE_CELL_HEIGHT * scale;");
-        sb.AppendLine("        container.scrollTop = scrollbackPixelHeight;");
-        sb.AppendLine("      });");
-        sb.AppendLine("    }");
-        sb.AppendLine();
-        sb.AppendLine("    // Track current cell for shimmer effect");
-        sb.AppendLine("    let currentCellX = -1;");
-        sb.AppendLine("    let currentCellY = -1;");
-        sb.AppendLine();
-        sb.AppendLine("    // Track pinned state for tooltip");
-        sb.AppendLine("    let isPinned = false;");
-        sb.AppendLine("    let pinnedCellX = -1;");
-        sb.AppendLine("    let pinnedCellY = -1;");
-        sb.AppendLine();
-        sb.AppendLine("    // Track highlighted cell groups");
-        sb.AppendLine("    let highlightedGroups = new Set();");
-        sb.AppendLine();
-        sb.AppendLine("    // Scale SVG to fill container while maintaining aspect ratio");
-        sb.AppendLine("    function updateSvgScale() {");
-        sb.AppendLine("      const containerRect = container.getBoundingClientRect();");
-        sb.AppendLine("      const padding = 40; // 20px padding on each side");
-        sb.AppendLine("      const availableWidth = containerRect.width - padding;");
-        sb.AppendLine("      const availableHeight = containerRect.height - padding;");
-        sb.AppendLine("      const scaleX = availableWidth / SVG_WIDTH;");
-        sb.AppendLine("      const scaleY = availableHeight / SVG_HEIGHT;");
-        sb.AppendLine("      const scale = Math.min(scaleX, scaleY);");
-        sb.AppendLine("      svg.style.width = (SVG_WIDTH * scale) + 'px';");
-        sb.AppendLine("      svg.style.height = (SVG_HEIGHT * scale) + 'px';");
-        sb.AppendLine("    }");
-        sb.AppendLine("    updateSvgScale();");
-        sb.AppendLine("    window.addEventListener('resize', updateSvgScale);");
-        sb.AppendLine();
-        sb.AppendLine("    function rgbToHex(r, g, b) {");
-        sb.AppendLine("      return '#' + [r, g, b].map(x => x.toString(16).padStart(2, '0')).join('');");
-        sb.AppendLine("    }");
-        sb.AppendLine();
-        sb.AppendLine("    function rgbToHsl(r, g, b) {");
-        sb.AppendLine("      r /= 255; g /= 255; b /= 255;");
-        sb.AppendLine("      const max = Math.max(r, g, b), min = Math.min(r, g, b);");
-        sb.AppendLine("      let h, s, l = (max + min) / 2;");
-        sb.AppendLine("      if (max === min) { h = s = 0; }");
-        sb.AppendLine("      else {");
-        sb.AppendLine("        const d = max - min;");
-        sb.AppendLine("        s = l > 0.5 ? d / (2 - max - min) : d / (max + min);");
-        sb.AppendLine("        switch (max) {");
-        sb.AppendLine("          case r: h = ((g - b) / d + (g < b ? 6 : 0)) / 6; break;");
-        sb.AppendLine("          case g: h = ((b - r) / d + 2) / 6; break;");
-        sb.AppendLine("          case b: h = ((r - g) / d + 4) / 6; break;");
-        sb.AppendLine("        }");
-        sb.AppendLine("      }");
-        sb.AppendLine("      return `hsl(${Math.round(h * 360)}, ${Math.round(s * 100)}%, ${Math.round(l * 100)}%)`;");
-        sb.AppendLine("    }");
-        sb.AppendLine();
-        sb.AppendLine("    function getAttributeBadges(attrs) {");
-        sb.AppendLine("      const badges = [];");
-        sb.AppendLine("      if (attrs & 1) badges.push('<span class=\"attr-badge bold\">Bold</span>');");
-        sb.AppendLine("      if (attrs & 2) badges.push('<span class=\"attr-badge dim\">Dim</span>');");
-        sb.AppendLine("      if (attrs & 4) badges.push('<span class=\"attr-badge italic\">Italic</span>');");
-        sb.AppendLine("      if (attrs & 8) badges.push('<span class=\"attr-badge underline\">Underline</span>');");
-        sb.AppendLine("      if (attrs & 16) badges.push('<span class=\"attr-badge blink\">Blink</span>');");
-        sb.AppendLine("      if (attrs & 32) badges.push('<span class=\"attr-badge reverse\">Reverse</span>');");
-        sb.AppendLine("      if (attrs & 64) badges.push('<span class=\"attr-badge hidden\">Hidden</span>');");
-        sb.AppendLine("      if (attrs & 128) badges.push('<span class=\"attr-badge strikethrough\">Strike</span>');");
-        sb.AppendLine("      if (attrs & 256) badges.push('<span class=\"attr-badge overline\">Overline</span>');");
-        sb.AppendLine("      return badges.length > 0 ? badges.join('') : '<span style=\"color:#666\">None</span>';");
-        sb.AppendLine("    }");
-        sb.AppendLine();
-        sb.AppendLine("    function formatColorInfo(color, label) {");
-        sb.AppendLine("      if (!color) return `<span style=\"color:#666\">Default</span>`;");
-        sb.AppendLine("      const hex = rgbToHex(color.r, color.g, color.b);");
-        sb.AppendLine("      const hsl = rgbToHsl(color.r, color.g, color.b);");
-        sb.AppendLine("      return `<span class=\"color-swatch\" style=\"background:${hex}\"></span>${hex}<br>` +");
-        sb.AppendLine("             `<span style=\"color:#888;font-size:11px\">rgb(${color.r}, ${color.g}, ${color.b})<br>${hsl}</span>`;");
-        sb.AppendLine("    }");
-        sb.AppendLine();
-        sb.AppendLine("    function renderTooltip(cell, x, y) {");
-        sb.AppendLine("      const char = cell.c === ' ' ? '␣' : (cell.c === '\\0' ? '∅' : (cell.c === '' ? '⋯' : cell.c));");
-        sb.AppendLine("      const codePoint = cell.c.codePointAt(0) || 0;");
-        sb.AppendLine("      const fgStyle = cell.fg ? `color:rgb(${cell.fg.r},${cell.fg.g},${cell.fg.b});` : '';");
-        sb.AppendLine("      const bgStyle = cell.bg ? `background:rgb(${cell.bg.r},${cell.bg.g},${cell.bg.b});` : 'background:#1e1e1e;';");
-        sb.AppendLine("      const seqInfo = cell.seq ? `Seq: ${cell.seq}` : 'Seq: 0';");
-        sb.AppendLine("      const timeInfo = cell.t ? new Date(cell.t).toLocaleTimeString() : '-';");
-        sb.AppendLine("      const hasSixel = cell.sixel;");
-        sb.AppendLine("      const hasLink = cell.link;");
-        sb.AppendLine();
-        sb.AppendLine("      return `");
-        sb.AppendLine("        <div class=\"tooltip-header\">");
-        sb.AppendLine("          <div class=\"tooltip-char\" style=\"${fgStyle}${bgStyle}\">${char}</div>");
-        sb.AppendLine("          <div>");
-        sb.AppendLine("            <div style=\"font-size:16px;font-weight:500\">Cell (${x}, ${y})</div>");
-        sb.AppendLine("            <div class=\"tooltip-position\">Column ${x}, Row ${y}</div>");
-        sb.AppendLine("          </div>");
-        sb.AppendLine("        </div>");
-        sb.AppendLine("        <div class=\"tooltip-section\">");
-        sb.AppendLine("          <div class=\"tooltip-label\">Character</div>");
-        sb.AppendLine("          <div class=\"tooltip-value\">");
-        sb.AppendLine("            '${cell.c === '\\0' ? '\\\\0 (null)' : (cell.c === '' ? '(continuation)' : cell.c)}' &nbsp;|&nbsp; ");
-        sb.AppendLine("            U+${codePoint.toString(16).toUpperCase().padStart(4, '0')} &nbsp;|&nbsp; ");
-        sb.AppendLine("            Dec: ${codePoint}");
-        sb.AppendLine("          </div>");
-        sb.AppendLine("        </div>");
-        sb.AppendLine("        <div class=\"tooltip-row\">");
-        sb.AppendLine("          <div class=\"tooltip-section\">");
-        sb.AppendLine("            <div class=\"tooltip-label\">Foreground</div>");
-        sb.AppendLine("            <div class=\"tooltip-value\">${formatColorInfo(cell.fg, 'fg')}</div>");
-        sb.AppendLine("          </div>");
-        sb.AppendLine("          <div class=\"tooltip-section\">");
-        sb.AppendLine("            <div class=\"tooltip-label\">Background</div>");
-        sb.AppendLine("            <div class=\"tooltip-value\">${formatColorInfo(cell.bg, 'bg')}</div>");
-        sb.AppendLine("          </div>");
-        sb.AppendLine("          ${cell.uc ? `<div class=\"tooltip-section\">");
-        sb.AppendLine("            <div class=\"tooltip-label\">Underline Color</div>");
-        sb.AppendLine("            <div class=\"tooltip-value\">${formatColorInfo(cell.uc, 'uc')}</div>");
-        sb.AppendLine("          </div>` : ''}");
-        sb.AppendLine("        </div>");
-        sb.AppendLine("        <div class=\"tooltip-section\">");
-        sb.AppendLine("          <div class=\"tooltip-label\">Attributes (${cell.a})</div>");
-        sb.AppendLine("          <div class=\"tooltip-value\">${getAttributeBadges(cell.a)}</div>");
-        sb.AppendLine("        </div>");
-        sb.AppendLine("        <div class=\"tooltip-section\">");
-        sb.AppendLine("          <div class=\"tooltip-label\">Write Order</div>");
-        sb.AppendLine("          <div class=\"tooltip-value\">${seqInfo} &nbsp;|&nbsp; ${timeInfo}</div>");
-        sb.AppendLine("        </div>");
-        sb.AppendLine("        ${hasSixel ? `");
-        sb.AppendLine("        <div class=\"tooltip-section\">");
-        sb.AppendLine("          <div class=\"tooltip-label\">Sixel Graphics</div>");
-        sb.AppendLine("          <div class=\"tooltip-value\">");
-        sb.AppendLine("            ${cell.sixel.origin ? '<span class=\"attr-badge\" style=\"background:#4e9a06\">Origin</span>' : '<span class=\"attr-badge\">Continuation</span>'}");
-        sb.AppendLine("            ${cell.sixel.w}×${cell.sixel.h} cells");
-        sb.AppendLine("          </div>");
-        sb.AppendLine("        </div>` : ''}");
-        sb.AppendLine("        ${hasLink ? `");
-        sb.AppendLine("        <div class=\"tooltip-section\">");
-        sb.AppendLine("          <div class=\"tooltip-label\">Hyperlink (OSC 8)</div>");
-        sb.AppendLine("          <div class=\"tooltip-value\">");
-        sb.AppendLine("            <a href=\"${cell.link.uri}\" target=\"_blank\" style=\"color:#00d4ff;text-decoration:underline;word-break:break-all\">${cell.link.uri}</a>");
-        sb.AppendLine("            ${cell.link.params ? `<br><span style=\"color:#888;font-size:11px\">Params: ${cell.link.params}</span>` : ''}");
-        sb.AppendLine("            ${cell.link.group ? `<br><button class=\"highlight-toggle ${highlightedGroups.has(cell.link.group) ? 'active' : ''}\" onclick=\"toggleGroupHighlight('${cell.link.group}')\">👁 ${highlightedGroups.has(cell.link.group) ? 'Hide' : 'Show'} related cells</button>` : ''}");
-        sb.AppendLine("          </div>");
-        sb.AppendLine("        </div>` : ''}");
-        sb.AppendLine("        ${isPinned ? `<span class=\"tooltip-pin-indicator\" onclick=\"unpinTooltip()\" title=\"Click to unpin\">📌</span>` : ''}");
-        sb.AppendLine("      `;");
-        sb.AppendLine("    }");
-        sb.AppendLine();
-        sb.AppendLine("    // Toggle highlight for a cell group (e.g., all cells with same hyperlink)");
-        sb.AppendLine("    function toggleGroupHighlight(groupName) {");
-        sb.AppendLine("      if (highlightedGroups.has(groupName)) {");
-        sb.AppendLine("        highlightedGroups.delete(groupName);");
-        sb.AppendLine("        // Remove highlight class from all cells in this group");
-        sb.AppendLine("        svg.querySelectorAll(`g.cell.${groupName}`).forEach(g => g.classList.remove('highlight'));");
-        sb.AppendLine("      } else {");
-        sb.AppendLine("        highlightedGroups.add(groupName);");
-        sb.AppendLine("        // Add highlight class to all cells in this group");
-        sb.AppendLine("        svg.querySelectorAll(`g.cell.${groupName}`).forEach(g => g.classList.add('highlight'));");
-        sb.AppendLine("      }");
-        sb.AppendLine("      // Re-render tooltip to update button state");
-        sb.AppendLine("      if (isPinned) {");
-        sb.AppendLine("        const cell = cellData[pinnedCellY][pinnedCellX];");
-        sb.AppendLine("        tooltip.innerHTML = renderTooltip(cell, pinnedCellX, pinnedCellY);");
-        sb.AppendLine("      }");
-        sb.AppendLine("    }");
-        sb.AppendLine("    // Make function available globally for onclick");
-        sb.AppendLine("    window.toggleGroupHighlight = toggleGroupHighlight;");
-        sb.AppendLine();
-        sb.AppendLine("    // Pin the tooltip in place");
-        sb.AppendLine("    function pinTooltip(x, y) {");
-        sb.AppendLine("      isPinned = true;");
-        sb.AppendLine("      pinnedCellX = x;");
-        sb.AppendLine("      pinnedCellY = y;");
-        sb.AppendLine("      tooltip.classList.add('pinned');");
-        sb.AppendLine("      // Re-render to show pin indicator");
-        sb.AppendLine("      const cell = cellData[y][x];");
-        sb.AppendLine("      tooltip.innerHTML = renderTooltip(cell, x, y);");
-        sb.AppendLine("    }");
-        sb.AppendLine();
-        sb.AppendLine("    // Unpin the tooltip");
-        sb.AppendLine("    function unpinTooltip() {");
-        sb.AppendLine("      isPinned = false;");
-        sb.AppendLine("      pinnedCellX = -1;");
-        sb.AppendLine("      pinnedCellY = -1;");
-        sb.AppendLine("      tooltip.classList.remove('pinned');");
-        sb.AppendLine("      tooltip.classList.remove('visible');");
-        sb.AppendLine("      highlight.classList.remove('visible');");
-        sb.AppendLine("    }");
-        sb.AppendLine("    // Make function available globally for onclick");
-        sb.AppendLine("    window.unpinTooltip = unpinTooltip;");
-        sb.AppendLine();
-        sb.AppendLine("    container.addEventListener('mousemove', (e) => {");
-        sb.AppendLine("      // If tooltip is pinned, don't update on hover");
-        sb.AppendLine("      if (isPinned) return;");
-        sb.AppendLine();
-        sb.AppendLine("      const svgRect = svg.getBoundingClientRect();");
-        sb.AppendLine("      const scaleX = svgRect.width / SVG_WIDTH;");
-        sb.AppendLine("      const scaleY = svgRect.height / SVG_HEIGHT;");
-        sb.AppendLine("      const cellWidth = BASE_CELL_WIDTH * scaleX;");
-        sb.AppendLine("      const cellHeight = BASE_CELL_HEIGHT * scaleY;");
-        sb.AppendLine("      const x = Math.floor((e.clientX - svgRect.left) / cellWidth);");
-        sb.AppendLine("      const y = Math.floor((e.clientY - svgRect.top) / cellHeight);");
-        sb.AppendLine();
-        sb.AppendLine("      if (x >= 0 && x < COLS && y >= 0 && y < ROWS) {");
-        sb.AppendLine("        const cell = cellData[y][x];");
-        sb.AppendLine();
-        sb.AppendLine("        // Check if we moved to a new cell");
-        sb.AppendLine("        const cellChanged = (x !== currentCellX || y !== currentCellY);");
-        sb.AppendLine("        currentCellX = x;");
-        sb.AppendLine("        currentCellY = y;");
-        sb.AppendLine();
-        sb.AppendLine("        // Position highlight relative to SVG");
-        sb.AppendLine("        const svgOffset = svg.getBoundingClientRect();");
-        sb.AppendLine("        const containerOffset = container.getBoundingClientRect();");
-        sb.AppendLine("        highlight.style.left = (svgOffset.left - containerOffset.left + x * cellWidth) + 'px';");
-        sb.AppendLine("        highlight.style.top = (svgOffset.top - containerOffset.top + y * cellHeight) + 'px';");
-        sb.AppendLine("        highlight.style.width = cellWidth + 'px';");
-        sb.AppendLine("        highlight.style.height = cellHeight + 'px';");
-        sb.AppendLine("        highlight.classList.add('visible');");
-        sb.AppendLine();
-        sb.AppendLine("        // Shimmer effect when moving to a new cell");
-        sb.AppendLine("        if (cellChanged) {");
-        sb.AppendLine("          highlight.classList.add('shimmer');");
-        sb.AppendLine("          setTimeout(() => highlight.classList.remove('shimmer'), 200);");
-        sb.AppendLine("        }");
-        sb.AppendLine();
-        sb.AppendLine("        // Update and position tooltip");
-        sb.AppendLine("        tooltip.innerHTML = renderTooltip(cell, x, y);");
-        sb.AppendLine("        tooltip.classList.add('visible');");
-        sb.AppendLine();
-        sb.AppendLine("        // Position tooltip to avoid viewport edges");
-        sb.AppendLine("        let tooltipX = e.clientX + 15;");
-        sb.AppendLine("        let tooltipY = e.clientY + 15;");
-        sb.AppendLine("        const tooltipRect = tooltip.getBoundingClientRect();");
-        sb.AppendLine("        if (tooltipX + tooltipRect.width > window.innerWidth - 10) {");
-        sb.AppendLine("          tooltipX = e.clientX - tooltipRect.width - 15;");
-        sb.AppendLine("        }");
-        sb.AppendLine("        if (tooltipY + tooltipRect.height > window.innerHeight - 10) {");
-        sb.AppendLine("          tooltipY = e.clientY - tooltipRect.height - 15;");
-        sb.AppendLine("        }");
-        sb.AppendLine("        tooltip.style.left = tooltipX + 'px';");
-        sb.AppendLine("        tooltip.style.top = tooltipY + 'px';");
-        sb.AppendLine("      } else {");
-        sb.AppendLine("        highlight.classList.remove('visible');");
-        sb.AppendLine("        tooltip.classList.remove('visible');");
-        sb.AppendLine("        currentCellX = -1;");
-        sb.AppendLine("        currentCellY = -1;");
-        sb.AppendLine("      }");
-        sb.AppendLine("    });");
-        sb.AppendLine();
-        sb.AppendLine("    // Click to pin tooltip");
-        sb.AppendLine("    container.addEventListener('click', (e) => {");
-        sb.AppendLine("      const svgRect = svg.getBoundingClientRect();");
-        sb.AppendLine("      const scaleX = svgRect.width / SVG_WIDTH;");
-        sb.AppendLine("      const scaleY = svgRect.height / SVG_HEIGHT;");
-        sb.AppendLine("      const cellWidth = BASE_CELL_WIDTH * scaleX;");
-        sb.AppendLine("      const cellHeight = BASE_CELL_HEIGHT * scaleY;");
-        sb.AppendLine("      const x = Math.floor((e.clientX - svgRect.left) / cellWidth);");
-        sb.AppendLine("      const y = Math.floor((e.clientY - svgRect.top) / cellHeight);");
-        sb.AppendLine();
-        sb.AppendLine("      if (x >= 0 && x < COLS && y >= 0 && y < ROWS) {");
-        sb.AppendLine("        if (isPinned && pinnedCellX === x && pinnedCellY === y) {");
-        sb.AppendLine("          // Clicking pinned cell again unpins");
-        sb.AppendLine("          unpinTooltip();");
-        sb.AppendLine("        } else {");
-        sb.AppendLine("          // Pin to this cell");
-        sb.AppendLine("          pinTooltip(x, y);");
-        sb.AppendLine("        }");
-        sb.AppendLine("      }");
-        sb.AppendLine("    });");
-        sb.AppendLine();
-        sb.AppendLine("    container.addEventListener('mouseleave', () => {");
-        sb.AppendLine("      // Only hide if not pinned");
-        sb.AppendLine("      if (!isPinned) {");
-        sb.AppendLine("        highlight.classList.remove('visible');");
-        sb.AppendLine("        tooltip.classList.remove('visible');");
-        sb.AppendLine("      }");
-        sb.AppendLine("    });");
-        sb.AppendLine();
-        sb.AppendLine("    // Theme controls");
-        sb.AppendLine("    const bgPicker = document.getElementById('bg-picker');");
-        sb.AppendLine("    const fgPicker = document.getElementById('fg-picker');");
-        sb.AppendLine("    const btnDark = document.getElementById('btn-dark');");
-        sb.AppendLine("    const btnLight = document.getElementById('btn-light');");
-        sb.AppendLine("    const cellGridToggle = document.getElementById('cell-grid-toggle');");
-        sb.AppendLine("    const pixelGridToggle = document.getElementById('pixel-grid-toggle');");
-        sb.AppendLine("    const cellGridColorPicker = document.getElementById('cell-grid-color');");
-        sb.AppendLine("    const pixelGridColorPicker = document.getElementById('pixel-grid-color');");
-        sb.AppendLine();
-        sb.AppendLine("    let currentDefaultBg = '#1e1e1e';");
-        sb.AppendLine("    let currentDefaultFg = '#d4d4d4';");
-        sb.AppendLine("    let cellGridCustomColor = false;");
-        sb.AppendLine("    let pixelGridCustomColor = false;");
-        sb.AppendLine();
-        sb.AppendLine("    // Compute contrasting color for grids based on background luminance");
-        sb.AppendLine("    function getContrastingGridColor(bgColor, alpha) {");
-        sb.AppendLine("      const hex = bgColor.replace('#', '');");
-        sb.AppendLine("      const r = parseInt(hex.substr(0, 2), 16);");
-        sb.AppendLine("      const g = parseInt(hex.substr(2, 2), 16);");
-        sb.AppendLine("      const b = parseInt(hex.substr(4, 2), 16);");
-        sb.AppendLine("      const luminance = (0.299 * r + 0.587 * g + 0.114 * b) / 255;");
-        sb.AppendLine("      const base = luminance > 0.5 ? 0 : 255;");
-        sb.AppendLine("      const adjusted = Math.round(base * alpha + (luminance > 0.5 ? 255 : 0) * (1 - alpha));");
-        sb.AppendLine("      const hex2 = adjusted.toString(16).padStart(2, '0');");
-        sb.AppendLine("      return `#${hex2}${hex2}${hex2}`;");
-        sb.AppendLine("    }");
-        sb.AppendLine();
-        sb.AppendLine("    function updateGridColors(bgColor) {");
-        sb.AppendLine("      if (!cellGridCustomColor) {");
-        sb.AppendLine("        const cellColor = getContrastingGridColor(bgColor, 0.5);");
-        sb.AppendLine("        cellGridColorPicker.value = cellColor;");
-        sb.AppendLine("        svg.querySelectorAll('.cell-grid line').forEach(el => el.setAttribute('stroke', cellColor));");
-        sb.AppendLine("      }");
-        sb.AppendLine("      if (!pixelGridCustomColor) {");
-        sb.AppendLine("        const pixelColor = getContrastingGridColor(bgColor, 0.25);");
-        sb.AppendLine("        pixelGridColorPicker.value = pixelColor;");
-        sb.AppendLine("        svg.querySelectorAll('.pixel-grid line').forEach(el => el.setAttribute('stroke', pixelColor));");
-        sb.AppendLine("      }");
-        sb.AppendLine("    }");
-        sb.AppendLine();
-        sb.AppendLine("    function updateTheme(newBg, newFg) {");
-        sb.AppendLine("      // Update the main background rect (first rect in SVG)");
-        sb.AppendLine("      const bgRect = svg.querySelector('rect');");
-        sb.AppendLine("      if (bgRect) bgRect.setAttribute('fill', newBg);");
-        sb.AppendLine();
-        sb.AppendLine("      // Update all cell background rects that use default background");
-        sb.AppendLine("      const allRects = svg.querySelectorAll('g.terminal-text rect');");
-        sb.AppendLine("      allRects.forEach(rect => {");
-        sb.AppendLine("        const currentFill = rect.getAttribute('fill');");
-        sb.AppendLine("        if (currentFill === currentDefaultBg) {");
-        sb.AppendLine("          rect.setAttribute('fill', newBg);");
-        sb.AppendLine("        }");
-        sb.AppendLine("      });");
-        sb.AppendLine();
-        sb.AppendLine("      // Update text elements using default foreground");
-        sb.AppendLine("      const allText = svg.querySelectorAll('g.terminal-text text');");
-        sb.AppendLine("      allText.forEach(text => {");
-        sb.AppendLine("        const currentFill = text.getAttribute('fill');");
-        sb.AppendLine("        if (currentFill === currentDefaultFg) {");
-        sb.AppendLine("          text.setAttribute('fill', newFg);");
-        sb.AppendLine("        }");
-        sb.AppendLine("      });");
-        sb.AppendLine();
-        sb.AppendLine("      currentDefaultBg = newBg;");
-        sb.AppendLine("      currentDefaultFg = newFg;");
-        sb.AppendLine("      bgPicker.value = newBg;");
-        sb.AppendLine("      fgPicker.value = newFg;");
-        sb.AppendLine();
-        sb.AppendLine("      // Update grid colors based on new background");
-        sb.AppendLine("      updateGridColors(newBg);");
-        sb.AppendLine("    }");
-        sb.AppendLine();
-        sb.AppendLine("    bgPicker.addEventListener('input', (e) => {");
-        sb.AppendLine("      updateTheme(e.target.value, currentDefaultFg);");
-        sb.AppendLine("      btnDark.classList.remove('active');");
-        sb.AppendLine("      btnLight.classList.remove('active');");
-        sb.AppendLine("    });");
-        sb.AppendLine();
-        sb.AppendLine("    fgPicker.addEventListener('input', (e) => {");
-        sb.AppendLine("      updateTheme(currentDefaultBg, e.target.value);");
-        sb.AppendLine("      btnDark.classList.remove('active');");
-        sb.AppendLine("      btnLight.classList.remove('active');");
-        sb.AppendLine("    });");
-        sb.AppendLine();
-        sb.AppendLine("    btnDark.addEventListener('click', () => {");
-        sb.AppendLine("      updateTheme('#1e1e1e', '#d4d4d4');");
-        sb.AppendLine("      btnDark.classList.add('active');");
-        sb.AppendLine("      btnLight.classList.remove('active');");
-        sb.AppendLine("    });");
-        sb.AppendLine();
-        sb.AppendLine("    btnLight.addEventListener('click', () => {");
-        sb.AppendLine("      updateTheme('#ffffff', '#1e1e1e');");
-        sb.AppendLine("      btnLight.classList.add('active');");
-        sb.AppendLine("      btnDark.classList.remove('active');");
-        sb.AppendLine("    });");
-        sb.AppendLine();
-        sb.AppendLine("    // Grid toggle and color controls");
-        sb.AppendLine("    cellGridToggle.addEventListener('change', (e) => {");
-        sb.AppendLine("      container.classList.toggle('show-cell-grid', e.target.checked);");
-        sb.AppendLine("    });");
-        sb.AppendLine();
-        sb.AppendLine("    pixelGridToggle.addEventListener('change', (e) => {");
-        sb.AppendLine("      container.classList.toggle('show-pixel-grid', e.target.checked);");
-        sb.AppendLine("    });");
-        sb.AppendLine();
-        sb.AppendLine("    cellGridColorPicker.addEventListener('input', (e) => {");
-        sb.AppendLine("      cellGridCustomColor = true;");
-        sb.AppendLine("      svg.querySelectorAll('.cell-grid line').forEach(el => el.setAttribute('stroke', e.target.value));");
-        sb.AppendLine("    });");
-        sb.AppendLine();
-        sb.AppendLine("    pixelGridColorPicker.addEventListener('input', (e) => {");
-        sb.AppendLine("      pixelGridCustomColor = true;");
-        sb.AppendLine("      svg.querySelectorAll('.pixel-grid line').forEach(el => el.setAttribute('stroke', e.target.value));");
-        sb.AppendLine("    });");
-        sb.AppendLine();
-        sb.AppendLine("    // Initialize grid colors based on default background");
-        sb.AppendLine("    updateGridColors(currentDefaultBg);");
-        sb.AppendLine("  </script>");
-        sb.AppendLine("</body>");
-        sb.AppendLine("</html>");
-
-        return sb.ToString();
+        w.AppendLine("    // Scroll to visible area when scrollback lines are present");
+        w.AppendLine("    if (SCROLLBACK_LINES > 0) {");
+        w.AppendLine("      requestAnimationFrame(() => {");
+        w.AppendLine("        const svgRect = svg.getBoundingClientRect();");
+        w.AppendLine("        const scale = svgRect.height / SVG_HEIGHT;");
+        w.AppendLine("        const scrollbackPixelHeight = SCROLLBACK_LINES * BASE_CELL_HEIGHT * scale;");
+        w.AppendLine("        container.scrollTop = scrollbackPixelHeight;");
+        w.AppendLine("      });");
+        w.AppendLine("    }");
+        w.AppendLine();
+        w.AppendLine("    // Track current cell for shimmer effect");
+        w.AppendLine("    let currentCellX = -1;");
+        w.AppendLine("    let currentCellY = -1;");
+        w.AppendLine();
+        w.AppendLine("    // Track pinned state for tooltip");
+        w.AppendLine("    let isPinned = false;");
+        w.AppendLine("    let pinnedCellX = -1;");
+        w.AppendLine("    let pinnedCellY = -1;");
+        w.AppendLine();
+        w.AppendLine("    // Track highlighted cell groups");
+        w.AppendLine("    let highlightedGroups = new Set();");
+        w.AppendLine();
+        w.AppendLine("    // Scale SVG to fill container while maintaining aspect ratio");
+        w.AppendLine("    function updateSvgScale() {");
+        w.AppendLine("      const containerRect = container.getBoundingClientRect();");
+        w.AppendLine("      const padding = 40; // 20px padding on each side");
+        w.AppendLine("      const availableWidth = containerRect.width - padding;");
+        w.AppendLine("      const availableHeight = containerRect.height - padding;");
+        w.AppendLine("      const scaleX = availableWidth / SVG_WIDTH;");
+        w.AppendLine("      const scaleY = availableHeight / SVG_HEIGHT;");
+        w.AppendLine("      const scale = Math.min(scaleX, scaleY);");
+        w.AppendLine("      svg.style.width = (SVG_WIDTH * scale) + 'px';");
+        w.AppendLine("      svg.style.height = (SVG_HEIGHT * scale) + 'px';");
+        w.AppendLine("    }");
+        w.AppendLine("    updateSvgScale();");
+        w.AppendLine("    window.addEventListener('resize', updateSvgScale);");
+        w.AppendLine();
+        w.AppendLine("    function rgbToHex(r, g, b) {");
+        w.AppendLine("      return '#' + [r, g, b].map(x => x.toString(16).padStart(2, '0')).join('');");
+        w.AppendLine("    }");
+        w.AppendLine();
+        w.AppendLine("    function rgbToHsl(r, g, b) {");
+        w.AppendLine("      r /= 255; g /= 255; b /= 255;");
+        w.AppendLine("      const max = Math.max(r, g, b), min = Math.min(r, g, b);");
+        w.AppendLine("      let h, s, l = (max + min) / 2;");
+        w.AppendLine("      if (max === min) { h = s = 0; }");
+        w.AppendLine("      else {");
+        w.AppendLine("        const d = max - min;");
+        w.AppendLine("        s = l > 0.5 ? d / (2 - max - min) : d / (max + min);");
+        w.AppendLine("        switch (max) {");
+        w.AppendLine("          case r: h = ((g - b) / d + (g < b ? 6 : 0)) / 6; break;");
+        w.AppendLine("          case g: h = ((b - r) / d + 2) / 6; break;");
+        w.AppendLine("          case b: h = ((r - g) / d + 4) / 6; break;");
+        w.AppendLine("        }");
+        w.AppendLine("      }");
+        w.AppendLine("      return `hsl(${Math.round(h * 360)}, ${Math.round(s * 100)}%, ${Math.round(l * 100)}%)`;");
+        w.AppendLine("    }");
+        w.AppendLine();
+        w.AppendLine("    function getAttributeBadges(attrs) {");
+        w.AppendLine("      const badges = [];");
+        w.AppendLine("      if (attrs & 1) badges.push('<span class=\"attr-badge bold\">Bold</span>');");
+        w.AppendLine("      if (attrs & 2) badges.push('<span class=\"attr-badge dim\">Dim</span>');");
+        w.AppendLine("      if (attrs & 4) badges.push('<span class=\"attr-badge italic\">Italic</span>');");
+        w.AppendLine("      if (attrs & 8) badges.push('<span class=\"attr-badge underline\">Underline</span>');");
+        w.AppendLine("      if (attrs & 16) badges.push('<span class=\"attr-badge blink\">Blink</span>');");
+        w.AppendLine("      if (attrs & 32) badges.push('<span class=\"attr-badge reverse\">Reverse</span>');");
+        w.AppendLine("      if (attrs & 64) badges.push('<span class=\"attr-badge hidden\">Hidden</span>');");
+        w.AppendLine("      if (attrs & 128) badges.push('<span class=\"attr-badge strikethrough\">Strike</span>');");
+        w.AppendLine("      if (attrs & 256) badges.push('<span class=\"attr-badge overline\">Overline</span>');");
+        w.AppendLine("      return badges.length > 0 ? badges.join('') : '<span style=\"color:#666\">None</span>';");
+        w.AppendLine("    }");
+        w.AppendLine();
+        w.AppendLine("    function formatColorInfo(color, label) {");
+        w.AppendLine("      if (!color) return `<span style=\"color:#666\">Default</span>`;");
+        w.AppendLine("      const hex = rgbToHex(color.r, color.g, color.b);");
+        w.AppendLine("      const hsl = rgbToHsl(color.r, color.g, color.b);");
+        w.AppendLine("      return `<span class=\"color-swatch\" style=\"background:${hex}\"></span>${hex}<br>` +");
+        w.AppendLine("             `<span style=\"color:#888;font-size:11px\">rgb(${color.r}, ${color.g}, ${color.b})<br>${hsl}</span>`;");
+        w.AppendLine("    }");
+        w.AppendLine();
+        w.AppendLine("    function renderTooltip(cell, x, y) {");
+        w.AppendLine("      const char = cell.c === ' ' ? '␣' : (cell.c === '\\0' ? '∅' : (cell.c === '' ? '⋯' : cell.c));");
+        w.AppendLine("      const codePoint = cell.c.codePointAt(0) || 0;");
+        w.AppendLine("      const fgStyle = cell.fg ? `color:rgb(${cell.fg.r},${cell.fg.g},${cell.fg.b});` : '';");
+        w.AppendLine("      const bgStyle = cell.bg ? `background:rgb(${cell.bg.r},${cell.bg.g},${cell.bg.b});` : 'background:#1e1e1e;';");
+        w.AppendLine("      const seqInfo = cell.seq ? `Seq: ${cell.seq}` : 'Seq: 0';");
+        w.AppendLine("      const timeInfo = cell.t ? new Date(cell.t).toLocaleTimeString() : '-';");
+        w.AppendLine("      const hasSixel = cell.sixel;");
+        w.AppendLine("      const hasLink = cell.link;");
+        w.AppendLine();
+        w.AppendLine("      return `");
+        w.AppendLine("        <div class=\"tooltip-header\">");
+        w.AppendLine("          <div class=\"tooltip-char\" style=\"${fgStyle}${bgStyle}\">${char}</div>");
+        w.AppendLine("          <div>");
+        w.AppendLine("            <div style=\"font-size:16px;font-weight:500\">Cell (${x}, ${y})</div>");
+        w.AppendLine("            <div class=\"tooltip-position\">Column ${x}, Row ${y}</div>");
+        w.AppendLine("          </div>");
+        w.AppendLine("        </div>");
+        w.AppendLine("        <div class=\"tooltip-section\">");
+        w.AppendLine("          <div class=\"tooltip-label\">Character</div>");
+        w.AppendLine("          <div class=\"tooltip-value\">");
+        w.AppendLine("            '${cell.c === '\\0' ? '\\\\0 (null)' : (cell.c === '' ? '(continuation)' : cell.c)}' &nbsp;|&nbsp; ");
+        w.AppendLine("            U+${codePoint.toString(16).toUpperCase().padStart(4, '0')} &nbsp;|&nbsp; ");
+        w.AppendLine("            Dec: ${codePoint}");
+        w.AppendLine("          </div>");
+        w.AppendLine("        </div>");
+        w.AppendLine("        <div class=\"tooltip-row\">");
+        w.AppendLine("          <div class=\"tooltip-section\">");
+        w.AppendLine("            <div class=\"tooltip-label\">Foreground</div>");
+        w.AppendLine("            <div class=\"tooltip-value\">${formatColorInfo(cell.fg, 'fg')}</div>");
+        w.AppendLine("          </div>");
+        w.AppendLine("          <div class=\"tooltip-section\">");
+        w.AppendLine("            <div class=\"tooltip-label\">Background</div>");
+        w.AppendLine("            <div class=\"tooltip-value\">${formatColorInfo(cell.bg, 'bg')}</div>");
+        w.AppendLine("          </div>");
+        w.AppendLine("          ${cell.uc ? `<div class=\"tooltip-section\">");
+        w.AppendLine("            <div class=\"tooltip-label\">Underline Color</div>");
+        w.AppendLine("            <div class=\"tooltip-value\">${formatColorInfo(cell.uc, 'uc')}</div>");
+        w.AppendLine("          </div>` : ''}");
+        w.AppendLine("        </div>");
+        w.AppendLine("        <div class=\"tooltip-section\">");
+        w.AppendLine("          <div class=\"tooltip-label\">Attributes (${cell.a})</div>");
+        w.AppendLine("          <div class=\"tooltip-value\">${getAttributeBadges(cell.a)}</div>");
+        w.AppendLine("        </div>");
+        w.AppendLine("        <div class=\"tooltip-section\">");
+        w.AppendLine("          <div class=\"tooltip-label\">Write Order</div>");
+        w.AppendLine("          <div class=\"tooltip-value\">${seqInfo} &nbsp;|&nbsp; ${timeInfo}</div>");
+        w.AppendLine("        </div>");
+        w.AppendLine("        ${hasSixel ? `");
+        w.AppendLine("        <div class=\"tooltip-section\">");
+        w.AppendLine("          <div class=\"tooltip-label\">Sixel Graphics</div>");
+        w.AppendLine("          <div class=\"tooltip-value\">");
+        w.AppendLine("            ${cell.sixel.origin ? '<span class=\"attr-badge\" style=\"background:#4e9a06\">Origin</span>' : '<span class=\"attr-badge\">Continuation</span>'}");
+        w.AppendLine("            ${cell.sixel.w}×${cell.sixel.h} cells");
+        w.AppendLine("          </div>");
+        w.AppendLine("        </div>` : ''}");
+        w.AppendLine("        ${hasLink ? `");
+        w.AppendLine("        <div class=\"tooltip-section\">");
+        w.AppendLine("          <div class=\"tooltip-label\">Hyperlink (OSC 8)</div>");
+        w.AppendLine("          <div class=\"tooltip-value\">");
+        w.AppendLine("            <a href=\"${cell.link.uri}\" target=\"_blank\" style=\"color:#00d4ff;text-decoration:underline;word-break:break-all\">${cell.link.uri}</a>");
+        w.AppendLine("            ${cell.link.params ? `<br><span style=\"color:#888;font-size:11px\">Params: ${cell.link.params}</span>` : ''}");
+        w.AppendLine("            ${cell.link.group ? `<br><button class=\"highlight-toggle ${highlightedGroups.has(cell.link.group) ? 'active' : ''}\" onclick=\"toggleGroupHighlight('${cell.link.group}')\">👁 ${highlightedGroups.has(cell.link.group) ? 'Hide' : 'Show'} related cells</button>` : ''}");
+        w.AppendLine("          </div>");
+        w.AppendLine("        </div>` : ''}");
+        w.AppendLine("        ${isPinned ? `<span class=\"tooltip-pin-indicator\" onclick=\"unpinTooltip()\" title=\"Click to unpin\">📌</span>` : ''}");
+        w.AppendLine("      `;");
+        w.AppendLine("    }");
+        w.AppendLine();
+        w.AppendLine("    // Toggle highlight for a cell group (e.g., all cells with same hyperlink)");
+        w.AppendLine("    function toggleGroupHighlight(groupName) {");
+        w.AppendLine("      if (highlightedGroups.has(groupName)) {");
+        w.AppendLine("        highlightedGroups.delete(groupName);");
+        w.AppendLine("        // Remove highlight class from all cells in this group");
+        w.AppendLine("        svg.querySelectorAll(`g.cell.${groupName}`).forEach(g => g.classList.remove('highlight'));");
+        w.AppendLine("      } else {");
+        w.AppendLine("        highlightedGroups.add(groupName);");
+        w.AppendLine("        // Add highlight class to all cells in this group");
+        w.AppendLine("        svg.querySelectorAll(`g.cell.${groupName}`).forEach(g => g.classList.add('highlight'));");
+        w.AppendLine("      }");
+        w.AppendLine("      // Re-render tooltip to update button state");
+        w.AppendLine("      if (isPinned) {");
+        w.AppendLine("        const cell = cellData[pinnedCellY][pinnedCellX];");
+        w.AppendLine("        tooltip.innerHTML = renderTooltip(cell, pinnedCellX, pinnedCellY);");
+        w.AppendLine("      }");
+        w.AppendLine("    }");
+        w.AppendLine("    // Make function available globally for onclick");
+        w.AppendLine("    window.toggleGroupHighlight = toggleGroupHighlight;");
+        w.AppendLine();
+        w.AppendLine("    // Pin the tooltip in place");
+        w.AppendLine("    function pinTooltip(x, y) {");
+        w.AppendLine("      isPinned = true;");
+        w.AppendLine("      pinnedCellX = x;");
+        w.AppendLine("      pinnedCellY = y;");
+        w.AppendLine("      tooltip.classList.add('pinned');");
+        w.AppendLine("      // Re-render to show pin indicator");
+        w.AppendLine("      const cell = cellData[y][x];");
+        w.AppendLine("      tooltip.innerHTML = renderTooltip(cell, x, y);");
+        w.AppendLine("    }");
+        w.AppendLine();
+        w.AppendLine("    // Unpin the tooltip");
+        w.AppendLine("    function unpinTooltip() {");
+        w.AppendLine("      isPinned = false;");
+        w.AppendLine("      pinnedCellX = -1;");
+        w.AppendLine("      pinnedCellY = -1;");
+        w.AppendLine("      tooltip.classList.remove('pinned');");
+        w.AppendLine("      tooltip.classList.remove('visible');");
+        w.AppendLine("      highlight.classList.remove('visible');");
+        w.AppendLine("    }");
+        w.AppendLine("    // Make function available globally for onclick");
+        w.AppendLine("    window.unpinTooltip = unpinTooltip;");
+        w.AppendLine();
+        w.AppendLine("    container.addEventListener('mousemove', (e) => {");
+        w.AppendLine("      // If tooltip is pinned, don't update on hover");
+        w.AppendLine("      if (isPinned) return;");
+        w.AppendLine();
+        w.AppendLine("      const svgRect = svg.getBoundingClientRect();");
+        w.AppendLine("      const scaleX = svgRect.width / SVG_WIDTH;");
+        w.AppendLine("      const scaleY = svgRect.height / SVG_HEIGHT;");
+        w.AppendLine("      const cellWidth = BASE_CELL_WIDTH * scaleX;");
+        w.AppendLine("      const cellHeight = BASE_CELL_HEIGHT * scaleY;");
+        w.AppendLine("      const x = Math.floor((e.clientX - svgRect.left) / cellWidth);");
+        w.AppendLine("      const y = Math.floor((e.clientY - svgRect.top) / cellHeight);");
+        w.AppendLine();
+        w.AppendLine("      if (x >= 0 && x < COLS && y >= 0 && y < ROWS) {");
+        w.AppendLine("        const cell = cellData[y][x];");
+        w.AppendLine();
+        w.AppendLine("        // Check if we moved to a new cell");
+        w.AppendLine("        const cellChanged = (x !== currentCellX || y !== currentCellY);");
+        w.AppendLine("        currentCellX = x;");
+        w.AppendLine("        currentCellY = y;");
+        w.AppendLine();
+        w.AppendLine("        // Position highlight relative to SVG");
+        w.AppendLine("        const svgOffset = svg.getBoundingClientRect();");
+        w.AppendLine("        const containerOffset = container.getBoundingClientRect();");
+        w.AppendLine("        highlight.style.left = (svgOffset.left - containerOffset.left + x * cellWidth) + 'px';");
+        w.AppendLine("        highlight.style.top = (svgOffset.top - containerOffset.top + y * cellHeight) + 'px';");
+        w.AppendLine("        highlight.style.width = cellWidth + 'px';");
+        w.AppendLine("        highlight.style.height = cellHeight + 'px';");
+        w.AppendLine("        highlight.classList.add('visible');");
+        w.AppendLine();
+        w.AppendLine("        // Shimmer effect when moving to a new cell");
+        w.AppendLine("        if (cellChanged) {");
+        w.AppendLine("          highlight.classList.add('shimmer');");
+        w.AppendLine("          setTimeout(() => highlight.classList.remove('shimmer'), 200);");
+        w.AppendLine("        }");
+        w.AppendLine();
+        w.AppendLine("        // Update and position tooltip");
+        w.AppendLine("        tooltip.innerHTML = renderTooltip(cell, x, y);");
+        w.AppendLine("        tooltip.classList.add('visible');");
+        w.AppendLine();
+        w.AppendLine("        // Position tooltip to avoid viewport edges");
+        w.AppendLine("        let tooltipX = e.clientX + 15;");
+        w.AppendLine("        let tooltipY = e.clientY + 15;");
+        w.AppendLine("        const tooltipRect = tooltip.getBoundingClientRect();");
+        w.AppendLine("        if (tooltipX + tooltipRect.width > window.innerWidth - 10) {");
+        w.AppendLine("          tooltipX = e.clientX - tooltipRect.width - 15;");
+        w.AppendLine("        }");
+        w.AppendLine("        if (tooltipY + tooltipRect.height > window.innerHeight - 10) {");
+        w.AppendLine("          tooltipY = e.clientY - tooltipRect.height - 15;");
+        w.AppendLine("        }");
+        w.AppendLine("        tooltip.style.left = tooltipX + 'px';");
+        w.AppendLine("        tooltip.style.top = tooltipY + 'px';");
+        w.AppendLine("      } else {");
+        w.AppendLine("        highlight.classList.remove('visible');");
+        w.AppendLine("        tooltip.classList.remove('visible');");
+        w.AppendLine("        currentCellX = -1;");
+        w.AppendLine("        currentCellY = -1;");
+        w.AppendLine("      }");
+        w.AppendLine("    });");
+        w.AppendLine();
+        w.AppendLine("    // Click to pin tooltip");
+        w.AppendLine("    container.addEventListener('click', (e) => {");
+        w.AppendLine("      const svgRect = svg.getBoundingClientRect();");
+        w.AppendLine("      const scaleX = svgRect.width / SVG_WIDTH;");
+        w.AppendLine("      const scaleY = svgRect.height / SVG_HEIGHT;");
+        w.AppendLine("      const cellWidth = BASE_CELL_WIDTH * scaleX;");
+        w.AppendLine("      const cellHeight = BASE_CELL_HEIGHT * scaleY;");
+        w.AppendLine("      const x = Math.floor((e.clientX - svgRect.left) / cellWidth);");
+        w.AppendLine("      const y = Math.floor((e.clientY - svgRect.top) / cellHeight);");
+        w.AppendLine();
+        w.AppendLine("      if (x >= 0 && x < COLS && y >= 0 && y < ROWS) {");
+        w.AppendLine("        if (isPinned && pinnedCellX === x && pinnedCellY === y) {");
+        w.AppendLine("          // Clicking pinned cell again unpins");
+        w.AppendLine("          unpinTooltip();");
+        w.AppendLine("        } else {");
+        w.AppendLine("          // Pin to this cell");
+        w.AppendLine("          pinTooltip(x, y);");
+        w.AppendLine("        }");
+        w.AppendLine("      }");
+        w.AppendLine("    });");
+        w.AppendLine();
+        w.AppendLine("    container.addEventListener('mouseleave', () => {");
+        w.AppendLine("      // Only hide if not pinned");
+        w.AppendLine("      if (!isPinned) {");
+        w.AppendLine("        highlight.classList.remove('visible');");
+        w.AppendLine("        tooltip.classList.remove('visible');");
+        w.AppendLine("      }");
+        w.AppendLine("    });");
+        w.AppendLine();
+        w.AppendLine("    // Theme controls");
+        w.AppendLine("    const bgPicker = document.getElementById('bg-picker');");
+        w.AppendLine("    const fgPicker = document.getElementById('fg-picker');");
+        w.AppendLine("    const btnDark = document.getElementById('btn-dark');");
+        w.AppendLine("    const btnLight = document.getElementById('btn-light');");
+        w.AppendLine("    const cellGridToggle = document.getElementById('cell-grid-toggle');");
+        w.AppendLine("    const pixelGridToggle = document.getElementById('pixel-grid-toggle');");
+        w.AppendLine("    const cellGridColorPicker = document.getElementById('cell-grid-color');");
+        w.AppendLine("    const pixelGridColorPicker = document.getElementById('pixel-grid-color');");
+        w.AppendLine();
+        w.AppendLine("    let currentDefaultBg = '#1e1e1e';");
+        w.AppendLine("    let currentDefaultFg = '#d4d4d4';");
+        w.AppendLine("    let cellGridCustomColor = false;");
+        w.AppendLine("    let pixelGridCustomColor = false;");
+        w.AppendLine();
+        w.AppendLine("    // Compute contrasting color for grids based on background luminance");
+        w.AppendLine("    function getContrastingGridColor(bgColor, alpha) {");
+        w.AppendLine("      const hex = bgColor.replace('#', '');");
+        w.AppendLine("      const r = parseInt(hex.substr(0, 2), 16);");
+        w.AppendLine("      const g = parseInt(hex.substr(2, 2), 16);");
+        w.AppendLine("      const b = parseInt(hex.substr(4, 2), 16);");
+        w.AppendLine("      const luminance = (0.299 * r + 0.587 * g + 0.114 * b) / 255;");
+        w.AppendLine("      const base = luminance > 0.5 ? 0 : 255;");
+        w.AppendLine("      const adjusted = Math.round(base * alpha + (luminance > 0.5 ? 255 : 0) * (1 - alpha));");
+        w.AppendLine("      const hex2 = adjusted.toString(16).padStart(2, '0');");
+        w.AppendLine("      return `#${hex2}${hex2}${hex2}`;");
+        w.AppendLine("    }");
+        w.AppendLine();
+        w.AppendLine("    function updateGridColors(bgColor) {");
+        w.AppendLine("      if (!cellGridCustomColor) {");
+        w.AppendLine("        const cellColor = getContrastingGridColor(bgColor, 0.5);");
+        w.AppendLine("        cellGridColorPicker.value = cellColor;");
+        w.AppendLine("        svg.querySelectorAll('.cell-grid line').forEach(el => el.setAttribute('stroke', cellColor));");
+        w.AppendLine("      }");
+        w.AppendLine("      if (!pixelGridCustomColor) {");
+        w.AppendLine("        const pixelColor = getContrastingGridColor(bgColor, 0.25);");
+        w.AppendLine("        pixelGridColorPicker.value = pixelColor;");
+        w.AppendLine("        svg.querySelectorAll('.pixel-grid line').forEach(el => el.setAttribute('stroke', pixelColor));");
+        w.AppendLine("      }");
+        w.AppendLine("    }");
+        w.AppendLine();
+        w.AppendLine("    const themeStyle = document.createElementNS('http://www.w3.org/2000/svg', 'style');");
+        w.AppendLine("    svg.appendChild(themeStyle);");
+        w.AppendLine();
+        w.AppendLine("    function updateTheme(newBg, newFg) {");
+        w.AppendLine("      // Update the main background rect (first rect in SVG)");
+        w.AppendLine("      const bgRect = svg.querySelector('rect');");
+        w.AppendLine("      if (bgRect) bgRect.setAttribute('fill', newBg);");
+        w.AppendLine();
+        w.AppendLine("      // Cells drawn in the default colors share the .fg and .bg classes");
+        w.AppendLine("      themeStyle.textContent = `.fg { fill: ${newFg}; } .bg { fill: ${newBg}; }`;");
+        w.AppendLine();
+        w.AppendLine("      currentDefaultBg = newBg;");
+        w.AppendLine("      currentDefaultFg = newFg;");
+        w.AppendLine("      bgPicker.value = newBg;");
+        w.AppendLine("      fgPicker.value = newFg;");
+        w.AppendLine();
+        w.AppendLine("      // Update grid colors based on new background");
+        w.AppendLine("      updateGridColors(newBg);");
+        w.AppendLine("    }");
+        w.AppendLine();
+        w.AppendLine("    bgPicker.addEventListener('input', (e) => {");
+        w.AppendLine("      updateTheme(e.target.value, currentDefaultFg);");
+        w.AppendLine("      btnDark.classList.remove('active');");
+        w.AppendLine("      btnLight.classList.remove('active');");
+        w.AppendLine("    });");
+        w.AppendLine();
+        w.AppendLine("    fgPicker.addEventListener('input', (e) => {");
+        w.AppendLine("      updateTheme(currentDefaultBg, e.target.value);");
+        w.AppendLine("      btnDark.classList.remove('active');");
+        w.AppendLine("      btnLight.classList.remove('active');");
+        w.AppendLine("    });");
+        w.AppendLine();
+        w.AppendLine("    btnDark.addEventListener('click', () => {");
+        w.AppendLine("      updateTheme('#1e1e1e', '#d4d4d4');");
+        w.AppendLine("      btnDark.classList.add('active');");
+        w.AppendLine("      btnLight.classList.remove('active');");
+        w.AppendLine("    });");
+        w.AppendLine();
+        w.AppendLine("    btnLight.addEventListener('click', () => {");
+        w.AppendLine("      updateTheme('#ffffff', '#1e1e1e');");
+        w.AppendLine("      btnLight.classList.add('active');");
+        w.AppendLine("      btnDark.classList.remove('active');");
+        w.AppendLine("    });");
+        w.AppendLine();
+        w.AppendLine("    // Grid toggle and color controls");
+        w.AppendLine("    cellGridToggle.addEventListener('change', (e) => {");
+        w.AppendLine("      container.classList.toggle('show-cell-grid', e.target.checked);");
+        w.AppendLine("    });");
+        w.AppendLine();
+        w.AppendLine("    pixelGridToggle.addEventListener('change', (e) => {");
+        w.AppendLine("      container.classList.toggle('show-pixel-grid', e.target.checked);");
+        w.AppendLine("    });");
+        w.AppendLine();
+        w.AppendLine("    cellGridColorPicker.addEventListener('input', (e) => {");
+        w.AppendLine("      cellGridCustomColor = true;");
+        w.AppendLine("      svg.querySelectorAll('.cell-grid line').forEach(el => el.setAttribute('stroke', e.target.value));");
+        w.AppendLine("    });");
+        w.AppendLine();
+        w.AppendLine("    pixelGridColorPicker.addEventListener('input', (e) => {");
+        w.AppendLine("      pixelGridCustomColor = true;");
+        w.AppendLine("      svg.querySelectorAll('.pixel-grid line').forEach(el => el.setAttribute('stroke', e.target.value));");
+        w.AppendLine("    });");
+        w.AppendLine();
+        w.AppendLine("    // Initialize grid colors based on default background");
+        w.AppendLine("    updateGridColors(currentDefaultBg);");
+        w.AppendLine("  </script>");
+        w.AppendLine("</body>");
+        w.AppendLine("</html>");
     }
 
-    private static string BuildCellDataJson(IHex1bTerminalRegion region, Dictionary<object, string> hyperlinkGroups)
+    private static void WriteCellDataJson(TerminalMarkupWriter w, IHex1bTerminalRegion region, TerminalSvgRenderer svgRenderer)
     {
-        var rows = new List<string>();
-
+        w.Append("[\n      ");
         for (int y = 0; y < region.Height; y++)
         {
-            var cells = new List<string>();
+            if (y > 0)
+                w.Append(",\n      ");
+
+            w.Append('[');
             for (int x = 0; x < region.Width; x++)
             {
+                if (x > 0)
+                    w.Append(',');
+
                 var cell = region.GetCell(x, y);
                 var ch = cell.Character ?? "";
-                
+
                 // Normalize unwritten-cell marker (U+E000, private use,
                 // emitted by Surface for never-painted cells) to empty so it
                 // doesn't surface in the JSON cell-data dump.
                 if (ch == "\uE000")
                     ch = "";
 
-                // Escape special JSON characters in the grapheme string
-                var escapedChar = EscapeJsonString(ch);
-
-                var fg = cell.Foreground.HasValue
-                    ? $"{{\"r\":{cell.Foreground.Value.R},\"g\":{cell.Foreground.Value.G},\"b\":{cell.Foreground.Value.B}}}"
-                    : "null";
-
-                var bg = cell.Background.HasValue
-                    ? $"{{\"r\":{cell.Background.Value.R},\"g\":{cell.Background.Value.G},\"b\":{cell.Background.Value.B}}}"
-                    : "null";
-
-                var attrs = (int)cell.Attributes;
-                var seq = cell.Sequence;
-                var writtenAt = cell.WrittenAt != default 
-                    ? $"\"{cell.WrittenAt:O}\"" 
-                    : "null";
+                w.Append("{\"c\":\"");
+                WriteJsonString(w, ch);
+                w.Append("\",\"fg\":");
+                WriteJsonColor(w, cell.Foreground);
+                w.Append(",\"bg\":");
+                WriteJsonColor(w, cell.Background);
+                w.Append(",\"uc\":");
+                WriteJsonColor(w, cell.UnderlineColor);
+                w.Append($",\"us\":{(int)cell.UnderlineStyle},\"a\":{(int)cell.Attributes},\"seq\":{cell.Sequence},\"t\":");
+                if (cell.WrittenAt != default)
+                    w.Append($"\"{cell.WrittenAt:O}\"");
+                else
+                    w.Append("null");
 
                 // Include sixel data if present
-                var sixel = cell.SixelData != null
-                    ? $"{{\"origin\":{(cell.IsSixel ? "true" : "false")},\"w\":{cell.SixelData.WidthInCells},\"h\":{cell.SixelData.HeightInCells}}}"
-                    : "null";
+                w.Append(",\"sixel\":");
+                if (cell.SixelData != null)
+                    w.Append($"{{\"origin\":{(cell.IsSixel ? "true" : "false")},\"w\":{cell.SixelData.WidthInCells},\"h\":{cell.SixelData.HeightInCells}}}");
+                else
+                    w.Append("null");
 
                 // Include hyperlink data if present (with group ID for highlighting related cells)
-                string hyperlink;
+                w.Append(",\"link\":");
                 if (cell.TrackedHyperlink is { } trackedLink && cell.HyperlinkData != null)
                 {
-                    var groupName = hyperlinkGroups.TryGetValue(trackedLink, out var g) ? g : "";
-                    hyperlink = $"{{\"uri\":\"{EscapeJsonString(cell.HyperlinkData.Uri)}\",\"params\":\"{EscapeJsonString(cell.HyperlinkData.Parameters)}\",\"group\":\"{groupName}\"}}";
+                    w.Append("{\"uri\":\"");
+                    WriteJsonString(w, cell.HyperlinkData.Uri);
+                    w.Append("\",\"params\":\"");
+                    WriteJsonString(w, cell.HyperlinkData.Parameters);
+                    w.Append($"\",\"group\":\"{svgRenderer.GetLinkGroup(trackedLink)}\"}}");
                 }
                 else
                 {
-                    hyperlink = "null";
+                    w.Append("null");
                 }
 
-                var uc = cell.UnderlineColor.HasValue
-                    ? $"{{\"r\":{cell.UnderlineColor.Value.R},\"g\":{cell.UnderlineColor.Value.G},\"b\":{cell.UnderlineColor.Value.B}}}"
-                    : "null";
-
-                var us = (int)cell.UnderlineStyle;
-
-                cells.Add($"{{\"c\":\"{escapedChar}\",\"fg\":{fg},\"bg\":{bg},\"uc\":{uc},\"us\":{us},\"a\":{attrs},\"seq\":{seq},\"t\":{writtenAt},\"sixel\":{sixel},\"link\":{hyperlink}}}");
+                w.Append('}');
             }
-            rows.Add($"[{string.Join(",", cells)}]");
+            w.Append(']');
         }
+        w.Append("\n    ]");
+    }
 
-        return $"[\n      {string.Join(",\n      ", rows)}\n    ]";
+    private static void WriteJsonColor(TerminalMarkupWriter w, Hex1bColor? color)
+    {
+        if (color is { } c)
+            w.Append($"{{\"r\":{c.R},\"g\":{c.G},\"b\":{c.B}}}");
+        else
+            w.Append("null");
     }
 
     /// <summary>
-    /// Escapes a string for JSON encoding.
+    /// Writes a string with JSON special characters escaped.
     /// </summary>
-    private static string EscapeJsonString(string s)
+    private static void WriteJsonString(TerminalMarkupWriter w, string? s)
     {
         if (string.IsNullOrEmpty(s))
-            return "";
+            return;
 
-        var sb = new System.Text.StringBuilder();
         foreach (var ch in s)
         {
-            sb.Append(ch switch
+            switch (ch)
             {
-                '"' => "\\\"",
-                '\\' => "\\\\",
-                '\n' => "\\n",
-                '\r' => "\\r",
-                '\t' => "\\t",
-                '\0' => "\\u0000",
-                < ' ' => $"\\u{(int)ch:x4}",
-                _ => ch.ToString()
-            });
+                case '"': w.Append("\\\""); break;
+                case '\\': w.Append("\\\\"); break;
+                case '\n': w.Append("\\n"); break;
+                case '\r': w.Append("\\r"); break;
+                case '\t': w.Append("\\t"); break;
+                case '\0': w.Append("\\u0000"); break;
+                case < ' ': w.Append($"\\u{(int)ch:x4}"); break;
+                default: w.Append(ch); break;
+            }
         }
-        return sb.ToString();
     }
 }
@@ -0,0 +1,278 @@
+using System.Text;
+using Hex1b.Theming;
+
+namespace Hex1b.Automation;
+
+/// <summary>
+/// A run of adjacent cells on one row that share attributes and colors.
+/// </summary>
+/// <param name="StartX">First column of the run.</param>
+/// <param name="Length">Number of cells in the run.</param>
+/// <param name="Attributes">Attributes shared by every cell in the run.</param>
+/// <param name="Foreground">Foreground color shared by every cell in the run.</param>
+/// <param name="Background">Background color shared by every cell in the run.</param>
+internal readonly record struct CellAttributeRun(
+    int StartX,
+    int Length,
+    CellAttributes Attributes,
+    Hex1bColor? Foreground,
+    Hex1bColor? Background);
+
+/// <summary>
+/// Text and attribute index over an immutable terminal region, shared by every search
+/// run against it.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Rows are indexed lazily and at most once: the line text (as produced by
+/// <see cref="Hex1bTerminalRegionExtensions.GetLine"/>), a map from text offsets back
+/// to cell columns, and the row's attribute runs. Joined multi-line text is cached per
+/// trim/separator combination together with its line start offsets.
+/// </para>
+/// <para>
+/// Snapshots and snapshot regions never change after creation, so they own a single
+/// index each (see <see cref="For"/>). Other regions get a fresh, unshared index.
+/// </para>
+/// <para>
+/// Concurrent searches on one snapshot are safe: every cached value is a pure function
+/// of the region, so a lost race only costs a duplicate computation.
+/// </para>
+/// </remarks>
+internal sealed class TerminalRegionTextIndex
+{
+    private readonly IHex1bTerminalRegion _region;
+    private readonly string?[] _lines;
+    private readonly int[]?[] _columnMaps; // null entry = identity map (one char per cell)
+    private readonly CellAttributeRun[]?[] _attributeRuns;
+    private readonly Dictionary<(bool TrimLines, string Separator), JoinedText> _joined = new();
+
+    /// <summary>
+    /// Creates an index over <paramref name="region"/>. The region must not change afterwards.
+    /// </summary>
+    public TerminalRegionTextIndex(IHex1bTerminalRegion region)
+    {
+        _region = region;
+        var height = Math.Max(0, region.Height);
+        _lines = new string?[height];
+        _columnMaps = new int[]?[height];
+        _attributeRuns = new CellAttributeRun[]?[height];
+    }
+
+    /// <summary>
+    /// Gets the shared index of a snapshot or snapshot region, or builds a private one
+    /// for any other region.
+    /// </summary>
+    public static TerminalRegionTextIndex For(IHex1bTerminalRegion region) => region switch
+    {
+        Hex1bTerminalSnapshot snapshot => snapshot.TextIndex,
+        Hex1bTerminalSnapshotRegion snapshotRegion => snapshotRegion.TextIndex,
+        _ => new TerminalRegionTextIndex(region)
+    };
+
+    /// <summary>
+    /// Gets the shared index for <paramref name="region"/> if it has one, otherwise null.
+    /// </summary>
+    public static TerminalRegionTextIndex? TryGetShared(IHex1bTerminalRegion region) => region switch
+    {
+        Hex1bTerminalSnapshot snapshot => snapshot.TextIndex,
+        Hex1bTerminalSnapshotRegion snapshotRegion => snapshotRegion.TextIndex,
+        _ => null
+    };
+
+    /// <summary>Number of indexed rows.</summary>
+    public int Height => _lines.Length;
+
+    /// <summary>Width of the indexed region in cells.</summary>
+    public int Width => _region.Width;
+
+    /// <summary>
+    /// Gets the text of row <paramref name="y"/>.
+    /// </summary>
+    public string GetLine(int y)
+    {
+        if (y < 0 || y >= _lines.Length)
+            return "";
+
+        return _lines[y] ?? IndexLine(y);
+    }
+
+    /// <summary>
+    /// Maps an offset into <see cref="GetLine"/>'s text back to the cell column it came from.
+    /// An offset at or past the end of the line maps to <see cref="Width"/>.
+    /// </summary>
+    public int GetColumn(int y, int offset)
+    {
+        var line = GetLine(y);
+        if (offset >= line.Length)
+            return _region.Width;
+        if (offset <= 0)
+            return 0;
+
+        var map = _columnMaps[y];
+        return map is null ? offset : map[offset];
+    }
+
+    /// <summary>
+    /// Gets the attribute runs of row <paramref name="y"/>, left to right.
+    /// </summary>
+    public ReadOnlySpan<CellAttributeRun> GetAttributeRuns(int y)
+    {
+        if (y < 0 || y >= _attributeRuns.Length)
+            return ReadOnlySpan<CellAttributeRun>.Empty;
+
+        return _attributeRuns[y] ??= BuildAttributeRuns(y);
+    }
+
+    /// <summary>
+    /// Gets every row joined into one string, plus the offset at which each row starts.
+    /// </summary>
+    /// <remarks>
+    /// <c>LineOffsets</c> has <see cref="Height"/> + 1 entries; the last is the text length.
+    /// </remarks>
+    public (string Text, int[] LineOffsets) GetJoinedText(bool trimLines, string? lineSeparator)
+    {
+        var key = (trimLines, lineSeparator ?? "");
+        lock (_joined)
+        {
+            if (_joined.TryGetValue(key, out var cached))
+                return (cached.Text, cached.LineOffsets);
+        }
+
+        var sb = new StringBuilder();
+        var lineOffsets = new int[_lines.Length + 1];
+        for (int y = 0; y < _lines.Length; y++)
+        {
+            if (y > 0 && key.Item2.Length > 0)
+                sb.Append(key.Item2);
+            lineOffsets[y] = sb.Length;
+            var line = GetLine(y);
+            sb.Append(trimLines ? line.AsSpan().TrimEnd() : line);
+        }
+        lineOffsets[_lines.Length] = sb.Length;
+
+        var joined = new JoinedText(sb.ToString(), lineOffsets);
+        lock (_joined)
+        {
+            _joined.TryAdd(key, joined);
+        }
+        return (joined.Text, joined.LineOffsets);
+    }
+
+    /// <summary>
+    /// Maps an offset into joined text back to a (row, offset within row) pair.
+    /// Offsets inside a separator belong to the row before it.
+    /// </summary>
+    public static (int Line, int Column) OffsetToLineColumn(int offset, int[] lineOffsets)
+    {
+        // Last row whose start is at or before the offset. Rows that start at the same
+        // offset (empty rows with no separator) resolve to the last of them.
+        int lo = 0;
+        int hi = lineOffsets.Length - 2;
+        while (lo < hi)
+        {
+            int mid = (lo + hi + 1) >> 1;
+            if (lineOffsets[mid] <= offset)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+
+        return (lo, offset - lineOffsets[lo]);
+    }
+
+    /// <summary>
+    /// Builds the text of row <paramref name="y"/> of <paramref name="region"/>.
+    /// </summary>
+    /// <param name="region">The region to read.</param>
+    /// <param name="y">The row.</param>
+    /// <param name="columns">If non-null, receives the cell column of every appended char.</param>
+    internal static string BuildLine(IHex1bTerminalRegion region, int y, List<int>? columns)
+    {
+        var sb = new StringBuilder(region.Width);
+        for (int x = 0; x < region.Width; x++)
+        {
+            var cell = region.GetCell(x, y);
+            var ch = cell.Character;
+            var before = sb.Length;
+
+            // Preserve the width of ordinary empty/unwritten cells as spaces so
+            // text snapshots keep their terminal geometry stable across platforms.
+            // But continuation cells for wide characters are zero-width in the
+            // textual view and should not show up as visible spaces.
+            if (string.IsNullOrEmpty(ch))
+            {
+                if (!IsWideCharContinuation(region, x, y))
+                    sb.Append(' ');
+            }
+            else if (ch == "\uE000" || ch == "\0")
+            {
+                sb.Append(' ');
+            }
+            else
+            {
+                sb.Append(ch);
+            }
+
+            if (columns is not null)
+            {
+                for (int i = before; i < sb.Length; i++)
+                    columns.Add(x);
+            }
+        }
+        return sb.ToString();
+    }
+
+    private static bool IsWideCharContinuation(IHex1bTerminalRegion region, int x, int y)
+    {
+        if (x <= 0)
+            return false;
+
+        var previous = region.GetCell(x - 1, y).Character;
+        return !string.IsNullOrEmpty(previous)
+            && previous != "\uE000"
+            && previous != "\0"
+            && DisplayWidth.GetGraphemeWidth(previous) > 1;
+    }
+
+    private string IndexLine(int y)
+    {
+        var columns = new List<int>(_region.Width);
+        var line = BuildLine(_region, y, columns);
+
+        var identity = columns.Count == _region.Width;
+        for (int i = 0; identity && i < columns.Count; i++)
+            identity = columns[i] == i;
+
+        // Publish the map before the line so a reader that sees the line sees its map.
+        _columnMaps[y] = identity ? null : columns.ToArray();
+        Volatile.Write(ref _lines[y], line);
+        return line;
+    }
+
+    private CellAttributeRun[] BuildAttributeRuns(int y)
+    {
+        var runs = new List<CellAttributeRun>();
+        int width = _region.Width;
+        int x = 0;
+        while (x < width)
+        {
+            var first = _region.GetCell(x, y);
+            int end = x + 1;
+            while (end < width)
+            {
+                var cell = _region.GetCell(end, y);
+                if (cell.Attributes != first.Attributes
+                    || !Hex1bTerminalRegionExtensions.ColorsEqual(cell.Foreground, first.Foreground)
+                    || !Hex1bTerminalRegionExtensions.ColorsEqual(cell.Background, first.Background))
+                    break;
+                end++;
+            }
+
+            runs.Add(new CellAttributeRun(x, end - x, first.Attributes, first.Foreground, first.Background));
+            x = end;
+        }
+        return runs.ToArray();
+    }
+
+    private sealed record JoinedText(string Text, int[] LineOffsets);
+}
@@ -0,0 +1,877 @@
+using System.Buffers;
+
+namespace Hex1b.Automation;
+
+/// <summary>
+/// Renders terminal snapshots to SVG, reusing work between successive frames.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Cells with the same style on a row are merged into one background <c>&lt;rect&gt;</c> and one
+/// <c>&lt;text&gt;</c> element, and colors are emitted once as CSS classes (<c>.c0</c>, <c>.c1</c>, ...)
+/// instead of on every element. Output is written to an <see cref="IBufferWriter{T}"/>.
+/// </para>
+/// <para>
+/// A renderer instance keeps its color classes stable and caches the markup of every row it has
+/// rendered. Snapshot rows are shared copy-on-write with the terminal, so a row the terminal hasn't
+/// written since the previous frame is copied from the cache instead of being rendered again.
+/// </para>
+/// <para>
+/// Live viewers can call <see cref="TryRenderDelta"/> after a full <see cref="Render(Hex1bTerminalSnapshot, IBufferWriter{char})"/>
+/// to get only the rows that changed. A delta is a <c>&lt;g class="terminal-delta"&gt;</c> element containing:
+/// a <c>&lt;style&gt;</c> with any new color classes (append it to the document), replacement
+/// <c>&lt;g data-row="y"&gt;</c> elements under <c>g.terminal-bg</c> and <c>g.terminal-text</c>
+/// (swap each for the element with the same <c>data-row</c> in the same layer), the
+/// <c>g.terminal-images</c> layer when images are present, and the <c>rect.cursor</c>.
+/// </para>
+/// <para>
+/// A renderer is not thread-safe, and <see cref="Options"/> should not be changed after it is created.
+/// </para>
+/// </remarks>
+/// <example>
+/// <code>
+/// var renderer = new TerminalSvgRenderer();
+/// var buffer = new ArrayBufferWriter&lt;char&gt;();
+///
+/// renderer.Render(terminal.CreateSnapshot(), buffer);        // full document
+/// buffer.Clear();
+/// if (!renderer.TryRenderDelta(terminal.CreateSnapshot(), buffer))
+///     renderer.Render(terminal.CreateSnapshot(), buffer);    // size changed: start over
+/// </code>
+/// </example>
+public sealed class TerminalSvgRenderer
+{
+    // Attributes that change how text is drawn; Reverse is folded into the fill color
+    private const CellAttributes TextAttributes = CellAttributes.Bold | CellAttributes.Dim | CellAttributes.Italic
+        | CellAttributes.Underline | CellAttributes.Blink | CellAttributes.Strikethrough | CellAttributes.Overline;
+
+    // Color classes and hyperlink groups are never renumbered while rows are cached; once
+    // either table grows past this the next full render starts over
+    private const int MaxTableEntries = 4096;
+
+    private readonly TerminalSvgOptions _options;
+    private readonly bool _cacheRows;
+    private readonly Dictionary<int, string> _colorClasses = new();
+    private readonly List<string> _colorRules = new();
+    private readonly Dictionary<object, string> _linkGroups = new();
+    private readonly ArrayBufferWriter<char> _rowScratch = new();
+    private RowFragment[] _rows = [];
+    private int _width = -1;
+    private int _height = -1;
+    private int _scrollbackLineCount;
+    private int _publishedColorRules;
+    private bool _hasImages;
+    private long _generation = -1;
+
+    /// <summary>
+    /// Creates a renderer.
+    /// </summary>
+    /// <param name="options">Rendering options, or null for <see cref="TerminalRegionSvgExtensions.DefaultOptions"/>.</param>
+    public TerminalSvgRenderer(TerminalSvgOptions? options = null)
+        : this(options ?? TerminalRegionSvgExtensions.DefaultOptions, cacheRows: true)
+    {
+    }
+
+    internal TerminalSvgRenderer(TerminalSvgOptions options, bool cacheRows)
+    {
+        _options = options;
+        _cacheRows = cacheRows;
+    }
+
+    /// <summary>
+    /// The options this renderer was created with.
+    /// </summary>
+    public TerminalSvgOptions Options => _options;
+
+    /// <summary>
+    /// The <see cref="Hex1bTerminalSnapshot.Generation"/> of the last snapshot rendered, or -1 if
+    /// there is no frame a delta can be based on.
+    /// </summary>
+    public long Generation => _generation;
+
+    /// <summary>
+    /// Writes a complete SVG document for the snapshot, including the cursor.
+    /// </summary>
+    /// <param name="snapshot">The snapshot to render.</param>
+    /// <param name="writer">The destination.</param>
+    public void Render(Hex1bTerminalSnapshot snapshot, IBufferWriter<char> writer)
+    {
+        ArgumentNullException.ThrowIfNull(snapshot);
+        Render(snapshot, writer, snapshot.CursorX, snapshot.CursorY, snapshot.ScrollbackLineCount);
+    }
+
+    /// <summary>
+    /// Writes a complete SVG document for the region.
+    /// </summary>
+    /// <param name="region">The region to render.</param>
+    /// <param name="writer">The destination.</param>
+    public void Render(IHex1bTerminalRegion region, IBufferWriter<char> writer)
+    {
+        ArgumentNullException.ThrowIfNull(region);
+        Render(region, writer, cursorX: null, cursorY: null, scrollbackLineCount: 0);
+    }
+
+    /// <summary>
+    /// Writes only what changed since the last rendered snapshot.
+    /// </summary>
+    /// <param name="snapshot">The snapshot to render.</param>
+    /// <param name="writer">The destination.</param>
+    /// <returns>
+    /// False, with nothing written, when there is no previous frame or its size or scrollback
+    /// differ; call <see cref="Render(Hex1bTerminalSnapshot, IBufferWriter{char})"/> instead.
+    /// </returns>
+    public bool TryRenderDelta(Hex1bTerminalSnapshot snapshot, IBufferWriter<char> writer)
+    {
+        ArgumentNullException.ThrowIfNull(snapshot);
+        ArgumentNullException.ThrowIfNull(writer);
+
+        if (!_cacheRows || _generation < 0
+            || snapshot.Width != _width || snapshot.Height != _height
+            || snapshot.ScrollbackLineCount != _scrollbackLineCount)
+            return false;
+
+        using var body = new PooledCharBufferWriter();
+        var b = new TerminalMarkupWriter(body);
+
+        b.AppendLine("  <g class=\"terminal-bg\">");
+        var changed = new List<RowFragment>();
+        for (int y = 0; y < _height; y++)
+        {
+            var key = snapshot.GetSharedRow(y);
+            if (key is not null && ReferenceEquals(_rows[y].Key, key))
+                continue;
+
+            var fragment = RenderRow(snapshot, y, key);
+            changed.Add(fragment);
+            b.Append(fragment.Background);
+        }
+        b.AppendLine("  </g>");
+
+        b.AppendLine("  <g class=\"terminal-text\" xml:space=\"preserve\">");
+        foreach (var fragment in changed)
+            b.Append(fragment.Text);
+        b.AppendLine("  </g>");
+
+        var hasImages = HasImages(snapshot);
+        if (hasImages || _hasImages)
+            WriteImages(b, snapshot);
+
+        WriteCursor(b, snapshot.CursorX, snapshot.CursorY, snapshot.Width, snapshot.Height, hideOutside: true);
+
+        var w = new TerminalMarkupWriter(writer);
+        w.AppendLine($"<g class=\"terminal-delta\" data-generation=\"{snapshot.Generation}\" data-base=\"{_generation}\">");
+        if (_publishedColorRules < _colorRules.Count)
+        {
+            w.Append("  <style>");
+            for (int i = _publishedColorRules; i < _colorRules.Count; i++)
+                w.Append(_colorRules[i]);
+            w.AppendLine("</style>");
+            _publishedColorRules = _colorRules.Count;
+        }
+        w.Append(body.WrittenSpan);
+        w.AppendLine("</g>");
+
+        _generation = snapshot.Generation;
+        _hasImages = hasImages;
+        return true;
+    }
+
+    internal void Render(IHex1bTerminalRegion region, IBufferWriter<char> writer, int? cursorX, int? cursorY, int scrollbackLineCount)
+    {
+        ArgumentNullException.ThrowIfNull(writer);
+
+        var snapshot = region as Hex1bTerminalSnapshot;
+        if (_colorRules.Count > MaxTableEntries || _linkGroups.Count > MaxTableEntries)
+            ResetTables();
+        if (region.Width != _width || region.Height != _height)
+        {
+            _width = region.Width;
+            _height = region.Height;
+            _rows = new RowFragment[_height];
+        }
+
+        var cellWidth = _options.CellWidth;
+        var cellHeight = _options.CellHeight;
+        var width = region.Width * cellWidth;
+        var height = region.Height * cellHeight;
+
+        // The rows are rendered first so the color table is complete before the <style> is written
+        using var body = new PooledCharBufferWriter();
+        var b = new TerminalMarkupWriter(body);
+
+        // PASS 1: Backgrounds (bottom layer)
+        b.AppendLine("  <g class=\"terminal-bg\">");
+        for (int y = 0; y < region.Height; y++)
+        {
+            if (GetCachedRow(snapshot, y) is { } fragment)
+                b.Append(fragment.Background);
+            else
+                WriteBackgroundRow(b, region, y);
+        }
+        b.AppendLine("  </g>");
+
+        // PASS 2: Images (middle layer - between backgrounds and text)
+        WriteImages(b, region);
+
+        // PASS 3: Text content with decorations (top layer)
+        b.AppendLine("  <g class=\"terminal-text\" xml:space=\"preserve\">");
+        for (int y = 0; y < region.Height; y++)
+        {
+            if (GetCachedRow(snapshot, y) is { } fragment)
+                b.Append(fragment.Text);
+            else
+                WriteTextRow(b, region, y);
+        }
+        b.AppendLine("  </g>");
+
+        var w = new TerminalMarkupWriter(writer);
+
+        // SVG header
+        w.AppendLine($"""<svg xmlns="http://www.w3.org/2000/svg" width="{width}" height="{height}" viewBox="0 0 {width} {height}">""");
+
+        // Style definitions including blink animation, cell group highlighting and the color table
+        w.AppendLine("  <defs>");
+        w.AppendLine("    <style>");
+        w.AppendLine($"      .terminal-text {{ font-family: {_options.FontFamily}; font-size: {_options.FontSize}px; }}");
+        w.AppendLine($"      .cursor {{ fill: {_options.CursorColor}; opacity: 0.7; }}");
+        w.AppendLine("      @keyframes blink { 0%, 49% { opacity: 1; } 50%, 100% { opacity: 0.3; } }");
+        w.AppendLine("      .blink { animation: blink 1s infinite; }");
+        w.AppendLine($"      .cell-grid {{ stroke: {_options.CellGridColor}; stroke-width: 0.5; vector-effect: non-scaling-stroke; }}");
+        w.AppendLine($"      .pixel-grid {{ stroke: {_options.PixelGridColor}; stroke-width: 0.25; vector-effect: non-scaling-stroke; }}");
+        w.AppendLine("      /* Cell group highlighting for related cells (hyperlinks, etc.) */");
+        w.AppendLine("      .cell { pointer-events: bounding-box; }");
+        w.AppendLine("      .cell.highlight > rect.cell-bg { stroke: #ff6b6b; stroke-width: 2; }");
+        w.AppendLine("      .cell.highlight > text { fill: #ff6b6b !important; }");
+        w.AppendLine("      /* Text attributes and colors shared by merged runs of cells */");
+        w.AppendLine("      text.b { font-weight: bold; }");
+        w.AppendLine("      text.d { opacity: 0.5; }");
+        w.AppendLine("      text.i { font-style: italic; }");
+        w.AppendLine("      text.s { text-decoration: line-through; }");
+        w.AppendLine("      text.o { text-decoration: overline; }");
+        w.AppendLine("      text.s.o { text-decoration: line-through overline; }");
+        w.AppendLine($"      .fg {{ fill: {_options.DefaultForeground}; }}");
+        w.AppendLine($"      .bg {{ fill: {_options.DefaultBackground}; }}");
+        foreach (var rule in _colorRules)
+        {
+            w.Append("      ");
+            w.AppendLine(rule);
+        }
+        w.AppendLine("    </style>");
+        w.AppendLine("  </defs>");
+        _publishedColorRules = _colorRules.Count;
+
+        // Background rectangle
+        w.AppendLine($"""  <rect width="{width}" height="{height}" fill="{_options.DefaultBackground}"/>""");
+
+        w.Append(body.WrittenSpan);
+
+        WriteCursor(w, cursorX, cursorY, region.Width, region.Height, hideOutside: false);
+
+        // Render scrollback separator line (bright dotted line between scrollback and visible area)
+        if (scrollbackLineCount > 0)
+        {
+            var separatorY = scrollbackLineCount * cellHeight;
+            // Draw a glow behind the line for visibility on both light and dark backgrounds
+            w.AppendLine($"""  <line x1="0" y1="{separatorY}" x2="{width}" y2="{separatorY}" stroke="rgba(0,0,0,0.5)" stroke-width="5" stroke-dasharray="8,4" />""");
+            w.AppendLine($"""  <line x1="0" y1="{separatorY}" x2="{width}" y2="{separatorY}" stroke="#ff6b6b" stroke-width="2" stroke-dasharray="8,4" />""");
+        }
+
+        // Render pixel grid lines (shows pixel boundaries within each cell)
+        if (_options.ShowPixelGrid)
+        {
+            w.AppendLine("  <g class=\"pixel-grid\">");
+            // Vertical pixel lines - one per pixel column
+            for (int px = 1; px < width; px++)
+                w.AppendLine($"""    <line x1="{px}" y1="0" x2="{px}" y2="{height}"/>""");
+            // Horizontal pixel lines - one per pixel row
+            for (int py = 1; py < height; py++)
+                w.AppendLine($"""    <line x1="0" y1="{py}" x2="{width}" y2="{py}"/>""");
+            w.AppendLine("  </g>");
+        }
+
+        // Render cell grid lines (coarser grid, one line per cell boundary)
+        if (_options.ShowCellGrid)
+        {
+            w.AppendLine("  <g class=\"cell-grid\">");
+            // Vertical cell lines
+            for (int col = 1; col < region.Width; col++)
+            {
+                var lineX = col * cellWidth;
+                w.AppendLine($"""    <line x1="{lineX}" y1="0" x2="{lineX}" y2="{height}"/>""");
+            }
+            // Horizontal cell lines
+            for (int row = 1; row < region.Height; row++)
+            {
+                var lineY = row * cellHeight;
+                w.AppendLine($"""    <line x1="0" y1="{lineY}" x2="{width}" y2="{lineY}"/>""");
+            }
+            w.AppendLine("  </g>");
+        }
+
+        w.AppendLine("</svg>");
+
+        if (_cacheRows && snapshot is not null)
+        {
+            _generation = snapshot.Generation;
+            _scrollbackLineCount = snapshot.ScrollbackLineCount;
+            _hasImages = HasImages(snapshot);
+        }
+        else
+        {
+            _generation = -1;
+        }
+    }
+
+    /// <summary>
+    /// Returns the cached markup for a snapshot row, rendering and caching it if the row changed.
+    /// Returns null when rows aren't cached.
+    /// </summary>
+    private RowFragment? GetCachedRow(Hex1bTerminalSnapshot? snapshot, int y)
+    {
+        if (!_cacheRows || snapshot is null)
+            return null;
+
+        var key = snapshot.GetSharedRow(y);
+        if (key is null)
+            return null;
+
+        return ReferenceEquals(_rows[y].Key, key) ? _rows[y] : RenderRow(snapshot, y, key);
+    }
+
+    private RowFragment RenderRow(Hex1bTerminalSnapshot snapshot, int y, TerminalCell[]? key)
+    {
+        var scratch = new TerminalMarkupWriter(_rowScratch);
+
+        _rowScratch.Clear();
+        WriteBackgroundRow(scratch, snapshot, y);
+        var background = _rowScratch.WrittenSpan.ToArray();
+
+        _rowScratch.Clear();
+        WriteTextRow(scratch, snapshot, y);
+        var text = _rowScratch.WrittenSpan.ToArray();
+
+        // Rows that read fill cells have no stable identity and are rendered every time
+        var fragment = new RowFragment(key, background, text);
+        _rows[y] = fragment;
+        return fragment;
+    }
+
+    private void ResetTables()
+    {
+        _colorClasses.Clear();
+        _colorRules.Clear();
+        _linkGroups.Clear();
+        _publishedColorRules = 0;
+        Array.Clear(_rows);
+        _generation = -1;
+    }
+
+    private void WriteBackgroundRow(TerminalMarkupWriter w, IHex1bTerminalRegion region, int y)
+    {
+        var cellWidth = _options.CellWidth;
+        var cellHeight = _options.CellHeight;
+        var rectY = y * cellHeight;
+
+        w.AppendLine($"    <g data-row=\"{y}\">");
+
+        // Adjacent cells with the same fill become one rect. Cells with the default background
+        // are left out; the document background already covers them.
+        string? runFill = null;
+        int runStart = 0, runEnd = 0;
+        List<(int X, int Cells)>? blinking = null;
+
+        for (int x = 0; x < region.Width;)
+        {
+            var cell = region.GetCell(x, y);
+
+            // Continuation cells are covered by the wide character that owns them; a continuation
+            // cell whose owner was overwritten has no background of its own
+            if (cell.Character == "")
+            {
+                x++;
+                continue;
+            }
+
+            var fill = BackgroundClass(cell);
+            var cells = OwnedCells(region, x, y, cell);
+
+            if (fill != runFill || runEnd != x)
+            {
+                WriteBackgroundRun(w, runFill, runStart, runEnd, rectY);
+                runFill = fill;
+                runStart = x;
+            }
+            runEnd = x + cells;
+
+            // Blink indicator: subtle border/glow around blinking cells
+            if ((cell.Attributes & CellAttributes.Blink) != 0)
+                (blinking ??= new()).Add((x, cells));
+
+            x += cells;
+        }
+        WriteBackgroundRun(w, runFill, runStart, runEnd, rectY);
+
+        if (blinking is not null)
+        {
+            foreach (var (x, cells) in blinking)
+                w.AppendLine($"""      <rect x="{x * cellWidth}" y="{rectY}" width="{cells * cellWidth}" height="{cellHeight}" fill="none" stroke="#ffcc00" stroke-width="1" stroke-dasharray="2,2" class="blink"/>""");
+        }
+
+        w.AppendLine("    </g>");
+    }
+
+    private void WriteBackgroundRun(TerminalMarkupWriter w, string? fill, int start, int end, int rectY)
+    {
+        if (fill is null || fill == "bg" || end <= start)
+            return;
+
+        var cellWidth = _options.CellWidth;
+        w.AppendLine($"""      <rect class="cell-bg {fill}" x="{start * cellWidth}" y="{rectY}" width="{(end - start) * cellWidth}" height="{_options.CellHeight}"/>""");
+    }
+
+    private void WriteTextRow(TerminalMarkupWriter w, IHex1bTerminalRegion region, int y)
+    {
+        w.AppendLine($"    <g data-row=\"{y}\">");
+
+        for (int x = 0; x < region.Width;)
+        {
+            var cell = region.GetCell(x, y);
+            var display = DisplayText(cell);
+
+            // Skip continuation cells, hidden text, and spaces with nothing to draw
+            if (display is null || (cell.Attributes & CellAttributes.Hidden) != 0 || IsBlankSpace(cell, display))
+            {
+                x++;
+                continue;
+            }
+
+            var style = GetTextStyle(cell);
+            var expectedWidth = DisplayWidth.GetGraphemeWidth(display);
+
+            if (display.Length != 1 || expectedWidth != 1)
+            {
+                // Wide characters and multi-code-unit graphemes are drawn on their own, clipped
+                // to the cells they still own if their continuation cell was overwritten
+                var cells = OwnedCells(region, x, y, cell);
+                var clip = expectedWidth > 1 && cells < expectedWidth;
+                WriteTextRun(w, region, x, y, Math.Max(cells, 1), glyphs: 1, style, clip);
+                x += Math.Max(cells, 1);
+                continue;
+            }
+
+            // Extend the run over single-width characters with the same style. Blank spaces join
+            // a run when they match it, but trailing ones are dropped.
+            var end = x + 1;
+            var lastVisible = end;
+            while (end < region.Width)
+            {
+                var next = region.GetCell(end, y);
+                var nextDisplay = DisplayText(next);
+                if (nextDisplay is null || nextDisplay.Length != 1
+                    || (next.Attributes & CellAttributes.Hidden) != 0
+                    || DisplayWidth.GetGraphemeWidth(nextDisplay) != 1
+                    || GetTextStyle(next) != style)
+                    break;
+
+                end++;
+                if (!IsBlankSpace(next, nextDisplay))
+                    lastVisible = end;
+            }
+
+            WriteTextRun(w, region, x, y, lastVisible - x, glyphs: lastVisible - x, style, clip: false);
+            x = lastVisible;
+        }
+
+        w.AppendLine("    </g>");
+    }
+
+    private void WriteTextRun(TerminalMarkupWriter w, IHex1bTerminalRegion region, int x, int y, int cells, int glyphs, TextStyle style, bool clip)
+    {
+        var cellWidth = _options.CellWidth;
+        var cellHeight = _options.CellHeight;
+        var textX = x * cellWidth;
+        var textY = y * cellHeight + (cellHeight * 0.75); // Baseline adjustment
+        var attrs = style.Attributes;
+
+        if (clip)
+        {
+            var clipWidth = cells * cellWidth;
+            w.AppendLine($"""      <clipPath id="clip-{x}-{y}"><rect x="{textX}" y="{y * cellHeight}" width="{clipWidth}" height="{cellHeight}"/></clipPath>""");
+        }
+
+        // Wrap in cell group for interaction (hover highlight, hyperlinks)
+        w.Append("      <g class=\"cell");
+        if (style.Link is not null)
+        {
+            w.Append(' ');
+            w.Append(style.Link);
+        }
+        w.Append($"\" data-x=\"{x}\" data-y=\"{y}\"><text class=\"{style.Fill}");
+        if ((attrs & CellAttributes.Bold) != 0)
+            w.Append(" b");
+        if ((attrs & CellAttributes.Dim) != 0)
+            w.Append(" d");
+        if ((attrs & CellAttributes.Italic) != 0)
+            w.Append(" i");
+        if ((attrs & CellAttributes.Strikethrough) != 0)
+            w.Append(" s");
+        if ((attrs & CellAttributes.Overline) != 0)
+            w.Append(" o");
+        if ((attrs & CellAttributes.Blink) != 0)
+            w.Append(" blink");
+        w.Append($"\" x=\"{textX}\" y=\"{textY:F1}\"");
+
+        // Stretch the run to the cell grid so glyphs line up even if the font's advance
+        // doesn't match the cell width
+        if (glyphs > 1)
+            w.Append($" textLength=\"{glyphs * cellWidth}\" lengthAdjust=\"spacing\"");
+        if (clip)
+            w.Append($" clip-path=\"url(#clip-{x}-{y})\"");
+        w.Append('>');
+
+        // Regular spaces don't receive text-decoration in SVG/HTML, but &#160; does
+        var decorated = (attrs & (CellAttributes.Underline | CellAttributes.Strikethrough | CellAttributes.Overline)) != 0;
+        for (int i = 0; i < glyphs; i++)
+        {
+            var display = DisplayText(region.GetCell(x + i, y))!;
+            if (display == " " && decorated)
+                w.Append("&#160;");
+            else
+                w.AppendEscaped(display);
+        }
+        w.Append("</text>");
+
+        if ((attrs & CellAttributes.Underline) != 0)
+            WriteUnderline(w, style, x, x + Math.Max(glyphs, 1), y);
+
+        w.AppendLine("</g>");
+    }
+
+    private void WriteUnderline(TerminalMarkupWriter w, TextStyle style, int startX, int endX, int y)
+    {
+        var cellWidth = _options.CellWidth;
+        var cellHeight = _options.CellHeight;
+        var ulY = y * cellHeight + cellHeight * 0.9;
+        var ulX1 = (double)(startX * cellWidth);
+        var ulX2 = (double)(endX * cellWidth);
+
+        var ulColor = style.UnderlineRgb >= 0
+            ? FormatRgb(style.UnderlineRgb)
+            : style.Fill switch
+            {
+                "fg" => _options.DefaultForeground,
+                "bg" => _options.DefaultBackground,
+                _ => FormatRgb(style.FillRgb)
+            };
+
+        switch (style.UnderlineStyle)
+        {
+            case UnderlineStyle.Double:
+                // Two parallel lines, offset above and below the baseline
+                var ulY1 = ulY - 1.5;
+                var ulY2 = ulY + 1.5;
+                w.Append($"""<line x1="{ulX1:F1}" y1="{ulY1:F1}" x2="{ulX2:F1}" y2="{ulY1:F1}" stroke="{ulColor}" stroke-width="0.8"/>""");
+                w.Append($"""<line x1="{ulX1:F1}" y1="{ulY2:F1}" x2="{ulX2:F1}" y2="{ulY2:F1}" stroke="{ulColor}" stroke-width="0.8"/>""");
+                break;
+
+            case UnderlineStyle.Curly:
+                // Wavy/sine curve using SVG path with cubic beziers, one wave per cell
+                var amplitude = cellHeight * 0.08;
+                var halfW = cellWidth / 2.0;
+                w.Append($"""<path d="M {ulX1:F1} {ulY:F1}""");
+                for (var x1 = ulX1; x1 < ulX2; x1 += cellWidth)
+                {
+                    var x2 = x1 + cellWidth;
+                    w.Append($""" C {x1 + halfW * 0.5:F1} {ulY - amplitude:F1}, {x1 + halfW * 0.5:F1} {ulY - amplitude:F1}, {x1 + halfW:F1} {ulY:F1} S {x2 - halfW * 0.5:F1} {ulY + amplitude:F1}, {x2:F1} {ulY:F1}""");
+                }
+                w.Append($"""" fill="none" stroke="{ulColor}" stroke-width="1"/>"""");
+                break;
+
+            case UnderlineStyle.Dotted:
+                w.Append($"""<line x1="{ulX1:F1}" y1="{ulY:F1}" x2="{ulX2:F1}" y2="{ulY:F1}" stroke="{ulColor}" stroke-width="1" stroke-dasharray="1.5,1.5"/>""");
+                break;
+
+            case UnderlineStyle.Dashed:
+                w.Append($"""<line x1="{ulX1:F1}" y1="{ulY:F1}" x2="{ulX2:F1}" y2="{ulY:F1}" stroke="{ulColor}" stroke-width="1" stroke-dasharray="3,2"/>""");
+                break;
+
+            default: // Single
+                w.Append($"""<line x1="{ulX1:F1}" y1="{ulY:F1}" x2="{ulX2:F1}" y2="{ulY:F1}" stroke="{ulColor}" stroke-width="1"/>""");
+                break;
+        }
+    }
+
+    private void WriteCursor(TerminalMarkupWriter w, int? cursorX, int? cursorY, int columns, int rows, bool hideOutside)
+    {
+        // Render cursor if within bounds
+        if (cursorX is >= 0 && cursorX < columns && cursorY is >= 0 && cursorY < rows)
+        {
+            var cursorRectX = cursorX.Value * _options.CellWidth;
+            var cursorRectY = cursorY.Value * _options.CellHeight;
+            w.AppendLine($"""  <rect class="cursor" x="{cursorRectX}" y="{cursorRectY}" width="{_options.CellWidth}" height="{_options.CellHeight}"/>""");
+        }
+        else if (hideOutside)
+        {
+            // A delta has to replace the previous cursor even when there is none to show
+            w.AppendLine("""  <rect class="cursor" width="0" height="0"/>""");
+        }
+    }
+
+    private void WriteImages(TerminalMarkupWriter w, IHex1bTerminalRegion region)
+    {
+        var cellWidth = _options.CellWidth;
+        var cellHeight = _options.CellHeight;
+
+        // Render KGP images and Sixel graphics
+        w.AppendLine("  <g class=\"terminal-images\">");
+
+        // KGP images - sort by ZIndex so lower z-values render first (further back)
+        if (region is Hex1bTerminalSnapshot snapshot)
+        {
+            var sortedPlacements = snapshot.KgpPlacements.OrderBy(p => p.ZIndex).ToList();
+            foreach (var placement in sortedPlacements)
+            {
+                if (snapshot.KgpImages.TryGetValue(placement.ImageId, out var imageData))
+                {
+                    var imgX = placement.Column * cellWidth;
+                    var imgY = placement.Row * cellHeight;
+                    var imgWidth = (int)placement.DisplayColumns * cellWidth;
+                    var imgHeight = (int)placement.DisplayRows * cellHeight;
+
+                    var dataUri = EncodeRgbaToDataUri(
+                        imageData.Data, imageData.Width, imageData.Height, imageData.Format,
+                        placement.SourceX, placement.SourceY,
+                        placement.SourceWidth, placement.SourceHeight);
+                    if (dataUri is not null)
+                    {
+                        w.AppendLine($"""    <image x="{imgX}" y="{imgY}" width="{imgWidth}" height="{imgHeight}" href="{dataUri}" preserveAspectRatio="none" style="image-rendering: pixelated;"/>""");
+                    }
+                }
+            }
+        }
+
+        // Sixel graphics
+        // Track which sixel payloads we've already rendered to avoid duplicates
+        var renderedSixels = new HashSet<string>();
+
+        for (int y = 0; y < region.Height; y++)
+        {
+            for (int x = 0; x < region.Width; x++)
+            {
+                var cell = region.GetCell(x, y);
+                var sixelData = cell.SixelData;
+
+                // Only render from the origin cell (has IsSixel flag and actual data)
+                if (sixelData == null || !cell.IsSixel)
+                    continue;
+
+                // Skip if we've already rendered this sixel (deduplication by payload reference)
+                if (!renderedSixels.Add(sixelData.Payload))
+                    continue;
+
+                // Decode sixel to image
+                var image = SixelDecoder.Decode(sixelData.Payload, cellWidth, cellHeight);
+                if (image == null || image.Width == 0 || image.Height == 0)
+                    continue;
+
+                // Encode to BMP data URI
+                var dataUri = BmpEncoder.ToDataUri(image);
+
+                // Calculate position and size
+                var imgX = x * cellWidth;
+                var imgY = y * cellHeight;
+                var imgWidth = sixelData.WidthInCells * cellWidth;
+                var imgHeight = sixelData.HeightInCells * cellHeight;
+
+                // Add image element with pixelated rendering to prevent antialiasing
+                w.AppendLine($"""    <image x="{imgX}" y="{imgY}" width="{imgWidth}" height="{imgHeight}" href="{dataUri}" preserveAspectRatio="none" style="image-rendering: pixelated;"/>""");
+            }
+        }
+
+        w.AppendLine("  </g>");
+    }
+
+    private static bool HasImages(Hex1bTerminalSnapshot snapshot)
+        => snapshot.KgpPlacements.Count > 0 || snapshot.ContainsSixelData();
+
+    /// <summary>
+    /// Returns the text to draw for a cell, or null for a continuation cell. Null characters and
+    /// the unwritten-cell marker (U+E000, which Surface emits for cells never painted) read as spaces.
+    /// </summary>
+    private static string? DisplayText(TerminalCell cell)
+    {
+        var ch = cell.Character;
+        if (string.IsNullOrEmpty(ch))
+            return null;
+        return ch == "\0" || ch == "\uE000" ? " " : ch;
+    }
+
+    /// <summary>
+    /// A space with no foreground color or attributes draws nothing.
+    /// </summary>
+    private static bool IsBlankSpace(TerminalCell cell, string display)
+        => display == " " && !cell.Foreground.HasValue
+            && (cell.Attributes & (TextAttributes | CellAttributes.Reverse)) == 0;
+
+    /// <summary>
+    /// Counts the cells a character covers: itself plus the continuation cells written with it.
+    /// Fewer than its display width means a later write overwrote part of it.
+    /// </summary>
+    private static int OwnedCells(IHex1bTerminalRegion region, int x, int y, TerminalCell cell)
+    {
+        var ch = cell.Character;
+        if (string.IsNullOrEmpty(ch) || ch == "\0" || ch == "\uE000")
+            return 1;
+
+        var expectedWidth = DisplayWidth.GetGraphemeWidth(ch);
+        var ownedCells = 1;
+        for (int i = 1; i < expectedWidth && (x + i) < region.Width; i++)
+        {
+            var contCell = region.GetCell(x + i, y);
+            // Continuation cell should be empty string with same sequence
+            if (contCell.Character == "" && contCell.Sequence == cell.Sequence)
+                ownedCells++;
+            else
+                break;
+        }
+        return ownedCells;
+    }
+
+    private string BackgroundClass(TerminalCell cell)
+    {
+        // Reverse: use foreground as background (or default foreground)
+        if ((cell.Attributes & CellAttributes.Reverse) != 0)
+            return cell.Foreground is { } fg ? ColorClass(fg) : "fg";
+        return cell.Background is { } bg ? ColorClass(bg) : "bg";
+    }
+
+    private TextStyle GetTextStyle(TerminalCell cell)
+    {
+        // Reverse: use background as foreground (or default background)
+        var reverse = (cell.Attributes & CellAttributes.Reverse) != 0;
+        var color = reverse ? cell.Background : cell.Foreground;
+        var fill = color is { } c ? ColorClass(c) : reverse ? "bg" : "fg";
+
+        var link = cell.TrackedHyperlink is { } trackedLink ? GetLinkGroup(trackedLink) : null;
+
+        var attrs = cell.Attributes & TextAttributes;
+        var underlined = (attrs & CellAttributes.Underline) != 0;
+        return new TextStyle(
+            fill,
+            color is { } rgb ? ToRgb(rgb) : -1,
+            attrs,
+            link,
+            underlined && cell.UnderlineColor is { } uc ? ToRgb(uc) : -1,
+            !underlined ? UnderlineStyle.None
+                : cell.UnderlineStyle == UnderlineStyle.None ? UnderlineStyle.Single : cell.UnderlineStyle);
+    }
+
+    /// <summary>
+    /// Returns the class shared by every cell of a hyperlink (<c>link-0</c>, <c>link-1</c>, ...),
+    /// so related cells can be highlighted together.
+    /// </summary>
+    internal string GetLinkGroup(object trackedLink)
+    {
+        if (!_linkGroups.TryGetValue(trackedLink, out var link))
+        {
+            link = $"link-{_linkGroups.Count}";
+            _linkGroups[trackedLink] = link;
+        }
+        return link;
+    }
+
+    private string ColorClass(Hex1b.Theming.Hex1bColor color)
+    {
+        var rgb = ToRgb(color);
+        if (_colorClasses.TryGetValue(rgb, out var name))
+            return name;
+
+        name = $"c{_colorClasses.Count}";
+        _colorClasses[rgb] = name;
+        _colorRules.Add($".{name} {{ fill: {FormatRgb(rgb)}; }}");
+        return name;
+    }
+
+    private static int ToRgb(Hex1b.Theming.Hex1bColor color) => (color.R << 16) | (color.G << 8) | color.B;
+
+    private static string FormatRgb(int rgb) => $"rgb({(rgb >> 16) & 0xFF},{(rgb >> 8) & 0xFF},{rgb & 0xFF})";
+
+    internal static string? EncodeRgbaToDataUri(
+        byte[] data, uint width, uint height, KgpFormat format,
+        uint sourceX = 0, uint sourceY = 0,
+        uint sourceWidth = 0, uint sourceHeight = 0)
+    {
+        if (data.Length == 0 || width == 0 || height == 0)
+            return null;
+
+        int bytesPerPixel = format == KgpFormat.Rgb24 ? 3 : 4;
+        int fullW = (int)width;
+
+        // Apply source crop region (0 means full extent)
+        int cropX = (int)sourceX;
+        int cropY = (int)sourceY;
+        int w = sourceWidth > 0 ? (int)sourceWidth : fullW - cropX;
+        int h = sourceHeight > 0 ? (int)sourceHeight : (int)height - cropY;
+
+        // Clamp to image bounds
+        w = Math.Min(w, fullW - cropX);
+        h = Math.Min(h, (int)height - cropY);
+        if (w <= 0 || h <= 0)
+            return null;
+
+        // Create BMP with bottom-up row order
+        int rowSize = (w * 3 + 3) & ~3; // BMP rows are 4-byte aligned
+        int headerSize = 54;
+        int imageSize = rowSize * h;
+        int fileSize = headerSize + imageSize;
+        var bmp = new byte[fileSize];
+
+        // BMP header
+        bmp[0] = (byte)'B'; bmp[1] = (byte)'M';
+        BitConverter.TryWriteBytes(bmp.AsSpan(2), fileSize);
+        BitConverter.TryWriteBytes(bmp.AsSpan(10), headerSize);
+        // DIB header
+        BitConverter.TryWriteBytes(bmp.AsSpan(14), 40);
+        BitConverter.TryWriteBytes(bmp.AsSpan(18), w);
+        BitConverter.TryWriteBytes(bmp.AsSpan(22), h);
+        bmp[26] = 1; // planes
+        bmp[28] = 24; // bits per pixel (output as RGB24)
+        BitConverter.TryWriteBytes(bmp.AsSpan(34), imageSize);
+
+        // Write pixel data (BMP is bottom-up, BGR order)
+        for (int y = 0; y < h; y++)
+        {
+            int srcRow = (cropY + h - 1 - y) * fullW * bytesPerPixel;
+            int dstRow = y * rowSize;
+            for (int x = 0; x < w; x++)
+            {
+                int si = srcRow + (cropX + x) * bytesPerPixel;
+                int di = dstRow + x * 3;
+                if (si + 2 < data.Length)
+                {
+                    bmp[headerSize + di] = data[si + 2]; // B
+                    bmp[headerSize + di + 1] = data[si + 1]; // G
+                    bmp[headerSize + di + 2] = data[si]; // R
+                }
+            }
+        }
+
+        return "data:image/bmp;base64," + Convert.ToBase64String(bmp);
+    }
+
+    /// <summary>
+    /// Everything that must match for neighbouring cells to share one text element.
+    /// </summary>
+    private readonly record struct TextStyle(
+        string Fill,
+        int FillRgb,
+        CellAttributes Attributes,
+        string? Link,
+        int UnderlineRgb,
+        UnderlineStyle UnderlineStyle);
+
+    /// <summary>
+    /// Rendered markup for one row, keyed by the snapshot row it was rendered from.
+    /// </summary>
+    private readonly record struct RowFragment(TerminalCell[]? Key, char[] Background, char[] Text);
+}
@@ -34,4 +34,28 @@ public abstract record TestStep
         
         return tcs.Task.ContinueWith(_ => timer.Dispose(), CancellationToken.None);
     }
+
+    /// <summary>
+    /// Waits until the terminal's screen changes after <paramref name="sinceGeneration"/>
+    /// or <paramref name="delay"/> elapses, whichever comes first.
+    /// </summary>
+    /// <remarks>
+    /// The delay still bounds the wait so predicates that depend on state outside the
+    /// screen (or on the passage of time) keep being re-evaluated at the poll interval.
+    /// </remarks>
+    protected static async Task DelayOrScreenChangeAsync(
+        Hex1bTerminal terminal,
+        long sinceGeneration,
+        TimeProvider timeProvider,
+        TimeSpan delay,
+        CancellationToken ct)
+    {
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(ct);
+        var changed = terminal.WaitForScreenChangeAsync(sinceGeneration, cts.Token);
+        var delayed = DelayAsync(timeProvider, delay, cts.Token);
+
+        await Task.WhenAny(changed, delayed);
+        cts.Cancel();
+        ct.ThrowIfCancellationRequested();
+    }
 }
@@ -20,17 +20,31 @@ public sealed record WaitUntilStep(
         var effectiveTimeout = Timeout;
         var deadline = timeProvider.GetUtcNow() + effectiveTimeout;
 
-        while (timeProvider.GetUtcNow() < deadline)
+        // Snapshots are only retaken when the screen generation moves; between changes the
+        // predicate is re-run against the cached snapshot so closures over external state
+        // still get polled without copying the screen buffer again.
+        Hex1bTerminalSnapshot? snapshot = null;
+        try
         {
-            ct.ThrowIfCancellationRequested();
+            while (timeProvider.GetUtcNow() < deadline)
+            {
+                ct.ThrowIfCancellationRequested();
 
-            // CreateSnapshot auto-flushes pending output
-            using var snapshot = terminal.CreateSnapshot();
+                if (snapshot is null || snapshot.Generation != terminal.ScreenGeneration)
+                {
+                    snapshot?.Dispose();
+                    snapshot = terminal.CreateSnapshot();
+                }
 
-            if (Predicate(snapshot))
-                return;
+                if (Predicate(snapshot))
+                    return;
 
-            await DelayAsync(timeProvider, options.PollInterval, ct);
+                await DelayOrScreenChangeAsync(terminal, snapshot.Generation, timeProvider, options.PollInterval, ct);
+            }
+        }
+        finally
+        {
+            snapshot?.Dispose();
         }
 
         // Timeout - capture final state for diagnostics
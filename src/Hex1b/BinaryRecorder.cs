@@ -0,0 +1,417 @@
+using System.Buffers;
+using System.Text.Json;
+using Hex1b.Tokens;
+
+namespace Hex1b;
+
+/// <summary>
+/// Records terminal sessions in the compact Hex1b binary recording format.
+/// </summary>
+/// <remarks>
+/// <para>
+/// This filter captures the same events as <see cref="AsciinemaRecorder"/> but writes them
+/// as length-prefixed binary frames with varint timestamps instead of JSON lines, so output
+/// is copied as raw UTF-8 without any escaping. Events are grouped into blocks that are
+/// optionally Brotli-compressed, which makes it suitable for recording long or
+/// high-throughput sessions continuously.
+/// </para>
+/// <para>
+/// When attached to a terminal, the recorder also writes periodic keyframes with the full
+/// terminal state, so <see cref="BinaryRecordingWorkloadAdapter"/> can start playback from
+/// any point without replaying everything before it.
+/// </para>
+/// <para>
+/// Recordings convert losslessly to and from asciicast v2 with
+/// <see cref="BinaryRecordingConverter"/>.
+/// </para>
+/// </remarks>
+/// <example>
+/// <code>
+/// await using var terminal = Hex1bTerminal.CreateBuilder()
+///     .WithPtyProcess("/bin/bash")
+///     .WithBinaryRecording("session.h1rec")
+///     .Build();
+///
+/// await terminal.RunAsync();
+/// </code>
+/// </example>
+public sealed class BinaryRecorder : ITerminalAwareWorkloadFilter, IAsyncDisposable, IDisposable
+{
+    private readonly string _filePath;
+    private readonly BinaryRecorderOptions _options;
+    private readonly object _lock = new();
+    private readonly SemaphoreSlim _writeLock = new(1, 1);
+    private readonly BinaryRecordingBlockBuilder _block = new();
+    private ArrayBufferWriter<byte> _sealed = new();
+    private ArrayBufferWriter<byte> _spare = new();
+    private FileStream? _stream;
+    private Hex1bTerminal? _terminal;
+    private DateTimeOffset _timestamp;
+    private int _width;
+    private int _height;
+    private bool _headerWritten;
+    private long _bytesSinceKeyframe;
+    private TimeSpan _lastKeyframe;
+    private TimeSpan _lastFlush;
+    private bool _closed;
+    private bool _disposed;
+
+    /// <summary>
+    /// Creates a new binary recorder that writes to the specified file.
+    /// </summary>
+    /// <param name="filePath">Path to the output file (typically with .h1rec extension).</param>
+    /// <param name="options">Recording options. If null, defaults are used.</param>
+    public BinaryRecorder(string filePath, BinaryRecorderOptions? options = null)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(filePath);
+        _filePath = filePath;
+        _options = options ?? new BinaryRecorderOptions();
+        _timestamp = DateTimeOffset.UtcNow;
+    }
+
+    /// <summary>
+    /// Gets the recording options.
+    /// </summary>
+    public BinaryRecorderOptions Options => _options;
+
+    /// <summary>
+    /// Gets the file path being written to.
+    /// </summary>
+    public string FilePath => _filePath;
+
+    /// <summary>
+    /// Adds a marker event at the current time.
+    /// </summary>
+    /// <param name="label">Optional label for the marker.</param>
+    /// <param name="elapsed">Time elapsed since session start.</param>
+    public void AddMarker(string label = "", TimeSpan? elapsed = null)
+    {
+        lock (_lock)
+        {
+            if (_closed) return;
+            AppendLocked((byte)'m', elapsed ?? DateTimeOffset.UtcNow - _timestamp, label);
+        }
+    }
+
+    /// <inheritdoc />
+    void ITerminalAwareWorkloadFilter.SetTerminal(Hex1bTerminal terminal)
+    {
+        _terminal = terminal;
+    }
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalWorkloadFilter.OnSessionStartAsync(int width, int height, DateTimeOffset timestamp, CancellationToken ct)
+    {
+        lock (_lock)
+        {
+            _width = width;
+            _height = height;
+            _timestamp = timestamp;
+            EnsureHeaderLocked();
+        }
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    async ValueTask IHex1bTerminalWorkloadFilter.OnOutputAsync(IReadOnlyList<AnsiToken> tokens, TimeSpan elapsed, CancellationToken ct)
+    {
+        if (tokens.Count == 0) return;
+
+        var text = AnsiTokenSerializer.Serialize(tokens);
+        bool blockFull;
+        lock (_lock)
+        {
+            if (_closed) return;
+            var before = _block.PendingBytes;
+            AppendLocked((byte)'o', elapsed, text);
+            _bytesSinceKeyframe += _block.PendingBytes - before;
+            blockFull = _block.PendingBytes >= _options.BlockSize;
+            if (blockFull)
+                _block.Seal(_sealed, _options.Compress);
+        }
+
+        if (blockFull)
+            await WriteSealedAsync(ct);
+    }
+
+    /// <inheritdoc />
+    async ValueTask IHex1bTerminalWorkloadFilter.OnFrameCompleteAsync(TimeSpan elapsed, CancellationToken ct)
+    {
+        bool write = false;
+        lock (_lock)
+        {
+            if (_closed) return;
+
+            // Frame boundaries are the only points where the terminal has applied exactly
+            // the output recorded so far, so keyframes are taken here.
+            if (_terminal is not null
+                && _options.CaptureKeyframes
+                && _bytesSinceKeyframe > 0
+                && (_bytesSinceKeyframe >= _options.KeyframeOutputBytes || elapsed - _lastKeyframe >= _options.KeyframeInterval))
+            {
+                var state = OffscreenTerminal.CaptureState(_terminal, out var width, out var height);
+                _block.Seal(_sealed, _options.Compress);
+                BinaryRecordingFormat.WriteKeyframe(_sealed, _block.LastTime, width, height, state, _options.Compress);
+                _bytesSinceKeyframe = 0;
+                _lastKeyframe = elapsed;
+                write = true;
+            }
+
+            if (_block.PendingBytes > 0 && elapsed - _lastFlush >= _options.FlushInterval)
+            {
+                _block.Seal(_sealed, _options.Compress);
+                write = true;
+            }
+        }
+
+        if (write)
+        {
+            _lastFlush = elapsed;
+            await WriteSealedAsync(ct);
+        }
+    }
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalWorkloadFilter.OnInputAsync(IReadOnlyList<AnsiToken> tokens, TimeSpan elapsed, CancellationToken ct)
+    {
+        if (!_options.CaptureInput || tokens.Count == 0) return ValueTask.CompletedTask;
+
+        var text = AnsiTokenSerializer.Serialize(tokens);
+        lock (_lock)
+        {
+            if (!_closed)
+                AppendLocked((byte)'i', elapsed, text);
+        }
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalWorkloadFilter.OnResizeAsync(int width, int height, TimeSpan elapsed, CancellationToken ct)
+    {
+        lock (_lock)
+        {
+            _width = width;
+            _height = height;
+            if (!_closed)
+                AppendLocked((byte)'r', elapsed, $"{width}x{height}");
+        }
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    async ValueTask IHex1bTerminalWorkloadFilter.OnSessionEndAsync(TimeSpan elapsed, CancellationToken ct)
+    {
+        await CloseAsync(ct);
+    }
+
+    /// <summary>
+    /// Writes all buffered events to the file.
+    /// </summary>
+    /// <param name="ct">Cancellation token.</param>
+    public async Task FlushAsync(CancellationToken ct = default)
+    {
+        lock (_lock)
+        {
+            EnsureHeaderLocked();
+            _block.Seal(_sealed, _options.Compress);
+        }
+
+        await WriteSealedAsync(ct);
+
+        await _writeLock.WaitAsync(ct);
+        try
+        {
+            if (_stream is not null)
+                await _stream.FlushAsync(ct);
+        }
+        finally
+        {
+            _writeLock.Release();
+        }
+    }
+
+    private void AppendLocked(byte type, TimeSpan elapsed, string data)
+    {
+        EnsureHeaderLocked();
+        _block.Append(type, BinaryRecordingFormat.ToMicroseconds(elapsed < TimeSpan.Zero ? TimeSpan.Zero : elapsed), data);
+    }
+
+    private void EnsureHeaderLocked()
+    {
+        if (_headerWritten)
+            return;
+
+        var header = new AsciinemaHeader
+        {
+            Version = 2,
+            Width = _width,
+            Height = _height,
+            Timestamp = _timestamp.ToUnixTimeSeconds(),
+            Title = _options.Title,
+            Command = _options.Command,
+            IdleTimeLimit = _options.IdleTimeLimit,
+            Env = _options.CaptureEnvironment ? new Dictionary<string, string>
+            {
+                ["TERM"] = Environment.GetEnvironmentVariable("TERM") ?? "xterm-256color",
+                ["SHELL"] = Environment.GetEnvironmentVariable("SHELL") ?? ""
+            } : null,
+            Theme = _options.Theme
+        };
+        BinaryRecordingFormat.WriteFileHeader(_sealed, JsonSerializer.SerializeToUtf8Bytes(header, AsciinemaJsonContext.Default.AsciinemaHeader));
+        _headerWritten = true;
+    }
+
+    private async Task WriteSealedAsync(CancellationToken ct)
+    {
+        await _writeLock.WaitAsync(ct);
+        try
+        {
+            ArrayBufferWriter<byte> toWrite;
+            lock (_lock)
+            {
+                if (_sealed.WrittenCount == 0)
+                    return;
+                toWrite = _sealed;
+                _sealed = _spare;
+            }
+
+            _stream ??= new FileStream(
+                _filePath,
+                FileMode.Create,
+                FileAccess.Write,
+                FileShare.ReadWrite | FileShare.Delete,
+                4096,
+                useAsync: true);
+            await _stream.WriteAsync(toWrite.WrittenMemory, ct);
+
+            toWrite.Clear();
+            _spare = toWrite;
+        }
+        finally
+        {
+            _writeLock.Release();
+        }
+    }
+
+    private async Task CloseAsync(CancellationToken ct)
+    {
+        lock (_lock)
+        {
+            if (_closed) return;
+        }
+
+        await FlushAsync(ct);
+
+        lock (_lock)
+        {
+            _closed = true;
+        }
+
+        await _writeLock.WaitAsync(ct);
+        try
+        {
+            if (_stream is not null)
+            {
+                await _stream.DisposeAsync();
+                _stream = null;
+            }
+        }
+        finally
+        {
+            _writeLock.Release();
+        }
+    }
+
+    /// <inheritdoc />
+    public async ValueTask DisposeAsync()
+    {
+        if (_disposed) return;
+        _disposed = true;
+
+        try
+        {
+            await CloseAsync(CancellationToken.None);
+        }
+        catch
+        {
+            // Best effort flush on dispose
+        }
+
+        _writeLock.Dispose();
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        if (_disposed) return;
+        DisposeAsync().AsTask().GetAwaiter().GetResult();
+    }
+}
+
+/// <summary>
+/// Options for configuring the binary recorder.
+/// </summary>
+public sealed class BinaryRecorderOptions
+{
+    /// <summary>
+    /// Title of the recording.
+    /// </summary>
+    public string? Title { get; set; }
+
+    /// <summary>
+    /// Command that was recorded.
+    /// </summary>
+    public string? Command { get; set; }
+
+    /// <summary>
+    /// Idle time limit - delays longer than this are compressed during playback.
+    /// </summary>
+    public float? IdleTimeLimit { get; set; }
+
+    /// <summary>
+    /// Whether to capture keyboard input. Off by default, as for asciinema recordings.
+    /// </summary>
+    public bool CaptureInput { get; set; }
+
+    /// <summary>
+    /// Whether to capture environment variables (TERM, SHELL).
+    /// </summary>
+    public bool CaptureEnvironment { get; set; } = true;
+
+    /// <summary>
+    /// Terminal color theme for playback.
+    /// </summary>
+    public AsciinemaTheme? Theme { get; set; }
+
+    /// <summary>
+    /// Whether to Brotli-compress event blocks and keyframes. Blocks that don't shrink
+    /// are stored uncompressed.
+    /// </summary>
+    public bool Compress { get; set; } = true;
+
+    /// <summary>
+    /// Size in bytes at which a block of events is written out.
+    /// </summary>
+    public int BlockSize { get; set; } = 64 * 1024;
+
+    /// <summary>
+    /// Longest time buffered events wait before being written, checked at frame boundaries.
+    /// </summary>
+    public TimeSpan FlushInterval { get; set; } = TimeSpan.FromSeconds(1);
+
+    /// <summary>
+    /// Whether to write terminal-state keyframes for seeking. Requires the recorder to be
+    /// attached to a terminal.
+    /// </summary>
+    public bool CaptureKeyframes { get; set; } = true;
+
+    /// <summary>
+    /// Longest time between keyframes while there is output.
+    /// </summary>
+    public TimeSpan KeyframeInterval { get; set; } = TimeSpan.FromSeconds(30);
+
+    /// <summary>
+    /// Bytes of output after which a keyframe is written at the next frame boundary.
+    /// </summary>
+    public int KeyframeOutputBytes { get; set; } = 256 * 1024;
+}
@@ -0,0 +1,204 @@
+using System.Buffers;
+using System.Text.Json;
+
+namespace Hex1b;
+
+/// <summary>
+/// Converts between Hex1b binary recordings (.h1rec) and asciicast v2 (.cast) files.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The header is carried over verbatim and events keep their type, data and timing, so a
+/// round trip reproduces the same events. Timestamps are stored with microsecond precision,
+/// which matches the six decimal places asciinema writes.
+/// </para>
+/// <para>
+/// Keyframes are not part of asciicast and are dropped when converting to .cast; they are
+/// regenerated when converting from .cast.
+/// </para>
+/// </remarks>
+/// <example>
+/// <code>
+/// await BinaryRecordingConverter.ToAsciicastAsync("session.h1rec", "session.cast");
+/// await BinaryRecordingConverter.FromAsciicastAsync("session.cast", "session.h1rec");
+/// </code>
+/// </example>
+public static class BinaryRecordingConverter
+{
+    /// <summary>
+    /// Converts a binary recording to an asciicast v2 file.
+    /// </summary>
+    /// <param name="binaryPath">Path to the .h1rec file to read.</param>
+    /// <param name="castPath">Path to the .cast file to write.</param>
+    /// <param name="ct">Cancellation token.</param>
+    /// <exception cref="InvalidDataException">The input is not a binary recording.</exception>
+    public static async Task ToAsciicastAsync(string binaryPath, string castPath, CancellationToken ct = default)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(binaryPath);
+        ArgumentException.ThrowIfNullOrWhiteSpace(castPath);
+
+        using var reader = await BinaryRecordingReader.OpenAsync(File.OpenRead(binaryPath), ct);
+        await using var output = new FileStream(castPath, FileMode.Create, FileAccess.Write, FileShare.Read, 4096, useAsync: true);
+
+        var buffer = new ArrayBufferWriter<byte>();
+        buffer.Write(reader.HeaderJson);
+        buffer.Write("\n"u8);
+
+        using var json = new Utf8JsonWriter(buffer);
+        while (await reader.ReadBlockAsync(ct: ct))
+        {
+            if (reader.BlockKind == BinaryRecordingFormat.EventsBlock)
+                WriteEvents(reader.BlockPayload, buffer, json);
+
+            await output.WriteAsync(buffer.WrittenMemory, ct);
+            buffer.Clear();
+        }
+    }
+
+    private static void WriteEvents(ReadOnlyMemory<byte> payload, ArrayBufferWriter<byte> buffer, Utf8JsonWriter json)
+    {
+        Span<byte> code = stackalloc byte[1];
+        var events = new BinaryRecordingEventBlockReader(payload);
+        while (events.TryRead(out var evt))
+        {
+            code[0] = evt.Type;
+            json.Reset(buffer);
+            json.WriteStartArray();
+            json.WriteNumberValue(Math.Round(BinaryRecordingFormat.ToSeconds(evt.TimeMicros), 6));
+            json.WriteStringValue(code);
+            json.WriteStringValue(evt.Data.Span);
+            json.WriteEndArray();
+            json.Flush();
+            buffer.Write("\n"u8);
+        }
+    }
+
+    /// <summary>
+    /// Converts an asciicast v2 file to a binary recording.
+    /// </summary>
+    /// <param name="castPath">Path to the .cast file to read.</param>
+    /// <param name="binaryPath">Path to the .h1rec file to write.</param>
+    /// <param name="options">
+    /// Options for block size, compression and keyframes. Header options such as
+    /// <see cref="BinaryRecorderOptions.Title"/> are ignored; the header is copied from the input.
+    /// </param>
+    /// <param name="ct">Cancellation token.</param>
+    /// <exception cref="InvalidDataException">The input has no valid asciicast header.</exception>
+    public static async Task FromAsciicastAsync(string castPath, string binaryPath, BinaryRecorderOptions? options = null, CancellationToken ct = default)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(castPath);
+        ArgumentException.ThrowIfNullOrWhiteSpace(binaryPath);
+
+        using var reader = new AsciinemaEventReader(File.OpenRead(castPath));
+        if (!await reader.ReadLineAsync(ct))
+            throw new InvalidDataException("Invalid asciinema file: missing header");
+
+        var encoder = new AsciicastEncoder(reader.Line.Span, options ?? new BinaryRecorderOptions());
+        try
+        {
+            await using var output = new FileStream(binaryPath, FileMode.Create, FileAccess.Write, FileShare.Read, 4096, useAsync: true);
+            while (await reader.ReadLineAsync(ct))
+            {
+                if (!encoder.Append(reader.Line.Span))
+                    break;
+
+                if (encoder.Output.WrittenCount >= encoder.Options.BlockSize)
+                {
+                    await output.WriteAsync(encoder.Output.WrittenMemory, ct);
+                    encoder.Output.Clear();
+                }
+            }
+
+            encoder.Complete();
+            await output.WriteAsync(encoder.Output.WrittenMemory, ct);
+        }
+        finally
+        {
+            encoder.Dispose();
+        }
+    }
+
+    /// <summary>
+    /// Encodes asciicast event lines into blocks and keyframes.
+    /// </summary>
+    private sealed class AsciicastEncoder : IDisposable
+    {
+        private static ReadOnlySpan<byte> Utf8Bom => [0xEF, 0xBB, 0xBF];
+
+        private readonly BinaryRecordingBlockBuilder _block = new();
+        private readonly ArrayBufferWriter<byte> _data = new();
+        private readonly OffscreenTerminal? _terminal;
+        private int _width;
+        private int _height;
+        private long _bytesSinceKeyframe;
+        private long _lastKeyframe;
+
+        public AsciicastEncoder(ReadOnlySpan<byte> header, BinaryRecorderOptions options)
+        {
+            Options = options;
+            if (header.StartsWith(Utf8Bom))
+                header = header[Utf8Bom.Length..];
+
+            (_width, _height) = AsciinemaEventReader.ParseHeader(header);
+            BinaryRecordingFormat.WriteFileHeader(Output, header);
+
+            if (options.CaptureKeyframes && _width > 0 && _height > 0)
+                _terminal = new OffscreenTerminal(_width, _height);
+        }
+
+        public BinaryRecorderOptions Options { get; }
+
+        public ArrayBufferWriter<byte> Output { get; } = new();
+
+        /// <summary>
+        /// Adds one event line. Returns false at a blank line, which ends the events.
+        /// </summary>
+        public bool Append(ReadOnlySpan<byte> line)
+        {
+            if (AsciinemaEventReader.IsBlank(line))
+                return false;
+
+            _data.Clear();
+            if (!AsciinemaEventReader.TryParseEvent(line, out var timestamp, out var eventType, _data) || eventType == 0)
+                return true;
+
+            var time = BinaryRecordingFormat.ToMicroseconds(Math.Max(timestamp, 0));
+            _block.Append(eventType, time, _data.WrittenSpan);
+            if (_block.PendingBytes >= Options.BlockSize)
+                _block.Seal(Output, Options.Compress);
+
+            if (_terminal is null)
+                return true;
+
+            if (eventType == (byte)'o')
+            {
+                _terminal.Write(_data.WrittenSpan);
+                _bytesSinceKeyframe += _data.WrittenCount;
+            }
+            else if (eventType == (byte)'r' && AsciinemaEventReader.TryParseSize(_data.WrittenSpan, out var w, out var h))
+            {
+                _width = w;
+                _height = h;
+            }
+
+            if (_bytesSinceKeyframe == 0
+                || (_bytesSinceKeyframe < Options.KeyframeOutputBytes
+                    && time - _lastKeyframe < BinaryRecordingFormat.ToMicroseconds(Options.KeyframeInterval)))
+                return true;
+
+            // A keyframe must not split an escape sequence; the next event completes it
+            if (!_terminal.TryCaptureState(out var state))
+                return true;
+
+            _block.Seal(Output, Options.Compress);
+            BinaryRecordingFormat.WriteKeyframe(Output, time, _width, _height, state, Options.Compress);
+            _bytesSinceKeyframe = 0;
+            _lastKeyframe = time;
+            return true;
+        }
+
+        public void Complete() => _block.Seal(Output, Options.Compress);
+
+        public void Dispose() => _terminal?.Dispose();
+    }
+}
@@ -0,0 +1,400 @@
+using System.Buffers;
+using System.IO.Compression;
+using System.Text;
+
+namespace Hex1b;
+
+/// <summary>
+/// Layout of Hex1b binary recordings (<c>.h1rec</c>).
+/// </summary>
+/// <remarks>
+/// <para>
+/// A recording is the magic <c>HEX1BREC</c>, a version byte, and a varint-length-prefixed
+/// asciicast v2 header (UTF-8 JSON, kept verbatim so conversion to <c>.cast</c> is lossless),
+/// followed by blocks. Every block is a kind byte and a varint payload length.
+/// </para>
+/// <para>
+/// An events block starts with the varint time (microseconds) its first delta is relative
+/// to, then holds frames of <c>[type byte][zigzag varint delta µs][varint length][data]</c>,
+/// where type is the asciicast event code (<c>o</c>, <c>i</c>, <c>r</c>, <c>m</c>) and data is
+/// the raw UTF-8 event data. Blocks are therefore decodable on their own.
+/// </para>
+/// <para>
+/// A keyframe block holds the varint time of the last event it covers, the terminal width
+/// and height, and output that recreates the terminal state at that point (see
+/// <see cref="OffscreenTerminal.CaptureState(Hex1bTerminal)"/>). Keyframes are derived data: players may
+/// use them to start mid-recording, and converters drop them.
+/// </para>
+/// <para>
+/// Blocks with <see cref="CompressedFlag"/> set in their kind store a varint uncompressed
+/// length followed by a Brotli stream. A truncated final block (e.g. after a crash) is
+/// ignored by readers, so everything before it stays readable.
+/// </para>
+/// </remarks>
+internal static class BinaryRecordingFormat
+{
+    public static ReadOnlySpan<byte> Magic => "HEX1BREC"u8;
+    public const byte Version = 1;
+
+    public const byte EventsBlock = 1;
+    public const byte KeyframeBlock = 2;
+    public const byte CompressedFlag = 0x80;
+
+    // Brotli level 1 keeps compression cheap enough for continuous recording
+    private const int BrotliQuality = 1;
+    private const int BrotliWindow = 22;
+
+    public static void WriteVarUInt(IBufferWriter<byte> output, ulong value)
+    {
+        var span = output.GetSpan(10);
+        var i = 0;
+        while (value >= 0x80)
+        {
+            span[i++] = (byte)(value | 0x80);
+            value >>= 7;
+        }
+        span[i++] = (byte)value;
+        output.Advance(i);
+    }
+
+    public static bool TryReadVarUInt(ReadOnlySpan<byte> source, ref int position, out ulong value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64 && position < source.Length; shift += 7)
+        {
+            var b = source[position++];
+            value |= (ulong)(b & 0x7F) << shift;
+            if (b < 0x80)
+                return true;
+        }
+        return false;
+    }
+
+    public static ulong ZigZag(long value) => (ulong)((value << 1) ^ (value >> 63));
+
+    public static long UnZigZag(ulong value) => (long)(value >> 1) ^ -(long)(value & 1);
+
+    public static long ToMicroseconds(double seconds) => (long)Math.Round(seconds * 1_000_000);
+
+    public static long ToMicroseconds(TimeSpan elapsed) => elapsed.Ticks / TimeSpan.TicksPerMicrosecond;
+
+    public static double ToSeconds(long microseconds) => microseconds / 1_000_000.0;
+
+    public static void WriteFileHeader(IBufferWriter<byte> output, ReadOnlySpan<byte> headerJson)
+    {
+        output.Write(Magic);
+        output.Write([Version]);
+        WriteVarUInt(output, (ulong)headerJson.Length);
+        output.Write(headerJson);
+    }
+
+    /// <summary>
+    /// Writes a block, compressing the payload when that makes it smaller.
+    /// </summary>
+    public static void WriteBlock(IBufferWriter<byte> output, byte kind, ReadOnlySpan<byte> payload, bool compress)
+    {
+        if (compress && payload.Length > 64)
+        {
+            var compressed = ArrayPool<byte>.Shared.Rent(BrotliEncoder.GetMaxCompressedLength(payload.Length));
+            try
+            {
+                if (BrotliEncoder.TryCompress(payload, compressed, out var written, BrotliQuality, BrotliWindow)
+                    && written < payload.Length)
+                {
+                    var lengthPrefix = new ArrayBufferWriter<byte>(10);
+                    WriteVarUInt(lengthPrefix, (ulong)payload.Length);
+
+                    output.Write([(byte)(kind | CompressedFlag)]);
+                    WriteVarUInt(output, (ulong)(lengthPrefix.WrittenCount + written));
+                    output.Write(lengthPrefix.WrittenSpan);
+                    output.Write(compressed.AsSpan(0, written));
+                    return;
+                }
+            }
+            finally
+            {
+                ArrayPool<byte>.Shared.Return(compressed);
+            }
+        }
+
+        output.Write([kind]);
+        WriteVarUInt(output, (ulong)payload.Length);
+        output.Write(payload);
+    }
+
+    public static void WriteKeyframe(IBufferWriter<byte> output, long timeMicros, int width, int height, ReadOnlySpan<byte> state, bool compress)
+    {
+        var payload = new ArrayBufferWriter<byte>(state.Length + 16);
+        WriteVarUInt(payload, (ulong)timeMicros);
+        WriteVarUInt(payload, (ulong)width);
+        WriteVarUInt(payload, (ulong)height);
+        payload.Write(state);
+        WriteBlock(output, KeyframeBlock, payload.WrittenSpan, compress);
+    }
+
+    public static bool TryParseKeyframe(ReadOnlyMemory<byte> payload, out BinaryRecordingKeyframe keyframe)
+    {
+        keyframe = default;
+        var span = payload.Span;
+        var position = 0;
+        if (!TryReadVarUInt(span, ref position, out var time)
+            || !TryReadVarUInt(span, ref position, out var width)
+            || !TryReadVarUInt(span, ref position, out var height))
+            return false;
+
+        keyframe = new BinaryRecordingKeyframe((long)time, (int)width, (int)height, payload[position..]);
+        return true;
+    }
+}
+
+/// <summary>
+/// One event decoded from a binary recording. <see cref="Data"/> points into the block buffer.
+/// </summary>
+internal readonly record struct BinaryRecordingEvent(long TimeMicros, byte Type, ReadOnlyMemory<byte> Data);
+
+/// <summary>
+/// A keyframe decoded from a binary recording. <see cref="State"/> points into the block buffer.
+/// </summary>
+internal readonly record struct BinaryRecordingKeyframe(long TimeMicros, int Width, int Height, ReadOnlyMemory<byte> State);
+
+/// <summary>
+/// Accumulates events into an events block.
+/// </summary>
+internal sealed class BinaryRecordingBlockBuilder
+{
+    private readonly ArrayBufferWriter<byte> _block = new();
+    private long _lastTime;
+    private int _eventCount;
+
+    /// <summary>Bytes buffered in the current block.</summary>
+    public int PendingBytes => _block.WrittenCount;
+
+    /// <summary>Time of the last event appended, in microseconds.</summary>
+    public long LastTime => _lastTime;
+
+    public void Append(byte type, long timeMicros, ReadOnlySpan<byte> data)
+    {
+        BeginFrame(type, timeMicros, data.Length);
+        _block.Write(data);
+    }
+
+    public void Append(byte type, long timeMicros, string data)
+    {
+        var length = Encoding.UTF8.GetByteCount(data);
+        BeginFrame(type, timeMicros, length);
+        var written = Encoding.UTF8.GetBytes(data, _block.GetSpan(length));
+        _block.Advance(written);
+    }
+
+    private void BeginFrame(byte type, long timeMicros, int length)
+    {
+        if (_eventCount++ == 0)
+            BinaryRecordingFormat.WriteVarUInt(_block, (ulong)_lastTime);
+
+        _block.Write([type]);
+        BinaryRecordingFormat.WriteVarUInt(_block, BinaryRecordingFormat.ZigZag(timeMicros - _lastTime));
+        BinaryRecordingFormat.WriteVarUInt(_block, (ulong)length);
+        _lastTime = timeMicros;
+    }
+
+    /// <summary>
+    /// Writes the buffered events as one block, if there are any, and starts a new block.
+    /// </summary>
+    public void Seal(IBufferWriter<byte> output, bool compress)
+    {
+        if (_eventCount == 0)
+            return;
+
+        BinaryRecordingFormat.WriteBlock(output, BinaryRecordingFormat.EventsBlock, _block.WrittenSpan, compress);
+        _block.Clear();
+        _eventCount = 0;
+    }
+}
+
+/// <summary>
+/// Iterates the events of a decoded events block.
+/// </summary>
+internal struct BinaryRecordingEventBlockReader
+{
+    private readonly ReadOnlyMemory<byte> _payload;
+    private int _position;
+    private long _time;
+
+    public BinaryRecordingEventBlockReader(ReadOnlyMemory<byte> payload)
+    {
+        _payload = payload;
+        _position = 0;
+        _time = 0;
+        if (BinaryRecordingFormat.TryReadVarUInt(payload.Span, ref _position, out var baseTime))
+            _time = (long)baseTime;
+        else
+            _position = payload.Length;
+    }
+
+    public bool TryRead(out BinaryRecordingEvent evt)
+    {
+        evt = default;
+        var span = _payload.Span;
+        var position = _position;
+        if (position >= span.Length)
+            return false;
+
+        var type = span[position++];
+        if (!BinaryRecordingFormat.TryReadVarUInt(span, ref position, out var delta)
+            || !BinaryRecordingFormat.TryReadVarUInt(span, ref position, out var length)
+            || (ulong)(span.Length - position) < length)
+        {
+            _position = span.Length;
+            return false;
+        }
+
+        _time += BinaryRecordingFormat.UnZigZag(delta);
+        evt = new BinaryRecordingEvent(_time, type, _payload.Slice(position, (int)length));
+        _position = position + (int)length;
+        return true;
+    }
+}
+
+/// <summary>
+/// Reads the header and blocks of a binary recording from a stream.
+/// </summary>
+internal sealed class BinaryRecordingReader : IDisposable
+{
+    private readonly Stream _stream;
+    private readonly byte[] _scratch = new byte[1];
+    private byte[] _raw = [];
+    private byte[] _decoded = [];
+
+    private BinaryRecordingReader(Stream stream, byte[] headerJson)
+    {
+        _stream = stream;
+        HeaderJson = headerJson;
+        (Width, Height) = AsciinemaEventReader.ParseHeader(headerJson);
+    }
+
+    /// <summary>The asciicast v2 header, as UTF-8 JSON.</summary>
+    public byte[] HeaderJson { get; }
+
+    public int Width { get; }
+
+    public int Height { get; }
+
+    /// <summary>Kind of the current block, without <see cref="BinaryRecordingFormat.CompressedFlag"/>.</summary>
+    public byte BlockKind { get; private set; }
+
+    /// <summary>Decoded payload of the current block; valid until the next read.</summary>
+    public ReadOnlyMemory<byte> BlockPayload { get; private set; }
+
+    /// <exception cref="InvalidDataException">The stream is not a binary recording.</exception>
+    public static async Task<BinaryRecordingReader> OpenAsync(Stream stream, CancellationToken ct = default)
+    {
+        var prefix = new byte[BinaryRecordingFormat.Magic.Length + 1];
+        if (!await TryReadExactlyAsync(stream, prefix, ct)
+            || !prefix.AsSpan(0, BinaryRecordingFormat.Magic.Length).SequenceEqual(BinaryRecordingFormat.Magic))
+            throw new InvalidDataException("Not a Hex1b binary recording");
+        if (prefix[^1] != BinaryRecordingFormat.Version)
+            throw new InvalidDataException($"Unsupported binary recording version {prefix[^1]}");
+
+        var headerLength = await ReadVarUIntAsync(stream, prefix, ct)
+            ?? throw new InvalidDataException("Invalid binary recording: missing header");
+        var header = new byte[checked((int)headerLength)];
+        if (!await TryReadExactlyAsync(stream, header, ct))
+            throw new InvalidDataException("Invalid binary recording: truncated header");
+
+        return new BinaryRecordingReader(stream, header);
+    }
+
+    /// <summary>
+    /// Position of the next block in the stream. Setting it requires a seekable stream.
+    /// </summary>
+    public long Position
+    {
+        get => _stream.Position;
+        set => _stream.Position = value;
+    }
+
+    /// <summary>
+    /// Advances to the next block.
+    /// </summary>
+    /// <param name="skipEvents">
+    /// If true, events blocks are skipped without being read or decompressed and their
+    /// <see cref="BlockPayload"/> is empty. Requires a seekable stream.
+    /// </param>
+    /// <param name="ct">Cancellation token.</param>
+    /// <returns>False at the end of the recording or at a truncated block.</returns>
+    public async ValueTask<bool> ReadBlockAsync(bool skipEvents = false, CancellationToken ct = default)
+    {
+        if (!await TryReadExactlyAsync(_stream, _scratch, ct))
+            return false;
+        var kind = _scratch[0];
+
+        var length = await ReadVarUIntAsync(_stream, _scratch, ct);
+        if (length is null || length > int.MaxValue)
+            return false;
+
+        var payloadLength = (int)length.Value;
+        if (skipEvents && (kind & ~BinaryRecordingFormat.CompressedFlag) == BinaryRecordingFormat.EventsBlock)
+        {
+            if (_stream.Length - _stream.Position < payloadLength)
+                return false;
+            _stream.Seek(payloadLength, SeekOrigin.Current);
+            BlockKind = BinaryRecordingFormat.EventsBlock;
+            BlockPayload = ReadOnlyMemory<byte>.Empty;
+            return true;
+        }
+
+        if (_raw.Length < payloadLength)
+            _raw = new byte[Math.Max(payloadLength, _raw.Length * 2)];
+        if (!await TryReadExactlyAsync(_stream, _raw.AsMemory(0, payloadLength), ct))
+            return false;
+
+        BlockKind = (byte)(kind & ~BinaryRecordingFormat.CompressedFlag);
+        if ((kind & BinaryRecordingFormat.CompressedFlag) == 0)
+        {
+            BlockPayload = _raw.AsMemory(0, payloadLength);
+            return true;
+        }
+
+        return TryDecompress(payloadLength);
+    }
+
+    private bool TryDecompress(int payloadLength)
+    {
+        var position = 0;
+        if (!BinaryRecordingFormat.TryReadVarUInt(_raw.AsSpan(0, payloadLength), ref position, out var decodedLength)
+            || decodedLength > int.MaxValue)
+            return false;
+
+        if (_decoded.Length < (int)decodedLength)
+            _decoded = new byte[Math.Max((int)decodedLength, _decoded.Length * 2)];
+        if (!BrotliDecoder.TryDecompress(_raw.AsSpan(position, payloadLength - position), _decoded, out var written)
+            || written != (int)decodedLength)
+            return false;
+
+        BlockPayload = _decoded.AsMemory(0, written);
+        return true;
+    }
+
+    private static async ValueTask<bool> TryReadExactlyAsync(Stream stream, Memory<byte> buffer, CancellationToken ct)
+    {
+        var read = await stream.ReadAtLeastAsync(buffer, buffer.Length, throwOnEndOfStream: false, ct).ConfigureAwait(false);
+        return read == buffer.Length;
+    }
+
+    private static async ValueTask<ulong?> ReadVarUIntAsync(Stream stream, byte[] scratch, CancellationToken ct)
+    {
+        var buffer = scratch.AsMemory(0, 1);
+        ulong value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (!await TryReadExactlyAsync(stream, buffer, ct))
+                return null;
+            value |= (ulong)(scratch[0] & 0x7F) << shift;
+            if (scratch[0] < 0x80)
+                return value;
+        }
+        return null;
+    }
+
+    public void Dispose() => _stream.Dispose();
+}
@@ -0,0 +1,291 @@
+using System.Buffers;
+using System.Threading.Channels;
+
+namespace Hex1b;
+
+/// <summary>
+/// A workload adapter that plays back a Hex1b binary recording (.h1rec).
+/// </summary>
+/// <remarks>
+/// <para>
+/// This is the binary-format counterpart of <see cref="AsciinemaFileWorkloadAdapter"/>:
+/// output events are replayed with their original timing, resize events update
+/// <see cref="Width"/> and <see cref="Height"/>, and input and marker events are ignored.
+/// </para>
+/// <para>
+/// Setting <see cref="StartPosition"/> starts playback part-way through the recording.
+/// The adapter restores the last keyframe at or before that position and replays only
+/// the events after it; events blocks before the keyframe are skipped without being
+/// decompressed.
+/// </para>
+/// </remarks>
+/// <example>
+/// <code>
+/// await using var terminal = Hex1bTerminal.CreateBuilder()
+///     .WithBinaryPlayback("session.h1rec")
+///     .Build();
+///
+/// await terminal.RunAsync();
+/// </code>
+/// </example>
+public sealed class BinaryRecordingWorkloadAdapter : IHex1bTerminalWorkloadAdapter
+{
+    private readonly string _filePath;
+    private readonly Channel<ReadOnlyMemory<byte>> _outputChannel;
+    private readonly CancellationTokenSource _cts = new();
+    private Task? _playbackTask;
+    private bool _disposed;
+    private bool _started;
+    private double _speedMultiplier = 1.0;
+
+    /// <summary>
+    /// Creates a new binary recording workload adapter.
+    /// </summary>
+    /// <param name="filePath">Path to the .h1rec file to play back.</param>
+    public BinaryRecordingWorkloadAdapter(string filePath)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(filePath);
+        _filePath = filePath;
+        _outputChannel = Channel.CreateUnbounded<ReadOnlyMemory<byte>>(new UnboundedChannelOptions
+        {
+            SingleReader = true,
+            SingleWriter = true
+        });
+    }
+
+    /// <summary>
+    /// Gets or sets the playback speed multiplier. Default is 1.0 (normal speed).
+    /// </summary>
+    public double SpeedMultiplier
+    {
+        get => _speedMultiplier;
+        set
+        {
+            if (value <= 0)
+                throw new ArgumentOutOfRangeException(nameof(value), "Speed multiplier must be greater than 0");
+            _speedMultiplier = value;
+        }
+    }
+
+    /// <summary>
+    /// Gets or sets the position in the recording to start playback from. Default is zero.
+    /// </summary>
+    public TimeSpan StartPosition { get; set; }
+
+    /// <summary>
+    /// Gets the width from the recording header, or 0 if not yet read.
+    /// </summary>
+    public int Width { get; private set; }
+
+    /// <summary>
+    /// Gets the height from the recording header, or 0 if not yet read.
+    /// </summary>
+    public int Height { get; private set; }
+
+    /// <summary>
+    /// Starts playback of the recording.
+    /// </summary>
+    public Task StartAsync(CancellationToken ct = default)
+    {
+        if (_started)
+            throw new InvalidOperationException("Playback has already been started.");
+
+        if (_disposed)
+            throw new ObjectDisposedException(nameof(BinaryRecordingWorkloadAdapter));
+
+        if (!File.Exists(_filePath))
+            throw new FileNotFoundException($"Binary recording not found: {_filePath}", _filePath);
+
+        _started = true;
+        _playbackTask = PlaybackLoopAsync(_cts.Token);
+
+        return Task.CompletedTask;
+    }
+
+    private async Task PlaybackLoopAsync(CancellationToken ct)
+    {
+        try
+        {
+            using var reader = await BinaryRecordingReader.OpenAsync(File.OpenRead(_filePath), ct);
+            Width = reader.Width;
+            Height = reader.Height;
+
+            var start = BinaryRecordingFormat.ToMicroseconds(StartPosition);
+            if (start > 0)
+                await RestoreKeyframeAsync(reader, start, ct);
+
+            // Events up to the start position are sent in one write, without delays
+            var catchUp = new ArrayBufferWriter<byte>();
+            var previousTimestamp = start;
+
+            while (!ct.IsCancellationRequested && await reader.ReadBlockAsync(ct: ct))
+            {
+                if (reader.BlockKind != BinaryRecordingFormat.EventsBlock)
+                    continue;
+
+                var events = new BinaryRecordingEventBlockReader(reader.BlockPayload);
+                while (events.TryRead(out var evt))
+                {
+                    if (evt.TimeMicros <= start)
+                    {
+                        if (evt.Type == (byte)'o')
+                            catchUp.Write(evt.Data.Span);
+                        else if (evt.Type == (byte)'r')
+                            ApplyResize(evt.Data.Span);
+                        continue;
+                    }
+
+                    if (catchUp.WrittenCount > 0)
+                    {
+                        await _outputChannel.Writer.WriteAsync(catchUp.WrittenSpan.ToArray(), ct);
+                        catchUp.Clear();
+                    }
+
+                    // Calculate delay based on timestamp difference
+                    var delay = evt.TimeMicros - previousTimestamp;
+                    if (delay > 0)
+                    {
+                        // Apply speed multiplier
+                        var adjustedDelay = BinaryRecordingFormat.ToSeconds(delay) / _speedMultiplier;
+                        await Task.Delay(TimeSpan.FromSeconds(adjustedDelay), ct);
+                    }
+                    previousTimestamp = evt.TimeMicros;
+
+                    // Handle event based on type; "i" and "m" events are ignored during playback
+                    if (evt.Type == (byte)'o')
+                        await _outputChannel.Writer.WriteAsync(evt.Data.ToArray(), ct);
+                    else if (evt.Type == (byte)'r')
+                        ApplyResize(evt.Data.Span);
+                }
+            }
+
+            if (catchUp.WrittenCount > 0)
+                await _outputChannel.Writer.WriteAsync(catchUp.WrittenSpan.ToArray(), ct);
+        }
+        catch (OperationCanceledException)
+        {
+            // Normal cancellation
+        }
+        catch (Exception ex)
+        {
+            // Log error or handle as needed
+            System.Diagnostics.Debug.WriteLine($"Playback error: {ex.Message}");
+        }
+        finally
+        {
+            _outputChannel.Writer.TryComplete();
+            Disconnected?.Invoke();
+        }
+    }
+
+    /// <summary>
+    /// Finds the last keyframe at or before <paramref name="start"/>, sends its state, and
+    /// leaves the reader positioned just after it. Without one, rewinds to the first block.
+    /// </summary>
+    private async Task RestoreKeyframeAsync(BinaryRecordingReader reader, long start, CancellationToken ct)
+    {
+        var firstBlock = reader.Position;
+        var resumeAt = firstBlock;
+        byte[]? state = null;
+
+        while (await reader.ReadBlockAsync(skipEvents: true, ct))
+        {
+            if (reader.BlockKind != BinaryRecordingFormat.KeyframeBlock
+                || !BinaryRecordingFormat.TryParseKeyframe(reader.BlockPayload, out var keyframe))
+                continue;
+            if (keyframe.TimeMicros > start)
+                break;
+
+            state = keyframe.State.ToArray();
+            Width = keyframe.Width;
+            Height = keyframe.Height;
+            resumeAt = reader.Position;
+        }
+
+        reader.Position = resumeAt;
+        if (state is not null)
+            await _outputChannel.Writer.WriteAsync(state, ct);
+    }
+
+    private void ApplyResize(ReadOnlySpan<byte> data)
+    {
+        if (AsciinemaEventReader.TryParseSize(data, out var width, out var height))
+        {
+            Width = width;
+            Height = height;
+        }
+    }
+
+    /// <inheritdoc />
+    public async ValueTask<ReadOnlyMemory<byte>> ReadOutputAsync(CancellationToken ct = default)
+    {
+        if (_disposed)
+            return ReadOnlyMemory<byte>.Empty;
+
+        try
+        {
+            if (await _outputChannel.Reader.WaitToReadAsync(ct))
+            {
+                if (_outputChannel.Reader.TryRead(out var data))
+                {
+                    return data;
+                }
+            }
+        }
+        catch (OperationCanceledException)
+        {
+            // Cancelled
+        }
+        catch (ChannelClosedException)
+        {
+            // Channel closed - playback ended
+        }
+
+        return ReadOnlyMemory<byte>.Empty;
+    }
+
+    /// <inheritdoc />
+    public ValueTask WriteInputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default)
+    {
+        // Playback is read-only, input is ignored
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    public ValueTask ResizeAsync(int width, int height, CancellationToken ct = default)
+    {
+        // Resize from outside is ignored - the recording controls the size
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    public event Action? Disconnected;
+
+    /// <inheritdoc />
+    public async ValueTask DisposeAsync()
+    {
+        if (_disposed)
+            return;
+
+        _disposed = true;
+
+        // Cancel playback
+        await _cts.CancelAsync();
+
+        // Wait for playback to complete
+        if (_playbackTask != null)
+        {
+            try
+            {
+                await _playbackTask;
+            }
+            catch
+            {
+                // Ignore exceptions during cleanup
+            }
+        }
+
+        _outputChannel.Writer.TryComplete();
+        _cts.Dispose();
+    }
+}
@@ -0,0 +1,110 @@
+using System.Runtime.InteropServices;
+
+namespace Hex1b;
+
+/// <summary>
+/// Reports when PTY child processes exit, using one thread that sleeps in the native
+/// library until a watched child exits.
+/// </summary>
+/// <remarks>
+/// On Linux 5.3+ the native side waits on pidfds with epoll; elsewhere it waits on a
+/// SIGCHLD self-pipe. Either way, idle children cost no wakeups and exited children are
+/// reaped straight away instead of lingering as zombies until someone polls them.
+/// </remarks>
+internal static partial class ChildExitWatcher
+{
+    private static readonly object s_lock = new();
+    private static readonly Dictionary<int, TaskCompletionSource<int>> s_pending = new();
+    private static bool s_initialized;
+    private static bool s_available;
+
+    /// <summary>
+    /// Starts watching <paramref name="pid"/>, which must be a child of this process that
+    /// nothing else reaps.
+    /// </summary>
+    /// <returns>
+    /// A task that completes with the child's exit code (128 + signal if it was killed), or
+    /// null if exit notification isn't available and the caller has to poll.
+    /// </returns>
+    public static Task<int>? Watch(int pid)
+    {
+        lock (s_lock)
+        {
+            if (!EnsureStarted())
+                return null;
+
+            // Registered before the native add so an immediate exit finds it
+            var exited = new TaskCompletionSource<int>(TaskCreationOptions.RunContinuationsAsynchronously);
+            s_pending[pid] = exited;
+            if (exitwatch_add(pid) < 0)
+            {
+                s_pending.Remove(pid);
+                return null;
+            }
+            return exited.Task;
+        }
+    }
+
+    private static bool EnsureStarted()
+    {
+        if (s_initialized)
+            return s_available;
+
+        s_initialized = true;
+        try
+        {
+            s_available = exitwatch_init() > 0;
+        }
+        catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException)
+        {
+            // Native library without exit notification; callers fall back to polling
+            s_available = false;
+        }
+
+        if (s_available)
+        {
+            var thread = new Thread(WatchLoop)
+            {
+                IsBackground = true,
+                Name = "Hex1b child exit watcher"
+            };
+            thread.Start();
+        }
+        return s_available;
+    }
+
+    private static void WatchLoop()
+    {
+        while (true)
+        {
+            if (exitwatch_next(out var pid, out var exitCode) < 0)
+            {
+                // Shouldn't happen; release every waiter rather than leave them hanging
+                lock (s_lock)
+                {
+                    s_available = false;
+                    foreach (var pending in s_pending.Values)
+                        pending.TrySetResult(-1);
+                    s_pending.Clear();
+                }
+                return;
+            }
+
+            TaskCompletionSource<int>? exited;
+            lock (s_lock)
+            {
+                s_pending.Remove(pid, out exited);
+            }
+            exited?.TrySetResult(exitCode);
+        }
+    }
+
+    [LibraryImport("hex1binterop", EntryPoint = "hex1b_exitwatch_init", SetLastError = true)]
+    private static partial int exitwatch_init();
+
+    [LibraryImport("hex1binterop", EntryPoint = "hex1b_exitwatch_add", SetLastError = true)]
+    private static partial int exitwatch_add(int pid);
+
+    [LibraryImport("hex1binterop", EntryPoint = "hex1b_exitwatch_next", SetLastError = true)]
+    private static partial int exitwatch_next(out int pid, out int exitCode);
+}
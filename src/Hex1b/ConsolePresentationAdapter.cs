@@ -22,8 +22,17 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
     // ST (where ST is either ESC \ or BEL). Most modern terminals support this
     // (xterm, iTerm2, kitty, WezTerm, Alacritty, Windows Terminal, VS Code).
     private static readonly byte[] BackgroundProbeQuery = Encoding.ASCII.GetBytes("\x1b]11;?\x1b\\");
+    // DECRQM for DEC private mode 2026 (Synchronized Update Mode). Supporting terminals
+    // reply ESC [ ? 2026 ; Ps $ y, where Ps 1-3 means the mode is known and can be set.
+    private static readonly byte[] SyncOutputProbeQuery = Encoding.ASCII.GetBytes("\x1b[?2026$p");
+    private static readonly byte[] SyncUpdateBegin = Encoding.ASCII.GetBytes("\x1b[?2026h");
+    private static readonly byte[] SyncUpdateEnd = Encoding.ASCII.GetBytes("\x1b[?2026l");
     private static readonly TimeSpan DefaultKgpProbeTimeout = TimeSpan.FromMilliseconds(150);
 
+    // An open frame is flushed once it holds this much, so a workload that never pauses
+    // still reaches the screen.
+    private const int MaxFrameBytes = 256 * 1024;
+
     private readonly IConsoleDriver _driver;
     private readonly bool _enableMouse;
     private readonly bool _preserveOPost;
@@ -36,6 +45,11 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
     private Decoder? _inputDecoder;
     private bool _kgpProbeCompleted;
     private bool _backgroundProbeCompleted;
+    private bool _syncOutputProbeCompleted;
+    private readonly object _frameLock = new();
+    private bool _frameOpen;
+    private int _frameBytes;
+    private long _writeCallsAtLastFlush;
     private bool _reflowEnabled;
     private bool _disposed;
     private bool _inRawMode;
@@ -100,6 +114,11 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
         return this;
     }
 
+    /// <summary>
+    /// Metrics that flushed frames are reported to. The terminal sets this to its own instance.
+    /// </summary>
+    internal Diagnostics.Hex1bMetrics Metrics { get; set; } = Diagnostics.Hex1bMetrics.Default;
+
     /// <inheritdoc/>
     public bool ReflowEnabled => _reflowEnabled;
 
@@ -165,15 +184,52 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
     public event Action? Disconnected;
 
     /// <inheritdoc />
+    /// <remarks>
+    /// Output is gathered into a frame that <see cref="FlushAsync"/> sends in one write, wrapped
+    /// in synchronized update mode when the terminal supports it. The terminal flushes whenever
+    /// the workload has no more output queued.
+    /// </remarks>
     public ValueTask WriteOutputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default)
     {
         if (_disposed) return ValueTask.CompletedTask;
 
-        _driver.Write(data.Span);
-        _driver.Flush();
+        lock (_frameLock)
+        {
+            if (!_frameOpen)
+            {
+                _frameOpen = true;
+                if (_capabilities.SupportsSynchronizedOutput)
+                    _driver.Write(SyncUpdateBegin);
+            }
+
+            _driver.Write(data.Span);
+            _frameBytes += data.Length;
+            if (_frameBytes >= MaxFrameBytes)
+                FlushFrame();
+        }
         return ValueTask.CompletedTask;
     }
 
+    private void FlushFrame()
+    {
+        if (_frameOpen)
+        {
+            if (_capabilities.SupportsSynchronizedOutput)
+                _driver.Write(SyncUpdateEnd);
+            _frameOpen = false;
+            _frameBytes = 0;
+        }
+
+        _driver.Flush();
+
+        var writeCalls = _driver.WriteCalls;
+        if (writeCalls != _writeCallsAtLastFlush)
+        {
+            Metrics.TerminalOutputWriteCalls.Record((int)(writeCalls - _writeCallsAtLastFlush));
+            _writeCallsAtLastFlush = writeCalls;
+        }
+    }
+
     /// <inheritdoc />
     public async ValueTask<ReadOnlyMemory<byte>> ReadInputAsync(CancellationToken ct = default)
     {
@@ -269,7 +325,10 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
     /// <inheritdoc />
     public ValueTask FlushAsync(CancellationToken ct = default)
     {
-        _driver.Flush();
+        lock (_frameLock)
+        {
+            FlushFrame();
+        }
         return ValueTask.CompletedTask;
     }
 
@@ -321,7 +380,9 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
         // Piggyback an OSC 11 background-colour query on the same probe pass.
         // Both responses arrive on stdin and are demuxed by signature.
         _driver.Write(BackgroundProbeQuery);
+        _driver.Write(SyncOutputProbeQuery);
         _driver.Flush();
+        _writeCallsAtLastFlush = _driver.WriteCalls;
 
         var bufferedInput = new List<byte>();
         var readBuffer = new byte[256];
@@ -351,7 +412,14 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
                     _backgroundProbeCompleted = true;
                 }
 
-                if (_capabilities.SupportsKgp && _backgroundProbeCompleted)
+                if (!_syncOutputProbeCompleted &&
+                    TryConsumeSyncOutputProbeResponse(bufferedInput, out var syncSupported))
+                {
+                    _capabilities = _capabilities with { SupportsSynchronizedOutput = syncSupported };
+                    _syncOutputProbeCompleted = true;
+                }
+
+                if (_capabilities.SupportsKgp && _backgroundProbeCompleted && _syncOutputProbeCompleted)
                     break;
             }
         }
@@ -488,6 +556,35 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
         return false;
     }
 
+    /// <summary>
+    /// Scans the buffered input for the DECRQM reply about mode 2026:
+    /// <c>ESC [ ? 2026 ; Ps $ y</c>. Ps 1 (set), 2 (reset) and 3 (permanently set) mean
+    /// the terminal can synchronize output; 0 (unknown) and 4 (permanently reset) mean it can't.
+    /// </summary>
+    private static bool TryConsumeSyncOutputProbeResponse(List<byte> buffer, out bool supported)
+    {
+        supported = false;
+        ReadOnlySpan<byte> prefix = "\x1b[?2026;"u8;
+        var span = CollectionsMarshal.AsSpan(buffer);
+        var start = span.IndexOf(prefix);
+        if (start < 0)
+            return false;
+
+        var end = start + prefix.Length;
+        while (end < span.Length && span[end] is >= (byte)'0' and <= (byte)'9')
+            end++;
+
+        if (end + 1 >= span.Length)
+            return false; // reply incomplete; wait for more bytes
+        if (span[end] != (byte)'$' || span[end + 1] != (byte)'y')
+            return false;
+
+        var status = span[(start + prefix.Length)..end];
+        supported = status.Length == 1 && status[0] is (byte)'1' or (byte)'2' or (byte)'3';
+        buffer.RemoveRange(start, end + 2 - start);
+        return true;
+    }
+
     private static bool TryParseRgbColor(string payload, out int rgb)
     {
         rgb = 0;
@@ -549,6 +646,12 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
         if (_disposed) return;
         _disposed = true;
 
+        // Close any open frame so the terminal doesn't stay in synchronized update mode
+        lock (_frameLock)
+        {
+            FlushFrame();
+        }
+
         Disconnected?.Invoke();
 
         if (_inRawMode)
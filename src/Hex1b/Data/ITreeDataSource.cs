@@ -0,0 +1,61 @@
+using Hex1b.Widgets;
+
+namespace Hex1b.Data;
+
+/// <summary>
+/// Provides the items of a <see cref="TreeWidget"/> on demand, for hierarchies too large
+/// to build as <see cref="TreeItemWidget"/>s up front.
+/// </summary>
+/// <typeparam name="T">The item type.</typeparam>
+/// <remarks>
+/// <para>
+/// The tree asks for the top-level items once and for an item's children the first time
+/// it is expanded, keeping them for later expansions. Only the rows in and around the
+/// viewport get a <see cref="TreeItemNode"/>, so a filesystem or trace browser with
+/// millions of loaded items costs no more per frame than one with a screenful.
+/// </para>
+/// <para>
+/// While a load is in flight the item shows a spinner. To show changed data, bind the
+/// tree to a new data source instance. If loading the top-level items fails or is
+/// cancelled, the tree asks again on its next reconcile.
+/// </para>
+/// <para>
+/// Items from a data source have no <see cref="TreeItemWidget"/>, so there are no
+/// <see cref="TreeItemWidget.OnExpanded(Action{Hex1b.Events.TreeItemExpandedEventArgs})"/> or
+/// <see cref="TreeItemWidget.OnCollapsed(Action{Hex1b.Events.TreeItemCollapsedEventArgs})"/>
+/// handlers to raise when they are toggled. Children are requested through
+/// <see cref="GetChildrenAsync"/> on the first expansion instead.
+/// </para>
+/// <para>
+/// For a hierarchy that already lives in memory, use <see cref="TreeDataSource{T}"/>.
+/// </para>
+/// </remarks>
+public interface ITreeDataSource<T>
+{
+    /// <summary>
+    /// Returns the top-level items.
+    /// </summary>
+    ValueTask<IReadOnlyList<T>> GetRootsAsync(CancellationToken cancellationToken = default);
+
+    /// <summary>
+    /// Returns the children of <paramref name="parent"/>. Only called for items that
+    /// <see cref="HasChildren"/> reports as having children.
+    /// </summary>
+    ValueTask<IReadOnlyList<T>> GetChildrenAsync(T parent, CancellationToken cancellationToken = default);
+
+    /// <summary>
+    /// Whether the item can be expanded. Called without loading its children, so it may
+    /// be a hint (an empty directory still shows an expand indicator).
+    /// </summary>
+    bool HasChildren(T item);
+
+    /// <summary>
+    /// Returns the label shown for the item.
+    /// </summary>
+    string GetLabel(T item);
+
+    /// <summary>
+    /// Returns the icon shown before the label, or null for none.
+    /// </summary>
+    string? GetIcon(T item);
+}
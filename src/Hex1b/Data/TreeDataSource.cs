@@ -0,0 +1,50 @@
+namespace Hex1b.Data;
+
+/// <summary>
+/// An <see cref="ITreeDataSource{T}"/> over a hierarchy that already lives in memory,
+/// described by selectors. Serves every request synchronously.
+/// </summary>
+/// <typeparam name="T">The item type.</typeparam>
+public sealed class TreeDataSource<T> : ITreeDataSource<T>
+{
+    private readonly IReadOnlyList<T> _roots;
+    private readonly Func<T, IReadOnlyList<T>> _childrenSelector;
+    private readonly Func<T, string> _labelSelector;
+    private readonly Func<T, string?>? _iconSelector;
+
+    /// <summary>
+    /// Wraps <paramref name="roots"/> and the hierarchy below them.
+    /// </summary>
+    /// <param name="roots">The top-level items.</param>
+    /// <param name="childrenSelector">Returns an item's children.</param>
+    /// <param name="labelSelector">Returns an item's label.</param>
+    /// <param name="iconSelector">Optionally returns an item's icon.</param>
+    public TreeDataSource(
+        IReadOnlyList<T> roots,
+        Func<T, IReadOnlyList<T>> childrenSelector,
+        Func<T, string> labelSelector,
+        Func<T, string?>? iconSelector = null)
+    {
+        _roots = roots ?? throw new ArgumentNullException(nameof(roots));
+        _childrenSelector = childrenSelector ?? throw new ArgumentNullException(nameof(childrenSelector));
+        _labelSelector = labelSelector ?? throw new ArgumentNullException(nameof(labelSelector));
+        _iconSelector = iconSelector;
+    }
+
+    /// <inheritdoc />
+    public ValueTask<IReadOnlyList<T>> GetRootsAsync(CancellationToken cancellationToken = default)
+        => ValueTask.FromResult(_roots);
+
+    /// <inheritdoc />
+    public ValueTask<IReadOnlyList<T>> GetChildrenAsync(T parent, CancellationToken cancellationToken = default)
+        => ValueTask.FromResult(_childrenSelector(parent));
+
+    /// <inheritdoc />
+    public bool HasChildren(T item) => _childrenSelector(item).Count > 0;
+
+    /// <inheritdoc />
+    public string GetLabel(T item) => _labelSelector(item);
+
+    /// <inheritdoc />
+    public string? GetIcon(T item) => _iconSelector?.Invoke(item);
+}
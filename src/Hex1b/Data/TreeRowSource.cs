@@ -0,0 +1,64 @@
+namespace Hex1b.Data;
+
+/// <summary>
+/// Untyped view of an <see cref="ITreeDataSource{T}"/> for <see cref="TreeNode"/>, which
+/// isn't generic over the item type.
+/// </summary>
+internal interface ITreeRowSource
+{
+    /// <summary>
+    /// The wrapped data source; trees reload only when this changes.
+    /// </summary>
+    object Source { get; }
+
+    ValueTask<IReadOnlyList<TreeRow>> GetRootsAsync(CancellationToken cancellationToken);
+
+    ValueTask<IReadOnlyList<TreeRow>> GetChildrenAsync(TreeRow parent, CancellationToken cancellationToken);
+
+    /// <summary>
+    /// The icon and label as <see cref="TreeItemNode.GetDisplayText"/> would return them.
+    /// </summary>
+    string GetDisplayText(TreeRow row);
+
+    /// <summary>
+    /// Fills in the label, icon and data of an item node for the row.
+    /// </summary>
+    void Describe(TreeRow row, TreeItemNode node);
+}
+
+internal sealed class TreeRowSource<T>(ITreeDataSource<T> source) : ITreeRowSource
+{
+    public object Source => source;
+
+    public async ValueTask<IReadOnlyList<TreeRow>> GetRootsAsync(CancellationToken cancellationToken)
+        => CreateRows(await source.GetRootsAsync(cancellationToken).ConfigureAwait(false));
+
+    public async ValueTask<IReadOnlyList<TreeRow>> GetChildrenAsync(TreeRow parent, CancellationToken cancellationToken)
+        => CreateRows(await source.GetChildrenAsync((T)parent.Item!, cancellationToken).ConfigureAwait(false));
+
+    public string GetDisplayText(TreeRow row)
+    {
+        var item = (T)row.Item!;
+        var label = source.GetLabel(item);
+        return source.GetIcon(item) is { } icon ? $"{icon} {label}" : label;
+    }
+
+    public void Describe(TreeRow row, TreeItemNode node)
+    {
+        var item = (T)row.Item!;
+        node.Label = source.GetLabel(item);
+        node.Icon = source.GetIcon(item);
+        node.DataValue = item;
+        node.DataType = typeof(T);
+    }
+
+    private TreeRow[] CreateRows(IReadOnlyList<T> items)
+    {
+        var rows = new TreeRow[items.Count];
+        for (int i = 0; i < rows.Length; i++)
+        {
+            rows[i] = new TreeRow { Item = items[i], HasChildren = source.HasChildren(items[i]) };
+        }
+        return rows;
+    }
+}
@@ -23,6 +23,11 @@ namespace Hex1b.Diagnostics;
 ///   <item>Capturing terminal state as ANSI or SVG</item>
 ///   <item>Injecting input characters</item>
 /// </list>
+/// <para>
+/// When the screen mirror is enabled, the filter also publishes the visible screen to
+/// ~/.hex1b/sockets/[pid].diagnostics.screen after every output batch. Readers open it
+/// with <see cref="TerminalScreenMirrorReader"/> instead of sending capture requests.
+/// </para>
 /// </remarks>
 public sealed class McpDiagnosticsPresentationFilter : ITerminalAwarePresentationFilter, IAsyncDisposable
 {
@@ -34,6 +39,8 @@ public sealed class McpDiagnosticsPresentationFilter : ITerminalAwarePresentatio
     private readonly object _inputLock = new();
     private readonly List<AttachSession> _sessions = [];
     private readonly object _attachLock = new();
+    private readonly TerminalScreenMirror? _screenMirror;
+    private readonly object _screenMirrorLock = new();
     private AttachSession? _leaderSession;
     
     // Terminal mode state for attach replay
@@ -52,6 +59,11 @@ public sealed class McpDiagnosticsPresentationFilter : ITerminalAwarePresentatio
     /// </summary>
     public string SocketPath => _socketPath;
 
+    /// <summary>
+    /// Gets the screen mirror path, or null if the screen mirror is disabled.
+    /// </summary>
+    public string? ScreenMirrorPath => _screenMirror?.Path;
+
     /// <summary>
     /// Gets the application name.
     /// </summary>
@@ -76,13 +88,16 @@ public sealed class McpDiagnosticsPresentationFilter : ITerminalAwarePresentatio
     /// Creates a new MCP diagnostics presentation filter.
     /// </summary>
     /// <param name="appName">Optional application name. Defaults to the entry assembly name.</param>
-    public McpDiagnosticsPresentationFilter(string? appName = null)
+    /// <param name="enableScreenMirror">Publish the screen to a shared-memory file next to the socket.</param>
+    public McpDiagnosticsPresentationFilter(string? appName = null, bool enableScreenMirror = false)
     {
         _appName = appName 
             ?? System.Reflection.Assembly.GetEntryAssembly()?.GetName().Name 
             ?? "Hex1bApp";
         _startTime = DateTimeOffset.UtcNow;
         _socketPath = GetSocketPath();
+        if (enableScreenMirror)
+            _screenMirror = new TerminalScreenMirror(TerminalScreenMirrorReader.GetMirrorPath(_socketPath));
     }
 
     /// <summary>
@@ -125,6 +140,7 @@ public sealed class McpDiagnosticsPresentationFilter : ITerminalAwarePresentatio
     public ValueTask OnSessionStartAsync(int width, int height, DateTimeOffset timestamp, CancellationToken ct = default)
     {
         StartListening();
+        UpdateScreenMirror();
         return ValueTask.CompletedTask;
     }
 
@@ -153,6 +169,8 @@ public sealed class McpDiagnosticsPresentationFilter : ITerminalAwarePresentatio
             }
         }
 
+        UpdateScreenMirror();
+
         // Broadcast to attached clients if any
         lock (_attachLock)
         {
@@ -187,6 +205,7 @@ public sealed class McpDiagnosticsPresentationFilter : ITerminalAwarePresentatio
     /// <inheritdoc />
     public ValueTask OnResizeAsync(int width, int height, TimeSpan elapsed, CancellationToken ct = default)
     {
+        UpdateScreenMirror();
         return ValueTask.CompletedTask;
     }
 
@@ -196,6 +215,27 @@ public sealed class McpDiagnosticsPresentationFilter : ITerminalAwarePresentatio
         return DisposeAsync();
     }
 
+    private void UpdateScreenMirror()
+    {
+        if (_screenMirror == null || _terminal == null)
+            return;
+
+        lock (_screenMirrorLock)
+        {
+            if (_disposed)
+                return;
+
+            try
+            {
+                _screenMirror.Update(_terminal);
+            }
+            catch (IOException)
+            {
+                // The mirror is best-effort; capture requests still work without it
+            }
+        }
+    }
+
     // === Socket Handling ===
 
     private void StartListening()
@@ -989,7 +1029,7 @@ public sealed class McpDiagnosticsPresentationFilter : ITerminalAwarePresentatio
             IdleTimeLimit = request.IdleLimit is > 0 ? (float)request.IdleLimit.Value : null
         };
 
-        _recorder.StartRecording(request.FilePath, options);
+        await _recorder.StartRecordingAsync(request.FilePath, options);
 
         // Synthesize current terminal state as the first event
         if (_terminal != null)
@@ -1071,6 +1111,15 @@ public sealed class McpDiagnosticsPresentationFilter : ITerminalAwarePresentatio
             catch { /* ignore */ }
         }
 
+        // Remove the screen mirror (readers see it closed)
+        if (_screenMirror != null)
+        {
+            lock (_screenMirrorLock)
+            {
+                _screenMirror.Dispose();
+            }
+        }
+
         // Clean up socket file
         try
         {
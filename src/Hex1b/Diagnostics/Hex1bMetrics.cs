@@ -72,6 +72,12 @@ public sealed class Hex1bMetrics : IDisposable
     /// <summary>ANSI tokens parsed from workload output per pump cycle.</summary>
     public Histogram<int> TerminalOutputTokens { get; }
 
+    /// <summary>Write system calls made per flushed frame by the console presentation.</summary>
+    public Histogram<int> TerminalOutputWriteCalls { get; }
+
+    /// <summary>Workload output bytes applied to the buffer but not forwarded because frames were skipped.</summary>
+    public Counter<long> TerminalOutputSkippedBytes { get; }
+
     // --- Terminal input pump ---
 
     /// <summary>Raw bytes read from presentation adapter per read.</summary>
@@ -83,6 +89,28 @@ public sealed class Hex1bMetrics : IDisposable
     /// <summary>Structured events dispatched to workload (tagged by <c>type</c>: key, mouse, resize).</summary>
     public Counter<long> TerminalInputEvents { get; }
 
+    // --- Asciinema recorder ---
+
+    /// <summary>Events queued in an <see cref="AsciinemaRecorder"/> when its writer starts a batch.</summary>
+    public Histogram<int> RecorderQueueDepth { get; }
+
+    /// <summary>Time to serialize and write one batch of recorded events.</summary>
+    public Histogram<double> RecorderWriteDuration { get; }
+
+    /// <summary>Recorded events discarded because the recorder queue was full.</summary>
+    public Counter<long> RecorderDroppedEvents { get; }
+
+    /// <summary>Recorded output events merged into a preceding event because the recorder queue was full.</summary>
+    public Counter<long> RecorderCoalescedEvents { get; }
+
+    // --- Animation ---
+
+    /// <summary>Animation clock ticks, each re-rendering every panel with running animations.</summary>
+    public Counter<long> AnimationTickCount { get; }
+
+    /// <summary>Running animations per animation clock tick.</summary>
+    public Histogram<int> AnimationActiveCount { get; }
+
     // --- Per-node timing (opt-in) ---
 
     /// <summary>Per-node measure phase duration (tagged by <c>node</c> path).</summary>
@@ -158,12 +186,24 @@ public sealed class Hex1bMetrics : IDisposable
         // Terminal output pump
         TerminalOutputBytes = Meter.CreateHistogram<int>("hex1b.terminal.output.bytes", "By", "Bytes written to presentation per write");
         TerminalOutputTokens = Meter.CreateHistogram<int>("hex1b.terminal.output.tokens", "{token}", "ANSI tokens from workload output per pump cycle");
+        TerminalOutputWriteCalls = Meter.CreateHistogram<int>("hex1b.terminal.output.write_calls", "{call}", "Write syscalls per flushed frame");
+        TerminalOutputSkippedBytes = Meter.CreateCounter<long>("hex1b.terminal.output.skipped_bytes", "By", "Workload output bytes not forwarded while skipping frames");
 
         // Terminal input pump
         TerminalInputBytes = Meter.CreateHistogram<int>("hex1b.terminal.input.bytes", "By", "Raw bytes from presentation per read");
         TerminalInputTokens = Meter.CreateHistogram<int>("hex1b.terminal.input.tokens", "{token}", "ANSI tokens from raw input per read");
         TerminalInputEvents = Meter.CreateCounter<long>("hex1b.terminal.input.events", "{event}", "Events dispatched to workload");
 
+        // Asciinema recorder
+        RecorderQueueDepth = Meter.CreateHistogram<int>("hex1b.recorder.queue.depth", "{event}", "Recorder events queued per write batch");
+        RecorderWriteDuration = Meter.CreateHistogram<double>("hex1b.recorder.write.duration", "ms", "Recorder batch write duration");
+        RecorderDroppedEvents = Meter.CreateCounter<long>("hex1b.recorder.events.dropped", "{event}", "Recorder events dropped under backpressure");
+        RecorderCoalescedEvents = Meter.CreateCounter<long>("hex1b.recorder.events.coalesced", "{event}", "Recorder output events coalesced under backpressure");
+
+        // Animation
+        AnimationTickCount = Meter.CreateCounter<long>("hex1b.animation.ticks", "{tick}", "Animation clock ticks");
+        AnimationActiveCount = Meter.CreateHistogram<int>("hex1b.animation.active", "{animation}", "Running animations per animation tick");
+
         // Surface pipeline (always-on)
         SurfaceDiffDuration = Meter.CreateHistogram<double>("hex1b.surface.diff.duration", "ms", "Surface diff duration");
         SurfaceDiffFastPathCount = Meter.CreateCounter<long>("hex1b.surface.diff.fast_path", "{diff}", "Surface diffs that took the 4-field fast path");
@@ -0,0 +1,303 @@
+using System.Buffers.Binary;
+using System.IO.MemoryMappedFiles;
+using Hex1b.Theming;
+
+namespace Hex1b.Diagnostics;
+
+/// <summary>
+/// Publishes the visible screen of a terminal into a memory-mapped file next to its
+/// diagnostics socket, so monitoring tools can read it without a socket round trip.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The file holds a fixed 64-byte header followed by <c>Capacity</c> cell records of
+/// <see cref="CellSize"/> bytes each, row-major. All integers are little-endian.
+/// </para>
+/// <para>
+/// Updates are protected by a seqlock: the writer makes the sequence odd, rewrites the
+/// header and any changed rows, then makes it even again. Readers copy the image and
+/// retry if the sequence was odd or changed while they were copying; see
+/// <see cref="TerminalScreenMirrorReader"/>.
+/// </para>
+/// <para>
+/// When the screen grows past the file's capacity the writer marks the old file closed
+/// and replaces it with a larger one at the same path; readers reopen when they see the
+/// closed flag.
+/// </para>
+/// </remarks>
+internal sealed unsafe class TerminalScreenMirror : IDisposable
+{
+    internal const uint Magic = 0x4D535848; // "HXSM"
+    internal const ushort FormatVersion = 1;
+    internal const int HeaderSize = 64;
+    internal const int CellSize = 40;
+
+    // Header field offsets
+    internal const int MagicOffset = 0;
+    internal const int VersionOffset = 4;
+    internal const int CellSizeOffset = 6;
+    internal const int SequenceOffset = 8;
+    internal const int GenerationOffset = 16;
+    internal const int WidthOffset = 24;
+    internal const int HeightOffset = 28;
+    internal const int CursorXOffset = 32;
+    internal const int CursorYOffset = 36;
+    internal const int FlagsOffset = 40;
+    internal const int CapacityOffset = 44;
+    internal const int TimestampOffset = 48;
+    internal const int ProcessIdOffset = 56;
+
+    // Header flags
+    internal const int FlagCursorVisible = 1 << 0;
+    internal const int FlagAlternateScreen = 1 << 1;
+    internal const int FlagClosed = 1 << 8;
+
+    // Cell record layout: UTF-16 text (4 units), fg, bg, underline color, attributes,
+    // text length, cell flags, underline style.
+    internal const int MaxTextLength = 4;
+    internal const int CellForegroundOffset = 8;
+    internal const int CellBackgroundOffset = 16;
+    internal const int CellUnderlineColorOffset = 24;
+    internal const int CellAttributesOffset = 32;
+    internal const int CellTextLengthOffset = 34;
+    internal const int CellFlagsOffset = 35;
+    internal const int CellUnderlineStyleOffset = 36;
+
+    // Cell flags
+    internal const byte CellFlagTruncated = 1 << 0;
+    internal const byte CellFlagHyperlink = 1 << 1;
+    internal const byte CellFlagSixel = 1 << 2;
+
+    private const int MinimumCapacity = 200 * 60;
+
+    private readonly string _path;
+    private MemoryMappedFile? _file;
+    private MemoryMappedViewAccessor? _view;
+    private byte* _base;
+    private int _capacity;
+    private long _sequence;
+
+    // Rows written by the previous update. Screen rows are shared copy-on-write, so a
+    // row whose array is unchanged since the last update has not been written to.
+    private TerminalCell[]?[] _lastRows = [];
+    private int _lastWidth = -1;
+    private long _lastGeneration = -1;
+    private int _lastFlags = -1;
+
+    public TerminalScreenMirror(string path)
+    {
+        _path = path;
+    }
+
+    /// <summary>
+    /// Gets the mirror file path.
+    /// </summary>
+    public string Path => _path;
+
+    /// <summary>
+    /// Writes the terminal's current screen into the mirror. Rows that haven't changed since
+    /// the previous update are skipped.
+    /// </summary>
+    public void Update(Hex1bTerminal terminal)
+    {
+        var flags = (terminal.CursorVisible ? FlagCursorVisible : 0)
+            | (terminal.InAlternateScreen ? FlagAlternateScreen : 0);
+        // Every applied output batch (cursor movement included) and every resize bumps
+        // the screen generation, so an unchanged generation means nothing to publish.
+        if (_file != null && terminal.ScreenGeneration == _lastGeneration && flags == _lastFlags)
+            return;
+
+        var pinned = terminal.PinScreen(0);
+        var width = pinned.Width;
+        var height = pinned.Height;
+
+        if (_file == null || width * height > _capacity)
+            Open(Math.Max(MinimumCapacity, width * height * 2));
+
+        if (width != _lastWidth || _lastRows.Length != height)
+        {
+            _lastRows = new TerminalCell[]?[height];
+            _lastWidth = width;
+        }
+
+        BeginWrite();
+
+        WriteInt64(GenerationOffset, pinned.Generation);
+        WriteInt32(WidthOffset, width);
+        WriteInt32(HeightOffset, height);
+        WriteInt32(CursorXOffset, pinned.CursorX);
+        WriteInt32(CursorYOffset, pinned.CursorY);
+        WriteInt32(FlagsOffset, flags);
+        WriteInt64(TimestampOffset, DateTimeOffset.UtcNow.ToUnixTimeMilliseconds());
+
+        for (int y = 0; y < height; y++)
+        {
+            var row = pinned.ScreenRows[y];
+            if (ReferenceEquals(row, _lastRows[y]))
+                continue;
+
+            var record = new Span<byte>(_base + HeaderSize + (long)y * width * CellSize, width * CellSize);
+            for (int x = 0; x < width; x++)
+            {
+                var cell = x < row.Length ? row[x] : TerminalCell.Empty;
+                WriteCell(record.Slice(x * CellSize, CellSize), cell);
+            }
+            _lastRows[y] = row;
+        }
+
+        EndWrite();
+
+        _lastGeneration = pinned.Generation;
+        _lastFlags = flags;
+    }
+
+    private void Open(int capacity)
+    {
+        Close(deleteFile: false);
+
+        // Replace rather than truncate: readers that still map the old file see it
+        // closed and reopen the path, instead of reading a file that shrank under them.
+        try { File.Delete(_path); }
+        catch (IOException) { }
+
+        var size = HeaderSize + (long)capacity * CellSize;
+        var options = new FileStreamOptions
+        {
+            Mode = FileMode.CreateNew,
+            Access = FileAccess.ReadWrite,
+            Share = FileShare.ReadWrite | FileShare.Delete,
+        };
+        if (!OperatingSystem.IsWindows())
+            options.UnixCreateMode = UnixFileMode.UserRead | UnixFileMode.UserWrite;
+
+        var stream = new FileStream(_path, options);
+        stream.SetLength(size);
+        _file = MemoryMappedFile.CreateFromFile(stream, null, size, MemoryMappedFileAccess.ReadWrite,
+            HandleInheritability.None, leaveOpen: false);
+        _view = _file.CreateViewAccessor(0, size, MemoryMappedFileAccess.ReadWrite);
+        _view.SafeMemoryMappedViewHandle.AcquirePointer(ref _base);
+        _base += _view.PointerOffset;
+        _capacity = capacity;
+        _sequence = 0;
+
+        WriteUInt32(MagicOffset, Magic);
+        WriteUInt16(VersionOffset, FormatVersion);
+        WriteUInt16(CellSizeOffset, CellSize);
+        WriteInt32(CapacityOffset, capacity);
+        WriteInt32(ProcessIdOffset, Environment.ProcessId);
+
+        // Every row has to be written into the new file
+        _lastRows = [];
+        _lastWidth = -1;
+    }
+
+    private void Close(bool deleteFile)
+    {
+        if (_view == null)
+            return;
+
+        // Tell readers still mapping this file that it's gone
+        BeginWrite();
+        WriteInt32(FlagsOffset, ReadInt32(FlagsOffset) | FlagClosed);
+        EndWrite();
+
+        _view.SafeMemoryMappedViewHandle.ReleasePointer();
+        _view.Dispose();
+        _file!.Dispose();
+        _view = null;
+        _file = null;
+        _base = null;
+
+        if (deleteFile)
+        {
+            try { File.Delete(_path); }
+            catch { /* ignore */ }
+        }
+    }
+
+    private void BeginWrite()
+    {
+        // Full fence: the odd sequence must be visible before any data store
+        Interlocked.Exchange(ref *(long*)(_base + SequenceOffset), ++_sequence);
+    }
+
+    private void EndWrite()
+    {
+        // Release: all data stores are visible before the even sequence
+        Volatile.Write(ref *(long*)(_base + SequenceOffset), ++_sequence);
+    }
+
+    private static void WriteCell(Span<byte> record, TerminalCell cell)
+    {
+        record.Clear();
+
+        var text = cell.Character.AsSpan();
+        var length = Math.Min(text.Length, MaxTextLength);
+        byte cellFlags = 0;
+        if (text.Length > MaxTextLength)
+            cellFlags |= CellFlagTruncated;
+        if (cell.TrackedHyperlink is not null)
+            cellFlags |= CellFlagHyperlink;
+        if (cell.TrackedSixel is not null)
+            cellFlags |= CellFlagSixel;
+
+        for (int i = 0; i < length; i++)
+            BinaryPrimitives.WriteUInt16LittleEndian(record[(i * 2)..], text[i]);
+
+        BinaryPrimitives.WriteUInt64LittleEndian(record[CellForegroundOffset..], PackColor(cell.Foreground));
+        BinaryPrimitives.WriteUInt64LittleEndian(record[CellBackgroundOffset..], PackColor(cell.Background));
+        BinaryPrimitives.WriteUInt64LittleEndian(record[CellUnderlineColorOffset..], PackColor(cell.UnderlineColor));
+        BinaryPrimitives.WriteUInt16LittleEndian(record[CellAttributesOffset..], (ushort)cell.Attributes);
+        record[CellTextLengthOffset] = (byte)length;
+        record[CellFlagsOffset] = cellFlags;
+        record[CellUnderlineStyleOffset] = (byte)cell.UnderlineStyle;
+    }
+
+    /// <summary>
+    /// Packs a color as R, G, B, ANSI index and a tag byte: 0 for no color, 1 for the
+    /// default color, otherwise 2 + <see cref="Hex1bColorKind"/>.
+    /// </summary>
+    internal static ulong PackColor(Hex1bColor? color)
+    {
+        if (color is not { } c)
+            return 0;
+
+        ulong tag = c.IsDefault ? 1UL : 2UL + (ulong)c.Kind;
+        return c.R | ((ulong)c.G << 8) | ((ulong)c.B << 16) | ((ulong)c.AnsiIndex << 24) | (tag << 32);
+    }
+
+    internal static Hex1bColor? UnpackColor(ulong packed)
+    {
+        var tag = (byte)(packed >> 32);
+        if (tag == 0)
+            return null;
+
+        var r = (byte)packed;
+        var g = (byte)(packed >> 8);
+        var b = (byte)(packed >> 16);
+        var index = (byte)(packed >> 24);
+        return tag switch
+        {
+            1 => Hex1bColor.Default,
+            2 + (int)Hex1bColorKind.Standard => Hex1bColor.FromStandard(index, r, g, b),
+            2 + (int)Hex1bColorKind.Bright => Hex1bColor.FromBright(index, r, g, b),
+            2 + (int)Hex1bColorKind.Indexed => Hex1bColor.FromIndexed(index, r, g, b),
+            _ => Hex1bColor.FromRgb(r, g, b),
+        };
+    }
+
+    private int ReadInt32(int offset) => BinaryPrimitives.ReadInt32LittleEndian(new ReadOnlySpan<byte>(_base + offset, 4));
+
+    private void WriteUInt16(int offset, ushort value) => BinaryPrimitives.WriteUInt16LittleEndian(new Span<byte>(_base + offset, 2), value);
+
+    private void WriteUInt32(int offset, uint value) => BinaryPrimitives.WriteUInt32LittleEndian(new Span<byte>(_base + offset, 4), value);
+
+    private void WriteInt32(int offset, int value) => BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(_base + offset, 4), value);
+
+    private void WriteInt64(int offset, long value) => BinaryPrimitives.WriteInt64LittleEndian(new Span<byte>(_base + offset, 8), value);
+
+    /// <summary>
+    /// Marks the mirror closed and deletes the file.
+    /// </summary>
+    public void Dispose() => Close(deleteFile: true);
+}
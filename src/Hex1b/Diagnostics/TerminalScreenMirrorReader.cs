@@ -0,0 +1,348 @@
+using System.Buffers.Binary;
+using System.IO.MemoryMappedFiles;
+using Hex1b.Automation;
+using Hex1b.Layout;
+
+namespace Hex1b.Diagnostics;
+
+/// <summary>
+/// Reads the shared-memory screen mirror that a terminal publishes next to its diagnostics
+/// socket when the mirror is enabled with <see cref="Hex1bTerminalBuilder.WithDiagnostics"/>.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Reading the mirror doesn't involve the terminal process at all: the screen image is
+/// copied out of the mapped file and validated against the writer's sequence counter, so
+/// pollers avoid the JSON request, the capture and the response serialization that a
+/// <c>capture</c> request over the socket costs.
+/// </para>
+/// <para>
+/// The mirror only holds the visible screen. Scrollback, images and hyperlink targets
+/// still need a capture request over the socket.
+/// </para>
+/// </remarks>
+public sealed unsafe class TerminalScreenMirrorReader : IDisposable
+{
+    private const int MaxReadAttempts = 64;
+
+    private readonly string _path;
+    private MemoryMappedFile? _file;
+    private MemoryMappedViewAccessor? _view;
+    private byte* _base;
+    private long _length;
+    private byte[] _buffer = [];
+    private long _lastSequence = -1;
+    private TerminalScreenMirrorFrame? _lastFrame;
+    private bool _disposed;
+
+    private TerminalScreenMirrorReader(string path)
+    {
+        _path = path;
+    }
+
+    /// <summary>
+    /// Gets the mirror file path.
+    /// </summary>
+    public string Path => _path;
+
+    /// <summary>
+    /// Gets the mirror file path that belongs to a diagnostics socket path.
+    /// </summary>
+    public static string GetMirrorPath(string socketPath)
+    {
+        const string socketSuffix = ".socket";
+        var basePath = socketPath.EndsWith(socketSuffix, StringComparison.Ordinal)
+            ? socketPath[..^socketSuffix.Length]
+            : socketPath;
+        return basePath + ".screen";
+    }
+
+    /// <summary>
+    /// Opens the mirror for a diagnostics socket, or returns null if the process doesn't
+    /// publish one.
+    /// </summary>
+    public static TerminalScreenMirrorReader? TryOpenForSocket(string socketPath)
+        => TryOpen(GetMirrorPath(socketPath));
+
+    /// <summary>
+    /// Opens a mirror file, or returns null if it doesn't exist or isn't a screen mirror.
+    /// </summary>
+    public static TerminalScreenMirrorReader? TryOpen(string path)
+    {
+        var reader = new TerminalScreenMirrorReader(path);
+        if (reader.Map())
+            return reader;
+
+        reader.Dispose();
+        return null;
+    }
+
+    /// <summary>
+    /// Reads the current screen image.
+    /// </summary>
+    /// <remarks>
+    /// Returns the previous frame instance when the writer hasn't published anything since
+    /// the last read, so polling an idle terminal doesn't copy or allocate. Returns null if
+    /// the writer has closed the mirror or kept it busy for every attempt.
+    /// </remarks>
+    public TerminalScreenMirrorFrame? TryRead()
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+
+        for (int attempt = 0; attempt < MaxReadAttempts; attempt++)
+        {
+            if (_base == null && !Map())
+                return null;
+
+            switch (TryCopy(out var frame))
+            {
+                case CopyResult.Success:
+                    return frame;
+                case CopyResult.Closed:
+                    // The writer replaced the file with a larger one (or exited); remap
+                    Unmap();
+                    if (!Map())
+                        return null;
+                    break;
+                case CopyResult.Busy:
+                    if (attempt > 8)
+                        Thread.Yield();
+                    break;
+            }
+        }
+
+        return null;
+    }
+
+    private enum CopyResult
+    {
+        Success,
+        Busy,
+        Closed,
+    }
+
+    private CopyResult TryCopy(out TerminalScreenMirrorFrame? frame)
+    {
+        frame = null;
+        var sequenceLocation = (long*)(_base + TerminalScreenMirror.SequenceOffset);
+
+        var before = Volatile.Read(ref *sequenceLocation);
+        if ((before & 1) != 0)
+            return CopyResult.Busy;
+
+        if (before == _lastSequence && _lastFrame != null)
+        {
+            frame = _lastFrame;
+            return CopyResult.Success;
+        }
+
+        var header = new ReadOnlySpan<byte>(_base, TerminalScreenMirror.HeaderSize);
+        var flags = BinaryPrimitives.ReadInt32LittleEndian(header[TerminalScreenMirror.FlagsOffset..]);
+        var width = BinaryPrimitives.ReadInt32LittleEndian(header[TerminalScreenMirror.WidthOffset..]);
+        var height = BinaryPrimitives.ReadInt32LittleEndian(header[TerminalScreenMirror.HeightOffset..]);
+        var size = TerminalScreenMirror.HeaderSize + (long)width * height * TerminalScreenMirror.CellSize;
+
+        if ((flags & TerminalScreenMirror.FlagClosed) != 0)
+            return Validate(sequenceLocation, before) ? CopyResult.Closed : CopyResult.Busy;
+
+        // A torn header can hold any dimensions; only trust them once the sequence checks out
+        if (width < 0 || height < 0 || size > _length)
+            return Validate(sequenceLocation, before) ? CopyResult.Closed : CopyResult.Busy;
+
+        if (_buffer.Length < size)
+            _buffer = new byte[size];
+        new ReadOnlySpan<byte>(_base, (int)size).CopyTo(_buffer);
+
+        if (!Validate(sequenceLocation, before))
+            return CopyResult.Busy;
+
+        frame = TerminalScreenMirrorFrame.Decode(_buffer.AsSpan(0, (int)size), width, height);
+        _lastSequence = before;
+        _lastFrame = frame;
+        return CopyResult.Success;
+    }
+
+    private static bool Validate(long* sequenceLocation, long before)
+    {
+        // Keep the data loads above from moving past the sequence re-read
+        Interlocked.MemoryBarrier();
+        return Volatile.Read(ref *sequenceLocation) == before;
+    }
+
+    private bool Map()
+    {
+        FileStream stream;
+        try
+        {
+            stream = new FileStream(_path, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete);
+        }
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+        {
+            return false;
+        }
+
+        if (stream.Length < TerminalScreenMirror.HeaderSize)
+        {
+            stream.Dispose();
+            return false;
+        }
+
+        _length = stream.Length;
+        _file = MemoryMappedFile.CreateFromFile(stream, null, 0, MemoryMappedFileAccess.Read,
+            HandleInheritability.None, leaveOpen: false);
+        _view = _file.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+        _view.SafeMemoryMappedViewHandle.AcquirePointer(ref _base);
+        _base += _view.PointerOffset;
+        _lastSequence = -1;
+
+        var header = new ReadOnlySpan<byte>(_base, TerminalScreenMirror.HeaderSize);
+        if (BinaryPrimitives.ReadUInt32LittleEndian(header) != TerminalScreenMirror.Magic
+            || BinaryPrimitives.ReadUInt16LittleEndian(header[TerminalScreenMirror.VersionOffset..]) != TerminalScreenMirror.FormatVersion
+            || BinaryPrimitives.ReadUInt16LittleEndian(header[TerminalScreenMirror.CellSizeOffset..]) != TerminalScreenMirror.CellSize)
+        {
+            Unmap();
+            return false;
+        }
+
+        return true;
+    }
+
+    private void Unmap()
+    {
+        if (_view == null)
+            return;
+
+        _view.SafeMemoryMappedViewHandle.ReleasePointer();
+        _view.Dispose();
+        _file!.Dispose();
+        _view = null;
+        _file = null;
+        _base = null;
+        _length = 0;
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        if (_disposed)
+            return;
+        _disposed = true;
+        Unmap();
+    }
+}
+
+/// <summary>
+/// A screen image read from a <see cref="TerminalScreenMirrorReader"/>.
+/// </summary>
+/// <remarks>
+/// Frames implement <see cref="IHex1bTerminalRegion"/>, so the usual text, search and
+/// rendering extensions work on them just like on a snapshot. Graphemes longer than four
+/// UTF-16 code units are truncated in the mirror.
+/// </remarks>
+public sealed class TerminalScreenMirrorFrame : IHex1bTerminalRegion
+{
+    private readonly TerminalCell[] _cells;
+
+    private TerminalScreenMirrorFrame(int width, int height, TerminalCell[] cells)
+    {
+        Width = width;
+        Height = height;
+        _cells = cells;
+    }
+
+    /// <summary>
+    /// The terminal's <see cref="Hex1bTerminal.ScreenGeneration"/> when the frame was published.
+    /// </summary>
+    public long Generation { get; private init; }
+
+    /// <inheritdoc />
+    public int Width { get; }
+
+    /// <inheritdoc />
+    public int Height { get; }
+
+    /// <summary>
+    /// Cursor X position when the frame was published.
+    /// </summary>
+    public int CursorX { get; private init; }
+
+    /// <summary>
+    /// Cursor Y position when the frame was published.
+    /// </summary>
+    public int CursorY { get; private init; }
+
+    /// <summary>
+    /// Whether the cursor was visible when the frame was published.
+    /// </summary>
+    public bool CursorVisible { get; private init; }
+
+    /// <summary>
+    /// Whether the terminal was in alternate screen mode when the frame was published.
+    /// </summary>
+    public bool InAlternateScreen { get; private init; }
+
+    /// <summary>
+    /// When the frame was published.
+    /// </summary>
+    public DateTimeOffset Timestamp { get; private init; }
+
+    /// <summary>
+    /// Process ID of the terminal that published the frame.
+    /// </summary>
+    public int ProcessId { get; private init; }
+
+    /// <inheritdoc />
+    public TerminalCell GetCell(int x, int y)
+    {
+        if (x < 0 || x >= Width || y < 0 || y >= Height)
+            return TerminalCell.Empty;
+        return _cells[y * Width + x];
+    }
+
+    /// <inheritdoc />
+    public Hex1bTerminalSnapshotRegion GetRegion(Rect bounds)
+    {
+        return new Hex1bTerminalSnapshotRegion(this, bounds);
+    }
+
+    internal static TerminalScreenMirrorFrame Decode(ReadOnlySpan<byte> image, int width, int height)
+    {
+        var header = image[..TerminalScreenMirror.HeaderSize];
+        var flags = BinaryPrimitives.ReadInt32LittleEndian(header[TerminalScreenMirror.FlagsOffset..]);
+
+        // Runs of identical text share one string, which covers blank screens and borders
+        var cells = new TerminalCell[width * height];
+        Span<char> text = stackalloc char[TerminalScreenMirror.MaxTextLength];
+        var lastText = " ";
+        for (int i = 0; i < cells.Length; i++)
+        {
+            var record = image.Slice(TerminalScreenMirror.HeaderSize + i * TerminalScreenMirror.CellSize, TerminalScreenMirror.CellSize);
+            var length = Math.Min((int)record[TerminalScreenMirror.CellTextLengthOffset], TerminalScreenMirror.MaxTextLength);
+            for (int c = 0; c < length; c++)
+                text[c] = (char)BinaryPrimitives.ReadUInt16LittleEndian(record[(c * 2)..]);
+
+            if (!lastText.AsSpan().SequenceEqual(text[..length]))
+                lastText = new string(text[..length]);
+
+            cells[i] = new TerminalCell(
+                lastText,
+                TerminalScreenMirror.UnpackColor(BinaryPrimitives.ReadUInt64LittleEndian(record[TerminalScreenMirror.CellForegroundOffset..])),
+                TerminalScreenMirror.UnpackColor(BinaryPrimitives.ReadUInt64LittleEndian(record[TerminalScreenMirror.CellBackgroundOffset..])),
+                (CellAttributes)BinaryPrimitives.ReadUInt16LittleEndian(record[TerminalScreenMirror.CellAttributesOffset..]),
+                UnderlineColor: TerminalScreenMirror.UnpackColor(BinaryPrimitives.ReadUInt64LittleEndian(record[TerminalScreenMirror.CellUnderlineColorOffset..])),
+                UnderlineStyle: (UnderlineStyle)record[TerminalScreenMirror.CellUnderlineStyleOffset]);
+        }
+
+        return new TerminalScreenMirrorFrame(width, height, cells)
+        {
+            Generation = BinaryPrimitives.ReadInt64LittleEndian(header[TerminalScreenMirror.GenerationOffset..]),
+            CursorX = BinaryPrimitives.ReadInt32LittleEndian(header[TerminalScreenMirror.CursorXOffset..]),
+            CursorY = BinaryPrimitives.ReadInt32LittleEndian(header[TerminalScreenMirror.CursorYOffset..]),
+            CursorVisible = (flags & TerminalScreenMirror.FlagCursorVisible) != 0,
+            InAlternateScreen = (flags & TerminalScreenMirror.FlagAlternateScreen) != 0,
+            Timestamp = DateTimeOffset.FromUnixTimeMilliseconds(
+                BinaryPrimitives.ReadInt64LittleEndian(header[TerminalScreenMirror.TimestampOffset..])),
+            ProcessId = BinaryPrimitives.ReadInt32LittleEndian(header[TerminalScreenMirror.ProcessIdOffset..]),
+        };
+    }
+}
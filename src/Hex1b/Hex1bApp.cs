@@ -49,6 +49,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
     private readonly RootContext _rootContext = new();
     private readonly FocusRing _focusRing = new();
     private readonly InputRouterState _inputRouterState = new();
+    private readonly List<Hex1bEvent> _inputBatch = [];
     private Hex1bNode? _rootNode;
     
     // Theme tracking for dirty detection when theme changes
@@ -218,6 +219,9 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
     // Animation timer for RedrawAfter() support
     private readonly AnimationTimer _animationTimer;
 
+    // Shared per-frame tick for StatePanel animations
+    private readonly AnimationClock _animationClock;
+
     // Minimum interval between rendered frames (paces the render loop, not just Schedule()).
     private readonly TimeSpan _frameRateLimit;
     // Timestamp of the last frame actually rendered. Used by the render loop
@@ -265,6 +269,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
         var frameRateLimitMs = Math.Max(1, options.FrameRateLimitMs);
         _animationTimer = new AnimationTimer(TimeSpan.FromMilliseconds(frameRateLimitMs));
         _frameRateLimit = TimeSpan.FromMilliseconds(frameRateLimitMs);
+        _animationClock = new AnimationClock(_animationTimer.MinimumInterval, ScheduleTimer, Invalidate, _metrics);
         
         // Check if mouse is enabled in options
         _mouseEnabled = options.EnableMouse;
@@ -467,6 +472,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
 
     /// <summary>
     /// Gets the last path debug info from input routing.
+    /// Only recorded while <see cref="Input.InputRouter.CaptureDebugInfo"/> is set.
     /// </summary>
     public string? LastPathDebug => Input.InputRouter.LastPathDebug;
 
@@ -603,34 +609,19 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
                             _inputCoalescingMaxDelayMs);
                         await Task.Delay(coalescingDelayMs, cancellationToken);
 
-                        while (_adapter.InputEvents.TryRead(out var delayedInput))
-                        {
-                            await ProcessInputEventAsync(delayedInput, cancellationToken);
-                            if (_stopRequested || cancellationToken.IsCancellationRequested)
-                                break;
-                        }
+                        await DrainInputAsync(cancellationToken);
                     }
                     else if (_enableInputCoalescing)
                     {
                         // Browser path: drain all already-queued events without delay.
-                        while (_adapter.InputEvents.TryRead(out var delayedInput))
-                        {
-                            await ProcessInputEventAsync(delayedInput, cancellationToken);
-                            if (_stopRequested || cancellationToken.IsCancellationRequested)
-                                break;
-                        }
+                        await DrainInputAsync(cancellationToken);
                     }
                 }
                 else
                 {
                     // Timer or invalidation woke us - drain ALL pending input first
                     // This ensures resize events are never starved by animation timers
-                    while (_adapter.InputEvents.TryRead(out var pendingInput))
-                    {
-                        await ProcessInputEventAsync(pendingInput, cancellationToken);
-                        if (_stopRequested || cancellationToken.IsCancellationRequested)
-                            break;
-                    }
+                    await DrainInputAsync(cancellationToken);
                 }
 
                 // Re-render after handling input or invalidation (state may have changed).
@@ -661,12 +652,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
                         break;
 
                     // ALWAYS process pending input before each re-render to prevent starvation
-                    while (_adapter.InputEvents.TryRead(out var pendingEvent))
-                    {
-                        await ProcessInputEventAsync(pendingEvent, cancellationToken);
-                        if (_stopRequested || cancellationToken.IsCancellationRequested)
-                            break;
-                    }
+                    await DrainInputAsync(cancellationToken);
                     
                     if (_stopRequested || cancellationToken.IsCancellationRequested)
                         break;
@@ -706,6 +692,47 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
         }
     }
 
+    /// <summary>
+    /// Processes every input event already queued. With input coalescing enabled, the batch is
+    /// merged first (<see cref="InputEventCoalescer"/>) so mouse motion, wheel and key-repeat
+    /// bursts are routed as one event each.
+    /// </summary>
+    private async Task DrainInputAsync(CancellationToken cancellationToken)
+    {
+        if (!_enableInputCoalescing)
+        {
+            while (_adapter.InputEvents.TryRead(out var pendingInput))
+            {
+                await ProcessInputEventAsync(pendingInput, cancellationToken);
+                if (_stopRequested || cancellationToken.IsCancellationRequested)
+                    return;
+            }
+            return;
+        }
+
+        var batch = _inputBatch;
+        batch.Clear();
+        while (_adapter.InputEvents.TryRead(out var pendingInput))
+        {
+            batch.Add(pendingInput);
+        }
+        InputEventCoalescer.Coalesce(batch);
+
+        try
+        {
+            foreach (var inputEvent in batch)
+            {
+                await ProcessInputEventAsync(inputEvent, cancellationToken);
+                if (_stopRequested || cancellationToken.IsCancellationRequested)
+                    return;
+            }
+        }
+        finally
+        {
+            batch.Clear();
+        }
+    }
+
     /// <summary>
     /// Processes a single input event (key, mouse, resize, etc.).
     /// </summary>
@@ -854,7 +881,12 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
 
                 if (isWheelDuringDrag)
                 {
-                    await DispatchWheelDuringDragAsync(mouseEvent, cancellationToken);
+                    // A merged wheel burst is offered to the handler whole; notches it doesn't
+                    // consume are dispatched one at a time
+                    for (var remaining = mouseEvent.RepeatCount; remaining > 0;)
+                    {
+                        remaining -= await DispatchWheelDuringDragAsync(mouseEvent with { RepeatCount = remaining }, cancellationToken);
+                    }
                     break;
                 }
 
@@ -882,7 +914,10 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
                 // Handle click events (button down) - may start a drag
                 if (mouseEvent.Action == MouseAction.Down && mouseEvent.Button != MouseButton.None)
                 {
-                    await HandleMouseClickAsync(mouseEvent, cancellationToken);
+                    for (var remaining = mouseEvent.RepeatCount; remaining > 0;)
+                    {
+                        remaining -= await HandleMouseClickAsync(mouseEvent with { RepeatCount = remaining }, cancellationToken);
+                    }
                 }
                 // Route other mouse events through InputRouter (for nodes that capture all input)
                 else if (_rootNode != null)
@@ -931,6 +966,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
         // The callback will mark nodes dirty, which is idempotent.
         
         var frameStart = Stopwatch.GetTimestamp();
+        _animationClock.BeginFrame(frameStart);
         
         // Update theme if we have a dynamic theme provider
         if (_themeProvider != null)
@@ -1012,6 +1048,13 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
             {
                 rootZStack.DragDropManager = _dragDropManager;
             }
+
+            // The tree and its bindings only change here, so input routing can reuse what it
+            // derives from them until the next reconcile
+            if (_rootNode != null)
+            {
+                _inputRouterState.ResetDispatchTable(_rootNode);
+            }
             
             reconcileTicks = Stopwatch.GetTimestamp() - reconcileFrameStart;
             if (_diagnosticTimingEnabled) _diagReconcileTicks = reconcileTicks;
@@ -1892,8 +1935,9 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
     /// <summary>
     /// Handles a mouse click by hit testing and routing through bindings.
     /// May initiate a drag if a drag binding matches.
+    /// Returns how many repeats of a merged wheel event were handled.
     /// </summary>
-    private async Task HandleMouseClickAsync(Hex1bMouseEvent mouseEvent, CancellationToken cancellationToken)
+    private async Task<int> HandleMouseClickAsync(Hex1bMouseEvent mouseEvent, CancellationToken cancellationToken)
     {
         // Defensively clear any stale pending bubble drag from a prior cycle
         // (e.g., if the previous mouse Up was missed because the cursor left
@@ -1935,9 +1979,12 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
                 var capturedActionContext = new InputBindingActionContext(
                     _focusRing, RequestStop, cancellationToken,
                     mouseEvent.X, mouseEvent.Y,
-                    CopyToClipboard, Invalidate, _windowManagerRegistry);
+                    CopyToClipboard, Invalidate, _windowManagerRegistry)
+                {
+                    RepeatCount = mouseEvent.RepeatCount
+                };
                 await matched.ExecuteAsync(capturedActionContext);
-                return;
+                return RepeatsHandled(capturedActionContext);
             }
         }
 
@@ -1949,7 +1996,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
             // Even when no focusable was hit, a non-focusable container in
             // the tree (e.g., SelectionPanel) may want to react on drag.
             TryArmBubbleDrag(eventWithClickCount, hitNode: null);
-            return;
+            return 1;
         }
         
         // Always focus the clicked node through the focus ring
@@ -1961,7 +2008,10 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
         var localY = mouseEvent.Y - hitNode.Bounds.Y;
         
         // Create action context for mouse bindings (includes mouse coordinates)
-        var actionContext = new InputBindingActionContext(_focusRing, RequestStop, cancellationToken, mouseEvent.X, mouseEvent.Y, CopyToClipboard, Invalidate, _windowManagerRegistry);
+        var actionContext = new InputBindingActionContext(_focusRing, RequestStop, cancellationToken, mouseEvent.X, mouseEvent.Y, CopyToClipboard, Invalidate, _windowManagerRegistry)
+        {
+            RepeatCount = mouseEvent.RepeatCount
+        };
         
         // Check if the node has a drag binding for this event
         // For multi-clicks (double/triple), check mouse bindings first since
@@ -1982,7 +2032,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
                 if (mouseBinding.Matches(eventWithClickCount))
                 {
                     await mouseBinding.ExecuteAsync(actionContext);
-                    return; // First match wins
+                    return RepeatsHandled(actionContext); // First match wins
                 }
             }
         }
@@ -2014,7 +2064,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
                     draggableNode.IsDragging = true;
                 }
                 
-                return;
+                return 1;
             }
         }
         
@@ -2026,7 +2076,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
                 if (mouseBinding.Matches(eventWithClickCount))
                 {
                     await mouseBinding.ExecuteAsync(actionContext);
-                    return; // First match wins
+                    return RepeatsHandled(actionContext); // First match wins
                 }
             }
         }
@@ -2039,8 +2089,16 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
         // click target). Only fires once the user actually moves the mouse,
         // so plain clicks on the hit focusable above were not affected.
         TryArmBubbleDrag(eventWithClickCount, hitNode);
+        return 1;
     }
 
+    /// <summary>
+    /// How many repeats of a merged wheel event a binding handled: all of them if it consumed
+    /// the repeat count, otherwise one.
+    /// </summary>
+    private static int RepeatsHandled(InputBindingActionContext context)
+        => context.RepeatCountConsumed ? context.RepeatCount : 1;
+
     /// <summary>
     /// Walks the full node tree to find drag bindings owned by nodes other
     /// than <paramref name="hitNode"/> whose <see cref="Hex1bNode.HitTestBounds"/>
@@ -2160,6 +2218,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
     /// synthetic <c>OnMove</c> on the active drag handler at the current
     /// mouse coordinates so the selection cursor follows the cell that
     /// scroll has just brought under the (stationary) mouse pointer.
+    /// Returns how many repeats of a merged wheel event were handled.
     /// </summary>
     /// <remarks>
     /// Walking up from <see cref="_activeDragNode"/> rather than hit-testing
@@ -2173,13 +2232,13 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
     /// handler relies on up-to-date bounds RIGHT NOW to compute the new
     /// cursor row from the mouse's current terminal coordinates.
     /// </remarks>
-    private async Task DispatchWheelDuringDragAsync(Hex1bMouseEvent mouseEvent, CancellationToken cancellationToken)
+    private async Task<int> DispatchWheelDuringDragAsync(Hex1bMouseEvent mouseEvent, CancellationToken cancellationToken)
     {
         var dragNode = _activeDragNode;
         var dragHandler = _activeDragHandler;
         if (dragNode is null || dragHandler is null)
         {
-            return;
+            return mouseEvent.RepeatCount;
         }
 
         // Defensive: if the drag-owning node has been reconciled out of the
@@ -2190,12 +2249,15 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
         {
             _activeDragHandler = null;
             _activeDragNode = null;
-            return;
+            return mouseEvent.RepeatCount;
         }
 
         var dragContext = new InputBindingActionContext(
             _focusRing, RequestStop, cancellationToken,
-            mouseEvent.X, mouseEvent.Y, CopyToClipboard, Invalidate, _windowManagerRegistry);
+            mouseEvent.X, mouseEvent.Y, CopyToClipboard, Invalidate, _windowManagerRegistry)
+        {
+            RepeatCount = mouseEvent.RepeatCount
+        };
 
         var matched = false;
         for (var n = dragNode; n != null; n = n.Parent)
@@ -2216,7 +2278,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
 
         // If no wheel binding fired, no scroll happened, so there's nothing
         // to follow with a synthetic OnMove.
-        if (!matched) return;
+        if (!matched) return mouseEvent.RepeatCount;
 
         // Force a synchronous layout pass so child Bounds reflect the
         // post-scroll state before the synthetic OnMove sees them. Without
@@ -2238,6 +2300,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
         var deltaX = mouseEvent.X - _dragStartX;
         var deltaY = mouseEvent.Y - _dragStartY;
         dragHandler.OnMove?.Invoke(dragContext, deltaX, deltaY);
+        return RepeatsHandled(dragContext);
     }
 
     private static bool ContainsNode(Hex1bNode root, Hex1bNode target)
@@ -2342,6 +2405,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable, IDiagnosticTreeProvider
         context.IsNew = existingNode is null || existingNode.GetType() != widget.GetExpectedNodeType();
         context.DiagnosticTimingEnabled = _diagnosticTimingEnabled;
         context.Metrics = _metrics.NodeReconcileDuration != null ? _metrics : null;
+        context.AnimationClock = _animationClock;
         
         // Delegate to the widget's own ReconcileAsync method
         long reconcileStart = 0;
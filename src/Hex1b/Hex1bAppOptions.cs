@@ -78,6 +78,9 @@ public class Hex1bAppOptions
     /// <summary>
     /// Whether to enable input coalescing. When enabled, multiple rapid inputs are
     /// batched together before rendering, improving performance under back pressure.
+    /// Queued bursts are also merged before routing: mouse motion collapses to the latest
+    /// position, wheel notches and repeated navigation keys become one event with a
+    /// repeat count (see <see cref="Input.InputBindingActionContext.ConsumeRepeatCount"/>).
     /// Disable for testing to ensure each input triggers a separate frame.
     /// Default is true.
     /// </summary>
@@ -60,6 +60,21 @@ public class Hex1bRenderContext
     /// </summary>
     public Hex1bColor AmbientBackground { get; set; } = Hex1bColor.Default;
 
+    /// <summary>
+    /// The part of the screen where rendered output can actually be seen, in absolute
+    /// coordinates, or null when nothing limits it. Scrolling containers narrow this to
+    /// their viewport while rendering their content, and layout containers skip children
+    /// that lie entirely outside it.
+    /// </summary>
+    public Rect? VisibleRect { get; set; }
+
+    /// <summary>
+    /// Whether a node with the given bounds lies entirely outside <see cref="VisibleRect"/>,
+    /// so rendering it cannot show anything. Empty bounds are never reported as outside.
+    /// </summary>
+    public bool IsOutsideVisibleRect(Rect bounds)
+        => VisibleRect is { } visible && bounds.Width > 0 && bounds.Height > 0 && !visible.IntersectsWith(bounds);
+
     public virtual void EnterAlternateScreen() => _adapter?.EnterTuiMode();
     public virtual void ExitAlternateScreen() => _adapter?.ExitTuiMode();
     public virtual void Write(string text) => _adapter?.Write(text);
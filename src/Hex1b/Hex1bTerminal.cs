@@ -70,7 +70,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
     private readonly object _bufferLock = new();
     private readonly SemaphoreSlim _workloadInputWriteLock = new(1, 1);
     
-    private TerminalCell[,] _screenBuffer;
+    private TerminalScreenBuffer _screenBuffer;
     private int _cursorX;
     private int _cursorY;
     private Hex1bColor? _currentForeground;
@@ -89,6 +89,14 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
     private readonly TaskCompletionSource<(string PumpName, Exception Error)> _pumpFaultTcs =
         new(TaskCreationOptions.RunContinuationsAsynchronously);
     private long _writeSequence; // Monotonically increasing write order counter
+
+    // Screen change tracking. _screenGeneration is bumped (under _bufferLock) once per
+    // applied token batch or resize; _rowGenerations records the generation at which each
+    // row's cells last changed so waiters can re-check only the dirty rows. The change
+    // signal is created lazily so terminals without waiters don't allocate per batch.
+    private long _screenGeneration;
+    private long[] _rowGenerations = Array.Empty<long>();
+    private TaskCompletionSource<long>? _screenChangedTcs;
     private int _savedCursorX; // Saved cursor X position for DECSC/DECRC
     private int _savedCursorY; // Saved cursor Y position for DECSC/DECRC
     private bool _cursorSaved; // Whether cursor has been saved (for restore without prior save)
@@ -135,10 +143,22 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         Channel.CreateUnbounded<PresentationInputEvent>(
             new UnboundedChannelOptions { SingleReader = true, SingleWriter = false });
     private ITimer? _escapeFlushTimer;
+
+    // Set when output was forwarded to the presentation since its last flush
+    private bool _presentationFramePending;
+
+    // Null unless frame skipping is enabled and the fast output path applies
+    private readonly TerminalFrameSkipper? _frameSkipper;
     
     // Scrollback buffer (opt-in via WithScrollback)
     private readonly ScrollbackBuffer? _scrollbackBuffer;
     private readonly Action<ScrollbackRowEventArgs>? _scrollbackCallback;
+
+    // Oldest scrollback rows a resize left at their previous widths (see ReflowResult.DeferredScrollbackRows).
+    // They are re-wrapped once resizing has been quiet for ReflowSettleDelay, or earlier when read.
+    private static readonly TimeSpan ReflowSettleDelay = TimeSpan.FromMilliseconds(150);
+    private int _deferredReflowRows;
+    private ITimer? _reflowSettleTimer;
     
     // Metrics instrumentation
     private readonly Diagnostics.Hex1bMetrics _metrics;
@@ -323,6 +343,15 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
             }
         }
         
+        // Notify terminal-aware workload filters
+        foreach (var filter in _workloadFilters)
+        {
+            if (filter is ITerminalAwareWorkloadFilter terminalAwareFilter)
+            {
+                terminalAwareFilter.SetTerminal(this);
+            }
+        }
+        
         // Get dimensions from presentation adapter (it's the source of truth)
         _width = _presentation.Width > 0 ? _presentation.Width : options.Width;
         _height = _presentation.Height > 0 ? _presentation.Height : options.Height;
@@ -330,7 +359,8 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         // Notify workload of initial dimensions (ResizeAsync handles not firing event on init)
         _ = _workload.ResizeAsync(_width, _height);
         
-        _screenBuffer = new TerminalCell[_height, _width];
+        _screenBuffer = new TerminalScreenBuffer(_height, _width);
+        _rowGenerations = new long[_height];
         _scrollBottom = _height - 1; // Default scroll region is full screen
         _marginRight = _width - 1; // Default left/right margins are full screen
         InitializeTabStops();
@@ -345,8 +375,18 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         }
         
         _metrics = options.Metrics ?? Diagnostics.Hex1bMetrics.Default;
+        if (_presentation is ConsolePresentationAdapter consolePresentation)
+            consolePresentation.Metrics = _metrics;
         _escapeTimeout = options.EscapeSequenceTimeout ?? TimeSpan.FromMilliseconds(50);
 
+        // Skipping replaces raw forwarding, so it can't apply when filters or the
+        // presentation need to see every token
+        if (options.FrameSkipInterval is { } frameSkipInterval && _workloadFilters.Count == 0
+            && _presentationFilters.Count == 0 && _presentation is not ICellImpactAwarePresentationAdapter)
+        {
+            _frameSkipper = new TerminalFrameSkipper(frameSkipInterval, _timeProvider);
+        }
+
         // Subscribe to presentation events
         _presentation.Resized += OnPresentationResized;
 
@@ -1355,6 +1395,35 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         };
     }
     
+    /// <summary>
+    /// Flushes the presentation once the workload has no more output queued, so everything
+    /// forwarded since the last flush goes out as one frame.
+    /// </summary>
+    private ValueTask FlushPresentationFrameAsync(CancellationToken ct)
+    {
+        if (!_presentationFramePending || _presentation is null)
+            return ValueTask.CompletedTask;
+
+        _presentationFramePending = false;
+        return _presentation.FlushAsync(ct);
+    }
+
+    /// <summary>
+    /// Called when the workload has no output waiting. Brings the presentation back in sync
+    /// if frames were being skipped, then flushes the frame.
+    /// </summary>
+    private async ValueTask EndOutputBurstAsync(CancellationToken ct)
+    {
+        if (_frameSkipper?.EndBurst(this) is { } state && _presentation is not null)
+        {
+            await _presentation.WriteOutputAsync(state, ct);
+            _metrics.TerminalOutputBytes.Record(state.Length);
+            _presentationFramePending = true;
+        }
+
+        await FlushPresentationFrameAsync(ct);
+    }
+
     private async Task PumpWorkloadOutputAsync(CancellationToken ct)
     {
         try
@@ -1369,7 +1438,12 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
 
                 if (_workload is IHex1bTerminalTokenWorkloadAdapter tokenWorkload)
                 {
-                    var item = await tokenWorkload.ReadOutputItemAsync(ct);
+                    var pendingItem = tokenWorkload.ReadOutputItemAsync(ct);
+                    if (!pendingItem.IsCompleted)
+                        await EndOutputBurstAsync(ct);
+                    else
+                        _frameSkipper?.OnOutputWaiting(this);
+                    var item = await pendingItem;
                     data = item.Bytes;
                     preTokenizedTokens = item.Tokens;
                     pooledItemBuffer = item.PooledBuffer;
@@ -1378,7 +1452,12 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 }
                 else
                 {
-                    data = await _workload.ReadOutputAsync(ct);
+                    var pendingData = _workload.ReadOutputAsync(ct);
+                    if (!pendingData.IsCompleted)
+                        await EndOutputBurstAsync(ct);
+                    else
+                        _frameSkipper?.OnOutputWaiting(this);
+                    data = await pendingData;
                 }
                 
                 if (data.IsEmpty)
@@ -1389,6 +1468,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                         pooledItemTokensReturn(pooledItemTokens);
 
                     // Channel empty - this is a frame boundary
+                    await EndOutputBurstAsync(ct);
                     await NotifyWorkloadFiltersFrameCompleteAsync();
                     
                     // Small delay to prevent busy-waiting in headless mode
@@ -1441,11 +1521,26 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                     // Still apply tokens to internal buffer so CreateSnapshot() works
                     ApplyTokens(tokens);
                     
+                    // While a flood is being skipped, send only the changed rows now and then
+                    if (_frameSkipper is { IsSkipping: true } && _presentation != null)
+                    {
+                        _metrics.TerminalOutputSkippedBytes.Add(data.Length);
+                        if (_frameSkipper.TakeDueRepaint(this) is { } repaint)
+                        {
+                            await _presentation.WriteOutputAsync(repaint, ct);
+                            _metrics.TerminalOutputBytes.Record(repaint.Length);
+                            _presentationFramePending = true;
+                            await FlushPresentationFrameAsync(ct);
+                        }
+                        continue;
+                    }
+
                     // Forward raw bytes to presentation if present
                     if (_presentation != null)
                     {
                         await _presentation.WriteOutputAsync(data, ct);
                         _metrics.TerminalOutputBytes.Record(data.Length);
+                        _presentationFramePending = true;
                     }
                     continue;
                 }
@@ -1459,6 +1554,8 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 // Forward to presentation if present
                 if (_presentation != null)
                 {
+                    _presentationFramePending = true;
+
                     // Check if presentation adapter wants cell impacts directly
                     if (_presentation is ICellImpactAwarePresentationAdapter impactAware)
                     {
@@ -1847,16 +1944,31 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
     internal bool MouseEncodingSgrEnabled => _mouseEncodingSgr;
     internal bool MouseEncodingUrxvtEnabled => _mouseEncodingUrxvt;
     internal int CursorShape => _cursorShape;
+    internal bool OriginModeEnabled => _originMode;
 
     /// <summary>
     /// The scrollback buffer, if one was configured via <see cref="Hex1bTerminalOptions.ScrollbackCapacity"/>.
     /// </summary>
-    internal ScrollbackBuffer? Scrollback => _scrollbackBuffer;
+    internal ScrollbackBuffer? Scrollback
+    {
+        get
+        {
+            lock (_bufferLock)
+            {
+                CompleteDeferredReflow();
+                return _scrollbackBuffer;
+            }
+        }
+    }
 
     /// <summary>
     /// Gets the number of rows currently stored in the scrollback buffer.
     /// Returns 0 if scrollback is not enabled.
     /// </summary>
+    /// <remarks>
+    /// Right after a resize this may still count older rows at their previous width; the
+    /// count changes when they are re-wrapped.
+    /// </remarks>
     public int ScrollbackCount
     {
         get
@@ -1878,6 +1990,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
     {
         lock (_bufferLock)
         {
+            CompleteDeferredReflow(count);
             return _scrollbackBuffer?.GetLines(count) ?? [];
         }
     }
@@ -1889,11 +2002,54 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
     /// <returns>A tuple containing the buffer copy, width, height, cursor X, and cursor Y.</returns>
     internal (TerminalCell[,] Buffer, int Width, int Height, int CursorX, int CursorY) GetScreenBufferSnapshot()
     {
+        TerminalCell[][] rows;
+        int width, height, cursorX, cursorY;
         lock (_bufferLock)
         {
-            var copy = new TerminalCell[_height, _width];
-            Array.Copy(_screenBuffer, copy, _screenBuffer.Length);
-            return (copy, _width, _height, _cursorX, _cursorY);
+            // Pinning is O(1); the copy below runs outside the lock so the output pump
+            // isn't stalled while it happens.
+            rows = _screenBuffer.Pin();
+            (width, height, cursorX, cursorY) = (_width, _height, _cursorX, _cursorY);
+        }
+
+        return (TerminalScreenBuffer.ToArray(rows, width), width, height, cursorX, cursorY);
+    }
+
+    /// <summary>
+    /// Gets the current graphic rendition (pen) and vertical scroll margins.
+    /// Thread-safe — acquires the buffer lock.
+    /// </summary>
+    /// <remarks>
+    /// Snapshots capture cells, cursor and modes but not the state that only affects
+    /// future output; this is what a replay needs on top of a snapshot to continue
+    /// writing exactly where the terminal left off.
+    /// </remarks>
+    internal (Hex1bColor? Foreground, Hex1bColor? Background, CellAttributes Attributes, int ScrollTop, int ScrollBottom) GetRenditionState()
+    {
+        lock (_bufferLock)
+        {
+            return (_currentForeground, _currentBackground, _currentAttributes, _scrollTop, _scrollBottom);
+        }
+    }
+
+    /// <summary>
+    /// Pins the current screen rows (and optionally the most recent scrollback rows) together
+    /// with the cursor position and screen generation, atomically and without copying cells.
+    /// </summary>
+    /// <remarks>
+    /// The returned row arrays are shared copy-on-write with the live terminal and must be
+    /// treated as read-only. Tracked objects in the pinned cells are not AddRef'd.
+    /// </remarks>
+    /// <param name="scrollbackLines">Number of scrollback rows to include. Zero means none.</param>
+    internal (TerminalCell[][] ScreenRows, ScrollbackRow[] ScrollbackRows, int Width, int Height, int CursorX, int CursorY, long Generation) PinScreen(int scrollbackLines)
+    {
+        lock (_bufferLock)
+        {
+            CompleteDeferredReflow(scrollbackLines);
+            var scrollbackRows = scrollbackLines > 0 && _scrollbackBuffer is not null
+                ? _scrollbackBuffer.GetLines(scrollbackLines)
+                : [];
+            return (_screenBuffer.Pin(), scrollbackRows, _width, _height, _cursorX, _cursorY, _screenGeneration);
         }
     }
 
@@ -1927,8 +2083,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
     {
         lock (_bufferLock)
         {
-            var copy = new TerminalCell[_height, _width];
-            Array.Copy(_screenBuffer, copy, _screenBuffer.Length);
+            var copy = _screenBuffer.ToArray();
             
             if (addTrackedObjectRefs)
             {
@@ -2140,6 +2295,143 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         }
     }
 
+    // === Screen Change Notification ===
+
+    /// <summary>
+    /// Gets the current screen generation.
+    /// </summary>
+    /// <remarks>
+    /// The generation increases every time a batch of workload output is applied to the
+    /// screen buffer or the terminal is resized. Two reads that return the same value
+    /// observed the same screen contents, so waiters can skip re-evaluating conditions
+    /// (and taking snapshots) until it changes. See <see cref="WaitForScreenChangeAsync"/>.
+    /// </remarks>
+    public long ScreenGeneration
+    {
+        get
+        {
+            lock (_bufferLock)
+            {
+                return _screenGeneration;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Waits until the screen generation advances past <paramref name="sinceGeneration"/>.
+    /// </summary>
+    /// <param name="sinceGeneration">The last generation the caller observed.</param>
+    /// <param name="ct">Cancellation token.</param>
+    /// <returns>
+    /// The new screen generation. Completes synchronously when the screen has already
+    /// changed since <paramref name="sinceGeneration"/>.
+    /// </returns>
+    public Task<long> WaitForScreenChangeAsync(long sinceGeneration, CancellationToken ct = default)
+    {
+        Task<long> changed;
+        lock (_bufferLock)
+        {
+            if (_screenGeneration > sinceGeneration)
+                return Task.FromResult(_screenGeneration);
+
+            _screenChangedTcs ??= new TaskCompletionSource<long>(TaskCreationOptions.RunContinuationsAsynchronously);
+            changed = _screenChangedTcs.Task;
+        }
+
+        return ct.CanBeCanceled ? changed.WaitAsync(ct) : changed;
+    }
+
+    /// <summary>
+    /// Gets the visible rows whose cells may have changed after <paramref name="sinceGeneration"/>.
+    /// </summary>
+    /// <remarks>
+    /// Row tracking is conservative: a row can be reported without any visible difference,
+    /// but a row whose cells changed is never omitted. After a resize every row is reported.
+    /// </remarks>
+    /// <param name="sinceGeneration">The last generation the caller observed.</param>
+    /// <returns>The 0-based indices of the changed rows, in ascending order.</returns>
+    public int[] GetChangedRows(long sinceGeneration)
+    {
+        lock (_bufferLock)
+        {
+            var count = 0;
+            for (int y = 0; y < _rowGenerations.Length; y++)
+            {
+                if (_rowGenerations[y] > sinceGeneration)
+                    count++;
+            }
+
+            if (count == 0)
+                return [];
+
+            var rows = new int[count];
+            var i = 0;
+            for (int y = 0; y < _rowGenerations.Length; y++)
+            {
+                if (_rowGenerations[y] > sinceGeneration)
+                    rows[i++] = y;
+            }
+            return rows;
+        }
+    }
+
+    /// <summary>
+    /// Checks whether any of the specified visible rows contains <paramref name="text"/>.
+    /// </summary>
+    /// <remarks>
+    /// Reads the rows directly under the buffer lock without copying the screen, which makes
+    /// it a cheap re-check for rows returned by <see cref="GetChangedRows"/>.
+    /// </remarks>
+    /// <param name="text">The text to search for.</param>
+    /// <param name="rows">The 0-based row indices to search. Out-of-range rows are ignored.</param>
+    public bool RowsContainText(string text, IReadOnlyList<int> rows)
+    {
+        ArgumentNullException.ThrowIfNull(text);
+        ArgumentNullException.ThrowIfNull(rows);
+
+        if (text.Length == 0)
+            return true;
+
+        lock (_bufferLock)
+        {
+            foreach (var y in rows)
+            {
+                if (y < 0 || y >= _height)
+                    continue;
+                if (GetLineInternal(y).Contains(text, StringComparison.Ordinal))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    // Must be called with _bufferLock held.
+    private void MarkRowsDirty(int firstRow, int lastRow)
+    {
+        var generation = _screenGeneration + 1;
+        var first = Math.Max(firstRow, 0);
+        var last = Math.Min(lastRow, _rowGenerations.Length - 1);
+        for (int y = first; y <= last; y++)
+            _rowGenerations[y] = generation;
+    }
+
+    // Must be called with _bufferLock held.
+    private void MarkAllRowsDirty() => MarkRowsDirty(0, _rowGenerations.Length - 1);
+
+    // Must be called with _bufferLock held. Rows marked since the previous publish carry
+    // the generation being published here.
+    private void PublishScreenChange()
+    {
+        _screenGeneration++;
+
+        var tcs = _screenChangedTcs;
+        if (tcs is not null)
+        {
+            _screenChangedTcs = null;
+            tcs.TrySetResult(_screenGeneration);
+        }
+    }
+
     /// <summary>
     /// Creates an immutable snapshot of the current terminal state.
     /// Useful for assertions and wait conditions in tests.
@@ -2193,6 +2485,10 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
             _scrollBottom = newHeight - 1;
             
             _pendingWrap = false;
+
+            _rowGenerations = new long[newHeight];
+            MarkAllRowsDirty();
+            PublishScreenChange();
         }
     }
 
@@ -2237,35 +2533,45 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         }
 
         // Apply the reflowed screen buffer
-        var newBuffer = new TerminalCell[newHeight, newWidth];
+        var newBuffer = new TerminalScreenBuffer(newHeight, newWidth);
         for (int y = 0; y < newHeight; y++)
         {
             if (y < result.ScreenRows.Length)
             {
                 for (int x = 0; x < newWidth && x < result.ScreenRows[y].Length; x++)
                 {
-                    newBuffer[y, x] = result.ScreenRows[y][x];
+                    newBuffer.GetCellForWrite(y, x) = result.ScreenRows[y][x];
                     // AddRef tracked objects in the new buffer
                     newBuffer[y, x].TrackedSixel?.AddRef();
                     newBuffer[y, x].TrackedHyperlink?.AddRef();
                 }
                 for (int x = result.ScreenRows[y].Length; x < newWidth; x++)
-                    newBuffer[y, x] = TerminalCell.Empty;
+                    newBuffer.GetCellForWrite(y, x) = TerminalCell.Empty;
             }
             else
             {
                 for (int x = 0; x < newWidth; x++)
-                    newBuffer[y, x] = TerminalCell.Empty;
+                    newBuffer.GetCellForWrite(y, x) = TerminalCell.Empty;
             }
         }
 
-        // Apply reflowed scrollback if scrollback is enabled
-        if (_scrollbackBuffer is not null)
+        // Apply reflowed scrollback if scrollback is enabled. Strategies that don't reflow
+        // hand the context's rows back; deferred rows are unchanged, so only the rows after
+        // them are replaced.
+        if (_scrollbackBuffer is not null && !ReferenceEquals(result.ScrollbackRows, scrollbackRows))
         {
-            _scrollbackBuffer.Clear();
-            foreach (var sbRow in result.ScrollbackRows)
+            int deferred = result.DeferredScrollbackRows;
+            int evicted = _scrollbackBuffer.Replace(deferred, scrollbackRows.Length - deferred,
+                new ArraySegment<ReflowScrollbackRow>(result.ScrollbackRows, deferred, result.ScrollbackRows.Length - deferred),
+                _timeProvider.GetUtcNow());
+
+            _deferredReflowRows = Math.Max(0, deferred - evicted);
+            if (_deferredReflowRows > 0)
             {
-                _scrollbackBuffer.Push(sbRow.Cells, sbRow.OriginalWidth, _timeProvider.GetUtcNow());
+                _reflowSettleTimer ??= _timeProvider.CreateTimer(
+                    OnReflowSettleTimerFired, null,
+                    Timeout.InfiniteTimeSpan, Timeout.InfiniteTimeSpan);
+                _reflowSettleTimer.Change(ReflowSettleDelay, Timeout.InfiniteTimeSpan);
             }
         }
 
@@ -2283,16 +2589,51 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         }
     }
 
+    private void OnReflowSettleTimerFired(object? state)
+    {
+        lock (_bufferLock)
+        {
+            if (!_disposed)
+                CompleteDeferredReflow();
+        }
+    }
+
+    /// <summary>
+    /// Re-wraps the scrollback rows an earlier resize deferred to the current width.
+    /// Must be called with <see cref="_bufferLock"/> held.
+    /// </summary>
+    /// <param name="newestRows">
+    /// When set, only completes the reflow if reading this many of the newest rows would
+    /// reach a deferred row.
+    /// </param>
+    private void CompleteDeferredReflow(int? newestRows = null)
+    {
+        if (_deferredReflowRows == 0 || _scrollbackBuffer is null)
+            return;
+        if (newestRows is { } count && count <= _scrollbackBuffer.Count - _deferredReflowRows)
+            return;
+
+        var deferred = new ReflowScrollbackRow[_deferredReflowRows];
+        var rows = _scrollbackBuffer.GetLines(_scrollbackBuffer.Count);
+        for (int i = 0; i < deferred.Length; i++)
+            deferred[i] = new ReflowScrollbackRow(rows[i].Cells, rows[i].OriginalWidth);
+
+        _scrollbackBuffer.Replace(0, deferred.Length, ReflowHelper.ReflowScrollback(deferred, _width),
+            _timeProvider.GetUtcNow());
+        _deferredReflowRows = 0;
+        _reflowSettleTimer?.Change(Timeout.InfiniteTimeSpan, Timeout.InfiniteTimeSpan);
+    }
+
     private void ResizeWithCrop(int newWidth, int newHeight)
     {
-        var newBuffer = new TerminalCell[newHeight, newWidth];
+        var newBuffer = new TerminalScreenBuffer(newHeight, newWidth);
         
         // Initialize with empty cells
         for (int y = 0; y < newHeight; y++)
         {
             for (int x = 0; x < newWidth; x++)
             {
-                newBuffer[y, x] = TerminalCell.Empty;
+                newBuffer.GetCellForWrite(y, x) = TerminalCell.Empty;
             }
         }
 
@@ -2303,7 +2644,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         {
             for (int x = 0; x < copyWidth; x++)
             {
-                newBuffer[y, x] = _screenBuffer[y, x];
+                newBuffer.GetCellForWrite(y, x) = _screenBuffer[y, x];
             }
         }
         
@@ -2340,7 +2681,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
     /// <param name="impacts">Optional list to record the cell impact for delta tracking.</param>
     private void SetCell(int y, int x, TerminalCell newCell, List<CellImpact>? impacts = null)
     {
-        ref var oldCell = ref _screenBuffer[y, x];
+        ref var oldCell = ref _screenBuffer.GetCellForWrite(y, x);
         
         // Release old Sixel data reference
         oldCell.TrackedSixel?.Release();
@@ -2502,7 +2843,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 // Release any tracked objects
                 _screenBuffer[y, x].TrackedSixel?.Release();
                 _screenBuffer[y, x].TrackedHyperlink?.Release();
-                _screenBuffer[y, x] = TerminalCell.Empty;
+                _screenBuffer.GetCellForWrite(y, x) = TerminalCell.Empty;
             }
         }
         _currentForeground = null;
@@ -2525,8 +2866,11 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         {
             foreach (var token in tokens)
             {
-                ApplyToken(token, null);
+                ApplyTokenTrackingRows(token, null);
             }
+
+            if (tokens.Count > 0)
+                PublishScreenChange();
         }
     }
 
@@ -2552,7 +2896,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 int cursorYBefore = _cursorY;
                 
                 var impacts = new List<CellImpact>();
-                ApplyToken(token, impacts);
+                ApplyTokenTrackingRows(token, impacts);
                 
                 result.Add(new AppliedToken(
                     token,
@@ -2560,11 +2904,71 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                     cursorXBefore, cursorYBefore,
                     _cursorX, _cursorY));
             }
+
+            if (tokens.Count > 0)
+                PublishScreenChange();
             
             return result;
         }
     }
 
+    /// <summary>
+    /// Applies a single token and records which rows it may have changed.
+    /// </summary>
+    /// <remarks>
+    /// Tokens that only touch the cursor row(s) mark the rows the cursor occupied before
+    /// and after the token (and the whole span for printing tokens, which can wrap).
+    /// Scrolls mark their region from inside <see cref="ScrollUp"/> and friends; any other
+    /// token conservatively marks the whole screen.
+    /// </remarks>
+    private void ApplyTokenTrackingRows(AnsiToken token, List<CellImpact>? impacts)
+    {
+        var rowBefore = _cursorY;
+        ApplyToken(token, impacts);
+        var rowAfter = _cursorY;
+
+        switch (token)
+        {
+            case TextToken:
+            case RepeatCharacterToken:
+                MarkRowsDirty(Math.Min(rowBefore, rowAfter), Math.Max(rowBefore, rowAfter));
+                MarkRowsDirty(_lastPrintedCellY, _lastPrintedCellY);
+                break;
+
+            case ControlCharacterToken:
+            case SgrToken:
+            case CursorPositionToken:
+            case CursorMoveToken:
+            case CursorColumnToken:
+            case CursorRowToken:
+            case ClearLineToken:
+            case SaveCursorToken:
+            case RestoreCursorToken:
+            case CursorShapeToken:
+            case OscToken:
+            case StandardModeToken:
+            case DeleteCharacterToken:
+            case InsertCharacterToken:
+            case EraseCharacterToken:
+            case DecscaToken:
+            case BackTabToken:
+            case IndexToken:
+            case ReverseIndexToken:
+            case CharacterSetToken:
+            case KeypadModeToken:
+            case UnrecognizedSequenceToken:
+            case TabClearToken:
+            case DeviceStatusReportToken:
+                MarkRowsDirty(rowBefore, rowBefore);
+                MarkRowsDirty(rowAfter, rowAfter);
+                break;
+
+            default:
+                MarkAllRowsDirty();
+                break;
+        }
+    }
+
     /// <summary>
     /// Applies a single ANSI token to the screen buffer.
     /// </summary>
@@ -2595,9 +2999,9 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 if (_presentation is ITerminalReflowProvider { ShouldClearSoftWrapOnAbsolutePosition: true }
                     && _cursorY >= 0 && _cursorY < _height)
                 {
-                    ref var lastCell = ref _screenBuffer[_cursorY, _width - 1];
+                    var lastCell = _screenBuffer[_cursorY, _width - 1];
                     if ((lastCell.Attributes & CellAttributes.SoftWrap) != 0)
-                        lastCell = lastCell with { Attributes = lastCell.Attributes & ~CellAttributes.SoftWrap };
+                        _screenBuffer.GetCellForWrite(_cursorY, _width - 1) = lastCell with { Attributes = lastCell.Attributes & ~CellAttributes.SoftWrap };
                 }
                 
                 if (_originMode)
@@ -3171,7 +3575,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                     int cellY = _lastPrintedCellY;
                     if (cellY >= 0 && cellY < _height && cellX >= 0 && cellX < _width)
                     {
-                        ref var cell = ref _screenBuffer[cellY, cellX];
+                        ref var cell = ref _screenBuffer.GetCellForWrite(cellY, cellX);
                         if (!string.IsNullOrEmpty(cell.Character))
                         {
                             var newContent = cell.Character + grapheme;
@@ -3182,7 +3586,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                                 cell = cell with { Character = newContent };
                                 for (int w = _lastPrintedCellWidth; w < newWidth && cellX + w < _width; w++)
                                 {
-                                    ref var contCell = ref _screenBuffer[cellY, cellX + w];
+                                    ref var contCell = ref _screenBuffer.GetCellForWrite(cellY, cellX + w);
                                     contCell = contCell with { Character = "" };
                                 }
                                 _cursorX = Math.Min(cellX + newWidth, _width - 1);
@@ -3217,7 +3621,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 int cellY = _lastPrintedCellY;
                 if (cellY >= 0 && cellY < _height && cellX >= 0 && cellX < _width)
                 {
-                    ref var cell = ref _screenBuffer[cellY, cellX];
+                    ref var cell = ref _screenBuffer.GetCellForWrite(cellY, cellX);
                     if (!string.IsNullOrEmpty(cell.Character))
                     {
                         var newContent = cell.Character + grapheme;
@@ -3240,7 +3644,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                                 _pendingWrap = false; // Clear pending wrap from original print
                                 // Mark soft wrap
                                 int wrapCol = _declrmm ? _marginRight : _width - 1;
-                                ref var wrapCell2 = ref _screenBuffer[cellY, wrapCol];
+                                ref var wrapCell2 = ref _screenBuffer.GetCellForWrite(cellY, wrapCol);
                                 wrapCell2 = wrapCell2 with { Attributes = wrapCell2.Attributes | CellAttributes.SoftWrap };
                                 
                                 int newX = _declrmm ? _marginLeft : 0;
@@ -3253,13 +3657,13 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                                 }
                                 
                                 // Print the combined wide char on the new line
-                                ref var newCell = ref _screenBuffer[newY, newX];
+                                ref var newCell = ref _screenBuffer.GetCellForWrite(newY, newX);
                                 newCell = newCell with { Character = newContent };
                                 
                                 // Add continuation cell
                                 if (newX + 1 < _width)
                                 {
-                                    ref var contCell2 = ref _screenBuffer[newY, newX + 1];
+                                    ref var contCell2 = ref _screenBuffer.GetCellForWrite(newY, newX + 1);
                                     contCell2 = contCell2 with { Character = "" };
                                 }
                                 
@@ -3283,7 +3687,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                             {
                                 for (int w = oldWidth; w < newWidth && cellX + w < _width; w++)
                                 {
-                                    ref var contCell = ref _screenBuffer[cellY, cellX + w];
+                                    ref var contCell = ref _screenBuffer.GetCellForWrite(cellY, cellX + w);
                                     contCell = contCell with { Character = "" };
                                 }
                             }
@@ -3318,7 +3722,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 
                     // Mark the last cell of the row being left as a soft-wrap point.
                     int wrapCol = _declrmm ? _marginRight : _width - 1;
-                    ref var wrapCell = ref _screenBuffer[_cursorY, wrapCol];
+                    ref var wrapCell = ref _screenBuffer.GetCellForWrite(_cursorY, wrapCol);
                     wrapCell = wrapCell with { Attributes = wrapCell.Attributes | CellAttributes.SoftWrap };
                 
                     // When DECLRMM is enabled, wrap to left margin, not column 0
@@ -3375,7 +3779,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                     else
                     {
                         // Screen-edge wrap: mark right edge as spacer head with soft wrap.
-                        ref var spacerCell = ref _screenBuffer[_cursorY, effectiveRightMargin];
+                        ref var spacerCell = ref _screenBuffer.GetCellForWrite(_cursorY, effectiveRightMargin);
                         spacerCell = spacerCell with
                         {
                             Character = " ",
@@ -3415,7 +3819,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 // If overwriting a continuation cell (tail of a wide char), clear the leading cell
                 if (_cursorX > 0 && _screenBuffer[_cursorY, _cursorX].Character == "")
                 {
-                    ref var leadingCell = ref _screenBuffer[_cursorY, _cursorX - 1];
+                    ref var leadingCell = ref _screenBuffer.GetCellForWrite(_cursorY, _cursorX - 1);
                     if (leadingCell.Character.Length > 0 && leadingCell.Character != " ")
                     {
                         leadingCell.TrackedSixel?.Release();
@@ -3427,7 +3831,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 // If overwriting the leading cell of a wide char, clear the continuation cell
                 if (_cursorX + 1 < _width && graphemeWidth == 1)
                 {
-                    ref var nextCell = ref _screenBuffer[_cursorY, _cursorX + 1];
+                    ref var nextCell = ref _screenBuffer.GetCellForWrite(_cursorY, _cursorX + 1);
                     if (nextCell.Character == "" && _screenBuffer[_cursorY, _cursorX].Character.Length > 0
                         && DisplayWidth.GetGraphemeWidth(_screenBuffer[_cursorY, _cursorX].Character) > 1)
                     {
@@ -3530,7 +3934,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         if (cellY < 0 || cellY >= _height || cellX < 0 || cellX >= _width)
             return;
         
-        ref var cell = ref _screenBuffer[cellY, cellX];
+        ref var cell = ref _screenBuffer.GetCellForWrite(cellY, cellX);
         if (string.IsNullOrEmpty(cell.Character))
             return;
         
@@ -3570,7 +3974,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
             // Clear continuation cells
             for (int w = newWidth; w < oldWidth && cellX + w < _width; w++)
             {
-                _screenBuffer[cellY, cellX + w] = TerminalCell.Empty;
+                _screenBuffer.GetCellForWrite(cellY, cellX + w) = TerminalCell.Empty;
             }
             
             // Adjust cursor: move back by the difference in width
@@ -3617,13 +4021,13 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 _cursorX = 0;
                 
                 // Write the wide character at the new position
-                ref var newCell = ref _screenBuffer[_cursorY, 0];
+                ref var newCell = ref _screenBuffer.GetCellForWrite(_cursorY, 0);
                 newCell = newCell with { Character = newGrapheme };
                 
                 // Add continuation cell (empty string marks it as wide char tail)
                 if (_width > 1)
                 {
-                    ref var contCell = ref _screenBuffer[_cursorY, 1];
+                    ref var contCell = ref _screenBuffer.GetCellForWrite(_cursorY, 1);
                     contCell = contCell with { Character = "" };
                 }
                 
@@ -3648,7 +4052,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
             // Add continuation cell(s) (empty string marks as wide char tail)
             for (int w = oldWidth; w < newWidth && cellX + w < _width; w++)
             {
-                ref var contCell = ref _screenBuffer[cellY, cellX + w];
+                ref var contCell = ref _screenBuffer.GetCellForWrite(cellY, cellX + w);
                 contCell = contCell with { Character = "" };
             }
             
@@ -3957,7 +4361,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
             if (!isExtended)
             {
                 // Mode 45: only wrap across soft-wrapped lines
-                ref var lastCellPrevRow = ref _screenBuffer[_cursorY - 1, rightMargin];
+                ref readonly var lastCellPrevRow = ref _screenBuffer[_cursorY - 1, rightMargin];
                 if ((lastCellPrevRow.Attributes & CellAttributes.SoftWrap) == 0)
                     break;
             }
@@ -3992,6 +4396,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 if (mode == ClearMode.AllAndScrollback)
                 {
                     _scrollbackBuffer?.Clear();
+                    _deferredReflowRows = 0;
                 }
                 break;
         }
@@ -4312,7 +4717,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                     else
                     {
                         // Direct assignment for internal buffer only
-                        _screenBuffer[y, x] = _savedMainScreenBuffer[y, x];
+                        _screenBuffer.GetCellForWrite(y, x) = _savedMainScreenBuffer[y, x];
                     }
                 }
             }
@@ -4328,7 +4733,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                     }
                     else
                     {
-                        _screenBuffer[y, x] = TerminalCell.Empty;
+                        _screenBuffer.GetCellForWrite(y, x) = TerminalCell.Empty;
                     }
                 }
             }
@@ -4735,6 +5140,8 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
 
     private void ScrollUp(List<CellImpact>? impacts = null)
     {
+        MarkRowsDirty(_scrollTop, _scrollBottom);
+
         // Scroll up within the scroll region
         // When DECLRMM is enabled, only scroll within left/right margins
         int leftCol = _declrmm ? _marginLeft : 0;
@@ -4795,6 +5202,8 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
     
     private void ScrollDown(List<CellImpact>? impacts = null)
     {
+        MarkRowsDirty(_scrollTop, _scrollBottom);
+
         // Scroll down within the scroll region
         // When DECLRMM is enabled, only scroll within left/right margins
         int leftCol = _declrmm ? _marginLeft : 0;
@@ -4851,12 +5260,15 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         }
 
         var timestamp = _timeProvider.GetUtcNow();
-        _scrollbackBuffer!.Push(cells, _width, timestamp);
+        if (_scrollbackBuffer!.Push(cells, _width, timestamp) is not null && _deferredReflowRows > 0)
+            _deferredReflowRows--;
         _scrollbackCallback?.Invoke(new ScrollbackRowEventArgs(this, cells, _width, timestamp));
     }
     
     private void InsertLines(int count, List<CellImpact>? impacts = null)
     {
+        MarkRowsDirty(_scrollTop, _scrollBottom);
+
         // Insert blank lines at cursor position within scroll region
         // Lines pushed off the bottom of the scroll region are lost
         // When DECLRMM is enabled, only affect columns within left/right margins
@@ -4903,6 +5315,8 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
     
     private void DeleteLines(int count, List<CellImpact>? impacts = null)
     {
+        MarkRowsDirty(_scrollTop, _scrollBottom);
+
         // Delete lines at cursor position within scroll region
         // Blank lines are inserted at the bottom of the scroll region
         // When DECLRMM is enabled, only affect columns within left/right margins
@@ -5207,7 +5621,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
                 
                 // Mark the last cell of the row being left as a soft-wrap point.
                 int wrapCol = _declrmm ? _marginRight : _width - 1;
-                ref var wrapCell = ref _screenBuffer[_cursorY, wrapCol];
+                ref var wrapCell = ref _screenBuffer.GetCellForWrite(_cursorY, wrapCol);
                 wrapCell = wrapCell with { Attributes = wrapCell.Attributes | CellAttributes.SoftWrap };
                 
                 // When DECLRMM is enabled, wrap to left margin, not column 0
@@ -6028,6 +6442,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         _workload.DisposeAsync().AsTask().GetAwaiter().GetResult();
 
         _escapeFlushTimer?.Dispose();
+        _reflowSettleTimer?.Dispose();
 
         _disposeCts.Cancel();
         _disposeCts.Dispose();
@@ -6077,6 +6492,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
         await _workload.DisposeAsync();
 
         _escapeFlushTimer?.Dispose();
+        _reflowSettleTimer?.Dispose();
 
         _disposeCts.Cancel();
         _disposeCts.Dispose();
@@ -6213,7 +6629,7 @@ public sealed partial class Hex1bTerminal : IDisposable, IAsyncDisposable
     /// Returns (completeText, incompleteSequence) where incompleteSequence
     /// should be prepended to the next chunk of data.
     /// </summary>
-    private static (string completeText, string incompleteSequence) ExtractIncompleteEscapeSequence(string text)
+    internal static (string completeText, string incompleteSequence) ExtractIncompleteEscapeSequence(string text)
     {
         if (string.IsNullOrEmpty(text))
             return (text, "");
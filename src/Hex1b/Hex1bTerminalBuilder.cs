@@ -50,6 +50,7 @@ public sealed class Hex1bTerminalBuilder
     private Diagnostics.Hex1bMetrics? _metrics;
     private Diagnostics.Hex1bMetricsOptions? _metricsOptions;
     private int? _scrollbackCapacity;
+    private TimeSpan? _frameSkipInterval;
     private Action<ScrollbackRowEventArgs>? _scrollbackCallback;
     private Reflow.ITerminalReflowProvider? _reflowStrategy;
     private bool _reflowEnabled;
@@ -894,6 +895,104 @@ public sealed class Hex1bTerminalBuilder
         return this;
     }
 
+    /// <summary>
+    /// Adds recording in the compact Hex1b binary format (.h1rec).
+    /// </summary>
+    /// <param name="filePath">Path to the output file (typically with .h1rec extension).</param>
+    /// <param name="options">Optional recording options.</param>
+    /// <returns>This builder instance for fluent chaining.</returns>
+    /// <remarks>
+    /// <para>
+    /// Binary recordings hold the same events as asciinema recordings but are much smaller
+    /// and cheaper to write, and include keyframes so playback can start at any point.
+    /// Use <see cref="BinaryRecordingConverter"/> to convert them to and from .cast files.
+    /// </para>
+    /// <para>
+    /// The recording is automatically flushed when the terminal is disposed.
+    /// </para>
+    /// </remarks>
+    /// <example>
+    /// <code>
+    /// await using var terminal = Hex1bTerminal.CreateBuilder()
+    ///     .WithPtyProcess("/bin/bash")
+    ///     .WithBinaryRecording("session.h1rec")
+    ///     .Build();
+    /// 
+    /// await terminal.RunAsync();
+    /// </code>
+    /// </example>
+    public Hex1bTerminalBuilder WithBinaryRecording(string filePath, BinaryRecorderOptions? options = null)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(filePath);
+        var recorder = new BinaryRecorder(filePath, options);
+        _workloadFilters.Add(recorder);
+        return this;
+    }
+
+    /// <summary>
+    /// Adds binary recording with access to the recorder instance.
+    /// </summary>
+    /// <param name="filePath">Path to the output file (typically with .h1rec extension).</param>
+    /// <param name="capture">Callback that receives the recorder instance for external control.</param>
+    /// <param name="options">Optional recording options.</param>
+    /// <returns>This builder instance for fluent chaining.</returns>
+    public Hex1bTerminalBuilder WithBinaryRecording(
+        string filePath,
+        Action<BinaryRecorder> capture,
+        BinaryRecorderOptions? options = null)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(filePath);
+        ArgumentNullException.ThrowIfNull(capture);
+
+        var recorder = new BinaryRecorder(filePath, options);
+        capture(recorder);
+        _workloadFilters.Add(recorder);
+        return this;
+    }
+
+    /// <summary>
+    /// Configures the terminal to play back a Hex1b binary recording (.h1rec).
+    /// </summary>
+    /// <param name="filePath">Path to the .h1rec file to play back.</param>
+    /// <param name="speedMultiplier">Optional playback speed multiplier. Default is 1.0 (normal speed).</param>
+    /// <param name="startPosition">Optional position to start playback from. Playback starts from the
+    /// nearest keyframe instead of replaying the whole recording.</param>
+    /// <returns>This builder instance for fluent chaining.</returns>
+    public Hex1bTerminalBuilder WithBinaryPlayback(string filePath, double speedMultiplier = 1.0, TimeSpan startPosition = default)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(filePath);
+
+        if (speedMultiplier <= 0)
+            throw new ArgumentOutOfRangeException(nameof(speedMultiplier), "Speed multiplier must be greater than 0");
+
+        SetWorkloadFactory(presentation =>
+        {
+            var adapter = new BinaryRecordingWorkloadAdapter(filePath)
+            {
+                SpeedMultiplier = speedMultiplier,
+                StartPosition = startPosition
+            };
+
+            Func<CancellationToken, Task<int>> runCallback = async ct =>
+            {
+                await adapter.StartAsync(ct);
+
+                // Wait for playback to complete (when Disconnected is fired)
+                var tcs = new TaskCompletionSource<int>();
+                adapter.Disconnected += () => tcs.TrySetResult(0);
+
+                // Also handle cancellation
+                using var registration = ct.Register(() => tcs.TrySetCanceled(ct));
+
+                return await tcs.Task;
+            };
+
+            return new Hex1bTerminalBuildContext(adapter, runCallback);
+        });
+
+        return this;
+    }
+
     /// <summary>
     /// Configures the terminal with a custom workload adapter.
     /// </summary>
@@ -1088,6 +1187,9 @@ public sealed class Hex1bTerminalBuilder
     /// <param name="appName">Optional application name for identification. Defaults to the entry assembly name.</param>
     /// <param name="forceEnable">When true, enables diagnostics even in Release builds. 
     /// By default, diagnostics are automatically disabled in Release builds for security.</param>
+    /// <param name="enableScreenMirror">When true, also publishes the visible screen to a shared-memory
+    /// file at ~/.hex1b/sockets/[pid].diagnostics.screen that monitors can read with
+    /// <see cref="Diagnostics.TerminalScreenMirrorReader"/> without a socket round trip.</param>
     /// <returns>This builder for chaining.</returns>
     /// <remarks>
     /// <para>
@@ -1118,7 +1220,7 @@ public sealed class Hex1bTerminalBuilder
     /// await terminal.RunAsync();
     /// </code>
     /// </example>
-    public Hex1bTerminalBuilder WithDiagnostics(string? appName = null, bool forceEnable = false)
+    public Hex1bTerminalBuilder WithDiagnostics(string? appName = null, bool forceEnable = false, bool enableScreenMirror = false)
     {
 #if !DEBUG
         // In Release builds, only enable if explicitly forced
@@ -1127,7 +1229,7 @@ public sealed class Hex1bTerminalBuilder
             return this;
         }
 #endif
-        var filter = new Diagnostics.McpDiagnosticsPresentationFilter(appName);
+        var filter = new Diagnostics.McpDiagnosticsPresentationFilter(appName, enableScreenMirror);
 
         // Find an existing AsciinemaRecorder in workload filters, or create an idle one
         var recorder = _workloadFilters.OfType<AsciinemaRecorder>().FirstOrDefault();
@@ -1266,6 +1368,23 @@ public sealed class Hex1bTerminalBuilder
         return this;
     }
 
+    /// <summary>
+    /// Enables frame skipping: while the workload floods the terminal faster than the
+    /// presentation can show it, the presentation is repainted from the screen buffer
+    /// at most once per <paramref name="interval"/> instead of receiving every byte.
+    /// </summary>
+    /// <param name="interval">How long a flood lasts before frames are skipped, and the time
+    /// between repaints while it continues. Default is 33 ms (about 30 frames per second).</param>
+    /// <returns>This builder for chaining.</returns>
+    /// <seealso cref="Hex1bTerminalOptions.FrameSkipInterval"/>
+    public Hex1bTerminalBuilder WithFrameSkipping(TimeSpan? interval = null)
+    {
+        var value = interval ?? TimeSpan.FromMilliseconds(33);
+        if (value <= TimeSpan.Zero) throw new ArgumentOutOfRangeException(nameof(interval), "Frame skip interval must be positive.");
+        _frameSkipInterval = value;
+        return this;
+    }
+
     /// <summary>
     /// Sets the dimensions for headless terminals.
     /// </summary>
@@ -1403,6 +1522,7 @@ public sealed class Hex1bTerminalBuilder
             RunCallback = runCallback,
             ScrollbackCapacity = _scrollbackCapacity,
             ScrollbackCallback = _scrollbackCallback,
+            FrameSkipInterval = _frameSkipInterval,
             Metrics = ResolveMetrics()
         };
         
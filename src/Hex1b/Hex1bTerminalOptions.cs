@@ -125,6 +125,26 @@ public sealed class Hex1bTerminalOptions
     /// </remarks>
     public TimeSpan? EscapeSequenceTimeout { get; set; }
 
+    /// <summary>
+    /// Enables frame skipping when set: if workload output keeps arriving faster than it is
+    /// presented for this long, raw output stops being forwarded and the presentation is
+    /// repainted from the screen buffer at most once per interval instead. Default is null (off).
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// This keeps floods like <c>yes</c> or a large <c>cat</c> from being limited by how fast
+    /// the presentation can draw every intermediate line. The terminal's own buffer still sees
+    /// every byte; only frames nobody would have seen are dropped. When the output pauses, the
+    /// full screen, cursor, pen and modes are sent so the presentation is exactly in sync again.
+    /// </para>
+    /// <para>
+    /// Skipped output never reaches the presentation, so lines that scroll past during a flood
+    /// don't appear in the host terminal's own scrollback. Frame skipping only applies when no
+    /// filters are configured and the presentation forwards raw output.
+    /// </para>
+    /// </remarks>
+    public TimeSpan? FrameSkipInterval { get; set; }
+
     /// <summary>
     /// Validates the options and throws if invalid.
     /// </summary>
@@ -135,6 +155,11 @@ public sealed class Hex1bTerminalOptions
             throw new InvalidOperationException("WorkloadAdapter is required.");
         }
 
+        if (FrameSkipInterval is { } frameSkipInterval && frameSkipInterval <= TimeSpan.Zero)
+        {
+            throw new InvalidOperationException("FrameSkipInterval must be greater than zero.");
+        }
+
         if (Width <= 0)
         {
             throw new InvalidOperationException("Width must be greater than zero.");
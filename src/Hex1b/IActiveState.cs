@@ -18,4 +18,10 @@ internal interface IActiveState
     /// Returns true if this state requires continued re-rendering (e.g. running animations).
     /// </summary>
     bool IsActive { get; }
+
+    /// <summary>
+    /// The number of running items (e.g. animators) this state holds, reported through
+    /// <see cref="Diagnostics.Hex1bMetrics.AnimationActiveCount"/>.
+    /// </summary>
+    int ActiveCount => IsActive ? 1 : 0;
 }
@@ -44,15 +44,20 @@ internal interface IConsoleDriver : IDisposable
     ValueTask<int> ReadAsync(Memory<byte> buffer, CancellationToken ct = default);
     
     /// <summary>
-    /// Write raw bytes to stdout.
+    /// Write raw bytes to stdout. Drivers may hold the bytes until <see cref="Flush"/>.
     /// </summary>
     /// <param name="data">Data to write.</param>
     void Write(ReadOnlySpan<byte> data);
     
     /// <summary>
-    /// Flush stdout.
+    /// Flush stdout, including any bytes held back by <see cref="Write"/>.
     /// </summary>
     void Flush();
+
+    /// <summary>
+    /// Number of write system calls made so far.
+    /// </summary>
+    long WriteCalls { get; }
     
     /// <summary>
     /// Drain any pending input from the buffer without processing it.
@@ -16,6 +16,13 @@ public sealed record Hex1bKeyEvent(Hex1bKey Key, string Text, Hex1bModifiers Mod
     {
     }
 
+    /// <summary>
+    /// How many presses of this key the event stands for. Greater than one when
+    /// <see cref="Hex1bApp"/> merged a burst of repeated navigation keys; handlers apply it
+    /// through <see cref="InputBindingActionContext.ConsumeRepeatCount"/>.
+    /// </summary>
+    public int RepeatCount { get; init; } = 1;
+
     /// <summary>
     /// Returns true if the Shift modifier is active.
     /// </summary>
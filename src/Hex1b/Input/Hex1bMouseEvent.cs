@@ -18,6 +18,13 @@ public sealed record Hex1bMouseEvent(
     int ClickCount = 1
 ) : Hex1bEvent
 {
+    /// <summary>
+    /// How many wheel notches this event stands for. Greater than one when
+    /// <see cref="Hex1bApp"/> merged a burst of scroll-wheel events; handlers apply it
+    /// through <see cref="InputBindingActionContext.ConsumeRepeatCount"/>.
+    /// </summary>
+    public int RepeatCount { get; init; } = 1;
+
     /// <summary>
     /// Returns true if this is a double-click event (ClickCount == 2).
     /// </summary>
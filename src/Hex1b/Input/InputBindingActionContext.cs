@@ -33,6 +33,16 @@ public sealed class InputBindingActionContext
     
     private readonly WindowManagerRegistry? _windowManagerRegistry;
 
+    /// <summary>
+    /// How many repeats of the key or wheel event this context was created for.
+    /// </summary>
+    internal int RepeatCount { get; init; } = 1;
+
+    /// <summary>
+    /// Whether the handler applied the whole <see cref="RepeatCount"/> at once.
+    /// </summary>
+    internal bool RepeatCountConsumed { get; private set; }
+
     internal InputBindingActionContext(
         FocusRing focusRing, 
         Action? requestStop = null, 
@@ -53,6 +63,23 @@ public sealed class InputBindingActionContext
         MouseY = mouseY;
     }
 
+    /// <summary>
+    /// Takes the number of times the triggering key or wheel event was repeated, so the
+    /// handler can apply them all in one step (for example, moving the selection down five
+    /// rows instead of one).
+    /// </summary>
+    /// <returns>The repeat count, at least 1.</returns>
+    /// <remarks>
+    /// Bursts of repeated navigation keys and wheel notches are merged into one event before
+    /// routing. If the handler doesn't call this method, the router runs the binding once per
+    /// repeat instead, so handlers that ignore repeat counts keep working unchanged.
+    /// </remarks>
+    public int ConsumeRepeatCount()
+    {
+        RepeatCountConsumed = true;
+        return RepeatCount;
+    }
+
     /// <summary>
     /// Requests the application to stop. The RunAsync call will exit gracefully
     /// after the current frame completes.
@@ -0,0 +1,247 @@
+namespace Hex1b.Input;
+
+/// <summary>
+/// Caches what key routing derives from the node tree: the global and capture-override tries,
+/// each node's bindings and trie, and the path to the focused node.
+/// </summary>
+/// <remarks>
+/// Bindings are configured during reconciliation, so everything except the focus path stays
+/// valid until the next reconcile. <see cref="Hex1bApp"/> resets the table after each one; a
+/// table for a different root is never reused. Focus can move between frames (Tab, actions),
+/// so the cached path is rechecked against the current focus before each use.
+/// </remarks>
+internal sealed class InputDispatchTable
+{
+    private readonly Dictionary<Hex1bNode, Layer> _layers = new(ReferenceEqualityComparer.Instance);
+    private ChordTrie? _globalTrie;
+    private ChordTrie? _captureOverrideTrie;
+    private List<Hex1bNode>? _focusPath;
+
+    public InputDispatchTable(Hex1bNode root)
+    {
+        Root = root;
+    }
+
+    /// <summary>
+    /// The root node the table was built from.
+    /// </summary>
+    public Hex1bNode Root { get; private set; }
+
+    /// <summary>
+    /// Drops everything cached so the next lookup rebuilds from <paramref name="root"/>.
+    /// </summary>
+    public void Reset(Hex1bNode root)
+    {
+        Root = root;
+        _layers.Clear();
+        _globalTrie = null;
+        _captureOverrideTrie = null;
+        _focusPath = null;
+    }
+
+    /// <summary>
+    /// Gets a node's bindings, building them on first use.
+    /// </summary>
+    public Layer GetLayer(Hex1bNode node)
+    {
+        if (!_layers.TryGetValue(node, out var layer))
+        {
+            var builder = node.BuildBindings();
+            var bindings = builder.Build();
+            layer = new Layer(builder, bindings, bindings.Count > 0 ? ChordTrie.Build(bindings) : null);
+            _layers[node] = layer;
+        }
+        return layer;
+    }
+
+    /// <summary>
+    /// Gets the trie of global bindings from the whole tree, or null if there are none.
+    /// Throws on a first-step conflict; a conflicting tree isn't cached, so every key reports it.
+    /// </summary>
+    public ChordTrie? GetGlobalTrie()
+    {
+        if (_globalTrie is null)
+        {
+            var bindings = new List<InputBinding>();
+            CollectGlobalBindings(Root, bindings);
+            _globalTrie = ChordTrie.Build(bindings);
+        }
+        return _globalTrie.HasChildren ? _globalTrie : null;
+    }
+
+    /// <summary>
+    /// Gets the trie of capture-override bindings from the whole tree, or null if there are none.
+    /// </summary>
+    public ChordTrie? GetCaptureOverrideTrie()
+    {
+        if (_captureOverrideTrie is null)
+        {
+            var bindings = new List<InputBinding>();
+            CollectCaptureOverrideBindings(Root, bindings);
+            _captureOverrideTrie = ChordTrie.Build(bindings);
+        }
+        return _captureOverrideTrie.HasChildren ? _captureOverrideTrie : null;
+    }
+
+    /// <summary>
+    /// Gets the path from the root to the focused node, or through the first children when
+    /// nothing is focused. The returned list is never modified, so it can be kept as a chord
+    /// anchor.
+    /// </summary>
+    public List<Hex1bNode> GetFocusPath(FocusRing focusRing)
+    {
+        if (_focusPath is null || !IsFocusPathCurrent(_focusPath, focusRing))
+        {
+            _focusPath = BuildPathToFocused(Root);
+        }
+        return _focusPath;
+    }
+
+    private static bool IsFocusPathCurrent(List<Hex1bNode> path, FocusRing focusRing)
+    {
+        var last = path[^1];
+        if (last.IsFocusable && last.IsFocused)
+        {
+            return true;
+        }
+
+        // A fallback path (no focused node) holds while nothing has taken focus
+        return focusRing.FocusedNode is null;
+    }
+
+    /// <summary>
+    /// Builds a path from the root node to the currently focused node.
+    /// If no focused node is found, builds a path that includes all nodes with bindings.
+    /// Returns empty list only if the tree is empty.
+    /// </summary>
+    private static List<Hex1bNode> BuildPathToFocused(Hex1bNode root)
+    {
+        var path = new List<Hex1bNode>();
+        if (!BuildPathRecursive(root, path))
+        {
+            // When no focused node exists, build a path that includes all nodes with bindings.
+            // This ensures that bindings on non-focusable nodes (like VStack with user bindings)
+            // are still checked during input routing.
+            path.Clear();
+            BuildPathWithBindings(root, path);
+
+            // Fallback to just root if we didn't find any nodes with bindings
+            if (path.Count == 0)
+            {
+                path.Add(root);
+            }
+        }
+        return path;
+    }
+
+    private static bool BuildPathRecursive(Hex1bNode node, List<Hex1bNode> path)
+    {
+        path.Add(node);
+
+        // If this node is focusable and focused, we found our target
+        if (node.IsFocusable && node.IsFocused)
+        {
+            return true;
+        }
+
+        // Check children
+        foreach (var child in node.GetChildren())
+        {
+            if (BuildPathRecursive(child, path))
+            {
+                return true;
+            }
+        }
+
+        // No focused node found in this subtree, backtrack
+        path.RemoveAt(path.Count - 1);
+        return false;
+    }
+
+    /// <summary>
+    /// Builds a path that includes all nodes with bindings (when no focused node exists).
+    /// This traverses the deepest path and includes all nodes along the way.
+    /// </summary>
+    private static void BuildPathWithBindings(Hex1bNode node, List<Hex1bNode> path)
+    {
+        // Always include this node in the path - we want to check bindings on all nodes
+        // from root to the deepest leaf, not just nodes that explicitly have bindings.
+        // This matches the behavior when a focused node exists (entire path is checked).
+        path.Add(node);
+
+        // Traverse to first child (depth-first) to build a path through the tree
+        var child = node.GetChildren().FirstOrDefault();
+        if (child is not null)
+        {
+            BuildPathWithBindings(child, path);
+        }
+    }
+
+    /// <summary>
+    /// Recursively collects all global bindings from the node tree.
+    /// Throws on conflict for first key step.
+    /// </summary>
+    private void CollectGlobalBindings(Hex1bNode node, List<InputBinding> bindings)
+    {
+        foreach (var binding in GetLayer(node).Bindings)
+        {
+            if (binding.IsGlobal)
+            {
+                binding.OwnerNode = node;
+
+                // Check for conflict with existing bindings
+                var firstStep = binding.FirstStep;
+                foreach (var existing in bindings)
+                {
+                    if (existing.FirstStep.Key == firstStep.Key &&
+                        existing.FirstStep.Modifiers == firstStep.Modifiers)
+                    {
+                        var ownerName = existing.OwnerNode?.GetType().Name ?? "unknown";
+                        var newOwnerName = node.GetType().Name;
+                        throw new InvalidOperationException(
+                            $"Global binding conflict: {firstStep} is already registered by {ownerName} " +
+                            $"('{existing.Description}'). Cannot register it again from {newOwnerName} " +
+                            $"('{binding.Description}'). Use .DisableAccelerator() or .Accelerator() to resolve.");
+                    }
+                }
+
+                bindings.Add(binding);
+            }
+        }
+
+        // Recurse into children
+        foreach (var child in node.GetChildren())
+        {
+            CollectGlobalBindings(child, bindings);
+        }
+    }
+
+    /// <summary>
+    /// Recursively collects all capture-override bindings from the node tree.
+    /// </summary>
+    private void CollectCaptureOverrideBindings(Hex1bNode node, List<InputBinding> bindings)
+    {
+        foreach (var binding in GetLayer(node).Bindings)
+        {
+            if (binding.OverridesCapture)
+            {
+                binding.OwnerNode = node;
+                bindings.Add(binding);
+            }
+        }
+
+        // Recurse into children
+        foreach (var child in node.GetChildren())
+        {
+            CollectCaptureOverrideBindings(child, bindings);
+        }
+    }
+
+    /// <summary>
+    /// A node's built bindings.
+    /// </summary>
+    /// <param name="Builder">The builder, for its character bindings.</param>
+    /// <param name="Bindings">The key bindings.</param>
+    /// <param name="Trie">The trie of <paramref name="Bindings"/>, or null if there are none.</param>
+    internal readonly record struct Layer(InputBindingsBuilder Builder, IReadOnlyList<InputBinding> Bindings, ChordTrie? Trie);
+}
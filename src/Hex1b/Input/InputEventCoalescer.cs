@@ -0,0 +1,78 @@
+namespace Hex1b.Input;
+
+/// <summary>
+/// Merges bursts of queued input events before they are routed, so a drag across a large
+/// widget or a held arrow key doesn't leave the app processing stale events.
+/// </summary>
+/// <remarks>
+/// Only adjacent events are merged, so the relative order of different events is kept:
+/// <list type="bullet">
+///   <item>Consecutive mouse move/drag events collapse to the latest position.</item>
+///   <item>Consecutive wheel events in the same direction at the same position become one
+///   event whose <see cref="Hex1bMouseEvent.RepeatCount"/> is the number of notches.</item>
+///   <item>Consecutive presses of the same navigation key (arrows, Page Up/Down) become one
+///   event whose <see cref="Hex1bKeyEvent.RepeatCount"/> is the number of presses.</item>
+/// </list>
+/// Widgets that can apply a repeat count in one step read it with
+/// <see cref="InputBindingActionContext.ConsumeRepeatCount"/>; for everything else the
+/// router replays the remaining repeats one at a time.
+/// </remarks>
+internal static class InputEventCoalescer
+{
+    /// <summary>
+    /// Merges adjacent events in <paramref name="events"/> in place.
+    /// </summary>
+    public static void Coalesce(List<Hex1bEvent> events)
+    {
+        if (events.Count < 2)
+            return;
+
+        var write = 0;
+        for (var read = 0; read < events.Count; read++)
+        {
+            var current = events[read];
+            if (write > 0 && TryMerge(events[write - 1], current, out var merged))
+            {
+                events[write - 1] = merged;
+                continue;
+            }
+            events[write++] = current;
+        }
+        events.RemoveRange(write, events.Count - write);
+    }
+
+    private static bool TryMerge(Hex1bEvent previous, Hex1bEvent next, out Hex1bEvent merged)
+    {
+        switch (previous, next)
+        {
+            case (Hex1bMouseEvent a, Hex1bMouseEvent b) when IsMotion(a) && a.Action == b.Action
+                && a.Button == b.Button && a.Modifiers == b.Modifiers:
+                merged = b;
+                return true;
+
+            case (Hex1bMouseEvent a, Hex1bMouseEvent b) when IsWheel(a) && a.Button == b.Button
+                && a.Action == b.Action && a.Modifiers == b.Modifiers && a.X == b.X && a.Y == b.Y:
+                merged = a with { RepeatCount = a.RepeatCount + b.RepeatCount };
+                return true;
+
+            case (Hex1bKeyEvent a, Hex1bKeyEvent b) when IsRepeatableKey(a.Key) && a.Key == b.Key
+                && a.Modifiers == b.Modifiers && a.Text == b.Text:
+                merged = a with { RepeatCount = a.RepeatCount + b.RepeatCount };
+                return true;
+
+            default:
+                merged = next;
+                return false;
+        }
+    }
+
+    private static bool IsMotion(Hex1bMouseEvent e)
+        => e.Action is MouseAction.Move or MouseAction.Drag;
+
+    private static bool IsWheel(Hex1bMouseEvent e)
+        => e.Action == MouseAction.Down && e.Button is MouseButton.ScrollUp or MouseButton.ScrollDown;
+
+    private static bool IsRepeatableKey(Hex1bKey key)
+        => key is Hex1bKey.UpArrow or Hex1bKey.DownArrow or Hex1bKey.LeftArrow or Hex1bKey.RightArrow
+            or Hex1bKey.PageUp or Hex1bKey.PageDown;
+}
@@ -5,13 +5,21 @@ namespace Hex1b.Input;
 /// </summary>
 public static class InputRouter
 {
+    /// <summary>
+    /// Debug: Whether routing records <see cref="LastPathDebug"/> and <see cref="LastRouteDebug"/>.
+    /// Off by default, since formatting them costs allocations on every key.
+    /// </summary>
+    public static bool CaptureDebugInfo { get; set; }
+
     /// <summary>
     /// Debug: The last path that was built during input routing.
+    /// Only recorded while <see cref="CaptureDebugInfo"/> is set.
     /// </summary>
     public static string? LastPathDebug { get; set; }
     
     /// <summary>
     /// Debug: The key that was last routed and whether a match was found.
+    /// Only recorded while <see cref="CaptureDebugInfo"/> is set.
     /// </summary>
     public static string? LastRouteDebug { get; set; }
     
@@ -20,13 +28,16 @@ public static class InputRouter
     /// 
     /// Algorithm:
     /// 1. Check global bindings first (from entire tree, evaluated regardless of focus)
-    /// 2. Build path from root to focused node
+    /// 2. Get path from root to focused node
     /// 3. If mid-chord, validate path matches and continue chord
-    /// 4. Build tries from each node's bindings (focused first, root last)
+    /// 4. Look up each node's trie (focused first, root last)
     /// 5. Search layers in order - first match wins
     /// 6. If internal node matched, start/continue chord
     /// 7. If leaf matched, execute action
     /// 8. If no match, fall through to HandleInput on focused node, then bubble up
+    /// 
+    /// The tries and the focus path come from the state's dispatch table, which is built
+    /// once per reconciled frame rather than per event.
     /// </summary>
     internal static async Task<InputResult> RouteInputAsync(
         Hex1bNode root, 
@@ -44,13 +55,15 @@ public static class InputRouter
         {
             Hex1bKeyEvent keyEvent => await RouteKeyInputAsync(root, keyEvent, focusRing, state, requestStop, cancellationToken, copyToClipboard, invalidate, windowManagerRegistry),
             Hex1bMouseEvent mouseEvent => await RouteMouseInputAsync(root, mouseEvent, focusRing, state, requestStop, cancellationToken, copyToClipboard, windowManagerRegistry),
-            Hex1bPasteEvent pasteEvent => await RoutePasteInputAsync(root, pasteEvent, focusRing),
+            Hex1bPasteEvent pasteEvent => await RoutePasteInputAsync(root, pasteEvent, focusRing, state),
             _ => InputResult.NotHandled
         };
     }
     
     /// <summary>
     /// Routes a key event through the node tree using layered chord tries.
+    /// A merged key-repeat event is routed once with its repeat count; if the handler
+    /// doesn't consume the count, the remaining repeats are routed one at a time.
     /// </summary>
     private static async Task<InputResult> RouteKeyInputAsync(
         Hex1bNode root, 
@@ -63,12 +76,40 @@ public static class InputRouter
         Action? invalidate = null,
         WindowManagerRegistry? windowManagerRegistry = null)
     {
-        // Create the action context for this input routing
-        var actionContext = new InputBindingActionContext(focusRing, requestStop, cancellationToken, copyToClipboard: copyToClipboard, invalidate: invalidate, windowManagerRegistry: windowManagerRegistry);
+        // Nodes and bindings see a single key press; the count travels on the context
+        var singleEvent = keyEvent.RepeatCount > 1 ? keyEvent with { RepeatCount = 1 } : keyEvent;
+        var result = InputResult.NotHandled;
+        
+        for (var remaining = keyEvent.RepeatCount; remaining > 0;)
+        {
+            // Create the action context for this input routing
+            var actionContext = new InputBindingActionContext(focusRing, requestStop, cancellationToken, copyToClipboard: copyToClipboard, invalidate: invalidate, windowManagerRegistry: windowManagerRegistry)
+            {
+                RepeatCount = remaining
+            };
+            
+            if (await RouteSingleKeyAsync(root, singleEvent, focusRing, state, actionContext) == InputResult.Handled)
+            {
+                result = InputResult.Handled;
+            }
+            remaining -= actionContext.RepeatCountConsumed ? remaining : 1;
+        }
+        
+        return result;
+    }
+    
+    private static async Task<InputResult> RouteSingleKeyAsync(
+        Hex1bNode root, 
+        Hex1bKeyEvent keyEvent, 
+        FocusRing focusRing,
+        InputRouterState state,
+        InputBindingActionContext actionContext)
+    {
+        var table = state.GetDispatchTable(root);
         
         // Check global bindings first (evaluated regardless of focus)
         // Global bindings are collected from the entire tree
-        var globalResult = await TryHandleGlobalBindingsAsync(root, keyEvent, actionContext, state);
+        var globalResult = await TryHandleGlobalBindingsAsync(table, keyEvent, actionContext, state);
         if (globalResult == InputResult.Handled)
         {
             return InputResult.Handled;
@@ -78,7 +119,7 @@ public static class InputRouter
         var capturedNode = focusRing.CapturedNode;
         if (capturedNode != null)
         {
-            var overrideResult = await TryHandleCaptureOverrideBindingsAsync(root, keyEvent, actionContext, state);
+            var overrideResult = await TryHandleCaptureOverrideBindingsAsync(table, keyEvent, actionContext, state);
             if (overrideResult == InputResult.Handled)
             {
                 return InputResult.Handled;
@@ -92,17 +133,23 @@ public static class InputRouter
             }
         }
         
-        // Build path from root to focused node
-        var path = BuildPathToFocused(root);
+        // Get path from root to focused node
+        var path = table.GetFocusPath(focusRing);
         
         // Debug: capture path info
-        LastPathDebug = $"Path ({path.Count} nodes): [{string.Join(" -> ", path.Select(n => n.GetType().Name))}]";
+        if (CaptureDebugInfo)
+        {
+            LastPathDebug = $"Path ({path.Count} nodes): [{string.Join(" -> ", path.Select(n => n.GetType().Name))}]";
+        }
         
         if (path.Count == 0)
         {
             // No focused node found, nothing to route to
             state.Reset();
-            LastRouteDebug = $"Key {keyEvent.Key}: No path found, NotHandled";
+            if (CaptureDebugInfo)
+            {
+                LastRouteDebug = $"Key {keyEvent.Key}: No path found, NotHandled";
+            }
             return InputResult.NotHandled;
         }
 
@@ -127,23 +174,24 @@ public static class InputRouter
 
         // Build layers: focused first (index 0), root last
         // Search from focused toward root - first match wins
-        var bindingSearchDebug = new List<string>();
+        var bindingSearchDebug = CaptureDebugInfo ? new List<string>() : null;
         for (int i = path.Count - 1; i >= 0; i--)
         {
             var node = path[i];
-            var builder = node.BuildBindings();
-            var bindings = builder.Build();
+            var layer = table.GetLayer(node);
             
-            bindingSearchDebug.Add($"{node.GetType().Name}:{bindings.Count}");
+            bindingSearchDebug?.Add($"{node.GetType().Name}:{layer.Bindings.Count}");
             
-            if (bindings.Count > 0)
+            if (layer.Trie is { } trie)
             {
-                var trie = ChordTrie.Build(bindings);
                 var result = trie.Lookup(keyEvent);
                 
                 if (!result.IsNoMatch)
                 {
-                    LastRouteDebug = $"Key {keyEvent.Key}: MATCHED at {node.GetType().Name}, IsLeaf={result.IsLeaf}";
+                    if (CaptureDebugInfo)
+                    {
+                        LastRouteDebug = $"Key {keyEvent.Key}: MATCHED at {node.GetType().Name}, IsLeaf={result.IsLeaf}";
+                    }
                     // Found a match at this layer
                     if (result.IsLeaf)
                     {
@@ -167,13 +215,16 @@ public static class InputRouter
             
             // No key binding matched at this layer, try character bindings
             // Character bindings only trigger on the focused node (not bubbling)
-            if (i == path.Count - 1 && await TryHandleCharacterBindingAsync(builder.CharacterBindings, keyEvent, actionContext))
+            if (i == path.Count - 1 && await TryHandleCharacterBindingAsync(layer.Builder.CharacterBindings, keyEvent, actionContext))
             {
                 return InputResult.Handled;
             }
         }
         
-        LastRouteDebug = $"Key {keyEvent.Key}: NO MATCH. Searched: [{string.Join(", ", bindingSearchDebug)}]";
+        if (bindingSearchDebug is not null)
+        {
+            LastRouteDebug = $"Key {keyEvent.Key}: NO MATCH. Searched: [{string.Join(", ", bindingSearchDebug)}]";
+        }
 
         // No binding matched, let the focused node handle the input directly
         // Only call HandleInput on nodes that are actually focused
@@ -207,10 +258,11 @@ public static class InputRouter
     private static async Task<InputResult> RoutePasteInputAsync(
         Hex1bNode root,
         Hex1bPasteEvent pasteEvent,
-        FocusRing focusRing)
+        FocusRing focusRing,
+        InputRouterState state)
     {
-        // Build path from root to focused node
-        var path = BuildPathToFocused(root);
+        // Get path from root to focused node
+        var path = state.GetDispatchTable(root).GetFocusPath(focusRing);
 
         if (path.Count == 0)
         {
@@ -407,95 +459,23 @@ public static class InputRouter
         return false;
     }
 
-    /// <summary>
-    /// Builds a path from the root node to the currently focused node.
-    /// If no focused node is found, builds a path that includes all nodes with bindings.
-    /// Returns empty list only if the tree is empty.
-    /// </summary>
-    private static List<Hex1bNode> BuildPathToFocused(Hex1bNode root)
-    {
-        var path = new List<Hex1bNode>();
-        if (!BuildPathRecursive(root, path))
-        {
-            // When no focused node exists, build a path that includes all nodes with bindings.
-            // This ensures that bindings on non-focusable nodes (like VStack with user bindings)
-            // are still checked during input routing.
-            path.Clear();
-            BuildPathWithBindings(root, path);
-            
-            // Fallback to just root if we didn't find any nodes with bindings
-            if (path.Count == 0)
-            {
-                path.Add(root);
-            }
-        }
-        return path;
-    }
-
-    private static bool BuildPathRecursive(Hex1bNode node, List<Hex1bNode> path)
-    {
-        path.Add(node);
-
-        // If this node is focusable and focused, we found our target
-        if (node.IsFocusable && node.IsFocused)
-        {
-            return true;
-        }
-
-        // Check children
-        foreach (var child in node.GetChildren())
-        {
-            if (BuildPathRecursive(child, path))
-            {
-                return true;
-            }
-        }
-
-        // No focused node found in this subtree, backtrack
-        path.RemoveAt(path.Count - 1);
-        return false;
-    }
-    
-    /// <summary>
-    /// Builds a path that includes all nodes with bindings (when no focused node exists).
-    /// This traverses the deepest path and includes all nodes along the way.
-    /// </summary>
-    private static void BuildPathWithBindings(Hex1bNode node, List<Hex1bNode> path)
-    {
-        // Always include this node in the path - we want to check bindings on all nodes
-        // from root to the deepest leaf, not just nodes that explicitly have bindings.
-        // This matches the behavior when a focused node exists (entire path is checked).
-        path.Add(node);
-        
-        // Traverse to first child (depth-first) to build a path through the tree
-        var children = node.GetChildren().ToList();
-        if (children.Count > 0)
-        {
-            BuildPathWithBindings(children[0], path);
-        }
-    }
-    
     /// <summary>
     /// Tries to handle input via global bindings collected from the entire tree.
     /// Global bindings are checked before focus-based routing.
     /// </summary>
     private static async Task<InputResult> TryHandleGlobalBindingsAsync(
-        Hex1bNode root,
+        InputDispatchTable table,
         Hex1bKeyEvent keyEvent,
         InputBindingActionContext actionContext,
         InputRouterState state)
     {
-        // Collect all global bindings from the entire tree
-        var globalBindings = new List<InputBinding>();
-        CollectGlobalBindings(root, globalBindings);
-        
-        if (globalBindings.Count == 0)
+        // Global bindings from the entire tree, collected once per frame
+        var trie = table.GetGlobalTrie();
+        if (trie is null)
         {
             return InputResult.NotHandled;
         }
         
-        // Build a trie from global bindings and check for a match
-        var trie = ChordTrie.Build(globalBindings);
         var result = trie.Lookup(keyEvent);
         
         if (!result.IsNoMatch)
@@ -503,7 +483,10 @@ public static class InputRouter
             if (result.IsLeaf)
             {
                 // Global binding matched - execute and done
-                LastRouteDebug = $"Key {keyEvent.Key}: GLOBAL match, executing";
+                if (CaptureDebugInfo)
+                {
+                    LastRouteDebug = $"Key {keyEvent.Key}: GLOBAL match, executing";
+                }
                 await result.ExecuteAsync(actionContext);
                 state.Reset();
                 return InputResult.Handled;
@@ -514,7 +497,10 @@ public static class InputRouter
                 // Global chord started - but we don't support global chords yet
                 // For now, treat as handled to prevent the key from being processed elsewhere
                 // TODO: Add support for global chords if needed
-                LastRouteDebug = $"Key {keyEvent.Key}: GLOBAL chord started";
+                if (CaptureDebugInfo)
+                {
+                    LastRouteDebug = $"Key {keyEvent.Key}: GLOBAL chord started";
+                }
                 return InputResult.Handled;
             }
         }
@@ -527,7 +513,7 @@ public static class InputRouter
     /// These bindings are checked when a node has captured input, before sending to the captured node.
     /// </summary>
     private static async Task<InputResult> TryHandleCaptureOverrideBindingsAsync(
-        Hex1bNode root,
+        InputDispatchTable table,
         Hex1bKeyEvent keyEvent,
         InputBindingActionContext actionContext,
         InputRouterState state)
@@ -556,17 +542,13 @@ public static class InputRouter
             return InputResult.NotHandled;
         }
 
-        // Collect all capture-override bindings from the entire tree
-        var overrideBindings = new List<InputBinding>();
-        CollectCaptureOverrideBindings(root, overrideBindings);
-        
-        if (overrideBindings.Count == 0)
+        // Capture-override bindings from the entire tree, collected once per frame
+        var trie = table.GetCaptureOverrideTrie();
+        if (trie is null)
         {
             return InputResult.NotHandled;
         }
         
-        // Build a trie from override bindings and check for a match
-        var trie = ChordTrie.Build(overrideBindings);
         var result = trie.Lookup(keyEvent);
         
         if (!result.IsNoMatch)
@@ -592,30 +574,6 @@ public static class InputRouter
         return InputResult.NotHandled;
     }
     
-    /// <summary>
-    /// Recursively collects all capture-override bindings from the node tree.
-    /// </summary>
-    private static void CollectCaptureOverrideBindings(Hex1bNode node, List<InputBinding> bindings)
-    {
-        var builder = node.BuildBindings();
-        var nodeBindings = builder.Build();
-        
-        foreach (var binding in nodeBindings)
-        {
-            if (binding.OverridesCapture)
-            {
-                binding.OwnerNode = node;
-                bindings.Add(binding);
-            }
-        }
-        
-        // Recurse into children
-        foreach (var child in node.GetChildren())
-        {
-            CollectCaptureOverrideBindings(child, bindings);
-        }
-    }
-    
     /// <summary>
     /// Gets all currently registered global bindings from the tree.
     /// Useful for checking conflicts during accelerator assignment.
@@ -668,46 +626,4 @@ public static class InputRouter
             CollectGlobalBindingsExcluding(child, bindings, excludeNode);
         }
     }
-    
-    /// <summary>
-    /// Recursively collects all global bindings from the node tree.
-    /// Throws on conflict for first key step.
-    /// </summary>
-    private static void CollectGlobalBindings(Hex1bNode node, List<InputBinding> bindings)
-    {
-        var builder = node.BuildBindings();
-        var nodeBindings = builder.Build();
-        
-        foreach (var binding in nodeBindings)
-        {
-            if (binding.IsGlobal)
-            {
-                binding.OwnerNode = node;
-                
-                // Check for conflict with existing bindings
-                var firstStep = binding.FirstStep;
-                foreach (var existing in bindings)
-                {
-                    if (existing.FirstStep.Key == firstStep.Key && 
-                        existing.FirstStep.Modifiers == firstStep.Modifiers)
-                    {
-                        var ownerName = existing.OwnerNode?.GetType().Name ?? "unknown";
-                        var newOwnerName = node.GetType().Name;
-                        throw new InvalidOperationException(
-                            $"Global binding conflict: {firstStep} is already registered by {ownerName} " +
-                            $"('{existing.Description}'). Cannot register it again from {newOwnerName} " +
-                            $"('{binding.Description}'). Use .DisableAccelerator() or .Accelerator() to resolve.");
-                    }
-                }
-                
-                bindings.Add(binding);
-            }
-        }
-        
-        // Recurse into children
-        foreach (var child in node.GetChildren())
-        {
-            CollectGlobalBindings(child, bindings);
-        }
-    }
 }
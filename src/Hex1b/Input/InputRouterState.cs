@@ -27,6 +27,12 @@ public sealed class InputRouterState
     /// </summary>
     internal int ChordLayerIndex { get; set; } = -1;
     
+    /// <summary>
+    /// The dispatch table for the current frame, or null when the owner doesn't reset it per
+    /// frame (routing then builds a fresh table for each event).
+    /// </summary>
+    private InputDispatchTable? _dispatchTable;
+
     /// <summary>
     /// Gets whether we're currently mid-chord.
     /// </summary>
@@ -53,6 +59,33 @@ public sealed class InputRouterState
         }
     }
     
+    /// <summary>
+    /// Starts a new dispatch table for <paramref name="root"/>. Called after each reconcile,
+    /// since that is when the tree and its bindings change.
+    /// </summary>
+    internal void ResetDispatchTable(Hex1bNode root)
+    {
+        if (_dispatchTable is null)
+        {
+            _dispatchTable = new InputDispatchTable(root);
+        }
+        else
+        {
+            _dispatchTable.Reset(root);
+        }
+    }
+
+    /// <summary>
+    /// Gets the dispatch table for <paramref name="root"/>: the per-frame table if it was
+    /// started for this root, otherwise a fresh one used for a single event.
+    /// </summary>
+    internal InputDispatchTable GetDispatchTable(Hex1bNode root)
+    {
+        return _dispatchTable is { } table && ReferenceEquals(table.Root, root)
+            ? table
+            : new InputDispatchTable(root);
+    }
+
     /// <summary>
     /// Notifies that the chord state changed.
     /// </summary>
@@ -30,6 +30,25 @@ public readonly struct Rect : IEquatable<Rect>
     /// <returns>True if the point is inside the rectangle, false otherwise.</returns>
     public bool Contains(int px, int py) => px >= X && px < Right && py >= Y && py < Bottom;
 
+    /// <summary>
+    /// Checks if this rectangle shares at least one cell with another.
+    /// </summary>
+    public bool IntersectsWith(Rect other)
+        => X < other.Right && other.X < Right && Y < other.Bottom && other.Y < Bottom;
+
+    /// <summary>
+    /// Returns the overlap of this rectangle and another, which is empty (zero width or
+    /// height) when they don't intersect.
+    /// </summary>
+    public Rect Intersect(Rect other)
+    {
+        var left = Math.Max(X, other.X);
+        var top = Math.Max(Y, other.Y);
+        return new Rect(left, top,
+            Math.Max(0, Math.Min(Right, other.Right) - left),
+            Math.Max(0, Math.Min(Bottom, other.Bottom) - top));
+    }
+
     public static Rect Zero => new(0, 0, 0, 0);
     public static Rect FromSize(Size size) => new(0, 0, size.Width, size.Height);
 
@@ -208,28 +208,28 @@ public sealed class EditorNode : Hex1bNode, IEditorSession
     public override void ConfigureDefaultBindings(InputBindingsBuilder bindings)
     {
         // ── Navigation ──────────────────────────────────────────
-        bindings.Key(Hex1bKey.LeftArrow).Triggers(EditorWidget.MoveLeft, MoveLeft, "Move left");
-        bindings.Key(Hex1bKey.RightArrow).Triggers(EditorWidget.MoveRight, MoveRight, "Move right");
-        bindings.Key(Hex1bKey.UpArrow).Triggers(EditorWidget.MoveUp, MoveUp, "Move up");
-        bindings.Key(Hex1bKey.DownArrow).Triggers(EditorWidget.MoveDown, MoveDown, "Move down");
+        bindings.Key(Hex1bKey.LeftArrow).Triggers(EditorWidget.MoveLeft, Repeated(MoveLeft), "Move left");
+        bindings.Key(Hex1bKey.RightArrow).Triggers(EditorWidget.MoveRight, Repeated(MoveRight), "Move right");
+        bindings.Key(Hex1bKey.UpArrow).Triggers(EditorWidget.MoveUp, Repeated(MoveUp), "Move up");
+        bindings.Key(Hex1bKey.DownArrow).Triggers(EditorWidget.MoveDown, Repeated(MoveDown), "Move down");
         bindings.Key(Hex1bKey.Home).Triggers(EditorWidget.MoveToLineStart, MoveToLineStart, "Go to line start");
         bindings.Key(Hex1bKey.End).Triggers(EditorWidget.MoveToLineEnd, MoveToLineEnd, "Go to line end");
         bindings.Ctrl().Key(Hex1bKey.Home).Triggers(EditorWidget.MoveToDocumentStart, MoveToDocumentStart, "Go to document start");
         bindings.Ctrl().Key(Hex1bKey.End).Triggers(EditorWidget.MoveToDocumentEnd, MoveToDocumentEnd, "Go to document end");
         bindings.Ctrl().Key(Hex1bKey.LeftArrow).Triggers(EditorWidget.MoveWordLeft, MoveWordLeft, "Move to previous word");
         bindings.Ctrl().Key(Hex1bKey.RightArrow).Triggers(EditorWidget.MoveWordRight, MoveWordRight, "Move to next word");
-        bindings.Key(Hex1bKey.PageUp).Triggers(EditorWidget.PageUp, PageUp, "Page up");
-        bindings.Key(Hex1bKey.PageDown).Triggers(EditorWidget.PageDown, PageDown, "Page down");
+        bindings.Key(Hex1bKey.PageUp).Triggers(EditorWidget.PageUp, Repeated(PageUp), "Page up");
+        bindings.Key(Hex1bKey.PageDown).Triggers(EditorWidget.PageDown, Repeated(PageDown), "Page down");
 
         // ── Selection (Shift+Navigation) ────────────────────────
-        bindings.Shift().Key(Hex1bKey.LeftArrow).Triggers(EditorWidget.SelectLeft, SelectLeft, "Extend selection left");
-        bindings.Shift().Key(Hex1bKey.RightArrow).Triggers(EditorWidget.SelectRight, SelectRight, "Extend selection right");
-        bindings.Shift().Key(Hex1bKey.UpArrow).Triggers(EditorWidget.SelectUp, SelectUp, "Extend selection up");
-        bindings.Shift().Key(Hex1bKey.DownArrow).Triggers(EditorWidget.SelectDown, SelectDown, "Extend selection down");
+        bindings.Shift().Key(Hex1bKey.LeftArrow).Triggers(EditorWidget.SelectLeft, Repeated(SelectLeft), "Extend selection left");
+        bindings.Shift().Key(Hex1bKey.RightArrow).Triggers(EditorWidget.SelectRight, Repeated(SelectRight), "Extend selection right");
+        bindings.Shift().Key(Hex1bKey.UpArrow).Triggers(EditorWidget.SelectUp, Repeated(SelectUp), "Extend selection up");
+        bindings.Shift().Key(Hex1bKey.DownArrow).Triggers(EditorWidget.SelectDown, Repeated(SelectDown), "Extend selection down");
         bindings.Shift().Key(Hex1bKey.Home).Triggers(EditorWidget.SelectToLineStart, SelectToLineStart, "Select to line start");
         bindings.Shift().Key(Hex1bKey.End).Triggers(EditorWidget.SelectToLineEnd, SelectToLineEnd, "Select to line end");
-        bindings.Shift().Key(Hex1bKey.PageUp).Triggers(EditorWidget.SelectPageUp, SelectPageUp, "Select page up");
-        bindings.Shift().Key(Hex1bKey.PageDown).Triggers(EditorWidget.SelectPageDown, SelectPageDown, "Select page down");
+        bindings.Shift().Key(Hex1bKey.PageUp).Triggers(EditorWidget.SelectPageUp, Repeated(SelectPageUp), "Select page up");
+        bindings.Shift().Key(Hex1bKey.PageDown).Triggers(EditorWidget.SelectPageDown, Repeated(SelectPageDown), "Select page down");
 
         // Ctrl+Shift bindings
         bindings.Ctrl().Shift().Key(Hex1bKey.Home).Triggers(EditorWidget.SelectToDocumentStart, SelectToDocumentStart, "Select to document start");
@@ -282,10 +282,10 @@ public sealed class EditorNode : Hex1bNode, IEditorSession
         bindings.Mouse(MouseButton.Left).TripleClick().Triggers(EditorWidget.TripleClick, HandleMouseTripleClick, "Triple-click to select line");
         // DragStepBuilder has no Triggers, keep .Action()
         bindings.Drag(MouseButton.Left).Action(HandleDragStart, "Drag to select text");
-        bindings.Mouse(MouseButton.ScrollUp).Triggers(EditorWidget.ScrollUp, ScrollUp, "Scroll up");
-        bindings.Mouse(MouseButton.ScrollDown).Triggers(EditorWidget.ScrollDown, ScrollDown, "Scroll down");
-        bindings.Mouse(MouseButton.ScrollUp).Shift().Triggers(EditorWidget.ScrollLeft, ScrollLeft, "Scroll left");
-        bindings.Mouse(MouseButton.ScrollDown).Shift().Triggers(EditorWidget.ScrollRight, ScrollRight, "Scroll right");
+        bindings.Mouse(MouseButton.ScrollUp).Triggers(EditorWidget.ScrollUp, Repeated(ScrollUp), "Scroll up");
+        bindings.Mouse(MouseButton.ScrollDown).Triggers(EditorWidget.ScrollDown, Repeated(ScrollDown), "Scroll down");
+        bindings.Mouse(MouseButton.ScrollUp).Shift().Triggers(EditorWidget.ScrollLeft, Repeated(ScrollLeft), "Scroll left");
+        bindings.Mouse(MouseButton.ScrollDown).Shift().Triggers(EditorWidget.ScrollRight, Repeated(ScrollRight), "Scroll right");
     }
 
     protected override Size MeasureCore(Constraints constraints)
@@ -1391,6 +1391,18 @@ public sealed class EditorNode : Hex1bNode, IEditorSession
 
     // --- Input handlers: navigation ---
 
+    /// <summary>
+    /// Wraps a one-step handler so a merged key-repeat or wheel burst runs it once per repeat
+    /// within a single routed event.
+    /// </summary>
+    private static Action<InputBindingActionContext> Repeated(Action step) => ctx =>
+    {
+        for (var repeats = ctx.ConsumeRepeatCount(); repeats > 0; repeats--)
+        {
+            step();
+        }
+    };
+
     private void MoveLeft()
     {
         _completionController?.Dismiss();
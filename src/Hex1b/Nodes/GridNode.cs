@@ -250,6 +250,9 @@ public sealed class GridNode : Hex1bNode, ILayoutProvider
 
         foreach (var entry in CellEntries)
         {
+            // Cells scrolled out of view can't show anything
+            if (context.IsOutsideVisibleRect(entry.Node.Bounds))
+                continue;
             context.RenderChild(entry.Node);
         }
 
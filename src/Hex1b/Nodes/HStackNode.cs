@@ -147,6 +147,9 @@ public sealed class HStackNode : Hex1bNode, ILayoutProvider
         
         for (int i = 0; i < Children.Count; i++)
         {
+            // Children scrolled out of view can't show anything
+            if (context.IsOutsideVisibleRect(Children[i].Bounds))
+                continue;
             context.RenderChild(Children[i]);
         }
 
@@ -222,6 +222,13 @@ public abstract class Hex1bNode
     /// </summary>
     internal Rect CachedBounds { get; set; }
 
+    /// <summary>
+    /// The visible rect the cached surface was rendered under when it cut into this node's
+    /// bounds, so children outside it may be missing from the surface; null when the whole
+    /// node was visible. The cache is only reused under the same visible rect.
+    /// </summary>
+    internal Rect? CachedVisibleRect { get; set; }
+
     /// <summary>
     /// Most recent dirty version for this node/subtree.
     /// Updated whenever this node or any descendant is marked dirty.
@@ -707,7 +707,11 @@ public class ListNode<T> : Hex1bNode, ILayoutProvider
 
     private async Task MoveUpWithEvent(InputBindingActionContext ctx)
     {
-        MoveUp();
+        // A held key or a fast wheel arrives as one event; move by all of it at once
+        for (var steps = ctx.ConsumeRepeatCount(); steps > 0; steps--)
+        {
+            MoveUp();
+        }
         if (FocusChangedAction != null)
         {
             await EnsureFocusedItemLoadedAsync(ctx.CancellationToken).ConfigureAwait(false);
@@ -717,7 +721,11 @@ public class ListNode<T> : Hex1bNode, ILayoutProvider
 
     private async Task MoveDownWithEvent(InputBindingActionContext ctx)
     {
-        MoveDown();
+        // A held key or a fast wheel arrives as one event; move by all of it at once
+        for (var steps = ctx.ConsumeRepeatCount(); steps > 0; steps--)
+        {
+            MoveDown();
+        }
         if (FocusChangedAction != null)
         {
             await EnsureFocusedItemLoadedAsync(ctx.CancellationToken).ConfigureAwait(false);
@@ -793,7 +801,10 @@ public class ListNode<T> : Hex1bNode, ILayoutProvider
     private async Task PageUpWithEvent(InputBindingActionContext ctx)
     {
         var previous = FocusedIndex;
-        PageUp();
+        for (var pages = ctx.ConsumeRepeatCount(); pages > 0; pages--)
+        {
+            PageUp();
+        }
         if (previous != FocusedIndex && FocusChangedAction != null)
         {
             await EnsureFocusedItemLoadedAsync(ctx.CancellationToken).ConfigureAwait(false);
@@ -804,7 +815,10 @@ public class ListNode<T> : Hex1bNode, ILayoutProvider
     private async Task PageDownWithEvent(InputBindingActionContext ctx)
     {
         var previous = FocusedIndex;
-        PageDown();
+        for (var pages = ctx.ConsumeRepeatCount(); pages > 0; pages--)
+        {
+            PageDown();
+        }
         if (previous != FocusedIndex && FocusChangedAction != null)
         {
             await EnsureFocusedItemLoadedAsync(ctx.CancellationToken).ConfigureAwait(false);
@@ -1,5 +1,6 @@
 using Hex1b.Input;
 using Hex1b.Layout;
+using Hex1b.Surfaces;
 using Hex1b.Theming;
 using Hex1b.Widgets;
 
@@ -190,6 +191,13 @@ public sealed class ScrollPanelNode : Hex1bNode, ILayoutProvider
     /// The size of the child content (measured unbounded in scroll direction).
     /// </summary>
     private Size _contentSize;
+
+    // What _contentSize was measured from: the child, its constraints, and the child's
+    // subtree version once it had been arranged. Scrolling only moves the content, so
+    // while none of these change the child tree isn't measured again.
+    private Hex1bNode? _measuredChild;
+    private Constraints _measuredConstraints;
+    private long _measuredChildVersion = -1;
     
     private int _focusedIndex = 0;
     private List<Hex1bNode>? _focusableNodes;
@@ -240,8 +248,8 @@ public sealed class ScrollPanelNode : Hex1bNode, ILayoutProvider
         bindings.Key(Hex1bKey.Escape).Triggers(ScrollPanelWidget.FocusFirstAction, _ => FocusFirst(), "Jump to first focusable");
         
         // Mouse wheel scrolling
-        bindings.Mouse(MouseButton.ScrollUp).Triggers(ScrollPanelWidget.MouseScrollUpAction, ctx => ScrollByAmount(-3, ctx), "Scroll up");
-        bindings.Mouse(MouseButton.ScrollDown).Triggers(ScrollPanelWidget.MouseScrollDownAction, ctx => ScrollByAmount(3, ctx), "Scroll down");
+        bindings.Mouse(MouseButton.ScrollUp).Triggers(ScrollPanelWidget.MouseScrollUpAction, ctx => ScrollByAmount(-3 * ctx.ConsumeRepeatCount(), ctx), "Scroll up");
+        bindings.Mouse(MouseButton.ScrollDown).Triggers(ScrollPanelWidget.MouseScrollDownAction, ctx => ScrollByAmount(3 * ctx.ConsumeRepeatCount(), ctx), "Scroll down");
         
         // Mouse drag on scrollbar (handles both clicks and thumb dragging)
         bindings.Drag(MouseButton.Left).Action(HandleScrollbarDrag, "Drag scrollbar");
@@ -628,7 +636,16 @@ public sealed class ScrollPanelNode : Hex1bNode, ILayoutProvider
             ? new Constraints(0, Math.Max(0, constraints.MaxWidth - scrollbarWidth), 0, int.MaxValue)
             : new Constraints(0, int.MaxValue, 0, Math.Max(0, constraints.MaxHeight - scrollbarHeight));
         
-        _contentSize = Child.Measure(childConstraints);
+        if (!ReferenceEquals(Child, _measuredChild)
+            || childConstraints != _measuredConstraints
+            || Child.SubtreeRenderVersion != _measuredChildVersion
+            || !SurfaceRenderContext.HasConsistentParentLinks(Child))
+        {
+            _contentSize = Child.Measure(childConstraints);
+            _measuredChild = Child;
+            _measuredConstraints = childConstraints;
+            _measuredChildVersion = -1;
+        }
         
         // Update content size
         if (Orientation == ScrollOrientation.Vertical)
@@ -730,6 +747,12 @@ public sealed class ScrollPanelNode : Hex1bNode, ILayoutProvider
                 Child.Arrange(new Rect(childX, bounds.Y, _contentSize.Width, viewportHeight));
             }
         }
+
+        // Moving the content marks it dirty; that alone doesn't change its size
+        if (ReferenceEquals(Child, _measuredChild))
+        {
+            _measuredChildVersion = Child.SubtreeRenderVersion;
+        }
     }
 
     public override void Render(Hex1bRenderContext context)
@@ -741,10 +764,14 @@ public sealed class ScrollPanelNode : Hex1bNode, ILayoutProvider
         ParentLayoutProvider = previousLayout;
         context.CurrentLayoutProvider = this;
         
-        // Use RenderChild for automatic caching support
+        // Use RenderChild for automatic caching support. Only the viewport can be seen,
+        // so containers in the content skip children scrolled out of it.
         if (Child != null)
         {
+            var previousVisible = context.VisibleRect;
+            context.VisibleRect = previousVisible is { } outer ? outer.Intersect(_viewportRect) : _viewportRect;
             context.RenderChild(Child);
+            context.VisibleRect = previousVisible;
         }
         
         context.CurrentLayoutProvider = previousLayout;
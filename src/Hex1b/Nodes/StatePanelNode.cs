@@ -80,6 +80,24 @@ public sealed class StatePanelNode : Hex1bNode
         }
     }
 
+    /// <summary>
+    /// Returns the total <see cref="IActiveState.ActiveCount"/> of the stored state,
+    /// or 0 when nothing needs another frame.
+    /// </summary>
+    internal int ActiveStateCount
+    {
+        get
+        {
+            var count = 0;
+            foreach (var state in _stateStore.Values)
+            {
+                if (state is IActiveState active && active.IsActive)
+                    count += Math.Max(1, active.ActiveCount);
+            }
+            return count;
+        }
+    }
+
     /// <summary>
     /// Advances all stored state that implements <see cref="IActiveState"/> by the given
     /// elapsed time. Called once per reconciliation frame before the builder runs.
@@ -402,8 +402,8 @@ public class TableNode<TRow> : Hex1bNode, ILayoutProvider, IDisposable
         bindings.Key(Hex1bKey.PageDown).Triggers(TableWidget<TRow>.PageDown, PageDown, "Page down");
         
         // Mouse wheel scrolling
-        bindings.Mouse(MouseButton.ScrollUp).Triggers(TableWidget<TRow>.ScrollUp, _ => { ScrollByAmount(-3); UserScrolledAway = true; }, "Scroll up");
-        bindings.Mouse(MouseButton.ScrollDown).Triggers(TableWidget<TRow>.ScrollDown, _ => { ScrollByAmount(3); if (_scrollOffset >= MaxScrollOffset) UserScrolledAway = false; }, "Scroll down");
+        bindings.Mouse(MouseButton.ScrollUp).Triggers(TableWidget<TRow>.ScrollUp, ctx => { ScrollByAmount(-3 * ctx.ConsumeRepeatCount()); UserScrolledAway = true; }, "Scroll up");
+        bindings.Mouse(MouseButton.ScrollDown).Triggers(TableWidget<TRow>.ScrollDown, ctx => { ScrollByAmount(3 * ctx.ConsumeRepeatCount()); if (_scrollOffset >= MaxScrollOffset) UserScrolledAway = false; }, "Scroll down");
         
         // Scrollbar drag — DragStepBuilder has no Triggers, keep .Action()
         bindings.Drag(MouseButton.Left).Action(HandleScrollbarDrag, "Drag scrollbar");
@@ -754,34 +754,40 @@ public class TableNode<TRow> : Hex1bNode, ILayoutProvider, IDisposable
 
     private async Task MoveFocusUp(InputBindingActionContext ctx)
     {
+        var steps = ctx.ConsumeRepeatCount();
         var currentIndex = await GetFocusedRowIndexAsync();
         if (currentIndex < 0)
         {
-            // No focus - focus the first visible row
-            _ = SetFocusedRowIndexAsync(_scrollOffset);
+            // No focus - the first step focuses the first visible row, the rest move on from it
+            _ = SetFocusedRowIndexAsync(Math.Max(0, _scrollOffset - (steps - 1)));
         }
         else if (currentIndex > 0)
         {
-            _ = SetFocusedRowIndexAsync(currentIndex - 1);
+            _ = SetFocusedRowIndexAsync(Math.Max(0, currentIndex - steps));
         }
         UserScrolledAway = true;
     }
 
     private async Task MoveFocusDown(InputBindingActionContext ctx)
     {
+        var steps = ctx.ConsumeRepeatCount();
         var currentIndex = await GetFocusedRowIndexAsync();
         var maxIndex = GetEffectiveItemCount() - 1;
         
         if (currentIndex < 0)
         {
-            // No focus - focus the first visible row
-            _ = SetFocusedRowIndexAsync(_scrollOffset);
+            // No focus - the first step focuses the first visible row, the rest move on from it
+            var newIndex = Math.Max(_scrollOffset, Math.Min(_scrollOffset + steps - 1, maxIndex));
+            _ = SetFocusedRowIndexAsync(newIndex);
+            if (newIndex == maxIndex)
+                UserScrolledAway = false;
         }
         else if (currentIndex < maxIndex)
         {
-            _ = SetFocusedRowIndexAsync(currentIndex + 1);
+            var newIndex = Math.Min(currentIndex + steps, maxIndex);
+            _ = SetFocusedRowIndexAsync(newIndex);
             // If we just moved to the last row, re-engage follow
-            if (currentIndex + 1 == maxIndex)
+            if (newIndex == maxIndex)
                 UserScrolledAway = false;
         }
         else if (currentIndex >= maxIndex)
@@ -813,7 +819,7 @@ public class TableNode<TRow> : Hex1bNode, ILayoutProvider, IDisposable
 
     private async Task PageUp(InputBindingActionContext ctx)
     {
-        var pageSize = Math.Max(1, _viewportRowCount - 1);
+        var pageSize = Math.Max(1, _viewportRowCount - 1) * ctx.ConsumeRepeatCount();
         var currentIndex = await GetFocusedRowIndexAsync();
         
         if (currentIndex >= 0)
@@ -831,7 +837,7 @@ public class TableNode<TRow> : Hex1bNode, ILayoutProvider, IDisposable
 
     private async Task PageDown(InputBindingActionContext ctx)
     {
-        var pageSize = Math.Max(1, _viewportRowCount - 1);
+        var pageSize = Math.Max(1, _viewportRowCount - 1) * ctx.ConsumeRepeatCount();
         var currentIndex = await GetFocusedRowIndexAsync();
         var maxIndex = GetEffectiveItemCount() - 1;
         
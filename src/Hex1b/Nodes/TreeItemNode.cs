@@ -183,6 +183,11 @@ public sealed class TreeItemNode : Hex1bNode
     /// </summary>
     public bool[] IsLastAtDepth { get; set; } = [];
 
+    /// <summary>
+    /// The parent TreeNode's row for this item.
+    /// </summary>
+    internal TreeRow? Row { get; set; }
+
     // Focus tracking
     private bool _isFocused;
     public override bool IsFocused 
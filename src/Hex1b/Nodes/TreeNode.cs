@@ -1,3 +1,5 @@
+using System.Collections;
+using Hex1b.Data;
 using Hex1b.Events;
 using Hex1b.Input;
 using Hex1b.Layout;
@@ -33,9 +35,66 @@ public sealed class TreeNode : Hex1bNode
     public TreeWidget? SourceWidget { get; set; }
 
     /// <summary>
-    /// Flattened list of visible tree items for rendering and navigation.
+    /// Rows above and below the viewport that keep their item nodes when the tree is
+    /// bound to a data source.
     /// </summary>
-    internal List<FlattenedTreeEntry> FlattenedItems { get; } = new();
+    internal const int VirtualizationBuffer = 5;
+
+    private readonly TreeRowIndex _rows = new();
+
+    // Guards _rows against expansions finishing on a background thread
+    private readonly object _rowsLock = new();
+
+    private ITreeRowSource? _dataSource;
+    private Task? _rootsLoad;
+    private Exception? _rootsLoadError;
+
+    // Rows whose item node was created from the data source, and the rows in or near the
+    // viewport this frame
+    private readonly HashSet<TreeRow> _materializedRows = new();
+    private readonly HashSet<TreeRow> _windowRows = new();
+
+    private TreeItemNode? _focusedNode;
+
+    /// <summary>
+    /// The visible tree items, in display order, for rendering and navigation.
+    /// </summary>
+    internal FlattenedTreeView FlattenedItems => new(this);
+
+    /// <summary>
+    /// Order-statistic index over the tree's rows.
+    /// </summary>
+    internal TreeRowIndex Rows => _rows;
+
+    /// <summary>
+    /// Data source the items come from instead of <see cref="Items"/>. Binding a
+    /// different source drops all rows; they are reloaded by <see cref="EnsureRootsLoading"/>.
+    /// </summary>
+    internal ITreeRowSource? DataSource
+    {
+        get => _dataSource;
+        set
+        {
+            if (ReferenceEquals(_dataSource?.Source, value?.Source)) return;
+
+            lock (_rowsLock)
+            {
+                _dataSource = value;
+                _rootsLoad = null;
+                _rootsLoadError = null;
+                foreach (var row in _materializedRows)
+                {
+                    row.Node = null;
+                }
+                _materializedRows.Clear();
+                _rows.Clear();
+                _focusedIndex = 0;
+                _scrollOffset = 0;
+            }
+            UpdateFocus();
+            MarkDirty();
+        }
+    }
 
     /// <summary>
     /// Index of the currently focused item in the flattened view.
@@ -103,7 +162,10 @@ public sealed class TreeNode : Hex1bNode
         // TreeNode itself is focusable
         yield return this;
         
-        // Also expose checkboxes from visible tree items for hit testing
+        // Also expose checkboxes from visible tree items for hit testing. Items from a
+        // data source have no checkboxes, so there is nothing to gather from them.
+        if (_dataSource is not null) yield break;
+
         foreach (var entry in FlattenedItems)
         {
             foreach (var focusable in entry.Node.GetFocusableNodes())
@@ -129,10 +191,11 @@ public sealed class TreeNode : Hex1bNode
 
     private Task MoveFocusUp(InputBindingActionContext ctx)
     {
-        if (FlattenedItems.Count == 0) return Task.CompletedTask;
+        var count = _rows.Count;
+        if (count == 0) return Task.CompletedTask;
         
         var previousIndex = _focusedIndex;
-        _focusedIndex = _focusedIndex <= 0 ? FlattenedItems.Count - 1 : _focusedIndex - 1;
+        _focusedIndex = _focusedIndex <= 0 ? count - 1 : _focusedIndex - 1;
         
         if (previousIndex != _focusedIndex)
         {
@@ -146,10 +209,11 @@ public sealed class TreeNode : Hex1bNode
 
     private Task MoveFocusDown(InputBindingActionContext ctx)
     {
-        if (FlattenedItems.Count == 0) return Task.CompletedTask;
+        var count = _rows.Count;
+        if (count == 0) return Task.CompletedTask;
         
         var previousIndex = _focusedIndex;
-        _focusedIndex = (_focusedIndex + 1) % FlattenedItems.Count;
+        _focusedIndex = (_focusedIndex + 1) % count;
         
         if (previousIndex != _focusedIndex)
         {
@@ -163,45 +227,54 @@ public sealed class TreeNode : Hex1bNode
 
     private async Task HandleLeft(InputBindingActionContext ctx)
     {
-        if (FlattenedItems.Count == 0) return;
+        if (_rows.Count == 0) return;
         
-        var focused = FlattenedItems[_focusedIndex];
-        if (focused.Node.IsExpanded && focused.Node.CanExpand)
+        TreeRow row;
+        TreeItemNode focused;
+        int parentIndex;
+        lock (_rowsLock)
+        {
+            row = _rows[_focusedIndex];
+            focused = GetItemNode(row);
+            parentIndex = row.Parent is { } parent ? _rows.IndexOf(parent) : -1;
+        }
+
+        if (focused.IsExpanded && focused.CanExpand)
         {
             // Collapse the current item
-            await ToggleExpandAsync(focused.Node, ctx);
+            await ToggleExpandAsync(focused, ctx);
         }
-        else if (focused.Depth > 0)
+        else if (parentIndex >= 0)
         {
             // Move to parent
-            for (int i = _focusedIndex - 1; i >= 0; i--)
-            {
-                if (FlattenedItems[i].Depth < focused.Depth)
-                {
-                    _focusedIndex = i;
-                    UpdateFocus();
-                    EnsureFocusedVisible();
-                    MarkDirty();
-                    break;
-                }
-            }
+            _focusedIndex = parentIndex;
+            UpdateFocus();
+            EnsureFocusedVisible();
+            MarkDirty();
         }
     }
 
     private async Task HandleRight(InputBindingActionContext ctx)
     {
-        if (FlattenedItems.Count == 0) return;
+        if (_rows.Count == 0) return;
         
-        var focused = FlattenedItems[_focusedIndex];
-        if (!focused.Node.IsExpanded && focused.Node.CanExpand)
+        TreeRow row;
+        TreeItemNode focused;
+        lock (_rowsLock)
+        {
+            row = _rows[_focusedIndex];
+            focused = GetItemNode(row);
+        }
+
+        if (!focused.IsExpanded && focused.CanExpand)
         {
             // Expand the current item
-            await ToggleExpandAsync(focused.Node, ctx);
+            await ToggleExpandAsync(focused, ctx);
         }
-        else if (focused.Node.IsExpanded && focused.Node.Children.Count > 0)
+        else if (row.IsExpanded && row.Children.Count > 0)
         {
             // Move to first child (it's the next item in flattened view)
-            if (_focusedIndex + 1 < FlattenedItems.Count)
+            if (_focusedIndex + 1 < _rows.Count)
             {
                 _focusedIndex++;
                 UpdateFocus();
@@ -213,9 +286,7 @@ public sealed class TreeNode : Hex1bNode
 
     private async Task HandleSpace(InputBindingActionContext ctx)
     {
-        if (FlattenedItems.Count == 0) return;
-        
-        var focused = FlattenedItems[_focusedIndex].Node;
+        if (GetFocusedItemNode() is not { } focused) return;
         
         if (MultiSelect)
         {
@@ -260,24 +331,25 @@ public sealed class TreeNode : Hex1bNode
     /// </summary>
     internal void FocusItem(TreeItemNode node)
     {
-        for (int i = 0; i < FlattenedItems.Count; i++)
+        int index;
+        lock (_rowsLock)
         {
-            if (FlattenedItems[i].Node == node)
-            {
-                _focusedIndex = i;
-                UpdateFocus();
-                EnsureFocusedVisible();
-                MarkDirty();
-                return;
-            }
+            index = node.Row is { } row ? _rows.IndexOf(row) : -1;
+        }
+
+        if (index >= 0)
+        {
+            _focusedIndex = index;
+            UpdateFocus();
+            EnsureFocusedVisible();
+            MarkDirty();
         }
     }
 
     private async Task ActivateFocused(InputBindingActionContext ctx)
     {
-        if (FlattenedItems.Count == 0) return;
+        if (GetFocusedItemNode() is not { } focused) return;
         
-        var focused = FlattenedItems[_focusedIndex].Node;
         if (focused.ActivateCallback != null)
         {
             await focused.ActivateCallback(ctx);
@@ -290,10 +362,9 @@ public sealed class TreeNode : Hex1bNode
         var localX = ctx.MouseX - Bounds.X;
         var itemIndex = localY + _scrollOffset;
         
-        if (itemIndex >= 0 && itemIndex < FlattenedItems.Count)
+        if (itemIndex >= 0 && itemIndex < _rows.Count)
         {
-            var clickedEntry = FlattenedItems[itemIndex];
-            var clickedNode = clickedEntry.Node;
+            var clickedNode = FlattenedItems[itemIndex].Node;
             
             // Update focus
             _focusedIndex = itemIndex;
@@ -321,7 +392,7 @@ public sealed class TreeNode : Hex1bNode
         var localY = ctx.MouseY - Bounds.Y;
         var itemIndex = localY + _scrollOffset;
         
-        if (itemIndex >= 0 && itemIndex < FlattenedItems.Count)
+        if (itemIndex >= 0 && itemIndex < _rows.Count)
         {
             var clickedNode = FlattenedItems[itemIndex].Node;
             
@@ -345,6 +416,12 @@ public sealed class TreeNode : Hex1bNode
     /// </summary>
     internal async Task ToggleExpandAsync(TreeItemNode node, InputBindingActionContext ctx)
     {
+        if (_dataSource is not null && node.Row is { } dataRow)
+        {
+            ToggleRowExpand(dataRow, ctx);
+            return;
+        }
+
         if (node.IsExpanded)
         {
             // Collapse
@@ -404,7 +481,7 @@ public sealed class TreeNode : Hex1bNode
                                 await capturedNode.SourceWidget.ExpandedHandler(args);
                             }
                             
-                            RebuildFlattenedView();
+                            SyncRow(capturedNode);
                             MarkDirty();
                             ctx.Invalidate(); // Wake up render loop to show the result
                         }
@@ -425,11 +502,120 @@ public sealed class TreeNode : Hex1bNode
             }
         }
         
-        RebuildFlattenedView();
+        SyncRow(node);
         MarkDirty();
         ctx.Invalidate(); // Wake up render loop to show the result
     }
 
+    /// <summary>
+    /// Expands or collapses a row of a tree bound to a data source. Children are loaded
+    /// the first time; a load that doesn't complete synchronously finishes in the
+    /// background with a spinner shown meanwhile.
+    /// </summary>
+    private void ToggleRowExpand(TreeRow row, InputBindingActionContext ctx)
+    {
+        var source = _dataSource!;
+        if (row.IsLoading)
+        {
+            return;
+        }
+
+        if (row.IsExpanded || row.ChildrenLoaded)
+        {
+            lock (_rowsLock)
+            {
+                _rows.SetExpanded(row, !row.IsExpanded);
+                SyncItemNode(row);
+                RestoreFocus();
+            }
+            UpdateFocus();
+            MarkDirty();
+            ctx.Invalidate();
+            return;
+        }
+
+        var load = source.GetChildrenAsync(row, ctx.CancellationToken);
+        if (load.IsCompletedSuccessfully)
+        {
+            ApplyLoadedChildren(source, row, load.Result);
+            ctx.Invalidate();
+            return;
+        }
+
+        row.IsLoading = true;
+        SyncItemNode(row);
+        ResetSpinnerAnimation(); // Start spinner from beginning
+        MarkDirty();
+        ctx.Invalidate(); // Wake up render loop to show loading state
+
+        _ = Task.Run(async () =>
+        {
+            try
+            {
+                ApplyLoadedChildren(source, row, await load);
+            }
+            finally
+            {
+                row.IsLoading = false;
+                SyncItemNode(row);
+                MarkDirty();
+                ctx.Invalidate(); // Wake up render loop to show the result
+            }
+        });
+    }
+
+    private void ApplyLoadedChildren(ITreeRowSource source, TreeRow row, IReadOnlyList<TreeRow> children)
+    {
+        lock (_rowsLock)
+        {
+            // The tree was bound to another source while loading
+            if (!ReferenceEquals(source, _dataSource)) return;
+
+            _rows.SetChildren(row, children);
+            row.HasChildren = children.Count > 0;
+            _rows.SetExpanded(row, true);
+            SyncItemNode(row);
+            RestoreFocus();
+        }
+        UpdateFocus();
+        MarkDirty();
+    }
+
+    /// <summary>
+    /// Brings the row of a tree item built from widgets in line with the item after it
+    /// was expanded, collapsed or had children loaded.
+    /// </summary>
+    private void SyncRow(TreeItemNode node)
+    {
+        lock (_rowsLock)
+        {
+            if (node.Row is not { } row)
+            {
+                RebuildFlattenedView();
+                return;
+            }
+
+            if (!HasRowsFor(row, node.Children))
+            {
+                _rows.SetChildren(row, BuildRows(node.Children, new List<bool>(node.IsLastAtDepth)));
+            }
+            row.HasChildren = node.HasChildren;
+            _rows.SetExpanded(row, node.IsExpanded);
+            RestoreFocus();
+        }
+        UpdateFocus();
+    }
+
+    private static bool HasRowsFor(TreeRow row, IReadOnlyList<TreeItemNode> children)
+    {
+        if (row.Children.Count != children.Count) return false;
+        for (int i = 0; i < children.Count; i++)
+        {
+            if (row.Children[i].Node != children[i]) return false;
+        }
+        return true;
+    }
+
     private Task LoadChildrenAsync(TreeItemNode parent, IEnumerable<TreeItemWidget> childWidgets)
     {
         var children = new List<TreeItemNode>();
@@ -497,56 +683,306 @@ public sealed class TreeNode : Hex1bNode
     /// </summary>
     internal void RebuildFlattenedView()
     {
-        FlattenedItems.Clear();
-        var isLastAtDepth = new List<bool>();
-        FlattenItems(Items, 0, isLastAtDepth);
-        
-        // Clamp focus index
-        if (_focusedIndex >= FlattenedItems.Count)
+        lock (_rowsLock)
         {
-            _focusedIndex = Math.Max(0, FlattenedItems.Count - 1);
+            _rows.SetRoots(BuildRows(Items, new List<bool>()));
+            RestoreFocus();
         }
         
         UpdateFocus();
     }
 
-    private void FlattenItems(IReadOnlyList<TreeItemNode> items, int depth, List<bool> isLastAtDepth)
+    /// <summary>
+    /// Creates the rows for tree items built from widgets, collapsed subtrees included,
+    /// and sets the items' guide information on the way.
+    /// </summary>
+    /// <param name="items">Sibling items.</param>
+    /// <param name="isLastAtDepth">Whether each ancestor is the last of its siblings; its
+    /// length is the items' depth.</param>
+    private TreeRow[] BuildRows(IReadOnlyList<TreeItemNode> items, List<bool> isLastAtDepth)
     {
+        var depth = isLastAtDepth.Count;
+        var rows = new TreeRow[items.Count];
         for (int i = 0; i < items.Count; i++)
         {
             var item = items[i];
             item.Depth = depth;
             item.IsLastChild = i == items.Count - 1;
             
-            // Build the IsLastAtDepth array for this item
-            while (isLastAtDepth.Count <= depth)
+            isLastAtDepth.Add(item.IsLastChild);
+            item.IsLastAtDepth = isLastAtDepth.ToArray();
+            
+            var row = new TreeRow { Node = item, HasChildren = item.HasChildren, IsExpanded = item.IsExpanded };
+            if (item.Children.Count > 0)
             {
-                isLastAtDepth.Add(false);
+                _rows.SetChildren(row, BuildRows(item.Children, isLastAtDepth));
             }
-            isLastAtDepth[depth] = item.IsLastChild;
-            item.IsLastAtDepth = isLastAtDepth.Take(depth + 1).ToArray();
+            isLastAtDepth.RemoveAt(depth);
             
-            FlattenedItems.Add(new FlattenedTreeEntry(item, depth, item.IsLastAtDepth));
-            
-            // Recursively add children if expanded
-            if (item.IsExpanded && item.Children.Count > 0)
+            item.Row = row;
+            rows[i] = row;
+        }
+        return rows;
+    }
+
+    /// <summary>
+    /// Keeps focus on the focused item when rows before it appear or disappear, or clamps
+    /// the focused index if the item is no longer visible. Call with the rows locked.
+    /// </summary>
+    private void RestoreFocus()
+    {
+        var index = _focusedNode?.Row is { } row ? _rows.IndexOf(row) : -1;
+        if (index >= 0)
+        {
+            _focusedIndex = index;
+        }
+        else if (_focusedIndex >= _rows.Count)
+        {
+            _focusedIndex = Math.Max(0, _rows.Count - 1);
+        }
+    }
+
+    private void UpdateFocus()
+    {
+        var focused = GetFocusedItemNode();
+        if (_focusedNode != focused && _focusedNode != null)
+        {
+            _focusedNode.IsFocused = false;
+        }
+        _focusedNode = focused;
+        if (focused != null)
+        {
+            focused.IsFocused = true;
+        }
+    }
+
+    private TreeItemNode? GetFocusedItemNode()
+    {
+        lock (_rowsLock)
+        {
+            return _focusedIndex < _rows.Count ? GetItemNode(_rows[_focusedIndex]) : null;
+        }
+    }
+
+    /// <summary>
+    /// Returns the item node for a row, creating one from the data source if the row
+    /// has none.
+    /// </summary>
+    internal TreeItemNode GetItemNode(TreeRow row)
+    {
+        if (row.Node is { } existing)
+        {
+            return existing;
+        }
+
+        var node = new TreeItemNode
+        {
+            Row = row,
+            Depth = row.Depth,
+            IsLastChild = row.IsLastChild,
+            IsLastAtDepth = row.GetIsLastAtDepth()
+        };
+        _dataSource!.Describe(row, node);
+
+        node.ActivateCallback = async ctx =>
+        {
+            if (ItemActivatedAction != null)
             {
-                FlattenItems(item.Children, depth + 1, isLastAtDepth);
+                await ItemActivatedAction(ctx, node);
             }
+        };
+        node.ToggleExpandCallback = ctx => ToggleExpandAsync(node, ctx);
+
+        if (node.Icon != null)
+        {
+            node.UserIconNode = new IconNode { Icon = node.Icon, Parent = node };
         }
+
+        row.Node = node;
+        _materializedRows.Add(row);
+        SyncItemNode(row);
+        return node;
     }
 
-    private void UpdateFocus()
+    /// <summary>
+    /// Copies a data source row's expansion state to its item node, if it has one.
+    /// </summary>
+    private static void SyncItemNode(TreeRow row)
+    {
+        if (row.Node is not { } node || row.Item is null) return;
+
+        node.HasChildren = row.CanExpand;
+        node.IsExpanded = row.IsExpanded;
+        node.IsLoading = row.IsLoading;
+
+        if (row.IsLoading)
+        {
+            node.LoadingSpinnerNode ??= new SpinnerNode { Parent = node };
+            node.ExpandIndicatorNode = null;
+        }
+        else if (row.CanExpand)
+        {
+            node.LoadingSpinnerNode = null;
+            node.ExpandIndicatorNode ??= new IconNode { Parent = node };
+            node.ExpandIndicatorNode.Icon = row.IsExpanded ? "▼" : "▶";
+        }
+        else
+        {
+            node.LoadingSpinnerNode = null;
+            node.ExpandIndicatorNode = null;
+        }
+    }
+
+    /// <summary>
+    /// Error from the last attempt to load the top-level items, shown in place of them
+    /// until the next reconcile tries again.
+    /// </summary>
+    internal Exception? RootsLoadError
+    {
+        get
+        {
+            lock (_rowsLock)
+            {
+                return _rootsLoadError;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Starts loading the top-level items from the data source, once per source. A load
+    /// that doesn't complete synchronously finishes in the background, with a loading row
+    /// shown meanwhile. A load that faults keeps its error for display and is tried again
+    /// on the next call.
+    /// </summary>
+    internal void EnsureRootsLoading(CancellationToken cancellationToken)
+    {
+        ITreeRowSource source;
+        lock (_rowsLock)
+        {
+            if (_dataSource is null || _rows.RootsLoaded || _rootsLoad != null) return;
+            source = _dataSource;
+        }
+
+        ValueTask<IReadOnlyList<TreeRow>> load;
+        try
+        {
+            load = source.GetRootsAsync(cancellationToken);
+        }
+        catch (Exception ex)
+        {
+            ApplyRootsLoadError(source, ex);
+            return;
+        }
+
+        if (load.IsCompleted)
+        {
+            CompleteRootsLoad(source, load);
+            return;
+        }
+
+        var pending = load.AsTask();
+        lock (_rowsLock)
+        {
+            if (!ReferenceEquals(source, _dataSource)) return;
+            _rootsLoad = pending;
+            _rootsLoadError = null;
+        }
+        MarkDirty();
+
+        _ = pending.ContinueWith(
+            task =>
+            {
+                CompleteRootsLoad(source, new ValueTask<IReadOnlyList<TreeRow>>(task));
+                InvalidateCallback?.Invoke(); // Wake up render loop to show the result
+            },
+            CancellationToken.None,
+            TaskContinuationOptions.ExecuteSynchronously,
+            TaskScheduler.Default);
+    }
+
+    private void CompleteRootsLoad(ITreeRowSource source, ValueTask<IReadOnlyList<TreeRow>> load)
+    {
+        IReadOnlyList<TreeRow> roots;
+        try
+        {
+            roots = load.Result;
+        }
+        catch (Exception ex)
+        {
+            ApplyRootsLoadError(source, ex);
+            return;
+        }
+
+        lock (_rowsLock)
+        {
+            if (!ReferenceEquals(source, _dataSource)) return;
+            _rootsLoad = null;
+            _rootsLoadError = null;
+            _rows.SetRoots(roots);
+            RestoreFocus();
+        }
+        UpdateFocus();
+        MarkDirty();
+    }
+
+    private void ApplyRootsLoadError(ITreeRowSource source, Exception error)
+    {
+        lock (_rowsLock)
+        {
+            // The tree was bound to another source while loading
+            if (!ReferenceEquals(source, _dataSource)) return;
+            _rootsLoad = null;
+            _rootsLoadError = error;
+        }
+        MarkDirty();
+    }
+
+    /// <summary>
+    /// Text shown in place of the items of a tree bound to a data source while it has none,
+    /// or null once they are loaded.
+    /// </summary>
+    private string? GetRootsStatusText(string loadingText, string loadFailedText)
+    {
+        if (_dataSource is null || _rows.Count > 0) return null;
+        if (_rootsLoad != null) return loadingText;
+        if (_rootsLoadError is { } error) return $"{loadFailedText}: {error.Message}";
+        return null;
+    }
+
+    /// <summary>
+    /// Gives the rows in and near the viewport item nodes, and drops those of rows that
+    /// have moved away. The focused row keeps its node.
+    /// </summary>
+    private void MaterializeViewport()
     {
-        for (int i = 0; i < FlattenedItems.Count; i++)
+        lock (_rowsLock)
         {
-            FlattenedItems[i].Node.IsFocused = i == _focusedIndex;
+            var start = Math.Max(0, _scrollOffset - VirtualizationBuffer);
+            var end = Math.Min(_rows.Count, _scrollOffset + _viewportHeight + VirtualizationBuffer);
+            
+            _windowRows.Clear();
+            var row = start < end ? _rows[start] : null;
+            for (int i = start; i < end && row != null; i++, row = _rows.Next(row))
+            {
+                _windowRows.Add(row);
+                GetItemNode(row);
+                SyncItemNode(row);
+            }
+            
+            var focusedRow = _focusedNode?.Row;
+            _materializedRows.RemoveWhere(materialized =>
+            {
+                if (materialized == focusedRow || _windowRows.Contains(materialized)) return false;
+                materialized.Node = null;
+                return true;
+            });
+            _windowRows.Clear();
         }
     }
 
     private void EnsureFocusedVisible()
     {
-        if (_viewportHeight <= 0 || FlattenedItems.Count == 0) return;
+        if (_viewportHeight <= 0 || _rows.Count == 0) return;
 
         if (_focusedIndex < _scrollOffset)
         {
@@ -557,7 +993,7 @@ public sealed class TreeNode : Hex1bNode
             _scrollOffset = _focusedIndex - _viewportHeight + 1;
         }
 
-        _scrollOffset = Math.Clamp(_scrollOffset, 0, Math.Max(0, FlattenedItems.Count - _viewportHeight));
+        _scrollOffset = Math.Clamp(_scrollOffset, 0, Math.Max(0, _rows.Count - _viewportHeight));
     }
 
     /// <summary>
@@ -584,27 +1020,37 @@ public sealed class TreeNode : Hex1bNode
 
     protected override Size MeasureCore(Constraints constraints)
     {
-        // Snapshot to avoid concurrent modification from async expansion callbacks
-        var items = FlattenedItems.ToArray();
-
-        if (items.Length == 0)
-        {
-            return constraints.Constrain(new Size(0, 0));
-        }
-
-        // Calculate max width needed
+        // Locked against concurrent modification from async expansion callbacks
+        int height;
         var maxWidth = 0;
-        foreach (var entry in items)
+        lock (_rowsLock)
         {
-            var guideWidth = entry.Depth * 3; // Each depth level adds 3 chars for guides
-            var indicatorWidth = 2; // Expand/collapse indicator
-            var checkboxWidth = MultiSelect ? 4 : 0; // "[x] " or "[ ] "
-            var contentWidth = DisplayWidth.GetStringWidth(entry.Node.GetDisplayText());
-            var totalWidth = guideWidth + indicatorWidth + checkboxWidth + contentWidth;
-            maxWidth = Math.Max(maxWidth, totalWidth);
+            height = _rows.Count;
+            if (height == 0)
+            {
+                var status = GetRootsStatusText(TreeTheme.LoadingText.DefaultValue(), TreeTheme.LoadFailedText.DefaultValue());
+                var statusSize = status is null ? new Size(0, 0) : new Size(DisplayWidth.GetStringWidth(status), 1);
+                return constraints.Constrain(statusSize);
+            }
+
+            // Calculate max width needed. A tree bound to a data source only measures the
+            // rows that can be on screen, so the cost doesn't grow with the hierarchy.
+            var start = _dataSource is null ? 0 : Math.Clamp(_scrollOffset, 0, height - 1);
+            var end = _dataSource is null ? height : start + Math.Min(height - start, constraints.MaxHeight);
+            var row = _rows[start];
+            for (int i = start; i < end && row != null; i++, row = _rows.Next(row))
+            {
+                var depth = row.Node?.Depth ?? row.Depth;
+                var guideWidth = depth * 3; // Each depth level adds 3 chars for guides
+                var indicatorWidth = 2; // Expand/collapse indicator
+                var checkboxWidth = MultiSelect ? 4 : 0; // "[x] " or "[ ] "
+                var displayText = row.Node?.GetDisplayText() ?? _dataSource!.GetDisplayText(row);
+                var contentWidth = DisplayWidth.GetStringWidth(displayText);
+                var totalWidth = guideWidth + indicatorWidth + checkboxWidth + contentWidth;
+                maxWidth = Math.Max(maxWidth, totalWidth);
+            }
         }
 
-        var height = items.Length;
         var constrainedSize = constraints.Constrain(new Size(maxWidth, height));
         _viewportHeight = constrainedSize.Height;
 
@@ -615,28 +1061,59 @@ public sealed class TreeNode : Hex1bNode
     {
         base.ArrangeCore(bounds);
         _viewportHeight = bounds.Height;
-        _scrollOffset = Math.Clamp(_scrollOffset, 0, Math.Max(0, FlattenedItems.Count - _viewportHeight));
+        _scrollOffset = Math.Clamp(_scrollOffset, 0, Math.Max(0, _rows.Count - _viewportHeight));
         EnsureFocusedVisible();
+
+        if (_dataSource is not null)
+        {
+            MaterializeViewport();
+        }
     }
 
     public override void Render(Hex1bRenderContext context)
     {
+        // Locked against concurrent modification from async expansion callbacks
+        lock (_rowsLock)
+        {
+            if (GetRootsStatusText(context.Theme.Get(TreeTheme.LoadingText), context.Theme.Get(TreeTheme.LoadFailedText)) is { } status)
+            {
+                RenderStatus(context, status);
+                return;
+            }
+
+            RenderRows(context, context.Theme);
+        }
+    }
+
+    private void RenderStatus(Hex1bRenderContext context, string status)
+    {
+        if (Bounds.Height == 0) return;
+
         var theme = context.Theme;
-        
+        var line = theme.Get(TreeTheme.StatusForegroundColor).ToForegroundAnsi() + status + theme.GetResetToGlobalCodes();
+        if (context.CurrentLayoutProvider != null)
+        {
+            context.WriteClipped(Bounds.X, Bounds.Y, line);
+        }
+        else
+        {
+            context.SetCursorPosition(Bounds.X, Bounds.Y);
+            context.Write(line);
+        }
+    }
+
+    private void RenderRows(Hex1bRenderContext context, Hex1bTheme theme)
+    {
         // Get guide strings based on style
         var (branch, lastBranch, vertical, space) = GetGuideStrings(theme);
         var guideColor = theme.Get(TreeTheme.GuideColor);
         
         // Get indicators
-        var expandedIndicator = theme.Get(TreeTheme.ExpandedIndicator);
-        var collapsedIndicator = theme.Get(TreeTheme.CollapsedIndicator);
-        var leafIndicator = theme.Get(TreeTheme.LeafIndicator);
         var checkboxChecked = theme.Get(TreeTheme.CheckboxChecked);
         var checkboxUnchecked = theme.Get(TreeTheme.CheckboxUnchecked);
         var checkboxIndeterminate = theme.Get(TreeTheme.CheckboxIndeterminate);
         
         // Get colors
-        var fg = theme.Get(TreeTheme.ForegroundColor);
         var bg = theme.Get(TreeTheme.BackgroundColor);
         var focusedFg = theme.Get(TreeTheme.FocusedForegroundColor);
         var focusedBg = theme.Get(TreeTheme.FocusedBackgroundColor);
@@ -646,15 +1123,13 @@ public sealed class TreeNode : Hex1bNode
         var globalColors = theme.GetGlobalColorCodes();
         var resetToGlobal = theme.GetResetToGlobalCodes();
         
-        // Snapshot to avoid concurrent modification from async expansion callbacks
-        var items = FlattenedItems.ToArray();
-        
-        var visibleEnd = Math.Min(_scrollOffset + _viewportHeight, items.Length);
+        var visibleEnd = Math.Min(_scrollOffset + _viewportHeight, _rows.Count);
+        var row = _scrollOffset < visibleEnd ? _rows[_scrollOffset] : null;
         
-        for (int i = _scrollOffset; i < visibleEnd; i++)
+        for (int i = _scrollOffset; i < visibleEnd && row != null; i++, row = _rows.Next(row))
         {
-            var entry = items[i];
-            var node = entry.Node;
+            var node = GetItemNode(row);
+            var entry = new FlattenedTreeEntry(node, node.Depth, node.IsLastAtDepth);
             var y = Bounds.Y + (i - _scrollOffset);
             var x = Bounds.X;
             
@@ -819,7 +1294,49 @@ public sealed class TreeNode : Hex1bNode
     /// </summary>
     internal bool HasLoadingItems()
     {
-        return FlattenedItems.Any(e => e.Node.IsLoading);
+        lock (_rowsLock)
+        {
+            return _rows.EnumerateVisible().Any(row => row.IsLoading || row.Node?.IsLoading == true);
+        }
+    }
+
+    private IEnumerable<FlattenedTreeEntry> EnumerateFlattenedItems()
+    {
+        List<TreeItemNode> nodes;
+        lock (_rowsLock)
+        {
+            nodes = _rows.EnumerateVisible().Select(GetItemNode).ToList();
+        }
+        return nodes.Select(node => new FlattenedTreeEntry(node, node.Depth, node.IsLastAtDepth));
+    }
+
+    /// <summary>
+    /// The visible tree items as entries, read from the row index on access.
+    /// </summary>
+    internal readonly struct FlattenedTreeView : IReadOnlyList<FlattenedTreeEntry>
+    {
+        private readonly TreeNode _tree;
+
+        public FlattenedTreeView(TreeNode tree) => _tree = tree;
+
+        public int Count => _tree._rows.Count;
+
+        public FlattenedTreeEntry this[int index]
+        {
+            get
+            {
+                TreeItemNode node;
+                lock (_tree._rowsLock)
+                {
+                    node = _tree.GetItemNode(_tree._rows[index]);
+                }
+                return new FlattenedTreeEntry(node, node.Depth, node.IsLastAtDepth);
+            }
+        }
+
+        public IEnumerator<FlattenedTreeEntry> GetEnumerator() => _tree.EnumerateFlattenedItems().GetEnumerator();
+
+        IEnumerator IEnumerable.GetEnumerator() => GetEnumerator();
     }
 }
 
@@ -0,0 +1,326 @@
+using System.Numerics;
+
+namespace Hex1b;
+
+/// <summary>
+/// One item in a <see cref="TreeNode"/>'s hierarchy, whether or not it currently has a
+/// <see cref="TreeItemNode"/>. Positioned in the flattened view by <see cref="TreeRowIndex"/>.
+/// </summary>
+internal sealed class TreeRow
+{
+    internal TreeRow[] ChildRows = [];
+
+    // Fenwick tree (1-based) over the children's VisibleCount, kept up to date even while
+    // this row is collapsed so expanding it is a single update
+    internal int[] ChildCounts = [0];
+
+    /// <summary>
+    /// The parent row; the index's hidden root for top-level rows.
+    /// </summary>
+    public TreeRow? Parent { get; internal set; }
+
+    public int IndexInParent { get; internal set; }
+
+    public IReadOnlyList<TreeRow> Children => ChildRows;
+
+    /// <summary>
+    /// Whether the children are shown. Change through <see cref="TreeRowIndex.SetExpanded"/>.
+    /// </summary>
+    public bool IsExpanded { get; internal set; }
+
+    /// <summary>
+    /// Rows this row contributes to the flattened view: itself, plus its visible
+    /// descendants while expanded.
+    /// </summary>
+    public int VisibleCount { get; internal set; } = 1;
+
+    /// <summary>
+    /// The item node. Always set for trees built from widgets; trees bound to a data
+    /// source only keep one while the row is in or near the viewport.
+    /// </summary>
+    public TreeItemNode? Node { get; set; }
+
+    /// <summary>
+    /// The data source item, or null for trees built from widgets.
+    /// </summary>
+    public object? Item { get; init; }
+
+    /// <summary>
+    /// Whether the row has or may have children, loaded or not.
+    /// </summary>
+    public bool HasChildren { get; set; }
+
+    /// <summary>
+    /// Whether <see cref="Children"/> has been filled in.
+    /// </summary>
+    public bool ChildrenLoaded { get; internal set; }
+
+    /// <summary>
+    /// Whether the children are being loaded from the data source.
+    /// </summary>
+    public bool IsLoading { get; set; }
+
+    public bool CanExpand => HasChildren || ChildRows.Length > 0;
+
+    public bool IsLastChild => Parent is { } parent && IndexInParent == parent.ChildRows.Length - 1;
+
+    /// <summary>
+    /// Depth below the top level (0 for top-level rows). Walks the ancestors.
+    /// </summary>
+    public int Depth
+    {
+        get
+        {
+            var depth = 0;
+            for (var parent = Parent; parent?.Parent is not null; parent = parent.Parent)
+            {
+                depth++;
+            }
+            return depth;
+        }
+    }
+
+    /// <summary>
+    /// Whether the ancestor at each depth, and finally this row, is the last of its
+    /// siblings; what the guide columns are drawn from.
+    /// </summary>
+    public bool[] GetIsLastAtDepth()
+    {
+        var result = new bool[Depth + 1];
+        var row = this;
+        for (int depth = result.Length - 1; depth >= 0; depth--)
+        {
+            result[depth] = row.IsLastChild;
+            row = row.Parent!;
+        }
+        return result;
+    }
+}
+
+/// <summary>
+/// Order-statistic index over the visible rows of a tree, in the order they are shown.
+/// </summary>
+/// <remarks>
+/// Every row knows how many rows its subtree shows, and every parent keeps those counts
+/// for its children in a Fenwick tree. Finding the row at an index, or the index of a row,
+/// walks down or up the hierarchy with a logarithmic search among the siblings at each
+/// level, and expanding, collapsing or loading the children of a row only updates its
+/// ancestors' counts. Neither depends on how many rows the tree shows in total.
+/// </remarks>
+internal sealed class TreeRowIndex
+{
+    // Hidden, always expanded root whose children are the top-level rows
+    private readonly TreeRow _root = new() { IsExpanded = true };
+
+    /// <summary>
+    /// Number of rows in the flattened view.
+    /// </summary>
+    public int Count => _root.VisibleCount - 1;
+
+    public IReadOnlyList<TreeRow> Roots => _root.ChildRows;
+
+    /// <summary>
+    /// Whether the top-level rows have been set since the index was created or cleared.
+    /// </summary>
+    public bool RootsLoaded => _root.ChildrenLoaded;
+
+    /// <summary>
+    /// Gets the row at a position in the flattened view.
+    /// </summary>
+    public TreeRow this[int index]
+    {
+        get
+        {
+            ArgumentOutOfRangeException.ThrowIfNegative(index);
+            ArgumentOutOfRangeException.ThrowIfGreaterThanOrEqual(index, Count);
+
+            // remaining: position among the rows shown below `row`
+            var row = _root;
+            var remaining = index;
+            while (true)
+            {
+                var (childIndex, before) = FindChild(row.ChildCounts, remaining);
+                var child = row.ChildRows[childIndex];
+                remaining -= before;
+                if (remaining == 0)
+                {
+                    return child;
+                }
+                remaining--;
+                row = child;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Returns the position of a row in the flattened view, or -1 if a collapsed ancestor
+    /// hides it or it isn't in this index.
+    /// </summary>
+    public int IndexOf(TreeRow row)
+    {
+        if (row == _root)
+        {
+            return -1;
+        }
+
+        var index = 0;
+        var current = row;
+        while (current.Parent is { } parent)
+        {
+            if (!parent.IsExpanded)
+            {
+                return -1;
+            }
+            index += Prefix(parent.ChildCounts, current.IndexInParent);
+            if (parent != _root)
+            {
+                index++;
+            }
+            current = parent;
+        }
+        return current == _root ? index : -1;
+    }
+
+    /// <summary>
+    /// Returns the row shown after <paramref name="row"/>, or null at the end.
+    /// </summary>
+    public TreeRow? Next(TreeRow row)
+    {
+        if (row.IsExpanded && row.ChildRows.Length > 0)
+        {
+            return row.ChildRows[0];
+        }
+
+        for (var current = row; current.Parent is { } parent; current = parent)
+        {
+            if (current.IndexInParent + 1 < parent.ChildRows.Length)
+            {
+                return parent.ChildRows[current.IndexInParent + 1];
+            }
+        }
+        return null;
+    }
+
+    /// <summary>
+    /// Enumerates the rows of the flattened view in order.
+    /// </summary>
+    public IEnumerable<TreeRow> EnumerateVisible()
+    {
+        for (var row = Count > 0 ? _root.ChildRows[0] : null; row is not null; row = Next(row))
+        {
+            yield return row;
+        }
+    }
+
+    public void SetRoots(IReadOnlyList<TreeRow> rows) => SetChildren(_root, rows);
+
+    /// <summary>
+    /// Removes all rows and marks the top-level rows as not loaded.
+    /// </summary>
+    public void Clear()
+    {
+        SetChildren(_root, []);
+        _root.ChildrenLoaded = false;
+    }
+
+    /// <summary>
+    /// Replaces the children of a row. The new rows may carry subtrees of their own,
+    /// which must already have been assembled with this method.
+    /// </summary>
+    public void SetChildren(TreeRow parent, IReadOnlyList<TreeRow> children)
+    {
+        var rows = new TreeRow[children.Count];
+        var counts = new int[rows.Length + 1];
+        for (int i = 0; i < rows.Length; i++)
+        {
+            var child = children[i];
+            child.Parent = parent;
+            child.IndexInParent = i;
+            rows[i] = child;
+            counts[i + 1] = child.VisibleCount;
+        }
+
+        // Linear-time Fenwick construction: push each partial sum to its parent slot
+        for (int i = 1; i < counts.Length; i++)
+        {
+            var up = i + (i & -i);
+            if (up < counts.Length)
+            {
+                counts[up] += counts[i];
+            }
+        }
+
+        parent.ChildRows = rows;
+        parent.ChildCounts = counts;
+        parent.ChildrenLoaded = true;
+        Recount(parent);
+    }
+
+    public void SetExpanded(TreeRow row, bool expanded)
+    {
+        if (row.IsExpanded == expanded)
+        {
+            return;
+        }
+        row.IsExpanded = expanded;
+        Recount(row);
+    }
+
+    /// <summary>
+    /// Brings a row's visible count in line with its state and passes the difference up
+    /// to the first collapsed ancestor.
+    /// </summary>
+    private static void Recount(TreeRow row)
+    {
+        var count = 1 + (row.IsExpanded ? Prefix(row.ChildCounts, row.ChildRows.Length) : 0);
+        var delta = count - row.VisibleCount;
+        row.VisibleCount = count;
+
+        while (delta != 0 && row.Parent is { } parent)
+        {
+            for (int i = row.IndexInParent + 1; i < parent.ChildCounts.Length; i += i & -i)
+            {
+                parent.ChildCounts[i] += delta;
+            }
+            if (!parent.IsExpanded)
+            {
+                break;
+            }
+            parent.VisibleCount += delta;
+            row = parent;
+        }
+    }
+
+    /// <summary>
+    /// Sum of the first <paramref name="count"/> children's visible counts.
+    /// </summary>
+    private static int Prefix(int[] counts, int count)
+    {
+        var sum = 0;
+        for (int i = count; i > 0; i -= i & -i)
+        {
+            sum += counts[i];
+        }
+        return sum;
+    }
+
+    /// <summary>
+    /// Finds the child whose rows include position <paramref name="remaining"/> among its
+    /// siblings' rows, and the number of rows shown before it.
+    /// </summary>
+    private static (int ChildIndex, int Before) FindChild(int[] counts, int remaining)
+    {
+        var position = 0;
+        var sum = 0;
+        for (int step = (int)BitOperations.RoundUpToPowerOf2((uint)counts.Length) >> 1; step > 0; step >>= 1)
+        {
+            var next = position + step;
+            if (next < counts.Length && sum + counts[next] <= remaining)
+            {
+                position = next;
+                sum += counts[next];
+            }
+        }
+        return (position, sum);
+    }
+}
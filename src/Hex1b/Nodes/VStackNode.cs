@@ -22,6 +22,11 @@ public sealed class VStackNode : Hex1bNode, ILayoutProvider
     /// </summary>
     public override bool ManagesChildFocus => true;
 
+    // Child heights from the last measure and the width they were measured at, so arrange
+    // can reuse them instead of measuring content-sized children again at the same width
+    private readonly List<(Hex1bNode Node, int Height)> _measuredHeights = new();
+    private int _measuredWidth = -1;
+
     #region ILayoutProvider Implementation
     
     /// <summary>
@@ -61,12 +66,15 @@ public sealed class VStackNode : Hex1bNode, ILayoutProvider
         // return int.MaxValue from unbounded measurement. The overflow would produce a negative
         // totalHeight, causing Constrain to return 0 and the VStack to collapse.
         long totalHeight = 0;
+        _measuredHeights.Clear();
+        _measuredWidth = constraints.MaxWidth;
 
         foreach (var child in Children)
         {
             // Children get the parent's width constraint but unbounded height
             var childConstraints = new Constraints(0, constraints.MaxWidth, 0, int.MaxValue);
             var childSize = child.Measure(childConstraints);
+            _measuredHeights.Add((child, childSize.Height));
             maxWidth = Math.Max(maxWidth, childSize.Width);
             totalHeight += childSize.Height;
         }
@@ -95,6 +103,7 @@ public sealed class VStackNode : Hex1bNode, ILayoutProvider
         var childSizes = ArrayPool<int>.Shared.Rent(count);
         var totalFixed = 0;
         var totalWeight = 0;
+        var reuseMeasured = bounds.Width == _measuredWidth && _measuredHeights.Count == count;
 
         try
         {
@@ -112,11 +121,14 @@ public sealed class VStackNode : Hex1bNode, ILayoutProvider
                 else if (hint.IsContent)
                 {
                     // Content height often depends on available width (e.g., wrapped TextBlock).
-                    // Measure with the current bounds width so content sizing is accurate.
+                    // Measure with the current bounds width so content sizing is accurate,
+                    // unless the last measure already used that width.
                     // Cap to availableHeight to prevent widgets that fill all space (e.g., Editor)
                     // from returning int.MaxValue and causing unbounded arrangement/render loops.
-                    var measured = Children[i].Measure(new Constraints(0, bounds.Width, 0, int.MaxValue));
-                    childSizes[i] = Math.Min(measured.Height, availableHeight);
+                    var measuredHeight = reuseMeasured && ReferenceEquals(_measuredHeights[i].Node, Children[i])
+                        ? _measuredHeights[i].Height
+                        : Children[i].Measure(new Constraints(0, bounds.Width, 0, int.MaxValue)).Height;
+                    childSizes[i] = Math.Min(measuredHeight, availableHeight);
                     totalFixed += childSizes[i];
                 }
                 else if (hint.IsFill)
@@ -166,6 +178,9 @@ public sealed class VStackNode : Hex1bNode, ILayoutProvider
         // Render flow children first
         for (int i = 0; i < Children.Count; i++)
         {
+            // Children scrolled out of view can't show anything
+            if (context.IsOutsideVisibleRect(Children[i].Bounds))
+                continue;
             context.RenderChild(Children[i]);
         }
 
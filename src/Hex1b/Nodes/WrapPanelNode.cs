@@ -194,6 +194,9 @@ public sealed class WrapPanelNode : Hex1bNode, ILayoutProvider
 
         for (int i = 0; i < Children.Count; i++)
         {
+            // Children scrolled out of view can't show anything
+            if (context.IsOutsideVisibleRect(Children[i].Bounds))
+                continue;
             context.RenderChild(Children[i]);
         }
 
@@ -0,0 +1,200 @@
+using System.Buffers;
+using System.Text;
+using Hex1b.Automation;
+using Hex1b.Theming;
+using Hex1b.Tokens;
+
+namespace Hex1b;
+
+/// <summary>
+/// A headless terminal that replays recorded output so its state can be captured
+/// as keyframes.
+/// </summary>
+/// <remarks>
+/// Output is buffered and applied in batches. Escape sequences split across writes are
+/// carried over like the live output pump does, and <see cref="TryCaptureState"/> refuses
+/// to capture while one is pending, since the replayed tail would then start mid-sequence.
+/// </remarks>
+internal sealed class OffscreenTerminal : IDisposable
+{
+    private const int ApplyThreshold = 16 * 1024;
+
+    private readonly Hex1bAppWorkloadAdapter _workload;
+    private readonly Hex1bTerminal _terminal;
+    private readonly ArrayBufferWriter<byte> _pending = new();
+    private string _incomplete = "";
+
+    public OffscreenTerminal(int width, int height)
+    {
+        _workload = new Hex1bAppWorkloadAdapter();
+        _terminal = Hex1bTerminal.CreateBuilder()
+            .WithWorkload(_workload)
+            .WithHeadless()
+            .WithDimensions(width, height)
+            .Build();
+    }
+
+    /// <summary>
+    /// Queues UTF-8 output for the terminal.
+    /// </summary>
+    public void Write(ReadOnlySpan<byte> output)
+    {
+        _pending.Write(output);
+        if (_pending.WrittenCount >= ApplyThreshold)
+            Apply();
+    }
+
+    /// <summary>
+    /// Gets a buffer to unescape output into; commit it with <see cref="Commit"/>.
+    /// </summary>
+    public ArrayBufferWriter<byte> Output => _pending;
+
+    /// <summary>
+    /// Applies output written directly to <see cref="Output"/> once enough is buffered.
+    /// </summary>
+    public void Commit()
+    {
+        if (_pending.WrittenCount >= ApplyThreshold)
+            Apply();
+    }
+
+    /// <summary>
+    /// Captures the current state as restore output, or returns false if the output so
+    /// far ends inside an escape sequence.
+    /// </summary>
+    public bool TryCaptureState(out byte[] state)
+    {
+        Apply();
+        if (_incomplete.Length > 0)
+        {
+            state = [];
+            return false;
+        }
+
+        state = CaptureState(_terminal);
+        return true;
+    }
+
+    private void Apply()
+    {
+        if (_pending.WrittenCount == 0)
+            return;
+
+        var (complete, rest) = Hex1bTerminal.ExtractIncompleteEscapeSequence(
+            _incomplete + Encoding.UTF8.GetString(_pending.WrittenSpan));
+        _incomplete = rest;
+        _pending.Clear();
+        if (complete.Length > 0)
+            _terminal.ApplyTokens(AnsiTokenizer.Tokenize(complete));
+    }
+
+    public void Dispose()
+    {
+        _terminal.Dispose();
+        _workload.Dispose();
+    }
+
+    /// <summary>
+    /// Serializes the terminal state as output that recreates it on a cleared terminal.
+    /// </summary>
+    /// <remarks>
+    /// Covers the visible screen, cursor, scroll margins, pen and the common DEC modes.
+    /// Scrollback and the main screen saved behind the alternate screen are not restored.
+    /// </remarks>
+    public static byte[] CaptureState(Hex1bTerminal terminal) => CaptureState(terminal, out _, out _);
+
+    /// <inheritdoc cref="CaptureState(Hex1bTerminal)"/>
+    /// <param name="terminal">The terminal to capture.</param>
+    /// <param name="width">Receives the terminal width at capture time.</param>
+    /// <param name="height">Receives the terminal height at capture time.</param>
+    public static byte[] CaptureState(Hex1bTerminal terminal, out int width, out int height)
+    {
+        using var snapshot = terminal.CreateSnapshot();
+        width = snapshot.Width;
+        height = snapshot.Height;
+        var (foreground, background, attributes, scrollTop, scrollBottom) = terminal.GetRenditionState();
+        var originMode = terminal.OriginModeEnabled;
+
+        var sb = new StringBuilder();
+        sb.Append("\x1b[?1049l");
+        if (snapshot.InAlternateScreen)
+            sb.Append("\x1b[?1049h");
+        sb.Append("\x1b[0m");
+        AppendAbsoluteAddressing(sb);
+
+        sb.Append(snapshot.ToAnsi(new TerminalAnsiOptions
+        {
+            IncludeClearScreen = true,
+            IncludeCursorPosition = false,
+            IncludeTrailingNewline = false
+        }));
+
+        AppendAddressingAndCursor(sb, scrollTop, scrollBottom, snapshot.Height, originMode, snapshot.CursorX, snapshot.CursorY);
+
+        AppendMode(sb, 25, snapshot.CursorVisible);
+        AppendMode(sb, 1, snapshot.ApplicationCursorKeysEnabled);
+        AppendMode(sb, 2004, snapshot.BracketedPasteEnabled);
+        AppendMode(sb, 1004, snapshot.FocusEventsEnabled);
+        AppendMode(sb, 9, snapshot.MouseProtocolX10Enabled);
+        AppendMode(sb, 1000, snapshot.MouseProtocolNormalEnabled);
+        AppendMode(sb, 1001, snapshot.MouseProtocolHighlightEnabled);
+        AppendMode(sb, 1002, snapshot.MouseProtocolButtonEnabled);
+        AppendMode(sb, 1003, snapshot.MouseProtocolAnyEnabled);
+        AppendMode(sb, 1005, snapshot.MouseEncodingUtf8Enabled);
+        AppendMode(sb, 1006, snapshot.MouseEncodingSgrEnabled);
+        AppendMode(sb, 1015, snapshot.MouseEncodingUrxvtEnabled);
+        sb.Append(snapshot.ApplicationKeypadEnabled ? "\x1b=" : "\x1b>");
+        if (snapshot.CursorShape != 0)
+            sb.Append($"\x1b[{snapshot.CursorShape} q");
+
+        // Pen last, so the restore sequence itself doesn't disturb it
+        AppendPen(sb, foreground, background, attributes);
+
+        return Encoding.UTF8.GetBytes(sb.ToString());
+    }
+
+    /// <summary>
+    /// Appends the SGR sequences that select the given pen, on top of the current one.
+    /// </summary>
+    internal static void AppendPen(StringBuilder sb, Hex1bColor? foreground, Hex1bColor? background, CellAttributes attributes)
+    {
+        if ((attributes & CellAttributes.Bold) != 0) sb.Append("\x1b[1m");
+        if ((attributes & CellAttributes.Dim) != 0) sb.Append("\x1b[2m");
+        if ((attributes & CellAttributes.Italic) != 0) sb.Append("\x1b[3m");
+        if ((attributes & CellAttributes.Underline) != 0) sb.Append("\x1b[4m");
+        if ((attributes & CellAttributes.Blink) != 0) sb.Append("\x1b[5m");
+        if ((attributes & CellAttributes.Reverse) != 0) sb.Append("\x1b[7m");
+        if ((attributes & CellAttributes.Hidden) != 0) sb.Append("\x1b[8m");
+        if ((attributes & CellAttributes.Strikethrough) != 0) sb.Append("\x1b[9m");
+        if ((attributes & CellAttributes.Overline) != 0) sb.Append("\x1b[53m");
+        if (foreground is { } fg) sb.Append(fg.ToForegroundAnsi());
+        if (background is { } bg) sb.Append(bg.ToBackgroundAnsi());
+    }
+
+    /// <summary>
+    /// Appends the sequences that turn origin mode off and reset the scroll margins, so
+    /// cursor positions that follow address the whole screen.
+    /// </summary>
+    internal static void AppendAbsoluteAddressing(StringBuilder sb) => sb.Append("\x1b[?6l\x1b[r");
+
+    /// <summary>
+    /// Appends the sequences that restore the scroll margins and origin mode after
+    /// <see cref="AppendAbsoluteAddressing"/>, then move the cursor to its screen position.
+    /// </summary>
+    internal static void AppendAddressingAndCursor(
+        StringBuilder sb, int scrollTop, int scrollBottom, int height, bool originMode, int cursorX, int cursorY)
+    {
+        // DECSTBM and DECOM both home the cursor, so they go before the cursor position
+        if (scrollTop != 0 || scrollBottom != height - 1)
+            sb.Append("\x1b[").Append(scrollTop + 1).Append(';').Append(scrollBottom + 1).Append('r');
+        if (originMode)
+            sb.Append("\x1b[?6h");
+
+        // With origin mode on, CUP rows count from the top margin
+        var row = originMode ? cursorY - scrollTop : cursorY;
+        sb.Append("\x1b[").Append(row + 1).Append(';').Append(cursorX + 1).Append('H');
+    }
+
+    private static void AppendMode(StringBuilder sb, int mode, bool enabled)
+        => sb.Append($"\x1b[?{mode}{(enabled ? 'h' : 'l')}");
+}
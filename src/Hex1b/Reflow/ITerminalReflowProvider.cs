@@ -115,4 +115,17 @@ public readonly record struct ReflowResult(
     int CursorX,
     int CursorY,
     int? NewSavedCursorX = null,
-    int? NewSavedCursorY = null);
+    int? NewSavedCursorY = null)
+{
+    /// <summary>
+    /// The number of oldest <see cref="ScrollbackRows"/> that were passed through unchanged
+    /// from the context instead of being re-wrapped. The terminal re-wraps them to its
+    /// current width once resizing settles or when they are read.
+    /// </summary>
+    /// <remarks>
+    /// Only the rows near the screen are re-wrapped during a resize, so a drag-resize
+    /// doesn't re-wrap the whole scrollback for every intermediate size. The deferred rows
+    /// must end on a logical line boundary.
+    /// </remarks>
+    public int DeferredScrollbackRows { get; init; }
+}
@@ -6,16 +6,30 @@ namespace Hex1b.Reflow;
 /// Shared reflow algorithm used by reflow strategy implementations.
 /// </summary>
 /// <remarks>
+/// <para>
 /// The algorithm:
 /// <list type="number">
-///   <item>Collects all rows (scrollback + screen) into a unified sequence</item>
+///   <item>Collects the screen rows and the newest scrollback rows into a unified sequence</item>
 ///   <item>Groups rows into logical lines using the <see cref="CellAttributes.SoftWrap"/> flag</item>
 ///   <item>Re-wraps each logical line to the new width</item>
 ///   <item>Distributes re-wrapped rows back into scrollback and screen buffer</item>
 /// </list>
+/// </para>
+/// <para>
+/// Only enough scrollback to refill the new screen plus a margin is re-wrapped. Older rows
+/// are returned unchanged and counted in <see cref="ReflowResult.DeferredScrollbackRows"/>;
+/// the terminal re-wraps them later with <see cref="ReflowScrollback"/>. Every logical line
+/// re-wraps to at least one row, so the deferred rows can never reach the new screen.
+/// </para>
 /// </remarks>
 internal static class ReflowHelper
 {
+    /// <summary>
+    /// How many screens of logical lines (at the new height) are re-wrapped synchronously:
+    /// one to refill the screen and one of margin for scrolling back right after a resize.
+    /// </summary>
+    private const int SynchronousScreens = 2;
+
     /// <summary>
     /// Performs terminal content reflow from one width to another.
     /// </summary>
@@ -44,17 +58,19 @@ internal static class ReflowHelper
                 hasSavedCursor ? context.SavedCursorY : null);
         }
 
-        // Step 1: Collect all rows into a unified sequence (scrollback + screen)
-        var allRows = CollectAllRows(context);
+        // Step 1: Collect the rows to re-wrap into a unified sequence (scrollback + screen),
+        // leaving scrollback older than the synchronous window for later.
+        int deferredRows = FindDeferredRowCount(context.ScrollbackRows, context.NewHeight);
+        var allRows = CollectAllRows(context, deferredRows);
 
         // Step 2: Group rows into logical lines using SoftWrap, and track which
         // logical line the cursor row belongs to (and optionally the saved cursor).
-        int scrollbackRowCount = context.ScrollbackRows.Length;
+        int scrollbackRowCount = context.ScrollbackRows.Length - deferredRows;
         int cursorAbsoluteRow = scrollbackRowCount + context.CursorY;
         int savedCursorAbsoluteRow = hasSavedCursor ? scrollbackRowCount + context.SavedCursorY!.Value : -1;
 
-        var (logicalLines, cursorLogicalLine, cursorRowInLogicalLine,
-             savedCursorLogicalLine, savedCursorRowInLogicalLine) =
+        var (logicalLines, cursorLogicalLine, cursorOffsetInLogicalLine,
+             savedCursorLogicalLine, savedCursorOffsetInLogicalLine) =
             GroupLogicalLinesWithCursors(allRows, cursorAbsoluteRow,
                 hasSavedCursor ? savedCursorAbsoluteRow : null);
 
@@ -77,8 +93,7 @@ internal static class ReflowHelper
             {
                 (newCursorRow, newCursorCol) = ComputeCursorInWrappedLine(
                     logicalLine, wrappedRows, rowsSoFar,
-                    cursorRowInLogicalLine, context.CursorX,
-                    context.OldWidth, context.NewWidth);
+                    cursorOffsetInLogicalLine + context.CursorX, context.NewWidth);
                 cursorFound = true;
             }
 
@@ -86,8 +101,7 @@ internal static class ReflowHelper
             {
                 (newSavedCursorRow, newSavedCursorCol) = ComputeCursorInWrappedLine(
                     logicalLine, wrappedRows, rowsSoFar,
-                    savedCursorRowInLogicalLine, context.SavedCursorX!.Value,
-                    context.OldWidth, context.NewWidth);
+                    savedCursorOffsetInLogicalLine + context.SavedCursorX!.Value, context.NewWidth);
                 savedCursorFound = true;
             }
 
@@ -108,20 +122,69 @@ internal static class ReflowHelper
         }
 
         // Step 4: Distribute rows into scrollback and screen
-        return DistributeRows(rewrappedRows, context, newCursorRow, newCursorCol, preserveCursorRow,
+        return DistributeRows(rewrappedRows, context, deferredRows, newCursorRow, newCursorCol, preserveCursorRow,
             hasSavedCursor ? newSavedCursorRow : null,
             hasSavedCursor ? newSavedCursorCol : null);
     }
 
+    /// <summary>
+    /// Re-wraps scrollback rows to <paramref name="newWidth"/>. The rows may have been captured
+    /// at different widths and must end on a logical line boundary, as the rows deferred by
+    /// <see cref="PerformReflow"/> do.
+    /// </summary>
+    public static ReflowScrollbackRow[] ReflowScrollback(IReadOnlyList<ReflowScrollbackRow> rows, int newWidth)
+    {
+        if (rows.Count == 0)
+            return [];
+
+        var allRows = new List<TerminalCell[]>(rows.Count);
+        foreach (var row in rows)
+            allRows.Add(row.Cells);
+
+        var (logicalLines, _, _, _, _) = GroupLogicalLinesWithCursors(allRows, cursorAbsoluteRow: -1, savedCursorAbsoluteRow: null);
+
+        var result = new List<ReflowScrollbackRow>(rows.Count);
+        foreach (var logicalLine in logicalLines)
+        {
+            foreach (var wrapped in WrapLogicalLine(logicalLine, newWidth))
+                result.Add(new ReflowScrollbackRow(wrapped, newWidth));
+        }
+        return result.ToArray();
+    }
+
+    /// <summary>
+    /// Returns how many of the oldest scrollback rows lie outside the synchronous window,
+    /// which starts at a logical line boundary and covers <see cref="SynchronousScreens"/>
+    /// screens of logical lines.
+    /// </summary>
+    private static int FindDeferredRowCount(ReflowScrollbackRow[] scrollbackRows, int newHeight)
+    {
+        int neededLines = newHeight * SynchronousScreens;
+        int lines = 0;
+        int start = scrollbackRows.Length;
+
+        while (start > 0 && lines < neededLines)
+        {
+            start--;
+
+            // Count a line each time the window reaches the row that begins it
+            if (start == 0 || !IsSoftWrapped(scrollbackRows[start - 1].Cells))
+                lines++;
+        }
+
+        return start;
+    }
+
+    private static bool IsSoftWrapped(TerminalCell[] row)
+        => row.Length > 0 && (row[^1].Attributes & CellAttributes.SoftWrap) != 0;
+
     /// <summary>
     /// Computes the new cursor position within re-wrapped rows for a given logical line.
     /// </summary>
     private static (int row, int col) ComputeCursorInWrappedLine(
         List<TerminalCell> logicalLine, List<TerminalCell[]> wrappedRows, int rowsSoFar,
-        int cursorRowInLogicalLine, int cursorX, int oldWidth, int newWidth)
+        int cellOffsetInLine, int newWidth)
     {
-        int cellOffsetInLine = cursorRowInLogicalLine * oldWidth + cursorX;
-
         if (logicalLine.Count == 0)
         {
             return (rowsSoFar, 0);
@@ -141,29 +204,19 @@ internal static class ReflowHelper
     }
 
     /// <summary>
-    /// Collects all rows (scrollback + screen) into a single list of cell arrays.
+    /// Collects the scrollback rows after the first <paramref name="skipScrollbackRows"/> and the
+    /// screen rows into a single list of cell arrays.
     /// </summary>
-    private static List<TerminalCell[]> CollectAllRows(ReflowContext context)
+    private static List<TerminalCell[]> CollectAllRows(ReflowContext context, int skipScrollbackRows)
     {
-        var allRows = new List<TerminalCell[]>(context.ScrollbackRows.Length + context.ScreenRows.Length);
+        var allRows = new List<TerminalCell[]>(
+            context.ScrollbackRows.Length - skipScrollbackRows + context.ScreenRows.Length);
 
-        // Add scrollback rows (may have different widths — normalize to OldWidth if needed)
-        foreach (var sbRow in context.ScrollbackRows)
+        // Add scrollback rows as they are. Rows left over from an earlier deferred reflow may
+        // have another width; grouping only looks at each row's own cells and SoftWrap flag.
+        for (int i = skipScrollbackRows; i < context.ScrollbackRows.Length; i++)
         {
-            if (sbRow.Cells.Length == context.OldWidth)
-            {
-                allRows.Add(sbRow.Cells);
-            }
-            else
-            {
-                // Normalize to current width for consistent processing
-                var normalized = new TerminalCell[context.OldWidth];
-                int copyLen = Math.Min(sbRow.Cells.Length, context.OldWidth);
-                Array.Copy(sbRow.Cells, normalized, copyLen);
-                for (int x = copyLen; x < context.OldWidth; x++)
-                    normalized[x] = TerminalCell.Empty;
-                allRows.Add(normalized);
-            }
+            allRows.Add(context.ScrollbackRows[i].Cells);
         }
 
         // Add screen rows
@@ -182,12 +235,13 @@ internal static class ReflowHelper
     /// <see cref="CellAttributes.SoftWrap"/> set on its last cell.
     /// </summary>
     /// <returns>
-    /// A tuple of (logicalLines, cursorLogicalLineIndex, cursorRowWithinLogicalLine,
-    /// savedCursorLogicalLineIndex, savedCursorRowWithinLogicalLine).
+    /// A tuple of (logicalLines, cursorLogicalLineIndex, cursorRowOffsetWithinLogicalLine,
+    /// savedCursorLogicalLineIndex, savedCursorRowOffsetWithinLogicalLine), where an offset is
+    /// the number of cells of the logical line that come before the cursor's row.
     /// The saved cursor values are -1/0 when <paramref name="savedCursorAbsoluteRow"/> is null.
     /// </returns>
-    private static (List<List<TerminalCell>> logicalLines, int cursorLogicalLine, int cursorRowInLine,
-        int savedCursorLogicalLine, int savedCursorRowInLine)
+    private static (List<List<TerminalCell>> logicalLines, int cursorLogicalLine, int cursorOffsetInLine,
+        int savedCursorLogicalLine, int savedCursorOffsetInLine)
         GroupLogicalLinesWithCursors(List<TerminalCell[]> allRows, int cursorAbsoluteRow,
             int? savedCursorAbsoluteRow)
     {
@@ -195,13 +249,20 @@ internal static class ReflowHelper
         var currentLine = new List<TerminalCell>();
         int currentLineStartRow = 0;
         int cursorLogicalLine = -1;
-        int cursorRowInLine = 0;
+        int cursorOffsetInLine = 0;
         int savedCursorLogicalLine = -1;
-        int savedCursorRowInLine = 0;
+        int savedCursorOffsetInLine = 0;
 
         for (int rowIdx = 0; rowIdx < allRows.Count; rowIdx++)
         {
             var row = allRows[rowIdx];
+
+            // Earlier rows of a logical line may have other widths, so offsets are counted in cells
+            if (rowIdx == cursorAbsoluteRow)
+                cursorOffsetInLine = currentLine.Count;
+            if (rowIdx == savedCursorAbsoluteRow)
+                savedCursorOffsetInLine = currentLine.Count;
+
             int lastNonEmpty = row.Length - 1;
             bool hasSoftWrap = row.Length > 0 && (row[^1].Attributes & CellAttributes.SoftWrap) != 0;
 
@@ -229,7 +290,6 @@ internal static class ReflowHelper
                 if (cursorLogicalLine < 0 && cursorAbsoluteRow >= currentLineStartRow && cursorAbsoluteRow <= rowIdx)
                 {
                     cursorLogicalLine = logicalLines.Count;
-                    cursorRowInLine = cursorAbsoluteRow - currentLineStartRow;
                 }
 
                 // Track saved cursor
@@ -237,7 +297,6 @@ internal static class ReflowHelper
                     && savedCursorAbsoluteRow.Value >= currentLineStartRow && savedCursorAbsoluteRow.Value <= rowIdx)
                 {
                     savedCursorLogicalLine = logicalLines.Count;
-                    savedCursorRowInLine = savedCursorAbsoluteRow.Value - currentLineStartRow;
                 }
 
                 logicalLines.Add(currentLine);
@@ -252,13 +311,11 @@ internal static class ReflowHelper
             if (cursorLogicalLine < 0 && cursorAbsoluteRow >= currentLineStartRow)
             {
                 cursorLogicalLine = logicalLines.Count;
-                cursorRowInLine = cursorAbsoluteRow - currentLineStartRow;
             }
             if (savedCursorAbsoluteRow.HasValue && savedCursorLogicalLine < 0
                 && savedCursorAbsoluteRow.Value >= currentLineStartRow)
             {
                 savedCursorLogicalLine = logicalLines.Count;
-                savedCursorRowInLine = savedCursorAbsoluteRow.Value - currentLineStartRow;
             }
             logicalLines.Add(currentLine);
         }
@@ -271,16 +328,16 @@ internal static class ReflowHelper
         if (cursorLogicalLine < 0)
         {
             cursorLogicalLine = logicalLines.Count - 1;
-            cursorRowInLine = 0;
+            cursorOffsetInLine = 0;
         }
 
         if (savedCursorAbsoluteRow.HasValue && savedCursorLogicalLine < 0)
         {
             savedCursorLogicalLine = logicalLines.Count - 1;
-            savedCursorRowInLine = 0;
+            savedCursorOffsetInLine = 0;
         }
 
-        return (logicalLines, cursorLogicalLine, cursorRowInLine, savedCursorLogicalLine, savedCursorRowInLine);
+        return (logicalLines, cursorLogicalLine, cursorOffsetInLine, savedCursorLogicalLine, savedCursorOffsetInLine);
     }
 
     /// <summary>
@@ -360,11 +417,13 @@ internal static class ReflowHelper
     }
 
     /// <summary>
-    /// Distributes re-wrapped rows into scrollback and screen buffer.
+    /// Distributes re-wrapped rows into scrollback and screen buffer, after the
+    /// <paramref name="deferredRows"/> oldest scrollback rows that weren't re-wrapped.
     /// </summary>
     private static ReflowResult DistributeRows(
         List<TerminalCell[]> rewrappedRows,
         ReflowContext context,
+        int deferredRows,
         int cursorRow,
         int cursorCol,
         bool preserveCursorRow,
@@ -401,11 +460,12 @@ internal static class ReflowHelper
         }
 
         // Build scrollback rows
-        int scrollbackCount = screenStartIndex;
+        int scrollbackCount = deferredRows + screenStartIndex;
         var scrollbackRows = new ReflowScrollbackRow[scrollbackCount];
-        for (int i = 0; i < scrollbackCount; i++)
+        Array.Copy(context.ScrollbackRows, scrollbackRows, deferredRows);
+        for (int i = 0; i < screenStartIndex; i++)
         {
-            scrollbackRows[i] = new ReflowScrollbackRow(rewrappedRows[i], context.NewWidth);
+            scrollbackRows[deferredRows + i] = new ReflowScrollbackRow(rewrappedRows[i], context.NewWidth);
         }
 
         // Build screen rows
@@ -442,7 +502,10 @@ internal static class ReflowHelper
         }
 
         return new ReflowResult(screenRows, scrollbackRows, newCursorCol, newCursorRow,
-            newSavedCursorX, newSavedCursorY);
+            newSavedCursorX, newSavedCursorY)
+        {
+            DeferredScrollbackRows = deferredRows
+        };
     }
 
     private static bool IsEmptyRow(TerminalCell[] row)
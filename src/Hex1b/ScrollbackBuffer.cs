@@ -1,3 +1,5 @@
+using Hex1b.Reflow;
+
 namespace Hex1b;
 
 /// <summary>
@@ -41,6 +43,10 @@ internal sealed class ScrollbackBuffer
     /// </summary>
     public int Count => _count;
 
+    // The oldest row's slot. Rows need not start at slot 0 even when the buffer isn't
+    // full, since Replace can shrink the buffer in place.
+    private int OldestIndex => (_head - _count + Capacity) % Capacity;
+
     /// <summary>
     /// Adds a row to the buffer. If the buffer is full, the oldest row is evicted
     /// and its tracked object references are released.
@@ -57,7 +63,7 @@ internal sealed class ScrollbackBuffer
         if (_count == Capacity)
         {
             evicted = _rows[_head];
-            ReleaseTrackedObjects(evicted.Value);
+            ReleaseTrackedObjects(evicted.Value.Cells);
         }
         else
         {
@@ -90,10 +96,7 @@ internal sealed class ScrollbackBuffer
 
         // Start index: oldest of the requested lines
         // _head points to the next write slot. The newest row is at (_head - 1).
-        // The oldest row in the buffer is at (_head) when full, or at index 0 when not full.
-        int startIndex = _count == Capacity
-            ? (_head - actual + Capacity) % Capacity
-            : _count - actual;
+        int startIndex = (_head - actual + Capacity) % Capacity;
 
         for (int i = 0; i < actual; i++)
         {
@@ -103,6 +106,79 @@ internal sealed class ScrollbackBuffer
         return result;
     }
 
+    /// <summary>
+    /// Replaces <paramref name="count"/> rows, starting <paramref name="start"/> rows after the
+    /// oldest, with <paramref name="rows"/>. Rows outside the replaced range keep their
+    /// timestamps. If the result exceeds the capacity, the oldest rows are evicted.
+    /// </summary>
+    /// <param name="start">Index of the first row to replace, counted from the oldest row.</param>
+    /// <param name="count">Number of rows to replace.</param>
+    /// <param name="rows">The new rows, ordered oldest to newest. Their cell arrays are stored directly.</param>
+    /// <param name="timestamp">The timestamp for the new rows.</param>
+    /// <returns>The number of rows evicted from the oldest end.</returns>
+    public int Replace(int start, int count, IReadOnlyList<ReflowScrollbackRow> rows, DateTimeOffset timestamp)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(start);
+        ArgumentOutOfRangeException.ThrowIfNegative(count);
+        ArgumentOutOfRangeException.ThrowIfGreaterThan(start + count, _count);
+
+        // Works on the ring in place: rows before the replaced range stay in their slots, so
+        // a resize only touches the rows it re-wrapped and the rows after them.
+        int oldest = OldestIndex;
+        int tailStart = start + count;
+        int tailLength = _count - tailStart;
+        int newCount = _count - count + rows.Count;
+        int evict = Math.Max(0, newCount - Capacity);
+
+        // AddRef the new rows before releasing the old ones: re-wrapped rows share their
+        // tracked objects with the rows they replace.
+        foreach (var row in rows)
+        {
+            for (int i = 0; i < row.Cells.Length; i++)
+            {
+                row.Cells[i].TrackedSixel?.AddRef();
+                row.Cells[i].TrackedHyperlink?.AddRef();
+            }
+        }
+        for (int i = start; i < tailStart; i++)
+            ReleaseTrackedObjects(_rows[(oldest + i) % Capacity].Cells);
+
+        // Evicted rows are the oldest of the result: unchanged rows, then new rows, then the tail
+        for (int i = 0; i < Math.Min(evict, start); i++)
+            ReleaseTrackedObjects(_rows[(oldest + i) % Capacity].Cells);
+        for (int i = start; i < Math.Min(evict, start + rows.Count); i++)
+            ReleaseTrackedObjects(rows[i - start].Cells);
+        int tailEvicted = Math.Clamp(evict - start - rows.Count, 0, tailLength);
+        for (int i = 0; i < tailEvicted; i++)
+            ReleaseTrackedObjects(_rows[(oldest + tailStart + i) % Capacity].Cells);
+
+        // The tail moves when the row count changes, and its new slots may overlap its old ones
+        ScrollbackRow[]? tail = null;
+        if (rows.Count != count && tailLength > tailEvicted)
+        {
+            tail = new ScrollbackRow[tailLength - tailEvicted];
+            for (int i = 0; i < tail.Length; i++)
+                tail[i] = _rows[(oldest + tailStart + tailEvicted + i) % Capacity];
+        }
+
+        for (int i = Math.Max(0, evict - start); i < rows.Count; i++)
+            _rows[(oldest + start + i) % Capacity] = new ScrollbackRow(rows[i].Cells, rows[i].OriginalWidth, timestamp);
+        if (tail is not null)
+        {
+            int tailTarget = start + rows.Count + tailEvicted;
+            for (int i = 0; i < tail.Length; i++)
+                _rows[(oldest + tailTarget + i) % Capacity] = tail[i];
+        }
+
+        // Slots vacated by a shrinking result
+        for (int i = newCount; i < _count; i++)
+            _rows[(oldest + i) % Capacity] = default;
+
+        _count = newCount - evict;
+        _head = (oldest + newCount) % Capacity;
+        return evict;
+    }
+
     /// <summary>
     /// Removes all rows from the buffer, releasing tracked object references.
     /// </summary>
@@ -111,12 +187,12 @@ internal sealed class ScrollbackBuffer
         if (_count == 0)
             return;
 
-        int startIndex = _count == Capacity ? _head : 0;
+        int startIndex = OldestIndex;
 
         for (int i = 0; i < _count; i++)
         {
             int idx = (startIndex + i) % Capacity;
-            ReleaseTrackedObjects(_rows[idx]);
+            ReleaseTrackedObjects(_rows[idx].Cells);
             _rows[idx] = default;
         }
 
@@ -124,15 +200,15 @@ internal sealed class ScrollbackBuffer
         _count = 0;
     }
 
-    private static void ReleaseTrackedObjects(ScrollbackRow row)
+    private static void ReleaseTrackedObjects(TerminalCell[]? cells)
     {
-        if (row.Cells is null)
+        if (cells is null)
             return;
 
-        for (int i = 0; i < row.Cells.Length; i++)
+        for (int i = 0; i < cells.Length; i++)
         {
-            row.Cells[i].TrackedSixel?.Release();
-            row.Cells[i].TrackedHyperlink?.Release();
+            cells[i].TrackedSixel?.Release();
+            cells[i].TrackedHyperlink?.Release();
         }
     }
 }
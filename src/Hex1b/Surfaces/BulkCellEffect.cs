@@ -0,0 +1,88 @@
+using System.Buffers;
+using Hex1b.Layout;
+
+namespace Hex1b.Surfaces;
+
+/// <summary>
+/// A computed cell effect that can also be applied to a whole region at once.
+/// </summary>
+/// <remarks>
+/// <para>
+/// <see cref="CellEffects"/> hands out <see cref="Compute"/> as its <see cref="CellCompute"/>,
+/// so these effects still work anywhere a delegate does. <see cref="CompositeSurface"/> and
+/// <see cref="Surface.ApplyEffect"/> recognize the delegate's target and call
+/// <see cref="Apply"/> instead, which reads the cells below from a resolved buffer and blends
+/// their colors a row at a time, rather than resolving every cell through a
+/// <see cref="ComputeContext"/>.
+/// </para>
+/// <para>
+/// <see cref="Apply"/> must produce exactly the cells <see cref="Compute"/> would.
+/// </para>
+/// </remarks>
+internal abstract class BulkCellEffect
+{
+    /// <summary>
+    /// Computes one cell, as a <see cref="CellCompute"/>.
+    /// </summary>
+    public abstract SurfaceCell Compute(ComputeContext context);
+
+    /// <summary>
+    /// Computes the effect's cells for a region.
+    /// </summary>
+    /// <param name="below">The resolved cells of the layers below, row-major over the whole
+    /// <paramref name="width"/> by <paramref name="height"/> composite.</param>
+    /// <param name="width">The composite width.</param>
+    /// <param name="height">The composite height.</param>
+    /// <param name="region">The cells to compute, within the composite.</param>
+    /// <param name="output">Receives the computed cells, row-major over the region.</param>
+    public abstract void Apply(ReadOnlySpan<SurfaceCell> below, int width, int height, Rect region, Span<SurfaceCell> output);
+
+    /// <summary>
+    /// Returns the bulk effect behind a delegate, or null for any other delegate.
+    /// </summary>
+    public static BulkCellEffect? From(CellCompute compute) => compute.Target as BulkCellEffect;
+}
+
+/// <summary>
+/// A bulk effect that transforms the packed foreground and background colors of each cell
+/// independently of its neighbors.
+/// </summary>
+internal abstract class ColorCellEffect : BulkCellEffect
+{
+    public override void Apply(ReadOnlySpan<SurfaceCell> below, int width, int height, Rect region, Span<SurfaceCell> output)
+    {
+        var buffer = ArrayPool<uint>.Shared.Rent(region.Width * 2);
+        try
+        {
+            var foreground = buffer.AsSpan(0, region.Width);
+            var background = buffer.AsSpan(region.Width, region.Width);
+
+            for (int row = 0; row < region.Height; row++)
+            {
+                var cells = below.Slice((region.Y + row) * width + region.X, region.Width);
+                CellEffectKernels.PackRow(cells, foreground, background);
+                Transform(foreground, background);
+
+                var rowOutput = output.Slice(row * region.Width, region.Width);
+                for (int i = 0; i < cells.Length; i++)
+                {
+                    rowOutput[i] = Create(cells[i], foreground[i], background[i]);
+                }
+            }
+        }
+        finally
+        {
+            ArrayPool<uint>.Shared.Return(buffer);
+        }
+    }
+
+    /// <summary>
+    /// Transforms one row of packed colors in place.
+    /// </summary>
+    protected abstract void Transform(Span<uint> foreground, Span<uint> background);
+
+    /// <summary>
+    /// Builds the output cell from the cell below and its transformed colors.
+    /// </summary>
+    protected abstract SurfaceCell Create(in SurfaceCell below, uint foreground, uint background);
+}
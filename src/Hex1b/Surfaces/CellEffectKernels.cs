@@ -0,0 +1,216 @@
+using System.Numerics;
+using System.Runtime.InteropServices;
+using Hex1b.Theming;
+
+namespace Hex1b.Surfaces;
+
+/// <summary>
+/// Row kernels behind the built-in <see cref="CellEffects"/>, working on packed colors.
+/// </summary>
+/// <remarks>
+/// <para>
+/// A packed color is <c>0xPPRRGGBB</c> in a <see cref="uint"/>. The kernels treat every byte
+/// as a lane, so a row of colors is processed <see cref="Vector{T}.Count"/> bytes at a time.
+/// The pad byte <c>PP</c> is 0 for the blending kernels; <see cref="SumNeighbors"/> uses it
+/// to count the colors that were present.
+/// </para>
+/// <para>
+/// The arithmetic matches the per-cell helpers in <see cref="CellEffects"/> exactly: channels
+/// are scaled in single precision and truncated, so a layer gives the same cells whether it
+/// is resolved one cell at a time or a row at a time.
+/// </para>
+/// </remarks>
+internal static class CellEffectKernels
+{
+    /// <summary>
+    /// Pad byte marking a color as present for <see cref="SumNeighbors"/>.
+    /// </summary>
+    public const uint Present = 0x01000000;
+
+    private const uint RgbMask = 0x00FFFFFF;
+
+    /// <summary>
+    /// Packs a color, treating a missing one as black like the per-cell effects do.
+    /// </summary>
+    public static uint Pack(Hex1bColor? color)
+        => color is { } c ? (uint)(c.R << 16 | c.G << 8 | c.B) : 0;
+
+    public static Hex1bColor Unpack(uint packed)
+        => Hex1bColor.FromRgb((byte)(packed >> 16), (byte)(packed >> 8), (byte)packed);
+
+    /// <summary>
+    /// Packs the foreground and background colors of a row of cells.
+    /// </summary>
+    public static void PackRow(ReadOnlySpan<SurfaceCell> cells, Span<uint> foreground, Span<uint> background)
+    {
+        for (int i = 0; i < cells.Length; i++)
+        {
+            foreground[i] = Pack(cells[i].Foreground);
+            background[i] = Pack(cells[i].Background);
+        }
+    }
+
+    /// <summary>
+    /// Multiplies every channel by <paramref name="factor"/>, truncating.
+    /// </summary>
+    public static void Scale(Span<uint> colors, float factor)
+    {
+        var bytes = MemoryMarshal.AsBytes(colors);
+        var i = 0;
+
+        if (Vector.IsHardwareAccelerated)
+        {
+            var scale = new Vector<float>(factor);
+            var zero = Vector<float>.Zero;
+            for (; i <= bytes.Length - Vector<byte>.Count; i += Vector<byte>.Count)
+            {
+                var lanes = bytes.Slice(i);
+                Transform(new Vector<byte>(lanes), scale, zero, zero, zero, zero).CopyTo(lanes);
+            }
+        }
+
+        for (; i < bytes.Length; i++)
+        {
+            bytes[i] = (byte)(bytes[i] * factor);
+        }
+    }
+
+    /// <summary>
+    /// Blends every color toward <paramref name="overlay"/> by <paramref name="amount"/>:
+    /// <c>c * (1 - amount) + overlay * amount</c> per channel, truncating.
+    /// </summary>
+    public static void Blend(Span<uint> colors, uint overlay, float amount)
+    {
+        var factor = 1f - amount;
+        var bytes = MemoryMarshal.AsBytes(colors);
+        var i = 0;
+
+        if (Vector.IsHardwareAccelerated)
+        {
+            // The overlay repeats every four lanes, so its weighted channels line up with
+            // the widened color lanes and can be computed once
+            var overlayBytes = Vector.AsVectorByte(new Vector<uint>(overlay & RgbMask));
+            var weight = new Vector<float>(amount);
+            Widen(overlayBytes, out var o0, out var o1, out var o2, out var o3);
+            o0 *= weight;
+            o1 *= weight;
+            o2 *= weight;
+            o3 *= weight;
+            var scale = new Vector<float>(factor);
+            for (; i <= bytes.Length - Vector<byte>.Count; i += Vector<byte>.Count)
+            {
+                var lanes = bytes.Slice(i);
+                Transform(new Vector<byte>(lanes), scale, o0, o1, o2, o3).CopyTo(lanes);
+            }
+        }
+
+        Span<byte> overlayChannels = stackalloc byte[sizeof(uint)];
+        MemoryMarshal.Write(overlayChannels, overlay & RgbMask);
+        for (; i < bytes.Length; i++)
+        {
+            bytes[i] = (byte)(bytes[i] * factor + overlayChannels[i % sizeof(uint)] * amount);
+        }
+    }
+
+    /// <summary>
+    /// Replaces every channel with <c>255 - channel</c>.
+    /// </summary>
+    public static void Invert(Span<uint> colors)
+    {
+        var i = 0;
+
+        if (Vector.IsHardwareAccelerated)
+        {
+            var mask = new Vector<uint>(RgbMask);
+            for (; i <= colors.Length - Vector<uint>.Count; i += Vector<uint>.Count)
+            {
+                var lanes = colors.Slice(i);
+                (new Vector<uint>(lanes) ^ mask).CopyTo(lanes);
+            }
+        }
+
+        for (; i < colors.Length; i++)
+        {
+            colors[i] ^= RgbMask;
+        }
+    }
+
+    /// <summary>
+    /// Sums each color with its four neighbors, per channel.
+    /// </summary>
+    /// <remarks>
+    /// <paramref name="above"/>, <paramref name="row"/> and <paramref name="below"/> hold one
+    /// extra color on each side, so <c>sums</c> entry <c>i</c> covers <c>row[i + 1]</c>. Colors
+    /// are packed with <see cref="Present"/> set, so the pad lane of each sum counts the colors
+    /// that contributed. <paramref name="sums"/> receives four lanes per color.
+    /// </remarks>
+    public static void SumNeighbors(ReadOnlySpan<uint> above, ReadOnlySpan<uint> row, ReadOnlySpan<uint> below, Span<ushort> sums)
+    {
+        var count = row.Length - 2;
+        var up = MemoryMarshal.AsBytes(above.Slice(1, count));
+        var down = MemoryMarshal.AsBytes(below.Slice(1, count));
+        var left = MemoryMarshal.AsBytes(row.Slice(0, count));
+        var center = MemoryMarshal.AsBytes(row.Slice(1, count));
+        var right = MemoryMarshal.AsBytes(row.Slice(2, count));
+        var i = 0;
+
+        if (Vector.IsHardwareAccelerated)
+        {
+            for (; i <= center.Length - Vector<byte>.Count; i += Vector<byte>.Count)
+            {
+                Vector.Widen(new Vector<byte>(center.Slice(i)), out var lo, out var hi);
+                Accumulate(up.Slice(i), ref lo, ref hi);
+                Accumulate(down.Slice(i), ref lo, ref hi);
+                Accumulate(left.Slice(i), ref lo, ref hi);
+                Accumulate(right.Slice(i), ref lo, ref hi);
+                lo.CopyTo(sums.Slice(i));
+                hi.CopyTo(sums.Slice(i + Vector<ushort>.Count));
+            }
+        }
+
+        for (; i < center.Length; i++)
+        {
+            sums[i] = (ushort)(center[i] + up[i] + down[i] + left[i] + right[i]);
+        }
+    }
+
+    private static void Accumulate(ReadOnlySpan<byte> lanes, ref Vector<ushort> lo, ref Vector<ushort> hi)
+    {
+        Vector.Widen(new Vector<byte>(lanes), out var addLo, out var addHi);
+        lo += addLo;
+        hi += addHi;
+    }
+
+    /// <summary>
+    /// Scales the bytes of one vector in single precision and adds the offsets, lane by lane.
+    /// </summary>
+    /// <remarks>
+    /// Converts through <see cref="int"/> rather than <see cref="uint"/>: the lanes never
+    /// exceed 255, and only the signed conversions have vector instructions before AVX-512.
+    /// </remarks>
+    private static Vector<byte> Transform(
+        Vector<byte> lanes, Vector<float> scale,
+        Vector<float> add0, Vector<float> add1, Vector<float> add2, Vector<float> add3)
+    {
+        Widen(lanes, out var f0, out var f1, out var f2, out var f3);
+        return Vector.Narrow(
+            Vector.Narrow(
+                Vector.AsVectorUInt32(Vector.ConvertToInt32(f0 * scale + add0)),
+                Vector.AsVectorUInt32(Vector.ConvertToInt32(f1 * scale + add1))),
+            Vector.Narrow(
+                Vector.AsVectorUInt32(Vector.ConvertToInt32(f2 * scale + add2)),
+                Vector.AsVectorUInt32(Vector.ConvertToInt32(f3 * scale + add3))));
+    }
+
+    private static void Widen(Vector<byte> lanes,
+        out Vector<float> f0, out Vector<float> f1, out Vector<float> f2, out Vector<float> f3)
+    {
+        Vector.Widen(lanes, out var lo, out var hi);
+        Vector.Widen(lo, out var u0, out var u1);
+        Vector.Widen(hi, out var u2, out var u3);
+        f0 = Vector.ConvertToSingle(Vector.AsVectorInt32(u0));
+        f1 = Vector.ConvertToSingle(Vector.AsVectorInt32(u1));
+        f2 = Vector.ConvertToSingle(Vector.AsVectorInt32(u2));
+        f3 = Vector.ConvertToSingle(Vector.AsVectorInt32(u3));
+    }
+}
@@ -1,3 +1,5 @@
+using System.Buffers;
+using Hex1b.Layout;
 using Hex1b.Theming;
 
 namespace Hex1b.Surfaces;
@@ -5,6 +7,11 @@ namespace Hex1b.Surfaces;
 /// <summary>
 /// Provides factory methods for common computed cell effects.
 /// </summary>
+/// <remarks>
+/// Apart from <see cref="Conditional"/>, these effects also have row kernels: when a
+/// <see cref="CompositeSurface"/> is flattened, or passed to <see cref="Surface.ApplyEffect"/>,
+/// their colors are blended a row at a time with SIMD instead of one cell at a time.
+/// </remarks>
 public static class CellEffects
 {
     /// <summary>
@@ -18,14 +25,7 @@ public static class CellEffects
     /// <returns>A <see cref="CellCompute"/> delegate for the shadow effect.</returns>
     public static CellCompute DropShadow(float opacity = 0.5f)
     {
-        opacity = Math.Clamp(opacity, 0f, 1f);
-
-        return context =>
-        {
-            var below = context.GetBelow();
-            var darkenedBg = DarkenColor(below.Background, opacity);
-            return new SurfaceCell(" ", null, darkenedBg);
-        };
+        return new DropShadowEffect(Math.Clamp(opacity, 0f, 1f)).Compute;
     }
 
     /// <summary>
@@ -36,15 +36,7 @@ public static class CellEffects
     /// <returns>A <see cref="CellCompute"/> delegate for the tint effect.</returns>
     public static CellCompute Tint(Hex1bColor tintColor, float opacity = 0.3f)
     {
-        opacity = Math.Clamp(opacity, 0f, 1f);
-
-        return context =>
-        {
-            var below = context.GetBelow();
-            var tintedBg = BlendColors(below.Background, tintColor, opacity);
-            var tintedFg = BlendColors(below.Foreground, tintColor, opacity);
-            return below with { Background = tintedBg, Foreground = tintedFg };
-        };
+        return new TintEffect(tintColor, Math.Clamp(opacity, 0f, 1f)).Compute;
     }
 
     /// <summary>
@@ -54,15 +46,7 @@ public static class CellEffects
     /// <returns>A <see cref="CellCompute"/> delegate for the dim effect.</returns>
     public static CellCompute Dim(float amount = 0.5f)
     {
-        amount = Math.Clamp(amount, 0f, 1f);
-
-        return context =>
-        {
-            var below = context.GetBelow();
-            var dimmedBg = DarkenColor(below.Background, amount);
-            var dimmedFg = DarkenColor(below.Foreground, amount);
-            return below with { Background = dimmedBg, Foreground = dimmedFg };
-        };
+        return new DimEffect(Math.Clamp(amount, 0f, 1f)).Compute;
     }
 
     /// <summary>
@@ -71,13 +55,7 @@ public static class CellEffects
     /// <returns>A <see cref="CellCompute"/> delegate for the invert effect.</returns>
     public static CellCompute Invert()
     {
-        return context =>
-        {
-            var below = context.GetBelow();
-            var invertedBg = InvertColor(below.Background);
-            var invertedFg = InvertColor(below.Foreground);
-            return below with { Background = invertedBg, Foreground = invertedFg };
-        };
+        return InvertEffect.Instance.Compute;
     }
 
     /// <summary>
@@ -90,23 +68,7 @@ public static class CellEffects
     /// <returns>A <see cref="CellCompute"/> delegate for the blur effect.</returns>
     public static CellCompute BlurBackground()
     {
-        return context =>
-        {
-            var center = context.GetBelow();
-            var up = context.GetBelowAt(context.X, context.Y - 1);
-            var down = context.GetBelowAt(context.X, context.Y + 1);
-            var left = context.GetBelowAt(context.X - 1, context.Y);
-            var right = context.GetBelowAt(context.X + 1, context.Y);
-
-            var blurredBg = AverageColors(
-                center.Background,
-                up.Background,
-                down.Background,
-                left.Background,
-                right.Background);
-
-            return center with { Background = blurredBg };
-        };
+        return BlurBackgroundEffect.Instance.Compute;
     }
 
     /// <summary>
@@ -116,7 +78,7 @@ public static class CellEffects
     /// <returns>A <see cref="CellCompute"/> delegate that passes through cells unchanged.</returns>
     public static CellCompute Passthrough()
     {
-        return context => context.GetBelow();
+        return PassthroughEffect.Instance.Compute;
     }
 
     /// <summary>
@@ -140,6 +102,206 @@ public static class CellEffects
         };
     }
 
+    #region Effects
+
+    private sealed class DropShadowEffect(float opacity) : ColorCellEffect
+    {
+        public override SurfaceCell Compute(ComputeContext context)
+        {
+            var below = context.GetBelow();
+            var darkenedBg = DarkenColor(below.Background, opacity);
+            return new SurfaceCell(" ", null, darkenedBg);
+        }
+
+        protected override void Transform(Span<uint> foreground, Span<uint> background)
+            => CellEffectKernels.Scale(background, 1f - opacity);
+
+        protected override SurfaceCell Create(in SurfaceCell below, uint foreground, uint background)
+            => new(" ", null, CellEffectKernels.Unpack(background));
+    }
+
+    private sealed class TintEffect(Hex1bColor tintColor, float opacity) : ColorCellEffect
+    {
+        private readonly uint _tint = CellEffectKernels.Pack(tintColor);
+
+        public override SurfaceCell Compute(ComputeContext context)
+        {
+            var below = context.GetBelow();
+            var tintedBg = BlendColors(below.Background, tintColor, opacity);
+            var tintedFg = BlendColors(below.Foreground, tintColor, opacity);
+            return below with { Background = tintedBg, Foreground = tintedFg };
+        }
+
+        protected override void Transform(Span<uint> foreground, Span<uint> background)
+        {
+            CellEffectKernels.Blend(foreground, _tint, opacity);
+            CellEffectKernels.Blend(background, _tint, opacity);
+        }
+
+        protected override SurfaceCell Create(in SurfaceCell below, uint foreground, uint background)
+            => below with { Background = CellEffectKernels.Unpack(background), Foreground = CellEffectKernels.Unpack(foreground) };
+    }
+
+    private sealed class DimEffect(float amount) : ColorCellEffect
+    {
+        public override SurfaceCell Compute(ComputeContext context)
+        {
+            var below = context.GetBelow();
+            var dimmedBg = DarkenColor(below.Background, amount);
+            var dimmedFg = DarkenColor(below.Foreground, amount);
+            return below with { Background = dimmedBg, Foreground = dimmedFg };
+        }
+
+        protected override void Transform(Span<uint> foreground, Span<uint> background)
+        {
+            CellEffectKernels.Scale(foreground, 1f - amount);
+            CellEffectKernels.Scale(background, 1f - amount);
+        }
+
+        protected override SurfaceCell Create(in SurfaceCell below, uint foreground, uint background)
+            => below with { Background = CellEffectKernels.Unpack(background), Foreground = CellEffectKernels.Unpack(foreground) };
+    }
+
+    private sealed class InvertEffect : ColorCellEffect
+    {
+        public static readonly InvertEffect Instance = new();
+
+        public override SurfaceCell Compute(ComputeContext context)
+        {
+            var below = context.GetBelow();
+            var invertedBg = InvertColor(below.Background);
+            var invertedFg = InvertColor(below.Foreground);
+            return below with { Background = invertedBg, Foreground = invertedFg };
+        }
+
+        protected override void Transform(Span<uint> foreground, Span<uint> background)
+        {
+            CellEffectKernels.Invert(foreground);
+            CellEffectKernels.Invert(background);
+        }
+
+        protected override SurfaceCell Create(in SurfaceCell below, uint foreground, uint background)
+            => below with { Background = CellEffectKernels.Unpack(background), Foreground = CellEffectKernels.Unpack(foreground) };
+    }
+
+    private sealed class PassthroughEffect : BulkCellEffect
+    {
+        public static readonly PassthroughEffect Instance = new();
+
+        public override SurfaceCell Compute(ComputeContext context) => context.GetBelow();
+
+        public override void Apply(ReadOnlySpan<SurfaceCell> below, int width, int height, Rect region, Span<SurfaceCell> output)
+        {
+            for (int row = 0; row < region.Height; row++)
+            {
+                below.Slice((region.Y + row) * width + region.X, region.Width)
+                    .CopyTo(output.Slice(row * region.Width));
+            }
+        }
+    }
+
+    private sealed class BlurBackgroundEffect : BulkCellEffect
+    {
+        public static readonly BlurBackgroundEffect Instance = new();
+
+        // Lanes of a packed color in memory: blue, green, red, then the presence count
+        private static readonly int BlueLane = BitConverter.IsLittleEndian ? 0 : 3;
+        private static readonly int GreenLane = BitConverter.IsLittleEndian ? 1 : 2;
+        private static readonly int RedLane = BitConverter.IsLittleEndian ? 2 : 1;
+        private static readonly int CountLane = BitConverter.IsLittleEndian ? 3 : 0;
+
+        public override SurfaceCell Compute(ComputeContext context)
+        {
+            var center = context.GetBelow();
+            var up = context.GetBelowAt(context.X, context.Y - 1);
+            var down = context.GetBelowAt(context.X, context.Y + 1);
+            var left = context.GetBelowAt(context.X - 1, context.Y);
+            var right = context.GetBelowAt(context.X + 1, context.Y);
+
+            var blurredBg = AverageColors(
+                center.Background,
+                up.Background,
+                down.Background,
+                left.Background,
+                right.Background);
+
+            return center with { Background = blurredBg };
+        }
+
+        public override void Apply(ReadOnlySpan<SurfaceCell> below, int width, int height, Rect region, Span<SurfaceCell> output)
+        {
+            // Three rows of backgrounds, one column wider on each side, rotated as we go down
+            var stride = region.Width + 2;
+            var packed = ArrayPool<uint>.Shared.Rent(stride * 3);
+            var sums = ArrayPool<ushort>.Shared.Rent(region.Width * 4);
+            try
+            {
+                var above = packed.AsSpan(0, stride);
+                var current = packed.AsSpan(stride, stride);
+                var next = packed.AsSpan(stride * 2, stride);
+                PackBackgrounds(below, width, height, region.X - 1, region.Y - 1, above);
+                PackBackgrounds(below, width, height, region.X - 1, region.Y, current);
+
+                for (int row = 0; row < region.Height; row++)
+                {
+                    var y = region.Y + row;
+                    PackBackgrounds(below, width, height, region.X - 1, y + 1, next);
+                    CellEffectKernels.SumNeighbors(above, current, next, sums);
+
+                    var cells = below.Slice(y * width + region.X, region.Width);
+                    var rowOutput = output.Slice(row * region.Width, region.Width);
+                    for (int i = 0; i < cells.Length; i++)
+                    {
+                        var sum = sums.AsSpan(i * 4, 4);
+                        var count = sum[CountLane];
+                        rowOutput[i] = cells[i] with
+                        {
+                            Background = count == 0
+                                ? null
+                                : Hex1bColor.FromRgb(
+                                    (byte)(sum[RedLane] / count),
+                                    (byte)(sum[GreenLane] / count),
+                                    (byte)(sum[BlueLane] / count))
+                        };
+                    }
+
+                    var recycled = above;
+                    above = current;
+                    current = next;
+                    next = recycled;
+                }
+            }
+            finally
+            {
+                ArrayPool<uint>.Shared.Return(packed);
+                ArrayPool<ushort>.Shared.Return(sums);
+            }
+        }
+
+        /// <summary>
+        /// Packs the backgrounds of a row segment, marking present colors. Cells outside the
+        /// composite and transparent backgrounds count as absent.
+        /// </summary>
+        private static void PackBackgrounds(ReadOnlySpan<SurfaceCell> below, int width, int height, int x, int y, Span<uint> packed)
+        {
+            if (y < 0 || y >= height)
+            {
+                packed.Clear();
+                return;
+            }
+
+            for (int i = 0; i < packed.Length; i++)
+            {
+                var column = x + i;
+                packed[i] = column >= 0 && column < width && below[y * width + column].Background is { } background
+                    ? CellEffectKernels.Pack(background) | CellEffectKernels.Present
+                    : 0;
+            }
+        }
+    }
+
+    #endregion
+
     #region Color Helpers
 
     private static Hex1bColor? DarkenColor(Hex1bColor? color, float amount)
@@ -1,3 +1,5 @@
+using System.Buffers;
+
 namespace Hex1b.Surfaces;
 
 /// <summary>
@@ -317,6 +319,30 @@ public sealed class CompositeSurface : ISurfaceSource
                 nameof(result));
         }
 
+        if (CanResolveByLayer)
+        {
+            var count = Width * Height;
+            var buffer = ArrayPool<SurfaceCell>.Shared.Rent(count);
+            try
+            {
+                var resolved = buffer.AsSpan(0, count);
+                ResolveByLayer(resolved);
+                for (var y = 0; y < Height; y++)
+                {
+                    for (var x = 0; x < Width; x++)
+                    {
+                        result[x, y] = resolved[y * Width + x];
+                    }
+                }
+            }
+            finally
+            {
+                // Cells hold strings and tracked objects; don't keep them alive in the pool
+                ArrayPool<SurfaceCell>.Shared.Return(buffer, clearArray: true);
+            }
+            return;
+        }
+
         var context = new LayerResolutionContext(this);
 
         for (var y = 0; y < Height; y++)
@@ -328,6 +354,110 @@ public sealed class CompositeSurface : ISurfaceSource
         }
     }
 
+    /// <summary>
+    /// Resolves every cell into <paramref name="resolved"/>, row-major.
+    /// </summary>
+    internal void ResolveInto(Span<SurfaceCell> resolved)
+    {
+        if (CanResolveByLayer)
+        {
+            ResolveByLayer(resolved);
+            return;
+        }
+
+        var context = new LayerResolutionContext(this);
+
+        for (var y = 0; y < Height; y++)
+        {
+            for (var x = 0; x < Width; x++)
+            {
+                resolved[y * Width + x] = context.ResolveCell(x, y);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets whether every computed layer is a <see cref="BulkCellEffect"/>, so the composite
+    /// can be resolved a layer at a time instead of a cell at a time.
+    /// </summary>
+    private bool CanResolveByLayer
+    {
+        get
+        {
+            foreach (var layer in _layers)
+            {
+                if (layer.Compute is not null && BulkCellEffect.From(layer.Compute) is null)
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    /// <summary>
+    /// Resolves bottom-up, one layer at a time, into <paramref name="resolved"/>.
+    /// </summary>
+    /// <remarks>
+    /// After a layer is applied the buffer holds exactly what
+    /// <see cref="ComputeContext.GetBelow"/> returns to the next layer, so bulk effects read it
+    /// directly. Cells compose the same way as in <see cref="LayerResolutionContext"/>.
+    /// </remarks>
+    private void ResolveByLayer(Span<SurfaceCell> resolved)
+    {
+        SurfaceCell[]? computedBuffer = null;
+        try
+        {
+            resolved.Fill(SurfaceCells.Empty);
+
+            foreach (var layer in _layers)
+            {
+                var left = Math.Max(0, layer.OffsetX);
+                var top = Math.Max(0, layer.OffsetY);
+                var right = Math.Min(Width, layer.OffsetX + layer.Source.Width);
+                var bottom = Math.Min(Height, layer.OffsetY + layer.Source.Height);
+                if (left >= right || top >= bottom)
+                    continue;
+
+                if (layer.Compute is null)
+                {
+                    for (var y = top; y < bottom; y++)
+                    {
+                        for (var x = left; x < right; x++)
+                        {
+                            var srcX = x - layer.OffsetX;
+                            var srcY = y - layer.OffsetY;
+                            if (!layer.Source.IsInBounds(srcX, srcY))
+                                continue;
+
+                            ref var cell = ref resolved[y * Width + x];
+                            cell = LayerResolutionContext.CompositeCell(cell, layer.Source.GetCell(srcX, srcY));
+                        }
+                    }
+                    continue;
+                }
+
+                var region = new Layout.Rect(left, top, right - left, bottom - top);
+                computedBuffer ??= ArrayPool<SurfaceCell>.Shared.Rent(resolved.Length);
+                var computed = computedBuffer.AsSpan(0, region.Width * region.Height);
+                BulkCellEffect.From(layer.Compute)!.Apply(resolved, Width, Height, region, computed);
+
+                for (var y = top; y < bottom; y++)
+                {
+                    var computedRow = computed.Slice((y - top) * region.Width, region.Width);
+                    var resolvedRow = resolved.Slice(y * Width + left, region.Width);
+                    for (var x = 0; x < computedRow.Length; x++)
+                    {
+                        resolvedRow[x] = LayerResolutionContext.CompositeCell(resolvedRow[x], computedRow[x]);
+                    }
+                }
+            }
+        }
+        finally
+        {
+            if (computedBuffer is not null)
+                ArrayPool<SurfaceCell>.Shared.Return(computedBuffer, clearArray: true);
+        }
+    }
+
     /// <summary>
     /// Computes sixel fragments for all sixels in this composite, accounting for occlusion.
     /// </summary>
@@ -871,7 +1001,7 @@ public sealed class CompositeSurface : ISurfaceSource
             }
         }
 
-        private static SurfaceCell CompositeCell(SurfaceCell below, SurfaceCell above)
+        internal static SurfaceCell CompositeCell(SurfaceCell below, SurfaceCell above)
         {
             // Handle transparency
             if (above.HasTransparentBackground)
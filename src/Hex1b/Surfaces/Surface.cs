@@ -1,3 +1,4 @@
+using System.Buffers;
 using System.Globalization;
 using Hex1b.Layout;
 using Hex1b.Theming;
@@ -652,6 +653,60 @@ public sealed class Surface : ISurfaceSource
         }
     }
 
+    /// <summary>
+    /// Applies a computed cell effect to this surface in place, as if the effect were a
+    /// computed layer over a composite with this surface as its only other layer.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Intended for <see cref="Nodes.EffectPanelNode"/> effect callbacks. The effects from
+    /// <see cref="CellEffects"/> run as row kernels over the whole surface; any other delegate
+    /// is evaluated a cell at a time against a copy of the surface.
+    /// </para>
+    /// <para>
+    /// Only cells the effect changes are written.
+    /// </para>
+    /// </remarks>
+    /// <param name="effect">The effect to apply, for example <see cref="CellEffects.Dim"/>.</param>
+    public void ApplyEffect(CellCompute effect)
+    {
+        ArgumentNullException.ThrowIfNull(effect);
+
+        // Row kernels read every cell before any is written; per-cell delegates may read
+        // neighbors that have already been replaced, so they get a copy
+        var composite = new CompositeSurface(Width, Height, CellMetrics);
+        composite.AddLayer(BulkCellEffect.From(effect) is not null ? this : Clone());
+        composite.AddComputedLayer(Width, Height, effect);
+
+        var buffer = ArrayPool<SurfaceCell>.Shared.Rent(_cells.Length);
+        try
+        {
+            var resolved = buffer.AsSpan(0, _cells.Length);
+            composite.ResolveInto(resolved);
+
+            for (int y = 0; y < Height; y++)
+            {
+                for (int x = 0; x < Width; x++)
+                {
+                    var index = y * Width + x;
+                    var current = _cells[index];
+                    var cell = resolved[index];
+
+                    // What the effect saw for this cell; unstyled spaces read as unwritten
+                    var below = CompositeSurface.LayerResolutionContext.CompositeCell(SurfaceCells.Empty, current);
+                    if (cell != current && cell != below)
+                    {
+                        this[x, y] = cell;
+                    }
+                }
+            }
+        }
+        finally
+        {
+            ArrayPool<SurfaceCell>.Shared.Return(buffer, clearArray: true);
+        }
+    }
+
     private Dictionary<(int X, int Y), SurfaceCell> BuildKgpCompositeOverrides(
         ISurfaceSource source,
         int offsetX,
@@ -665,6 +665,7 @@ public class SurfaceRenderContext : Hex1bRenderContext
                         KgpImageEpoch = KgpImageEpoch,
                         MouseX = MouseX,
                         MouseY = MouseY,
+                        VisibleRect = VisibleRect,
                         CellMetrics = CellMetrics,
                         Metrics = Metrics,
                         SurfacePool = pool,
@@ -752,6 +753,7 @@ public class SurfaceRenderContext : Hex1bRenderContext
         if (!child.IsDirty
             && child.CachedSurface != null
             && child.CachedBounds == child.Bounds
+            && (child.CachedVisibleRect is not { } cachedVisible || cachedVisible == VisibleRect)
             && child.CachedSurface.Width == child.Bounds.Width
             && child.CachedSurface.Height == child.Bounds.Height)
         {
@@ -836,6 +838,7 @@ public class SurfaceRenderContext : Hex1bRenderContext
                 KgpImageEpoch = KgpImageEpoch,
                 MouseX = MouseX,  // Pass mouse position to children
                 MouseY = MouseY,
+                VisibleRect = VisibleRect,
                 CellMetrics = CellMetrics,  // Propagate cell metrics for sixel sizing
                 Metrics = Metrics,
                 SurfacePool = SurfacePool, // Propagate the pool so descendants (EffectPanel temp surfaces, nested RenderChild surfaces) reuse buffers instead of falling back to `new Surface`.
@@ -868,6 +871,9 @@ public class SurfaceRenderContext : Hex1bRenderContext
             // Cache the result
             child.CachedSurface = childSurface;
             child.CachedBounds = child.Bounds;
+            child.CachedVisibleRect = VisibleRect is { } visible && visible.Intersect(child.Bounds) != child.Bounds
+                ? visible
+                : null;
             child.CachedSubtreeRenderVersion = subtreeVersionBeforeRender;
             
             // Composite onto our surface at RELATIVE position
@@ -895,7 +901,7 @@ public class SurfaceRenderContext : Hex1bRenderContext
         }
     }
 
-    private static bool HasConsistentParentLinks(Hex1bNode node)
+    internal static bool HasConsistentParentLinks(Hex1bNode node)
     {
         foreach (var child in node.GetChildren())
         {
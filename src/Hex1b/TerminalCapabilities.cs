@@ -64,6 +64,12 @@ public record TerminalCapabilities
     /// Presentation supports Kitty Graphics Protocol (KGP) for inline image display.
     /// </summary>
     public bool SupportsKgp { get; init; }
+
+    /// <summary>
+    /// Presentation supports synchronized output (DEC private mode 2026), so a frame
+    /// wrapped in it is displayed at once instead of as it arrives.
+    /// </summary>
+    public bool SupportsSynchronizedOutput { get; init; }
     
     /// <summary>
     /// Whether the terminal supports retroactive variation selector width changes.
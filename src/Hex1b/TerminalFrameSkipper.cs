@@ -0,0 +1,172 @@
+using System.Text;
+using Hex1b.Theming;
+
+namespace Hex1b;
+
+/// <summary>
+/// Decides when the output pump stops forwarding raw workload output and renders the
+/// presentation from the screen buffer instead.
+/// </summary>
+/// <remarks>
+/// <para>
+/// A burst starts when the pump finds output already waiting for it, which means the
+/// workload is producing faster than the output is consumed. Once a burst has lasted a
+/// whole interval, the pump keeps applying output to the screen buffer but only sends the
+/// rows that changed, at most once per interval. When the workload stops for breath the
+/// burst ends and the full terminal state is sent, so modes and the pen changed by skipped
+/// output are brought up to date too.
+/// </para>
+/// <para>
+/// Screen rows are shared copy-on-write with pins, so a row whose array is the one sent
+/// last time hasn't been written since. Not thread-safe; only the output pump uses it.
+/// </para>
+/// </remarks>
+internal sealed class TerminalFrameSkipper
+{
+    private readonly TimeSpan _interval;
+    private readonly TimeProvider _timeProvider;
+    private readonly StringBuilder _sb = new();
+
+    private long _burstStart;
+    private long _lastRepaint;
+
+    // Rows as the presentation last saw them
+    private TerminalCell[][] _shownRows = [];
+    private int _shownWidth;
+
+    public TerminalFrameSkipper(TimeSpan interval, TimeProvider timeProvider)
+    {
+        _interval = interval;
+        _timeProvider = timeProvider;
+    }
+
+    /// <summary>
+    /// Whether raw output is currently being skipped.
+    /// </summary>
+    public bool IsSkipping { get; private set; }
+
+    /// <summary>
+    /// Records that output was already waiting when the pump asked for it. Starts skipping
+    /// once that has kept happening for a whole interval.
+    /// </summary>
+    /// <remarks>
+    /// Must be called before the output is applied, while the presentation still shows
+    /// exactly what the screen buffer holds.
+    /// </remarks>
+    public void OnOutputWaiting(Hex1bTerminal terminal)
+    {
+        var now = _timeProvider.GetTimestamp();
+        if (_burstStart == 0)
+        {
+            _burstStart = now;
+            return;
+        }
+
+        if (IsSkipping || _timeProvider.GetElapsedTime(_burstStart, now) < _interval)
+            return;
+
+        var pinned = terminal.PinScreen(0);
+        _shownRows = pinned.ScreenRows;
+        _shownWidth = pinned.Width;
+        _lastRepaint = now;
+        IsSkipping = true;
+    }
+
+    /// <summary>
+    /// Returns the rows that changed since the last repaint if one is due, otherwise null.
+    /// </summary>
+    public byte[]? TakeDueRepaint(Hex1bTerminal terminal)
+    {
+        var now = _timeProvider.GetTimestamp();
+        if (!IsSkipping || _timeProvider.GetElapsedTime(_lastRepaint, now) < _interval)
+            return null;
+
+        _lastRepaint = now;
+        var pinned = terminal.PinScreen(0);
+        if (pinned.Width != _shownWidth || pinned.ScreenRows.Length != _shownRows.Length)
+        {
+            // Resized mid-burst; row positions no longer line up, so send everything
+            _shownRows = pinned.ScreenRows;
+            _shownWidth = pinned.Width;
+            return OffscreenTerminal.CaptureState(terminal);
+        }
+
+        // The presentation still has the margins and origin mode the workload last set, so
+        // rows are addressed with those lifted and they are put back afterwards
+        _sb.Clear();
+        OffscreenTerminal.AppendAbsoluteAddressing(_sb);
+        var prefixLength = _sb.Length;
+        for (int y = 0; y < pinned.ScreenRows.Length; y++)
+        {
+            var row = pinned.ScreenRows[y];
+            if (!ReferenceEquals(row, _shownRows[y]))
+                AppendRow(_sb, y, row, pinned.Width);
+        }
+        _shownRows = pinned.ScreenRows;
+
+        if (_sb.Length == prefixLength)
+            return null;
+
+        // Put the margins, cursor and pen back where the workload expects them
+        var (foreground, background, attributes, scrollTop, scrollBottom) = terminal.GetRenditionState();
+        OffscreenTerminal.AppendAddressingAndCursor(
+            _sb, scrollTop, scrollBottom, pinned.ScreenRows.Length, terminal.OriginModeEnabled, pinned.CursorX, pinned.CursorY);
+        _sb.Append("\x1b[0m");
+        OffscreenTerminal.AppendPen(_sb, foreground, background, attributes);
+        return Encoding.UTF8.GetBytes(_sb.ToString());
+    }
+
+    /// <summary>
+    /// Ends the current burst. Returns the full terminal state to send if output was being
+    /// skipped, otherwise null.
+    /// </summary>
+    public byte[]? EndBurst(Hex1bTerminal terminal)
+    {
+        _burstStart = 0;
+        if (!IsSkipping)
+            return null;
+
+        IsSkipping = false;
+        _shownRows = [];
+        return OffscreenTerminal.CaptureState(terminal);
+    }
+
+    private static void AppendRow(StringBuilder sb, int y, TerminalCell[] row, int width)
+    {
+        sb.Append("\x1b[").Append(y + 1).Append(";1H\x1b[0m");
+
+        Hex1bColor? foreground = null;
+        Hex1bColor? background = null;
+        var attributes = CellAttributes.None;
+        for (int x = 0; x < width && x < row.Length; x++)
+        {
+            var cell = row[x];
+            var ch = cell.Character;
+
+            // Continuation cells of wide characters
+            if (string.IsNullOrEmpty(ch))
+                continue;
+            // Never-painted cells show as blank
+            if (ch is "\0" or "\uE000")
+                ch = " ";
+
+            if (cell.Attributes != attributes || !SameColor(cell.Foreground, foreground)
+                || !SameColor(cell.Background, background))
+            {
+                sb.Append("\x1b[0m");
+                OffscreenTerminal.AppendPen(sb, cell.Foreground, cell.Background, cell.Attributes);
+                (foreground, background, attributes) = (cell.Foreground, cell.Background, cell.Attributes);
+            }
+            sb.Append(ch);
+        }
+    }
+
+    private static bool SameColor(Hex1bColor? a, Hex1bColor? b)
+    {
+        if (a is not { } x || b is not { } y)
+            return a.HasValue == b.HasValue;
+
+        return x.Kind == y.Kind && x.AnsiIndex == y.AnsiIndex && x.IsDefault == y.IsDefault
+            && x.R == y.R && x.G == y.G && x.B == y.B;
+    }
+}
@@ -0,0 +1,141 @@
+namespace Hex1b;
+
+/// <summary>
+/// The visible cell grid of a <see cref="Hex1bTerminal"/>, stored as rows that can be
+/// shared copy-on-write with snapshots.
+/// </summary>
+/// <remarks>
+/// <para>
+/// <see cref="Pin"/> hands out the current row table in O(1): the table and every row
+/// it references become shared. The next write to a shared row clones just that row
+/// (and, once per pin, the row table itself), so a snapshot keeps seeing the rows as
+/// they were when it was pinned while the terminal keeps writing.
+/// </para>
+/// <para>
+/// Reads go through the <c>ref readonly</c> indexer and never clone. Writes must go
+/// through <see cref="GetCellForWrite"/> or <see cref="GetRowForWrite"/>.
+/// </para>
+/// <para>
+/// Because every post-pin write replaces the row array, two pinned row tables that hold
+/// the same array reference for a row are guaranteed to have identical contents there.
+/// </para>
+/// <para>
+/// Not thread-safe; the terminal guards all access with its buffer lock.
+/// </para>
+/// </remarks>
+internal sealed class TerminalScreenBuffer
+{
+    private TerminalCell[][] _rows;
+    private long[] _rowEpochs; // Pin epoch at which each row was last made private
+    private long _pinEpoch;
+    private bool _rowTableShared;
+
+    /// <summary>
+    /// Creates a buffer of <paramref name="height"/> rows of <paramref name="width"/> default cells.
+    /// </summary>
+    public TerminalScreenBuffer(int height, int width)
+    {
+        Width = width;
+        Height = height;
+        _rows = new TerminalCell[height][];
+        for (int y = 0; y < height; y++)
+            _rows[y] = new TerminalCell[width];
+        _rowEpochs = new long[height];
+    }
+
+    /// <summary>
+    /// Creates a buffer that takes ownership of <paramref name="rows"/>.
+    /// Every row must be exactly <paramref name="width"/> cells long.
+    /// </summary>
+    public TerminalScreenBuffer(TerminalCell[][] rows, int width)
+    {
+        Width = width;
+        Height = rows.Length;
+        _rows = rows;
+        _rowEpochs = new long[rows.Length];
+    }
+
+    /// <summary>Number of columns.</summary>
+    public int Width { get; }
+
+    /// <summary>Number of rows.</summary>
+    public int Height { get; }
+
+    /// <summary>
+    /// Reads a cell without cloning its row.
+    /// </summary>
+    public ref readonly TerminalCell this[int y, int x] => ref _rows[y][x];
+
+    /// <summary>
+    /// Gets a read-only view of a row without cloning it.
+    /// </summary>
+    public ReadOnlySpan<TerminalCell> GetRow(int y) => _rows[y];
+
+    /// <summary>
+    /// Gets a writable reference to a cell, cloning its row first if a pin shares it.
+    /// </summary>
+    public ref TerminalCell GetCellForWrite(int y, int x) => ref GetRowForWrite(y)[x];
+
+    /// <summary>
+    /// Gets a writable row, cloning it first if a pin shares it.
+    /// </summary>
+    public TerminalCell[] GetRowForWrite(int y)
+    {
+        if (_rowEpochs[y] != _pinEpoch)
+        {
+            if (_rowTableShared)
+            {
+                _rows = (TerminalCell[][])_rows.Clone();
+                _rowTableShared = false;
+            }
+
+            _rows[y] = (TerminalCell[])_rows[y].Clone();
+            _rowEpochs[y] = _pinEpoch;
+        }
+
+        return _rows[y];
+    }
+
+    /// <summary>
+    /// Returns the current row table and marks it and all of its rows as shared.
+    /// </summary>
+    /// <remarks>
+    /// The returned rows are never mutated afterwards; callers must treat them as read-only.
+    /// </remarks>
+    public TerminalCell[][] Pin()
+    {
+        _pinEpoch++;
+        _rowTableShared = true;
+        return _rows;
+    }
+
+    /// <summary>
+    /// Copies the buffer into a new rectangular array.
+    /// </summary>
+    public TerminalCell[,] ToArray()
+    {
+        var copy = new TerminalCell[Height, Width];
+        for (int y = 0; y < Height; y++)
+        {
+            var row = _rows[y];
+            for (int x = 0; x < Width; x++)
+                copy[y, x] = row[x];
+        }
+        return copy;
+    }
+
+    /// <summary>
+    /// Copies a pinned row table into a new rectangular array.
+    /// </summary>
+    public static TerminalCell[,] ToArray(TerminalCell[][] rows, int width)
+    {
+        var copy = new TerminalCell[rows.Length, width];
+        for (int y = 0; y < rows.Length; y++)
+        {
+            var row = rows[y];
+            for (int x = 0; x < width; x++)
+                copy[y, x] = row[x];
+        }
+        return copy;
+    }
+}
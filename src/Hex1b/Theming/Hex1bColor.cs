@@ -27,7 +27,7 @@ public enum Hex1bColorKind : byte
 /// standard ANSI colors (e.g., SGR 34 = blue) remain palette-relative
 /// instead of being converted to fixed RGB values.
 /// </remarks>
-public readonly struct Hex1bColor
+public readonly struct Hex1bColor : IEquatable<Hex1bColor>
 {
     public byte R { get; }
     public byte G { get; }
@@ -146,4 +146,19 @@ public readonly struct Hex1bColor
     /// Gets the ANSI escape code for setting this as the underline color (SGR 58).
     /// </summary>
     public string ToUnderlineColorAnsi() => IsDefault ? "\x1b[59m" : $"\x1b[58;2;{R};{G};{B}m";
+
+    // Field-wise, as the default struct equality is, but without boxing: cells compare
+    // their nullable colors through EqualityComparer, which only avoids boxing for
+    // IEquatable types
+
+    /// <inheritdoc />
+    public bool Equals(Hex1bColor other)
+        => R == other.R && G == other.G && B == other.B
+            && IsDefault == other.IsDefault && Kind == other.Kind && AnsiIndex == other.AnsiIndex;
+
+    /// <inheritdoc />
+    public override bool Equals(object? obj) => obj is Hex1bColor other && Equals(other);
+
+    /// <inheritdoc />
+    public override int GetHashCode() => HashCode.Combine(R, G, B, IsDefault, Kind, AnsiIndex);
 }
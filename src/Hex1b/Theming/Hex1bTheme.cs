@@ -1,11 +1,26 @@
+using System.Runtime.CompilerServices;
+
 namespace Hex1b.Theming;
 
 /// <summary>
 /// A theme containing values for various UI elements.
 /// </summary>
+/// <remarks>
+/// Values are kept in one typed table per element type, indexed by the slot each
+/// <see cref="Hex1bThemeElement{T}"/> gets when it is created. Locking a theme compiles
+/// every element's value, with fallbacks and defaults already applied, so <see cref="Get{T}"/>
+/// on a locked theme is a single array read.
+/// </remarks>
 public class Hex1bTheme
 {
-    private readonly Dictionary<string, object> _values = new();
+    // Values set on this theme: a ThemeValues<T> per element type id, indexed by name slot
+    private object?[] _values = [];
+
+    // Locked themes only: a T[] of resolved values per element type id, indexed by slot.
+    // Tables are replaced, never modified, so readers on other threads need no lock.
+    private object?[] _compiled = [];
+    private readonly object _compileLock = new();
+
     private readonly string _name;
     private bool _isLocked;
 
@@ -26,7 +41,11 @@ public class Hex1bTheme
     /// </summary>
     public Hex1bTheme Lock()
     {
-        _isLocked = true;
+        if (!_isLocked)
+        {
+            _isLocked = true;
+            ThemeSlots.CompileAll(this);
+        }
         return this;
     }
 
@@ -35,15 +54,25 @@ public class Hex1bTheme
     /// </summary>
     public T Get<T>(Hex1bThemeElement<T> element)
     {
-        if (_values.TryGetValue(element.Name, out var value) && value is T typedValue)
-        {
-            return typedValue;
-        }
-        if (element.Fallback != null)
+        if (_isLocked)
         {
-            return Get(element.Fallback);
+            var compiled = Volatile.Read(ref _compiled);
+            var typeId = ThemeSlots<T>.TypeId;
+            if ((uint)typeId < (uint)compiled.Length
+                && compiled[typeId] is { } entry)
+            {
+                // Only Compile<T> stores at this type's id, so the cast can skip the type check
+                var table = Unsafe.As<T[]>(entry);
+                if ((uint)element.Slot < (uint)table.Length)
+                {
+                    return table[element.Slot];
+                }
+            }
+
+            // Element created after the theme was locked
+            Compile<T>();
         }
-        return element.DefaultValue();
+        return Resolve(element);
     }
 
     /// <summary>
@@ -57,7 +86,15 @@ public class Hex1bTheme
             throw new InvalidOperationException(
                 $"Cannot modify locked theme '{_name}'. Use Clone() to create a modifiable copy first.");
         }
-        _values[element.Name] = value!;
+
+        var typeId = ThemeSlots<T>.TypeId;
+        if (typeId >= _values.Length)
+        {
+            Array.Resize(ref _values, typeId + 1);
+        }
+        var values = (ThemeValues<T>?)_values[typeId] ?? new ThemeValues<T>();
+        _values[typeId] = values;
+        values.Set(element.NameSlot, value);
         return this;
     }
 
@@ -67,10 +104,109 @@ public class Hex1bTheme
     public Hex1bTheme Clone(string? newName = null)
     {
         var clone = new Hex1bTheme(newName ?? _name);
-        foreach (var kvp in _values)
+        clone._values = new object?[_values.Length];
+        for (int i = 0; i < _values.Length; i++)
         {
-            clone._values[kvp.Key] = kvp.Value;
+            clone._values[i] = (_values[i] as IThemeValues)?.Clone();
         }
         return clone;
     }
+
+    /// <summary>
+    /// Resolves an element through the values set on this theme, then its fallbacks,
+    /// then the last default in the chain.
+    /// </summary>
+    private T Resolve<T>(Hex1bThemeElement<T> element)
+    {
+        var values = ThemeSlots<T>.TypeId < _values.Length ? (ThemeValues<T>?)_values[ThemeSlots<T>.TypeId] : null;
+        for (var current = element; ; current = current.Fallback)
+        {
+            if (values != null && values.TryGet(current.NameSlot, out var value))
+            {
+                return value;
+            }
+            if (current.Fallback == null)
+            {
+                return current.DefaultValue();
+            }
+        }
+    }
+
+    /// <summary>
+    /// Builds the resolved table for every element of type <typeparamref name="T"/>
+    /// registered so far. Locked themes only.
+    /// </summary>
+    internal void Compile<T>()
+    {
+        var elements = ThemeSlots<T>.Elements;
+        var table = new T[elements.Length];
+        for (int i = 0; i < table.Length; i++)
+        {
+            table[i] = Resolve(elements[i]);
+        }
+
+        lock (_compileLock)
+        {
+            var typeId = ThemeSlots<T>.TypeId;
+            var compiled = _compiled;
+            if (typeId >= compiled.Length)
+            {
+                Array.Resize(ref compiled, typeId + 1);
+            }
+            else if (compiled[typeId] is T[] existing && existing.Length >= table.Length)
+            {
+                return;
+            }
+            else
+            {
+                compiled = (object?[])compiled.Clone();
+            }
+            compiled[typeId] = table;
+            Volatile.Write(ref _compiled, compiled);
+        }
+    }
+
+    private interface IThemeValues
+    {
+        IThemeValues Clone();
+    }
+
+    /// <summary>
+    /// Values set for elements of one type, indexed by name slot.
+    /// </summary>
+    private sealed class ThemeValues<T> : IThemeValues
+    {
+        private T[] _values = [];
+        private bool[] _isSet = [];
+
+        public bool TryGet(int nameSlot, out T value)
+        {
+            // A null value counts as not set, so the fallback applies
+            if (nameSlot < _isSet.Length && _isSet[nameSlot] && _values[nameSlot] is { } set)
+            {
+                value = set;
+                return true;
+            }
+            value = default!;
+            return false;
+        }
+
+        public void Set(int nameSlot, T value)
+        {
+            if (nameSlot >= _values.Length)
+            {
+                var length = Math.Max(nameSlot + 1, _values.Length * 2);
+                Array.Resize(ref _values, length);
+                Array.Resize(ref _isSet, length);
+            }
+            _values[nameSlot] = value;
+            _isSet[nameSlot] = true;
+        }
+
+        public IThemeValues Clone() => new ThemeValues<T>
+        {
+            _values = (T[])_values.Clone(),
+            _isSet = (bool[])_isSet.Clone()
+        };
+    }
 }
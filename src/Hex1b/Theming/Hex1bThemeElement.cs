@@ -14,12 +14,34 @@ public class Hex1bThemeElement<T>
     /// </summary>
     public Hex1bThemeElement<T>? Fallback { get; }
 
+    /// <summary>
+    /// Dense index among the elements of type <typeparamref name="T"/>, into a locked
+    /// theme's resolved values.
+    /// </summary>
+    internal int Slot { get; }
+
+    /// <summary>
+    /// Index shared by the elements of type <typeparamref name="T"/> with this name, into
+    /// a theme's set values.
+    /// </summary>
+    internal int NameSlot { get; }
+
+    /// <summary>
+    /// Creates a theme element.
+    /// </summary>
+    /// <remarks>
+    /// Every distinct element reserves a slot in process-wide tables for the lifetime of the
+    /// process, so declare elements once, typically as <c>static readonly</c> fields. Creating
+    /// an element again with the same name, fallback and default delegate reuses the slot,
+    /// but a new default delegate each time (e.g. a lambda capturing a local) does not.
+    /// </remarks>
     public Hex1bThemeElement(string name, Func<T> defaultValue,
                              Hex1bThemeElement<T>? fallback = null)
     {
         Name = name;
         DefaultValue = defaultValue;
         Fallback = fallback;
+        (Slot, NameSlot) = ThemeSlots<T>.Register(this);
     }
 
     public override string ToString() => Name;
@@ -0,0 +1,108 @@
+namespace Hex1b.Theming;
+
+/// <summary>
+/// Numbers theme element types, so a theme can keep one typed table per type.
+/// </summary>
+internal static class ThemeSlots
+{
+    private static readonly object s_lock = new();
+    private static Action<Hex1bTheme>[] s_compilers = [];
+
+    /// <summary>
+    /// Registers an element type and returns its type id.
+    /// </summary>
+    public static int RegisterType(Action<Hex1bTheme> compile)
+    {
+        lock (s_lock)
+        {
+            var compilers = new Action<Hex1bTheme>[s_compilers.Length + 1];
+            s_compilers.CopyTo(compilers, 0);
+            compilers[^1] = compile;
+            Volatile.Write(ref s_compilers, compilers);
+            return compilers.Length - 1;
+        }
+    }
+
+    /// <summary>
+    /// Compiles the table of every element type registered so far.
+    /// </summary>
+    public static void CompileAll(Hex1bTheme theme)
+    {
+        foreach (var compile in Volatile.Read(ref s_compilers))
+        {
+            compile(theme);
+        }
+    }
+}
+
+/// <summary>
+/// Assigns every <see cref="Hex1bThemeElement{T}"/> of one value type a dense slot when it
+/// is created, so themes can store and resolve values by array index instead of by name.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Each element gets a <see cref="Hex1bThemeElement{T}.Slot"/>, used for resolved values
+/// since elements can differ in fallback and default. Elements that share a name share a
+/// <see cref="Hex1bThemeElement{T}.NameSlot"/>, used for values set on a theme, because
+/// setting one of them has always set them all.
+/// </para>
+/// <para>
+/// Slots are never released. An element with the same name, fallback and default delegate
+/// as one already registered resolves to the same value in every theme, so it reuses that
+/// element's slot; recreating an element from the same definition does not grow the tables.
+/// </para>
+/// </remarks>
+internal static class ThemeSlots<T>
+{
+    public static readonly int TypeId = ThemeSlots.RegisterType(theme => theme.Compile<T>());
+
+    private static readonly object s_lock = new();
+    private static readonly Dictionary<string, int> s_nameSlots = new();
+    private static readonly Dictionary<(string Name, int FallbackSlot, Func<T> DefaultValue), int> s_slots = new();
+    private static Hex1bThemeElement<T>[] s_elements = new Hex1bThemeElement<T>[16];
+    private static int s_count;
+
+    public static (int Slot, int NameSlot) Register(Hex1bThemeElement<T> element)
+    {
+        lock (s_lock)
+        {
+            if (!s_nameSlots.TryGetValue(element.Name, out var nameSlot))
+            {
+                nameSlot = s_nameSlots.Count;
+                s_nameSlots.Add(element.Name, nameSlot);
+            }
+
+            var key = (element.Name, element.Fallback?.Slot ?? -1, element.DefaultValue);
+            if (s_slots.TryGetValue(key, out var existing))
+            {
+                return (existing, nameSlot);
+            }
+
+            var slot = s_count;
+            s_slots.Add(key, slot);
+            var elements = s_elements;
+            if (slot == elements.Length)
+            {
+                Array.Resize(ref elements, elements.Length * 2);
+            }
+            elements[slot] = element;
+
+            // Publish the array before the count so readers never see a slot without its element
+            Volatile.Write(ref s_elements, elements);
+            Volatile.Write(ref s_count, slot + 1);
+            return (slot, nameSlot);
+        }
+    }
+
+    /// <summary>
+    /// The first element registered for each slot, indexed by slot.
+    /// </summary>
+    public static ReadOnlySpan<Hex1bThemeElement<T>> Elements
+    {
+        get
+        {
+            var count = Volatile.Read(ref s_count);
+            return Volatile.Read(ref s_elements).AsSpan(0, count);
+        }
+    }
+}
@@ -85,4 +85,23 @@ public static class TreeTheme
         new($"{nameof(TreeTheme)}.{nameof(CheckboxIndeterminate)}", () => " ▤  ");
 
     #endregion
+
+    #region Status
+
+    /// <summary>
+    /// Text shown in place of the items while a data source loads them.
+    /// </summary>
+    public static readonly Hex1bThemeElement<string> LoadingText =
+        new($"{nameof(TreeTheme)}.{nameof(LoadingText)}", () => "Loading...");
+
+    /// <summary>
+    /// Text shown, followed by the error message, when a data source fails to load the items.
+    /// </summary>
+    public static readonly Hex1bThemeElement<string> LoadFailedText =
+        new($"{nameof(TreeTheme)}.{nameof(LoadFailedText)}", () => "Failed to load");
+
+    public static readonly Hex1bThemeElement<Hex1bColor> StatusForegroundColor =
+        new($"{nameof(TreeTheme)}.{nameof(StatusForegroundColor)}", () => Hex1bColor.Gray);
+
+    #endregion
 }
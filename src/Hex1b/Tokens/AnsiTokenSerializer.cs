@@ -67,6 +67,10 @@ public static class AnsiTokenSerializer
             UnrecognizedSequenceToken unrec => unrec.Sequence,
             KgpToken kgp => SerializeKgp(kgp),
             DeviceStatusReportToken dsr => $"\x1b[{dsr.Type}n",
+            TabClearToken tbc => tbc.Mode == 0 ? "\x1b[g" : $"\x1b[{tbc.Mode}g",
+            DecscaToken sca => $"\x1b[{sca.Mode}\"q",
+            DecalnToken => "\x1b#8",
+            RisToken => "\x1bc",
             _ => throw new ArgumentException($"Unknown token type: {token.GetType().Name}", nameof(token))
         };
     }
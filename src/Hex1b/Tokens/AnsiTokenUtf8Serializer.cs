@@ -360,6 +360,31 @@ public static class AnsiTokenUtf8Serializer
                 WriteByte(writer, (byte)'n');
                 return;
 
+            case TabClearToken tbc:
+                WriteEscLeftBracket(writer);
+                if (tbc.Mode != 0)
+                    WriteInt(writer, tbc.Mode);
+                WriteByte(writer, (byte)'g');
+                return;
+
+            case DecscaToken sca:
+                WriteEscLeftBracket(writer);
+                WriteInt(writer, sca.Mode);
+                WriteByte(writer, (byte)'"');
+                WriteByte(writer, (byte)'q');
+                return;
+
+            case DecalnToken:
+                WriteByte(writer, 0x1b);
+                WriteByte(writer, (byte)'#');
+                WriteByte(writer, (byte)'8');
+                return;
+
+            case RisToken:
+                WriteByte(writer, 0x1b);
+                WriteByte(writer, (byte)'c');
+                return;
+
             default:
                 throw new ArgumentException($"Unknown token type: {token.GetType().Name}", nameof(token));
         }
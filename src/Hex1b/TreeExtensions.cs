@@ -1,3 +1,4 @@
+using Hex1b.Data;
 using Hex1b.Widgets;
 
 namespace Hex1b;
@@ -102,6 +103,33 @@ public static class TreeExtensions
         return new TreeWidget(treeItems);
     }
 
+    /// <summary>
+    /// Creates a virtualized Tree bound to an <see cref="ITreeDataSource{T}"/>.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Children are requested from the data source the first time an item is expanded,
+    /// and only the rows in and near the viewport get item nodes, so expanding, collapsing
+    /// and scrolling cost the same for a million loaded items as for a hundred. Multi-select
+    /// is not supported, and expanding or collapsing an item raises no per-item
+    /// <c>OnExpanded</c>/<c>OnCollapsed</c> handlers, since the items are not widgets.
+    /// </para>
+    /// </remarks>
+    /// <example>
+    /// <code>
+    /// var source = new TreeDataSource&lt;DirectoryInfo&gt;(
+    ///     [new DirectoryInfo("/")],
+    ///     dir => dir.GetDirectories(),
+    ///     dir => dir.Name);
+    /// context.Tree(source)
+    /// </code>
+    /// </example>
+    public static TreeWidget Tree<TParent, T>(
+        this WidgetContext<TParent> context,
+        ITreeDataSource<T> dataSource)
+        where TParent : Hex1bWidget
+        => new([]) { DataSource = new TreeRowSource<T>(dataSource) };
+
     private static IReadOnlyList<TreeItemWidget> BuildTreeItems<T>(
         IEnumerable<T> items,
         Func<T, string> labelSelector,
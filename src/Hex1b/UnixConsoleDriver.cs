@@ -54,6 +54,19 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
     // poll() constants
     private const short POLLIN = 0x0001;
     
+    // Output batching: Write copies into pinned chunks and Flush hands them all to one
+    // writev(). IOV_MAX is at least 1024 on Linux and macOS.
+    private const int OutputChunkSize = 16 * 1024;
+    private const int MaxFreeOutputChunks = 16;
+    private const int MaxIovecsPerCall = 1024;
+    private const int MaxStackIovecs = 64;
+    
+    private readonly object _outputLock = new();
+    private readonly List<byte[]> _outputChunks = new();
+    private readonly Stack<byte[]> _freeOutputChunks = new();
+    private int _lastChunkLength;
+    private long _writeCalls;
+    
     private byte[]? _originalTermios;
     private bool _inRawMode;
     private PosixSignalRegistration? _sigwinchRegistration;
@@ -236,25 +249,24 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
     
     public void Write(ReadOnlySpan<byte> data)
     {
-        unsafe
+        // Held until Flush so a frame's pieces (frame bytes, cursor, KGP payloads, mode
+        // changes) leave in one syscall instead of one small packet each.
+        lock (_outputLock)
         {
-            fixed (byte* ptr = data)
+            while (!data.IsEmpty)
             {
-                var remaining = data.Length;
-                var offset = 0;
-                while (remaining > 0)
+                if (_outputChunks.Count == 0 || _lastChunkLength == OutputChunkSize)
                 {
-                    var written = write(STDOUT_FILENO, ptr + offset, (nuint)remaining);
-                    if (written < 0)
-                    {
-                        var errno = Marshal.GetLastPInvokeError();
-                        if (errno == 4) // EINTR
-                            continue;
-                        throw new InvalidOperationException($"write() failed with errno {errno}");
-                    }
-                    offset += (int)written;
-                    remaining -= (int)written;
+                    _outputChunks.Add(_freeOutputChunks.TryPop(out var chunk)
+                        ? chunk
+                        : GC.AllocateUninitializedArray<byte>(OutputChunkSize, pinned: true));
+                    _lastChunkLength = 0;
                 }
+                
+                var count = Math.Min(data.Length, OutputChunkSize - _lastChunkLength);
+                data[..count].CopyTo(_outputChunks[^1].AsSpan(_lastChunkLength));
+                _lastChunkLength += count;
+                data = data[count..];
             }
         }
     }
@@ -265,6 +277,74 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
         // which can cause timing issues with programs like tmux that expect immediate output.
         // The write() syscall already handles buffering at the kernel level.
         // tcdrain(STDOUT_FILENO);
+        lock (_outputLock)
+        {
+            if (_outputChunks.Count == 0)
+                return;
+            
+            try
+            {
+                WriteOutputChunks();
+            }
+            finally
+            {
+                foreach (var chunk in _outputChunks)
+                {
+                    if (_freeOutputChunks.Count < MaxFreeOutputChunks)
+                        _freeOutputChunks.Push(chunk);
+                }
+                _outputChunks.Clear();
+                _lastChunkLength = 0;
+            }
+        }
+    }
+    
+    public long WriteCalls => Interlocked.Read(ref _writeCalls);
+    
+    private unsafe void WriteOutputChunks()
+    {
+        var chunkCount = _outputChunks.Count;
+        Span<IoVec> iovecs = chunkCount <= MaxStackIovecs
+            ? stackalloc IoVec[chunkCount]
+            : new IoVec[chunkCount];
+        
+        // The chunks live on the pinned object heap, so their addresses are stable
+        for (int i = 0; i < chunkCount; i++)
+        {
+            iovecs[i].Base = (byte*)Marshal.UnsafeAddrOfPinnedArrayElement(_outputChunks[i], 0);
+            iovecs[i].Length = (nuint)(i == chunkCount - 1 ? _lastChunkLength : OutputChunkSize);
+        }
+        
+        fixed (IoVec* first = iovecs)
+        {
+            var current = first;
+            var remaining = chunkCount;
+            while (remaining > 0)
+            {
+                var written = writev(STDOUT_FILENO, current, Math.Min(remaining, MaxIovecsPerCall));
+                Interlocked.Increment(ref _writeCalls);
+                if (written < 0)
+                {
+                    var errno = Marshal.GetLastPInvokeError();
+                    if (errno == 4) // EINTR
+                        continue;
+                    throw new InvalidOperationException($"writev() failed with errno {errno}");
+                }
+                
+                // Skip the vectors that were written in full and trim a partially written one
+                while (remaining > 0 && (nuint)written >= current->Length)
+                {
+                    written -= (nint)current->Length;
+                    current++;
+                    remaining--;
+                }
+                if (remaining > 0)
+                {
+                    current->Base += written;
+                    current->Length -= (nuint)written;
+                }
+            }
+        }
     }
     
     public void DrainInput()
@@ -306,6 +386,15 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
         if (_disposed) return;
         _disposed = true;
         
+        try
+        {
+            Flush();
+        }
+        catch (InvalidOperationException)
+        {
+            // stdout is gone; nothing left to deliver it to
+        }
+        
         ExitRawMode();
         _sigwinchRegistration?.Dispose();
     }
@@ -328,7 +417,14 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
     private static extern unsafe nint read(int fd, byte* buf, nuint count);
     
     [DllImport("libc", SetLastError = true)]
-    private static extern unsafe nint write(int fd, byte* buf, nuint count);
+    private static extern unsafe nint writev(int fd, IoVec* iov, int iovcnt);
+    
+    [StructLayout(LayoutKind.Sequential)]
+    private unsafe struct IoVec
+    {
+        public byte* Base;
+        public nuint Length;
+    }
     
     // P/Invoke for poll()
     [StructLayout(LayoutKind.Sequential)]
@@ -2,6 +2,30 @@ using System.Runtime.InteropServices;
 
 namespace Hex1b;
 
+/// <summary>
+/// How <see cref="UnixPtyHandle"/> starts its child process.
+/// </summary>
+internal enum UnixPtySpawnMode
+{
+    /// <summary>
+    /// Use <see cref="PosixSpawn"/> where the native library supports it, otherwise <see cref="ForkPty"/>.
+    /// A failed <c>posix_spawn</c> is retried with <see cref="ForkPty"/>, so a missing executable
+    /// still starts a child that exits with 127.
+    /// </summary>
+    Auto,
+
+    /// <summary>
+    /// <c>posix_spawn</c> with the PTY opened in the parent. Start-up cost doesn't grow with the
+    /// parent's heap, and the child gets exactly the environment passed to it. Linux only.
+    /// </summary>
+    PosixSpawn,
+
+    /// <summary>
+    /// <c>forkpty</c>. The child inherits the parent's environment.
+    /// </summary>
+    ForkPty,
+}
+
 /// <summary>
 /// Unix (Linux/macOS) PTY implementation using native library.
 /// Uses proper setsid/TIOCSCTTY for controlling terminal setup,
@@ -9,11 +33,25 @@ namespace Hex1b;
 /// </summary>
 internal sealed partial class UnixPtyHandle : IPtyHandle
 {
+    // Large enough that a burst of output is usually read in one native call
+    private const int ReadBufferSize = 64 * 1024;
+
+    private readonly UnixPtySpawnMode _spawnMode;
     private int _masterFd = -1;
     private int _childPid = -1;
+    private Task<int>? _exitTask;
     private bool _disposed;
-    private readonly byte[] _readBuffer = new byte[4096];
-    private readonly byte[] _readFds = new byte[128];
+    private readonly byte[] _readBuffer = GC.AllocateUninitializedArray<byte>(ReadBufferSize, pinned: true);
+
+    // Interrupts a pending read on cancellation, child exit or disposal
+    private readonly object _wakeLock = new();
+    private int _wakeReadFd = -1;
+    private int _wakeWriteFd = -1;
+
+    public UnixPtyHandle(UnixPtySpawnMode spawnMode = UnixPtySpawnMode.Auto)
+    {
+        _spawnMode = spawnMode;
+    }
     
     public int ProcessId => _childPid;
     
@@ -36,8 +74,97 @@ internal sealed partial class UnixPtyHandle : IPtyHandle
                 "libhex1binterop.dylib (macOS) is in the application directory or a standard library path.");
         }
         
-        string resolvedPath = ResolveExecutablePath(fileName);
+        Spawn(fileName, arguments, workingDirectory, environment, width, height);
         
+        // Small delay to let child process initialize
+        await Task.Delay(50, ct);
+    }
+    
+    /// <summary>
+    /// Starts the child attached to a new PTY, without the settle delay of <see cref="StartAsync"/>.
+    /// </summary>
+    internal void Spawn(
+        string fileName,
+        string[] arguments,
+        string? workingDirectory,
+        Dictionary<string, string> environment,
+        int width,
+        int height)
+    {
+        string resolvedPath = ResolveExecutablePath(fileName);
+
+        if (_spawnMode == UnixPtySpawnMode.ForkPty ||
+            !TrySpawnPty(resolvedPath, arguments, workingDirectory, environment, width, height))
+        {
+            ForkPty(resolvedPath, arguments, workingDirectory, environment, width, height);
+        }
+
+        // Null when the native library can't notify exits; we poll instead
+        _exitTask = ChildExitWatcher.Watch(_childPid);
+
+        _ = pty_set_nonblocking(_masterFd);
+        if (pty_wake_pipe(out _wakeReadFd, out _wakeWriteFd) < 0)
+        {
+            _wakeReadFd = _wakeWriteFd = -1;
+        }
+        _exitTask?.ContinueWith(static (_, state) => ((UnixPtyHandle)state!).Wake(), this, TaskScheduler.Default);
+    }
+
+    private bool TrySpawnPty(
+        string resolvedPath,
+        string[] arguments,
+        string? workingDirectory,
+        Dictionary<string, string> environment,
+        int width,
+        int height)
+    {
+        // Without arguments, start a login shell like the forkpty path: argv[0] is "-name"
+        var argv = new string?[arguments.Length + 2];
+        argv[0] = arguments.Length > 0 ? resolvedPath : "-" + Path.GetFileName(resolvedPath);
+        arguments.CopyTo(argv, 1);
+
+        var envp = new string?[environment.Count + 1];
+        var i = 0;
+        foreach (var (key, value) in environment)
+        {
+            envp[i++] = $"{key}={value}";
+        }
+
+        // forkpty treats a missing working directory as non-fatal; posix_spawn would fail
+        var cwd = workingDirectory is not null && Directory.Exists(workingDirectory) ? workingDirectory : null;
+
+        int result;
+        try
+        {
+            result = pty_spawnpty(resolvedPath, argv, envp, cwd, width, height, out _masterFd, out _childPid);
+        }
+        catch (EntryPointNotFoundException) when (_spawnMode == UnixPtySpawnMode.Auto)
+        {
+            // Native library predates hex1b_spawnpty
+            return false;
+        }
+
+        if (result == 0)
+            return true;
+
+        // posix_spawn reports a failed exec (e.g. a missing executable) as an error, where forkpty
+        // starts a child that exits with 127. Auto retries with forkpty so callers keep seeing
+        // that exit code, whichever path is available.
+        var errno = Marshal.GetLastPInvokeError();
+        if (_spawnMode == UnixPtySpawnMode.Auto)
+            return false;
+
+        throw new InvalidOperationException($"pty_spawnpty failed with error: {errno}");
+    }
+
+    private void ForkPty(
+        string resolvedPath,
+        string[] arguments,
+        string? workingDirectory,
+        Dictionary<string, string> environment,
+        int width,
+        int height)
+    {
         // The native pty_forkpty functions inherit the parent's environment.
         // We need to temporarily set HEX1B_NESTING_LEVEL so the child inherits the correct value,
         // then restore the original value after fork.
@@ -105,9 +232,6 @@ internal sealed partial class UnixPtyHandle : IPtyHandle
             // Restore the original nesting level in the parent process
             System.Environment.SetEnvironmentVariable(nestingLevelKey, originalNestingLevel);
         }
-        
-        // Small delay to let child process initialize
-        await Task.Delay(50, ct);
     }
     
     private static string ResolveExecutablePath(string fileName)
@@ -146,99 +270,83 @@ internal sealed partial class UnixPtyHandle : IPtyHandle
     {
         if (_masterFd < 0 || _disposed)
             return ReadOnlyMemory<byte>.Empty;
+
+        // Output that's already waiting completes synchronously, without a thread pool hop.
+        // That also tells the terminal the child is writing faster than it is being consumed.
+        var available = ReadAvailable();
+        if (!available.IsEmpty)
+            return available;
         
         try
         {
-            return await Task.Run(() =>
-            {
-                while (!ct.IsCancellationRequested)
-                {
-                    Array.Clear(_readFds);
-                    FD_SET(_masterFd, _readFds);
-                    
-                    int result = select(_masterFd + 1, _readFds, IntPtr.Zero, IntPtr.Zero, 100);
-                    
-                    if (result < 0)
-                    {
-                        int errno = Marshal.GetLastPInvokeError();
-                        if (errno == 4) continue; // EINTR
-                        return ReadOnlyMemory<byte>.Empty;
-                    }
-                    
-                    if (result == 0)
-                    {
-                        if (!IsChildRunning(_childPid))
-                            return ReadOnlyMemory<byte>.Empty;
-                        continue;
-                    }
-                    
-                    if (FD_ISSET(_masterFd, _readFds))
-                    {
-                        nint bytesRead = read(_masterFd, _readBuffer, (nuint)_readBuffer.Length);
-                        if (bytesRead <= 0)
-                            return ReadOnlyMemory<byte>.Empty;
-                        
-                        var resultBuf = new byte[bytesRead];
-                        Array.Copy(_readBuffer, resultBuf, (int)bytesRead);
-                        
-                        return new ReadOnlyMemory<byte>(resultBuf);
-                    }
-                }
-                return ReadOnlyMemory<byte>.Empty;
-            }, ct);
+            return await Task.Run(() => ReadBurst(ct), ct);
         }
         catch (OperationCanceledException)
         {
             return ReadOnlyMemory<byte>.Empty;
         }
     }
-    
-    public ValueTask WriteAsync(ReadOnlyMemory<byte> data, CancellationToken ct)
+
+    private unsafe ReadOnlyMemory<byte> ReadAvailable()
     {
-        if (_masterFd < 0 || _disposed || data.IsEmpty)
-            return ValueTask.CompletedTask;
-        
-        try
+        fixed (byte* buffer = _readBuffer)
         {
-            var buffer = data.ToArray();
-            nint remaining = buffer.Length;
-            nint offset = 0;
-            
-            while (remaining > 0)
-            {
-                nint written = write(_masterFd, buffer, offset, remaining);
-                if (written < 0)
-                {
-                    int errno = Marshal.GetLastPInvokeError();
-                    if (errno == 4) continue; // EINTR
-                    break;
-                }
-                offset += written;
-                remaining -= written;
-            }
+            nint bytesRead = pty_read(_masterFd, -1, buffer, (nuint)_readBuffer.Length, 0);
+            return bytesRead > 0
+                ? _readBuffer.AsSpan(0, (int)bytesRead).ToArray()
+                : ReadOnlyMemory<byte>.Empty;
         }
-        catch
+    }
+
+    private unsafe ReadOnlyMemory<byte> ReadBurst(CancellationToken ct)
+    {
+        int masterFd = _masterFd;
+        int wakeFd = _wakeReadFd;
+
+        // With a wake pipe and exit notification nothing needs a periodic tick
+        int idleTimeoutMs = wakeFd >= 0 && _exitTask is not null ? -1 : 100;
+
+        using var registration = ct.UnsafeRegister(static state => ((UnixPtyHandle)state!).Wake(), this);
+        fixed (byte* buffer = _readBuffer)
         {
-            // Write error - ignore
+            while (!ct.IsCancellationRequested && !_disposed)
+            {
+                // Once the child has gone, drain what's left without waiting
+                bool childRunning = IsChildRunning();
+                nint bytesRead = pty_read(masterFd, wakeFd, buffer, (nuint)_readBuffer.Length, childRunning ? idleTimeoutMs : 0);
+
+                if (bytesRead > 0)
+                    return _readBuffer.AsSpan(0, (int)bytesRead).ToArray();
+
+                if (bytesRead < 0 || !childRunning)
+                    return ReadOnlyMemory<byte>.Empty;
+            }
         }
-        
-        return ValueTask.CompletedTask;
+        return ReadOnlyMemory<byte>.Empty;
     }
-    
-    private static void FD_SET(int fd, byte[] fdset)
+
+    private unsafe void Wake()
     {
-        int index = fd / 8;
-        int bit = fd % 8;
-        if (index < fdset.Length)
-            fdset[index] |= (byte)(1 << bit);
+        lock (_wakeLock)
+        {
+            if (_wakeWriteFd < 0)
+                return;
+
+            byte signal = 0;
+            _ = writePtr(_wakeWriteFd, &signal, 1);
+        }
     }
     
-    private static bool FD_ISSET(int fd, byte[] fdset)
+    public unsafe ValueTask WriteAsync(ReadOnlyMemory<byte> data, CancellationToken ct)
     {
-        int index = fd / 8;
-        int bit = fd % 8;
-        if (index >= fdset.Length) return false;
-        return (fdset[index] & (1 << bit)) != 0;
+        if (_masterFd < 0 || _disposed || data.IsEmpty)
+            return ValueTask.CompletedTask;
+        
+        // Errors are ignored, as before: the read side reports a dead PTY
+        using var pin = data.Pin();
+        _ = pty_write(_masterFd, (byte*)pin.Pointer, (nuint)data.Length);
+        
+        return ValueTask.CompletedTask;
     }
     
     public void Resize(int width, int height)
@@ -251,24 +359,32 @@ internal sealed partial class UnixPtyHandle : IPtyHandle
     
     public void Kill(int signal = 15)
     {
-        if (_childPid > 0 && IsChildRunning(_childPid))
+        if (_childPid > 0 && IsChildRunning())
         {
             _ = KillProcess(_childPid, signal);
         }
     }
     
-    private static bool IsChildRunning(int pid)
+    private bool IsChildRunning()
     {
-        return KillProcess(pid, 0) == 0;
+        if (_exitTask is not null)
+            return !_exitTask.IsCompleted;
+
+        return KillProcess(_childPid, 0) == 0;
     }
     
     public async Task<int> WaitForExitAsync(CancellationToken ct)
     {
         if (_childPid <= 0)
             return -1;
+
+        if (_exitTask is not null)
+            return await _exitTask.WaitAsync(ct);
         
-        while (!ct.IsCancellationRequested)
+        // No exit notification: poll, which also reaps the child
+        while (true)
         {
+            ct.ThrowIfCancellationRequested();
             int status;
             int result = pty_wait(_childPid, 100, out status);
             if (result == 0)
@@ -281,8 +397,6 @@ internal sealed partial class UnixPtyHandle : IPtyHandle
             }
             await Task.Delay(10, ct);
         }
-        
-        return -1;
     }
     
     public ValueTask DisposeAsync()
@@ -291,6 +405,18 @@ internal sealed partial class UnixPtyHandle : IPtyHandle
             return ValueTask.CompletedTask;
         
         _disposed = true;
+
+        // Get any reader out of its wait before the descriptors go away
+        Wake();
+        lock (_wakeLock)
+        {
+            if (_wakeWriteFd >= 0)
+            {
+                close(_wakeWriteFd);
+                close(_wakeReadFd);
+                _wakeReadFd = _wakeWriteFd = -1;
+            }
+        }
         
         if (_masterFd >= 0)
         {
@@ -298,16 +424,24 @@ internal sealed partial class UnixPtyHandle : IPtyHandle
             _masterFd = -1;
         }
         
-        if (_childPid > 0 && IsChildRunning(_childPid))
+        if (_childPid > 0 && IsChildRunning())
         {
             _ = KillProcess(_childPid, SIGKILL);
             
-            for (int i = 0; i < 10 && IsChildRunning(_childPid); i++)
+            if (_exitTask is not null)
             {
-                Thread.Sleep(10);
+                // The watcher reaps it
+                _exitTask.Wait(100);
+            }
+            else
+            {
+                for (int i = 0; i < 10 && IsChildRunning(); i++)
+                {
+                    Thread.Sleep(10);
+                }
+                
+                _ = pty_wait(_childPid, 100, out _);
             }
-            
-            _ = pty_wait(_childPid, 100, out _);
         }
         
         return ValueTask.CompletedTask;
@@ -337,45 +471,34 @@ internal sealed partial class UnixPtyHandle : IPtyHandle
         out int masterFd,
         out int childPid);
     
+    [LibraryImport("hex1binterop", EntryPoint = "hex1b_spawnpty", SetLastError = true, StringMarshalling = StringMarshalling.Utf8)]
+    private static partial int pty_spawnpty(
+        string execPath,
+        [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPUTF8Str)] string?[] argv,
+        [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPUTF8Str)] string?[] envp,
+        string? workingDir,
+        int width,
+        int height,
+        out int masterFd,
+        out int childPid);
+    
     [LibraryImport("hex1binterop", EntryPoint = "hex1b_wait", SetLastError = true)]
     private static partial int pty_wait(int pid, int timeoutMs, out int status);
     
     [LibraryImport("hex1binterop", EntryPoint = "hex1b_resize", SetLastError = true)]
     private static partial int pty_resize(int masterFd, int width, int height);
     
-    [LibraryImport("libc", EntryPoint = "select", SetLastError = true)]
-    private static partial int select(int nfds, byte[] readfds, IntPtr writefds, IntPtr exceptfds, ref Timeval timeout);
+    [LibraryImport("hex1binterop", EntryPoint = "hex1b_set_nonblocking", SetLastError = true)]
+    private static partial int pty_set_nonblocking(int fd);
     
-    [StructLayout(LayoutKind.Sequential)]
-    private struct Timeval
-    {
-        public long tv_sec;
-        public long tv_usec;
-    }
-    
-    private static int select(int nfds, byte[] readfds, IntPtr writefds, IntPtr exceptfds, int timeoutMs)
-    {
-        var tv = new Timeval
-        {
-            tv_sec = timeoutMs / 1000,
-            tv_usec = (timeoutMs % 1000) * 1000
-        };
-        return select(nfds, readfds, writefds, exceptfds, ref tv);
-    }
+    [LibraryImport("hex1binterop", EntryPoint = "hex1b_wake_pipe", SetLastError = true)]
+    private static partial int pty_wake_pipe(out int readFd, out int writeFd);
     
-    [LibraryImport("libc", EntryPoint = "read", SetLastError = true)]
-    private static partial nint read(int fd, byte[] buf, nuint count);
+    [LibraryImport("hex1binterop", EntryPoint = "hex1b_pty_read", SetLastError = true)]
+    private static unsafe partial nint pty_read(int masterFd, int wakeFd, byte* buffer, nuint capacity, int timeoutMs);
     
-    private static nint write(int fd, byte[] buf, nint offset, nint count)
-    {
-        unsafe
-        {
-            fixed (byte* ptr = buf)
-            {
-                return writePtr(fd, ptr + offset, (nuint)count);
-            }
-        }
-    }
+    [LibraryImport("hex1binterop", EntryPoint = "hex1b_pty_write", SetLastError = true)]
+    private static unsafe partial nint pty_write(int masterFd, byte* data, nuint length);
     
     [LibraryImport("libc", EntryPoint = "write", SetLastError = true)]
     private static unsafe partial nint writePtr(int fd, byte* buf, nuint count);
@@ -1,3 +1,4 @@
+using System.Buffers;
 using System.Net.WebSockets;
 using System.Text;
 using System.Text.Json;
@@ -12,6 +13,11 @@ namespace Hex1b;
 /// This adapter implements <see cref="IHex1bTerminalPresentationAdapter"/> for
 /// WebSocket connections, allowing Hex1b applications to run in web browsers
 /// through xterm.js or similar terminal emulators.
+/// <para>
+/// By default every output chunk is sent as its own text message. See
+/// <see cref="WebSocketPresentationOptions"/> for batched binary output, compression and
+/// client-acknowledged flow control.
+/// </para>
 /// </remarks>
 public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAdapter
 {
@@ -27,6 +33,17 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
     private int _cellPixelHeight = 20;
     private double _actualCellPixelWidth = 10.0;
     private readonly bool _enableMouse;
+    private readonly WebSocketPresentationOptions _options;
+
+    // Sends are serialized: a WebSocket allows one outstanding send, and the batch is shared
+    private readonly SemaphoreSlim _sendLock = new(1, 1);
+    private readonly ArrayBufferWriter<byte> _batch = new();
+    private CancellationTokenSource? _sendCts;
+    private CancellationToken _sendCtsSource;
+
+    private readonly object _flowLock = new();
+    private long _unacknowledgedBytes;
+    private TaskCompletionSource? _windowOpened;
 
     /// <summary>
     /// Creates a new WebSocket presentation adapter.
@@ -36,11 +53,28 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
     /// <param name="height">Initial terminal height in rows.</param>
     /// <param name="enableMouse">Whether to enable mouse tracking.</param>
     public WebSocketPresentationAdapter(WebSocket webSocket, int width, int height, bool enableMouse = false)
+        : this(webSocket, width, height, new WebSocketPresentationOptions { EnableMouse = enableMouse })
+    {
+    }
+
+    /// <summary>
+    /// Creates a new WebSocket presentation adapter with the given output options.
+    /// </summary>
+    /// <param name="webSocket">The WebSocket connection to use.</param>
+    /// <param name="width">Initial terminal width in columns.</param>
+    /// <param name="height">Initial terminal height in rows.</param>
+    /// <param name="options">How output is sent and flow-controlled.</param>
+    public WebSocketPresentationAdapter(WebSocket webSocket, int width, int height, WebSocketPresentationOptions options)
     {
         _webSocket = webSocket ?? throw new ArgumentNullException(nameof(webSocket));
+        _options = options ?? throw new ArgumentNullException(nameof(options));
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(options.MaxBatchBytes, nameof(options.MaxBatchBytes));
+        if (options.FlowControlWindow is { } window)
+            ArgumentOutOfRangeException.ThrowIfNegativeOrZero(window, nameof(options.FlowControlWindow));
+
         _width = width;
         _height = height;
-        _enableMouse = enableMouse;
+        _enableMouse = options.EnableMouse;
     }
 
     /// <inheritdoc />
@@ -185,12 +219,33 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
         if (_disposed || _webSocket.State != WebSocketState.Open)
             return;
 
+        TryTraceOutput(data);
+
         try
         {
-            TryTraceOutput(data);
-            using var linkedCts = CancellationTokenSource.CreateLinkedTokenSource(ct, _disposeCts.Token);
-            // Use Text message type since terminal output is UTF-8 and JavaScript expects strings
-            await _webSocket.SendAsync(data, WebSocketMessageType.Text, endOfMessage: true, linkedCts.Token);
+            await _sendLock.WaitAsync(ct);
+        }
+        catch (OperationCanceledException)
+        {
+            return;
+        }
+
+        try
+        {
+            // DisposeAsync takes the lock to retire the send token sources
+            if (_disposed)
+                return;
+
+            if (_options.OutputMode == WebSocketOutputMode.Text)
+            {
+                // Text messages, since JavaScript clients in this mode expect strings
+                await SendMessageAsync(data, WebSocketMessageType.Text, ct);
+                return;
+            }
+
+            _batch.Write(data.Span);
+            if (_batch.WrittenCount >= _options.MaxBatchBytes)
+                await SendBatchAsync(ct);
         }
         catch (WebSocketException)
         {
@@ -200,6 +255,107 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
         {
             // Cancelled
         }
+        finally
+        {
+            _sendLock.Release();
+        }
+    }
+
+    /// <summary>
+    /// Records that the client has written <paramref name="bytes"/> bytes of output, reopening
+    /// the flow control window. Called for <c>{"type":"ack"}</c> messages read by
+    /// <see cref="ReadInputAsync"/>; hosts with their own control channel can call it directly.
+    /// </summary>
+    /// <param name="bytes">The number of output bytes the client has processed.</param>
+    public void AcknowledgeOutput(long bytes)
+    {
+        if (bytes <= 0 || _options.FlowControlWindow is not { } window)
+            return;
+
+        lock (_flowLock)
+        {
+            _unacknowledgedBytes = Math.Max(0, _unacknowledgedBytes - bytes);
+            if (_unacknowledgedBytes < window)
+            {
+                _windowOpened?.TrySetResult();
+                _windowOpened = null;
+            }
+        }
+    }
+
+    // Caller holds _sendLock
+    private async ValueTask SendBatchAsync(CancellationToken ct)
+    {
+        if (_batch.WrittenCount == 0)
+            return;
+
+        try
+        {
+            await SendMessageAsync(_batch.WrittenMemory, WebSocketMessageType.Binary, ct);
+        }
+        finally
+        {
+            _batch.ResetWrittenCount();
+        }
+    }
+
+    // Caller holds _sendLock
+    private async ValueTask SendMessageAsync(ReadOnlyMemory<byte> data, WebSocketMessageType messageType, CancellationToken ct)
+    {
+        var token = GetSendToken(ct);
+        await WaitForFlowControlWindowAsync(token);
+
+        var flags = WebSocketMessageFlags.EndOfMessage;
+        if (!_options.CompressOutput || data.Length < _options.CompressionThreshold)
+            flags |= WebSocketMessageFlags.DisableCompression;
+
+        await _webSocket.SendAsync(data, messageType, flags, token);
+
+        if (_options.FlowControlWindow is not null)
+        {
+            lock (_flowLock)
+            {
+                _unacknowledgedBytes += data.Length;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Links the caller's token with disposal. The output pump passes the same token on every
+    /// call, so the linked source is reused instead of allocated per send.
+    /// </summary>
+    private CancellationToken GetSendToken(CancellationToken ct)
+    {
+        if (!ct.CanBeCanceled)
+            return _disposeCts.Token;
+
+        if (_sendCts is null || _sendCtsSource != ct)
+        {
+            _sendCts?.Dispose();
+            _sendCts = CancellationTokenSource.CreateLinkedTokenSource(ct, _disposeCts.Token);
+            _sendCtsSource = ct;
+        }
+        return _sendCts.Token;
+    }
+
+    private async ValueTask WaitForFlowControlWindowAsync(CancellationToken ct)
+    {
+        if (_options.FlowControlWindow is not { } window)
+            return;
+
+        while (true)
+        {
+            Task opened;
+            lock (_flowLock)
+            {
+                if (_unacknowledgedBytes < window)
+                    return;
+
+                _windowOpened ??= new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+                opened = _windowOpened.Task;
+            }
+            await opened.WaitAsync(ct);
+        }
     }
 
     /// <inheritdoc />
@@ -213,45 +369,58 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
         try
         {
             using var linkedCts = CancellationTokenSource.CreateLinkedTokenSource(ct, _disposeCts.Token);
-            var result = await _webSocket.ReceiveAsync(buffer.AsMemory(), linkedCts.Token);
-            
-            if (result.MessageType == WebSocketMessageType.Close)
-            {
-                return ReadOnlyMemory<byte>.Empty;
-            }
-            
-            // Check for resize message (custom protocol)
-            if (result.MessageType == WebSocketMessageType.Text)
+
+            // Control messages (acks, resizes) are consumed here and the loop reads on, so a
+            // long run of them between keystrokes reuses one buffer and one linked token
+            while (true)
             {
-                var text = Encoding.UTF8.GetString(buffer, 0, result.Count);
+                var result = await _webSocket.ReceiveAsync(buffer.AsMemory(), linkedCts.Token);
                 
-                // Handle JSON format: {"type":"resize","cols":80,"rows":24,"cellWidth":8.4,"cellHeight":16}
-                if (text.StartsWith("{") && text.Contains("resize"))
+                if (result.MessageType == WebSocketMessageType.Close)
                 {
-                    if (TryParseJsonResize(text, out var newWidth, out var newHeight, out var cellWidth, out var cellHeight, out var actualCellWidth))
-                    {
-                        Resize(newWidth, newHeight, cellWidth, cellHeight, actualCellWidth);
-                        // Return empty for resize messages - not actual input
-                        return await ReadInputAsync(ct);
-                    }
+                    return ReadOnlyMemory<byte>.Empty;
                 }
                 
-                // Handle legacy format: resize:80,24
-                if (text.StartsWith("resize:"))
+                // Check for resize message (custom protocol)
+                if (result.MessageType == WebSocketMessageType.Text)
                 {
-                    var parts = text[7..].Split(',');
-                    if (parts.Length == 2 && 
-                        int.TryParse(parts[0], out var width) && 
-                        int.TryParse(parts[1], out var height))
+                    var text = Encoding.UTF8.GetString(buffer, 0, result.Count);
+
+                    // Handle flow control acknowledgements: {"type":"ack","bytes":4096}
+                    if (text.StartsWith("{") && TryParseJsonAck(text, out var acknowledged))
+                    {
+                        AcknowledgeOutput(acknowledged);
+                        continue;
+                    }
+                    
+                    // Handle JSON format: {"type":"resize","cols":80,"rows":24,"cellWidth":8.4,"cellHeight":16}
+                    if (text.StartsWith("{") && text.Contains("resize"))
+                    {
+                        if (TryParseJsonResize(text, out var newWidth, out var newHeight, out var cellWidth, out var cellHeight, out var actualCellWidth))
+                        {
+                            Resize(newWidth, newHeight, cellWidth, cellHeight, actualCellWidth);
+                            // Resize messages are not actual input
+                            continue;
+                        }
+                    }
+                    
+                    // Handle legacy format: resize:80,24
+                    if (text.StartsWith("resize:"))
                     {
-                        Resize(width, height);
-                        // Return empty for resize messages - not actual input
-                        return await ReadInputAsync(ct);
+                        var parts = text[7..].Split(',');
+                        if (parts.Length == 2 && 
+                            int.TryParse(parts[0], out var width) && 
+                            int.TryParse(parts[1], out var height))
+                        {
+                            Resize(width, height);
+                            // Resize messages are not actual input
+                            continue;
+                        }
                     }
                 }
+                
+                return buffer.AsMemory(0, result.Count);
             }
-            
-            return buffer.AsMemory(0, result.Count);
         }
         catch (WebSocketException)
         {
@@ -261,13 +430,49 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
         {
             return ReadOnlyMemory<byte>.Empty;
         }
+        catch (ObjectDisposedException)
+        {
+            // Disposed between the check above and linking its token
+            return ReadOnlyMemory<byte>.Empty;
+        }
     }
 
     /// <inheritdoc />
-    public ValueTask FlushAsync(CancellationToken ct = default)
+    /// <remarks>
+    /// In <see cref="WebSocketOutputMode.BatchedBinary"/> mode this sends the output gathered
+    /// since the last flush as one message. Text mode sends each write immediately.
+    /// </remarks>
+    public async ValueTask FlushAsync(CancellationToken ct = default)
     {
-        // WebSocket sends are typically already unbuffered
-        return ValueTask.CompletedTask;
+        if (_options.OutputMode == WebSocketOutputMode.Text || _disposed || _webSocket.State != WebSocketState.Open)
+            return;
+
+        try
+        {
+            await _sendLock.WaitAsync(ct);
+        }
+        catch (OperationCanceledException)
+        {
+            return;
+        }
+
+        try
+        {
+            if (!_disposed)
+                await SendBatchAsync(ct);
+        }
+        catch (WebSocketException)
+        {
+            // Connection closed
+        }
+        catch (OperationCanceledException)
+        {
+            // Cancelled
+        }
+        finally
+        {
+            _sendLock.Release();
+        }
     }
 
     /// <inheritdoc />
@@ -295,8 +500,21 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
 
         Disconnected?.Invoke();
 
+        // Cancels any in-flight send, including output waiting on the flow control window.
+        // Taking the send lock then waits for that send to unwind before its linked token
+        // source is disposed; writers that get the lock afterwards see _disposed and return.
         _disposeCts.Cancel();
-        _disposeCts.Dispose();
+        await _sendLock.WaitAsync();
+        try
+        {
+            _sendCts?.Dispose();
+            _sendCts = null;
+            _disposeCts.Dispose();
+        }
+        finally
+        {
+            _sendLock.Release();
+        }
 
         if (_webSocket.State == WebSocketState.Open)
         {
@@ -311,6 +529,19 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
         }
     }
 
+    /// <summary>
+    /// Attempts to parse a JSON flow control acknowledgement.
+    /// </summary>
+    private static bool TryParseJsonAck(string json, out long bytes)
+    {
+        bytes = 0;
+        if (!System.Text.RegularExpressions.Regex.IsMatch(json, @"""type""\s*:\s*""ack"""))
+            return false;
+
+        var bytesMatch = System.Text.RegularExpressions.Regex.Match(json, @"""bytes""\s*:\s*(\d+)");
+        return bytesMatch.Success && long.TryParse(bytesMatch.Groups[1].Value, out bytes);
+    }
+
     /// <summary>
     /// Attempts to parse a JSON resize message.
     /// </summary>
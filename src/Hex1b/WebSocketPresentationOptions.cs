@@ -0,0 +1,87 @@
+namespace Hex1b;
+
+/// <summary>
+/// How <see cref="WebSocketPresentationAdapter"/> sends terminal output to the client.
+/// </summary>
+public enum WebSocketOutputMode
+{
+    /// <summary>
+    /// Each output chunk is sent as its own text message. Works with clients that pass
+    /// message strings straight to the terminal emulator.
+    /// </summary>
+    Text,
+
+    /// <summary>
+    /// Output is gathered until the terminal flushes a frame (or the batch reaches
+    /// <see cref="WebSocketPresentationOptions.MaxBatchBytes"/>) and sent as one binary message.
+    /// The client must read binary messages, e.g. with <c>binaryType = "arraybuffer"</c>.
+    /// </summary>
+    BatchedBinary,
+}
+
+/// <summary>
+/// Options for configuring a <see cref="WebSocketPresentationAdapter"/>.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The defaults match the adapter's original behavior: one text message per output chunk,
+/// no flow control.
+/// </para>
+/// <example>
+/// <code>
+/// var options = new WebSocketPresentationOptions
+/// {
+///     OutputMode = WebSocketOutputMode.BatchedBinary,
+///     FlowControlWindow = 256 * 1024
+/// };
+/// await using var presentation = new WebSocketPresentationAdapter(webSocket, 80, 24, options);
+/// </code>
+/// </example>
+/// </remarks>
+public sealed class WebSocketPresentationOptions
+{
+    /// <summary>
+    /// Whether to enable mouse tracking. Default is false.
+    /// </summary>
+    public bool EnableMouse { get; set; }
+
+    /// <summary>
+    /// How output is framed on the socket. Default is <see cref="WebSocketOutputMode.Text"/>.
+    /// </summary>
+    public WebSocketOutputMode OutputMode { get; set; } = WebSocketOutputMode.Text;
+
+    /// <summary>
+    /// In <see cref="WebSocketOutputMode.BatchedBinary"/> mode, a batch is sent as soon as it
+    /// holds this many bytes, even if the frame isn't finished. Default is 64 KiB.
+    /// </summary>
+    public int MaxBatchBytes { get; set; } = 64 * 1024;
+
+    /// <summary>
+    /// Whether output messages may be compressed. Default is false.
+    /// </summary>
+    /// <remarks>
+    /// Compression uses the permessage-deflate extension, so it only takes effect when the
+    /// socket was accepted with it, e.g.
+    /// <c>AcceptWebSocketAsync(new WebSocketAcceptContext { DangerousDeflateOptions = new() })</c>.
+    /// When false, output is always sent uncompressed even if the extension was negotiated.
+    /// </remarks>
+    public bool CompressOutput { get; set; }
+
+    /// <summary>
+    /// Messages smaller than this are sent uncompressed when <see cref="CompressOutput"/> is on,
+    /// since deflate doesn't pay for itself on a few escape sequences. Default is 1 KiB.
+    /// </summary>
+    public int CompressionThreshold { get; set; } = 1024;
+
+    /// <summary>
+    /// The most output bytes that may be sent without the client acknowledging them, or null
+    /// to disable flow control. Default is null.
+    /// </summary>
+    /// <remarks>
+    /// When set, the client reports the bytes it has written to its terminal with a text message
+    /// <c>{"type":"ack","bytes":N}</c>. Once the unacknowledged total reaches the window, output
+    /// waits for the next acknowledgement, which holds back the workload instead of queueing
+    /// data for a browser that can't keep up.
+    /// </remarks>
+    public int? FlowControlWindow { get; set; }
+}
@@ -60,6 +60,13 @@ public sealed class ReconcileContext
     /// Only set (non-null) when per-node metrics are enabled.
     /// </summary>
     internal Diagnostics.Hex1bMetrics? Metrics { get; set; }
+
+    /// <summary>
+    /// The app's animation clock. When set, StatePanels advance their animations to its frame
+    /// timestamp and request re-renders through its shared tick instead of
+    /// <see cref="ScheduleTimerCallback"/>.
+    /// </summary>
+    internal Animation.AnimationClock? AnimationClock { get; set; }
     
     /// <summary>
     /// The layout axis of the parent container (if any).
@@ -179,6 +186,7 @@ public sealed class ReconcileContext
         {
             DiagnosticTimingEnabled = DiagnosticTimingEnabled,
             Metrics = Metrics,
+            AnimationClock = AnimationClock,
             _inputOverrides = _inputOverrides
         };
     }
@@ -192,7 +200,7 @@ public sealed class ReconcileContext
         return new ReconcileContext(Parent, FocusRing, CancellationToken, _ancestors.ToList(), axis, InvalidateCallback,
             CaptureInputCallback, ReleaseCaptureCallback, ScheduleTimerCallback, WindowManagerRegistry, RequestFocusCallback,
             CopyToClipboardCallback)
-        { IsNew = IsNew, DiagnosticTimingEnabled = DiagnosticTimingEnabled, Metrics = Metrics, _inputOverrides = _inputOverrides };
+        { IsNew = IsNew, DiagnosticTimingEnabled = DiagnosticTimingEnabled, Metrics = Metrics, AnimationClock = AnimationClock, _inputOverrides = _inputOverrides };
     }
     
     /// <summary>
@@ -204,7 +212,7 @@ public sealed class ReconcileContext
         return new ReconcileContext(Parent, FocusRing, CancellationToken, _ancestors.ToList(), LayoutAxis, InvalidateCallback,
             CaptureInputCallback, ReleaseCaptureCallback, ScheduleTimerCallback, WindowManagerRegistry, RequestFocusCallback,
             CopyToClipboardCallback)
-        { IsNew = IsNew, ChildIndex = index, ChildCount = count, DiagnosticTimingEnabled = DiagnosticTimingEnabled, Metrics = Metrics, _inputOverrides = _inputOverrides };
+        { IsNew = IsNew, ChildIndex = index, ChildCount = count, DiagnosticTimingEnabled = DiagnosticTimingEnabled, Metrics = Metrics, AnimationClock = AnimationClock, _inputOverrides = _inputOverrides };
     }
 
     /// <summary>
@@ -216,7 +224,7 @@ public sealed class ReconcileContext
         return new ReconcileContext(Parent, FocusRing, CancellationToken, _ancestors.ToList(), LayoutAxis, InvalidateCallback,
             CaptureInputCallback, ReleaseCaptureCallback, ScheduleTimerCallback, WindowManagerRegistry, RequestFocusCallback,
             CopyToClipboardCallback)
-        { IsNew = IsNew, ChildIndex = ChildIndex, ChildCount = ChildCount, DiagnosticTimingEnabled = DiagnosticTimingEnabled, Metrics = Metrics, _inputOverrides = overrides };
+        { IsNew = IsNew, ChildIndex = ChildIndex, ChildCount = ChildCount, DiagnosticTimingEnabled = DiagnosticTimingEnabled, Metrics = Metrics, AnimationClock = AnimationClock, _inputOverrides = overrides };
     }
 
     /// <summary>
@@ -63,8 +63,12 @@ public sealed record StatePanelWidget(
             ancestorSP.MarkVisited(StateKey);
         }
 
-        // 3. Compute elapsed time since last reconciliation
-        var now = System.Diagnostics.Stopwatch.GetTimestamp();
+        // 3. Compute elapsed time since last reconciliation. Under an app, every panel uses
+        // the frame's timestamp so concurrent animations advance in step.
+        var clock = context.AnimationClock;
+        var now = clock is { FrameTimestamp: > 0 }
+            ? clock.FrameTimestamp
+            : System.Diagnostics.Stopwatch.GetTimestamp();
         var elapsed = node.LastReconcileTicks > 0
             ? System.Diagnostics.Stopwatch.GetElapsedTime(node.LastReconcileTicks, now)
             : TimeSpan.Zero;
@@ -83,8 +87,14 @@ public sealed record StatePanelWidget(
         // 6. Sweep nested state keys not visited this frame
         node.SweepUnvisited();
 
-        // 7. Schedule re-render if any stored state is still active
-        if (node.HasActiveState && context.ScheduleTimerCallback is not null)
+        // 7. Schedule re-render if any stored state is still active. The app's clock batches
+        // all active panels into one tick; without it, each panel schedules its own timer.
+        var activeCount = node.ActiveStateCount;
+        if (activeCount > 0 && clock is not null)
+        {
+            clock.RequestFrame(node, activeCount);
+        }
+        else if (activeCount > 0 && context.ScheduleTimerCallback is not null)
         {
             var capturedNode = node;
             var capturedInvalidate = context.InvalidateCallback;
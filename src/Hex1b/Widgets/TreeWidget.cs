@@ -1,3 +1,4 @@
+using Hex1b.Data;
 using Hex1b.Events;
 using Hex1b.Input;
 using Hex1b.Nodes;
@@ -41,6 +42,14 @@ public sealed record TreeWidget(IReadOnlyList<TreeItemWidget> Items) : Hex1bWidg
     /// </summary>
     public bool IsMultiSelect { get; init; } = false;
 
+    /// <summary>
+    /// Optional data source the items come from instead of <see cref="Items"/>. Only the
+    /// rows in and near the viewport get item nodes, so the tree scales to hierarchies
+    /// with millions of loaded items. Set through the <see cref="ITreeDataSource{T}"/>
+    /// overload of <c>Tree</c>.
+    /// </summary>
+    internal ITreeRowSource? DataSource { get; init; }
+
     // Container-level event handlers
     internal Func<TreeSelectionChangedEventArgs, Task>? SelectionChangedHandler { get; init; }
     internal Func<TreeItemActivatedEventArgs, Task>? ItemActivatedHandler { get; init; }
@@ -90,14 +99,28 @@ public sealed record TreeWidget(IReadOnlyList<TreeItemWidget> Items) : Hex1bWidg
         node.CascadeSelection = IsMultiSelect; // Cascade is always on when multi-select is enabled
         node.SourceWidget = this;
         node.InvalidateCallback = context.InvalidateCallback;
+        node.DataSource = DataSource;
+
+        if (DataSource is not null)
+        {
+            if (IsMultiSelect)
+            {
+                throw new InvalidOperationException("Multi-select is not supported for trees bound to a data source.");
+            }
 
-        // Recursively reconcile tree items
-        var newItems = new List<TreeItemNode>();
-        await ReconcileItemsAsync(Items, node.Items, newItems, node, context);
-        node.Items = newItems;
+            node.Items = [];
+            node.EnsureRootsLoading(context.CancellationToken);
+        }
+        else
+        {
+            // Recursively reconcile tree items
+            var newItems = new List<TreeItemNode>();
+            await ReconcileItemsAsync(Items, node.Items, newItems, node, context);
+            node.Items = newItems;
 
-        // Rebuild flattened view
-        node.RebuildFlattenedView();
+            // Rebuild flattened view
+            node.RebuildFlattenedView();
+        }
 
         // Wire up container-level event handlers
         if (SelectionChangedHandler != null)
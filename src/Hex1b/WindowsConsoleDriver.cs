@@ -114,6 +114,7 @@ internal sealed class WindowsConsoleDriver : IConsoleDriver
     private uint _originalOutputCodePage;
     private bool _inRawMode;
     private bool _disposed;
+    private long _writeCalls;
     private int _lastWidth;
     private int _lastHeight;
     
@@ -848,6 +849,7 @@ internal sealed class WindowsConsoleDriver : IConsoleDriver
                 
                 while (remaining > 0)
                 {
+                    Interlocked.Increment(ref _writeCalls);
                     if (!WriteFile(_outputHandle, ptr + offset, remaining, out var bytesWritten, nint.Zero))
                     {
                         var error = Marshal.GetLastWin32Error();
@@ -865,6 +867,8 @@ internal sealed class WindowsConsoleDriver : IConsoleDriver
     {
         FlushFileBuffers(_outputHandle);
     }
+
+    public long WriteCalls => Interlocked.Read(ref _writeCalls);
     
     public void DrainInput()
     {
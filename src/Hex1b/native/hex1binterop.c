@@ -8,8 +8,11 @@
  * 
  * Key operations:
  * - hex1b_forkpty_shell() - Fork with PTY using forkpty() for shell spawning
+ * - hex1b_spawnpty() - Spawn with PTY using posix_spawn() (Linux), without fork
  * - hex1b_resize() - Resize terminal dimensions
+ * - hex1b_pty_read() / hex1b_pty_write() - Whole read bursts and writes in one call
  * - hex1b_wait() - Wait for child process with timeout
+ * - hex1b_exitwatch_*() - Block until any watched child exits (pidfd/epoll or SIGCHLD)
  */
 
 #define _GNU_SOURCE
@@ -24,6 +27,10 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <termios.h>
+#include <poll.h>
+#include <spawn.h>
+#include <pthread.h>
+#include <stdint.h>
 
 #ifdef __APPLE__
 #include <util.h>
@@ -31,6 +38,11 @@
 #include <pty.h>
 #endif
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#endif
+
 /* External environment variable */
 extern char **environ;
 
@@ -136,6 +148,156 @@ int hex1b_resize(int master_fd, int width, int height)
     return ioctl(master_fd, TIOCSWINSZ, &ws);
 }
 
+/**
+ * Puts a file descriptor in non-blocking mode, as hex1b_pty_read() expects of
+ * the master.
+ *
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int hex1b_set_nonblocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0) {
+        return -1;
+    }
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+/**
+ * Creates a pipe used to interrupt hex1b_pty_read(). Writing a byte to the
+ * write end makes a pending read return 0.
+ *
+ * @param out_read_fd  Output: Read end, passed to hex1b_pty_read()
+ * @param out_write_fd Output: Write end
+ *
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int hex1b_wake_pipe(int* out_read_fd, int* out_write_fd)
+{
+    int fds[2];
+    if (out_read_fd == NULL || out_write_fd == NULL) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (pipe(fds) < 0) {
+        return -1;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+    }
+    *out_read_fd = fds[0];
+    *out_write_fd = fds[1];
+    return 0;
+}
+
+/**
+ * Waits until the (non-blocking) master is readable, then reads until the
+ * buffer is full or the master has nothing more, so a whole output burst
+ * costs one call.
+ *
+ * @param master_fd  Master file descriptor, in non-blocking mode
+ * @param wake_fd    Read end of a hex1b_wake_pipe() pipe, or -1
+ * @param buffer     Destination buffer
+ * @param capacity   Size of buffer in bytes
+ * @param timeout_ms How long to wait for data (-1 for no limit)
+ *
+ * @return Bytes read (> 0); 0 if woken or timed out; -1 on error or when the
+ *         slave side has closed (errno is set, EIO for end of output)
+ */
+ssize_t hex1b_pty_read(int master_fd, int wake_fd, unsigned char* buffer, size_t capacity, int timeout_ms)
+{
+    if (buffer == NULL || capacity == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    struct pollfd fds[2];
+    nfds_t nfds = wake_fd >= 0 ? 2 : 1;
+    fds[0].fd = master_fd;
+    fds[0].events = POLLIN;
+    fds[0].revents = 0;
+    fds[1].fd = wake_fd;
+    fds[1].events = POLLIN;
+    fds[1].revents = 0;
+
+    int ready;
+    do {
+        ready = poll(fds, nfds, timeout_ms);
+    } while (ready < 0 && errno == EINTR);
+    if (ready < 0) {
+        return -1;
+    }
+
+    if (nfds == 2 && (fds[1].revents & POLLIN)) {
+        char drain[64];
+        while (read(wake_fd, drain, sizeof(drain)) > 0) {
+        }
+    }
+
+    if (fds[0].revents == 0) {
+        return 0;
+    }
+
+    size_t total = 0;
+    while (total < capacity) {
+        ssize_t n = read(master_fd, buffer + total, capacity - total);
+        if (n > 0) {
+            total += (size_t)n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+
+        /* End of output or an error: hand over what was read, report it next call */
+        if (total > 0) {
+            break;
+        }
+        if (n == 0) {
+            errno = EIO;
+        }
+        return -1;
+    }
+    return (ssize_t)total;
+}
+
+/**
+ * Writes all of data to the (possibly non-blocking) master, waiting for room
+ * when the child isn't keeping up.
+ *
+ * @return Bytes written (== length), or -1 on error (errno is set)
+ */
+ssize_t hex1b_pty_write(int master_fd, const unsigned char* data, size_t length)
+{
+    size_t total = 0;
+    while (total < length) {
+        ssize_t n = write(master_fd, data + total, length - total);
+        if (n > 0) {
+            total += (size_t)n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd pfd;
+            pfd.fd = master_fd;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+                return -1;
+            }
+            continue;
+        }
+        return -1;
+    }
+    return (ssize_t)total;
+}
+
 /**
  * Waits for a child process to exit with timeout.
  * 
@@ -274,3 +436,377 @@ int hex1b_forkpty_exec(
     *out_child_pid = pid;
     return 0;
 }
+
+/**
+ * Spawns an executable attached to a new PTY using posix_spawn().
+ *
+ * forkpty() copies the page tables of the whole parent, which for a managed
+ * process grows with the heap. glibc implements posix_spawn() with
+ * CLONE_VM | CLONE_VFORK, so the cost of starting a child doesn't depend on
+ * the parent's size.
+ *
+ * The PTY pair is opened in the parent. The child becomes a session leader
+ * via POSIX_SPAWN_SETSID and then opens the slave by path without O_NOCTTY,
+ * which on Linux makes it the controlling terminal (the TIOCSCTTY step that
+ * forkpty() performs). BSD-derived systems don't acquire a controlling
+ * terminal on open, so there this returns ENOSYS and callers fall back to
+ * hex1b_forkpty_exec().
+ *
+ * No descriptors are closed explicitly: the master and every descriptor
+ * this library or the .NET runtime opens are close-on-exec.
+ *
+ * @param exec_path      Path to the executable
+ * @param argv           NULL-terminated array of arguments (including argv[0])
+ * @param envp           NULL-terminated array of KEY=VALUE strings for the child
+ * @param working_dir    Working directory for the child (NULL for current)
+ * @param width          Initial terminal width in columns
+ * @param height         Initial terminal height in rows
+ * @param out_master_fd  Output: Master PTY file descriptor
+ * @param out_child_pid  Output: PID of the spawned child process
+ *
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int hex1b_spawnpty(
+    const char* exec_path,
+    const char** argv,
+    const char** envp,
+    const char* working_dir,
+    int width,
+    int height,
+    int* out_master_fd,
+    int* out_child_pid)
+{
+    if (exec_path == NULL || argv == NULL || envp == NULL ||
+        out_master_fd == NULL || out_child_pid == NULL) {
+        errno = EINVAL;
+        return -1;
+    }
+
+#if defined(__linux__) && defined(POSIX_SPAWN_SETSID) && \
+    defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+    int master_fd = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (master_fd < 0) {
+        return -1;
+    }
+
+    char slave_name[128];
+    if (grantpt(master_fd) < 0 || unlockpt(master_fd) < 0 ||
+        ptsname_r(master_fd, slave_name, sizeof(slave_name)) != 0) {
+        int saved = errno;
+        close(master_fd);
+        errno = saved;
+        return -1;
+    }
+
+    struct winsize ws;
+    ws.ws_row = height > 0 ? height : 24;
+    ws.ws_col = width > 0 ? width : 80;
+    ws.ws_xpixel = 0;
+    ws.ws_ypixel = 0;
+    ioctl(master_fd, TIOCSWINSZ, &ws);
+
+    posix_spawnattr_t attr;
+    posix_spawn_file_actions_t actions;
+    int rc = posix_spawnattr_init(&attr);
+    if (rc != 0) {
+        close(master_fd);
+        errno = rc;
+        return -1;
+    }
+    rc = posix_spawn_file_actions_init(&actions);
+    if (rc != 0) {
+        posix_spawnattr_destroy(&attr);
+        close(master_fd);
+        errno = rc;
+        return -1;
+    }
+
+    /* Reset every handler and unblock everything, as the forkpty path does by hand */
+    sigset_t all_signals, no_signals;
+    sigfillset(&all_signals);
+    sigemptyset(&no_signals);
+    posix_spawnattr_setsigdefault(&attr, &all_signals);
+    posix_spawnattr_setsigmask(&attr, &no_signals);
+    posix_spawnattr_setflags(&attr,
+        POSIX_SPAWN_SETSID | POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK);
+
+    /* setsid() runs before the file actions, so this open acquires the controlling terminal */
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, slave_name, O_RDWR, 0);
+    posix_spawn_file_actions_adddup2(&actions, STDIN_FILENO, STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, STDIN_FILENO, STDERR_FILENO);
+
+    if (working_dir != NULL && working_dir[0] != '\0') {
+        posix_spawn_file_actions_addchdir_np(&actions, working_dir);
+    }
+
+    pid_t pid;
+    rc = posix_spawn(&pid, exec_path, &actions, &attr, (char* const*)argv, (char* const*)envp);
+
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+
+    if (rc != 0) {
+        close(master_fd);
+        errno = rc;
+        return -1;
+    }
+
+    *out_master_fd = master_fd;
+    *out_child_pid = pid;
+    return 0;
+#else
+    (void)argv;
+    (void)envp;
+    (void)working_dir;
+    (void)width;
+    (void)height;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/*
+ * Child exit notification.
+ *
+ * One consumer thread calls hex1b_exitwatch_next() in a loop and sleeps until
+ * a watched child exits, so idle children cost no wakeups. On Linux 5.3+ each
+ * child gets a pidfd registered with an epoll instance. Elsewhere a SIGCHLD
+ * handler writes to a self-pipe and the registered children are checked with
+ * waitpid(WNOHANG); the previous SIGCHLD handler is still called, so the
+ * .NET runtime keeps seeing exits of its own Process children.
+ */
+
+#define EXITWATCH_MODE_NONE   0
+#define EXITWATCH_MODE_PIDFD  1
+#define EXITWATCH_MODE_SIGCHLD 2
+
+static pthread_mutex_t exitwatch_lock = PTHREAD_MUTEX_INITIALIZER;
+static int exitwatch_mode = EXITWATCH_MODE_NONE;
+static int exitwatch_epoll_fd = -1;
+static int exitwatch_pipe[2] = { -1, -1 };
+static struct sigaction exitwatch_previous_action;
+static int* exitwatch_pids = NULL;
+static int exitwatch_pid_count = 0;
+static int exitwatch_pid_capacity = 0;
+
+static int exit_code_from_status(int status)
+{
+    if (WIFEXITED(status)) {
+        return WEXITSTATUS(status);
+    }
+    if (WIFSIGNALED(status)) {
+        return 128 + WTERMSIG(status);
+    }
+    return -1;
+}
+
+static void exitwatch_sigchld(int sig, siginfo_t* info, void* context)
+{
+    int saved_errno = errno;
+    char byte = 0;
+    ssize_t ignored = write(exitwatch_pipe[1], &byte, 1);
+    (void)ignored;
+    errno = saved_errno;
+
+    if (exitwatch_previous_action.sa_flags & SA_SIGINFO) {
+        if (exitwatch_previous_action.sa_sigaction != NULL) {
+            exitwatch_previous_action.sa_sigaction(sig, info, context);
+        }
+    } else if (exitwatch_previous_action.sa_handler != SIG_DFL &&
+               exitwatch_previous_action.sa_handler != SIG_IGN) {
+        exitwatch_previous_action.sa_handler(sig);
+    }
+}
+
+static int exitwatch_init_sigchld(void)
+{
+    if (pipe(exitwatch_pipe) < 0) {
+        return -1;
+    }
+    fcntl(exitwatch_pipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(exitwatch_pipe[1], F_SETFD, FD_CLOEXEC);
+    fcntl(exitwatch_pipe[1], F_SETFL, O_NONBLOCK);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = exitwatch_sigchld;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART | SA_NOCLDSTOP;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGCHLD, &sa, &exitwatch_previous_action) < 0) {
+        int saved = errno;
+        close(exitwatch_pipe[0]);
+        close(exitwatch_pipe[1]);
+        exitwatch_pipe[0] = exitwatch_pipe[1] = -1;
+        errno = saved;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Sets up child exit notification. Safe to call more than once.
+ *
+ * @return 1 for pidfd/epoll, 2 for the SIGCHLD fallback, -1 on error (errno is set)
+ */
+int hex1b_exitwatch_init(void)
+{
+    pthread_mutex_lock(&exitwatch_lock);
+    if (exitwatch_mode != EXITWATCH_MODE_NONE) {
+        int mode = exitwatch_mode;
+        pthread_mutex_unlock(&exitwatch_lock);
+        return mode;
+    }
+
+#if defined(__linux__) && defined(SYS_pidfd_open)
+    int probe = (int)syscall(SYS_pidfd_open, getpid(), 0);
+    if (probe >= 0) {
+        close(probe);
+        exitwatch_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (exitwatch_epoll_fd >= 0) {
+            exitwatch_mode = EXITWATCH_MODE_PIDFD;
+        }
+    }
+#endif
+
+    if (exitwatch_mode == EXITWATCH_MODE_NONE && exitwatch_init_sigchld() == 0) {
+        exitwatch_mode = EXITWATCH_MODE_SIGCHLD;
+    }
+
+    int mode = exitwatch_mode;
+    pthread_mutex_unlock(&exitwatch_lock);
+    return mode == EXITWATCH_MODE_NONE ? -1 : mode;
+}
+
+/**
+ * Starts watching a child process. The child must not be reaped by anyone
+ * else; hex1b_exitwatch_next() reaps it.
+ *
+ * @param pid  PID of a child of this process
+ *
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int hex1b_exitwatch_add(int pid)
+{
+#if defined(__linux__) && defined(SYS_pidfd_open)
+    if (exitwatch_mode == EXITWATCH_MODE_PIDFD) {
+        int pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+        if (pidfd < 0) {
+            return -1;
+        }
+        fcntl(pidfd, F_SETFD, FD_CLOEXEC);
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u64 = ((uint64_t)(uint32_t)pidfd << 32) | (uint32_t)pid;
+        if (epoll_ctl(exitwatch_epoll_fd, EPOLL_CTL_ADD, pidfd, &ev) < 0) {
+            int saved = errno;
+            close(pidfd);
+            errno = saved;
+            return -1;
+        }
+        return 0;
+    }
+#endif
+
+    if (exitwatch_mode != EXITWATCH_MODE_SIGCHLD) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    pthread_mutex_lock(&exitwatch_lock);
+    if (exitwatch_pid_count == exitwatch_pid_capacity) {
+        int capacity = exitwatch_pid_capacity > 0 ? exitwatch_pid_capacity * 2 : 16;
+        int* pids = realloc(exitwatch_pids, sizeof(int) * capacity);
+        if (pids == NULL) {
+            pthread_mutex_unlock(&exitwatch_lock);
+            errno = ENOMEM;
+            return -1;
+        }
+        exitwatch_pids = pids;
+        exitwatch_pid_capacity = capacity;
+    }
+    exitwatch_pids[exitwatch_pid_count++] = pid;
+    pthread_mutex_unlock(&exitwatch_lock);
+
+    /* The child may already have exited; wake the consumer to check */
+    char byte = 0;
+    ssize_t ignored = write(exitwatch_pipe[1], &byte, 1);
+    (void)ignored;
+    return 0;
+}
+
+/**
+ * Blocks until a watched child exits, reaps it and stops watching it.
+ * Must only be called from a single thread.
+ *
+ * @param out_pid       Output: PID of the child that exited
+ * @param out_exit_code Output: Exit code (128 + signal if killed, -1 if unknown)
+ *
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int hex1b_exitwatch_next(int* out_pid, int* out_exit_code)
+{
+    if (out_pid == NULL || out_exit_code == NULL) {
+        errno = EINVAL;
+        return -1;
+    }
+
+#if defined(__linux__) && defined(SYS_pidfd_open)
+    if (exitwatch_mode == EXITWATCH_MODE_PIDFD) {
+        struct epoll_event ev;
+        int n;
+        do {
+            n = epoll_wait(exitwatch_epoll_fd, &ev, 1, -1);
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) {
+            return -1;
+        }
+
+        int pid = (int)(uint32_t)ev.data.u64;
+        int pidfd = (int)(uint32_t)(ev.data.u64 >> 32);
+        epoll_ctl(exitwatch_epoll_fd, EPOLL_CTL_DEL, pidfd, NULL);
+        close(pidfd);
+
+        int status;
+        pid_t result;
+        do {
+            result = waitpid(pid, &status, 0);
+        } while (result < 0 && errno == EINTR);
+
+        *out_pid = pid;
+        *out_exit_code = result == pid ? exit_code_from_status(status) : -1;
+        return 0;
+    }
+#endif
+
+    if (exitwatch_mode != EXITWATCH_MODE_SIGCHLD) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    for (;;) {
+        pthread_mutex_lock(&exitwatch_lock);
+        for (int i = 0; i < exitwatch_pid_count; i++) {
+            int status;
+            pid_t result = waitpid(exitwatch_pids[i], &status, WNOHANG);
+            if (result == 0 || (result < 0 && errno == EINTR)) {
+                continue;
+            }
+
+            /* Exited, or already reaped by someone else (ECHILD) */
+            *out_pid = exitwatch_pids[i];
+            *out_exit_code = result > 0 ? exit_code_from_status(status) : -1;
+            exitwatch_pids[i] = exitwatch_pids[--exitwatch_pid_count];
+            pthread_mutex_unlock(&exitwatch_lock);
+            return 0;
+        }
+        pthread_mutex_unlock(&exitwatch_lock);
+
+        char buffer[64];
+        ssize_t n = read(exitwatch_pipe[0], buffer, sizeof(buffer));
+        if (n < 0 && errno != EINTR) {
+            return -1;
+        }
+    }
+}
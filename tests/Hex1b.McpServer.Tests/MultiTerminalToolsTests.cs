@@ -0,0 +1,180 @@
+using System.Text.Json;
+using ModelContextProtocol.Client;
+using ModelContextProtocol.Protocol;
+
+namespace Hex1b.McpServer.Tests;
+
+/// <summary>
+/// Integration tests for the MCP tools that capture or wait on several terminals in one call.
+/// </summary>
+[TestClass]
+public class MultiTerminalToolsTests : McpServerTestBase
+{
+    private static string StartTerminalToolName => OperatingSystem.IsWindows()
+        ? "start_pwsh_terminal"
+        : "start_bash_terminal";
+
+    private static JsonElement GetResponse(CallToolResult result)
+    {
+        var text = result.Content.OfType<TextContentBlock>().FirstOrDefault()?.Text;
+        Assert.IsNotNull(text);
+        return JsonSerializer.Deserialize<JsonElement>(text);
+    }
+
+    private async Task<string> StartTerminalSessionAsync(McpClient client)
+    {
+        var result = await client.CallToolAsync(
+            StartTerminalToolName,
+            new Dictionary<string, object?>
+            {
+                ["width"] = 80,
+                ["height"] = 24,
+                ["workingDirectory"] = Path.GetTempPath()
+            },
+            cancellationToken: TestCancellationToken);
+
+        var response = GetResponse(result);
+        Assert.IsTrue(response.GetProperty("success").GetBoolean(), response.GetProperty("message").GetString());
+        return response.GetProperty("sessionId").GetString()!;
+    }
+
+    private async Task SendInputAsync(McpClient client, string sessionId, string text)
+    {
+        var result = await client.CallToolAsync(
+            "send_terminal_input",
+            new Dictionary<string, object?> { ["sessionId"] = sessionId, ["text"] = text },
+            cancellationToken: TestCancellationToken);
+
+        Assert.IsTrue(GetResponse(result).GetProperty("success").GetBoolean());
+    }
+
+    private async Task<JsonElement> WaitForTerminalsTextAsync(McpClient client, string[] sessionIds, string[] texts, string mode, int timeoutSeconds)
+    {
+        var result = await client.CallToolAsync(
+            "wait_for_terminals_text",
+            new Dictionary<string, object?>
+            {
+                ["sessionIds"] = sessionIds,
+                ["texts"] = texts,
+                ["mode"] = mode,
+                ["timeoutSeconds"] = timeoutSeconds
+            },
+            cancellationToken: TestCancellationToken);
+
+        return GetResponse(result);
+    }
+
+    [TestMethod]
+    public async Task CaptureTerminalScreens_SeveralSessions_CapturesEachAndReportsUnknownId()
+    {
+        // Arrange
+        await StartServerAsync();
+        await using var client = await CreateClientAsync();
+        var first = await StartTerminalSessionAsync(client);
+        var second = await StartTerminalSessionAsync(client);
+
+        // Act
+        var result = await client.CallToolAsync(
+            "capture_terminal_screens",
+            new Dictionary<string, object?> { ["sessionIds"] = new[] { first, "missing", second } },
+            cancellationToken: TestCancellationToken);
+
+        // Assert: one capture per ID, in order, and the unknown one fails on its own
+        var response = GetResponse(result);
+        Assert.IsFalse(response.GetProperty("success").GetBoolean());
+        Assert.AreEqual("Captured 2 of 3 terminal(s)", response.GetProperty("message").GetString());
+
+        var captures = response.GetProperty("captures").EnumerateArray().ToArray();
+        Assert.HasCount(3, captures);
+        Assert.AreEqual(first, captures[0].GetProperty("sessionId").GetString());
+        Assert.IsTrue(captures[0].GetProperty("success").GetBoolean());
+        Assert.IsTrue(captures[0].TryGetProperty("content", out _));
+        Assert.AreEqual("missing", captures[1].GetProperty("sessionId").GetString());
+        Assert.IsFalse(captures[1].GetProperty("success").GetBoolean());
+        Assert.Contains("not found", captures[1].GetProperty("message").GetString()!);
+        Assert.AreEqual(second, captures[2].GetProperty("sessionId").GetString());
+        Assert.IsTrue(captures[2].GetProperty("success").GetBoolean());
+    }
+
+    [TestMethod]
+    public async Task WaitForTerminalsText_AnyMode_ReturnsWhenOneTerminalShowsText()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        // Arrange
+        await StartServerAsync();
+        await using var client = await CreateClientAsync();
+        var first = await StartTerminalSessionAsync(client);
+        var second = await StartTerminalSessionAsync(client);
+
+        // Act: the echoed command line shows the expression, only its output shows hex1b-42
+        await SendInputAsync(client, second, "echo hex1b-$((40+2))\n");
+        var response = await WaitForTerminalsTextAsync(client, [first, second], ["hex1b-42"], "any", 10);
+
+        // Assert
+        Assert.IsTrue(response.GetProperty("success").GetBoolean());
+        Assert.IsTrue(response.GetProperty("satisfied").GetBoolean());
+        Assert.AreEqual("any", response.GetProperty("mode").GetString());
+        var results = response.GetProperty("results").EnumerateArray().ToArray();
+        Assert.HasCount(2, results);
+        Assert.IsFalse(results[0].GetProperty("found").GetBoolean());
+        Assert.IsTrue(results[1].GetProperty("found").GetBoolean());
+        Assert.IsTrue(results[1].TryGetProperty("foundAfterMs", out _));
+    }
+
+    [TestMethod]
+    public async Task WaitForTerminalsText_AllMode_TimesOutUntilEveryTerminalShowsText()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        // Arrange
+        await StartServerAsync();
+        await using var client = await CreateClientAsync();
+        var first = await StartTerminalSessionAsync(client);
+        var second = await StartTerminalSessionAsync(client);
+        await SendInputAsync(client, first, "echo hex1b-$((40+2))\n");
+        var firstShown = await WaitForTerminalsTextAsync(client, [first], ["hex1b-42"], "any", 10);
+        Assert.IsTrue(firstShown.GetProperty("satisfied").GetBoolean());
+
+        // Act: only the first terminal shows its text
+        var partial = await WaitForTerminalsTextAsync(client, [first, second], ["hex1b-42", "hex1b-43"], "all", 1);
+
+        await SendInputAsync(client, second, "echo hex1b-$((40+3))\n");
+        var complete = await WaitForTerminalsTextAsync(client, [first, second], ["hex1b-42", "hex1b-43"], "all", 10);
+
+        // Assert
+        Assert.IsTrue(partial.GetProperty("success").GetBoolean());
+        Assert.IsFalse(partial.GetProperty("satisfied").GetBoolean());
+        Assert.Contains("not met within 1s", partial.GetProperty("message").GetString()!);
+        var partialResults = partial.GetProperty("results").EnumerateArray().ToArray();
+        Assert.IsTrue(partialResults[0].GetProperty("found").GetBoolean());
+        Assert.IsFalse(partialResults[1].GetProperty("found").GetBoolean());
+
+        Assert.IsTrue(complete.GetProperty("satisfied").GetBoolean());
+        Assert.IsTrue(complete.GetProperty("results").EnumerateArray().All(r => r.GetProperty("found").GetBoolean()));
+    }
+
+    [TestMethod]
+    public async Task WaitForTerminalsText_InvalidArguments_Fails()
+    {
+        // Arrange
+        await StartServerAsync();
+        await using var client = await CreateClientAsync();
+        var session = await StartTerminalSessionAsync(client);
+
+        // Act
+        var unknownMode = await WaitForTerminalsTextAsync(client, [session], ["x"], "some", 1);
+        var unknownSession = await WaitForTerminalsTextAsync(client, [session, "missing"], ["x"], "any", 1);
+        var textCountMismatch = await WaitForTerminalsTextAsync(client, [session, session, session], ["x", "y"], "any", 1);
+
+        // Assert
+        Assert.IsFalse(unknownMode.GetProperty("success").GetBoolean());
+        Assert.Contains("Unknown mode", unknownMode.GetProperty("message").GetString()!);
+        Assert.IsFalse(unknownSession.GetProperty("success").GetBoolean());
+        Assert.Contains("'missing' not found", unknownSession.GetProperty("message").GetString()!);
+        Assert.IsFalse(textCountMismatch.GetProperty("success").GetBoolean());
+        Assert.Contains("Expected 1 or 3 texts", textCountMismatch.GetProperty("message").GetString()!);
+    }
+}
@@ -0,0 +1,248 @@
+namespace Hex1b.McpServer.Tests;
+
+/// <summary>
+/// Tests for the warm shell pool and the concurrent session limit of <see cref="TerminalSessionManager"/>.
+/// </summary>
+/// <remarks>
+/// The pool is Unix-only, so these tests return early on Windows.
+/// </remarks>
+[TestClass]
+public class TerminalSessionPoolTests
+{
+    private static readonly TimeSpan Timeout = TimeSpan.FromSeconds(20);
+
+    private static CancellationToken CancellationToken => TestContext.Current.CancellationToken;
+
+    [TestMethod]
+    public async Task StartSession_WithWarmPool_TakesPooledShellAndRefills()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager(new TerminalSessionPoolOptions { WarmSessionCount = 1 });
+        await WaitUntilAsync(() => manager.WarmSessionCount == 1, "The pool never warmed up.");
+
+        var workingDirectory = Directory.CreateTempSubdirectory("hex1b-pool-test-").FullName;
+        try
+        {
+            var session = await manager.StartSessionAsync("bash", [], workingDirectory, width: 100, height: 30, ct: CancellationToken);
+
+            Assert.IsTrue(session.IsPooled);
+            Assert.StartsWith("term-", session.Id);
+            Assert.AreEqual(workingDirectory, session.WorkingDirectory);
+            Assert.AreEqual(100, session.Width);
+            Assert.AreEqual(30, session.Height);
+
+            // The pooled shell was moved into the requested directory
+            await session.SendInputAsync("pwd\r", CancellationToken);
+            Assert.IsTrue(await session.WaitForTextAsync(workingDirectory, Timeout, CancellationToken));
+
+            // Taking the shell starts a replacement
+            await WaitUntilAsync(() => manager.WarmSessionCount == 1, "The pool was not refilled.");
+        }
+        finally
+        {
+            Directory.Delete(workingDirectory, recursive: true);
+        }
+    }
+
+    [TestMethod]
+    public async Task StartSession_NotMatchingPool_StartsFreshProcess()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager(new TerminalSessionPoolOptions { WarmSessionCount = 1 });
+        await WaitUntilAsync(() => manager.WarmSessionCount == 1, "The pool never warmed up.");
+
+        var session = await manager.StartSessionAsync("bash", ["--norc"], ct: CancellationToken);
+
+        Assert.IsFalse(session.IsPooled);
+        Assert.AreEqual(1, manager.WarmSessionCount);
+    }
+
+    [TestMethod]
+    public async Task StartSession_AtCapacity_QueuesUntilSessionRemoved()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager(new TerminalSessionPoolOptions { MaxConcurrentSessions = 1 });
+        var first = await manager.StartSessionAsync("bash", [], ct: CancellationToken);
+
+        var queued = manager.StartSessionAsync("bash", [], ct: CancellationToken);
+        await Task.Delay(200, CancellationToken);
+        Assert.IsFalse(queued.IsCompleted);
+
+        await manager.RemoveSessionAsync(first.Id);
+        var second = await queued.WaitAsync(Timeout, CancellationToken);
+
+        Assert.AreEqual(1, manager.SessionCount);
+        Assert.AreSame(second, manager.GetSession(second.Id));
+    }
+
+    [TestMethod]
+    public async Task StartSession_AtCapacity_SlotFreedWhenProcessExits()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager(new TerminalSessionPoolOptions { MaxConcurrentSessions = 1 });
+        var first = await manager.StartSessionAsync("bash", ["-c", "sleep 0.2"], ct: CancellationToken);
+
+        // The exited session still counts as a session, but no longer holds the slot
+        var second = await manager.StartSessionAsync("bash", [], ct: CancellationToken).WaitAsync(Timeout, CancellationToken);
+
+        Assert.IsTrue(first.HasExited);
+        Assert.IsFalse(second.HasExited);
+    }
+
+    [TestMethod]
+    public async Task StartSession_QueuedAndCancelled_ThrowsAndTakesNoSlot()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager(new TerminalSessionPoolOptions { MaxConcurrentSessions = 1 });
+        var first = await manager.StartSessionAsync("bash", [], ct: CancellationToken);
+
+        using var cts = new CancellationTokenSource();
+        var queued = manager.StartSessionAsync("bash", [], ct: cts.Token);
+        await Task.Delay(100, CancellationToken);
+        cts.Cancel();
+
+        await Assert.ThrowsAsync<OperationCanceledException>(() => queued);
+        Assert.AreEqual(1, manager.SessionCount);
+
+        // The cancelled request neither kept a slot nor leaked the one it waited for
+        await manager.RemoveSessionAsync(first.Id);
+        await manager.StartSessionAsync("bash", [], ct: CancellationToken).WaitAsync(Timeout, CancellationToken);
+    }
+
+    [TestMethod]
+    public async Task StartSession_QueueTimeout_Throws()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager(new TerminalSessionPoolOptions
+        {
+            MaxConcurrentSessions = 1,
+            SessionQueueTimeout = TimeSpan.FromMilliseconds(100)
+        });
+        await manager.StartSessionAsync("bash", [], ct: CancellationToken);
+
+        var ex = await Assert.ThrowsAsync<InvalidOperationException>(
+            () => manager.StartSessionAsync("bash", [], ct: CancellationToken));
+
+        Assert.Contains("limit of 1 concurrent sessions", ex.Message);
+    }
+
+    [TestMethod]
+    public async Task RemoveSession_Pooled_ResetsShellAndReturnsIt()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        // A released shell only goes back into a pool that isn't full. The rc file makes the
+        // first shell started after the marker exists (the refill) slow, so the pool is still
+        // short when the released shell has been reset.
+        var directory = Directory.CreateTempSubdirectory("hex1b-pool-test-").FullName;
+        var marker = Path.Combine(directory, "slow");
+        var rcFile = Path.Combine(directory, "rc");
+        await File.WriteAllTextAsync(rcFile, $"if [ -e '{marker}' ]; then rm -f '{marker}'; sleep 5; fi\n", CancellationToken);
+        string[] arguments = ["--rcfile", rcFile];
+
+        try
+        {
+            await using var manager = new TerminalSessionManager(new TerminalSessionPoolOptions
+            {
+                WarmSessionCount = 1,
+                Shell = "bash",
+                ShellArguments = arguments
+            });
+            await WaitUntilAsync(() => manager.WarmSessionCount == 1, "The pool never warmed up.");
+            await File.WriteAllTextAsync(marker, "", CancellationToken);
+
+            var session = await manager.StartSessionAsync("bash", arguments, ct: CancellationToken);
+            await session.SendInputAsync("export HEX1B_POOL_TEST=leftover; echo \"[$HEX1B_POOL_TEST]\"\r", CancellationToken);
+            Assert.IsTrue(await session.WaitForTextAsync("[leftover]", Timeout, CancellationToken));
+
+            await manager.RemoveSessionAsync(session.Id);
+            await WaitUntilAsync(() => manager.WarmSessionCount == 1, "The released shell was not returned.");
+
+            var reused = await manager.StartSessionAsync("bash", arguments, ct: CancellationToken);
+
+            Assert.AreSame(session, reused);
+            Assert.AreEqual(1, reused.ReuseCount);
+            Assert.DoesNotContain("leftover", reused.CaptureText());
+
+            // The shell was re-executed with the pool's environment
+            await reused.SendInputAsync("echo \"[${HEX1B_POOL_TEST:-unset}]\"\r", CancellationToken);
+            Assert.IsTrue(await reused.WaitForTextAsync("[unset]", Timeout, CancellationToken));
+        }
+        finally
+        {
+            Directory.Delete(directory, recursive: true);
+        }
+    }
+
+    [TestMethod]
+    public async Task Pool_ResetScript_IsOnlyReadableByOwner()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        string path;
+        await using (var pool = new TerminalSessionPool(new TerminalSessionPoolOptions { WarmSessionCount = 1 }))
+        {
+            path = pool.ResetScriptPath;
+
+            Assert.AreEqual(UnixFileMode.UserRead | UnixFileMode.UserWrite, File.GetUnixFileMode(path));
+            Assert.StartsWith("exec env -i ", await File.ReadAllTextAsync(path, CancellationToken));
+        }
+
+        Assert.IsFalse(File.Exists(path));
+    }
+
+    [TestMethod]
+    public async Task ListSessions_ReportsPoolingAndResourceUsage()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager(new TerminalSessionPoolOptions { WarmSessionCount = 1 });
+        await WaitUntilAsync(() => manager.WarmSessionCount == 1, "The pool never warmed up.");
+
+        var pooled = await manager.StartSessionAsync("bash", [], ct: CancellationToken);
+        var fresh = await manager.StartSessionAsync("bash", ["--norc"], ct: CancellationToken);
+        await pooled.SendInputAsync("echo metrics-check\r", CancellationToken);
+        Assert.IsTrue(await pooled.WaitForTextAsync("metrics-check", Timeout, CancellationToken));
+
+        var sessions = manager.ListSessions();
+        var pooledInfo = sessions.Single(s => s.Id == pooled.Id);
+        var freshInfo = sessions.Single(s => s.Id == fresh.Id);
+
+        Assert.IsTrue(pooledInfo.IsPooled);
+        Assert.AreEqual(0, pooledInfo.ReuseCount);
+        Assert.IsFalse(freshInfo.IsPooled);
+
+        var usage = pooledInfo.ResourceUsage;
+        Assert.IsNotNull(usage);
+        Assert.IsGreaterThanOrEqualTo((long)"echo metrics-check\r".Length, usage.InputBytes);
+        Assert.IsGreaterThan(0L, usage.OutputBytes);
+        Assert.IsNotNull(usage.CpuTime);
+        Assert.IsNotNull(usage.WorkingSetBytes);
+    }
+
+    private static async Task WaitUntilAsync(Func<bool> condition, string message)
+    {
+        var deadline = DateTime.UtcNow + Timeout;
+        while (!condition())
+        {
+            if (DateTime.UtcNow > deadline)
+                Assert.Fail(message);
+            await Task.Delay(20, CancellationToken);
+        }
+    }
+}
@@ -0,0 +1,193 @@
+using System.Diagnostics;
+
+namespace Hex1b.McpServer.Tests;
+
+/// <summary>
+/// Tests for waiting on text across several sessions with <see cref="TerminalSessionManager.WaitForTextAsync"/>.
+/// </summary>
+/// <remarks>
+/// The shells print text built by arithmetic expansion (<c>hex1b-$((40+2))</c> prints
+/// <c>hex1b-42</c>), so the echoed command line never matches the text waited for.
+/// </remarks>
+[TestClass]
+public class TerminalTextWaiterTests
+{
+    private static readonly TimeSpan Timeout = TimeSpan.FromSeconds(20);
+
+    private static CancellationToken CancellationToken => TestContext.Current.CancellationToken;
+
+    [TestMethod]
+    public async Task WaitForText_TextAppearsAfterCall_ReturnsFound()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager();
+        var session = await StartShellAsync(manager);
+
+        var wait = manager.WaitForTextAsync([new(session.Id, "hex1b-42")], waitForAll: false, Timeout, CancellationToken);
+        await Task.Delay(100, CancellationToken);
+        Assert.IsFalse(wait.IsCompleted);
+
+        await session.SendInputAsync("echo hex1b-$((40+2))\r", CancellationToken);
+        var results = await wait;
+
+        Assert.HasCount(1, results);
+        Assert.AreEqual(session.Id, results[0].SessionId);
+        Assert.IsTrue(results[0].Found);
+        Assert.IsFalse(results[0].HasExited);
+        Assert.IsNotNull(results[0].FoundAfter);
+    }
+
+    [TestMethod]
+    public async Task WaitForText_TextAlreadyShown_ReturnsImmediately()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager();
+        var session = await StartShellAsync(manager);
+        await session.SendInputAsync("echo hex1b-$((40+2))\r", CancellationToken);
+        Assert.IsTrue(await session.WaitForTextAsync("hex1b-42", Timeout, CancellationToken));
+
+        var results = await manager.WaitForTextAsync([new(session.Id, "hex1b-42")], waitForAll: true, Timeout, CancellationToken);
+
+        Assert.IsTrue(results[0].Found);
+    }
+
+    [TestMethod]
+    public async Task WaitForText_TextNeverShown_TimesOut()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager();
+        var session = await StartShellAsync(manager);
+
+        var stopwatch = Stopwatch.StartNew();
+        var results = await manager.WaitForTextAsync(
+            [new(session.Id, "never-shown")], waitForAll: false, TimeSpan.FromMilliseconds(300), CancellationToken);
+
+        Assert.IsGreaterThanOrEqualTo(TimeSpan.FromMilliseconds(250), stopwatch.Elapsed);
+        Assert.IsFalse(results[0].Found);
+        Assert.IsFalse(results[0].HasExited);
+        Assert.IsNull(results[0].FoundAfter);
+    }
+
+    [TestMethod]
+    public async Task WaitForText_Cancelled_Throws()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager();
+        var session = await StartShellAsync(manager);
+
+        using var cts = new CancellationTokenSource();
+        var wait = manager.WaitForTextAsync([new(session.Id, "never-shown")], waitForAll: false, Timeout, cts.Token);
+        await Task.Delay(100, CancellationToken);
+        cts.Cancel();
+
+        await Assert.ThrowsAsync<OperationCanceledException>(() => wait);
+    }
+
+    [TestMethod]
+    public async Task WaitForText_AnyMode_ReturnsWhenOneTerminalShowsText()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager();
+        var first = await StartShellAsync(manager);
+        var second = await StartShellAsync(manager);
+
+        var wait = manager.WaitForTextAsync(
+            [new(first.Id, "hex1b-42"), new(second.Id, "hex1b-42")], waitForAll: false, Timeout, CancellationToken);
+        await second.SendInputAsync("echo hex1b-$((40+2))\r", CancellationToken);
+        var results = await wait;
+
+        Assert.HasCount(2, results);
+        Assert.IsFalse(results[0].Found);
+        Assert.IsTrue(results[1].Found);
+    }
+
+    [TestMethod]
+    public async Task WaitForText_AllMode_WaitsForEveryTerminal()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager();
+        var first = await StartShellAsync(manager);
+        var second = await StartShellAsync(manager);
+
+        var wait = manager.WaitForTextAsync(
+            [new(first.Id, "hex1b-42"), new(second.Id, "hex1b-43")], waitForAll: true, Timeout, CancellationToken);
+        await first.SendInputAsync("echo hex1b-$((40+2))\r", CancellationToken);
+        Assert.IsTrue(await first.WaitForTextAsync("hex1b-42", Timeout, CancellationToken));
+        await Task.Delay(100, CancellationToken);
+        Assert.IsFalse(wait.IsCompleted);
+
+        await second.SendInputAsync("echo hex1b-$((40+3))\r", CancellationToken);
+        var results = await wait;
+
+        Assert.IsTrue(results[0].Found);
+        Assert.IsTrue(results[1].Found);
+    }
+
+    [TestMethod]
+    public async Task WaitForText_AllMode_SameTerminalListedTwice_WaitsForBothTexts()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager();
+        var session = await StartShellAsync(manager);
+
+        var wait = manager.WaitForTextAsync(
+            [new(session.Id, "hex1b-42"), new(session.Id, "hex1b-43")], waitForAll: true, Timeout, CancellationToken);
+        await session.SendInputAsync("echo hex1b-$((40+2))\r", CancellationToken);
+        Assert.IsTrue(await session.WaitForTextAsync("hex1b-42", Timeout, CancellationToken));
+        await Task.Delay(100, CancellationToken);
+        Assert.IsFalse(wait.IsCompleted);
+
+        await session.SendInputAsync("echo hex1b-$((40+3))\r", CancellationToken);
+        var results = await wait;
+
+        Assert.IsTrue(results.All(r => r.Found));
+    }
+
+    [TestMethod]
+    public async Task WaitForText_AllMode_EndsEarlyWhenTerminalExits()
+    {
+        if (OperatingSystem.IsWindows())
+            return;
+
+        await using var manager = new TerminalSessionManager();
+        var running = await StartShellAsync(manager);
+        var exiting = await manager.StartSessionAsync("bash", ["-c", "sleep 0.2"], ct: CancellationToken);
+
+        var stopwatch = Stopwatch.StartNew();
+        var results = await manager.WaitForTextAsync(
+            [new(running.Id, "never-shown"), new(exiting.Id, "never-shown")], waitForAll: true, Timeout, CancellationToken);
+
+        Assert.IsLessThan(Timeout, stopwatch.Elapsed);
+        Assert.IsFalse(results[0].HasExited);
+        Assert.IsTrue(results[1].HasExited);
+        Assert.IsFalse(results[1].Found);
+    }
+
+    [TestMethod]
+    public async Task WaitForText_UnknownSession_Throws()
+    {
+        await using var manager = new TerminalSessionManager();
+
+        var ex = await Assert.ThrowsAsync<ArgumentException>(
+            () => manager.WaitForTextAsync([new("missing", "text")], waitForAll: false, Timeout, CancellationToken));
+
+        Assert.Contains("missing", ex.Message);
+    }
+
+    private static Task<TerminalSession> StartShellAsync(TerminalSessionManager manager)
+        => manager.StartSessionAsync("bash", ["--norc"], ct: CancellationToken);
+}
@@ -0,0 +1,184 @@
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+using Hex1b;
+using Hex1b.Animation;
+using Hex1b.Diagnostics;
+using Hex1b.Nodes;
+using Hex1b.Widgets;
+
+namespace Hex1b.Tests.Animation;
+
+[TestClass]
+public class AnimationClockTests
+{
+    [TestMethod]
+    public void RequestFrame_SchedulesOneTick_ForManyPanels()
+    {
+        var scheduled = new List<(TimeSpan delay, Action callback)>();
+        var clock = new AnimationClock(TimeSpan.FromMilliseconds(16), (delay, cb) => scheduled.Add((delay, cb)), null);
+
+        clock.RequestFrame(new StatePanelNode(), 1);
+        clock.RequestFrame(new StatePanelNode(), 2);
+        clock.RequestFrame(new StatePanelNode(), 3);
+
+        Assert.HasCount(1, scheduled);
+        Assert.AreEqual(TimeSpan.FromMilliseconds(16), scheduled[0].delay);
+        Assert.IsTrue(clock.IsTicking);
+    }
+
+    [TestMethod]
+    public void Tick_MarksRequestingPanelsDirty_AndInvalidatesOnce()
+    {
+        var scheduled = new List<Action>();
+        var invalidations = 0;
+        var clock = new AnimationClock(TimeSpan.FromMilliseconds(16), (_, cb) => scheduled.Add(cb), () => invalidations++);
+        var first = new StatePanelNode();
+        var second = new StatePanelNode();
+        var idle = new StatePanelNode();
+        foreach (var node in new[] { first, second, idle })
+            node.ClearDirty();
+
+        clock.RequestFrame(first, 1);
+        clock.RequestFrame(second, 1);
+        scheduled[0]();
+
+        Assert.IsTrue(first.IsDirty);
+        Assert.IsTrue(second.IsDirty);
+        Assert.IsFalse(idle.IsDirty);
+        Assert.AreEqual(1, invalidations);
+    }
+
+    [TestMethod]
+    public void Tick_StopsTicking_WhenNoPanelRequestsAgain()
+    {
+        var scheduled = new List<Action>();
+        var clock = new AnimationClock(TimeSpan.FromMilliseconds(16), (_, cb) => scheduled.Add(cb), null);
+
+        clock.RequestFrame(new StatePanelNode(), 1);
+        scheduled[0]();
+
+        Assert.IsFalse(clock.IsTicking);
+        Assert.HasCount(1, scheduled);
+    }
+
+    [TestMethod]
+    public void Tick_CountsEachPanelOnce_WhenFramesRepeatBetweenTicks()
+    {
+        var scheduled = new List<Action>();
+        var clock = new AnimationClock(TimeSpan.FromMilliseconds(16), (_, cb) => scheduled.Add(cb), null);
+        var node = new StatePanelNode();
+
+        // Two frames (e.g. driven by input) before the tick fires
+        clock.RequestFrame(node, 3);
+        clock.RequestFrame(node, 2);
+        scheduled[0]();
+
+        Assert.AreEqual(2, clock.ActiveAnimations);
+    }
+
+    [TestMethod]
+    public void Tick_RecordsActiveAnimationMetrics()
+    {
+        using var metrics = new Hex1bMetrics();
+        var active = new List<int>();
+        long ticks = 0;
+
+        using var listener = new MeterListener();
+        listener.InstrumentPublished = (instrument, listener) =>
+        {
+            if (ReferenceEquals(instrument.Meter, metrics.Meter))
+                listener.EnableMeasurementEvents(instrument);
+        };
+        listener.SetMeasurementEventCallback<int>((inst, value, tags, state) =>
+        {
+            if (inst.Name == "hex1b.animation.active") active.Add(value);
+        });
+        listener.SetMeasurementEventCallback<long>((inst, value, tags, state) =>
+        {
+            if (inst.Name == "hex1b.animation.ticks") ticks += value;
+        });
+        listener.Start();
+
+        var scheduled = new List<Action>();
+        var clock = new AnimationClock(TimeSpan.FromMilliseconds(16), (_, cb) => scheduled.Add(cb), null, metrics);
+        clock.RequestFrame(new StatePanelNode(), 2);
+        clock.RequestFrame(new StatePanelNode(), 3);
+        scheduled[0]();
+
+        Assert.AreEqual(1, ticks);
+        Assert.HasCount(1, active);
+        Assert.AreEqual(5, active[0]);
+    }
+
+    [TestMethod]
+    public async Task Reconcile_WithClock_AdvancesPanelsToFrameTimestamp()
+    {
+        var scheduled = new List<Action>();
+        var clock = new AnimationClock(TimeSpan.FromMilliseconds(16), (_, cb) => scheduled.Add(cb), null);
+        var context = ReconcileContext.CreateRoot();
+        context.AnimationClock = clock;
+        var keyA = new object();
+        var keyB = new object();
+        var progress = new Dictionary<object, double>();
+
+        VStackWidget Build() => new([Panel(keyA), Panel(keyB)]);
+
+        StatePanelWidget Panel(object key) => new(key, sp =>
+        {
+            var anim = sp.GetAnimations().Get<NumericAnimator<double>>("fade", a =>
+            {
+                a.Duration = TimeSpan.FromSeconds(10);
+            });
+            progress[key] = anim.RawProgress;
+            return new TextBlockWidget("test");
+        });
+
+        var start = Stopwatch.GetTimestamp();
+        clock.BeginFrame(start);
+        var root = await Build().ReconcileAsync(null, context);
+
+        // Both panels request the next frame through a single tick
+        Assert.HasCount(1, scheduled);
+        scheduled[0]();
+
+        // Second frame one second later: both panels advance by exactly that second,
+        // however long reconciling the first one takes
+        clock.BeginFrame(start + Stopwatch.Frequency);
+        await Build().ReconcileAsync(root, context);
+
+        Assert.AreEqual(0.1, progress[keyA], 1e-9);
+        Assert.AreEqual(0.1, progress[keyB], 1e-9);
+        Assert.HasCount(2, scheduled);
+    }
+
+    [TestMethod]
+    public async Task Reconcile_WithClock_StopsRequesting_WhenAnimationsComplete()
+    {
+        var scheduled = new List<Action>();
+        var clock = new AnimationClock(TimeSpan.FromMilliseconds(16), (_, cb) => scheduled.Add(cb), null);
+        var context = ReconcileContext.CreateRoot();
+        context.AnimationClock = clock;
+        var key = new object();
+
+        StatePanelWidget Build() => new(key, sp =>
+        {
+            sp.GetAnimations().Get<NumericAnimator<double>>("fade", a =>
+            {
+                a.Duration = TimeSpan.FromMilliseconds(100);
+            });
+            return new TextBlockWidget("test");
+        });
+
+        var start = Stopwatch.GetTimestamp();
+        clock.BeginFrame(start);
+        var node = await Build().ReconcileAsync(null, context);
+        scheduled[0]();
+
+        // Past the animation's duration, nothing is left to tick
+        clock.BeginFrame(start + Stopwatch.Frequency);
+        await Build().ReconcileAsync(node, context);
+
+        Assert.HasCount(1, scheduled);
+        Assert.IsFalse(clock.IsTicking);
+    }
+}
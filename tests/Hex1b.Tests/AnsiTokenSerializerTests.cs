@@ -454,5 +454,17 @@ public class AnsiTokenSerializerTests
         Assert.AreEqual("", endLink.Payload);
     }
 
+    [TestMethod]
+    public void RoundTrip_ResetAndTabSequences_PreservesTokens()
+    {
+        var input = "\x1bc\x1b#8\x1b[g\x1b[3g\x1b[1\"q";
+        var tokens = AnsiTokenizer.Tokenize(input);
+        var output = AnsiTokenSerializer.Serialize(tokens);
+
+        Assert.AreEqual(input, output);
+        CollectionAssert.AreEqual(tokens.ToList(), AnsiTokenizer.Tokenize(output).ToList());
+        Assert.AreEqual(input, System.Text.Encoding.UTF8.GetString(AnsiTokenUtf8Serializer.Serialize(tokens).Span));
+    }
+
     #endregion
 }
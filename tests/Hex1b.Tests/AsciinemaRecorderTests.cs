@@ -351,6 +351,246 @@ public class AsciinemaRecorderTests : IDisposable
         Assert.Contains("Hello!", content);
     }
 
+    private static async Task<IHex1bTerminalWorkloadFilter> StartSessionAsync(AsciinemaRecorder recorder)
+    {
+        var filter = (IHex1bTerminalWorkloadFilter)recorder;
+        await filter.OnSessionStartAsync(80, 24, DateTimeOffset.UtcNow, TestContext.Current.CancellationToken);
+        return filter;
+    }
+
+    private static async Task<List<(double Time, string Code, string Data)>> ReadEventsAsync(string path)
+    {
+        var lines = await File.ReadAllLinesAsync(path, TestContext.Current.CancellationToken);
+        return lines.Skip(1)
+            .Where(l => l.Length > 0)
+            .Select(l => JsonDocument.Parse(l).RootElement)
+            .Select(e => (e[0].GetDouble(), e[1].GetString()!, e[2].GetString()!))
+            .ToList();
+    }
+
+    [TestMethod]
+    public async Task Backpressure_Block_WritesFullQueueWithoutLosingEvents()
+    {
+        var tempFile = GetTempFile();
+        var recorder = new AsciinemaRecorder(tempFile, new AsciinemaRecorderOptions { AutoFlush = false, QueueCapacity = 2 });
+        var filter = await StartSessionAsync(recorder);
+
+        for (int i = 0; i < 5; i++)
+            await filter.OnOutputAsync(AnsiTokenizer.Tokenize($"e{i}"), TimeSpan.FromSeconds(i), TestContext.Current.CancellationToken);
+
+        // The full queue was written out instead of waiting for a flush
+        Assert.IsLessThanOrEqualTo(2, recorder.PendingEventCount);
+        await recorder.FlushAsync(TestContext.Current.CancellationToken);
+
+        var events = await ReadEventsAsync(tempFile);
+        CollectionAssert.AreEqual(new[] { "e0", "e1", "e2", "e3", "e4" }, events.Select(e => e.Data).ToArray());
+        Assert.AreEqual(0, recorder.DroppedEventCount);
+        await recorder.DisposeAsync();
+    }
+
+    [TestMethod]
+    public async Task Backpressure_DropWithMarker_RecordsDroppedCount()
+    {
+        var tempFile = GetTempFile();
+        var recorder = new AsciinemaRecorder(tempFile, new AsciinemaRecorderOptions
+        {
+            AutoFlush = false,
+            QueueCapacity = 2,
+            BackpressurePolicy = AsciinemaBackpressurePolicy.DropWithMarker
+        });
+        var filter = await StartSessionAsync(recorder);
+
+        for (int i = 0; i < 5; i++)
+            await filter.OnOutputAsync(AnsiTokenizer.Tokenize($"e{i}"), TimeSpan.FromSeconds(i), TestContext.Current.CancellationToken);
+        await recorder.FlushAsync(TestContext.Current.CancellationToken);
+        await filter.OnOutputAsync(AnsiTokenizer.Tokenize("after"), TimeSpan.FromSeconds(10), TestContext.Current.CancellationToken);
+        await recorder.FlushAsync(TestContext.Current.CancellationToken);
+
+        var events = await ReadEventsAsync(tempFile);
+        Assert.AreEqual(3, recorder.DroppedEventCount);
+        CollectionAssert.AreEqual(
+            new[] { "o:e0", "o:e1", "m:hex1b: dropped 3 events", "o:after" },
+            events.Select(e => $"{e.Code}:{e.Data}").ToArray());
+        Assert.AreEqual(4.0, events[2].Time);
+        await recorder.DisposeAsync();
+    }
+
+    [TestMethod]
+    public async Task Backpressure_Coalesce_MergesOutputInOrder()
+    {
+        var tempFile = GetTempFile();
+        var recorder = new AsciinemaRecorder(tempFile, new AsciinemaRecorderOptions
+        {
+            AutoFlush = false,
+            QueueCapacity = 2,
+            BackpressurePolicy = AsciinemaBackpressurePolicy.Coalesce
+        });
+        var filter = await StartSessionAsync(recorder);
+
+        for (int i = 0; i < 5; i++)
+            await filter.OnOutputAsync(AnsiTokenizer.Tokenize($"e{i}"), TimeSpan.FromSeconds(i), TestContext.Current.CancellationToken);
+        Assert.AreEqual(3, recorder.PendingEventCount);
+
+        // Non-output events are not coalesced; they wait behind the merged output
+        await filter.OnResizeAsync(100, 30, TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+        await recorder.FlushAsync(TestContext.Current.CancellationToken);
+
+        var events = await ReadEventsAsync(tempFile);
+        Assert.AreEqual(2, recorder.CoalescedEventCount);
+        CollectionAssert.AreEqual(
+            new[] { "o:e0", "o:e1", "o:e2e3e4", "r:100x30" },
+            events.Select(e => $"{e.Code}:{e.Data}").ToArray());
+        Assert.AreEqual(2.0, events[2].Time);
+        await recorder.DisposeAsync();
+    }
+
+    [TestMethod]
+    public async Task AutoFlush_BackgroundWriterPreservesOrderUnderLoad()
+    {
+        var tempFile = GetTempFile();
+        var recorder = new AsciinemaRecorder(tempFile, new AsciinemaRecorderOptions { QueueCapacity = 8 });
+        var filter = await StartSessionAsync(recorder);
+
+        for (int i = 0; i < 1000; i++)
+            await filter.OnOutputAsync(AnsiTokenizer.Tokenize($"line {i}\r\n"), TimeSpan.FromMilliseconds(i), TestContext.Current.CancellationToken);
+        await recorder.FlushAsync(TestContext.Current.CancellationToken);
+
+        var events = await ReadEventsAsync(tempFile);
+        CollectionAssert.AreEqual(
+            Enumerable.Range(0, 1000).Select(i => $"line {i}\r\n").ToArray(),
+            events.Select(e => e.Data).ToArray());
+        Assert.AreEqual(0, recorder.PendingEventCount);
+        await recorder.DisposeAsync();
+    }
+
+    [TestMethod]
+    public async Task AutoFlush_WriteFails_OutputDoesNotBlockAndErrorIsReported()
+    {
+        // The file can't be created: its directory doesn't exist
+        var tempFile = Path.Combine(Path.GetTempPath(), $"hex1b_test_{Guid.NewGuid()}", "recording.cast");
+        var recorder = new AsciinemaRecorder(tempFile, new AsciinemaRecorderOptions { QueueCapacity = 2 });
+        var filter = await StartSessionAsync(recorder);
+
+        var output = Task.Run(async () =>
+        {
+            for (int i = 0; i < 50; i++)
+                await filter.OnOutputAsync(AnsiTokenizer.Tokenize($"e{i}"), TimeSpan.FromMilliseconds(i), TestContext.Current.CancellationToken);
+        }, TestContext.Current.CancellationToken);
+        await output.WaitAsync(TimeSpan.FromSeconds(10), TestContext.Current.CancellationToken);
+
+        await Assert.ThrowsAsync<DirectoryNotFoundException>(() => recorder.FlushAsync(TestContext.Current.CancellationToken));
+        await Assert.ThrowsAsync<DirectoryNotFoundException>(() => recorder.StopRecordingAsync(TestContext.Current.CancellationToken));
+        Assert.IsGreaterThan(0L, recorder.DroppedEventCount);
+        Assert.IsFalse(recorder.IsRecording);
+        await recorder.DisposeAsync();
+    }
+
+    [TestMethod]
+    public async Task FlushAsync_FirstWriteFails_NextWriteStartsWithHeaderAndDropMarker()
+    {
+        var directory = Path.Combine(Path.GetTempPath(), $"hex1b_test_{Guid.NewGuid()}");
+        var tempFile = Path.Combine(directory, "recording.cast");
+        var recorder = new AsciinemaRecorder(tempFile, new AsciinemaRecorderOptions { AutoFlush = false });
+        var filter = await StartSessionAsync(recorder);
+
+        try
+        {
+            await filter.OnOutputAsync(AnsiTokenizer.Tokenize("lost"), TimeSpan.FromSeconds(1), TestContext.Current.CancellationToken);
+            await Assert.ThrowsAsync<DirectoryNotFoundException>(() => recorder.FlushAsync(TestContext.Current.CancellationToken));
+
+            Directory.CreateDirectory(directory);
+            await filter.OnOutputAsync(AnsiTokenizer.Tokenize("kept"), TimeSpan.FromSeconds(2), TestContext.Current.CancellationToken);
+            await recorder.FlushAsync(TestContext.Current.CancellationToken);
+
+            var lines = await File.ReadAllLinesAsync(tempFile, TestContext.Current.CancellationToken);
+            Assert.AreEqual(2, JsonDocument.Parse(lines[0]).RootElement.GetProperty("version").GetInt32());
+            var events = await ReadEventsAsync(tempFile);
+            CollectionAssert.AreEqual(
+                new[] { "m:hex1b: dropped 1 events", "o:kept" },
+                events.Select(e => $"{e.Code}:{e.Data}").ToArray());
+            Assert.AreEqual(1.0, events[0].Time);
+            Assert.AreEqual(1, recorder.DroppedEventCount);
+            await recorder.DisposeAsync();
+        }
+        finally
+        {
+            if (Directory.Exists(directory))
+                Directory.Delete(directory, recursive: true);
+        }
+    }
+
+    [TestMethod]
+    public async Task AddMarker_QueueFullUnderBlock_DropsInsteadOfWaiting()
+    {
+        var tempFile = GetTempFile();
+        var recorder = new AsciinemaRecorder(tempFile, new AsciinemaRecorderOptions { AutoFlush = false, QueueCapacity = 2 });
+        var filter = await StartSessionAsync(recorder);
+
+        await filter.OnOutputAsync(AnsiTokenizer.Tokenize("e0"), TimeSpan.FromSeconds(0), TestContext.Current.CancellationToken);
+        await filter.OnOutputAsync(AnsiTokenizer.Tokenize("e1"), TimeSpan.FromSeconds(1), TestContext.Current.CancellationToken);
+        recorder.AddMarker("chapter", TimeSpan.FromSeconds(2));
+        await recorder.FlushAsync(TestContext.Current.CancellationToken);
+
+        var events = await ReadEventsAsync(tempFile);
+        Assert.AreEqual(1, recorder.DroppedEventCount);
+        CollectionAssert.AreEqual(
+            new[] { "o:e0", "o:e1", "m:hex1b: dropped 1 events" },
+            events.Select(e => $"{e.Code}:{e.Data}").ToArray());
+        await recorder.DisposeAsync();
+    }
+
+    [TestMethod]
+    public async Task AddMarkerAsync_QueueFullUnderBlock_WaitsForRoom()
+    {
+        var tempFile = GetTempFile();
+        var recorder = new AsciinemaRecorder(tempFile, new AsciinemaRecorderOptions { AutoFlush = false, QueueCapacity = 2 });
+        var filter = await StartSessionAsync(recorder);
+
+        await filter.OnOutputAsync(AnsiTokenizer.Tokenize("e0"), TimeSpan.FromSeconds(0), TestContext.Current.CancellationToken);
+        await filter.OnOutputAsync(AnsiTokenizer.Tokenize("e1"), TimeSpan.FromSeconds(1), TestContext.Current.CancellationToken);
+        await recorder.AddMarkerAsync("chapter", TimeSpan.FromSeconds(2), TestContext.Current.CancellationToken);
+        await recorder.FlushAsync(TestContext.Current.CancellationToken);
+
+        var events = await ReadEventsAsync(tempFile);
+        Assert.AreEqual(0, recorder.DroppedEventCount);
+        CollectionAssert.AreEqual(
+            new[] { "o:e0", "o:e1", "m:chapter" },
+            events.Select(e => $"{e.Code}:{e.Data}").ToArray());
+        await recorder.DisposeAsync();
+    }
+
+    [TestMethod]
+    public async Task StartRecordingAsync_WhileStopping_WaitsForPreviousWriter()
+    {
+        var firstFile = GetTempFile();
+        var secondFile = GetTempFile();
+        var recorder = new AsciinemaRecorder(firstFile, new AsciinemaRecorderOptions { QueueCapacity = 8 });
+        var filter = await StartSessionAsync(recorder);
+
+        for (int i = 0; i < 100; i++)
+            await filter.OnOutputAsync(AnsiTokenizer.Tokenize($"first {i}\r\n"), TimeSpan.FromMilliseconds(i), TestContext.Current.CancellationToken);
+
+        // Restart without waiting for the stop
+        var stop = recorder.StopRecordingAsync(TestContext.Current.CancellationToken);
+        await recorder.StartRecordingAsync(secondFile, new AsciinemaRecorderOptions { QueueCapacity = 8 }, TestContext.Current.CancellationToken);
+        Assert.IsTrue(stop.IsCompleted);
+        Assert.AreEqual(firstFile, await stop);
+
+        for (int i = 0; i < 100; i++)
+            await filter.OnOutputAsync(AnsiTokenizer.Tokenize($"second {i}\r\n"), TimeSpan.FromMilliseconds(i), TestContext.Current.CancellationToken);
+        await recorder.StopRecordingAsync(TestContext.Current.CancellationToken);
+
+        var first = await ReadEventsAsync(firstFile);
+        var second = await ReadEventsAsync(secondFile);
+        CollectionAssert.AreEqual(
+            Enumerable.Range(0, 100).Select(i => $"first {i}\r\n").ToArray(),
+            first.Select(e => e.Data).ToArray());
+        CollectionAssert.AreEqual(
+            Enumerable.Range(0, 100).Select(i => $"second {i}\r\n").ToArray(),
+            second.Select(e => e.Data).ToArray());
+        await recorder.DisposeAsync();
+    }
+
     [TestMethod]
     public async Task CaptureCast_AttachesToTestResults()
     {
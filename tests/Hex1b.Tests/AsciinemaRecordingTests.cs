@@ -0,0 +1,222 @@
+using System.Buffers;
+using System.Text;
+using Hex1b.Tokens;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for the streaming asciicast parser and keyframe-based seeking in <see cref="AsciinemaRecording"/>.
+/// </summary>
+[TestClass]
+public class AsciinemaRecordingTests : IDisposable
+{
+    private readonly List<string> _tempFiles = new();
+
+    private string GetTempFile()
+    {
+        var path = Path.Combine(Path.GetTempPath(), $"hex1b_test_{Guid.NewGuid()}.cast");
+        _tempFiles.Add(path);
+        return path;
+    }
+
+    public void Dispose()
+    {
+        foreach (var file in _tempFiles)
+        {
+            try { File.Delete(file); } catch { }
+        }
+    }
+
+    private static Hex1bTerminal CreateTerminal(Hex1bAppWorkloadAdapter workload, int width, int height)
+        => Hex1bTerminal.CreateBuilder().WithWorkload(workload).WithHeadless().WithDimensions(width, height).Build();
+
+    [TestMethod]
+    public void TryParseEvent_UnescapesDataIntoBuffer()
+    {
+        var line = Encoding.UTF8.GetBytes("[1.5, \"o\", \"\\u001b[31m\\\"hi\\\"\\r\\n\\u00e9 \\ud83d\\ude00\"]");
+        var data = new ArrayBufferWriter<byte>();
+
+        var parsed = AsciinemaEventReader.TryParseEvent(line, out var timestamp, out var eventType, data);
+
+        Assert.IsTrue(parsed);
+        Assert.AreEqual(1.5, timestamp);
+        Assert.AreEqual((byte)'o', eventType);
+        Assert.AreEqual("\x1b[31m\"hi\"\r\né 😀", Encoding.UTF8.GetString(data.WrittenSpan));
+    }
+
+    [TestMethod]
+    public void TryParseEvent_MalformedLine_ReturnsFalseWithoutWriting()
+    {
+        var data = new ArrayBufferWriter<byte>();
+
+        Assert.IsFalse(AsciinemaEventReader.TryParseEvent("[1.0, \"o\"]"u8, out _, out _, data));
+        Assert.IsFalse(AsciinemaEventReader.TryParseEvent("{\"o\": 1}"u8, out _, out _, data));
+        Assert.IsFalse(AsciinemaEventReader.TryParseEvent("[1.0, \"o\", \"\\ud800\"]"u8, out _, out _, data));
+        Assert.AreEqual(0, data.WrittenCount);
+    }
+
+    [TestMethod]
+    public void ParseHeader_SkipsOtherProperties()
+    {
+        var header = "\uFEFF{\"version\":2,\"env\":{\"width\":1,\"TERM\":\"xterm\"},\"width\":120,\"height\":40}";
+
+        var (width, height) = AsciinemaEventReader.ParseHeader(Encoding.UTF8.GetBytes(header));
+
+        Assert.AreEqual(120, width);
+        Assert.AreEqual(40, height);
+    }
+
+    [TestMethod]
+    public void TryParseSize_RequiresWidthXHeight()
+    {
+        Assert.IsTrue(AsciinemaEventReader.TryParseSize("100x30"u8, out var width, out var height));
+        Assert.AreEqual((100, 30), (width, height));
+        Assert.IsFalse(AsciinemaEventReader.TryParseSize("100x"u8, out _, out _));
+        Assert.IsFalse(AsciinemaEventReader.TryParseSize("100x30x2"u8, out _, out _));
+    }
+
+    [TestMethod]
+    public async Task ReadLineAsync_ReportsOffsetsAcrossBufferRefills()
+    {
+        var longLine = new string('x', 100_000);
+        var bytes = Encoding.UTF8.GetBytes($"first\r\n{longLine}\nlast");
+        using var reader = new AsciinemaEventReader(new MemoryStream(bytes));
+        var ct = TestContext.Current.CancellationToken;
+
+        Assert.IsTrue(await reader.ReadLineAsync(ct));
+        Assert.AreEqual("first", Encoding.UTF8.GetString(reader.Line.Span));
+        Assert.AreEqual(0, reader.LineOffset);
+
+        Assert.IsTrue(await reader.ReadLineAsync(ct));
+        Assert.AreEqual(longLine.Length, reader.Line.Length);
+        Assert.AreEqual(7, reader.LineOffset);
+
+        Assert.IsTrue(await reader.ReadLineAsync(ct));
+        Assert.AreEqual("last", Encoding.UTF8.GetString(reader.Line.Span));
+        Assert.AreEqual(7 + longLine.Length + 1, reader.LineOffset);
+
+        Assert.IsFalse(await reader.ReadLineAsync(ct));
+    }
+
+    [TestMethod]
+    public async Task LoadEventsAsync_IndexesEventsAndMarkers()
+    {
+        var filePath = GetTempFile();
+        await File.WriteAllLinesAsync(filePath,
+        [
+            "{\"version\":2,\"width\":80,\"height\":24}",
+            "[0.0,\"o\",\"hello\"]",
+            "[1.0,\"m\",\"Chapter \\\"one\\\"\"]",
+            "not an event",
+            "[2.5,\"o\",\"world\"]"
+        ], TestContext.Current.CancellationToken);
+        var recording = new AsciinemaRecording(filePath);
+
+        await recording.LoadEventsAsync(TestContext.Current.CancellationToken);
+        await recording.KeyframesBuilt;
+        recording.Close();
+
+        Assert.AreEqual(80, recording.Width);
+        Assert.AreEqual(24, recording.Height);
+        Assert.AreEqual(2.5, recording.Duration);
+        Assert.HasCount(1, recording.Markers);
+        Assert.AreEqual(new AsciinemaMarker(1.0, "Chapter \"one\""), recording.Markers[0]);
+    }
+
+    [TestMethod]
+    public async Task Seek_FromKeyframe_MatchesFullReplay()
+    {
+        const int width = 30;
+        const int height = 6;
+        var filePath = GetTempFile();
+        var lines = new List<string> { $"{{\"version\":2,\"width\":{width},\"height\":{height}}}" };
+        var outputs = new List<string>();
+        for (int i = 0; i < 200; i++)
+        {
+            // The color is set in one event and used in the next, so keyframes must carry the pen
+            var output = i % 2 == 0 ? $"\x1b[3{i % 7 + 1}m" : $"line {i} é\r\n";
+            if (i == 120)
+                output = "\x1b[?1049h\x1b[2;5r\x1b[?25l";
+            outputs.Add(output);
+            lines.Add($"[{i * 0.5:0.0},\"o\",{System.Text.Json.JsonSerializer.Serialize(output)}]");
+        }
+        await File.WriteAllLinesAsync(filePath, lines, TestContext.Current.CancellationToken);
+
+        var recording = new AsciinemaRecording(filePath) { KeyframeOutputBytes = 256 };
+        await recording.LoadEventsAsync(TestContext.Current.CancellationToken);
+        await recording.KeyframesBuilt;
+        Assert.IsGreaterThan(3, recording.KeyframeCount);
+
+        using var seekWorkload = new Hex1bAppWorkloadAdapter();
+        using var seekTerminal = CreateTerminal(seekWorkload, width, height);
+        var writes = new List<int>();
+        recording.SetCallbacks(
+            output =>
+            {
+                writes.Add(output.Length);
+                seekTerminal.ApplyTokens(AnsiTokenizer.Tokenize(Encoding.UTF8.GetString(output.Span)));
+            },
+            () => seekTerminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[2J\x1b[H")));
+
+        foreach (var target in new[] { 99.0, 30.5, 75.0 })
+        {
+            var targetIndex = (int)(target / 0.5);
+            writes.Clear();
+            recording.ProcessSeek(target);
+
+            using var replayWorkload = new Hex1bAppWorkloadAdapter();
+            using var replayTerminal = CreateTerminal(replayWorkload, width, height);
+            replayTerminal.ApplyTokens(AnsiTokenizer.Tokenize(string.Concat(outputs.Take(targetIndex + 1))));
+            // Carry on writing after the seek; both terminals must continue identically
+            const string next = "next";
+            seekTerminal.ApplyTokens(AnsiTokenizer.Tokenize(next));
+            replayTerminal.ApplyTokens(AnsiTokenizer.Tokenize(next));
+
+            using var expected = replayTerminal.CreateSnapshot();
+            using var actual = seekTerminal.CreateSnapshot();
+            for (int y = 0; y < height; y++)
+                Assert.AreEqual(expected.GetLine(y), actual.GetLine(y), $"row {y} after seek to {target}");
+            Assert.AreEqual((expected.CursorX, expected.CursorY), (actual.CursorX, actual.CursorY));
+            Assert.AreEqual(expected.InAlternateScreen, actual.InAlternateScreen);
+            Assert.AreEqual(expected.CursorVisible, actual.CursorVisible);
+            Assert.IsTrue(Hex1bTerminalRegionExtensions.ColorsEqual(
+                expected.GetCell(expected.CursorX - 1, expected.CursorY).Foreground,
+                actual.GetCell(actual.CursorX - 1, actual.CursorY).Foreground));
+
+            // The keyframe is restored in one write, then only the tail after it is replayed
+            Assert.IsLessThanOrEqualTo(2, writes.Count);
+            Assert.IsLessThan(string.Concat(outputs.Take(targetIndex + 1)).Length, writes.Skip(1).Sum());
+            Assert.AreEqual(target, recording.CurrentPosition);
+        }
+
+        recording.Close();
+    }
+
+    [TestMethod]
+    public void CaptureState_RestoresScreenCursorAndModes()
+    {
+        using var sourceWorkload = new Hex1bAppWorkloadAdapter();
+        using var source = CreateTerminal(sourceWorkload, 20, 5);
+        source.ApplyTokens(AnsiTokenizer.Tokenize("top\r\n\x1b[?1049h\x1b[1;32malt\x1b[3;4r\x1b[?2004h\x1b[4;7H"));
+
+        var state = OffscreenTerminal.CaptureState(source);
+
+        using var targetWorkload = new Hex1bAppWorkloadAdapter();
+        using var target = CreateTerminal(targetWorkload, 20, 5);
+        target.ApplyTokens(AnsiTokenizer.Tokenize("junk"));
+        target.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[2J\x1b[H" + Encoding.UTF8.GetString(state) + "!"));
+        source.ApplyTokens(AnsiTokenizer.Tokenize("!"));
+
+        using var expected = source.CreateSnapshot();
+        using var actual = target.CreateSnapshot();
+        Assert.IsTrue(actual.InAlternateScreen);
+        Assert.IsTrue(actual.BracketedPasteEnabled);
+        Assert.AreEqual("alt", actual.GetLineTrimmed(1));
+        Assert.AreEqual(expected.GetLine(3), actual.GetLine(3));
+        Assert.AreEqual((expected.CursorX, expected.CursorY), (actual.CursorX, actual.CursorY));
+        var cell = actual.GetCell(6, 3);
+        Assert.AreEqual("!", cell.Character);
+        Assert.AreEqual(CellAttributes.Bold, cell.Attributes & CellAttributes.Bold);
+        Assert.IsTrue(Hex1bTerminalRegionExtensions.ColorsEqual(expected.GetCell(6, 3).Foreground, cell.Foreground));
+    }
+}
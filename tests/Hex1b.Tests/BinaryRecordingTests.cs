@@ -0,0 +1,264 @@
+using System.Buffers;
+using System.Text;
+using Hex1b.Tokens;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for the binary recording format, <see cref="BinaryRecorder"/>,
+/// <see cref="BinaryRecordingWorkloadAdapter"/> and <see cref="BinaryRecordingConverter"/>.
+/// </summary>
+[TestClass]
+public class BinaryRecordingTests : IDisposable
+{
+    private readonly List<string> _tempFiles = new();
+
+    private string GetTempFile(string extension)
+    {
+        var path = Path.Combine(Path.GetTempPath(), $"hex1b_test_{Guid.NewGuid()}{extension}");
+        _tempFiles.Add(path);
+        return path;
+    }
+
+    public void Dispose()
+    {
+        foreach (var file in _tempFiles)
+        {
+            try { File.Delete(file); } catch { }
+        }
+    }
+
+    private static List<string> ReadEventLines(string castPath)
+        => File.ReadAllLines(castPath).Skip(1).Where(l => l.Length > 0).ToList();
+
+    [TestMethod]
+    public void VarUInt_RoundTripsBoundaryValues()
+    {
+        var buffer = new ArrayBufferWriter<byte>();
+        ulong[] values = [0, 1, 127, 128, 16_383, 16_384, uint.MaxValue, ulong.MaxValue];
+        foreach (var value in values)
+            BinaryRecordingFormat.WriteVarUInt(buffer, value);
+
+        var position = 0;
+        foreach (var value in values)
+        {
+            Assert.IsTrue(BinaryRecordingFormat.TryReadVarUInt(buffer.WrittenSpan, ref position, out var read));
+            Assert.AreEqual(value, read);
+        }
+        Assert.AreEqual(buffer.WrittenCount, position);
+        Assert.IsFalse(BinaryRecordingFormat.TryReadVarUInt([0x80, 0x80], ref position, out _));
+
+        foreach (var delta in new long[] { 0, -1, 1, long.MinValue, long.MaxValue })
+            Assert.AreEqual(delta, BinaryRecordingFormat.UnZigZag(BinaryRecordingFormat.ZigZag(delta)));
+    }
+
+    [TestMethod]
+    [DataRow(false)]
+    [DataRow(true)]
+    public async Task Blocks_RoundTripEvents(bool compress)
+    {
+        var output = new ArrayBufferWriter<byte>();
+        BinaryRecordingFormat.WriteFileHeader(output, "{\"version\":2,\"width\":80,\"height\":24}"u8);
+        var builder = new BinaryRecordingBlockBuilder();
+        for (int i = 0; i < 100; i++)
+            builder.Append((byte)'o', i * 1_500, $"line {i} \x1b[32mé\r\n");
+        builder.Append((byte)'r', 99_000, "100x30");
+        builder.Seal(output, compress);
+        builder.Append((byte)'m', 200_000, "");
+        builder.Seal(output, compress);
+
+        using var reader = await BinaryRecordingReader.OpenAsync(new MemoryStream(output.WrittenSpan.ToArray()), TestContext.Current.CancellationToken);
+        Assert.AreEqual((80, 24), (reader.Width, reader.Height));
+
+        var events = new List<(long Time, char Type, string Data)>();
+        while (await reader.ReadBlockAsync(ct: TestContext.Current.CancellationToken))
+        {
+            Assert.AreEqual(BinaryRecordingFormat.EventsBlock, reader.BlockKind);
+            var block = new BinaryRecordingEventBlockReader(reader.BlockPayload);
+            while (block.TryRead(out var evt))
+                events.Add((evt.TimeMicros, (char)evt.Type, Encoding.UTF8.GetString(evt.Data.Span)));
+        }
+
+        Assert.HasCount(102, events);
+        Assert.AreEqual((45_000L, 'o', "line 30 \x1b[32mé\r\n"), events[30]);
+        Assert.AreEqual((99_000L, 'r', "100x30"), events[100]);
+        Assert.AreEqual((200_000L, 'm', ""), events[101]);
+        if (compress)
+            Assert.IsLessThan(100 * 16, output.WrittenCount);
+    }
+
+    [TestMethod]
+    public async Task Reader_StopsAtTruncatedBlock()
+    {
+        var output = new ArrayBufferWriter<byte>();
+        BinaryRecordingFormat.WriteFileHeader(output, "{\"width\":10,\"height\":5}"u8);
+        var builder = new BinaryRecordingBlockBuilder();
+        builder.Append((byte)'o', 0, "first");
+        builder.Seal(output, compress: false);
+        var firstBlockEnd = output.WrittenCount;
+        builder.Append((byte)'o', 10, new string('x', 1000));
+        builder.Seal(output, compress: true);
+
+        var truncated = output.WrittenSpan[..(firstBlockEnd + (output.WrittenCount - firstBlockEnd) / 2)].ToArray();
+        using var reader = await BinaryRecordingReader.OpenAsync(new MemoryStream(truncated), TestContext.Current.CancellationToken);
+
+        Assert.IsTrue(await reader.ReadBlockAsync(ct: TestContext.Current.CancellationToken));
+        Assert.IsFalse(await reader.ReadBlockAsync(ct: TestContext.Current.CancellationToken));
+        await Assert.ThrowsExactlyAsync<InvalidDataException>(
+            () => BinaryRecordingReader.OpenAsync(new MemoryStream("HEX1BRE"u8.ToArray()), TestContext.Current.CancellationToken));
+    }
+
+    [TestMethod]
+    public async Task Converter_RoundTripsAsciicast()
+    {
+        var castPath = GetTempFile(".cast");
+        var binaryPath = GetTempFile(".h1rec");
+        var roundTripPath = GetTempFile(".cast");
+        var header = "{\"version\":2,\"width\":20,\"height\":4,\"timestamp\":1700000000,\"title\":\"t\",\"env\":{\"TERM\":\"xterm\"}}";
+        var lines = new List<string> { header };
+        for (int i = 0; i < 300; i++)
+        {
+            var data = i % 3 == 0 ? $"\x1b[3{i % 7 + 1}m\"quoted\" é 😀" : $"row {i}\r\n";
+            lines.Add($"[{i * 0.123457:0.######},\"o\",{System.Text.Json.JsonSerializer.Serialize(data)}]");
+        }
+        lines.Add("[40.5,\"i\",\"q\"]");
+        lines.Add("[41.25,\"r\",\"30x6\"]");
+        lines.Add("[42,\"m\",\"end\"]");
+        await File.WriteAllLinesAsync(castPath, lines, TestContext.Current.CancellationToken);
+
+        var options = new BinaryRecorderOptions { BlockSize = 512, KeyframeOutputBytes = 256 };
+        await BinaryRecordingConverter.FromAsciicastAsync(castPath, binaryPath, options, TestContext.Current.CancellationToken);
+        await BinaryRecordingConverter.ToAsciicastAsync(binaryPath, roundTripPath, TestContext.Current.CancellationToken);
+
+        Assert.AreEqual(header, File.ReadLines(roundTripPath).First());
+        var expected = ReadEventLines(castPath);
+        var actual = ReadEventLines(roundTripPath);
+        Assert.HasCount(expected.Count, actual);
+        var expectedData = new ArrayBufferWriter<byte>();
+        var actualData = new ArrayBufferWriter<byte>();
+        for (int i = 0; i < expected.Count; i++)
+        {
+            expectedData.Clear();
+            actualData.Clear();
+            Assert.IsTrue(AsciinemaEventReader.TryParseEvent(Encoding.UTF8.GetBytes(expected[i]), out var expectedTime, out var expectedType, expectedData));
+            Assert.IsTrue(AsciinemaEventReader.TryParseEvent(Encoding.UTF8.GetBytes(actual[i]), out var actualTime, out var actualType, actualData));
+            Assert.AreEqual(expectedTime, actualTime, 1e-9);
+            Assert.AreEqual(expectedType, actualType);
+            Assert.IsTrue(expectedData.WrittenSpan.SequenceEqual(actualData.WrittenSpan), $"event {i}");
+        }
+
+        // Converting from .cast regenerates keyframes
+        using var reader = await BinaryRecordingReader.OpenAsync(File.OpenRead(binaryPath), TestContext.Current.CancellationToken);
+        var keyframes = 0;
+        while (await reader.ReadBlockAsync(skipEvents: true, TestContext.Current.CancellationToken))
+        {
+            if (reader.BlockKind == BinaryRecordingFormat.KeyframeBlock)
+                keyframes++;
+        }
+        Assert.IsGreaterThan(3, keyframes);
+    }
+
+    [TestMethod]
+    public async Task Recorder_WritesEventsAndKeyframesFromTerminal()
+    {
+        var binaryPath = GetTempFile(".h1rec");
+        var castPath = GetTempFile(".cast");
+        using var workload = new Hex1bAppWorkloadAdapter();
+        var options = new Hex1bTerminalOptions
+        {
+            Width = 20,
+            Height = 4,
+            WorkloadAdapter = workload
+        };
+        var recorder = new BinaryRecorder(binaryPath, new BinaryRecorderOptions { Title = "bin", KeyframeOutputBytes = 1 });
+        options.WorkloadFilters.Add(recorder);
+        using var terminal = new Hex1bTerminal(options);
+        var filter = (IHex1bTerminalWorkloadFilter)recorder;
+        var ct = TestContext.Current.CancellationToken;
+
+        await filter.OnSessionStartAsync(20, 4, DateTimeOffset.UtcNow, ct);
+        foreach (var (text, seconds) in new[] { ("hello\r\n", 0.5), ("\x1b[1mworld", 1.0) })
+        {
+            // Filters see output before the terminal applies it; frames complete afterwards
+            var tokens = AnsiTokenizer.Tokenize(text);
+            await filter.OnOutputAsync(tokens, TimeSpan.FromSeconds(seconds), ct);
+            terminal.ApplyTokens(tokens);
+            await filter.OnFrameCompleteAsync(TimeSpan.FromSeconds(seconds), ct);
+        }
+        recorder.AddMarker("done", TimeSpan.FromSeconds(2));
+        await recorder.DisposeAsync();
+
+        using (var reader = await BinaryRecordingReader.OpenAsync(File.OpenRead(binaryPath), ct))
+        {
+            Assert.AreEqual((20, 4), (reader.Width, reader.Height));
+            var keyframes = new List<long>();
+            while (await reader.ReadBlockAsync(ct: ct))
+            {
+                if (reader.BlockKind == BinaryRecordingFormat.KeyframeBlock)
+                {
+                    Assert.IsTrue(BinaryRecordingFormat.TryParseKeyframe(reader.BlockPayload, out var keyframe));
+                    keyframes.Add(keyframe.TimeMicros);
+                }
+            }
+            CollectionAssert.AreEqual(new long[] { 500_000, 1_000_000 }, keyframes);
+        }
+
+        await BinaryRecordingConverter.ToAsciicastAsync(binaryPath, castPath, ct);
+        var lines = File.ReadAllLines(castPath);
+        StringAssert.Contains(lines[0], "\"title\":\"bin\"");
+        CollectionAssert.AreEqual(
+            new[] { "[0.5,\"o\",\"hello\\r\\n\"]", "[1,\"o\",\"\\u001B[1mworld\"]", "[2,\"m\",\"done\"]" },
+            lines.Skip(1).ToArray());
+    }
+
+    [TestMethod]
+    public async Task Playback_FromStartPosition_RestoresKeyframeThenTail()
+    {
+        var castPath = GetTempFile(".cast");
+        var binaryPath = GetTempFile(".h1rec");
+        var lines = new List<string> { "{\"version\":2,\"width\":20,\"height\":4}" };
+        var outputs = new List<string>();
+        for (int i = 0; i < 40; i++)
+        {
+            outputs.Add($"\x1b[3{i % 7 + 1}mline {i}\r\n");
+            lines.Add($"[{i * 0.25:0.00},\"o\",{System.Text.Json.JsonSerializer.Serialize(outputs[^1])}]");
+        }
+        await File.WriteAllLinesAsync(castPath, lines, TestContext.Current.CancellationToken);
+        await BinaryRecordingConverter.FromAsciicastAsync(castPath, binaryPath,
+            new BinaryRecorderOptions { KeyframeOutputBytes = 100 }, TestContext.Current.CancellationToken);
+
+        await using var adapter = new BinaryRecordingWorkloadAdapter(binaryPath)
+        {
+            StartPosition = TimeSpan.FromSeconds(7.5),
+            SpeedMultiplier = 100
+        };
+        await adapter.StartAsync(TestContext.Current.CancellationToken);
+
+        var writes = new List<string>();
+        while (true)
+        {
+            var data = await adapter.ReadOutputAsync(TestContext.Current.CancellationToken);
+            if (data.IsEmpty)
+                break;
+            writes.Add(Encoding.UTF8.GetString(data.Span));
+        }
+
+        // Keyframe state and the catch-up since it, then the remaining events one by one
+        Assert.IsLessThanOrEqualTo(2 + (40 - 31), writes.Count);
+        CollectionAssert.AreEqual(outputs.Skip(31).ToList(), writes.TakeLast(40 - 31).ToList());
+        Assert.IsLessThan(string.Concat(outputs.Take(31)).Length, writes.SkipLast(40 - 31).Skip(1).Sum(w => w.Length));
+
+        using var playedWorkload = new Hex1bAppWorkloadAdapter();
+        using var played = Hex1bTerminal.CreateBuilder().WithWorkload(playedWorkload).WithHeadless().WithDimensions(20, 4).Build();
+        played.ApplyTokens(AnsiTokenizer.Tokenize(string.Concat(writes)));
+        using var fullWorkload = new Hex1bAppWorkloadAdapter();
+        using var full = Hex1bTerminal.CreateBuilder().WithWorkload(fullWorkload).WithHeadless().WithDimensions(20, 4).Build();
+        full.ApplyTokens(AnsiTokenizer.Tokenize(string.Concat(outputs)));
+
+        using var expected = full.CreateSnapshot();
+        using var actual = played.CreateSnapshot();
+        for (int y = 0; y < 4; y++)
+            Assert.AreEqual(expected.GetLine(y), actual.GetLine(y));
+        Assert.AreEqual((expected.CursorX, expected.CursorY), (actual.CursorX, actual.CursorY));
+    }
+}
@@ -206,6 +206,57 @@ public class ConsolePresentationAdapterTests
         Assert.AreEqual("abc", Encoding.ASCII.GetString(input.Span));
     }
 
+    [TestMethod]
+    public async Task EnterRawModeAsync_WhenSyncOutputQueryResponds_EnablesSynchronizedOutput()
+    {
+        using var driver = new FakeConsoleDriver("\x1b[?2026;2$yabc");
+        await using var adapter = new ConsolePresentationAdapter(
+            driver,
+            kgpProbeTimeout: TimeSpan.FromMilliseconds(25));
+
+        await adapter.EnterRawModeAsync(TestContext.Current.CancellationToken);
+        var input = await adapter.ReadInputAsync(TestContext.Current.CancellationToken);
+
+        Assert.IsTrue(adapter.Capabilities.SupportsSynchronizedOutput);
+        Assert.Contains("\x1b[?2026$p", driver.WrittenText);
+        Assert.AreEqual("abc", Encoding.ASCII.GetString(input.Span));
+    }
+
+    [TestMethod]
+    public async Task EnterRawModeAsync_WhenSyncOutputModeIsUnknown_LeavesSynchronizedOutputDisabled()
+    {
+        using var driver = new FakeConsoleDriver("\x1b[?2026;0$y");
+        await using var adapter = new ConsolePresentationAdapter(
+            driver,
+            kgpProbeTimeout: TimeSpan.FromMilliseconds(25));
+
+        await adapter.EnterRawModeAsync(TestContext.Current.CancellationToken);
+
+        Assert.IsFalse(adapter.Capabilities.SupportsSynchronizedOutput);
+    }
+
+    [TestMethod]
+    public async Task WriteOutputAsync_WithSynchronizedOutput_WrapsFrameUntilFlush()
+    {
+        using var driver = new FakeConsoleDriver("\x1b[?2026;2$y");
+        await using var adapter = new ConsolePresentationAdapter(
+            driver,
+            kgpProbeTimeout: TimeSpan.FromMilliseconds(25));
+        await adapter.EnterRawModeAsync(TestContext.Current.CancellationToken);
+        var probeLength = driver.WrittenText.Length;
+        var flushes = driver.FlushCount;
+
+        await adapter.WriteOutputAsync(Encoding.ASCII.GetBytes("one"), TestContext.Current.CancellationToken);
+        await adapter.WriteOutputAsync(Encoding.ASCII.GetBytes("two"), TestContext.Current.CancellationToken);
+
+        Assert.AreEqual(flushes, driver.FlushCount);
+
+        await adapter.FlushAsync(TestContext.Current.CancellationToken);
+
+        Assert.AreEqual(flushes + 1, driver.FlushCount);
+        Assert.AreEqual("\x1b[?2026honetwo\x1b[?2026l", driver.WrittenText[probeLength..]);
+    }
+
     [TestMethod]
     public async Task ReadInputAsync_WhenConsoleInputEncodingIsLatin1_ConvertsInputBytesToUtf8()
     {
@@ -461,6 +512,10 @@ internal sealed class FakeConsoleDriver : IConsoleDriver
         return WaitForCancellationAsync(ct);
     }
 
+    public int FlushCount { get; private set; }
+
+    public long WriteCalls => FlushCount;
+
     public void Write(ReadOnlySpan<byte> data)
     {
         _written.AddRange(data.ToArray());
@@ -468,6 +523,7 @@ internal sealed class FakeConsoleDriver : IConsoleDriver
 
     public void Flush()
     {
+        FlushCount++;
     }
 
     public void DrainInput()
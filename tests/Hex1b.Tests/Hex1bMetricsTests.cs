@@ -42,6 +42,8 @@ public class Hex1bMetricsTests
             "hex1b.terminal.input.bytes",
             "hex1b.terminal.input.tokens",
             "hex1b.terminal.input.events",
+            "hex1b.animation.ticks",
+            "hex1b.animation.active",
             "hex1b.surface.diff.duration",
             "hex1b.surface.tokens.duration",
             "hex1b.surface.serialize.duration",
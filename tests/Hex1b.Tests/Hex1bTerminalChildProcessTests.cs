@@ -542,6 +542,145 @@ public class Hex1bTerminalChildProcessTests
         Assert.IsFalse(exists, $"Process {pid} should have been terminated");
     }
     
+    /// <summary>
+    /// Verifies that the spawned child owns the PTY as its controlling terminal and
+    /// sees exactly the environment it was given.
+    /// </summary>
+    [TestMethod]
+    [TestCategory("Unix")]
+    public async Task StartAsync_WithoutInheritedEnvironment_ChildGetsPtyAndExplicitEnvironment()
+    {
+        // Skip on non-Linux platforms - posix_spawn PTY support requires Linux
+        if (!OperatingSystem.IsLinux())
+            return;
+
+        await using var process = new Hex1bTerminalChildProcess(
+            "/bin/sh",
+            ["-c", "(exec </dev/tty) && echo \"ctty:$SPAWN_MARKER:$HOME:end\""],
+            workingDirectory: null,
+            environment: new Dictionary<string, string> { ["PATH"] = "/usr/bin:/bin", ["SPAWN_MARKER"] = "spawned" },
+            inheritEnvironment: false);
+
+        await process.StartAsync(TestContext.Current.CancellationToken);
+
+        var output = new StringBuilder();
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+        cts.CancelAfter(TimeSpan.FromSeconds(5));
+        try
+        {
+            while (!output.ToString().Contains(":end"))
+            {
+                var data = await process.ReadOutputAsync(cts.Token);
+                if (data.IsEmpty)
+                    break;
+                output.Append(Encoding.UTF8.GetString(data.Span));
+            }
+        }
+        catch (OperationCanceledException)
+        {
+            // Timeout
+        }
+
+        Assert.Contains("ctty:spawned::end", output.ToString());
+    }
+
+    /// <summary>
+    /// Verifies that a missing executable starts a child that exits with 127, whichever
+    /// way the PTY child is spawned.
+    /// </summary>
+    [TestMethod]
+    [TestCategory("Unix")]
+    [DataRow(false)]
+    [DataRow(true)]
+    public async Task StartAsync_MissingExecutable_ExitsWith127(bool forceForkPty)
+    {
+        // Skip on non-Linux platforms - PTY support requires Linux
+        if (!OperatingSystem.IsLinux())
+            return;
+
+        await using var handle = new UnixPtyHandle(forceForkPty ? UnixPtySpawnMode.ForkPty : UnixPtySpawnMode.Auto);
+        await handle.StartAsync(
+            "/nonexistent/hex1b-missing-executable",
+            [],
+            workingDirectory: null,
+            new Dictionary<string, string> { ["PATH"] = "/usr/bin:/bin" },
+            80,
+            24,
+            TestContext.Current.CancellationToken);
+
+        var exitCode = await handle.WaitForExitAsync(TestContext.Current.CancellationToken)
+            .WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+
+        Assert.AreEqual(127, exitCode);
+    }
+
+    /// <summary>
+    /// Verifies that the exit code is reported as soon as the child exits and that
+    /// a cancelled wait doesn't mark a running process as exited.
+    /// </summary>
+    [TestMethod]
+    [TestCategory("Unix")]
+    public async Task WaitForExitAsync_ReportsExitCode_AndCancellationLeavesProcessRunning()
+    {
+        // Skip on non-Linux platforms - PTY support requires Linux
+        if (!OperatingSystem.IsLinux())
+            return;
+
+        await using var process = new Hex1bTerminalChildProcess(
+            "/bin/sh",
+            ["-c", "read line; exit 7"]);
+
+        await process.StartAsync(TestContext.Current.CancellationToken);
+
+        using (var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken))
+        {
+            cts.CancelAfter(TimeSpan.FromMilliseconds(100));
+            await Assert.ThrowsAsync<OperationCanceledException>(() => process.WaitForExitAsync(cts.Token));
+        }
+        Assert.IsFalse(process.HasExited);
+
+        await process.WriteInputAsync(Encoding.UTF8.GetBytes("\n"), TestContext.Current.CancellationToken);
+        var exitCode = await process.WaitForExitAsync(TestContext.Current.CancellationToken)
+            .WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+
+        Assert.AreEqual(7, exitCode);
+        Assert.IsTrue(process.HasExited);
+    }
+
+    /// <summary>
+    /// Verifies that a large burst of output arrives complete and that reading ends
+    /// once the child has exited and its output is drained.
+    /// </summary>
+    [TestMethod]
+    [TestCategory("Unix")]
+    public async Task ReadOutputAsync_LargeBurst_ArrivesCompleteThenEnds()
+    {
+        // Skip on non-Linux platforms - PTY support requires Linux
+        if (!OperatingSystem.IsLinux())
+            return;
+
+        const int burstBytes = 200_000;
+        await using var process = new Hex1bTerminalChildProcess(
+            "/bin/sh",
+            ["-c", $"head -c {burstBytes} /dev/zero | tr '\\0' x"]);
+
+        await process.StartAsync(TestContext.Current.CancellationToken);
+
+        var received = 0;
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+        cts.CancelAfter(TimeSpan.FromSeconds(10));
+        while (true)
+        {
+            var data = await process.ReadOutputAsync(cts.Token);
+            if (data.IsEmpty)
+                break;
+            received += data.Span.Count((byte)'x');
+        }
+
+        Assert.IsFalse(cts.IsCancellationRequested, "Reading should end when the child exits");
+        Assert.AreEqual(burstBytes, received);
+    }
+
     private static bool ProcessExists(int pid)
     {
         try
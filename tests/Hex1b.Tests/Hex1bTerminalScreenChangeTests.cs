@@ -0,0 +1,170 @@
+using Hex1b.Automation;
+using Hex1b.Tokens;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for the screen generation counter, change signal and dirty-row tracking.
+/// </summary>
+[TestClass]
+public class Hex1bTerminalScreenChangeTests
+{
+    private static Hex1bTerminal CreateTerminal(int width = 20, int height = 5)
+    {
+        var workload = new Hex1bAppWorkloadAdapter();
+        return Hex1bTerminal.CreateBuilder()
+            .WithWorkload(workload)
+            .WithHeadless()
+            .WithDimensions(width, height)
+            .Build();
+    }
+
+    [TestMethod]
+    public void ApplyTokens_AdvancesScreenGeneration()
+    {
+        using var terminal = CreateTerminal();
+        var before = terminal.ScreenGeneration;
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("Hello"));
+
+        Assert.IsTrue(terminal.ScreenGeneration > before);
+    }
+
+    [TestMethod]
+    public void ApplyTokens_EmptyBatch_DoesNotAdvanceScreenGeneration()
+    {
+        using var terminal = CreateTerminal();
+        var before = terminal.ScreenGeneration;
+
+        terminal.ApplyTokens([]);
+
+        Assert.AreEqual(before, terminal.ScreenGeneration);
+    }
+
+    [TestMethod]
+    public void GetChangedRows_ReportsOnlyRowsWrittenSinceGeneration()
+    {
+        using var terminal = CreateTerminal();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("top"));
+        var generation = terminal.ScreenGeneration;
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[4;1Hrow four"));
+
+        var rows = terminal.GetChangedRows(generation);
+        CollectionAssert.Contains(rows, 3);
+        CollectionAssert.DoesNotContain(rows, 1);
+        CollectionAssert.DoesNotContain(rows, 2);
+    }
+
+    [TestMethod]
+    public void GetChangedRows_ClearScreen_ReportsAllRows()
+    {
+        using var terminal = CreateTerminal(height: 4);
+        var generation = terminal.ScreenGeneration;
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[2J"));
+
+        TestSeq.AreEqual(new[] { 0, 1, 2, 3 }, terminal.GetChangedRows(generation));
+    }
+
+    [TestMethod]
+    public void GetChangedRows_ScrollMarksScrollRegion()
+    {
+        using var terminal = CreateTerminal(height: 3);
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("A\r\nB\r\nC"));
+        var generation = terminal.ScreenGeneration;
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\r\nD"));
+
+        TestSeq.AreEqual(new[] { 0, 1, 2 }, terminal.GetChangedRows(generation));
+    }
+
+    [TestMethod]
+    public void GetChangedRows_AfterResize_ReportsEveryRow()
+    {
+        using var terminal = CreateTerminal(height: 3);
+        var generation = terminal.ScreenGeneration;
+
+        terminal.Resize(20, 4);
+
+        Assert.IsTrue(terminal.ScreenGeneration > generation);
+        TestSeq.AreEqual(new[] { 0, 1, 2, 3 }, terminal.GetChangedRows(generation));
+    }
+
+    [TestMethod]
+    public async Task WaitForScreenChangeAsync_CompletesWhenOutputIsApplied()
+    {
+        using var terminal = CreateTerminal();
+        var generation = terminal.ScreenGeneration;
+
+        var wait = terminal.WaitForScreenChangeAsync(generation, TestContext.Current.CancellationToken);
+        Assert.IsFalse(wait.IsCompleted);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("x"));
+
+        var newGeneration = await wait.WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+        Assert.IsTrue(newGeneration > generation);
+    }
+
+    [TestMethod]
+    public void WaitForScreenChangeAsync_AlreadyChanged_CompletesSynchronously()
+    {
+        using var terminal = CreateTerminal();
+        var generation = terminal.ScreenGeneration;
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("x"));
+
+        var wait = terminal.WaitForScreenChangeAsync(generation, TestContext.Current.CancellationToken);
+
+        Assert.IsTrue(wait.IsCompletedSuccessfully);
+    }
+
+    [TestMethod]
+    public async Task WaitForScreenChangeAsync_Cancelled_Throws()
+    {
+        using var terminal = CreateTerminal();
+        using var cts = new CancellationTokenSource();
+
+        var wait = terminal.WaitForScreenChangeAsync(terminal.ScreenGeneration, cts.Token);
+        cts.Cancel();
+
+        await Assert.ThrowsAsync<OperationCanceledException>(() => wait);
+    }
+
+    [TestMethod]
+    public void RowsContainText_OnlySearchesRequestedRows()
+    {
+        using var terminal = CreateTerminal();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("needle\r\nhay"));
+
+        Assert.IsTrue(terminal.RowsContainText("needle", [0]));
+        Assert.IsFalse(terminal.RowsContainText("needle", [1, 2]));
+    }
+
+    [TestMethod]
+    public void Snapshot_CapturesGeneration()
+    {
+        using var terminal = CreateTerminal();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("x"));
+
+        using var snapshot = terminal.CreateSnapshot();
+
+        Assert.AreEqual(terminal.ScreenGeneration, snapshot.Generation);
+    }
+
+    [TestMethod]
+    public async Task WaitUntil_WakesOnScreenChangeBeforePollInterval()
+    {
+        using var terminal = CreateTerminal();
+        var options = new Hex1bTerminalInputSequenceOptions { PollInterval = TimeSpan.FromMinutes(5) };
+
+        var wait = new Hex1bTerminalInputSequenceBuilder()
+            .WithOptions(options)
+            .WaitUntil(s => s.ContainsText("ready"), TimeSpan.FromMinutes(10))
+            .Build()
+            .ApplyAsync(terminal, TestContext.Current.CancellationToken);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("ready"));
+
+        await wait.WaitAsync(TimeSpan.FromSeconds(10), TestContext.Current.CancellationToken);
+    }
+}
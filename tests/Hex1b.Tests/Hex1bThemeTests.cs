@@ -0,0 +1,100 @@
+using Hex1b.Theming;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for theme value storage, fallback resolution and locked theme compilation.
+/// </summary>
+[TestClass]
+public class Hex1bThemeTests
+{
+    private static readonly Hex1bThemeElement<Hex1bColor> Base =
+        new("Hex1bThemeTests.Base", () => Hex1bColor.Red);
+
+    private static readonly Hex1bThemeElement<Hex1bColor> Derived =
+        new("Hex1bThemeTests.Derived", () => Hex1bColor.Green, Base);
+
+    [TestMethod]
+    [DataRow(false)]
+    [DataRow(true)]
+    public void Get_ResolvesSetValueThenFallbackThenDefault(bool locked)
+    {
+        var unset = new Hex1bTheme("Unset");
+        var baseSet = new Hex1bTheme("Base").Set(Base, Hex1bColor.Blue);
+        var derivedSet = new Hex1bTheme("Derived").Set(Base, Hex1bColor.Blue).Set(Derived, Hex1bColor.Yellow);
+        if (locked)
+        {
+            unset.Lock();
+            baseSet.Lock();
+            derivedSet.Lock();
+        }
+
+        // The default at the end of the chain applies, not the derived element's own
+        Assert.AreEqual(Hex1bColor.Red, unset.Get(Derived));
+        Assert.AreEqual(Hex1bColor.Blue, baseSet.Get(Derived));
+        Assert.AreEqual(Hex1bColor.Yellow, derivedSet.Get(Derived));
+        Assert.AreEqual(Hex1bColor.Blue, derivedSet.Get(Base));
+    }
+
+    [TestMethod]
+    public void Get_ElementCreatedAfterLock_IsResolved()
+    {
+        var theme = new Hex1bTheme("Test").Set(Base, Hex1bColor.Cyan).Lock();
+        Assert.AreEqual(Hex1bColor.Cyan, theme.Get(Base));
+
+        var late = new Hex1bThemeElement<Hex1bColor>("Hex1bThemeTests.Late", () => Hex1bColor.White, Base);
+
+        Assert.AreEqual(Hex1bColor.Cyan, theme.Get(late));
+        Assert.AreEqual(Hex1bColor.Cyan, theme.Get(Base));
+    }
+
+    [TestMethod]
+    public void Set_ElementsWithSameName_ShareValue()
+    {
+        var first = new Hex1bThemeElement<string>("Hex1bThemeTests.Shared", () => "first");
+        var second = new Hex1bThemeElement<string>("Hex1bThemeTests.Shared", () => "second");
+
+        var theme = new Hex1bTheme("Test").Set(first, "set");
+
+        Assert.AreEqual("set", theme.Get(second));
+        Assert.AreEqual("second", new Hex1bTheme("Empty").Lock().Get(second));
+    }
+
+    [TestMethod]
+    public void Constructor_SameDefinition_ReusesSlot()
+    {
+        static Hex1bThemeElement<string> Create() =>
+            new("Hex1bThemeTests.Recreated", () => "default");
+
+        var first = Create();
+        var second = Create();
+        var other = new Hex1bThemeElement<string>("Hex1bThemeTests.Recreated", () => "other");
+
+        Assert.AreEqual(first.Slot, second.Slot);
+        Assert.AreNotEqual(first.Slot, other.Slot);
+        Assert.AreEqual("other", new Hex1bTheme("Empty").Lock().Get(other));
+    }
+
+    [TestMethod]
+    public void Set_Null_FallsBackToDefault()
+    {
+        var element = new Hex1bThemeElement<string>("Hex1bThemeTests.Nullable", () => "default");
+
+        var theme = new Hex1bTheme("Test").Set(element, null!).Lock();
+
+        Assert.AreEqual("default", theme.Get(element));
+    }
+
+    [TestMethod]
+    public void Clone_CopiesValues_AndIsIndependent()
+    {
+        var original = new Hex1bTheme("Original").Set(Base, Hex1bColor.Blue).Lock();
+
+        var clone = original.Clone("Clone").Set(Derived, Hex1bColor.Magenta);
+
+        Assert.IsFalse(clone.IsLocked);
+        Assert.AreEqual(Hex1bColor.Blue, clone.Get(Base));
+        Assert.AreEqual(Hex1bColor.Magenta, clone.Get(Derived));
+        Assert.AreEqual(Hex1bColor.Blue, original.Get(Derived));
+    }
+}
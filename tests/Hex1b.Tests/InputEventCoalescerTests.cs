@@ -0,0 +1,96 @@
+using Hex1b.Input;
+
+namespace Hex1b.Tests;
+
+[TestClass]
+public class InputEventCoalescerTests
+{
+    [TestMethod]
+    public void Coalesce_ConsecutiveMouseMoves_KeepsLatestPosition()
+    {
+        var events = new List<Hex1bEvent>
+        {
+            new Hex1bMouseEvent(MouseButton.None, MouseAction.Move, 1, 1, Hex1bModifiers.None),
+            new Hex1bMouseEvent(MouseButton.None, MouseAction.Move, 2, 1, Hex1bModifiers.None),
+            new Hex1bMouseEvent(MouseButton.None, MouseAction.Move, 3, 2, Hex1bModifiers.None),
+        };
+
+        InputEventCoalescer.Coalesce(events);
+
+        var move = TestSeq.IsType<Hex1bMouseEvent>(TestSeq.Single(events));
+        Assert.AreEqual(3, move.X);
+        Assert.AreEqual(2, move.Y);
+    }
+
+    [TestMethod]
+    public void Coalesce_DragSeparatedByButtonEvents_KeepsOrder()
+    {
+        var events = new List<Hex1bEvent>
+        {
+            new Hex1bMouseEvent(MouseButton.Left, MouseAction.Down, 1, 1, Hex1bModifiers.None),
+            new Hex1bMouseEvent(MouseButton.Left, MouseAction.Drag, 2, 1, Hex1bModifiers.None),
+            new Hex1bMouseEvent(MouseButton.Left, MouseAction.Drag, 5, 1, Hex1bModifiers.None),
+            new Hex1bMouseEvent(MouseButton.Left, MouseAction.Up, 5, 1, Hex1bModifiers.None),
+        };
+
+        InputEventCoalescer.Coalesce(events);
+
+        Assert.HasCount(3, events);
+        var drag = TestSeq.IsType<Hex1bMouseEvent>(events[1]);
+        Assert.AreEqual(MouseAction.Drag, drag.Action);
+        Assert.AreEqual(5, drag.X);
+        Assert.AreEqual(MouseAction.Up, TestSeq.IsType<Hex1bMouseEvent>(events[2]).Action);
+    }
+
+    [TestMethod]
+    public void Coalesce_WheelBurst_SumsNotchesPerDirection()
+    {
+        var events = new List<Hex1bEvent>
+        {
+            new Hex1bMouseEvent(MouseButton.ScrollDown, MouseAction.Down, 4, 4, Hex1bModifiers.None),
+            new Hex1bMouseEvent(MouseButton.ScrollDown, MouseAction.Down, 4, 4, Hex1bModifiers.None),
+            new Hex1bMouseEvent(MouseButton.ScrollDown, MouseAction.Down, 4, 4, Hex1bModifiers.None),
+            new Hex1bMouseEvent(MouseButton.ScrollUp, MouseAction.Down, 4, 4, Hex1bModifiers.None),
+        };
+
+        InputEventCoalescer.Coalesce(events);
+
+        Assert.HasCount(2, events);
+        Assert.AreEqual(3, TestSeq.IsType<Hex1bMouseEvent>(events[0]).RepeatCount);
+        Assert.AreEqual(1, TestSeq.IsType<Hex1bMouseEvent>(events[1]).RepeatCount);
+    }
+
+    [TestMethod]
+    public void Coalesce_RepeatedNavigationKey_MergesWithRepeatCount()
+    {
+        var events = new List<Hex1bEvent>
+        {
+            Hex1bKeyEvent.Plain(Hex1bKey.DownArrow),
+            Hex1bKeyEvent.Plain(Hex1bKey.DownArrow),
+            Hex1bKeyEvent.Plain(Hex1bKey.DownArrow),
+            Hex1bKeyEvent.WithShift(Hex1bKey.DownArrow),
+        };
+
+        InputEventCoalescer.Coalesce(events);
+
+        Assert.HasCount(2, events);
+        Assert.AreEqual(3, TestSeq.IsType<Hex1bKeyEvent>(events[0]).RepeatCount);
+        Assert.AreEqual(Hex1bModifiers.Shift, TestSeq.IsType<Hex1bKeyEvent>(events[1]).Modifiers);
+    }
+
+    [TestMethod]
+    public void Coalesce_RepeatedTextKeys_AreNotMerged()
+    {
+        var events = new List<Hex1bEvent>
+        {
+            Hex1bKeyEvent.Plain(Hex1bKey.A, 'a'),
+            Hex1bKeyEvent.Plain(Hex1bKey.A, 'a'),
+            Hex1bKeyEvent.Plain(Hex1bKey.Enter),
+            Hex1bKeyEvent.Plain(Hex1bKey.Enter),
+        };
+
+        InputEventCoalescer.Coalesce(events);
+
+        Assert.HasCount(4, events);
+    }
+}
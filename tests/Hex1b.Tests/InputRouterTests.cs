@@ -718,4 +718,123 @@ public class InputRouterTests
     }
 
     #endregion
+
+    #region Dispatch Table Tests
+
+    [TestMethod]
+    public async Task RouteInput_WithFrameDispatchTable_BuildsBindingsOncePerFrame()
+    {
+        // Arrange
+        var configureCount = 0;
+        var saves = 0;
+        var focusedNode = new MockFocusableNode { IsFocused = true };
+        focusedNode.BindingsConfig = bindings =>
+        {
+            configureCount++;
+            bindings.Ctrl().Key(Hex1bKey.S).Action(_ => { saves++; return Task.CompletedTask; }, "Save");
+        };
+
+        var container = new MockContainerNode();
+        container.Children.Add(focusedNode);
+        focusedNode.Parent = container;
+
+        var focusRing = new FocusRing();
+        focusRing.Rebuild(container);
+        focusRing.EnsureFocus();
+        var state = new InputRouterState();
+        state.ResetDispatchTable(container);
+
+        // Act - several keys in one frame, then a new frame
+        for (int i = 0; i < 3; i++)
+        {
+            await InputRouter.RouteInputAsync(container, Hex1bKeyEvent.WithCtrl(Hex1bKey.S), focusRing, state, null, TestContext.Current.CancellationToken);
+        }
+        var countInFrame = configureCount;
+
+        state.ResetDispatchTable(container);
+        await InputRouter.RouteInputAsync(container, Hex1bKeyEvent.WithCtrl(Hex1bKey.S), focusRing, state, null, TestContext.Current.CancellationToken);
+
+        // Assert
+        Assert.AreEqual(4, saves);
+        Assert.AreEqual(1, countInFrame);
+        Assert.AreEqual(2, configureCount);
+    }
+
+    [TestMethod]
+    public async Task RouteInput_WithFrameDispatchTable_FollowsFocusChangesWithinFrame()
+    {
+        // Arrange
+        var first = new MockFocusableNode();
+        var second = new MockFocusableNode();
+        var container = new MockContainerNode();
+        container.Children.Add(first);
+        container.Children.Add(second);
+        first.Parent = container;
+        second.Parent = container;
+
+        var focusRing = new FocusRing();
+        focusRing.Rebuild(container);
+        focusRing.EnsureFocus();
+        var state = new InputRouterState();
+        state.ResetDispatchTable(container);
+
+        // Act - move focus between keys without starting a new frame
+        await InputRouter.RouteInputAsync(container, Hex1bKeyEvent.Plain(Hex1bKey.A, 'a'), focusRing, state, null, TestContext.Current.CancellationToken);
+        focusRing.FocusNext();
+        await InputRouter.RouteInputAsync(container, Hex1bKeyEvent.Plain(Hex1bKey.B, 'b'), focusRing, state, null, TestContext.Current.CancellationToken);
+
+        // Assert
+        Assert.AreEqual(Hex1bKey.A, TestSeq.IsType<Hex1bKeyEvent>(TestSeq.Single(first.ReceivedInputs)).Key);
+        Assert.AreEqual(Hex1bKey.B, TestSeq.IsType<Hex1bKeyEvent>(TestSeq.Single(second.ReceivedInputs)).Key);
+    }
+
+    [TestMethod]
+    public async Task RouteInput_RepeatedKey_HandlerConsumingCountRunsOnce()
+    {
+        // Arrange
+        var calls = new List<int>();
+        var focusedNode = new MockFocusableNode { IsFocused = true };
+        focusedNode.BindingsConfig = bindings =>
+        {
+            bindings.Key(Hex1bKey.DownArrow).Action(ctx => calls.Add(ctx.ConsumeRepeatCount()), "Down");
+        };
+
+        var focusRing = new FocusRing();
+        focusRing.Rebuild(focusedNode);
+        var state = new InputRouterState();
+
+        // Act
+        var keyEvent = Hex1bKeyEvent.Plain(Hex1bKey.DownArrow) with { RepeatCount = 4 };
+        await InputRouter.RouteInputAsync(focusedNode, keyEvent, focusRing, state, null, TestContext.Current.CancellationToken);
+
+        // Assert
+        Assert.AreEqual(4, TestSeq.Single(calls));
+    }
+
+    [TestMethod]
+    public async Task RouteInput_RepeatedKey_ReplaysForHandlersIgnoringCount()
+    {
+        // Arrange
+        var bindingCalls = 0;
+        var focusedNode = new MockFocusableNode { IsFocused = true };
+        focusedNode.BindingsConfig = bindings =>
+        {
+            bindings.Key(Hex1bKey.DownArrow).Action(_ => bindingCalls++, "Down");
+        };
+
+        var focusRing = new FocusRing();
+        focusRing.Rebuild(focusedNode);
+        var state = new InputRouterState();
+
+        // Act - one key with bindings, one falling through to HandleInput
+        await InputRouter.RouteInputAsync(focusedNode, Hex1bKeyEvent.Plain(Hex1bKey.DownArrow) with { RepeatCount = 3 }, focusRing, state, null, TestContext.Current.CancellationToken);
+        await InputRouter.RouteInputAsync(focusedNode, Hex1bKeyEvent.Plain(Hex1bKey.UpArrow) with { RepeatCount = 2 }, focusRing, state, null, TestContext.Current.CancellationToken);
+
+        // Assert - nodes see single presses
+        Assert.AreEqual(3, bindingCalls);
+        Assert.HasCount(2, focusedNode.ReceivedInputs);
+        Assert.IsTrue(focusedNode.ReceivedInputs.All(e => ((Hex1bKeyEvent)e).RepeatCount == 1));
+    }
+
+    #endregion
 }
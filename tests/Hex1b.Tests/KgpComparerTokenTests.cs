@@ -288,9 +288,8 @@ public class KgpComparerTokenTests
         
         var svg = terminal.CreateSnapshot().ToSvg();
         Assert.Contains("<image", svg);
-        // Text characters appear individually in SVG <text> elements
-        Assert.Contains(">H<", svg);
-        Assert.Contains(">i<", svg);
+        // Same-style characters are merged into one SVG <text> element
+        Assert.Contains(">Hi<", svg);
     }
 
     [TestMethod]
@@ -310,8 +310,8 @@ public class KgpPerlinNoiseTests
         var textGroupStart = svg.IndexOf("class=\"terminal-text\"");
         Assert.IsTrue(textGroupStart > imagesGroupEnd, "Text group should appear after images group in SVG");
 
-        // Verify the 'A' characters are in the text layer
-        Assert.Contains(">A<", svg);
+        // Verify the 'A' characters are in the text layer, one run per row
+        Assert.Contains($">{new string('A', TermWidth)}<", svg);
     }
 
     #region Perlin noise generation
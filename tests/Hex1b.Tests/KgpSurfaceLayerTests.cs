@@ -516,7 +516,6 @@ public class KgpSurfaceLayerTests
 
         // Verify SVG output contains text
         var svg = terminal.CreateSnapshot().ToSvg();
-        Assert.Contains(">H<", svg);
-        Assert.Contains(">i<", svg);
+        Assert.Contains(">Hi<", svg);
     }
 }
@@ -1097,9 +1097,28 @@ public class Osc8HyperlinkTests
         var snapshot = terminal.CreateSnapshot();
         var svg = snapshot.ToSvg();
         
-        // Count how many cells have the link-0 class - should be 5 (for A, B, C, D, E)
+        // A, B, C, D and E share a style and a link, so they are drawn as one link-0 group
         var cellGroupCount = System.Text.RegularExpressions.Regex.Matches(svg, @"class=""cell link-0""").Count;
-        Assert.AreEqual(5, cellGroupCount);
+        Assert.AreEqual(1, cellGroupCount);
+        Assert.Contains(">ABCDE<", svg);
+    }
+
+    [TestMethod]
+    public async Task SvgOutput_SameHyperlinkWithStyleChange_SplitsGroupsSharingClass()
+    {
+        // A style change inside one hyperlink starts a new run, and both runs keep the link class
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = Hex1bTerminal.CreateBuilder().WithWorkload(workload).WithHeadless().WithDimensions(40, 5).Build();
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b]8;;https://example.com\x1b\\AB\x1b[31mCDE\x1b[0m\x1b]8;;\x1b\\"));
+
+        var snapshot = terminal.CreateSnapshot();
+        var svg = snapshot.ToSvg();
+
+        var cellGroupCount = System.Text.RegularExpressions.Regex.Matches(svg, @"class=""cell link-0""").Count;
+        Assert.AreEqual(2, cellGroupCount);
+        Assert.Contains(">AB<", svg);
+        Assert.Contains(">CDE<", svg);
     }
 
     [TestMethod]
@@ -1164,10 +1183,24 @@ public class Osc8HyperlinkTests
         var snapshot = terminal.CreateSnapshot();
         var svg = snapshot.ToSvg();
         
-        // Check for data attributes on cells
+        // A and B share a style, so one group carries the attributes of its first cell
         Assert.Contains("data-x=\"0\"", svg);
         Assert.Contains("data-y=\"0\"", svg);
-        Assert.Contains("data-x=\"1\"", svg);
+        Assert.DoesNotContain("data-x=\"1\"", svg);
+    }
+
+    [TestMethod]
+    public async Task SvgOutput_StyleChange_StartsCellGroupAtItsFirstCell()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = Hex1bTerminal.CreateBuilder().WithWorkload(workload).WithHeadless().WithDimensions(10, 3).Build();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("A\x1b[31mB"));
+
+        var snapshot = terminal.CreateSnapshot();
+        var svg = snapshot.ToSvg();
+
+        Assert.Contains("data-x=\"0\" data-y=\"0\"", svg);
+        Assert.Contains("data-x=\"1\" data-y=\"0\"", svg);
     }
 
     #endregion
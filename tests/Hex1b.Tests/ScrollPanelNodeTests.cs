@@ -2,6 +2,7 @@ using Hex1b.Events;
 using Hex1b.Input;
 using Hex1b.Layout;
 using Hex1b.Nodes;
+using Hex1b.Surfaces;
 using Hex1b.Theming;
 using Hex1b.Widgets;
 
@@ -1592,4 +1593,115 @@ public class ScrollPanelNodeTests
     }
 
     #endregion
+
+    #region Viewport Clipping Tests
+
+    /// <summary>
+    /// One-row node that counts how often it is measured and rendered.
+    /// </summary>
+    private sealed class CountingRowNode : Hex1bNode
+    {
+        public int MeasureCount { get; private set; }
+        public int RenderCount { get; private set; }
+
+        protected override Size MeasureCore(Constraints constraints)
+        {
+            MeasureCount++;
+            return constraints.Constrain(new Size(10, 1));
+        }
+
+        public override void Render(Hex1bRenderContext context) => RenderCount++;
+    }
+
+    private static (ScrollPanelNode Panel, VStackNode Content) CreateLinkedPanel(List<Hex1bNode> rows)
+    {
+        var content = new VStackNode { Children = rows };
+        foreach (var row in rows)
+        {
+            row.Parent = content;
+        }
+        var panel = new ScrollPanelNode { Child = content, Orientation = ScrollOrientation.Vertical };
+        content.Parent = panel;
+        return (panel, content);
+    }
+
+    private static void ClearDirtyFlags(Hex1bNode node)
+    {
+        node.ClearDirty();
+        foreach (var child in node.GetChildren())
+        {
+            ClearDirtyFlags(child);
+        }
+    }
+
+    [TestMethod]
+    public void Render_SkipsChildrenOutsideViewport()
+    {
+        var rows = Enumerable.Range(0, 30).Select(_ => new CountingRowNode()).ToList();
+        var (panel, _) = CreateLinkedPanel([.. rows]);
+        panel.Measure(Constraints.Tight(40, 10));
+        panel.Arrange(new Rect(0, 0, 40, 10));
+        panel.Offset = 10;
+        panel.Measure(Constraints.Tight(40, 10));
+        panel.Arrange(new Rect(0, 0, 40, 10));
+
+        panel.Render(new SurfaceRenderContext(new Surface(40, 10)));
+
+        for (int i = 0; i < rows.Count; i++)
+        {
+            Assert.AreEqual(i is >= 10 and < 20 ? 1 : 0, rows[i].RenderCount, $"Row {i}");
+        }
+    }
+
+    [TestMethod]
+    public void Render_ViewportGrows_ShowsRowsSkippedFromCachedContent()
+    {
+        var rows = Enumerable.Range(0, 30).Select(i => (Hex1bNode)new TextBlockNode { Text = $"Line {i}" }).ToList();
+        var (panel, _) = CreateLinkedPanel(rows);
+        panel.Measure(Constraints.Tight(40, 5));
+        panel.Arrange(new Rect(0, 0, 40, 5));
+        panel.Render(new SurfaceRenderContext(new Surface(40, 10)));
+        ClearDirtyFlags(panel);
+
+        // The content keeps its bounds, so only the narrower visible rect rendered earlier can
+        // tell that its cached surface is missing rows
+        panel.Measure(Constraints.Tight(40, 10));
+        panel.Arrange(new Rect(0, 0, 40, 10));
+        var surface = new Surface(40, 10);
+        panel.Render(new SurfaceRenderContext(surface));
+
+        Assert.AreEqual("L", surface[0, 9].Character);
+        Assert.AreEqual("9", surface[5, 9].Character);
+    }
+
+    [TestMethod]
+    public void Measure_AfterScrolling_DoesNotRemeasureContent()
+    {
+        var rows = Enumerable.Range(0, 30).Select(_ => new CountingRowNode()).ToList();
+        var (panel, _) = CreateLinkedPanel([.. rows]);
+        panel.Measure(Constraints.Tight(40, 10));
+        panel.Arrange(new Rect(0, 0, 40, 10));
+
+        panel.Offset = 10;
+        panel.Measure(Constraints.Tight(40, 10));
+        panel.Arrange(new Rect(0, 0, 40, 10));
+        panel.ScrollBy(5);
+        panel.Measure(Constraints.Tight(40, 10));
+        panel.Arrange(new Rect(0, 0, 40, 10));
+
+        Assert.AreEqual(1, rows[0].MeasureCount);
+        Assert.AreEqual(15, panel.Offset);
+
+        // A change inside the content is measured again
+        rows[3].MarkDirty();
+        panel.Measure(Constraints.Tight(40, 10));
+        Assert.AreEqual(2, rows[0].MeasureCount);
+
+        // So is a different width
+        panel.Arrange(new Rect(0, 0, 40, 10));
+        panel.Measure(Constraints.Tight(30, 10));
+        Assert.AreEqual(3, rows[0].MeasureCount);
+    }
+
+    #endregion
 }
@@ -1,3 +1,4 @@
+using Hex1b.Reflow;
 using Hex1b.Tokens;
 
 namespace Hex1b.Tests;
@@ -216,6 +217,56 @@ public class ScrollbackBufferTests
         Assert.AreEqual(ts, lines[0].Timestamp);
     }
 
+    [TestMethod]
+    public void Replace_GrowingRangeInWrappedBuffer_ShiftsTailAndEvictsOldest()
+    {
+        var buffer = CreateBuffer(5);
+        foreach (var text in new[] { "A", "B", "C", "D", "E", "F", "G" })
+            buffer.Push(MakeRow(text), 10, DateTimeOffset.UtcNow);
+
+        int evicted = buffer.Replace(1, 1, [ReflowRow("X"), ReflowRow("Y")], DateTimeOffset.UtcNow);
+        buffer.Push(MakeRow("H"), 10, DateTimeOffset.UtcNow);
+
+        Assert.AreEqual(1, evicted);
+        CollectionAssert.AreEqual(new[] { "Y", "E", "F", "G", "H" }, Texts(buffer));
+    }
+
+    [TestMethod]
+    public void Replace_ShrinkingRange_KeepsOrderForLaterPushes()
+    {
+        var buffer = CreateBuffer(5);
+        foreach (var text in new[] { "A", "B", "C", "D", "E", "F" })
+            buffer.Push(MakeRow(text), 10, DateTimeOffset.UtcNow);
+
+        int evicted = buffer.Replace(1, 3, [ReflowRow("X")], DateTimeOffset.UtcNow);
+
+        Assert.AreEqual(0, evicted);
+        CollectionAssert.AreEqual(new[] { "B", "X", "F" }, Texts(buffer));
+
+        foreach (var text in new[] { "G", "H", "I" })
+            buffer.Push(MakeRow(text), 10, DateTimeOffset.UtcNow);
+
+        CollectionAssert.AreEqual(new[] { "X", "F", "G", "H", "I" }, Texts(buffer));
+    }
+
+    [TestMethod]
+    public void Replace_MoreRowsThanCapacity_KeepsNewestRows()
+    {
+        var buffer = CreateBuffer(3);
+        buffer.Push(MakeRow("A"), 10, DateTimeOffset.UtcNow);
+        buffer.Push(MakeRow("B"), 10, DateTimeOffset.UtcNow);
+
+        int evicted = buffer.Replace(0, 2, [ReflowRow("P"), ReflowRow("Q"), ReflowRow("R"), ReflowRow("S")], DateTimeOffset.UtcNow);
+
+        Assert.AreEqual(1, evicted);
+        CollectionAssert.AreEqual(new[] { "Q", "R", "S" }, Texts(buffer));
+    }
+
+    private static ReflowScrollbackRow ReflowRow(string text) => new(MakeRow(text), 10);
+
+    private static string[] Texts(ScrollbackBuffer buffer)
+        => buffer.GetLines(buffer.Count).Select(row => row.Cells[0].Character).ToArray();
+
     [TestMethod]
     public void Capacity_ReturnsConfiguredValue()
     {
@@ -1921,6 +1921,94 @@ public class ComputedCellTests
         Assert.AreEqual(SurfaceCells.Empty, result[7, 7]);
     }
 
+    [TestMethod]
+    [DataRow("DropShadow")]
+    [DataRow("Tint")]
+    [DataRow("Dim")]
+    [DataRow("Invert")]
+    [DataRow("BlurBackground")]
+    [DataRow("Passthrough")]
+    public void Flatten_BuiltInEffect_MatchesPerCellResolution(string name)
+    {
+        CellCompute effect = name switch
+        {
+            "DropShadow" => CellEffects.DropShadow(0.4f),
+            "Tint" => CellEffects.Tint(Hex1bColor.FromRgb(200, 30, 90), 0.35f),
+            "Dim" => CellEffects.Dim(0.7f),
+            "Invert" => CellEffects.Invert(),
+            "BlurBackground" => CellEffects.BlurBackground(),
+            _ => CellEffects.Passthrough(),
+        };
+
+        // Odd width so the row kernels' scalar tails run; the effect covers part of the
+        // composite and hangs off its bottom-right corner
+        var bulk = CreateEffectComposite(effect);
+        var perCell = CreateEffectComposite(context => effect(context));
+
+        var expected = perCell.Flatten();
+        var actual = bulk.Flatten();
+
+        for (int y = 0; y < expected.Height; y++)
+        {
+            for (int x = 0; x < expected.Width; x++)
+            {
+                Assert.AreEqual(expected[x, y], actual[x, y], $"Cell ({x}, {y})");
+            }
+        }
+    }
+
+    [TestMethod]
+    public void ApplyEffect_Dim_DarkensWrittenCells_AndLeavesUnwrittenCells()
+    {
+        var surface = new Surface(40, 3);
+        surface.WriteText(0, 0, new string('x', 40), Hex1bColor.White, Hex1bColor.FromRgb(100, 50, 200));
+
+        surface.ApplyEffect(CellEffects.Dim(0.5f));
+
+        Assert.AreEqual("x", surface[39, 0].Character);
+        Assert.AreEqual(Hex1bColor.FromRgb(127, 127, 127), surface[39, 0].Foreground);
+        Assert.AreEqual(Hex1bColor.FromRgb(50, 25, 100), surface[39, 0].Background);
+        Assert.AreEqual(SurfaceCells.Empty, surface[0, 1]);
+    }
+
+    [TestMethod]
+    public void ApplyEffect_CustomDelegate_MatchesBuiltInEffect()
+    {
+        var bulk = new Surface(21, 4);
+        bulk.WriteText(0, 0, "Hello, effect panel!", Hex1bColor.Yellow, Hex1bColor.Blue);
+        bulk.WriteText(3, 2, "  ", null, null);
+        var perCell = bulk.Clone();
+        var effect = CellEffects.Invert();
+
+        bulk.ApplyEffect(effect);
+        perCell.ApplyEffect(context => effect(context));
+
+        Assert.IsTrue(SurfaceComparer.Compare(perCell, bulk).IsEmpty);
+        Assert.AreEqual(Hex1bColor.FromRgb(255, 255, 0), bulk[0, 0].Background);
+        Assert.AreEqual(" ", bulk[3, 2].Character);
+    }
+
+    private static CompositeSurface CreateEffectComposite(CellCompute effect)
+    {
+        var composite = new CompositeSurface(37, 9);
+
+        var background = new Surface(37, 9);
+        for (int y = 0; y < 9; y++)
+        {
+            var color = Hex1bColor.FromRgb((byte)(y * 28), (byte)(255 - y * 20), 77);
+            background.WriteText(y, y, $"row {y} text", Hex1bColor.FromRgb(250, (byte)(y * 9), 3), y % 3 == 0 ? null : color);
+        }
+        composite.AddLayer(background);
+
+        var panel = new Surface(12, 4);
+        panel.Fill(new Rect(0, 0, 12, 4), new SurfaceCell(" ", null, Hex1bColor.Red));
+        panel.WriteText(1, 1, "panel", Hex1bColor.White, null);
+        composite.AddLayer(panel, 4, 2);
+
+        composite.AddComputedLayer(30, 8, effect, 3, 3);
+        return composite;
+    }
+
     #endregion
 }
 
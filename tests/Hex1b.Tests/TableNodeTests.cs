@@ -369,6 +369,29 @@ public class TableNodeTests
         Assert.AreEqual(1, node.FocusedKey); // Focus moved to row 1
     }
 
+    [TestMethod]
+    public async Task DownArrow_RepeatedWithoutFocusedRow_FocusesFirstRowThenMovesOn()
+    {
+        var data = Enumerable.Range(1, 50).Select(i => $"Row {i}").ToArray();
+        var node = new TableNode<string>
+        {
+            Data = data,
+            HeaderBuilder = h => [h.Cell("Name")],
+            RowBuilder = (r, item, _) => [r.Cell(item)]
+        };
+        node.Measure(new Constraints(0, 40, 0, 10));
+        node.Arrange(new Rect(0, 0, 40, 10));
+        node.IsFocused = true;
+
+        var focusRing = new FocusRing();
+        focusRing.Rebuild(node);
+        var keyEvent = Hex1bKeyEvent.Plain(Hex1bKey.DownArrow) with { RepeatCount = 3 };
+        await InputRouter.RouteInputAsync(node, keyEvent, focusRing, new InputRouterState(), null, TestContext.Current.CancellationToken);
+
+        // The first step focuses row 0, the other two move down from it
+        Assert.AreEqual(2, node.FocusedKey);
+    }
+
     [TestMethod]
     public async Task DownArrow_AtBottomOfViewport_ScrollsToKeepFocusVisible()
     {
@@ -0,0 +1,261 @@
+using System.Text;
+using System.Threading.Channels;
+using Hex1b.Tokens;
+using Microsoft.Extensions.Time.Testing;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for frame skipping in the terminal output pump.
+/// </summary>
+[TestClass]
+public class TerminalFrameSkippingTests
+{
+    [TestMethod]
+    public async Task Flood_SkipsFrames_AndPresentationEndsInSync()
+    {
+        // Arrange: a workload that always has output waiting, each read taking 50 µs, so the
+        // 250 ms flood outlasts the 10 ms interval many times over
+        var timeProvider = new FakeTimeProvider();
+        var workload = new QueuedWorkloadAdapter(timeProvider, TimeSpan.FromMicroseconds(50));
+        var produced = 0;
+        for (int i = 0; i < 5000; i++)
+            produced += workload.Enqueue($"\x1b[3{i % 8}mline {i}\x1b[0m\r\n");
+        workload.Enqueue("\x1b[1mdone");
+
+        var presentation = new RecordingPresentationAdapter(40, 10);
+        await using var terminal = Hex1bTerminal.CreateBuilder()
+            .WithWorkload(workload)
+            .WithPresentation(presentation)
+            .WithTimeProvider(timeProvider)
+            .WithFrameSkipping(TimeSpan.FromMilliseconds(10))
+            .Build();
+
+        // Act
+        await workload.Drained.WaitAsync(TimeSpan.FromSeconds(10), TestContext.Current.CancellationToken);
+        var mirror = await WaitForMirrorAsync(terminal, presentation);
+
+        // Assert: most of the flood never reached the presentation, yet it shows the same screen
+        Assert.IsLessThan(produced / 4, presentation.ByteCount);
+        var expected = terminal.CreateSnapshot();
+        var actual = mirror.CreateSnapshot();
+        for (int y = 0; y < 10; y++)
+            Assert.AreEqual(expected.GetLine(y), actual.GetLine(y), $"Row {y}");
+        Assert.AreEqual(expected.CursorX, actual.CursorX);
+        Assert.AreEqual(expected.CursorY, actual.CursorY);
+        Assert.IsTrue(actual.GetCell(0, 9).IsBold);
+    }
+
+    [TestMethod]
+    public async Task PacedOutput_IsForwardedUnchanged()
+    {
+        var timeProvider = new FakeTimeProvider();
+        var workload = new QueuedWorkloadAdapter(timeProvider, TimeSpan.FromMilliseconds(1));
+        var presentation = new RecordingPresentationAdapter(40, 10);
+        await using var terminal = Hex1bTerminal.CreateBuilder()
+            .WithWorkload(workload)
+            .WithPresentation(presentation)
+            .WithTimeProvider(timeProvider)
+            .WithFrameSkipping(TimeSpan.FromMilliseconds(10))
+            .Build();
+
+        // Each chunk arrives only after the pump has gone back to waiting
+        var expected = new StringBuilder();
+        for (int i = 0; i < 20; i++)
+        {
+            var chunk = $"line {i}\r\n";
+            expected.Append(chunk);
+            workload.ResetDrained();
+            workload.Enqueue(chunk);
+            await workload.Drained.WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+        }
+
+        await presentation.WaitForBytesAsync(Encoding.UTF8.GetByteCount(expected.ToString()));
+        Assert.AreEqual(expected.ToString(), presentation.Text);
+    }
+
+    [TestMethod]
+    public async Task Repaint_WithOriginModeAndScrollRegion_AddressesWholeScreen()
+    {
+        // Arrange: the workload has set a scroll region and origin mode, and the presentation
+        // has seen both before skipping starts
+        var timeProvider = new FakeTimeProvider();
+        var skipper = new TerminalFrameSkipper(TimeSpan.FromMilliseconds(10), timeProvider);
+        await using var terminal = CreateHeadlessTerminal();
+        await using var mirror = CreateHeadlessTerminal();
+        Apply("top line\x1b[3;8r\x1b[?6h", terminal, mirror);
+
+        skipper.OnOutputWaiting(terminal);
+        timeProvider.Advance(TimeSpan.FromMilliseconds(20));
+        skipper.OnOutputWaiting(terminal);
+        Assert.IsTrue(skipper.IsSkipping);
+
+        // Act: a flood that scrolls the region and writes below it, then a repaint
+        var flood = new StringBuilder();
+        for (int i = 0; i < 50; i++)
+            flood.Append($"\x1b[6;1Hscrolled {i}\n");
+        flood.Append("\x1b[?6l\x1b[10;1Hbottom\x1b[?6h\x1b[2;3H");
+        Apply(flood.ToString(), terminal);
+
+        timeProvider.Advance(TimeSpan.FromMilliseconds(20));
+        var repaint = skipper.TakeDueRepaint(terminal);
+        Assert.IsNotNull(repaint);
+        Apply(Encoding.UTF8.GetString(repaint), mirror);
+
+        // Assert: every row landed where it belongs, and the margins and origin mode are back
+        // for the output that follows
+        AssertSameScreen(terminal, mirror);
+        Apply("\x1b[1;1Hafter\x1b[6;1H\nnext", terminal, mirror);
+        AssertSameScreen(terminal, mirror);
+    }
+
+    private static Hex1bTerminal CreateHeadlessTerminal() => Hex1bTerminal.CreateBuilder()
+        .WithWorkload(new Hex1bAppWorkloadAdapter())
+        .WithHeadless()
+        .WithDimensions(40, 10)
+        .Build();
+
+    private static void Apply(string text, params Hex1bTerminal[] terminals)
+    {
+        foreach (var terminal in terminals)
+            terminal.ApplyTokens(AnsiTokenizer.Tokenize(text));
+    }
+
+    private static void AssertSameScreen(Hex1bTerminal expectedTerminal, Hex1bTerminal actualTerminal)
+    {
+        var expected = expectedTerminal.CreateSnapshot();
+        var actual = actualTerminal.CreateSnapshot();
+        for (int y = 0; y < expected.Height; y++)
+            Assert.AreEqual(expected.GetLine(y), actual.GetLine(y), $"Row {y}");
+        Assert.AreEqual(expected.CursorX, actual.CursorX);
+        Assert.AreEqual(expected.CursorY, actual.CursorY);
+    }
+
+    private static async Task<Hex1bTerminal> WaitForMirrorAsync(Hex1bTerminal terminal, RecordingPresentationAdapter presentation)
+    {
+        // Output is written before the pump goes back to waiting, but give it a moment
+        var deadline = DateTime.UtcNow.AddSeconds(5);
+        while (true)
+        {
+            var mirror = Hex1bTerminal.CreateBuilder()
+                .WithWorkload(new Hex1bAppWorkloadAdapter())
+                .WithHeadless()
+                .WithDimensions(40, 10)
+                .Build();
+            mirror.ApplyTokens(AnsiTokenizer.Tokenize(presentation.Text));
+
+            if (mirror.CreateSnapshot().GetLine(9).StartsWith("done") || DateTime.UtcNow > deadline)
+                return mirror;
+
+            await mirror.DisposeAsync();
+            await Task.Delay(20, TestContext.Current.CancellationToken);
+        }
+    }
+
+    /// <summary>
+    /// Returns queued output synchronously, like a PTY with data already waiting, and
+    /// only goes asynchronous once the queue is empty. Every read advances the clock.
+    /// </summary>
+    private sealed class QueuedWorkloadAdapter(FakeTimeProvider timeProvider, TimeSpan readDuration) : IHex1bTerminalWorkloadAdapter
+    {
+        private readonly Channel<byte[]> _output = Channel.CreateUnbounded<byte[]>();
+        private TaskCompletionSource _drained = new(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        public Task Drained => _drained.Task;
+
+        public event Action? Disconnected
+        {
+            add { }
+            remove { }
+        }
+
+        public int Enqueue(string text)
+        {
+            var bytes = Encoding.UTF8.GetBytes(text);
+            _output.Writer.TryWrite(bytes);
+            return bytes.Length;
+        }
+
+        public void ResetDrained()
+            => _drained = new(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        public ValueTask<ReadOnlyMemory<byte>> ReadOutputAsync(CancellationToken ct = default)
+        {
+            timeProvider.Advance(readDuration);
+            if (_output.Reader.TryRead(out var data))
+                return new ValueTask<ReadOnlyMemory<byte>>(data);
+
+            _drained.TrySetResult();
+            return WaitForOutputAsync(ct);
+        }
+
+        private async ValueTask<ReadOnlyMemory<byte>> WaitForOutputAsync(CancellationToken ct)
+        {
+            try
+            {
+                return await _output.Reader.ReadAsync(ct);
+            }
+            catch (OperationCanceledException)
+            {
+                return ReadOnlyMemory<byte>.Empty;
+            }
+        }
+
+        public ValueTask WriteInputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default) => ValueTask.CompletedTask;
+        public ValueTask ResizeAsync(int width, int height, CancellationToken ct = default) => ValueTask.CompletedTask;
+        public ValueTask DisposeAsync() => ValueTask.CompletedTask;
+    }
+
+    private sealed class RecordingPresentationAdapter(int width, int height) : IHex1bTerminalPresentationAdapter
+    {
+        private readonly MemoryStream _output = new();
+
+        public int Width => width;
+        public int Height => height;
+        public TerminalCapabilities Capabilities => new();
+
+        public int ByteCount
+        {
+            get { lock (_output) return (int)_output.Length; }
+        }
+
+        public string Text
+        {
+            get { lock (_output) return Encoding.UTF8.GetString(_output.GetBuffer(), 0, (int)_output.Length); }
+        }
+
+        public event Action<int, int>? Resized
+        {
+            add { }
+            remove { }
+        }
+
+        public event Action? Disconnected
+        {
+            add { }
+            remove { }
+        }
+
+        public ValueTask WriteOutputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default)
+        {
+            lock (_output) _output.Write(data.Span);
+            return ValueTask.CompletedTask;
+        }
+
+        public async Task WaitForBytesAsync(int count)
+        {
+            var deadline = DateTime.UtcNow.AddSeconds(5);
+            while (ByteCount < count && DateTime.UtcNow < deadline)
+                await Task.Delay(10, TestContext.Current.CancellationToken);
+        }
+
+        public ValueTask<ReadOnlyMemory<byte>> ReadInputAsync(CancellationToken ct = default)
+            => new(Task.Delay(Timeout.Infinite, ct).ContinueWith(_ => ReadOnlyMemory<byte>.Empty, TaskScheduler.Default));
+
+        public ValueTask FlushAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+        public ValueTask EnterRawModeAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+        public ValueTask ExitRawModeAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+        public (int Row, int Column) GetCursorPosition() => (0, 0);
+        public ValueTask DisposeAsync() => ValueTask.CompletedTask;
+    }
+}
@@ -1,5 +1,6 @@
 using Hex1b.Reflow;
 using Hex1b.Tokens;
+using Microsoft.Extensions.Time.Testing;
 
 namespace Hex1b.Tests;
 
@@ -551,4 +552,77 @@ public class TerminalReflowTests
     }
 
     #endregion
+
+    #region Deferred Scrollback Reflow
+
+    [TestMethod]
+    public void Reflow_LargeScrollback_DefersOlderRowsUntilRead()
+    {
+        // Arrange: 100 lines of 20 chars, each soft-wrapped to 2 rows at width 10
+        var adapter = new HeadlessPresentationAdapter(10, 3).WithReflow(AlacrittyReflowStrategy.Instance);
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = Hex1bTerminal.CreateBuilder()
+            .WithWorkload(workload).WithPresentation(adapter).WithDimensions(10, 3)
+            .WithScrollback(1000).Build();
+        var lines = WriteNumberedLines(terminal, 100);
+
+        // Act: Widen so each line fits in one row
+        terminal.Resize(20, 3);
+
+        // Assert: Only the rows near the screen were re-wrapped; older rows are still 2 per line
+        Assert.IsTrue(terminal.GetScrollbackRows(2).All(r => r.OriginalWidth == 20));
+        Assert.IsTrue(terminal.ScrollbackCount > 97);
+
+        // Reading the older rows re-wraps them
+        var rows = terminal.GetScrollbackRows(terminal.ScrollbackCount);
+        Assert.AreEqual(97, rows.Length);
+        Assert.AreEqual(97, terminal.ScrollbackCount);
+        for (int i = 0; i < rows.Length; i++)
+        {
+            Assert.AreEqual(20, rows[i].OriginalWidth);
+            Assert.AreEqual(lines[i], RowText(rows[i]));
+        }
+        Assert.AreEqual(lines[97], terminal.CreateSnapshot().GetLine(0).TrimEnd());
+    }
+
+    [TestMethod]
+    public void Reflow_DragResize_RewrapsDeferredRowsOnceSettled()
+    {
+        // Arrange
+        var timeProvider = new FakeTimeProvider();
+        var adapter = new HeadlessPresentationAdapter(10, 3).WithReflow(AlacrittyReflowStrategy.Instance);
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = Hex1bTerminal.CreateBuilder()
+            .WithWorkload(workload).WithPresentation(adapter).WithDimensions(10, 3)
+            .WithScrollback(1000).WithTimeProvider(timeProvider).Build();
+        var lines = WriteNumberedLines(terminal, 100);
+
+        // Act: Several sizes in quick succession, then let the resize settle
+        terminal.Resize(15, 3);
+        terminal.Resize(18, 3);
+        terminal.Resize(20, 3);
+        Assert.IsTrue(terminal.ScrollbackCount > 97);
+
+        timeProvider.Advance(TimeSpan.FromSeconds(1));
+
+        // Assert: The deferred rows were re-wrapped straight to the final width
+        Assert.AreEqual(97, terminal.ScrollbackCount);
+        var rows = terminal.GetScrollbackRows(97);
+        for (int i = 0; i < rows.Length; i++)
+        {
+            Assert.AreEqual(lines[i], RowText(rows[i]));
+        }
+    }
+
+    private static string[] WriteNumberedLines(Hex1bTerminal terminal, int count)
+    {
+        var lines = Enumerable.Range(0, count).Select(i => $"L{i:D3}" + new string('x', 16)).ToArray();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(string.Join("\r\n", lines)));
+        return lines;
+    }
+
+    private static string RowText(ScrollbackRow row)
+        => string.Concat(row.Cells.Select(c => c.Character)).TrimEnd();
+
+    #endregion
 }
@@ -0,0 +1,137 @@
+using Hex1b.Layout;
+using Hex1b.Tokens;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for the per-snapshot text index and compiled cell patterns.
+/// </summary>
+[TestClass]
+public class TerminalRegionTextIndexTests
+{
+    private static Hex1bTerminalSnapshot CreateSnapshot(string content, int width = 40, int height = 5)
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = Hex1bTerminal.CreateBuilder().WithWorkload(workload).WithHeadless().WithDimensions(width, height).Build();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(content));
+        return terminal.CreateSnapshot();
+    }
+
+    [TestMethod]
+    public void Snapshot_SharesOneIndexAcrossSearches()
+    {
+        using var snapshot = CreateSnapshot("hello");
+
+        Assert.AreSame(snapshot.TextIndex, TerminalRegionTextIndex.For(snapshot));
+        Assert.AreSame(snapshot.GetLine(0), snapshot.GetLine(0));
+    }
+
+    [TestMethod]
+    public void GetColumn_MapsTextOffsetsPastWideCharacters()
+    {
+        using var snapshot = CreateSnapshot("你好 ab");
+        var index = snapshot.TextIndex;
+
+        Assert.AreEqual("你好 ab", index.GetLine(0).TrimEnd());
+        Assert.AreEqual(0, index.GetColumn(0, 0));
+        Assert.AreEqual(2, index.GetColumn(0, 1));
+        Assert.AreEqual(5, index.GetColumn(0, 3));
+        Assert.AreEqual(snapshot.Width, index.GetColumn(0, 1000));
+    }
+
+    [TestMethod]
+    public void GetAttributeRuns_GroupsCellsWithSameStyle()
+    {
+        using var snapshot = CreateSnapshot("ab\x1b[1mcd\x1b[0mef", width: 6, height: 1);
+
+        var runs = snapshot.TextIndex.GetAttributeRuns(0).ToArray();
+
+        Assert.AreEqual(3, runs.Length);
+        Assert.AreEqual(new CellAttributeRun(2, 2, CellAttributes.Bold, null, null), runs[1]);
+        Assert.IsTrue(snapshot.HasAttribute(CellAttributes.Bold));
+        Assert.IsFalse(snapshot.HasAttribute(CellAttributes.Italic));
+    }
+
+    [TestMethod]
+    public void OffsetToLineColumn_ResolvesSeparatorsAndEmptyRows()
+    {
+        // "ab\n\ncd": rows start at 0, 3 and 4
+        int[] offsets = [0, 3, 4, 6];
+
+        Assert.AreEqual((0, 2), TerminalRegionTextIndex.OffsetToLineColumn(2, offsets));
+        Assert.AreEqual((1, 0), TerminalRegionTextIndex.OffsetToLineColumn(3, offsets));
+        Assert.AreEqual((2, 1), TerminalRegionTextIndex.OffsetToLineColumn(5, offsets));
+        Assert.AreEqual((2, 2), TerminalRegionTextIndex.OffsetToLineColumn(6, offsets));
+
+        // Without a separator, rows that start at the same offset resolve to the last one
+        Assert.AreEqual((1, 0), TerminalRegionTextIndex.OffsetToLineColumn(0, [0, 0, 2]));
+    }
+
+    [TestMethod]
+    public void FindMultiLinePattern_UsesCachedJoinedText()
+    {
+        using var snapshot = CreateSnapshot("one\r\ntwo\r\nthree");
+
+        var matches = snapshot.FindMultiLinePattern(@"two\s*\nthree", trimLines: true);
+
+        Assert.AreEqual(1, matches.Count);
+        Assert.AreEqual(1, matches[0].StartLine);
+        Assert.AreEqual(2, matches[0].EndLine);
+        Assert.AreEqual(5, matches[0].EndColumn);
+    }
+
+    [TestMethod]
+    public void FindText_AfterWideCharacter_MatchesCellColumns()
+    {
+        using var snapshot = CreateSnapshot("你好 [ok]");
+
+        var match = new CellPatternSearcher().Find("[ok]").SearchFirst(snapshot);
+
+        Assert.IsNotNull(match);
+        Assert.AreEqual(new Rect(5, 0, 4, 1), match.Bounds);
+        Assert.AreEqual("[ok]", match.Text);
+    }
+
+    [TestMethod]
+    public void FindChar_IgnoresCharacterInsideLargerGrapheme()
+    {
+        // "e\u0301" occupies one cell; its text contains 'e' but the cell isn't "e"
+        using var snapshot = CreateSnapshot("e\u0301 e", width: 5, height: 1);
+
+        var result = new CellPatternSearcher().Find('e').Search(snapshot);
+
+        Assert.AreEqual(1, result.Count);
+        Assert.AreEqual(2, result.First!.Start.X);
+    }
+
+    [TestMethod]
+    public void Compile_ReturnsSameInstanceAndMatchesSearcher()
+    {
+        using var snapshot = CreateSnapshot("x=1\r\ny=2\r\nx=3");
+        var searcher = new CellPatternSearcher()
+            .BeginCapture("name")
+            .Find('x')
+            .EndCapture()
+            .Then(p => p.Right('=').Right(1));
+
+        var compiled = searcher.Compile();
+
+        Assert.AreSame(compiled, searcher.Compile());
+        var result = snapshot.SearchPattern(compiled);
+        Assert.AreEqual(2, result.Count);
+        Assert.AreEqual("x=1", result.Matches[0].Text);
+        Assert.AreEqual("x", result.Matches[1].GetCaptureText("name"));
+        Assert.AreEqual(2, result.Matches[1].Start.Y);
+    }
+
+    [TestMethod]
+    public void SnapshotRegion_HasItsOwnIndex()
+    {
+        using var snapshot = CreateSnapshot("abc\r\ndef");
+        var region = snapshot.GetRegion(new Rect(1, 1, 2, 1));
+
+        Assert.AreEqual("ef", region.GetLine(0));
+        Assert.AreNotSame(snapshot.TextIndex, region.TextIndex);
+        Assert.AreEqual(1, new CellPatternSearcher().Find("ef").Search(region).Count);
+    }
+}
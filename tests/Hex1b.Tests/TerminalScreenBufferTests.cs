@@ -0,0 +1,116 @@
+using Hex1b.Tokens;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for the copy-on-write row storage behind the terminal screen and its snapshots.
+/// </summary>
+[TestClass]
+public class TerminalScreenBufferTests
+{
+    private static TerminalCell Cell(string ch) => TerminalCell.Empty with { Character = ch };
+
+    [TestMethod]
+    public void Pin_ReturnsCurrentRowsWithoutCopying()
+    {
+        var buffer = new TerminalScreenBuffer(2, 3);
+        buffer.GetCellForWrite(0, 0) = Cell("a");
+
+        var pinned = buffer.Pin();
+
+        Assert.AreEqual("a", pinned[0][0].Character);
+        Assert.AreSame(pinned[1], buffer.Pin()[1]);
+    }
+
+    [TestMethod]
+    public void WriteAfterPin_ClonesOnlyTheWrittenRow()
+    {
+        var buffer = new TerminalScreenBuffer(3, 3);
+        buffer.GetCellForWrite(1, 0) = Cell("a");
+        var pinned = buffer.Pin();
+
+        buffer.GetCellForWrite(1, 0) = Cell("b");
+
+        Assert.AreEqual("a", pinned[1][0].Character);
+        Assert.AreEqual("b", buffer[1, 0].Character);
+
+        var repinned = buffer.Pin();
+        Assert.AreNotSame(pinned[1], repinned[1]);
+        Assert.AreSame(pinned[0], repinned[0]);
+        Assert.AreSame(pinned[2], repinned[2]);
+    }
+
+    [TestMethod]
+    public void WriteWithoutPin_MutatesInPlace()
+    {
+        var buffer = new TerminalScreenBuffer(1, 2);
+        var row = buffer.GetRowForWrite(0);
+
+        buffer.GetCellForWrite(0, 1) = Cell("z");
+
+        Assert.AreSame(row, buffer.GetRowForWrite(0));
+        Assert.AreEqual("z", row[1].Character);
+    }
+
+    [TestMethod]
+    public void RepeatedWritesAfterPin_CloneRowOnce()
+    {
+        var buffer = new TerminalScreenBuffer(1, 3);
+        buffer.Pin();
+
+        var first = buffer.GetRowForWrite(0);
+        var second = buffer.GetRowForWrite(0);
+
+        Assert.AreSame(first, second);
+    }
+
+    [TestMethod]
+    public void Snapshot_IsUnaffectedByLaterWrites()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = Hex1bTerminal.CreateBuilder().WithWorkload(workload).WithHeadless().WithDimensions(10, 3).Build();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("before"));
+
+        using var snapshot = terminal.CreateSnapshot();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[1;1Hafter!"));
+
+        Assert.AreEqual("before", snapshot.GetLineTrimmed(0));
+        using var later = terminal.CreateSnapshot();
+        Assert.AreEqual("after!", later.GetLineTrimmed(0));
+    }
+
+    [TestMethod]
+    public void Snapshot_WithScrollback_SharesScrollbackRows()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = Hex1bTerminal.CreateBuilder()
+            .WithWorkload(workload)
+            .WithHeadless()
+            .WithDimensions(10, 2)
+            .WithScrollback(10)
+            .Build();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("one\r\ntwo\r\nthree"));
+
+        using var snapshot = terminal.CreateSnapshot(scrollbackLines: 5);
+
+        Assert.AreEqual(1, snapshot.ScrollbackLineCount);
+        Assert.AreEqual(3, snapshot.Height);
+        Assert.AreEqual("one", snapshot.GetLineTrimmed(0));
+        Assert.AreEqual("three", snapshot.GetLineTrimmed(2));
+    }
+
+    [TestMethod]
+    public void GetScreenBufferSnapshot_ReturnsIndependentCopy()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = Hex1bTerminal.CreateBuilder().WithWorkload(workload).WithHeadless().WithDimensions(5, 1).Build();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("ab"));
+
+        var (buffer, width, height, _, _) = terminal.GetScreenBufferSnapshot();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\rcd"));
+
+        Assert.AreEqual(5, width);
+        Assert.AreEqual(1, height);
+        Assert.AreEqual("a", buffer[0, 0].Character);
+    }
+}
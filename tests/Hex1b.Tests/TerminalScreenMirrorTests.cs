@@ -0,0 +1,124 @@
+using Hex1b.Automation;
+using Hex1b.Diagnostics;
+using Hex1b.Theming;
+using Hex1b.Tokens;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for the shared-memory screen mirror written by <see cref="TerminalScreenMirror"/>
+/// and read by <see cref="TerminalScreenMirrorReader"/>.
+/// </summary>
+[TestClass]
+public class TerminalScreenMirrorTests : IDisposable
+{
+    private readonly string _path = Path.Combine(Path.GetTempPath(), $"hex1b_test_{Guid.NewGuid()}.diagnostics.screen");
+
+    public void Dispose()
+    {
+        try { File.Delete(_path); } catch { }
+    }
+
+    private static Hex1bTerminal CreateTerminal(int width, int height)
+        => Hex1bTerminal.CreateBuilder()
+            .WithWorkload(new Hex1bAppWorkloadAdapter())
+            .WithHeadless()
+            .WithDimensions(width, height)
+            .Build();
+
+    [TestMethod]
+    public void Reader_ReturnsScreenMatchingSnapshot()
+    {
+        using var terminal = CreateTerminal(20, 4);
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("Hello \x1b[1;31mred\x1b[0m\r\n\x1b[38;2;1;2;3;48;5;200mrgb\x1b[0m 中文"));
+
+        using var mirror = new TerminalScreenMirror(_path);
+        mirror.Update(terminal);
+
+        using var reader = TerminalScreenMirrorReader.TryOpen(_path);
+        Assert.IsNotNull(reader);
+        var frame = reader.TryRead();
+        Assert.IsNotNull(frame);
+
+        using var snapshot = terminal.CreateSnapshot();
+        Assert.AreEqual(snapshot.GetText(), frame.GetText());
+        Assert.AreEqual(snapshot.Generation, frame.Generation);
+        Assert.AreEqual(snapshot.CursorX, frame.CursorX);
+        Assert.AreEqual(snapshot.CursorY, frame.CursorY);
+        Assert.AreEqual(Environment.ProcessId, frame.ProcessId);
+
+        var red = frame.GetCell(6, 0);
+        Assert.AreEqual("r", red.Character);
+        Assert.IsTrue(red.IsBold);
+        Assert.AreEqual(Hex1bColorKind.Standard, red.Foreground!.Value.Kind);
+        Assert.AreEqual(1, red.Foreground!.Value.AnsiIndex);
+
+        var rgb = frame.GetCell(0, 1);
+        Assert.AreEqual(Hex1bColorKind.Rgb, rgb.Foreground!.Value.Kind);
+        Assert.AreEqual((byte)3, rgb.Foreground!.Value.B);
+        Assert.AreEqual(Hex1bColorKind.Indexed, rgb.Background!.Value.Kind);
+        Assert.AreEqual(200, rgb.Background!.Value.AnsiIndex);
+    }
+
+    [TestMethod]
+    public void Reader_SeesUpdatesAndReusesIdleFrames()
+    {
+        using var terminal = CreateTerminal(10, 3);
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("one"));
+
+        using var mirror = new TerminalScreenMirror(_path);
+        mirror.Update(terminal);
+
+        using var reader = TerminalScreenMirrorReader.TryOpen(_path)!;
+        var first = reader.TryRead()!;
+        Assert.AreSame(first, reader.TryRead());
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\r\ntwo"));
+        mirror.Update(terminal);
+
+        var second = reader.TryRead()!;
+        Assert.AreNotSame(first, second);
+        Assert.IsTrue(second.Generation > first.Generation);
+        Assert.AreEqual("one", second.GetLineTrimmed(0));
+        Assert.AreEqual("two", second.GetLineTrimmed(1));
+    }
+
+    [TestMethod]
+    public void Reader_ReopensWhenMirrorGrowsAndStopsWhenDisposed()
+    {
+        using var terminal = CreateTerminal(10, 3);
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("small"));
+
+        var mirror = new TerminalScreenMirror(_path);
+        mirror.Update(terminal);
+
+        using var reader = TerminalScreenMirrorReader.TryOpen(_path)!;
+        Assert.AreEqual(10, reader.TryRead()!.Width);
+
+        // Larger than the initial capacity, so the writer replaces the file
+        terminal.Resize(400, 100);
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[Hbig"));
+        mirror.Update(terminal);
+
+        var grown = reader.TryRead()!;
+        Assert.AreEqual(400, grown.Width);
+        Assert.AreEqual(100, grown.Height);
+        using (var snapshot = terminal.CreateSnapshot())
+            Assert.AreEqual(snapshot.GetText(), grown.GetText());
+
+        mirror.Dispose();
+        Assert.IsNull(reader.TryRead());
+        Assert.IsFalse(File.Exists(_path));
+    }
+
+    [TestMethod]
+    public void TryOpen_ReturnsNullForMissingOrForeignFiles()
+    {
+        Assert.IsNull(TerminalScreenMirrorReader.TryOpen(_path));
+
+        File.WriteAllBytes(_path, new byte[128]);
+        Assert.IsNull(TerminalScreenMirrorReader.TryOpen(_path));
+
+        Assert.AreEqual("/tmp/42.diagnostics.screen", TerminalScreenMirrorReader.GetMirrorPath("/tmp/42.diagnostics.socket"));
+    }
+}
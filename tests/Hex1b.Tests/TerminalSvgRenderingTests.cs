@@ -1,6 +1,8 @@
+using System.Buffers;
 using Hex1b.Input;
 using Hex1b.Layout;
 using Hex1b.Theming;
+using Hex1b.Tokens;
 
 namespace Hex1b.Tests;
 
@@ -246,4 +248,85 @@ public class TerminalSvgRenderingTests
         // Attach SVG to test output
         TestCaptureHelper.AttachSvg("custom-options.svg", svg);
     }
+
+    [TestMethod]
+    public void SameStyleCells_AreMergedIntoOneTextElement()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = Hex1bTerminal.CreateBuilder().WithWorkload(workload).WithHeadless().WithDimensions(20, 3).Build();
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("Hello World\r\n\x1b[38;2;200;10;10mRed\x1b[0m \x1b[38;2;200;10;10mRed"));
+
+        var svg = terminal.CreateSnapshot().ToSvg();
+
+        Assert.Contains(">Hello World<", svg);
+        Assert.Contains(">Red<", svg);
+        Assert.AreEqual(3, CountOccurrences(svg, "<text "));
+
+        // Both red runs share one color class
+        Assert.AreEqual(1, CountOccurrences(svg, "fill: rgb(200,10,10)"));
+        Assert.AreEqual(2, CountOccurrences(svg, "<text class=\"c0\""));
+    }
+
+    [TestMethod]
+    public void Renderer_ReusedAcrossFrames_MatchesFreshRender()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = Hex1bTerminal.CreateBuilder().WithWorkload(workload).WithHeadless().WithDimensions(20, 4).Build();
+        var options = new TerminalSvgOptions();
+        var renderer = new TerminalSvgRenderer(options);
+        var buffer = new ArrayBufferWriter<char>();
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[44mfirst\x1b[0m\r\nsecond"));
+        renderer.Render(terminal.CreateSnapshot(), buffer);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[4;1H\x1b[1mfourth"));
+        var snapshot = terminal.CreateSnapshot();
+        buffer.Clear();
+        renderer.Render(snapshot, buffer);
+
+        Assert.AreEqual(snapshot.ToSvg(options), buffer.WrittenSpan.ToString());
+    }
+
+    [TestMethod]
+    public void Renderer_TryRenderDelta_WritesOnlyChangedRows()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = Hex1bTerminal.CreateBuilder().WithWorkload(workload).WithHeadless().WithDimensions(20, 4).Build();
+        var renderer = new TerminalSvgRenderer();
+        var buffer = new ArrayBufferWriter<char>();
+
+        // Nothing to base a delta on yet
+        Assert.IsFalse(renderer.TryRenderDelta(terminal.CreateSnapshot(), buffer));
+        Assert.AreEqual(0, buffer.WrittenCount);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("top\r\n\r\nbottom"));
+        renderer.Render(terminal.CreateSnapshot(), buffer);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[3;1H\x1b[38;2;0;200;0mgreen"));
+        var snapshot = terminal.CreateSnapshot();
+        buffer.Clear();
+        Assert.IsTrue(renderer.TryRenderDelta(snapshot, buffer));
+        var delta = buffer.WrittenSpan.ToString();
+
+        Assert.StartsWith("<g class=\"terminal-delta\"", delta);
+        Assert.Contains(">green<", delta);
+        Assert.Contains("data-row=\"2\"", delta);
+        Assert.DoesNotContain("data-row=\"0\"", delta);
+        Assert.DoesNotContain(">top<", delta);
+        Assert.Contains("<style>.c0 { fill: rgb(0,200,0); }</style>", delta);
+        Assert.AreEqual(snapshot.Generation, renderer.Generation);
+
+        // A resize can't be expressed as a delta
+        terminal.Resize(30, 4);
+        buffer.Clear();
+        Assert.IsFalse(renderer.TryRenderDelta(terminal.CreateSnapshot(), buffer));
+    }
+
+    private static int CountOccurrences(string text, string value)
+    {
+        var count = 0;
+        for (var i = text.IndexOf(value, StringComparison.Ordinal); i >= 0; i = text.IndexOf(value, i + value.Length, StringComparison.Ordinal))
+            count++;
+        return count;
+    }
 }
@@ -1,4 +1,5 @@
 using Hex1b;
+using Hex1b.Data;
 using Hex1b.Events;
 using Hex1b.Input;
 using Hex1b.Layout;
@@ -474,4 +475,223 @@ public class TreeNodeTests
     }
 
     #endregion
+
+    #region Data Source Tests
+
+    private sealed record Folder(string Name, IReadOnlyList<Folder> Children);
+
+    private static Folder[] CreateFolders(int count, int childCount, string prefix = "")
+        => Enumerable.Range(0, count)
+            .Select(i => new Folder($"{prefix}{i}", childCount > 0 ? CreateFolders(childCount, 0, $"{prefix}{i}.") : []))
+            .ToArray();
+
+    private static TreeDataSource<Folder> CreateFolderSource(IReadOnlyList<Folder> roots)
+        => new(roots, folder => folder.Children, folder => folder.Name);
+
+    private static InputBindingActionContext CreateActionContext()
+        => new(new FocusRing(), null, TestContext.Current.CancellationToken);
+
+    [TestMethod]
+    public void TreeRowIndex_IndexAndLookup_MatchDepthFirstOrder()
+    {
+        var index = new TreeRowIndex();
+        var roots = new List<TreeRow>();
+        for (int i = 0; i < 300; i++)
+        {
+            var row = new TreeRow { HasChildren = true };
+            index.SetChildren(row, Enumerable.Range(0, i % 7).Select(_ => new TreeRow()).ToArray());
+            roots.Add(row);
+        }
+        index.SetRoots(roots);
+
+        var random = new Random(42);
+        for (int step = 0; step < 200; step++)
+        {
+            var row = roots[random.Next(roots.Count)];
+            index.SetExpanded(row, !row.IsExpanded);
+        }
+
+        var expected = roots.SelectMany(r => r.IsExpanded ? r.Children.Prepend(r) : [r]).ToList();
+        Assert.AreEqual(expected.Count, index.Count);
+        CollectionAssert.AreEqual(expected, index.EnumerateVisible().ToList());
+        for (int i = 0; i < expected.Count; i++)
+        {
+            Assert.AreSame(expected[i], index[i]);
+            Assert.AreEqual(i, index.IndexOf(expected[i]));
+        }
+
+        var hidden = roots.First(r => !r.IsExpanded && r.Children.Count > 0).Children[0];
+        Assert.AreEqual(-1, index.IndexOf(hidden));
+    }
+
+    [TestMethod]
+    public async Task DataSource_Expand_LoadsChildrenOnce()
+    {
+        var requested = new List<string>();
+        var source = new TreeDataSource<Folder>(
+            CreateFolders(3, 2),
+            folder => { requested.Add(folder.Name); return folder.Children; },
+            folder => folder.Name);
+        var node = await ReconcileTreeAsync(new RootContext().Tree(source));
+        requested.Clear(); // HasChildren asks too
+
+        Assert.AreEqual(3, node.FlattenedItems.Count);
+
+        var ctx = CreateActionContext();
+        await node.ToggleExpandAsync(node.FlattenedItems[1].Node, ctx);
+        await node.ToggleExpandAsync(node.FlattenedItems[1].Node, ctx);
+        await node.ToggleExpandAsync(node.FlattenedItems[1].Node, ctx);
+
+        Assert.AreEqual(1, requested.Count(name => name == "1"));
+        CollectionAssert.AreEqual(
+            new[] { "0", "1", "1.0", "1.1", "2" },
+            node.FlattenedItems.Select(e => e.Node.Label).ToArray());
+        Assert.AreEqual(1, node.FlattenedItems[2].Depth);
+        Assert.AreEqual("1.1", node.FlattenedItems[3].Node.GetData<Folder>().Name);
+    }
+
+    [TestMethod]
+    public async Task DataSource_AsyncChildren_ShowLoadingUntilLoaded()
+    {
+        var children = new TaskCompletionSource<IReadOnlyList<Folder>>(TaskCreationOptions.RunContinuationsAsynchronously);
+        var source = new DeferredFolderSource(CreateFolders(2, 0), children.Task);
+        var node = await ReconcileTreeAsync(new RootContext().Tree(source));
+
+        var parent = node.FlattenedItems[0].Node;
+        await node.ToggleExpandAsync(parent, CreateActionContext());
+
+        Assert.IsTrue(node.HasLoadingItems());
+        Assert.IsNotNull(parent.LoadingSpinnerNode);
+        Assert.AreEqual(2, node.FlattenedItems.Count);
+
+        children.SetResult(CreateFolders(4, 0, "0."));
+        var deadline = DateTime.UtcNow.AddSeconds(5);
+        while (node.HasLoadingItems() && DateTime.UtcNow < deadline)
+        {
+            await Task.Delay(10, TestContext.Current.CancellationToken);
+        }
+
+        Assert.IsFalse(node.HasLoadingItems());
+        Assert.AreEqual(6, node.FlattenedItems.Count);
+        Assert.IsTrue(parent.IsExpanded);
+        Assert.AreEqual("▼", parent.ExpandIndicatorNode?.Icon);
+    }
+
+    [TestMethod]
+    public async Task DataSource_OnlyMaterializesRowsNearViewport()
+    {
+        var node = await ReconcileTreeAsync(new RootContext().Tree(CreateFolderSource(CreateFolders(100_000, 0))));
+
+        node.Measure(new Constraints(0, 40, 0, 10));
+        node.Arrange(new Rect(0, 0, 40, 10));
+        var materialized = node.Rows.Roots.Count(row => row.Node != null);
+        Assert.AreEqual(10 + TreeNode.VirtualizationBuffer, materialized);
+
+        // Jump to the end; the first rows let go of their nodes
+        node.FocusItem(node.FlattenedItems[99_999].Node);
+        node.Arrange(new Rect(0, 0, 40, 10));
+
+        Assert.IsNull(node.Rows.Roots[0].Node);
+        Assert.IsTrue(node.Rows.Roots[99_999].Node!.IsFocused);
+        Assert.AreEqual(10 + TreeNode.VirtualizationBuffer, node.Rows.Roots.Count(row => row.Node != null));
+    }
+
+    [TestMethod]
+    public async Task DataSource_SlowRoots_ReconcileDoesNotWaitForThem()
+    {
+        var roots = new TaskCompletionSource<IReadOnlyList<Folder>>(TaskCreationOptions.RunContinuationsAsynchronously);
+        var invalidated = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        var source = new PendingRootsSource(roots.Task);
+        var context = ReconcileContext.CreateRoot(invalidateCallback: () => invalidated.TrySetResult());
+
+        var node = (TreeNode)await new RootContext().Tree(source).ReconcileAsync(null, context);
+
+        Assert.AreEqual(0, node.FlattenedItems.Count);
+        Assert.AreEqual(new Size(10, 1), node.Measure(new Constraints(0, 40, 0, 10)));
+
+        roots.SetResult(CreateFolders(3, 0));
+        await invalidated.Task.WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+
+        Assert.AreEqual(3, node.FlattenedItems.Count);
+        Assert.AreEqual(1, source.RootRequests);
+    }
+
+    [TestMethod]
+    public async Task DataSource_RootsLoadFails_RetriesOnNextReconcile()
+    {
+        var source = new FlakyRootsSource(CreateFolders(3, 0));
+        var widget = new RootContext().Tree(source);
+        var node = new TreeNode();
+        var invalidated = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        var context = ReconcileContext.CreateRoot(invalidateCallback: () => invalidated.TrySetResult());
+
+        await widget.ReconcileAsync(node, context);
+        await invalidated.Task.WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+
+        Assert.IsInstanceOfType<IOException>(node.RootsLoadError);
+        Assert.AreEqual(0, node.FlattenedItems.Count);
+        Assert.AreEqual(new Size(25, 1), node.Measure(new Constraints(0, 40, 0, 10)));
+
+        invalidated = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        context = ReconcileContext.CreateRoot(invalidateCallback: () => invalidated.TrySetResult());
+        await widget.ReconcileAsync(node, context);
+        await invalidated.Task.WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+
+        Assert.AreEqual(2, source.RootRequests);
+        Assert.IsNull(node.RootsLoadError);
+        Assert.AreEqual(3, node.FlattenedItems.Count);
+    }
+
+    /// <summary>
+    /// Fails the first request for the roots, as a transient I/O error would.
+    /// </summary>
+    private sealed class FlakyRootsSource(IReadOnlyList<Folder> roots) : ITreeDataSource<Folder>
+    {
+        public int RootRequests { get; private set; }
+
+        public async ValueTask<IReadOnlyList<Folder>> GetRootsAsync(CancellationToken cancellationToken = default)
+        {
+            await Task.Yield();
+            if (++RootRequests == 1) throw new IOException("transient");
+            return roots;
+        }
+
+        public ValueTask<IReadOnlyList<Folder>> GetChildrenAsync(Folder parent, CancellationToken cancellationToken = default) => new(parent.Children);
+        public bool HasChildren(Folder item) => item.Children.Count > 0;
+        public string GetLabel(Folder item) => item.Name;
+        public string? GetIcon(Folder item) => null;
+    }
+
+    /// <summary>
+    /// Serves the roots from a pending task, as a slow disk or network would.
+    /// </summary>
+    private sealed class PendingRootsSource(Task<IReadOnlyList<Folder>> roots) : ITreeDataSource<Folder>
+    {
+        public int RootRequests { get; private set; }
+
+        public ValueTask<IReadOnlyList<Folder>> GetRootsAsync(CancellationToken cancellationToken = default)
+        {
+            RootRequests++;
+            return new(roots);
+        }
+
+        public ValueTask<IReadOnlyList<Folder>> GetChildrenAsync(Folder parent, CancellationToken cancellationToken = default) => new(parent.Children);
+        public bool HasChildren(Folder item) => item.Children.Count > 0;
+        public string GetLabel(Folder item) => item.Name;
+        public string? GetIcon(Folder item) => null;
+    }
+
+    /// <summary>
+    /// Serves the roots immediately and every item's children from one pending task.
+    /// </summary>
+    private sealed class DeferredFolderSource(IReadOnlyList<Folder> roots, Task<IReadOnlyList<Folder>> children) : ITreeDataSource<Folder>
+    {
+        public ValueTask<IReadOnlyList<Folder>> GetRootsAsync(CancellationToken cancellationToken = default) => new(roots);
+        public ValueTask<IReadOnlyList<Folder>> GetChildrenAsync(Folder parent, CancellationToken cancellationToken = default) => new(children);
+        public bool HasChildren(Folder item) => true;
+        public string GetLabel(Folder item) => item.Name;
+        public string? GetIcon(Folder item) => null;
+    }
+
+    #endregion
 }
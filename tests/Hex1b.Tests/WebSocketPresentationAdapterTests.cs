@@ -1,4 +1,5 @@
 using System.Net.WebSockets;
+using System.Text;
 
 namespace Hex1b.Tests;
 
@@ -30,6 +31,194 @@ public class WebSocketPresentationAdapterTests
         }
     }
 
+    [TestMethod]
+    public async Task WriteOutputAsync_BatchedBinary_SendsOneBinaryMessagePerFlush()
+    {
+        using var webSocket = new RecordingWebSocket();
+        await using var adapter = new WebSocketPresentationAdapter(webSocket, 80, 24, new WebSocketPresentationOptions
+        {
+            OutputMode = WebSocketOutputMode.BatchedBinary
+        });
+
+        await adapter.WriteOutputAsync("one"u8.ToArray(), TestContext.Current.CancellationToken);
+        await adapter.WriteOutputAsync("two"u8.ToArray(), TestContext.Current.CancellationToken);
+
+        Assert.IsEmpty(webSocket.Sent);
+
+        await adapter.FlushAsync(TestContext.Current.CancellationToken);
+
+        var message = TestSeq.Single(webSocket.Sent);
+        Assert.AreEqual(WebSocketMessageType.Binary, message.Type);
+        Assert.AreEqual("onetwo", Encoding.UTF8.GetString(message.Data));
+    }
+
+    [TestMethod]
+    public async Task WriteOutputAsync_BatchedBinary_SendsEarlyWhenBatchIsFull()
+    {
+        using var webSocket = new RecordingWebSocket();
+        await using var adapter = new WebSocketPresentationAdapter(webSocket, 80, 24, new WebSocketPresentationOptions
+        {
+            OutputMode = WebSocketOutputMode.BatchedBinary,
+            MaxBatchBytes = 4
+        });
+
+        await adapter.WriteOutputAsync("abcdef"u8.ToArray(), TestContext.Current.CancellationToken);
+        await adapter.WriteOutputAsync("g"u8.ToArray(), TestContext.Current.CancellationToken);
+        await adapter.FlushAsync(TestContext.Current.CancellationToken);
+
+        Assert.HasCount(2, webSocket.Sent);
+        Assert.AreEqual("abcdef", Encoding.UTF8.GetString(webSocket.Sent[0].Data));
+        Assert.AreEqual("g", Encoding.UTF8.GetString(webSocket.Sent[1].Data));
+    }
+
+    [TestMethod]
+    public async Task WriteOutputAsync_FlowControlWindowFull_WaitsForClientAck()
+    {
+        using var webSocket = new RecordingWebSocket();
+        await using var adapter = new WebSocketPresentationAdapter(webSocket, 80, 24, new WebSocketPresentationOptions
+        {
+            FlowControlWindow = 8
+        });
+
+        await adapter.WriteOutputAsync("12345678"u8.ToArray(), TestContext.Current.CancellationToken);
+        var blocked = adapter.WriteOutputAsync("9"u8.ToArray(), TestContext.Current.CancellationToken).AsTask();
+        await Task.Delay(50, TestContext.Current.CancellationToken);
+
+        Assert.IsFalse(blocked.IsCompleted);
+        Assert.HasCount(1, webSocket.Sent);
+
+        webSocket.Receive("""{"type":"ack","bytes":8}""");
+        webSocket.Receive("x");
+        var input = await adapter.ReadInputAsync(TestContext.Current.CancellationToken);
+        await blocked.WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+
+        Assert.AreEqual("x", Encoding.UTF8.GetString(input.Span));
+        Assert.HasCount(2, webSocket.Sent);
+    }
+
+    [TestMethod]
+    public async Task ReadInputAsync_ManyAcksBeforeInput_ReturnsInput()
+    {
+        using var webSocket = new RecordingWebSocket();
+        await using var adapter = new WebSocketPresentationAdapter(webSocket, 80, 24, new WebSocketPresentationOptions
+        {
+            FlowControlWindow = 1024
+        });
+
+        // Acks arrive about once per frame, so a long output stream can deliver thousands
+        // before the next keystroke; every one completes synchronously here
+        for (int i = 0; i < 20_000; i++)
+        {
+            webSocket.Receive("""{"type":"ack","bytes":64}""");
+        }
+        webSocket.Receive("""{"type":"resize","cols":100,"rows":30}""");
+        webSocket.Receive("resize:120,40");
+        webSocket.Receive("k");
+
+        var input = await adapter.ReadInputAsync(TestContext.Current.CancellationToken);
+
+        Assert.AreEqual("k", Encoding.UTF8.GetString(input.Span));
+        Assert.AreEqual(120, adapter.Width);
+        Assert.AreEqual(40, adapter.Height);
+    }
+
+    [TestMethod]
+    public async Task DisposeAsync_DuringSend_CancelsSendBeforeDisposing()
+    {
+        using var webSocket = new RecordingWebSocket { BlockSends = true };
+        var adapter = new WebSocketPresentationAdapter(webSocket, 80, 24);
+
+        var write = adapter.WriteOutputAsync("out"u8.ToArray(), TestContext.Current.CancellationToken).AsTask();
+        await webSocket.SendStarted.Task.WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+
+        await adapter.DisposeAsync().AsTask().WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+        await write.WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+
+        Assert.IsTrue(webSocket.SendCancelled);
+
+        // Writes after disposal are dropped rather than touching the disposed token sources
+        await adapter.WriteOutputAsync("late"u8.ToArray(), TestContext.Current.CancellationToken);
+        await adapter.FlushAsync(TestContext.Current.CancellationToken);
+        Assert.IsEmpty(webSocket.Sent);
+    }
+
+    private sealed class RecordingWebSocket : WebSocket
+    {
+        private readonly Queue<byte[]> _received = new();
+
+        public List<(WebSocketMessageType Type, byte[] Data)> Sent { get; } = new();
+
+        /// <summary>When set, sends wait until cancelled, to hold a send in flight.</summary>
+        public bool BlockSends { get; init; }
+
+        public TaskCompletionSource SendStarted { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        public bool SendCancelled { get; private set; }
+
+        public void Receive(string text) => _received.Enqueue(Encoding.UTF8.GetBytes(text));
+
+        public override WebSocketCloseStatus? CloseStatus => null;
+
+        public override string? CloseStatusDescription => null;
+
+        public override WebSocketState State => WebSocketState.Open;
+
+        public override string? SubProtocol => null;
+
+        public override void Abort()
+        {
+        }
+
+        public override Task CloseAsync(WebSocketCloseStatus closeStatus, string? statusDescription, CancellationToken cancellationToken)
+        {
+            return Task.CompletedTask;
+        }
+
+        public override Task CloseOutputAsync(WebSocketCloseStatus closeStatus, string? statusDescription, CancellationToken cancellationToken)
+        {
+            return Task.CompletedTask;
+        }
+
+        public override void Dispose()
+        {
+        }
+
+        public override Task<WebSocketReceiveResult> ReceiveAsync(ArraySegment<byte> buffer, CancellationToken cancellationToken)
+        {
+            throw new NotSupportedException();
+        }
+
+        public override ValueTask<ValueWebSocketReceiveResult> ReceiveAsync(Memory<byte> buffer, CancellationToken cancellationToken = default)
+        {
+            var message = _received.Dequeue();
+            message.CopyTo(buffer);
+            return ValueTask.FromResult(new ValueWebSocketReceiveResult(message.Length, WebSocketMessageType.Text, endOfMessage: true));
+        }
+
+        public override Task SendAsync(ArraySegment<byte> buffer, WebSocketMessageType messageType, bool endOfMessage, CancellationToken cancellationToken)
+        {
+            throw new NotSupportedException();
+        }
+
+        public override async ValueTask SendAsync(ReadOnlyMemory<byte> buffer, WebSocketMessageType messageType, bool endOfMessage, CancellationToken cancellationToken = default)
+        {
+            if (BlockSends)
+            {
+                SendStarted.TrySetResult();
+                try
+                {
+                    await Task.Delay(Timeout.Infinite, cancellationToken);
+                }
+                catch (OperationCanceledException)
+                {
+                    SendCancelled = true;
+                    throw;
+                }
+            }
+            Sent.Add((messageType, buffer.ToArray()));
+        }
+    }
+
     private sealed class StubWebSocket : WebSocket
     {
         public override WebSocketCloseStatus? CloseStatus => null;